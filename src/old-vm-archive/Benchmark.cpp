@@ -0,0 +1,1077 @@
+#include "Benchmark.hpp"
+
+#include "util/Strings.hpp"
+
+#include "compiler/token/Tokenizer.hpp"
+#include "compiler/token/Transformer.hpp"
+#include "compiler/builder/Application.hpp"
+#include "compiler/builder/Package.hpp"
+#include "compiler/builder/NodeBuilder.hpp"
+#include "compiler/node/NodeParser.hpp"
+#include "compiler/optimizer/LoopOptimizer.hpp"
+
+#include "vm/VirtualMachine.hpp"
+#include "vm/element/Class.hpp"
+#include "vm/element/Method.hpp"
+#include "vm/runtime/Stack.hpp"
+#include "vm/runtime/Natives.hpp"
+#include "vm/runtime/Vectors.hpp"
+#include "vm/runtime/Thread.hpp"
+#include "vm/runtime/Fiber.hpp"
+#include "vm/runtime/TaskPool.hpp"
+#include "vm/runtime/Future.hpp"
+#include "vm/runtime/Monitor.hpp"
+#include "util/Threads.hpp"
+
+using namespace Compiler;
+
+namespace Void {
+    namespace Benchmarks {
+        /**
+         * Run the benchmark with the given name.
+         * @param name benchmark name
+         * @param options command line options
+         */
+        void run(String name, Options& options) {
+            if (name == "parser")
+                parser(options);
+            else if (name == "loops")
+                loops(options);
+            else if (name == "natives")
+                natives(options);
+            else if (name == "arrays")
+                arrays(options);
+            else if (name == "vectors")
+                vectors(options);
+            else if (name == "threads")
+                threads(options);
+            else if (name == "tasks")
+                tasks(options);
+            else if (name == "frames")
+                frames(options);
+            else if (name == "locks")
+                locks(options);
+            else if (name == "classes")
+                classes(options);
+            else
+                error("Unknown benchmark '" << name << "'. Available benchmarks: parser, loops, natives, arrays, vectors, threads, tasks, frames, locks, classes");
+        }
+
+        /**
+         * Get the integer value of a command line option.
+         * @param options command line options
+         * @param key option key
+         * @param defaultValue value to use if the option is missing
+         * @return option value or the default value
+         */
+        int getOption(Options& options, String key, int defaultValue) {
+            if (!options.has(key) || options.get(key).empty())
+                return defaultValue;
+            return stringToInt(options.get(key));
+        }
+
+        /**
+         * Transform source code to tokens the same way as the compiler does.
+         * @param source raw source code
+         * @return transformed tokens
+         */
+        List<Token> tokenize(UString source) {
+            // split up the source code to raw tokens
+            Tokenizer tokenizer(source);
+            List<Token> tokens;
+            while (true) {
+                Token token = tokenizer.next();
+                if (!token.hasNext())
+                    break;
+                tokens.push_back(token);
+            }
+            tokens.push_back(Token::of(TokenType::NewLine));
+
+            // insert the automatic semicolons and remove the comments
+            Transformer transformer(tokens);
+            tokens = transformer.transform();
+            tokens.push_back(Token::of(TokenType::Finish));
+            return tokens;
+        }
+
+        /**
+         * Measure the throughput of the expression parser over deep and wide expressions.
+         * @param options command line options
+         */
+        void parser(Options& options) {
+            int iterations = getOption(options, "iterations", 200);
+            int width = getOption(options, "width", 512);
+            int depth = getOption(options, "depth", 256);
+
+            // the binary operators that are rotated in the wide expressions
+            static const char* const OPERATORS[] = {
+                "+", "-", "*", "/", "%", "<", ">", "<=", ">=", "==", "!=", "&&", "||", "&", "|", "<<", ">>", "??"
+            };
+            const int operatorCount = sizeof(OPERATORS) / sizeof(OPERATORS[0]);
+
+            // create a long flat expression with operators of mixed precedence
+            // a0 + a1 * a2.value - call(a3) ...
+            String wide;
+            for (int i = 0; i < width; i++) {
+                if (i > 0)
+                    wide += String(" ") + OPERATORS[i % operatorCount] + " ";
+                if (i % 8 == 3)
+                    wide += "call(a" + toString(i) + ")";
+                else if (i % 8 == 5)
+                    wide += "a" + toString(i) + ".value";
+                else
+                    wide += "a" + toString(i);
+            }
+
+            // create a deeply nested expression of groups
+            // ((((a + 1) * 2) - 3) / 4)
+            String nested = String(depth, '(') + "a";
+            for (int i = 0; i < depth; i++)
+                nested += String(" ") + OPERATORS[i % 5] + " " + toString(i + 1) + ")";
+
+            // create a deep right-associative operation chain
+            // a ^ -a ^ -a ^ -a
+            String chain = "a";
+            for (int i = 0; i < depth; i++)
+                chain += " ^ -a";
+
+            // tokenize the expressions once, only the parsing is measured
+            List<Token> wideTokens = tokenize(Strings::toUTF(wide + "\n"));
+            List<Token> nestedTokens = tokenize(Strings::toUTF(nested + "\n"));
+            List<Token> chainTokens = tokenize(Strings::toUTF(chain + "\n"));
+
+            println("[Benchmark] Expression parser, " << iterations << " iterations");
+            parseExpressions("wide (" + toString(width) + " operands)", wideTokens, iterations);
+            parseExpressions("nested (" + toString(depth) + " groups)", nestedTokens, iterations);
+            parseExpressions("right-associative (" + toString(depth) + " operators)", chainTokens, iterations);
+        }
+
+        /**
+         * Parse every expression of the given tokens multiple times and print the throughput.
+         * @param name name of the measured case
+         * @param tokens expression tokens
+         * @param iterations parse count
+         */
+        void parseExpressions(String name, List<Token>& tokens, int iterations) {
+            Application* application = new Application();
+            Package* package = new Package(application);
+
+            long long elapsed = 0;
+            for (int i = 0; i < iterations; i++) {
+                NodeParser parser(package, tokens);
+
+                // parse the expressions until the end of the tokens
+                auto begin = nanoTime();
+                while (!parser.peek().is(TokenType::Finish)) {
+                    Node* node = parser.nextExpression();
+                    if (node->is(NodeType::Error))
+                        error("Benchmark expression could not be parsed: " << name);
+                }
+                elapsed += nanoTime() - begin;
+            }
+
+            // calculate the parsing throughput
+            double seconds = elapsed / 1000000000.0;
+            double tokensPerSecond = (static_cast<double>(tokens.size()) * iterations) / seconds;
+
+            println("    " << std::left << std::setw(40) << name
+                << (elapsed / iterations / 1000.0) << " us/parse    "
+                << (tokensPerSecond / 1000000.0) << "M tokens/s");
+        }
+
+        /**
+         * Measure the execution time of nested loops compiled with and without the loop optimizer.
+         * @param options command line options
+         */
+        void loops(Options& options) {
+            int iterations = getOption(options, "iterations", 10);
+            int count = getOption(options, "count", 100000);
+
+            // the inner loop recalculates the same products in every iteration,
+            // and both of the loops step their counters by an assignment
+            UString source =
+                U"package \"bench\"\n"
+                U"int compute(int n, int a, int b) {\n"
+                U"    int sum = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        int j = 0\n"
+                U"        while (j < 8) {\n"
+                U"            sum += a * b - j\n"
+                U"            sum = sum + (a + b) * 3\n"
+                U"            j = j + 1\n"
+                U"        }\n"
+                U"        sum = sum % (a * 1000 + 7)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return sum\n"
+                U"}\n";
+
+            List<String> plain = compileSource(source, false);
+            List<String> optimized = compileSource(source, true);
+
+            println("[Benchmark] Loop optimizer, " << iterations << " iterations of " << count << " outer loops");
+            println("    bytecode before:");
+            printMethod(plain, "compute");
+            println("    bytecode after:");
+            printMethod(optimized, "compute");
+
+            int expected = runLoops("unoptimized", plain, count, iterations, options);
+            int result = runLoops("optimized", optimized, count, iterations, options);
+            if (result != expected)
+                error("Optimized loop returned " << result << " instead of " << expected);
+        }
+
+        /**
+         * Mix a value into a hash, the native implementation of the benchmark method.
+         * @param hash previous hash
+         * @param value mixed value
+         * @return new hash
+         */
+        static int mix(int hash, int value) {
+            return (hash * 31 + value) % 65521;
+        }
+
+        /**
+         * Measure the overhead of the native and extern method calls, compared to the bytecode method calls.
+         * @param options command line options
+         */
+        void natives(Options& options) {
+            int iterations = getOption(options, "iterations", 10);
+            int count = getOption(options, "count", 1000000);
+
+            // every loop calls a method with the same result, once implemented in bytecode and once natively
+            UString source =
+                U"package \"bench\"\n"
+                U"native int mix(int hash, int value)\n"
+                U"extern int abs(int value)\n"
+                U"int mixBytecode(int hash, int value) {\n"
+                U"    return (hash * 31 + value) % 65521\n"
+                U"}\n"
+                U"int absBytecode(int value) {\n"
+                U"    if (value < 0) {\n"
+                U"        return -value\n"
+                U"    }\n"
+                U"    return value\n"
+                U"}\n"
+                U"int callBytecode(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = mixBytecode(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n"
+                U"int callNative(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = mix(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n"
+                U"int callAbsBytecode(int n) {\n"
+                U"    int sum = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        sum = (sum + absBytecode(i - n / 2)) % 65521\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return sum\n"
+                U"}\n"
+                U"int callExtern(int n) {\n"
+                U"    int sum = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        sum = (sum + abs(i - n / 2)) % 65521\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return sum\n"
+                U"}\n";
+
+            Natives::define<&mix>("<package>bench", "mix");
+            List<String> bytecode = compileSource(source, false);
+
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            println("[Benchmark] Native calls, " << iterations << " iterations of " << count << " calls");
+            int expected = runCalls("bytecode method", vm, heap, "callBytecode", count, iterations);
+            int result = runCalls("native method", vm, heap, "callNative", count, iterations);
+            if (result != expected)
+                error("Native method returned " << result << " instead of " << expected);
+            expected = runCalls("bytecode abs", vm, heap, "callAbsBytecode", count, iterations);
+            result = runCalls("extern abs", vm, heap, "callExtern", count, iterations);
+            if (result != expected)
+                error("Extern method returned " << result << " instead of " << expected);
+        }
+
+        /**
+         * Measure the element-wise array loops, compared to the bulk array instructions.
+         * @param options command line options
+         */
+        void arrays(Options& options) {
+            int iterations = getOption(options, "iterations", 10);
+            int count = getOption(options, "count", 1000000);
+
+            // the arrays are not part of the language yet, so the methods are written in bytecode,
+            // every method allocates arrays of n elements, and returns an element to check the result
+            List<String> bytecode = {
+                "cdef <package>bench",
+                "cbegin",
+
+                "mdef fillLoop", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link n 0", "#link i 1", "#link a 4",
+                "ianew -l n -r a",
+                "iset i 0",
+                ":loop",
+                "ifi>= -l i -l n -jump end",
+                "iastore -l a -l i -c 7",
+                "iinc -l i -r i",
+                "goto loop",
+                ":end",
+                "idecr -l n -r i",
+                "iaload -l a -l i",
+                "arraydelete -l a",
+                "ireturn",
+                "mend",
+
+                "mdef fillBulk", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link n 0", "#link i 1", "#link a 4",
+                "ianew -l n -r a",
+                "iafill -l a -c 7",
+                "idecr -l n -r i",
+                "iaload -l a -l i",
+                "arraydelete -l a",
+                "ireturn",
+                "mend",
+
+                "mdef copyLoop", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link n 0", "#link i 1", "#link x 2", "#link a 4", "#link b 5",
+                "ianew -l n -r a",
+                "iafill -l a -c 7",
+                "ianew -l n -r b",
+                "iset i 0",
+                ":loop",
+                "ifi>= -l i -l n -jump end",
+                "iaload -l a -l i -r x",
+                "iastore -l b -l i -l x",
+                "iinc -l i -r i",
+                "goto loop",
+                ":end",
+                "idecr -l n -r i",
+                "iaload -l b -l i",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "ireturn",
+                "mend",
+
+                "mdef copyBulk", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link n 0", "#link i 1", "#link a 4", "#link b 5",
+                "ianew -l n -r a",
+                "iafill -l a -c 7",
+                "ianew -l n -r b",
+                "arraycopy -l a -c 0 -l b -c 0 -l n",
+                "idecr -l n -r i",
+                "iaload -l b -l i",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "ireturn",
+                "mend",
+
+                "mdef compareLoop", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link n 0", "#link i 1", "#link x 2", "#link y 3", "#link a 4", "#link b 5",
+                "ianew -l n -r a",
+                "iafill -l a -c 7",
+                "ianew -l n -r b",
+                "iafill -l b -c 7",
+                "iset i 0",
+                ":loop",
+                "ifi>= -l i -l n -jump end",
+                "iaload -l a -l i -r x",
+                "iaload -l b -l i -r y",
+                "ifi!= -l x -l y -jump end",
+                "iinc -l i -r i",
+                "goto loop",
+                ":end",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "ireturn -l i",
+                "mend",
+
+                "mdef compareBulk", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link n 0", "#link i 1", "#link a 4", "#link b 5",
+                "ianew -l n -r a",
+                "iafill -l a -c 7",
+                "ianew -l n -r b",
+                "iafill -l b -c 7",
+                "arraycompare -l a -l b -r i",
+                // the arrays are equal, the loop stops at their length
+                "ifi!= -l i -c -1 -jump end",
+                "iset i 0",
+                "iadd -l i -l n -r i",
+                ":end",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "ireturn -l i",
+                "mend",
+
+                "cend"
+            };
+
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            println("[Benchmark] Array operations, " << iterations << " iterations of " << count << " elements");
+            String cases[] = { "fill", "copy", "compare" };
+            for (String name : cases) {
+                int expected = runCalls(name + " loop", vm, heap, name + "Loop", count, iterations, "element");
+                int result = runCalls(name + " bulk", vm, heap, name + "Bulk", count, iterations, "element");
+                if (result != expected)
+                    error("Bulk " << name << " returned " << result << " instead of " << expected);
+            }
+        }
+
+        /**
+         * Measure the element-wise numeric loops, compared to the vector instructions of each instruction set.
+         * @param options command line options
+         */
+        void vectors(Options& options) {
+            int iterations = getOption(options, "iterations", 10);
+            int count = getOption(options, "count", 1000000);
+
+            // the elements are small integers, so that the sums are exact regardless of the order of the additions
+            List<String> bytecode = {
+                "cdef <package>bench",
+                "cbegin",
+
+                "mdef sumLoop", "mmod static", "mparam I", "mreturn D", "mbegin",
+                "#link n 0", "#link i 1", "#link x 2", "#link s 6", "#link a 4",
+                "danew -l n -r a",
+                "dafill -l a -c 3",
+                "dset s 0",
+                "iset i 0",
+                ":loop",
+                "ifi>= -l i -l n -jump end",
+                "daload -l a -l i -r x",
+                "dadd -l s -l x -r s",
+                "iinc -l i -r i",
+                "goto loop",
+                ":end",
+                "arraydelete -l a",
+                "dreturn -l s",
+                "mend",
+
+                "mdef sumVector", "mmod static", "mparam I", "mreturn D", "mbegin",
+                "#link n 0", "#link s 6", "#link a 4",
+                "danew -l n -r a",
+                "dafill -l a -c 3",
+                "vsum -l a -r s",
+                "arraydelete -l a",
+                "dreturn -l s",
+                "mend",
+
+                "mdef saxpyLoop", "mmod static", "mparam I", "mreturn D", "mbegin",
+                "#link n 0", "#link i 1", "#link x 2", "#link y 3", "#link a 4", "#link b 5",
+                "danew -l n -r a",
+                "dafill -l a -c 2",
+                "danew -l n -r b",
+                "dafill -l b -c 3",
+                "iset i 0",
+                ":loop",
+                "ifi>= -l i -l n -jump end",
+                "daload -l a -l i -r x",
+                "dmul -l x -c 2 -r x",
+                "daload -l b -l i -r y",
+                "dadd -l x -l y -r y",
+                "dastore -l b -l i -l y",
+                "iinc -l i -r i",
+                "goto loop",
+                ":end",
+                "idecr -l n -r i",
+                "daload -l b -l i",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "dreturn",
+                "mend",
+
+                "mdef saxpyVector", "mmod static", "mparam I", "mreturn D", "mbegin",
+                "#link n 0", "#link i 1", "#link a 4", "#link b 5",
+                "danew -l n -r a",
+                "dafill -l a -c 2",
+                "danew -l n -r b",
+                "dafill -l b -c 3",
+                "vfma -l a -c 2 -l b -l b",
+                "idecr -l n -r i",
+                "daload -l b -l i",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "dreturn",
+                "mend",
+
+                "mdef dotLoop", "mmod static", "mparam I", "mreturn D", "mbegin",
+                "#link n 0", "#link i 1", "#link x 2", "#link y 3", "#link s 6", "#link a 4", "#link b 5",
+                "danew -l n -r a",
+                "dafill -l a -c 2",
+                "danew -l n -r b",
+                "dafill -l b -c 3",
+                "dset s 0",
+                "iset i 0",
+                ":loop",
+                "ifi>= -l i -l n -jump end",
+                "daload -l a -l i -r x",
+                "daload -l b -l i -r y",
+                "dmul -l x -l y -r x",
+                "dadd -l s -l x -r s",
+                "iinc -l i -r i",
+                "goto loop",
+                ":end",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "dreturn -l s",
+                "mend",
+
+                "mdef dotVector", "mmod static", "mparam I", "mreturn D", "mbegin",
+                "#link n 0", "#link s 6", "#link a 4", "#link b 5",
+                "danew -l n -r a",
+                "dafill -l a -c 2",
+                "danew -l n -r b",
+                "dafill -l b -c 3",
+                "vdot -l a -l b -r s",
+                "arraydelete -l a",
+                "arraydelete -l b",
+                "dreturn -l s",
+                "mend",
+
+                "cend"
+            };
+
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            // measure every instruction set up to the one selected at startup
+            Vectors::InstructionSet selected = Vectors::getSelected();
+            println("[Benchmark] Vector operations, " << iterations << " iterations of " << count << " elements, "
+                << Vectors::getName(selected) << " selected");
+            String cases[] = { "sum", "saxpy", "dot" };
+            for (String name : cases) {
+                double expected = runCalls<double>(name + " loop", vm, heap, name + "Loop", count, iterations, "element");
+                for (int set = 0; set <= static_cast<int>(selected); set++) {
+                    Vectors::select(static_cast<Vectors::InstructionSet>(set));
+                    String kernel = Vectors::getName(Vectors::getSelected());
+                    double result = runCalls<double>(name + " " + kernel, vm, heap, name + "Vector", count, iterations, "element");
+                    if (result != expected)
+                        error("Vector " << name << " returned " << result << " instead of " << expected << " using " << kernel);
+                }
+                Vectors::select(selected);
+            }
+        }
+
+        /**
+         * Wait until a benchmark thread returns, and take its integer result.
+         * @param thread the joined thread
+         * @param heap root program stack
+         * @return the result of the thread
+         */
+        static int joinResult(Thread* thread, Stack* heap) {
+            // the benchmark is not run by a fiber, so the failure of the thread terminates it
+            Fiber joiner(false);
+            thread->join();
+            thread->collect(&joiner, heap);
+            if (joiner.hasFailed())
+                error(joiner.getError());
+            return heap->ints.pull();
+        }
+
+        /**
+         * Measure the throughput of a method running on multiple threads of the virtual machine at once.
+         * @param options command line options
+         */
+        void threads(Options& options) {
+            int iterations = getOption(options, "iterations", 3);
+            int count = getOption(options, "count", 100000);
+            uint maxThreads = (uint) getOption(options, "threads", (int) Threads::hardwareThreads());
+
+            // every thread runs the same method, that calls an other method, so the threads share
+            // the classes and the resolved call sites, but each of them has its own stacks
+            UString source =
+                U"package \"bench\"\n"
+                U"int mix(int hash, int value) {\n"
+                U"    return (hash * 31 + value) % 65521\n"
+                U"}\n"
+                U"int work(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = mix(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n";
+
+            List<String> bytecode = compileSource(source, false);
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Method* method = vm->getClass("<package>bench")->getMethod("work", { "I" });
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            println("[Benchmark] Threads, " << iterations << " iterations of " << count << " calls on each thread");
+            // the thread count is doubled, until every hardware thread is used
+            List<uint> counts;
+            for (uint threads = 1; threads < maxThreads; threads *= 2)
+                counts.push_back(threads);
+            counts.push_back(getMax(maxThreads, 1u));
+
+            // the hash is never negative, so the first result is the expected one
+            int expected = -1;
+            double single = 0;
+            for (uint threads : counts) {
+                long long elapsed = 0;
+                for (int i = 0; i < iterations; i++) {
+                    auto begin = nanoTime();
+                    List<Thread*> started;
+                    for (uint j = 0; j < threads; j++) {
+                        heap->ints.push(count);
+                        started.push_back(vm->startThread(method, heap));
+                    }
+                    for (Thread* thread : started) {
+                        int result = joinResult(thread, heap);
+                        if (expected < 0)
+                            expected = result;
+                        else if (result != expected)
+                            error("Thread " << thread->id << " returned " << result << " instead of " << expected);
+                    }
+                    elapsed += nanoTime() - begin;
+                }
+
+                // the throughput is the count of the calls of all the threads in a second
+                double throughput = static_cast<double>(count) * threads * iterations / elapsed * 1000.0;
+                if (threads == 1)
+                    single = throughput;
+                println("    " << std::left << std::setw(40) << (toString(threads) + (threads == 1 ? " thread" : " threads"))
+                    << throughput << " Mcalls/s    speedup " << throughput / single << "x    result " << expected);
+            }
+        }
+
+        /**
+         * Measure the short tasks run on a thread of their own, compared to the tasks run by the task pool.
+         * @param options command line options
+         */
+        void tasks(Options& options) {
+            int iterations = getOption(options, "iterations", 3);
+            int count = getOption(options, "count", 500);
+            int calls = getOption(options, "calls", 100);
+
+            // every task is a short call-heavy method, the chained task transforms the result of the previous one
+            UString source =
+                U"package \"bench\"\n"
+                U"int mix(int hash, int value) {\n"
+                U"    return (hash * 31 + value) % 65521\n"
+                U"}\n"
+                U"int work(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = mix(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n"
+                U"int twice(int hash) {\n"
+                U"    return mix(hash, hash)\n"
+                U"}\n";
+
+            List<String> bytecode = compileSource(source, false);
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Class* clazz = vm->getClass("<package>bench");
+            Method* work = clazz->getMethod("work", { "I" });
+            Method* twice = clazz->getMethod("twice", { "I" });
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            TaskPool* pool = vm->getTasks();
+            println("[Benchmark] Tasks, " << iterations << " iterations of " << count << " tasks of " << calls
+                << " calls, " << pool->size() << " workers");
+
+            // run the tasks on a thread of their own
+            long long elapsed = 0;
+            int expected = 0;
+            for (int i = 0; i < iterations; i++) {
+                auto begin = nanoTime();
+                List<Thread*> started;
+                for (int j = 0; j < count; j++) {
+                    heap->ints.push(calls);
+                    started.push_back(vm->startThread(work, heap));
+                }
+                for (Thread* thread : started) {
+                    expected = joinResult(thread, heap);
+                }
+                elapsed += nanoTime() - begin;
+            }
+            println("    " << std::left << std::setw(40) << "thread per task"
+                << (elapsed / iterations / 1000000.0) << " ms/iteration    result " << expected);
+
+            // run the same tasks on the task pool
+            elapsed = 0;
+            int result = 0;
+            for (int i = 0; i < iterations; i++) {
+                auto begin = nanoTime();
+                List<Future*> futures;
+                for (int j = 0; j < count; j++) {
+                    heap->ints.push(calls);
+                    futures.push_back(vm->submitTask(work, heap));
+                }
+                for (Future* future : futures) {
+                    if (!future->await(heap))
+                        error("Task " << future->id << " has failed: " << future->getError());
+                    result = heap->ints.pull();
+                    if (result != expected)
+                        error("Task " << future->id << " returned " << result << " instead of " << expected);
+                }
+                elapsed += nanoTime() - begin;
+            }
+            println("    " << std::left << std::setw(40) << "task pool"
+                << (elapsed / iterations / 1000000.0) << " ms/iteration    result " << result);
+
+            // chain a second task to each task, the chained tasks are submitted by the workers
+            elapsed = 0;
+            for (int i = 0; i < iterations; i++) {
+                auto begin = nanoTime();
+                List<Future*> futures;
+                for (int j = 0; j < count; j++) {
+                    heap->ints.push(calls);
+                    futures.push_back(vm->chainTask(vm->submitTask(work, heap), twice, heap));
+                }
+                for (Future* future : futures) {
+                    if (!future->await(heap))
+                        error("Task " << future->id << " has failed: " << future->getError());
+                    result = heap->ints.pull();
+                }
+                elapsed += nanoTime() - begin;
+            }
+            println("    " << std::left << std::setw(40) << "chained task pool"
+                << (elapsed / iterations / 1000000.0) << " ms/iteration    result " << result);
+
+            TaskPool::Metrics metrics = pool->getMetrics();
+            println("    " << metrics.submitted << " tasks submitted, " << metrics.stolen << " stolen, " << metrics.helped
+                << " run by waiting threads, peak queue depth " << metrics.peakQueueDepth << ", queue depth " << metrics.queueDepth);
+        }
+
+        /**
+         * Measure the method calls executed by the frame stack of a fiber, and the recursion deeper than the native stack.
+         * @param options command line options
+         */
+        void frames(Options& options) {
+            int iterations = getOption(options, "iterations", 5);
+            int count = getOption(options, "count", 1000000);
+            int depth = getOption(options, "depth", 1000000);
+
+            // every frame of the recursion stays on the frame stack until the deepest call returns
+            UString source =
+                U"package \"bench\"\n"
+                U"int mix(int hash, int value) {\n"
+                U"    return (hash * 31 + value) % 65521\n"
+                U"}\n"
+                U"int flat(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = mix(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n"
+                U"int nested(int n) {\n"
+                U"    if (n == 0) {\n"
+                U"        return 0\n"
+                U"    }\n"
+                U"    return nested(n - 1) + 1\n"
+                U"}\n";
+
+            List<String> bytecode = compileSource(source, false);
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            println("[Benchmark] Frames, " << iterations << " iterations of " << count << " calls and a recursion of depth " << depth);
+            runCalls("flat calls", vm, heap, "flat", count, iterations);
+            int result = runCalls("nested calls", vm, heap, "nested", depth, iterations);
+            if (result != depth)
+                error("Recursion returned " << result << " instead of " << depth);
+        }
+
+        /**
+         * Measure the synchronized method calls, with the lock held by a single thread and shared by multiple threads.
+         * @param options command line options
+         */
+        void locks(Options& options) {
+            int iterations = getOption(options, "iterations", 3);
+            int count = getOption(options, "count", 200000);
+            uint threads = (uint) getOption(options, "threads", (int) getMax(Threads::hardwareThreads(), 2u));
+
+            // the synchronized method is static, so every call holds the lock of the package class
+            UString source =
+                U"package \"bench\"\n"
+                U"int mix(int hash, int value) {\n"
+                U"    return (hash * 31 + value) % 65521\n"
+                U"}\n"
+                U"synchronized int guard(int hash, int value) {\n"
+                U"    return (hash * 31 + value) % 65521\n"
+                U"}\n"
+                U"int plain(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = mix(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n"
+                U"int locked(int n) {\n"
+                U"    int hash = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        hash = guard(hash, i)\n"
+                U"        i += 1\n"
+                U"    }\n"
+                U"    return hash\n"
+                U"}\n";
+
+            List<String> bytecode = compileSource(source, false);
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Method* locked = vm->getClass("<package>bench")->getMethod("locked", { "I" });
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            println("[Benchmark] Locks, " << iterations << " iterations of " << count << " calls, " << threads << " contending threads");
+            int expected = runCalls("unsynchronized", vm, heap, "plain", count, iterations);
+            // the lock is never deflated, so the thin lock is measured before the threads contend for it
+            int result = runCalls("uncontended synchronized", vm, heap, "locked", count, iterations);
+            if (result != expected)
+                error("Synchronized method returned " << result << " instead of " << expected);
+
+            Monitor::Metrics before = Monitor::getMetrics();
+            long long elapsed = 0;
+            for (int i = 0; i < iterations; i++) {
+                auto begin = nanoTime();
+                List<Thread*> started;
+                for (uint j = 0; j < threads; j++) {
+                    heap->ints.push(count);
+                    started.push_back(vm->startThread(locked, heap));
+                }
+                for (Thread* thread : started) {
+                    result = joinResult(thread, heap);
+                    if (result != expected)
+                        error("Thread " << thread->id << " returned " << result << " instead of " << expected);
+                }
+                elapsed += nanoTime() - begin;
+            }
+            println("    " << std::left << std::setw(40) << "contended synchronized"
+                << (static_cast<double>(elapsed) / iterations / count / threads) << " ns/call    result " << result);
+
+            Monitor::Metrics after = Monitor::getMetrics();
+            println("    " << after.contended - before.contended << " contended acquisitions, " << after.inflated - before.inflated
+                << " locks inflated, " << after.parked - before.parked << " threads parked");
+        }
+
+        /**
+         * Measure the class lookups of multiple threads, while an other thread is loading new classes.
+         * @param options command line options
+         */
+        void classes(Options& options) {
+            int iterations = getOption(options, "iterations", 3);
+            int count = getOption(options, "count", 1000);
+            int lookups = getOption(options, "lookups", 1000000);
+            uint readers = (uint) getOption(options, "threads", (int) getMax(Threads::hardwareThreads() - 1, 1u));
+
+            // the looked up classes are defined before the readers start
+            VirtualMachine* vm = new VirtualMachine(options);
+            List<String> names;
+            for (int i = 0; i < count; i++) {
+                names.push_back("bench.Class" + toString(i));
+                vm->defineClass(new Class(names.back(), "Object", 0, {}, vm));
+            }
+
+            println("[Benchmark] Classes, " << iterations << " iterations of " << lookups << " lookups of " << count
+                << " classes on " << readers << " threads");
+            String cases[] = { "lookups", "lookups while loading" };
+            for (int loading = 0; loading < 2; loading++) {
+                long long elapsed = 0;
+                int loaded = 0;
+                for (int i = 0; i < iterations; i++) {
+                    std::atomic<bool> reading = true;
+                    auto begin = nanoTime();
+                    List<std::thread> started;
+                    for (uint j = 0; j < readers; j++) {
+                        started.emplace_back([vm, &names, lookups, j]() {
+                            for (int k = 0; k < lookups; k++) {
+                                String& name = names[(k + j * 7) % names.size()];
+                                if (vm->getClass(name) == nullptr)
+                                    error("Class '" << name << "' is not defined");
+                            }
+                        });
+                    }
+                    // the loader defines new classes until the readers return, the table grows meanwhile
+                    std::thread loader;
+                    if (loading) {
+                        loader = std::thread([vm, &reading, &loaded, i]() {
+                            for (int k = 0; reading.load(std::memory_order_relaxed); k++, loaded++)
+                                vm->defineClass(new Class("bench.Loaded" + toString(i) + "_" + toString(k), "Object", 0, {}, vm));
+                        });
+                    }
+                    for (std::thread& thread : started)
+                        thread.join();
+                    elapsed += nanoTime() - begin;
+                    reading = false;
+                    if (loading)
+                        loader.join();
+                }
+                println("    " << std::left << std::setw(40) << cases[loading]
+                    << (static_cast<double>(elapsed) / iterations / lookups) << " ns/lookup    " << loaded << " classes loaded");
+            }
+        }
+
+        /**
+         * Call a method of the compiled benchmark source multiple times and print the time of the inner calls.
+         * @param name name of the measured case
+         * @param vm virtual machine that loaded the benchmark source
+         * @param heap root program stack
+         * @param method name of the called method
+         * @param count call count of the method
+         * @param iterations iteration count
+         * @param unit the name of the unit of work, that is done count times by a call
+         * @return the result of the last call, an int or a double
+         */
+        template <typename T>
+        T runCalls(String name, VirtualMachine* vm, Stack* heap, String method, int count, int iterations, String unit) {
+            Method* target = vm->getClass("<package>bench")->getMethod(method, { "I" });
+
+            T result = 0;
+            long long elapsed = 0;
+            for (int i = 0; i < iterations; i++) {
+                heap->ints.push(count);
+                auto begin = nanoTime();
+                target->invoke(vm, heap, nullptr, nullptr);
+                elapsed += nanoTime() - begin;
+                if constexpr (std::is_same_v<T, double>)
+                    result = heap->doubles.pull();
+                else
+                    result = heap->ints.pull();
+            }
+
+            println("    " << std::left << std::setw(40) << name
+                << (static_cast<double>(elapsed) / iterations / count) << " ns/" << unit << "    result " << result);
+            return result;
+        }
+
+        template int runCalls<int>(String, VirtualMachine*, Stack*, String, int, int, String);
+        template double runCalls<double>(String, VirtualMachine*, Stack*, String, int, int, String);
+
+        /**
+         * Compile the methods of a single source package to an executable bytecode class.
+         * @param source raw source code
+         * @param optimize true if the loops of the methods should be optimized
+         * @return linked bytecode
+         */
+        List<String> compileSource(UString source, bool optimize) {
+            Application* application = new Application();
+            Package* package = new Package(application);
+
+            // parse the declarations of the source
+            List<Token> tokens = tokenize(source);
+            NodeParser parser(package, tokens, false);
+            List<Node*> nodes;
+            while (true) {
+                Node* node = parser.next();
+                if (node->is(NodeType::Error))
+                    error("Benchmark source could not be parsed");
+                if (node->is(NodeType::Finish))
+                    break;
+                nodes.push_back(node);
+            }
+            NodeBuilder builder(package, nodes);
+            builder.build();
+            package = application->registerPackage(package);
+            package->resolve();
+
+            if (optimize) {
+                LoopOptimizer optimizer(package);
+                optimizer.optimize();
+            }
+
+            // put the package methods to the anonymous package class
+            List<UString> methods;
+            package->compileMethods(methods);
+            // the virtual machine reads the instructions without the indentation, the same way as the program loader
+            List<String> bytecode = { "cdef <package>" + Strings::fromUTF(package->name), "cbegin" };
+            for (UString& line : methods) {
+                String instruction = Strings::fromUTF(line);
+                bytecode.push_back(instruction.substr(instruction.find_first_not_of(' ')));
+            }
+            bytecode.push_back("cend");
+            return bytecode;
+        }
+
+        /**
+         * Print the bytecode of a method of the compiled benchmark source.
+         * @param bytecode linked bytecode
+         * @param method method name
+         */
+        void printMethod(List<String>& bytecode, String method) {
+            bool printing = false;
+            for (String& line : bytecode) {
+                printing |= line.find("mdef " + method) != String::npos;
+                if (printing)
+                    println("        " << (line.starts_with("mdef") || line.starts_with("mend") ? "" : "    ") << line);
+                if (printing && line.find("mend") != String::npos)
+                    break;
+            }
+        }
+
+        /**
+         * Call the compute method of the compiled benchmark source multiple times and print the execution time.
+         * @param name name of the measured case
+         * @param bytecode linked bytecode
+         * @param count iteration count of the outer loop
+         * @param iterations call count
+         * @param options command line options
+         * @return the result of the last call
+         */
+        int runLoops(String name, List<String>& bytecode, int count, int iterations, Options& options) {
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            Method* method = vm->getClass("<package>bench")->getMethod("compute", { "I", "I", "I" });
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            vm->initialize(heap);
+
+            int result = 0;
+            long long elapsed = 0;
+            for (int i = 0; i < iterations; i++) {
+                // compute(count, 3, 7)
+                heap->ints.push(count);
+                heap->ints.push(3);
+                heap->ints.push(7);
+                auto begin = nanoTime();
+                method->invoke(vm, heap, nullptr, nullptr);
+                elapsed += nanoTime() - begin;
+                result = heap->ints.pull();
+            }
+
+            println("    " << std::left << std::setw(40) << name
+                << (elapsed / iterations / 1000000.0) << " ms/call    result " << result);
+            return result;
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Common.hpp"
+
+#include "util/Options.hpp"
+#include "compiler/token/Token.hpp"
+
+namespace Void {
+    class VirtualMachine;
+    class Stack;
+
+    /**
+     * Represents a collection of micro benchmarks that measure the performance critical parts of the compiler
+     * and the virtual machine. Benchmarks are launched using the "-benchmark <name>" command line option.
+     */
+    namespace Benchmarks {
+        /**
+         * Run the benchmark with the given name.
+         * @param name benchmark name
+         * @param options command line options
+         */
+        void run(String name, Options& options);
+
+        /**
+         * Get the integer value of a command line option.
+         * @param options command line options
+         * @param key option key
+         * @param defaultValue value to use if the option is missing
+         * @return option value or the default value
+         */
+        int getOption(Options& options, String key, int defaultValue);
+
+        /**
+         * Transform source code to tokens the same way as the compiler does.
+         * @param source raw source code
+         * @return transformed tokens
+         */
+        List<Compiler::Token> tokenize(UString source);
+
+        /**
+         * Measure the throughput of the expression parser over deep and wide expressions.
+         * @param options command line options
+         */
+        void parser(Options& options);
+
+        /**
+         * Parse every expression of the given tokens multiple times and print the throughput.
+         * @param name name of the measured case
+         * @param tokens expression tokens
+         * @param iterations parse count
+         */
+        void parseExpressions(String name, List<Compiler::Token>& tokens, int iterations);
+
+        /**
+         * Measure the execution time of nested loops compiled with and without the loop optimizer.
+         * @param options command line options
+         */
+        void loops(Options& options);
+
+        /**
+         * Measure the overhead of the native and extern method calls, compared to the bytecode method calls.
+         * @param options command line options
+         */
+        void natives(Options& options);
+
+        /**
+         * Measure the element-wise array loops, compared to the bulk array instructions.
+         * @param options command line options
+         */
+        void arrays(Options& options);
+
+        /**
+         * Measure the element-wise numeric loops, compared to the vector instructions of each instruction set.
+         * @param options command line options
+         */
+        void vectors(Options& options);
+
+        /**
+         * Measure the throughput of a method running on multiple threads of the virtual machine at once.
+         * @param options command line options
+         */
+        void threads(Options& options);
+
+        /**
+         * Measure the short tasks run on a thread of their own, compared to the tasks run by the task pool.
+         * @param options command line options
+         */
+        void tasks(Options& options);
+
+        /**
+         * Measure the method calls executed by the frame stack of a fiber, and the recursion deeper than the native stack.
+         * @param options command line options
+         */
+        void frames(Options& options);
+
+        /**
+         * Measure the synchronized method calls, with the lock held by a single thread and shared by multiple threads.
+         * @param options command line options
+         */
+        void locks(Options& options);
+
+        /**
+         * Measure the class lookups of multiple threads, while an other thread is loading new classes.
+         * @param options command line options
+         */
+        void classes(Options& options);
+
+        /**
+         * Call a method of the compiled benchmark source multiple times and print the time of the inner calls.
+         * @param name name of the measured case
+         * @param vm virtual machine that loaded the benchmark source
+         * @param heap root program stack
+         * @param method name of the called method
+         * @param count call count of the method
+         * @param iterations iteration count
+         * @param unit the name of the unit of work, that is done count times by a call
+         * @return the result of the last call, an int or a double
+         */
+        template <typename T = int>
+        T runCalls(String name, VirtualMachine* vm, Stack* heap, String method, int count, int iterations, String unit = "call");
+
+        /**
+         * Compile the methods of a single source package to an executable bytecode class.
+         * @param source raw source code
+         * @param optimize true if the loops of the methods should be optimized
+         * @return linked bytecode
+         */
+        List<String> compileSource(UString source, bool optimize);
+
+        /**
+         * Print the bytecode of a method of the compiled benchmark source.
+         * @param bytecode linked bytecode
+         * @param method method name
+         */
+        void printMethod(List<String>& bytecode, String method);
+
+        /**
+         * Call the compute method of the compiled benchmark source multiple times and print the execution time.
+         * @param name name of the measured case
+         * @param bytecode linked bytecode
+         * @param count iteration count of the outer loop
+         * @param iterations call count
+         * @param options command line options
+         * @return the result of the last call
+         */
+        int runLoops(String name, List<String>& bytecode, int count, int iterations, Options& options);
+    }
+}
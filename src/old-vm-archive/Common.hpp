@@ -27,6 +27,7 @@ typedef std::any Object;
 // maps
 
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <deque>
 
@@ -39,6 +40,15 @@ using TreeMap = std::map<K, V>;
 template <typename K, typename V>
 using Pair = std::pair<K, V>;
 
+// threads
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
 // lists
 
 template <typename T>
@@ -4,10 +4,17 @@
 #include "vm/VirtualMachine.hpp"
 #include "vm/element/Executable.hpp"
 #include "vm/runtime/Stack.hpp"
+#include "vm/runtime/Console.hpp"
+#include "vm/runtime/Monitor.hpp"
 #include "vm/element/Method.hpp"
 #include "vm/element/Field.hpp"
 
 #include "util/Files.hpp"
+#include "util/Strings.hpp"
+#include "util/Threads.hpp"
+
+#include "Benchmark.hpp"
+#include "Tests.hpp"
 
 #include "compiler/Project.hpp"
 #include "compiler/token/Token.hpp"
@@ -48,6 +55,12 @@ namespace Void {
         // generate a native header for a compiled void executable
         else if (options.has("header"))
             generateHeader(options);
+        // run a performance benchmark
+        else if (options.has("benchmark"))
+            runBenchmark(options);
+        // run a regression test
+        else if (options.has("test"))
+            runTest(options);
     }
 
     /**
@@ -60,8 +73,16 @@ namespace Void {
         println("Where options include:" << '\n');
         println("	-run <executable file>		Execute a compiled vertex program.");
         println("	-compile <project folder>	Compile vertex source files.");
+        println("	-threads <count>		Set the count of the compiler threads.");
+        println("	-rebuild			Ignore the previous build and compile all source files.");
+        println("	-O0				Disable the optimizations of the compiler.");
+        println("	-ir				Generate the bytecode of the methods through the SSA intermediate representation.");
+        println("	-dump <passes>			Print the nodes of the methods after the given optimization passes (inline, scalar, fold, loop, dce),");
+        println("					or the graphs of the -ir stages (ssa, copy, gvn, values, cfg).");
         println("	-header <source file>		Create a c++ header for the given source file.");
         println("   -new <project name>         Create a new Void project.");
+        println("	-benchmark <name>		Run a compiler or virtual machine benchmark.");
+        println("	-test <name>			Run a compiler or virtual machine regression test.");
         println("");
     }
 
@@ -115,12 +136,51 @@ namespace Void {
 
         // TODO setup program arguments for the environment
 
+        // override the buffering of the program output, that depends on whether the output is a terminal by default
+        if (options.has("XConsoleBuffer")) {
+            String mode = options.get("XConsoleBuffer");
+            if (mode == "line")
+                Console::setBuffering(Console::Buffering::LINE);
+            else if (mode == "full")
+                Console::setBuffering(Console::Buffering::FULL);
+            else
+                error("Invalid console buffering mode '" << mode << "'. Available modes: line, full");
+        }
+
+        // the messages of the virtual machine must precede the program output, even if the program exits with an error
+        std::cout.flush();
+
         auto begin = currentTimeMillis();
         mainMethod->invoke(vm, heap, nullptr, nullptr);
+        // the program exits when every thread it has started returned, and every task it has submitted has been run
+        vm->joinThreads();
+        vm->waitTasks();
+        Console::flush();
         auto end = currentTimeMillis();
 
         println("");
         println("Executed in " << end - begin << "ms");
+
+        // debug the virtual call sites that are bound to a single method by the class hierarchy
+        if (options.has("XDevirtStats")) {
+            println("[Void] Devirtualized " << vm->devirtualizedSites << " of " << vm->virtualSites
+                << " virtual call sites, " << vm->guardMisses << " receiver guard misses");
+        }
+
+        // debug the work distribution of the task pool
+        if (options.has("XTaskStats")) {
+            TaskPool::Metrics metrics = vm->getTasks()->getMetrics();
+            println("[Void] Task pool of " << metrics.workers << " workers ran " << metrics.submitted << " tasks, "
+                << metrics.stolen << " stolen, " << metrics.helped << " run by waiting threads, peak queue depth "
+                << metrics.peakQueueDepth);
+        }
+
+        // debug the contention of the locks of the synchronized methods and blocks
+        if (options.has("XLockStats")) {
+            Monitor::Metrics metrics = Monitor::getMetrics();
+            println("[Void] " << metrics.contended << " contended lock acquisitions, " << metrics.inflated
+                << " locks inflated, " << metrics.parked << " threads parked");
+        }
     }
 
     /**
@@ -138,10 +198,11 @@ namespace Void {
         String inputDir = options.get("compile");
         println("Compiling project root " << inputDir);
 
-        // create the void application wrapper
-        Project project(inputDir);
-        // validate that the project files are exist
-        // project.validate();
+        // compile every source file of the project if a project folder is given
+        if (Files::isDirectory(inputDir)) {
+            compileProject(inputDir, options);
+            return;
+        }
 
         Tokenizer tokenizer(Files::readUTF(inputDir));
 
@@ -196,6 +257,51 @@ namespace Void {
             println(instruction);
     }
 
+    /**
+     * Compile all the source files of a project folder using multiple threads.
+     * @param inputDir project root directory
+     * @param options command line arguments
+     */
+    void Launcher::compileProject(String inputDir, Options& options) {
+        // create the void application wrapper
+        Project project(inputDir);
+        // validate that the project files are exist
+        project.validate();
+
+        // get the count of the compiler worker threads
+        uint threads = Threads::hardwareThreads();
+        if (options.has("threads") && !options.get("threads").empty())
+            threads = (uint) stringToInt(options.get("threads"));
+
+        // configure the optimization passes of the compiler
+        project.optimize = !options.has("O0");
+        project.ir = options.has("ir");
+        if (options.has("dump")) {
+            String passes = options.get("dump");
+            project.dumps = Strings::split(passes, ',');
+        }
+
+        // compile the project source files
+        List<UString> bytecode;
+        project.compile(bytecode, threads > 0 ? threads : 1, options.has("rebuild"));
+
+        // print the bytecode if the output file is not specified
+        if (!options.has("out")) {
+            for (UString instruction : bytecode)
+                println(instruction);
+            return;
+        }
+
+        // write the bytecode to the output file
+        String outputFile = options.get("out");
+        FileWriter writer(outputFile);
+        if (writer.fail())
+            error("Unable to write file: " << outputFile);
+        for (UString instruction : bytecode)
+            writer << Strings::fromUTF(instruction) << '\n';
+        println("Bytecode written to " << outputFile);
+    }
+
     /**
      * Generate a native header for a compile void class.
      * @param options command line arguments
@@ -203,4 +309,20 @@ namespace Void {
     void Launcher::generateHeader(Options& options) {
         println("Generating headers " << options.get("header"));
     }
+
+    /**
+     * Run a compiler or virtual machine performance benchmark.
+     * @param options command line arguments
+     */
+    void Launcher::runBenchmark(Options& options) {
+        Benchmarks::run(options.get("benchmark"), options);
+    }
+
+    /**
+     * Run a compiler or virtual machine regression test.
+     * @param options command line arguments
+     */
+    void Launcher::runTest(Options& options) {
+        Tests::run(options.get("test"), options);
+    }
 }
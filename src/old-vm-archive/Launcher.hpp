@@ -39,10 +39,29 @@ namespace Void {
          */
         void compileSources(Options& options);
 
+        /**
+         * Compile all the source files of a project folder using multiple threads.
+         * @param inputDir project root directory
+         * @param options command line arguments
+         */
+        void compileProject(String inputDir, Options& options);
+
         /**
          * Generate a native header for a compile void class.
          * @param options command line arguments
          */
         void generateHeader(Options& options);
+
+        /**
+         * Run a compiler or virtual machine performance benchmark.
+         * @param options command line arguments
+         */
+        void runBenchmark(Options& options);
+
+        /**
+         * Run a compiler or virtual machine regression test.
+         * @param options command line arguments
+         */
+        void runTest(Options& options);
     };
 }
@@ -0,0 +1,1364 @@
+#include "Tests.hpp"
+#include "Benchmark.hpp"
+
+#include "util/Strings.hpp"
+#include "util/Threads.hpp"
+
+#include "compiler/builder/Application.hpp"
+#include "compiler/builder/Package.hpp"
+#include "compiler/builder/Symbols.hpp"
+#include "compiler/node/NodeParser.hpp"
+#include "compiler/Project.hpp"
+
+#include "vm/VirtualMachine.hpp"
+#include "vm/element/Class.hpp"
+#include "vm/element/Method.hpp"
+#include "vm/runtime/Stack.hpp"
+
+using namespace Compiler;
+
+namespace Void {
+    namespace Tests {
+        /**
+         * Run the test suite with the given name.
+         * @param name test suite name
+         * @param options command line options
+         */
+        void run(String name, Options& options) {
+            if (name == "operators")
+                operators(options);
+            else if (name == "projects")
+                projects(options);
+            else if (name == "rebuild")
+                rebuild(options);
+            else if (name == "overloads")
+                overloads(options);
+            else if (name == "codegen")
+                codegen(options);
+            else if (name == "folding")
+                folding(options);
+            else if (name == "deadcode")
+                deadcode(options);
+            else if (name == "inlining")
+                inlining(options);
+            else if (name == "loops")
+                loops(options);
+            else if (name == "structs")
+                structs(options);
+            else if (name == "ssa")
+                ssa(options);
+            else if (name == "valuenumbering")
+                valuenumbering(options);
+            else if (name == "slots")
+                slots(options);
+            else if (name == "devirtualization")
+                devirtualization(options);
+            else
+                error("Unknown test '" << name << "'. Available tests: operators, projects, rebuild, overloads, codegen, folding, deadcode, "
+                    << "inlining, loops, structs, ssa, valuenumbering, slots, devirtualization");
+        }
+
+        /**
+         * Test the tokenization and the parsing of the operators.
+         * @param options command line options
+         */
+        void operators(Options& options) {
+            println("[Test] Operators");
+
+            // the operators are matched by the longest adjacent characters, the whitespaces separate them
+            expectTokens(U"x - -y", { U"x", U"-", U"-", U"y" });
+            expectTokens(U"a + +b", { U"a", U"+", U"+", U"b" });
+            expectTokens(U"x-=y", { U"x", U"-=", U"y" });
+            expectTokens(U"x-- - y", { U"x", U"--", U"-", U"y" });
+            expectTokens(U"a >>>= b", { U"a", U">>>", U"=", U"b" });
+            expectTokens(U"a?.b ?? c::d", { U"a", U"?.", U"b", U"??", U"c", U"::", U"d" });
+            // a safe member operator is never matched before a fraction
+            expectTokens(U"c ?.5", { U"c", U"?", U".", U"5" });
+            // the comment markers are not joined with the comment
+            expectTokens(U"a //= b", { U"a" });
+            expectTokens(U"a /*= b */ + c", { U"a", U"+", U"c" });
+
+            // the nested generic types are closed by a shift operator token
+            expectParsed(U"void test() {\n    Map<String, List<int>> values = null\n}\n");
+            expectParsed(U"void test() {\n    || println(1)\n}\n");
+
+            // the prefix operator after a binary operator is an operator of the right operand
+            UString source =
+                U"package \"tests\"\n"
+                U"int negate(int x) {\n"
+                U"    int y = 3\n"
+                U"    return x - -y\n"
+                U"}\n"
+                U"int plus(int a) {\n"
+                U"    int b = 3\n"
+                U"    return a + +b\n"
+                U"}\n"
+                U"int step(int x) {\n"
+                U"    x -= -2\n"
+                U"    x--\n"
+                U"    return x\n"
+                U"}\n";
+
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(Benchmarks::compileSource(source, false), options, heap);
+
+            expectResult(vm, heap, "negate", 5, 8);
+            expectResult(vm, heap, "plus", 5, 8);
+            expectResult(vm, heap, "step", 5, 6);
+            println("    passed");
+        }
+
+        /**
+         * Test the parallel compilation of a project, whose packages are declared by multiple source files.
+         * @param options command line options
+         */
+        void projects(Options& options) {
+            println("[Test] Projects");
+
+            // the main package is split to two files, and the generated package to many files,
+            // so that the workers parse the declarations of the same package at the same time
+            TreeMap<String, String> sources;
+            sources["main/Main.vs"] =
+                "package \"main\"\n"
+                "import \"util\"\n"
+                "import \"gen\"\n"
+                "int run(int x) {\n"
+                "    return helper(x) + twice(x)\n"
+                "}\n"
+                "int total(int x) {\n"
+                "    int sum = 0\n";
+            for (int i = 0; i < 16; i++)
+                sources["main/Main.vs"] += "    sum += part" + toString(i) + "(x)\n";
+            sources["main/Main.vs"] +=
+                "    return sum\n"
+                "}\n"
+                "void main() {\n"
+                "    println(run(3))\n"
+                "}\n";
+            sources["main/Helper.vs"] =
+                "package \"main\"\n"
+                "int helper(int a) {\n"
+                "    return a * 5\n"
+                "}\n";
+            sources["util/Util.vs"] =
+                "package \"util\"\n"
+                "int twice(int x) {\n"
+                "    return x * 2\n"
+                "}\n";
+            for (int i = 0; i < 16; i++) {
+                sources["gen/Part" + toString(i) + ".vs"] =
+                    "package \"gen\"\n"
+                    "int part" + toString(i) + "(int x) {\n"
+                    "    return x + " + toString(i) + "\n"
+                    "}\n";
+            }
+
+            // the unreachable methods are kept, so that every method can be called by the test
+            Project project(createProject("projects", sources));
+            project.optimize = false;
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(compileProject(project, 4, true), options, heap);
+
+            // the merged declarations are called across the files and the packages
+            if (int result = callMethod(vm, heap, "<package>main", "run", 3); result != 21)
+                error("Method run(3) returned " << result << " instead of 21");
+            if (int result = callMethod(vm, heap, "<package>main", "total", 1); result != 136)
+                error("Method total(1) returned " << result << " instead of 136");
+            if (int result = callMethod(vm, heap, "<package>gen", "part15", 1); result != 16)
+                error("Method part15(1) returned " << result << " instead of 16");
+            println("    passed");
+        }
+
+        /**
+         * Test the incremental compilation of a project, that reuses the bytecode of the unchanged source files.
+         * @param options command line options
+         */
+        void rebuild(Options& options) {
+            println("[Test] Rebuild");
+
+            TreeMap<String, String> sources;
+            sources["main/Main.vs"] =
+                "package \"main\"\n"
+                "import \"util\"\n"
+                "int run(int x) {\n"
+                "    return helper(x) + twice(x)\n"
+                "}\n";
+            sources["main/Helper.vs"] =
+                "package \"main\"\n"
+                "int helper(int a) {\n"
+                "    return a * 5\n"
+                "}\n";
+            sources["other/Other.vs"] =
+                "package \"other\"\n"
+                "int other(int x) {\n"
+                "    return x - 1\n"
+                "}\n";
+            sources["util/Util.vs"] =
+                "package \"util\"\n"
+                "int twice(int x) {\n"
+                "    return x * 2\n"
+                "}\n";
+            String projectDir = createProject("rebuild", sources);
+            Project project(projectDir);
+            project.optimize = false;
+
+            // the first build has no database, so every file is parsed
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(compileProject(project, 2, false), options, heap);
+            expectRebuilt(project, { "main/Helper.vs", "main/Main.vs", "other/Other.vs", "util/Util.vs" });
+            if (int result = callMethod(vm, heap, "<package>main", "run", 3); result != 21)
+                error("Method run(3) returned " << result << " instead of 21");
+
+            // nothing has changed, so the whole program is linked from the build database
+            vm = loadProgram(compileProject(project, 2, false), options, heap);
+            expectRebuilt(project, {});
+            if (int result = callMethod(vm, heap, "<package>main", "run", 3); result != 21)
+                error("Method run(3) of the reused bytecode returned " << result << " instead of 21");
+
+            // a changed method body keeps the declarations of the package, so the other files are reused
+            writeSource(projectDir, "main/Helper.vs",
+                "package \"main\"\n"
+                "int helper(int a) {\n"
+                "    return a * 7\n"
+                "}\n");
+            vm = loadProgram(compileProject(project, 2, false), options, heap);
+            expectRebuilt(project, { "main/Helper.vs" });
+            if (int result = callMethod(vm, heap, "<package>main", "run", 3); result != 27)
+                error("Method run(3) returned " << result << " instead of 27 after changing helper");
+
+            // a changed declaration rebuilds the files that import the package, but not the unrelated ones
+            writeSource(projectDir, "util/Util.vs",
+                "package \"util\"\n"
+                "int twice(int x) {\n"
+                "    return x * 2\n"
+                "}\n"
+                "int thrice(int x) {\n"
+                "    return x * 3\n"
+                "}\n");
+            vm = loadProgram(compileProject(project, 2, false), options, heap);
+            expectRebuilt(project, { "main/Main.vs", "util/Util.vs" });
+            if (int result = callMethod(vm, heap, "<package>util", "thrice", 3); result != 9)
+                error("Method thrice(3) returned " << result << " instead of 9");
+            if (int result = callMethod(vm, heap, "<package>other", "other", 3); result != 2)
+                error("Method other(3) of the reused bytecode returned " << result << " instead of 2");
+
+            // a forced rebuild ignores the build database
+            compileProject(project, 2, true);
+            expectRebuilt(project, { "main/Helper.vs", "main/Main.vs", "other/Other.vs", "util/Util.vs" });
+            println("    passed");
+        }
+
+        /**
+         * Test the identifier interner and the method lookup by the interned overload signatures.
+         * @param options command line options
+         */
+        void overloads(Options& options) {
+            println("[Test] Overloads");
+
+            // the parser threads intern the same identifiers at the same time, every thread must get the same symbols
+            const uint NAMES = 256, ROUNDS = 16;
+            List<Symbol> symbols(NAMES * ROUNDS);
+            Threads::forEach(NAMES * ROUNDS, 8, [&](uint index) {
+                symbols[index] = Symbols::intern(U"overload" + Strings::toUTF(toString(index % NAMES)));
+            });
+            for (uint i = 0; i < NAMES * ROUNDS; i++) {
+                Symbol expected = Symbols::intern(U"overload" + Strings::toUTF(toString(i % NAMES)));
+                if (symbols[i] != expected)
+                    error("Identifier overload" << (i % NAMES) << " was interned as both " << symbols[i] << " and " << expected);
+                if (Symbols::nameOf(expected) != U"overload" + Strings::toUTF(toString(i % NAMES)))
+                    error("Symbol " << expected << " is named " << Strings::fromUTF(Symbols::nameOf(expected)));
+            }
+            if (Symbols::intern(U"") != EMPTY_SYMBOL)
+                error("The empty identifier was not interned as the empty symbol");
+
+            // the overloads share their name, so only their parameter types select the called method
+            UString source =
+                U"package \"tests\"\n"
+                U"int pick(int a) {\n"
+                U"    return a + 1\n"
+                U"}\n"
+                U"int pick(int a, int b) {\n"
+                U"    return a * b\n"
+                U"}\n"
+                U"int pick(int a, int b, int c) {\n"
+                U"    return a - b - c\n"
+                U"}\n"
+                U"int one(int x) {\n"
+                U"    return pick(x)\n"
+                U"}\n"
+                U"int two(int x) {\n"
+                U"    return pick(x, 3)\n"
+                U"}\n"
+                U"int three(int x) {\n"
+                U"    return pick(x, 3, 4)\n"
+                U"}\n"
+                U"int all(int x) {\n"
+                U"    int sum = 0\n";
+            // enough methods to grow the hashed tables of the package several times
+            for (int i = 0; i < 200; i++)
+                source += U"    sum += method" + Strings::toUTF(toString(i)) + U"(x)\n";
+            source +=
+                U"    return sum\n"
+                U"}\n";
+            for (int i = 0; i < 200; i++) {
+                source +=
+                    U"int method" + Strings::toUTF(toString(i)) + U"(int x) {\n"
+                    U"    return x + " + Strings::toUTF(toString(i)) + U"\n"
+                    U"}\n";
+            }
+
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(Benchmarks::compileSource(source, false), options, heap);
+
+            expectResult(vm, heap, "one", 10, 11);
+            expectResult(vm, heap, "two", 10, 30);
+            expectResult(vm, heap, "three", 10, 3);
+            expectResult(vm, heap, "all", 1, 20100);
+            expectResult(vm, heap, "method199", 1, 200);
+            println("    passed");
+        }
+
+        /**
+         * Test the generated bytecode of the expressions, the local variables and the control flow statements.
+         * @param options command line options
+         */
+        void codegen(Options& options) {
+            println("[Test] Codegen");
+
+            UString source =
+                U"package \"tests\"\n"
+                U"int arithmetic(int x) {\n"
+                U"    int y = x * 3 + 4 / 2 - x % 5\n"
+                U"    y += x * x\n"
+                U"    y -= 7\n"
+                U"    y = y * -1 + (x - 2) * (x + 3)\n"
+                U"    return y\n"
+                U"}\n"
+                U"int branches(int x) {\n"
+                U"    if (x < 0) return -1\n"
+                U"    if (x > 10 && x % 2 == 0) {\n"
+                U"        return 2\n"
+                U"    } else if (x > 10 || x == 5) {\n"
+                U"        return 3\n"
+                U"    } else if (!(x == 7)) {\n"
+                U"        return 4\n"
+                U"    }\n"
+                U"    return 5\n"
+                U"}\n"
+                U"int loops(int n) {\n"
+                U"    int sum = 0\n"
+                U"    int i = 0\n"
+                U"    while (i < n) {\n"
+                U"        sum += i * i\n"
+                U"        i++\n"
+                U"    }\n"
+                U"    do {\n"
+                U"        sum -= 100\n"
+                U"    } while (sum > 1000)\n"
+                U"    return sum\n"
+                U"}\n"
+                U"int counters(int x) {\n"
+                U"    int a = x++\n"
+                U"    int b = x--\n"
+                U"    x--\n"
+                U"    return a * 100 + b * 10 + x\n"
+                U"}\n"
+                U"int scopes(int x) {\n"
+                U"    int total = 0\n"
+                U"    if (x > 0) {\n"
+                U"        int inner = x * 2\n"
+                U"        total += inner\n"
+                U"    }\n"
+                U"    if (x > 1) {\n"
+                U"        int other = x + 1\n"
+                U"        total += other\n"
+                U"    }\n"
+                U"    return total\n"
+                U"}\n"
+                U"bool even(int x) {\n"
+                U"    return x % 2 == 0\n"
+                U"}\n"
+                U"int add(int a, int b) {\n"
+                U"    return a + b\n"
+                U"}\n"
+                U"int fib(int n) {\n"
+                U"    if (n < 2) return n\n"
+                U"    return fib(n - 1) + fib(n - 2)\n"
+                U"}\n"
+                U"int calls(int n) {\n"
+                U"    int parity = 0\n"
+                U"    if (even(n)) parity = 1\n"
+                U"    return add(fib(n), n * 1000) + parity\n"
+                U"}\n";
+
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(Benchmarks::compileSource(source, false), options, heap);
+
+            List<int> arguments = { -7, -1, 0, 1, 2, 5, 7, 9, 12, 13, 20 };
+            expectResults(vm, heap, "arithmetic", arguments, [](int x) {
+                int y = x * 3 + 4 / 2 - x % 5;
+                y += x * x;
+                y -= 7;
+                return y * -1 + (x - 2) * (x + 3);
+            });
+            expectResults(vm, heap, "branches", arguments, [](int x) {
+                if (x < 0)
+                    return -1;
+                if (x > 10 && x % 2 == 0)
+                    return 2;
+                if (x > 10 || x == 5)
+                    return 3;
+                return x != 7 ? 4 : 5;
+            });
+            expectResults(vm, heap, "loops", { 0, 1, 5, 10, 20 }, [](int n) {
+                int sum = 0;
+                for (int i = 0; i < n; i++)
+                    sum += i * i;
+                // the body of the do-while loop runs before the condition is checked
+                do
+                    sum -= 100;
+                while (sum > 1000);
+                return sum;
+            });
+            expectResults(vm, heap, "counters", arguments, [](int x) {
+                return x * 100 + (x + 1) * 10 + (x - 1);
+            });
+            expectResults(vm, heap, "scopes", arguments, [](int x) {
+                return (x > 0 ? x * 2 : 0) + (x > 1 ? x + 1 : 0);
+            });
+            expectResults(vm, heap, "calls", { 0, 1, 2, 7, 10, 15 }, [](int n) {
+                int a = 0, b = 1;
+                for (int i = 0; i < n; i++) {
+                    int t = a + b;
+                    a = b;
+                    b = t;
+                }
+                return a + n * 1000 + (n % 2 == 0);
+            });
+            println("    passed");
+        }
+
+        /**
+         * Test the folding of the constant expressions and the propagation of the constant local variables.
+         * @param options command line options
+         */
+        void folding(Options& options) {
+            println("[Test] Folding");
+
+            String source =
+                "package \"tests\"\n"
+                "int constants(int x) {\n"
+                "    int size = 4 * 8 + 2\n"
+                "    int half = size / 2 - 3 % 2\n"
+                "    return x * size + half\n"
+                "}\n"
+                "int branches(int x) {\n"
+                "    bool debug = false\n"
+                "    int size = 34\n"
+                "    if (debug) {\n"
+                "        return 1\n"
+                "    } else if (size > 30 && !debug) {\n"
+                "        return x + 2\n"
+                "    }\n"
+                "    return 3\n"
+                "}\n"
+                "int reassigned(int x) {\n"
+                "    int step = 5\n"
+                "    int total = step * 2\n"
+                "    if (x > 3) step = x\n"
+                "    total += step\n"
+                "    return total\n"
+                "}\n"
+                "int series(int n) {\n"
+                "    int i = 0\n"
+                "    int sum = 0\n"
+                "    while (i < n) {\n"
+                "        sum += i * (7 - 1) % 4\n"
+                "        i++\n"
+                "    }\n"
+                "    return sum\n"
+                "}\n"
+                "int overflow(int x) {\n"
+                "    int min = -2147483647 - 1\n"
+                "    return min - 1 + x\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "folding", source,
+                { "constants", "branches", "reassigned", "series", "overflow" }, { -5, 0, 1, 3, 4, 10, 100 }, false);
+
+            // the constant locals are replaced by their folded values
+            expectInstruction(bytecode, "constants", "imul -l x -c 34", true);
+            expectInstruction(bytecode, "constants", "idiv", false);
+            // the conditions are known at compile time, so no branch is left
+            expectInstruction(bytecode, "branches", "ifi", false);
+            // a local that is assigned in a branch is not constant after the branch
+            expectInstruction(bytecode, "reassigned", "iadd -l total -l step", true);
+            // a constant subexpression inside a loop is folded too
+            expectInstruction(bytecode, "series", "imul -l i -c 6", true);
+            // the folded integer operations wrap around the same way as the virtual machine
+            expectInstruction(bytecode, "overflow", "iadd -c 2147483647", true);
+            println("    passed");
+        }
+
+        /**
+         * Test the removal of the unreachable statements, the unused local variables and the unreachable methods.
+         * @param options command line options
+         */
+        void deadcode(Options& options) {
+            println("[Test] Deadcode");
+
+            String source =
+                "package \"tests\"\n"
+                "int early(int a) {\n"
+                "    if (a > 2) {\n"
+                "        return 1\n"
+                "    } else {\n"
+                "        return 2\n"
+                "    }\n"
+                "    int dead = a * 99\n"
+                "    return dead\n"
+                "}\n"
+                "int locals(int a) {\n"
+                "    int temp = a * 7\n"
+                "    int other = temp + 3\n"
+                "    return a + 1\n"
+                "}\n"
+                "int never(int a) {\n"
+                "    while (false) {\n"
+                "        a = a * 13\n"
+                "    }\n"
+                "    do {\n"
+                "        a += 5\n"
+                "    } while (false)\n"
+                "    return a\n"
+                "}\n"
+                "int used(int a) {\n"
+                "    int kept = a * 3\n"
+                "    if (a > 0) return kept\n"
+                "    return -kept\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "deadcode", source,
+                { "early", "locals", "never", "used" }, { -3, 0, 1, 2, 3, 50 }, false);
+
+            // the statements after a returning if-else are never executed
+            expectInstruction(bytecode, "early", "imul", false);
+            // the unused locals are removed with their initializers
+            expectInstruction(bytecode, "locals", "imul", false);
+            // a loop with a false condition is removed, and a do-while loop with a false condition runs once
+            expectInstruction(bytecode, "never", "imul", false);
+            expectInstruction(bytecode, "never", "goto", false);
+            // a local that is read on every path is kept
+            expectInstruction(bytecode, "used", "imul", true);
+
+            // the methods, that cannot be reached from the main method, are removed from a program
+            TreeMap<String, String> sources;
+            sources["main/Main.vs"] =
+                "package \"main\"\n"
+                "import \"util\"\n"
+                "int reached(int x) {\n"
+                "    return helper(x) + 1\n"
+                "}\n"
+                "int unreached(int x) {\n"
+                "    return x * 2\n"
+                "}\n"
+                "void main() {\n"
+                "    println(reached(1))\n"
+                "}\n";
+            sources["util/Util.vs"] =
+                "package \"util\"\n"
+                "int helper(int x) {\n"
+                "    return x + 10\n"
+                "}\n"
+                "int spare(int x) {\n"
+                "    return x - 10\n"
+                "}\n";
+            Project project(createProject("deadcode-program", sources));
+            List<String> program = compileProject(project, 1, true);
+            // the reached method is inlined to the main method, so only its call of the other package is kept
+            methodBytecode(program, "main");
+            methodBytecode(program, "helper");
+            for (String& line : program) {
+                if (line == "mdef reached" || line == "mdef unreached" || line == "mdef spare")
+                    error("Unreachable method " << line.substr(5) << " was kept in the program");
+            }
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(program, options, heap);
+            if (int result = callMethod(vm, heap, "<package>util", "helper", 1); result != 11)
+                error("Method helper(1) returned " << result << " instead of 11");
+            println("    passed");
+        }
+
+        /**
+         * Test the replacement of the small method calls with the body of the called method.
+         * @param options command line options
+         */
+        void inlining(Options& options) {
+            println("[Test] Inlining");
+
+            String source =
+                "package \"tests\"\n"
+                "int square(int x) {\n"
+                "    return x * x\n"
+                "}\n"
+                "int clamp(int v, int lo, int hi) {\n"
+                "    int r = v\n"
+                "    if (r < lo) r = lo\n"
+                "    if (r > hi) r = hi\n"
+                "    return r\n"
+                "}\n"
+                "int quad(int x) {\n"
+                "    int s = square(x)\n"
+                "    return square(s)\n"
+                "}\n"
+                "int fact(int n) {\n"
+                "    if (n < 2) return 1\n"
+                "    return n * fact(n - 1)\n"
+                "}\n"
+                "int nested(int x) {\n"
+                "    int q = quad(x)\n"
+                "    int s = square(x)\n"
+                "    return q + clamp(s, 0, 40)\n"
+                "}\n"
+                "int mixed(int x) {\n"
+                "    return quad(x) + clamp(square(x), 0, 40)\n"
+                "}\n"
+                "int effects(int x) {\n"
+                "    int r = square(x++)\n"
+                "    return r * 10 + x\n"
+                "}\n"
+                "int looped(int n) {\n"
+                "    int x = 1\n"
+                "    int total = 0\n"
+                "    while (x < n) {\n"
+                "        x = x + square(2)\n"
+                "        total += clamp(x, 10, 50)\n"
+                "    }\n"
+                "    return total\n"
+                "}\n"
+                "int recursive(int n) {\n"
+                "    return fact(n) + 1\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "inlining", source,
+                { "quad", "nested", "mixed", "effects", "looped", "recursive" }, { -4, 0, 1, 3, 6, 9, 120 }, false);
+
+            // the calls of the inlined methods are replaced with their body, including the nested calls
+            expectInstruction(bytecode, "quad", "invokestatic <package>tests square", false);
+            expectInstruction(bytecode, "nested", "invokestatic", false);
+            expectInstruction(bytecode, "looped", "invokestatic", false);
+            // an expression with multiple calls keeps its calls, as they would have to be reordered
+            expectInstruction(bytecode, "mixed", "invokestatic <package>tests clamp I I I", true);
+            // the argument of an inlined call is evaluated once
+            expectInstruction(bytecode, "effects", "invokestatic", false);
+            // a recursive method is never inlined to itself
+            expectInstruction(bytecode, "fact", "invokestatic <package>tests fact I", true);
+            println("    passed");
+        }
+
+        /**
+         * Test the hoisting of the loop invariant expressions and the stepping of the induction variables.
+         * @param options command line options
+         */
+        void loops(Options& options) {
+            println("[Test] Loops");
+
+            String source =
+                "package \"tests\"\n"
+                "int compute(int n) {\n"
+                "    int a = n % 7 + 1\n"
+                "    int b = n % 5 + 2\n"
+                "    int sum = 0\n"
+                "    int i = 0\n"
+                "    while (i < n) {\n"
+                "        int j = 0\n"
+                "        while (j < 8) {\n"
+                "            sum += a * b - j\n"
+                "            sum = sum + (a + b) * 3\n"
+                "            j = j + 1\n"
+                "        }\n"
+                "        sum = sum % (a * 1000 + 7)\n"
+                "        i += 1\n"
+                "    }\n"
+                "    return sum\n"
+                "}\n"
+                "int variant(int n) {\n"
+                "    int k = n\n"
+                "    int sum = 0\n"
+                "    int i = 0\n"
+                "    while (i < 10) {\n"
+                "        sum += k * 2\n"
+                "        k += i\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return sum\n"
+                "}\n"
+                "int guarded(int n) {\n"
+                "    int d = n - 5\n"
+                "    int sum = 0\n"
+                "    int i = 0\n"
+                "    while (i < d) {\n"
+                "        sum += 100 / d\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return sum\n"
+                "}\n"
+                "int countdown(int n) {\n"
+                "    int sum = 0\n"
+                "    do {\n"
+                "        sum += n * 3\n"
+                "        n = n - 1\n"
+                "    } while (n > 0)\n"
+                "    return sum\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "loops", source,
+                { "compute", "variant", "guarded", "countdown" }, { -2, 0, 1, 3, 5, 6, 40 }, false);
+
+            // the product of the parameters is calculated once, before the outer loop
+            String compute = methodBytecode(bytecode, "compute");
+            ulong product = compute.find("imul -l a -l b");
+            if (product == String::npos || product > compute.find(":loop"))
+                error("The loop invariant a * b was not hoisted before the loops:\n" << compute);
+            // the induction variables are stepped by an increment instead of an addition
+            expectInstruction(bytecode, "compute", "iinc -l j -r j", true);
+            expectInstruction(bytecode, "countdown", "idecr -l n -r n", true);
+            // an expression of a variable, that changes in the loop, is not hoisted
+            String variant = methodBytecode(bytecode, "variant");
+            if (variant.find("imul") < variant.find(":loop"))
+                error("The loop variant k * 2 was hoisted before the loop:\n" << variant);
+            println("    passed");
+        }
+
+        /**
+         * Test the replacement of the non-escaping struct values with the local variables of their members.
+         * @param options command line options
+         */
+        void structs(Options& options) {
+            println("[Test] Structs");
+
+            String source =
+                "package \"tests\"\n"
+                "struct Point(int x, int y)\n"
+                "struct Size {\n"
+                "    int width\n"
+                "    int height\n"
+                "}\n"
+                "int area(int w) {\n"
+                "    let size = new Size { height: w + 1 }\n"
+                "    size.width = w\n"
+                "    return size.width * size.height\n"
+                "}\n"
+                "int copied(int x) {\n"
+                "    let point = new Point(x, 3)\n"
+                "    point.x += 10\n"
+                "    let (a, b) = point\n"
+                "    Point copy = point\n"
+                "    copy.y = 7\n"
+                "    return a * 100 + b * 10 + copy.y + point.y\n"
+                "}\n"
+                "int walk(int n) {\n"
+                "    let p = new Point(0, 0)\n"
+                "    int i = 0\n"
+                "    while (i < n) {\n"
+                "        p.x += i\n"
+                "        if (p.x > 10) p.y += 1\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return p.x * 100 + p.y\n"
+                "}\n";
+
+            // the struct instances cannot be compiled without the optimizations, so the results are checked directly
+            Project project(createProject("structs", { { "tests/Tests.vs", source } }));
+            List<String> bytecode = compileProject(project, 1, true);
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(bytecode, options, heap);
+
+            List<int> arguments = { -3, 0, 1, 4, 9, 20 };
+            // the members that are not set by the initializer are zero
+            expectResults(vm, heap, "area", arguments, [](int w) {
+                return w * (w + 1);
+            });
+            // a struct is copied by value, so the members of the copy are independent
+            expectResults(vm, heap, "copied", arguments, [](int x) {
+                return (x + 10) * 100 + 3 * 10 + 7 + 3;
+            });
+            expectResults(vm, heap, "walk", arguments, [](int n) {
+                int x = 0, y = 0;
+                for (int i = 0; i < n; i++) {
+                    x += i;
+                    if (x > 10)
+                        y++;
+                }
+                return x * 100 + y;
+            });
+
+            // the members are kept in their own local variables instead of an instance
+            expectInstruction(bytecode, "area", "#link size@width", true);
+            expectInstruction(bytecode, "walk", "#link p@x", true);
+            for (String method : { "area", "copied", "walk" })
+                expectInstruction(bytecode, method, "new", false);
+            println("    passed");
+        }
+
+        /**
+         * Test the bytecode generation through the static single assignment intermediate representation.
+         * @param options command line options
+         */
+        void ssa(Options& options) {
+            println("[Test] SSA");
+
+            // the loops, that swap their variables, need the phis of the loop header to be copied in parallel
+            String source =
+                "package \"tests\"\n"
+                "int fib(int n) {\n"
+                "    int a = 0\n"
+                "    int b = 1\n"
+                "    int i = 0\n"
+                "    while (i < n) {\n"
+                "        int t = a\n"
+                "        a = b\n"
+                "        b = t\n"
+                "        b = b + a\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return a\n"
+                "}\n"
+                "int swap(int n) {\n"
+                "    int a = 1\n"
+                "    int b = 2\n"
+                "    int i = 0\n"
+                "    while (i < n) {\n"
+                "        int t = a\n"
+                "        a = b\n"
+                "        b = t\n"
+                "        i += 1\n"
+                "    }\n"
+                "    return a * 10 + b\n"
+                "}\n"
+                "int lost(int n) {\n"
+                "    int x = 1\n"
+                "    int y = 0\n"
+                "    do {\n"
+                "        y = x\n"
+                "        x = x + 2\n"
+                "    } while (x < n)\n"
+                "    return y * 100 + x\n"
+                "}\n"
+                "int branches(int x) {\n"
+                "    int r = 0\n"
+                "    if (x > 10 && x % 3 == 0) {\n"
+                "        r = x * 2\n"
+                "    } else if (x < 0 || x == 4) {\n"
+                "        r = -x\n"
+                "    } else {\n"
+                "        r = x + 100\n"
+                "    }\n"
+                "    return r + x\n"
+                "}\n"
+                "int nested(int n) {\n"
+                "    int total = 0\n"
+                "    int i = 0\n"
+                "    while (i < n) {\n"
+                "        int j = i\n"
+                "        while (j > 0) {\n"
+                "            if (j % 2 == 0) total += j\n"
+                "            else total -= 1\n"
+                "            j = j - 1\n"
+                "        }\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return total\n"
+                "}\n"
+                "int search(int n) {\n"
+                "    int i = 0\n"
+                "    while (i < 100) {\n"
+                "        if (i * i > n) return i\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return -1\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "ssa", source,
+                { "fib", "swap", "lost", "branches", "nested", "search" }, { -4, 0, 1, 2, 3, 4, 7, 12, 30, 20000 }, true);
+
+            // the methods are lowered from the blocks of their graphs
+            for (String method : { "fib", "swap", "lost", "branches", "nested", "search" })
+                expectInstruction(bytecode, method, ":block", true);
+            println("    passed");
+        }
+
+        /**
+         * Test the reuse of the redundant computations by the global value numbering of the intermediate representation.
+         * @param options command line options
+         */
+        void valuenumbering(Options& options) {
+            println("[Test] Value numbering");
+
+            String source =
+                "package \"tests\"\n"
+                "int redundant(int x) {\n"
+                "    int a = x * 3 + 1\n"
+                "    int b = x * 3 + 1\n"
+                "    return a + b\n"
+                "}\n"
+                "int dominated(int x) {\n"
+                "    int a = x * 5\n"
+                "    if (x > 2) {\n"
+                "        int b = x * 5\n"
+                "        return a + b\n"
+                "    }\n"
+                "    return a\n"
+                "}\n"
+                "int sibling(int x) {\n"
+                "    int r = 0\n"
+                "    if (x > 0) {\n"
+                "        r = x * 7\n"
+                "    } else {\n"
+                "        r = 1\n"
+                "    }\n"
+                "    int s = x * 7\n"
+                "    return r + s\n"
+                "}\n"
+                "int changed(int x) {\n"
+                "    int a = x * 2\n"
+                "    x = x + 1\n"
+                "    int b = x * 2\n"
+                "    return a - b\n"
+                "}\n"
+                "int looped(int n) {\n"
+                "    int sum = 0\n"
+                "    int i = 0\n"
+                "    while (i < 5) {\n"
+                "        sum += i * n\n"
+                "        sum += i * n\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return sum\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "valuenumbering", source,
+                { "redundant", "dominated", "sibling", "changed", "looped" }, { -3, 0, 1, 2, 3, 11 }, true);
+
+            // the second computation is replaced by the value of the first one
+            expectInstructions(bytecode, "redundant", "imul", 1);
+            expectInstructions(bytecode, "dominated", "imul", 1);
+            expectInstructions(bytecode, "looped", "imul", 1);
+            // a computation of a block, that does not dominate the other one, is not reused
+            expectInstructions(bytecode, "sibling", "imul", 2);
+            // a reassigned variable is a different value
+            expectInstructions(bytecode, "changed", "imul", 2);
+            println("    passed");
+        }
+
+        /**
+         * Test the packing of the values to the storage slots by their live ranges.
+         * @param options command line options
+         */
+        void slots(Options& options) {
+            println("[Test] Slots");
+
+            String source =
+                "package \"tests\"\n"
+                "int chain(int x) {\n"
+                "    int a = x * 2\n"
+                "    int b = a + 3\n"
+                "    int c = b * 5\n"
+                "    int d = c - 7\n"
+                "    int e = d * 11\n"
+                "    int f = e + 13\n"
+                "    int g = f * 17\n"
+                "    return g - 19\n"
+                "}\n"
+                "int overlap(int x) {\n"
+                "    int a = x * 2\n"
+                "    int b = x * 3\n"
+                "    int c = x * 5\n"
+                "    int d = x * 7\n"
+                "    int e = x * 11\n"
+                "    return a - b + c - d + e\n"
+                "}\n"
+                "int carried(int n) {\n"
+                "    int a = 1\n"
+                "    int b = 2\n"
+                "    int c = 3\n"
+                "    int i = 0\n"
+                "    while (i < n) {\n"
+                "        int t = a + b\n"
+                "        a = b + c\n"
+                "        b = c * 2 - t\n"
+                "        c = t % 1000\n"
+                "        i = i + 1\n"
+                "    }\n"
+                "    return a * 100 + b * 10 + c\n"
+                "}\n";
+
+            List<String> bytecode = expectOptimized(options, "slots", source,
+                { "chain", "overlap", "carried" }, { -5, 0, 1, 2, 9, 25 }, true);
+
+            // each value of the chain dies at the definition of the next one, so they share the slot of the parameter
+            if (uint slots = ensuredSlots(bytecode, "chain"); slots > 1)
+                error("Method chain uses " << slots << " slots instead of 1:\n" << methodBytecode(bytecode, "chain"));
+            // the values, that are live at the same time, need their own slots
+            if (uint slots = ensuredSlots(bytecode, "overlap"); slots < 3)
+                error("Method overlap uses only " << slots << " slots:\n" << methodBytecode(bytecode, "overlap"));
+            // the loop counter is stepped in place
+            expectInstruction(bytecode, "carried", "iinc", true);
+            println("    passed");
+        }
+
+        /**
+         * Test the binding of the virtual call sites by the loaded class hierarchy.
+         * @param options command line options
+         */
+        void devirtualization(Options& options) {
+            println("[Test] Devirtualization");
+
+            // the compiler cannot emit instance calls yet, so the classes are declared in bytecode
+            List<String> bytecode = {
+                "cdef Base",
+                "cbegin",
+                "mdef id", "mreturn I", "mbegin", "ireturn -c 1", "mend",
+                "mdef twice", "mparam I", "mreturn I", "mbegin", "iadd -l 0 -l 0 -r 1", "ireturn -l 1", "mend",
+                "cend",
+                "cdef Dog",
+                "cext Base",
+                "cbegin",
+                "mdef id", "mreturn I", "mbegin", "ireturn -c 2", "mend",
+                "cend",
+                "cdef Leaf",
+                "cext Base",
+                "cbegin",
+                "cend",
+                "cdef Solo",
+                "cmod final",
+                "cbegin",
+                "mdef value", "mreturn I", "mbegin", "ireturn -c 7", "mend",
+                "cend",
+                "cdef <package>tests",
+                "cbegin",
+                // the receiver class is selected by the argument, so the call site sees every class
+                "mdef polymorphic", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link k 0", "#link r 1",
+                "ifi== -l k -c 0 -jump base",
+                "ifi== -l k -c 1 -jump dog",
+                "new Leaf", "astore r", "goto call",
+                ":base", "new Base", "astore r", "goto call",
+                ":dog", "new Dog", "astore r",
+                ":call", "aload r", "invokevirtual Base id", "ireturn",
+                "mend",
+                // no loaded class overrides the method of the leaf class
+                "mdef leaf", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link k 0", "#link r 1",
+                "ifi== -l k -c 0 -jump leaf",
+                "new Puppy", "astore r", "goto call",
+                ":leaf", "new Leaf", "astore r",
+                ":call", "aload r", "invokevirtual Leaf id", "ireturn",
+                "mend",
+                // the inherited method is not overridden by any subclass
+                "mdef twice", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "#link k 0",
+                "new Dog", "iload k", "invokevirtual Base twice I", "ireturn",
+                "mend",
+                // a final class cannot have subclasses
+                "mdef solo", "mmod static", "mparam I", "mreturn I", "mbegin",
+                "new Solo", "invokevirtual Solo value", "ireturn",
+                "mend",
+                "cend"
+            };
+            Stack* heap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* vm = loadProgram(bytecode, options, heap);
+
+            // only the call site of the overridden method needs the receiver class
+            if (vm->virtualSites != 4 || vm->devirtualizedSites != 3)
+                error("Devirtualized " << vm->devirtualizedSites << " of " << vm->virtualSites << " call sites instead of 3 of 4");
+            expectResults(vm, heap, "polymorphic", { 0, 1, 2, 1, 1, 0 }, [](int k) {
+                return k == 1 ? 2 : 1;
+            });
+            // the receiver class changes between the calls, so the cached class misses
+            if (vm->guardMisses < 4)
+                error("The receiver guard missed " << vm->guardMisses << " times instead of at least 4");
+            expectResult(vm, heap, "leaf", 0, 1);
+            expectResult(vm, heap, "twice", 21, 42);
+            expectResult(vm, heap, "solo", 0, 7);
+
+            // a class loaded later overrides the devirtualized method, so the call site has to dispatch again
+            vm->loadBytecode({
+                "cdef Puppy",
+                "cext Leaf",
+                "cbegin",
+                "mdef id", "mreturn I", "mbegin", "ireturn -c 3", "mend",
+                "cend"
+            });
+            vm->getClass("Puppy")->initialize(heap);
+            expectResults(vm, heap, "leaf", { 1, 0, 1 }, [](int k) {
+                return k == 0 ? 1 : 3;
+            });
+            expectResults(vm, heap, "polymorphic", { 0, 1, 2 }, [](int k) {
+                return k == 1 ? 2 : 1;
+            });
+            println("    passed");
+        }
+
+        /**
+         * Check that the source code is split to the expected token values.
+         * @param source raw source code
+         * @param expected token values, in the order of the tokens
+         */
+        void expectTokens(UString source, List<UString> expected) {
+            // the automatic semicolons are not checked
+            List<UString> values;
+            for (Token& token : Benchmarks::tokenize(source)) {
+                if (!token.is(TokenType::Semicolon) && !token.is(TokenType::Finish))
+                    values.push_back(token.value);
+            }
+            if (values != expected)
+                error("Source '" << Strings::fromUTF(source) << "' was tokenized as '" << Strings::fromUTF(Strings::join(values, U" "))
+                    << "' instead of '" << Strings::fromUTF(Strings::join(expected, U" ")) << "'");
+        }
+
+        /**
+         * Check that the source code is parsed without errors.
+         * @param source raw source code
+         */
+        void expectParsed(UString source) {
+            Package* package = new Package(new Application());
+            NodeParser parser(package, Benchmarks::tokenize(source));
+            while (true) {
+                Node* node = parser.next();
+                if (node->is(NodeType::Error))
+                    error("Source '" << Strings::fromUTF(source) << "' could not be parsed");
+                if (node->is(NodeType::Finish))
+                    break;
+            }
+        }
+
+        /**
+         * Call a method of the compiled test source with an integer argument and check its result.
+         * @param vm virtual machine that loaded the test source
+         * @param heap root program stack
+         * @param method name of the called method
+         * @param argument the argument of the method
+         * @param expected the expected result
+         */
+        void expectResult(VirtualMachine* vm, Stack* heap, String method, int argument, int expected) {
+            int result = callMethod(vm, heap, "<package>tests", method, argument);
+            if (result != expected)
+                error("Method " << method << "(" << argument << ") returned " << result << " instead of " << expected);
+        }
+
+        /**
+         * Call a method of the compiled test source with each of the arguments and check its results.
+         * @param vm virtual machine that loaded the test source
+         * @param heap root program stack
+         * @param method name of the called method
+         * @param arguments the arguments to call the method with
+         * @param reference the function that calculates the expected result of an argument
+         */
+        void expectResults(VirtualMachine* vm, Stack* heap, String method, List<int> arguments, Function<int(int)> reference) {
+            for (int argument : arguments)
+                expectResult(vm, heap, method, argument, reference(argument));
+        }
+
+        /**
+         * Call a static method with an integer argument and take its integer result.
+         * @param vm virtual machine that loaded the method
+         * @param heap root program stack
+         * @param className the name of the class of the method
+         * @param method name of the called method
+         * @param argument the argument of the method
+         * @return the result of the method
+         */
+        int callMethod(VirtualMachine* vm, Stack* heap, String className, String method, int argument) {
+            Class* clazz = vm->getClass(className);
+            if (clazz == nullptr)
+                error("Class " << className << " is not loaded");
+            Method* target = clazz->getMethod(method, { "I" });
+            if (target == nullptr)
+                error("Method " << method << "(int) is not declared by class " << className);
+            heap->ints.push(argument);
+            target->invoke(vm, heap, nullptr, nullptr);
+            return heap->ints.pull();
+        }
+
+        /**
+         * Load the bytecode to a new virtual machine, and initialize its classes.
+         * @param bytecode linked bytecode
+         * @param options command line options
+         * @param heap root program stack
+         * @return the virtual machine that loaded the bytecode
+         */
+        VirtualMachine* loadProgram(List<String> bytecode, Options& options, Stack* heap) {
+            VirtualMachine* vm = new VirtualMachine(options);
+            vm->loadBytecode(bytecode);
+            vm->initialize(heap);
+            return vm;
+        }
+
+        /**
+         * Write the source files of a test project to an empty temporary project folder.
+         * @param name the name of the project folder
+         * @param sources the paths of the source files relative to the source folder, and their content
+         * @return project root directory
+         */
+        String createProject(String name, TreeMap<String, String> sources) {
+            // the build database of the previous test run is removed with the folder
+            Path root = FS::temp_directory_path() / ("void-test-" + name);
+            FS::remove_all(root);
+            FS::create_directories(root / "src");
+            FileWriter(root / "build.xml") << "<project></project>\n";
+            for (auto& [path, content] : sources)
+                writeSource(root.generic_string(), path, content);
+            return root.generic_string();
+        }
+
+        /**
+         * Write a source file of a test project, and create its folder if it is missing.
+         * @param projectDir project root directory
+         * @param path the path of the source file relative to the source folder
+         * @param content the content of the source file
+         */
+        void writeSource(String projectDir, String path, String content) {
+            Path file = Path(projectDir) / "src" / path;
+            FS::create_directories(file.parent_path());
+            FileWriter writer(file);
+            if (writer.fail())
+                error("Unable to write file: " << file.generic_string());
+            writer << content;
+        }
+
+        /**
+         * Compile a test project, and strip the indentation of its bytecode, the way the program loader does.
+         * @param project compiled project
+         * @param threads the count of the compiler worker threads
+         * @param rebuild true if the previous build should be ignored
+         * @return linked bytecode
+         */
+        List<String> compileProject(Project& project, uint threads, bool rebuild) {
+            List<UString> compiled;
+            project.compile(compiled, threads, rebuild);
+            List<String> bytecode;
+            for (UString& line : compiled) {
+                String instruction = Strings::fromUTF(line);
+                ulong begin = instruction.find_first_not_of(' ');
+                if (begin != String::npos)
+                    bytecode.push_back(instruction.substr(begin));
+            }
+            return bytecode;
+        }
+
+        /**
+         * Check that the last compilation of the project parsed again exactly the expected source files.
+         * @param project compiled project
+         * @param expected the paths of the rebuilt source files, in source order
+         */
+        void expectRebuilt(Project& project, List<String> expected) {
+            if (project.rebuilt != expected)
+                error("Files [" << Strings::join(project.rebuilt, ", ") << "] were rebuilt instead of ["
+                    << Strings::join(expected, ", ") << "]");
+        }
+
+        /**
+         * Compile a test package without and with the optimizations, and check that the optimized methods
+         * return the same results as the unoptimized ones.
+         * @param options command line options
+         * @param name the name of the project folder
+         * @param source raw source code of the package, that must not have a main method
+         * @param methods the names of the compared methods
+         * @param arguments the arguments to call the methods with
+         * @param ir true if the optimized bytecode should be generated through the intermediate representation
+         * @return optimized linked bytecode
+         */
+        List<String> expectOptimized(Options& options, String name, String source, List<String> methods, List<int> arguments, bool ir) {
+            // without a main method the package is a library, therefore the optimized build keeps every method
+            String projectDir = createProject(name, { { "tests/Tests.vs", source } });
+
+            Project plain(projectDir);
+            plain.optimize = false;
+            Stack* plainHeap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* plainVm = loadProgram(compileProject(plain, 1, true), options, plainHeap);
+
+            Project optimized(projectDir);
+            optimized.ir = ir;
+            List<String> bytecode = compileProject(optimized, 1, true);
+            Stack* optimizedHeap = new Stack(nullptr, nullptr, "Heap");
+            VirtualMachine* optimizedVm = loadProgram(bytecode, options, optimizedHeap);
+
+            for (String& method : methods) {
+                for (int argument : arguments) {
+                    int expected = callMethod(plainVm, plainHeap, "<package>tests", method, argument);
+                    int result = callMethod(optimizedVm, optimizedHeap, "<package>tests", method, argument);
+                    if (result != expected)
+                        error("Optimized method " << method << "(" << argument << ") returned " << result << " instead of " << expected);
+                }
+            }
+            return bytecode;
+        }
+
+        /**
+         * Get the bytecode of a method from the linked bytecode.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @return method bytecode lines joined by new lines
+         */
+        String methodBytecode(List<String>& bytecode, String method) {
+            String result;
+            bool found = false;
+            for (String& line : bytecode) {
+                found |= line == "mdef " + method;
+                if (!found)
+                    continue;
+                result += line + "\n";
+                if (line == "mend")
+                    return result;
+            }
+            error("Method " << method << " is missing from the bytecode");
+        }
+
+        /**
+         * Check if the bytecode of a method contains the given instruction.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @param instruction the searched instruction, with or without its operands
+         * @param expected true if the instruction should be present
+         */
+        void expectInstruction(List<String>& bytecode, String method, String instruction, bool expected) {
+            String body = methodBytecode(bytecode, method);
+            bool found = body.find("\n" + instruction) != String::npos;
+            if (found != expected)
+                error("Instruction '" << instruction << "' is " << (found ? "present in" : "missing from") << " method " 
+                    << method << ":\n" << body);
+        }
+
+        /**
+         * Check how many times the bytecode of a method contains the given instruction.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @param instruction the searched instruction, with or without its operands
+         * @param expected the expected count of the instruction
+         */
+        void expectInstructions(List<String>& bytecode, String method, String instruction, uint expected) {
+            String body = methodBytecode(bytecode, method);
+            uint count = 0;
+            for (ulong index = body.find("\n" + instruction); index != String::npos; index = body.find("\n" + instruction, index + 1))
+                count++;
+            if (count != expected)
+                error("Instruction '" << instruction << "' is present " << count << " times instead of " << expected 
+                    << " in method " << method << ":\n" << body);
+        }
+
+        /**
+         * Get the count of the integer storage slots, that are reserved by a method.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @return the count of the ensured integer slots
+         */
+        uint ensuredSlots(List<String>& bytecode, String method) {
+            String body = methodBytecode(bytecode, method);
+            ulong index = body.find("\niensure ");
+            if (index == String::npos)
+                return 0;
+            return (uint) std::stoul(body.substr(index + 9));
+        }
+    }
+}
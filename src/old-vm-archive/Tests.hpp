@@ -0,0 +1,243 @@
+#pragma once
+
+#include "Common.hpp"
+
+#include "util/Options.hpp"
+
+namespace Compiler {
+    class Project;
+}
+
+namespace Void {
+    class VirtualMachine;
+    class Stack;
+
+    /**
+     * Represents a collection of regression tests of the compiler and the virtual machine. Tests are launched
+     * using the "-test <name>" command line option, and a failing test terminates the launcher with an error.
+     */
+    namespace Tests {
+        /**
+         * Run the test suite with the given name.
+         * @param name test suite name
+         * @param options command line options
+         */
+        void run(String name, Options& options);
+
+        /**
+         * Test the tokenization and the parsing of the operators.
+         * @param options command line options
+         */
+        void operators(Options& options);
+
+        /**
+         * Test the parallel compilation of a project, whose packages are declared by multiple source files.
+         * @param options command line options
+         */
+        void projects(Options& options);
+
+        /**
+         * Test the incremental compilation of a project, that reuses the bytecode of the unchanged source files.
+         * @param options command line options
+         */
+        void rebuild(Options& options);
+
+        /**
+         * Test the identifier interner and the method lookup by the interned overload signatures.
+         * @param options command line options
+         */
+        void overloads(Options& options);
+
+        /**
+         * Test the generated bytecode of the expressions, the local variables and the control flow statements.
+         * @param options command line options
+         */
+        void codegen(Options& options);
+
+        /**
+         * Test the folding of the constant expressions and the propagation of the constant local variables.
+         * @param options command line options
+         */
+        void folding(Options& options);
+
+        /**
+         * Test the removal of the unreachable statements, the unused local variables and the unreachable methods.
+         * @param options command line options
+         */
+        void deadcode(Options& options);
+
+        /**
+         * Test the replacement of the small method calls with the body of the called method.
+         * @param options command line options
+         */
+        void inlining(Options& options);
+
+        /**
+         * Test the hoisting of the loop invariant expressions and the stepping of the induction variables.
+         * @param options command line options
+         */
+        void loops(Options& options);
+
+        /**
+         * Test the replacement of the non-escaping struct values with the local variables of their members.
+         * @param options command line options
+         */
+        void structs(Options& options);
+
+        /**
+         * Test the bytecode generation through the static single assignment intermediate representation.
+         * @param options command line options
+         */
+        void ssa(Options& options);
+
+        /**
+         * Test the reuse of the redundant computations by the global value numbering of the intermediate representation.
+         * @param options command line options
+         */
+        void valuenumbering(Options& options);
+
+        /**
+         * Test the packing of the values to the storage slots by their live ranges.
+         * @param options command line options
+         */
+        void slots(Options& options);
+
+        /**
+         * Test the binding of the virtual call sites by the loaded class hierarchy.
+         * @param options command line options
+         */
+        void devirtualization(Options& options);
+
+        /**
+         * Check that the source code is split to the expected token values.
+         * @param source raw source code
+         * @param expected token values, in the order of the tokens
+         */
+        void expectTokens(UString source, List<UString> expected);
+
+        /**
+         * Check that the source code is parsed without errors.
+         * @param source raw source code
+         */
+        void expectParsed(UString source);
+
+        /**
+         * Call a method of the compiled test source with an integer argument and check its result.
+         * @param vm virtual machine that loaded the test source
+         * @param heap root program stack
+         * @param method name of the called method
+         * @param argument the argument of the method
+         * @param expected the expected result
+         */
+        void expectResult(VirtualMachine* vm, Stack* heap, String method, int argument, int expected);
+
+        /**
+         * Call a method of the compiled test source with each of the arguments and check its results.
+         * @param vm virtual machine that loaded the test source
+         * @param heap root program stack
+         * @param method name of the called method
+         * @param arguments the arguments to call the method with
+         * @param reference the function that calculates the expected result of an argument
+         */
+        void expectResults(VirtualMachine* vm, Stack* heap, String method, List<int> arguments, Function<int(int)> reference);
+
+        /**
+         * Call a static method with an integer argument and take its integer result.
+         * @param vm virtual machine that loaded the method
+         * @param heap root program stack
+         * @param className the name of the class of the method
+         * @param method name of the called method
+         * @param argument the argument of the method
+         * @return the result of the method
+         */
+        int callMethod(VirtualMachine* vm, Stack* heap, String className, String method, int argument);
+
+        /**
+         * Load the bytecode to a new virtual machine, and initialize its classes.
+         * @param bytecode linked bytecode
+         * @param options command line options
+         * @param heap root program stack
+         * @return the virtual machine that loaded the bytecode
+         */
+        VirtualMachine* loadProgram(List<String> bytecode, Options& options, Stack* heap);
+
+        /**
+         * Write the source files of a test project to an empty temporary project folder.
+         * @param name the name of the project folder
+         * @param sources the paths of the source files relative to the source folder, and their content
+         * @return project root directory
+         */
+        String createProject(String name, TreeMap<String, String> sources);
+
+        /**
+         * Write a source file of a test project, and create its folder if it is missing.
+         * @param projectDir project root directory
+         * @param path the path of the source file relative to the source folder
+         * @param content the content of the source file
+         */
+        void writeSource(String projectDir, String path, String content);
+
+        /**
+         * Compile a test project, and strip the indentation of its bytecode, the way the program loader does.
+         * @param project compiled project
+         * @param threads the count of the compiler worker threads
+         * @param rebuild true if the previous build should be ignored
+         * @return linked bytecode
+         */
+        List<String> compileProject(Compiler::Project& project, uint threads, bool rebuild);
+
+        /**
+         * Check that the last compilation of the project parsed again exactly the expected source files.
+         * @param project compiled project
+         * @param expected the paths of the rebuilt source files, in source order
+         */
+        void expectRebuilt(Compiler::Project& project, List<String> expected);
+
+        /**
+         * Compile a test package without and with the optimizations, and check that the optimized methods
+         * return the same results as the unoptimized ones.
+         * @param options command line options
+         * @param name the name of the project folder
+         * @param source raw source code of the package, that must not have a main method
+         * @param methods the names of the compared methods
+         * @param arguments the arguments to call the methods with
+         * @param ir true if the optimized bytecode should be generated through the intermediate representation
+         * @return optimized linked bytecode
+         */
+        List<String> expectOptimized(Options& options, String name, String source, List<String> methods, List<int> arguments, bool ir);
+
+        /**
+         * Get the bytecode of a method from the linked bytecode.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @return method bytecode lines joined by new lines
+         */
+        String methodBytecode(List<String>& bytecode, String method);
+
+        /**
+         * Check if the bytecode of a method contains the given instruction.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @param instruction the searched instruction, with or without its operands
+         * @param expected true if the instruction should be present
+         */
+        void expectInstruction(List<String>& bytecode, String method, String instruction, bool expected);
+
+        /**
+         * Check how many times the bytecode of a method contains the given instruction.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @param instruction the searched instruction, with or without its operands
+         * @param expected the expected count of the instruction
+         */
+        void expectInstructions(List<String>& bytecode, String method, String instruction, uint expected);
+
+        /**
+         * Get the count of the integer storage slots, that are reserved by a method.
+         * @param bytecode linked bytecode
+         * @param method method name
+         * @return the count of the ensured integer slots
+         */
+        uint ensuredSlots(List<String>& bytecode, String method);
+    }
+}
@@ -0,0 +1,126 @@
+// pugixml has to be included before the common macros, because it declares a method named "print"
+#include "xml/PugiXml.hpp"
+
+#include "BuildDatabase.hpp"
+
+#include "../util/Files.hpp"
+#include "../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Initialize the build database.
+     * @param file database file path
+     */
+    BuildDatabase::BuildDatabase(String file)
+        : file(file)
+    { }
+
+    /**
+     * Load the list of strings from the children of an xml node.
+     * @param node parent xml node
+     * @param name child node name
+     * @param result loaded strings
+     */
+    static void loadList(pugi::xml_node node, const char* name, List<UString>& result) {
+        for (pugi::xml_node child : node.children(name))
+            result.push_back(Strings::toUTF(child.text().get()));
+    }
+
+    /**
+     * Save the list of strings as the children of an xml node.
+     * @param node parent xml node
+     * @param name child node name
+     * @param values strings to be saved
+     */
+    static void saveList(pugi::xml_node node, const char* name, List<UString>& values) {
+        for (UString& value : values)
+            node.append_child(name).text().set(Strings::fromUTF(value).c_str());
+    }
+
+    /**
+     * Load the build records of the previous compilation. Nothing is loaded if the file does not exist.
+     */
+    void BuildDatabase::load() {
+        records.clear();
+        if (!Files::exists(file))
+            return;
+
+        // parse the database file, ignore it if it is corrupted,
+        // the project will be fully rebuilt in that case
+        pugi::xml_document document;
+        if (!document.load_file(file.c_str())) {
+            warn("Unable to read build database " << file << ", rebuilding all files.");
+            return;
+        }
+
+        // <file path="main/Main.vs" hash="..." package="main" named="true">
+        for (pugi::xml_node node : document.child("build").children("file")) {
+            BuildRecord record;
+            record.path = node.attribute("path").as_string();
+            record.hash = (ulong) node.attribute("hash").as_ullong();
+            record.package = Strings::toUTF(node.attribute("package").as_string());
+            record.named = node.attribute("named").as_bool();
+            loadList(node.child("exports"), "export", record.exports);
+            loadList(node.child("imports"), "import", record.imports);
+            loadList(node.child("types"), "i", record.types);
+            loadList(node.child("methods"), "i", record.methods);
+            records[record.path] = record;
+        }
+    }
+
+    /**
+     * Write the build records to the database file.
+     */
+    void BuildDatabase::save() {
+        pugi::xml_document document;
+        pugi::xml_node root = document.append_child("build");
+
+        // sort the records, so that the database file changes only where the sources did
+        List<String> paths;
+        for (auto& [path, _] : records)
+            paths.push_back(path);
+        std::sort(paths.begin(), paths.end());
+
+        for (String& path : paths) {
+            BuildRecord& record = records[path];
+            pugi::xml_node node = root.append_child("file");
+            node.append_attribute("path").set_value(record.path.c_str());
+            node.append_attribute("hash").set_value((unsigned long long) record.hash);
+            node.append_attribute("package").set_value(Strings::fromUTF(record.package).c_str());
+            node.append_attribute("named").set_value(record.named);
+            saveList(node.append_child("exports"), "export", record.exports);
+            saveList(node.append_child("imports"), "import", record.imports);
+            saveList(node.append_child("types"), "i", record.types);
+            saveList(node.append_child("methods"), "i", record.methods);
+        }
+
+        if (!document.save_file(file.c_str()))
+            error("Unable to write build database: " << file);
+    }
+
+    /**
+     * Get the build record of a source file.
+     * @param path relative source file path
+     * @return found build record or nullptr if the file was not compiled before
+     */
+    BuildRecord* BuildDatabase::getRecord(String path) {
+        auto it = records.find(path);
+        return it != records.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * Calculate the hash of a source file content.
+     * @param content raw file content
+     * @return 64-bit FNV-1a hash of the content
+     */
+    ulong BuildDatabase::hash(String& content) {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (char c : content) {
+            hash ^= (unsigned char) c;
+            hash *= 1099511628211ULL;
+        }
+        return (ulong) hash;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../Common.hpp"
+
+namespace Compiler {
+    /**
+     * Represents the build information of a single source file, that is kept between compilations.
+     */
+    class BuildRecord {
+    public:
+        /**
+         * The path of the source file relative to the source folder.
+         */
+        String path;
+
+        /**
+         * The hash of the source file content.
+         */
+        ulong hash = 0;
+
+        /**
+         * The name of the package declared by the source file.
+         */
+        UString package;
+
+        /**
+         * Determine if the source file has explicitly declared its package.
+         */
+        bool named = false;
+
+        /**
+         * The signatures of the declarations exposed by the source file.
+         */
+        List<UString> exports;
+
+        /**
+         * The targets of the imports of the source file.
+         */
+        List<UString> imports;
+
+        /**
+         * The compiled bytecode of the types declared by the source file.
+         */
+        List<UString> types;
+
+        /**
+         * The compiled bytecode of the package methods declared by the source file.
+         */
+        List<UString> methods;
+    };
+
+    /**
+     * Represents a persistent storage of the previous project build, that makes incremental compilation possible.
+     * The database is stored as an xml file next to the build file of the project.
+     */
+    class BuildDatabase {
+    private:
+        /**
+         * The path of the database file.
+         */
+        String file;
+
+    public:
+        /**
+         * The map of the source file build records, keyed by the relative source file path.
+         */
+        Map<String, BuildRecord> records;
+
+        /**
+         * Initialize the build database.
+         * @param file database file path
+         */
+        BuildDatabase(String file);
+
+        /**
+         * Load the build records of the previous compilation. Nothing is loaded if the file does not exist.
+         */
+        void load();
+
+        /**
+         * Write the build records to the database file.
+         */
+        void save();
+
+        /**
+         * Get the build record of a source file.
+         * @param path relative source file path
+         * @return found build record or nullptr if the file was not compiled before
+         */
+        BuildRecord* getRecord(String path);
+
+        /**
+         * Calculate the hash of a source file content.
+         * @param content raw file content
+         * @return 64-bit FNV-1a hash of the content
+         */
+        static ulong hash(String& content);
+    };
+}
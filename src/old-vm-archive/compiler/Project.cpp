@@ -1,6 +1,21 @@
 #include "Project.hpp"
 
 #include "../util/Files.hpp"
+#include "../util/Threads.hpp"
+#include "../util/Strings.hpp"
+
+#include "token/Tokenizer.hpp"
+#include "token/Transformer.hpp"
+#include "node/NodeParser.hpp"
+#include "builder/NodeBuilder.hpp"
+#include "optimizer/MethodInliner.hpp"
+#include "optimizer/ScalarReplacer.hpp"
+#include "optimizer/ConstantFolder.hpp"
+#include "optimizer/LoopOptimizer.hpp"
+#include "optimizer/DeadCodeEliminator.hpp"
+#include "optimizer/ReachabilityAnalyzer.hpp"
+
+#include <algorithm>
 
 using namespace Void;
 
@@ -12,7 +27,8 @@ namespace Compiler {
     Project::Project(String projectDir) 
         : projectDir(projectDir), 
           sourceDir(Files::combine(projectDir, "src")),
-          buildFile(Files::combine(projectDir, "build.xml"))
+          buildFile(Files::combine(projectDir, "build.xml")),
+          databaseFile(Files::combine(projectDir, "build.db.xml"))
     { }
 
     /**
@@ -32,4 +48,421 @@ namespace Compiler {
         if (!Files::exists(buildFile))
             error("Project root is missing build file: " << buildFile);
     }
-}
\ No newline at end of file
+
+    /**
+     * Compile all the project source files to executable bytecode.
+     * Only the files that have changed since the previous build and the files depending on them are parsed again,
+     * the bytecode of the other files is reused from the build database.
+     * The source files are parsed on multiple threads, then the packages are merged to the application.
+     * Cross-package resolution and bytecode generation are run in parallel as well, once all files are parsed.
+     * @param bytecode executable bytecode result
+     * @param threads the count of the compiler worker threads
+     * @param rebuild true if the previous build should be ignored
+     */
+    void Project::compile(List<UString>& bytecode, uint threads, bool rebuild) {
+        auto begin = currentTimeMillis();
+        Application* application = new Application();
+
+        // load the information of the previous build
+        BuildDatabase database(databaseFile);
+        if (!rebuild)
+            database.load();
+
+        // read the source files and check which of them have changed since the previous build
+        List<Path> sources = collectSources();
+        List<SourceFile> files(sources.size());
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            file.path = sources[index];
+            file.name = FS::relative(file.path, sourceDir).generic_string();
+            file.content = Files::readAll(file.path.generic_string());
+            file.hash = BuildDatabase::hash(file.content);
+            file.record = database.getRecord(file.name);
+            file.rebuild = file.record == nullptr || file.record->hash != file.hash;
+        });
+
+        // parse the changed source files on the worker threads
+        // each file is parsed to its own package, so the workers do not share any state
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            if (files[index].rebuild)
+                files[index].package = parseSource(application, files[index]);
+        });
+        reportDiagnostics(files);
+        uint changed = 0;
+        for (SourceFile& file : files)
+            changed += file.rebuild;
+
+        // parse the unchanged files that depend on a package which declarations have changed
+        markDependents(files, database);
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            if (files[index].rebuild && files[index].package == nullptr)
+                files[index].package = parseSource(application, files[index]);
+        });
+        reportDiagnostics(files);
+
+        // declare the previous exports of the reused files, so that the other files can still resolve them
+        uint reused = 0;
+        for (SourceFile& file : files) {
+            if (file.rebuild)
+                continue;
+            Package* package = new Package(application);
+            if (file.record->named) {
+                package->name = file.record->package;
+                package->named = true;
+            }
+            package->restoreExports(file.record->exports);
+            file.package = package;
+            reused++;
+        }
+        auto parsed = currentTimeMillis();
+
+        // merge the source file packages to the application in source order
+        List<Package*> packages;
+        List<Package*> registered;
+        for (SourceFile& file : files) {
+            Package* package = application->registerPackage(file.package);
+            registered.push_back(package);
+            if (!(contains(packages, package)))
+                packages.push_back(package);
+        }
+
+        // resolve the imports and the signature types of the registered packages
+        // all the packages are registered at this point, therefore they can be resolved independently
+        Threads::forEach((uint) packages.size(), threads, [&](uint index) {
+            packages[index]->resolve();
+        });
+        auto resolved = currentTimeMillis();
+
+        // optimize the methods of the rebuilt files before their bytecode is generated
+        // the optimizations run after the resolution, as the inlining has to find the called methods
+        if (optimize)
+            optimizeMethods(files, threads);
+        auto optimized = currentTimeMillis();
+
+        // generate the bytecode of the rebuilt files, the other files keep their previous bytecode
+        List<BuildRecord> records(files.size());
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            BuildRecord& record = records[index];
+            if (!file.rebuild) {
+                record = *file.record;
+                return;
+            }
+            record.path = file.name;
+            record.hash = file.hash;
+            record.package = file.package->name;
+            record.named = file.package->named;
+            record.exports = file.package->getExports();
+            for (auto& [_, target] : file.package->imports)
+                record.imports.push_back(target);
+            file.package->compileTypes(record.types);
+            // each source file has its own pass manager, so the workers do not share the statistics of the passes
+            if (ir) {
+                file.passes = new PassManager(dumps);
+                file.package->compileMethods(record.methods, file.passes);
+            }
+            else
+                file.package->compileMethods(record.methods);
+        });
+
+        // print the dumped graphs in the order of the source files, once all the workers are finished
+        PassManager passes(dumps);
+        for (SourceFile& file : files) {
+            if (file.passes == nullptr)
+                continue;
+            print(file.passes->output.str());
+            passes.merge(file.passes);
+        }
+
+        // link the bytecode of the source files package by package
+        for (Package* package : packages) {
+            List<UString> methods;
+            for (uint i = 0; i < files.size(); i++) {
+                if (registered[i] != package)
+                    continue;
+                bytecode.insert(bytecode.end(), records[i].types.begin(), records[i].types.end());
+                methods.insert(methods.end(), records[i].methods.begin(), records[i].methods.end());
+            }
+            // create an anonymus class for storing package methods
+            if (methods.empty())
+                continue;
+            bytecode.push_back(U"cdef <package>" + package->name);
+            bytecode.push_back(U"cbegin");
+            bytecode.insert(bytecode.end(), methods.begin(), methods.end());
+            bytecode.push_back(U"cend");
+        }
+
+        // remove the methods and classes that cannot be reached from the main method of the program
+        // the bytecode of the reused files is kept in full in the build database, as a later change may call them
+        ReachabilityAnalyzer analyzer;
+        if (optimize)
+            analyzer.prune(bytecode);
+        auto compiled = currentTimeMillis();
+
+        // store the information of this build for the next compilation
+        uint removed = 0;
+        for (auto& [path, _] : database.records) {
+            bool found = false;
+            for (SourceFile& file : files)
+                found |= file.name == path;
+            removed += !found;
+        }
+        database.records.clear();
+        for (BuildRecord& record : records)
+            database.records[record.path] = record;
+        database.save();
+
+        println("Compiled " << files.size() << " source files to " << packages.size() << " packages using " 
+            << threads << " threads in " << (compiled - begin) << "ms");
+        println("    rebuilt: " << (files.size() - reused) << " (" << changed << " changed, " 
+            << (files.size() - reused - changed) << " dependent), reused: " << reused << ", removed: " << removed);
+        println("    parse: " << (parsed - begin) << "ms, resolve: " << (resolved - parsed) 
+            << "ms, optimize: " << (optimized - resolved) << "ms, bytecode: " << (compiled - optimized) << "ms");
+        if (optimize) {
+            uint inlined = 0, replaced = 0, folded = 0, propagated = 0, branches = 0, hoisted = 0, stepped = 0, unreachable = 0, unused = 0;
+            for (SourceFile& file : files) {
+                inlined += file.inlined;
+                replaced += file.replaced;
+                folded += file.folded;
+                propagated += file.propagated;
+                branches += file.branches;
+                hoisted += file.hoisted;
+                stepped += file.stepped;
+                unreachable += file.unreachable;
+                unused += file.unused;
+            }
+            println("    optimized: " << inlined << " calls inlined, " << replaced << " structs replaced, " << folded << " operations folded, " 
+                << propagated << " constants propagated, " << branches << " branches removed");
+            println("    loops: " << hoisted << " invariants hoisted, " << stepped << " induction variables stepped");
+            println("    removed: " << unreachable << " unreachable statements, " << unused << " unused locals, " 
+                << analyzer.removedMethods << " unused methods, " << analyzer.removedClasses << " unused classes");
+        }
+        if (ir)
+            println("    ir: " << passes.methods << " methods, " << passes.report());
+        rebuilt.clear();
+        for (SourceFile& file : files) {
+            if (!file.rebuild)
+                continue;
+            println("    rebuilt " << file.name);
+            rebuilt.push_back(file.name);
+        }
+    }
+
+    /**
+     * Run the optimization passes on the methods of the rebuilt source files.
+     * Each pass is run on all the files before the next pass is started, so that the result of a pass can be dumped.
+     * @param files project source files
+     * @param threads the count of the compiler worker threads
+     */
+    void Project::optimizeMethods(List<SourceFile>& files, uint threads) {
+        // replace the calls of the small methods with their body, so that the folding can use the constant arguments
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            if (!file.rebuild)
+                return;
+            MethodInliner inliner(file.package);
+            inliner.inlineCalls();
+            file.inlined = inliner.inlined;
+        });
+        dump(files, "inline");
+
+        // keep the structs that do not escape their method in separate member variables instead of instances
+        // the members of the inlined struct parameters are copied the same way, therefore this runs after the inlining
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            if (!file.rebuild)
+                return;
+            ScalarReplacer replacer(file.package);
+            replacer.replace();
+            file.replaced = replacer.replaced;
+        });
+        dump(files, "scalar");
+
+        // evaluate the constant expressions and remove the branches that are never executed
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            if (!file.rebuild)
+                return;
+            ConstantFolder folder(file.package);
+            folder.fold();
+            file.folded = folder.folded;
+            file.propagated = folder.propagated;
+            file.branches = folder.branches;
+        });
+        dump(files, "fold");
+
+        // move the invariant calculations out of the loops, once the folding has simplified them
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            if (!file.rebuild)
+                return;
+            LoopOptimizer optimizer(file.package);
+            optimizer.optimize();
+            file.hoisted = optimizer.hoisted;
+            file.stepped = optimizer.stepped;
+        });
+        dump(files, "loop");
+
+        // remove the statements after the returns and the variables that became unused by the folding
+        Threads::forEach((uint) files.size(), threads, [&](uint index) {
+            SourceFile& file = files[index];
+            if (!file.rebuild)
+                return;
+            DeadCodeEliminator eliminator(file.package);
+            eliminator.eliminate();
+            file.unreachable = eliminator.statements;
+            file.unused = eliminator.locals;
+        });
+        dump(files, "dce");
+    }
+
+    /**
+     * Print the methods of the rebuilt source files, if the dump of the given optimization pass is requested.
+     * @param files project source files
+     * @param pass optimization pass name
+     */
+    void Project::dump(List<SourceFile>& files, String pass) {
+        if (!(contains(dumps, pass)))
+            return;
+        for (SourceFile& file : files) {
+            if (!file.rebuild)
+                continue;
+            println("[" << pass << "] " << file.name);
+            for (MethodNode* method : file.package->methods) {
+                uint index = 0;
+                method->debug(index);
+            }
+        }
+    }
+
+    /**
+     * Find the files that have to be rebuilt, because a package they depend on has changed its declarations.
+     * @param files project source files
+     * @param database previous build information
+     */
+    void Project::markDependents(List<SourceFile>& files, BuildDatabase& database) {
+        // collect the packages whose declarations have changed
+        List<UString> changed;
+        for (SourceFile& file : files) {
+            if (!file.rebuild)
+                continue;
+            BuildRecord* record = file.record;
+            Package* package = file.package;
+            if (record != nullptr && record->exports == package->getExports() && record->package == package->name)
+                continue;
+            if (package->named && !(contains(changed, package->name)))
+                changed.push_back(package->name);
+            if (record != nullptr && record->named && !(contains(changed, record->package)))
+                changed.push_back(record->package);
+        }
+
+        // the declarations of the removed files are not available anymore
+        for (auto& [path, record] : database.records) {
+            bool found = false;
+            for (SourceFile& file : files)
+                found |= file.name == path;
+            if (!found && record.named && !(contains(changed, record.package)))
+                changed.push_back(record.package);
+        }
+
+        // mark the unchanged files that use a changed package
+        for (SourceFile& file : files) {
+            if (file.rebuild)
+                continue;
+            BuildRecord* record = file.record;
+            // the files of the same package see each other's declarations
+            if (record->named && contains(changed, record->package)) {
+                file.rebuild = true;
+                continue;
+            }
+            // check if an imported package has changed
+            for (UString& target : record->imports) {
+                for (UString& name : Package::getImportedNames(target))
+                    file.rebuild |= contains(changed, name);
+            }
+        }
+    }
+
+    /**
+     * Collect the source files of the project.
+     * @return the paths of the source files in a consistent order
+     */
+    List<Path> Project::collectSources() {
+        List<Path> files;
+        Files::walk(sourceDir, files);
+
+        // keep the void source files only
+        List<Path> sources;
+        for (Path& file : files) {
+            if (file.extension() == ".vs")
+                sources.push_back(file);
+        }
+
+        // the directory walk order depends on the file system,
+        // sort the files so that the packages are always merged in the same order
+        std::sort(sources.begin(), sources.end());
+        return sources;
+    }
+
+    /**
+     * Tokenize and parse a source file, then build its declarations to a new package.
+     * @param application parent application
+     * @param file target source file
+     * @return parsed source file package
+     */
+    Package* Project::parseSource(Application* application, SourceFile& file) {
+        // split up the source code to raw tokens
+        Tokenizer tokenizer(Strings::toUTF(file.content));
+        List<Token> tokens;
+        while (true) {
+            Token token = tokenizer.next();
+            if (!token.hasNext())
+                break;
+            tokens.push_back(token);
+        }
+        tokens.push_back(Token::of(TokenType::NewLine));
+
+        // insert the automatic semicolons and remove the comments
+        Transformer transformer(tokens);
+        tokens = transformer.transform();
+
+        // parse the tokens to nodes
+        // the parsed declarations are not printed, as the output of the workers would be interleaved
+        Package* package = new Package(application);
+        NodeParser parser(package, tokens, false);
+        List<Node*> nodes;
+        while (true) {
+            Node* node = parser.next();
+            // the worker cannot stop the compilation, the error is reported once every file is parsed
+            if (node->is(NodeType::Error)) {
+                file.diagnostic = "Unable to parse source file: " + file.name;
+                return package;
+            }
+            if (node->is(NodeType::Finish))
+                break;
+            nodes.push_back(node);
+        }
+
+        // build the declarations of the source file
+        NodeBuilder builder(package, nodes);
+        builder.build();
+        return package;
+    }
+
+    /**
+     * Report the errors of the parsed source files and stop the compilation if there were any.
+     * Should be called from the main thread, once the parser workers are finished.
+     * @param files parsed source files
+     */
+    void Project::reportDiagnostics(List<SourceFile>& files) {
+        uint failed = 0;
+        for (SourceFile& file : files) {
+            if (file.diagnostic.empty())
+                continue;
+            println(file.diagnostic);
+            failed++;
+        }
+        if (failed > 0)
+            error("Compilation failed, " << failed << " source files could not be parsed.");
+    }
+}
@@ -2,7 +2,108 @@
 
 #include "../Common.hpp"
 
+#include "builder/Application.hpp"
+#include "builder/Package.hpp"
+#include "BuildDatabase.hpp"
+#include "ir/PassManager.hpp"
+
 namespace Compiler {
+    /**
+     * Represents the compilation state of a single project source file.
+     */
+    class SourceFile {
+    public:
+        /**
+         * The path of the source file.
+         */
+        Path path;
+
+        /**
+         * The path of the source file relative to the source folder.
+         */
+        String name;
+
+        /**
+         * The raw content of the source file.
+         */
+        String content;
+
+        /**
+         * The hash of the source file content.
+         */
+        ulong hash = 0;
+
+        /**
+         * The build record of the previous compilation, nullptr if the file is new.
+         */
+        BuildRecord* record = nullptr;
+
+        /**
+         * The package built from the source file.
+         */
+        Package* package = nullptr;
+
+        /**
+         * Determine if the source file has to be parsed and compiled again.
+         */
+        bool rebuild = false;
+
+        /**
+         * The error that stopped the parsing of the source file, empty if the file has been parsed successfully.
+         */
+        String diagnostic;
+
+        /**
+         * The count of the method calls of the source file that were replaced by the body of the called method.
+         */
+        uint inlined = 0;
+
+        /**
+         * The count of the struct values of the source file that were replaced by local variables of their members.
+         */
+        uint replaced = 0;
+
+        /**
+         * The count of the operations of the source file that were replaced by their result.
+         */
+        uint folded = 0;
+
+        /**
+         * The count of the local variable reads of the source file that were replaced by a constant value.
+         */
+        uint propagated = 0;
+
+        /**
+         * The count of the if cases of the source file that were removed or made unconditional.
+         */
+        uint branches = 0;
+
+        /**
+         * The count of the loop invariant expressions of the source file that were moved before their loop.
+         */
+        uint hoisted = 0;
+
+        /**
+         * The count of the induction variable updates of the source file that were rewritten to increments.
+         */
+        uint stepped = 0;
+
+        /**
+         * The count of the unreachable statements of the source file that were removed.
+         */
+        uint unreachable = 0;
+
+        /**
+         * The count of the unused local variables of the source file that were removed.
+         */
+        uint unused = 0;
+
+        /**
+         * The pass manager that generated the bytecode of the source file through the intermediate representation.
+         */
+        PassManager* passes = nullptr;
+    };
+
     /**
      * Represents a Void project which transforms source files to executable bytecode.
      * This class takes care of dependencies and project settings as well.
@@ -29,7 +130,32 @@ namespace Compiler {
          */
         String buildFile;
 
+        /**
+         * The file which stores the information of the previous build, used for incremental compilation.
+         */
+        String databaseFile;
+
     public:
+        /**
+         * Determine if the parsed methods should be optimized before generating their bytecode.
+         */
+        bool optimize = true;
+
+        /**
+         * Determine if the bytecode of the methods should be generated through the intermediate representation.
+         */
+        bool ir = false;
+
+        /**
+         * The names of the optimization passes whose resulting nodes are printed to the console.
+         */
+        List<String> dumps;
+
+        /**
+         * The paths of the source files relative to the source folder, that were parsed again by the last compilation.
+         */
+        List<String> rebuilt;
+
         /**
          * Initialize the project.
          * @param projectDir project root directory
@@ -41,5 +167,60 @@ namespace Compiler {
          * @return true if all the requires files exists
          */
         void validate();
+
+        /**
+         * Compile all the project source files to executable bytecode.
+         * Only the files that have changed since the previous build and the files depending on them are parsed again,
+         * the bytecode of the other files is reused from the build database.
+         * The source files are parsed on multiple threads, then the packages are merged to the application.
+         * Cross-package resolution and bytecode generation are run in parallel as well, once all files are parsed.
+         * @param bytecode executable bytecode result
+         * @param threads the count of the compiler worker threads
+         * @param rebuild true if the previous build should be ignored
+         */
+        void compile(List<UString>& bytecode, uint threads, bool rebuild);
+
+        /**
+         * Collect the source files of the project.
+         * @return the paths of the source files in a consistent order
+         */
+        List<Path> collectSources();
+
+        /**
+         * Tokenize and parse a source file, then build its declarations to a new package.
+         * @param application parent application
+         * @param file target source file
+         * @return parsed source file package
+         */
+        Package* parseSource(Application* application, SourceFile& file);
+
+        /**
+         * Report the errors of the parsed source files and stop the compilation if there were any.
+         * Should be called from the main thread, once the parser workers are finished.
+         * @param files parsed source files
+         */
+        void reportDiagnostics(List<SourceFile>& files);
+
+        /**
+         * Run the optimization passes on the methods of the rebuilt source files.
+         * Each pass is run on all the files before the next pass is started, so that the result of a pass can be dumped.
+         * @param files project source files
+         * @param threads the count of the compiler worker threads
+         */
+        void optimizeMethods(List<SourceFile>& files, uint threads);
+
+        /**
+         * Print the methods of the rebuilt source files, if the dump of the given optimization pass is requested.
+         * @param files project source files
+         * @param pass optimization pass name
+         */
+        void dump(List<SourceFile>& files, String pass);
+
+        /**
+         * Find the files that have to be rebuilt, because a package they depend on has changed its declarations.
+         * @param files project source files
+         * @param database previous build information
+         */
+        void markDependents(List<SourceFile>& files, BuildDatabase& database);
     };
 }
\ No newline at end of file
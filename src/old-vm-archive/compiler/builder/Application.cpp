@@ -1,5 +1,34 @@
 #include "Application.hpp"
 
 namespace Compiler {
+    /**
+     * Register a parsed source file package in the application.
+     * Source files declaring the same package name are merged to a single package.
+     * @param package parsed source file package
+     * @return the registered package that holds the content of the source file
+     */
+    Package* Application::registerPackage(Package* package) {
+        // create the package if no other source file has declared it yet
+        // the source file package is kept untouched, so it can be compiled on its own
+        Package* target = getPackage(package->name);
+        if (target == nullptr) {
+            target = new Package(this);
+            target->name = package->name;
+            target->named = package->named;
+            packages[package->name] = target;
+        }
+        // merge the content of the source file into the registered package
+        target->merge(package);
+        return target;
+    }
 
-}
\ No newline at end of file
+    /**
+     * Get a registered package by its name.
+     * @param name target package name
+     * @return found package or nullptr if not found
+     */
+    Package* Application::getPackage(UString name) {
+        auto it = packages.find(name);
+        return it != packages.end() ? it->second : nullptr;
+    }
+}
@@ -11,5 +11,20 @@ namespace Compiler {
          * The map of the registered packages.
          */
         Map<UString, Package*> packages;
+
+        /**
+         * Register a parsed source file package in the application.
+         * Source files declaring the same package name are merged to a single package.
+         * @param package parsed source file package
+         * @return the registered package that holds the content of the source file
+         */
+        Package* registerPackage(Package* package);
+
+        /**
+         * Get a registered package by its name.
+         * @param name target package name
+         * @return found package or nullptr if not found
+         */
+        Package* getPackage(UString name);
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,1243 @@
+#include "MethodBuilder.hpp"
+
+#include <algorithm>
+
+#include "../optimizer/NodeWalker.hpp"
+#include "../../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the instruction prefix of the given type descriptor.
+     * @param type value type descriptor
+     * @return instruction prefix
+     */
+    static UString getPrefix(char type) {
+        switch (type) {
+            case 'I':
+                return U"i";
+            case 'J':
+                return U"l";
+            case 'F':
+                return U"f";
+            case 'D':
+                return U"d";
+        }
+        error("Instance values are not supported by the code generator yet.");
+        return U"";
+    }
+
+    /**
+     * Get the conversion rank of the given type descriptor. Constants can be used as any type with a higher rank.
+     * @param type value type descriptor
+     * @return type rank
+     */
+    static int getRank(char type) {
+        switch (type) {
+            case 'I':
+                return 0;
+            case 'J':
+                return 1;
+            case 'F':
+                return 2;
+            case 'D':
+                return 3;
+        }
+        return 4;
+    }
+
+    /**
+     * Get the type of an operation with the given operand types.
+     * @param left first operand type
+     * @param right second operand type
+     * @return wider operand type
+     */
+    static char promote(char left, char right) {
+        return getRank(left) >= getRank(right) ? left : right;
+    }
+
+    /**
+     * Get the arithmetic operator that is performed by a compound assignment.
+     * @param operatorType compound assignment operator
+     * @return arithmetic operator, or None if the operator is not an arithmetic compound assignment
+     */
+    static OperatorType getCompoundOperator(OperatorType operatorType) {
+        switch (operatorType) {
+            case OperatorType::AddAssign:
+                return OperatorType::Add;
+            case OperatorType::SubtractAssign:
+                return OperatorType::Subtract;
+            case OperatorType::MultiplyAssign:
+                return OperatorType::Multiply;
+            case OperatorType::DivideAssign:
+                return OperatorType::Divide;
+            case OperatorType::ModuloAssign:
+                return OperatorType::Modulo;
+            default:
+                return OperatorType::None;
+        }
+    }
+
+    /**
+     * Get the comparison that is true if the given comparison is false.
+     * @param operatorType comparison operator
+     * @return negated comparison operator
+     */
+    static OperatorType negateComparison(OperatorType operatorType) {
+        switch (operatorType) {
+            case OperatorType::Equal:
+                return OperatorType::NotEqual;
+            case OperatorType::NotEqual:
+                return OperatorType::Equal;
+            case OperatorType::Less:
+                return OperatorType::GreaterEqual;
+            case OperatorType::LessEqual:
+                return OperatorType::Greater;
+            case OperatorType::Greater:
+                return OperatorType::LessEqual;
+            case OperatorType::GreaterEqual:
+                return OperatorType::Less;
+            default:
+                return OperatorType::None;
+        }
+    }
+
+    /**
+     * Determine if the given operator compares two values.
+     * @param operatorType target operator
+     * @return true if the operator is a comparison
+     */
+    static bool isComparison(OperatorType operatorType) {
+        return negateComparison(operatorType) != OperatorType::None;
+    }
+
+    /**
+     * Initialize the operand.
+     * @param kind operand kind
+     * @param type operand type descriptor
+     * @param value constant value or storage slot
+     */
+    Operand::Operand(OperandKind kind, char type, UString value)
+        : kind(kind), type(type), value(value)
+    { }
+
+    /**
+     * Determine if the operand is a constant value.
+     * @return true if the operand is a constant
+     */
+    bool Operand::isConstant() {
+        return kind == OperandKind::Constant;
+    }
+
+    /**
+     * Initialize the variable.
+     * @param type variable type descriptor
+     * @param linker storage slot linker name
+     */
+    Variable::Variable(char type, UString linker)
+        : type(type), linker(linker)
+    { }
+
+    /**
+     * Initialize the method builder.
+     * @param package method package
+     * @param method target method
+     */
+    MethodBuilder::MethodBuilder(Package* package, MethodNode* method)
+        : package(package), method(method)
+    { }
+
+    /**
+     * Initialize the method builder for a standalone expression.
+     * @param package expression package
+     */
+    MethodBuilder::MethodBuilder(Package* package)
+        : package(package), method(nullptr)
+    { }
+
+    /**
+     * Build the body of the method.
+     * @param bytecode result bytecode list
+     */
+    void MethodBuilder::build(List<UString>& bytecode) {
+        // the parameters are visible in the whole method body
+        scopes.push_back(Map<UString, Variable>());
+        declareParameters();
+
+        buildBlock(method->body);
+
+        // the linkers are placed before the instructions, so that every instruction can use them
+        for (UString& link : links)
+            bytecode.push_back(U"        " + link);
+        for (UString& instruction : instructions)
+            bytecode.push_back(U"        " + instruction);
+    }
+
+    /**
+     * Build a standalone expression, that leaves its value on the stack.
+     * @param node target expression
+     * @param bytecode result bytecode list
+     */
+    void MethodBuilder::buildValue(Node* node, List<UString>& bytecode) {
+        scopes.push_back(Map<UString, Variable>());
+
+        char type = typeOf(node);
+        push(evaluate(node, type, U""), type);
+
+        for (UString& instruction : instructions)
+            bytecode.push_back(instruction);
+    }
+
+    /**
+     * Get the type descriptor of the given type token.
+     * @param package package that resolves the declared types
+     * @param type target type token
+     * @return type descriptor
+     */
+    UString MethodBuilder::getDescriptor(Package* package, Token type) {
+        UString value = type.value;
+
+        if (type.is(TokenType::Type)) {
+            char kind = getDescriptorKind(type);
+            if (kind == 0)
+                error("Unable to generate code for type '" << value << "'.");
+            return UString(1, kind);
+        }
+
+        // use the fully qualified name of the type if it has been resolved
+        auto resolved = package->resolvedTypes.find(Symbols::intern(value));
+        if (resolved != package->resolvedTypes.end())
+            return U"L" + resolved->second;
+        return U"L" + value;
+    }
+
+    /**
+     * Get the first character of the type descriptor of the given type token, that tells how the values are stored.
+     * @param type target type token
+     * @return descriptor character, or 0 if the type does not have a descriptor
+     */
+    char MethodBuilder::getDescriptorKind(Token type) {
+        // the declared types are stored as references
+        if (!type.is(TokenType::Type))
+            return 'L';
+
+        // the virtual machine does not have instructions for the narrow types and booleans,
+        // therefore they are stored as integers
+        UString value = type.value;
+        if (value == U"int" || value == U"bool" || value == U"byte" || value == U"short" || value == U"char")
+            return 'I';
+        else if (value == U"long")
+            return 'J';
+        else if (value == U"float")
+            return 'F';
+        else if (value == U"double")
+            return 'D';
+        else if (value == U"void")
+            return 'V';
+        return 0;
+    }
+
+    /**
+     * Get the return type descriptor of the given method.
+     * @param method target method
+     * @return return type descriptor
+     */
+    UString MethodBuilder::getReturnDescriptor(MethodNode* method) {
+        // the tuple return types are not lowered to the bytecode yet, they must not be compiled as void methods
+        if (method->returnTypes.size() > 1)
+            error("Method " << method->name << " returns multiple values, that is not supported by the code generator yet.");
+        if (method->returnTypes.empty())
+            return U"V";
+        return getDescriptor(method->Node::package, method->returnTypes[0].types[0]);
+    }
+
+    /**
+     * Create the instructions that jump to the section of the case key matching an integer.
+     * The dense keys use a jump table, the sparse keys use a binary search, and a few keys are compared one by one.
+     * @param value the argument of the switched integer
+     * @param keys the case keys and their sections
+     * @param fallback the section of the unmatched values
+     * @param fallsThrough true if the fallback section directly follows the instructions
+     * @return jump instructions
+     */
+    List<UString> MethodBuilder::createSwitch(UString value, List<Pair<int, UString>> keys, UString fallback, bool fallsThrough) {
+        List<UString> result;
+        std::sort(keys.begin(), keys.end());
+
+        // ifi== -l a -c 1 -jump case1
+        // goto end
+        if (keys.size() <= SWITCH_MAX_COMPARES) {
+            for (auto& [key, section] : keys)
+                result.push_back(U"ifi== " + value + U" -c " + Strings::toUTF(toString(key)) + U" -jump " + section);
+            if (!fallsThrough)
+                result.push_back(U"goto " + fallback);
+            return result;
+        }
+
+        // tableswitch -l a -low 1 -default end -jump case1 case2 end case4
+        // the keys between the case keys jump to the fallback section
+        long long low = keys.front().first;
+        long long high = keys.back().first;
+        if (high - low + 1 <= (long long) keys.size() * SWITCH_MAX_TABLE_RATIO) {
+            UString instruction = U"tableswitch " + value + U" -low " + Strings::toUTF(toString(low))
+                + U" -default " + fallback + U" -jump";
+            uint index = 0;
+            for (long long key = low; key <= high; key++)
+                instruction += U" " + (keys[index].first == key ? keys[index++].second : fallback);
+            result.push_back(instruction);
+            return result;
+        }
+
+        // lookupswitch -l a -default end -case 1 case1 -case 1000 case2
+        UString instruction = U"lookupswitch " + value + U" -default " + fallback;
+        for (auto& [key, section] : keys)
+            instruction += U" -case " + Strings::toUTF(toString(key)) + U" " + section;
+        result.push_back(instruction);
+        return result;
+    }
+
+    /**
+     * Replace the "{name}" placeholders of a string template with the "{}" placeholders of the template instruction.
+     * @param value template literal
+     * @param names the list to append the names of the interpolated variables to
+     * @return template pattern
+     */
+    UString MethodBuilder::parseTemplate(UString value, List<UString>& names) {
+        UString result;
+        for (uint i = 0; i < value.length(); i++) {
+            // a brace, that is not followed by a name and a closing brace, is a part of the text,
+            // that is escaped for the template instruction
+            if (value[i] != '{') {
+                result += value[i] == '}' ? U"}}" : UString(1, value[i]);
+                continue;
+            }
+            uint end = i + 1;
+            while (end < value.length() && (iswalnum((wint_t) value[end]) || value[end] == '_'))
+                end++;
+            if (end == i + 1 || end == value.length() || value[end] != '}' || iswdigit((wint_t) value[i + 1])) {
+                if (end < value.length() && value[end] == '.')
+                    error("Only local variables can be interpolated in a string template.");
+                result += U"{{";
+                continue;
+            }
+            names.push_back(value.substr(i + 1, end - i - 1));
+            result += U"{}";
+            i = end;
+        }
+        return result;
+    }
+
+    /**
+     * Create the instructions that print a string template. The string is built at once and deleted after it is printed.
+     * @param pattern template pattern
+     * @param arguments the type descriptors and the instruction arguments of the placeholders
+     * @param newLine true if a new line should be printed after the string
+     * @return print instructions
+     */
+    List<UString> MethodBuilder::createTemplatePrint(UString pattern, List<Pair<char, UString>> arguments, bool newLine) {
+        // ttemplate "x = {}" I -l x
+        // tdebug -n -k
+        // tdelete -s
+        UString instruction = U"ttemplate \"";
+        for (cint c : pattern) {
+            if (c == '\n')
+                instruction += U"\\n";
+            else if (c == '\r')
+                instruction += U"\\r";
+            else if (c == '\t')
+                instruction += U"\\t";
+            else if (c == '"' || c == '\\')
+                instruction += UString(1, '\\') + c;
+            else
+                instruction += c;
+        }
+        instruction += U"\"";
+        for (auto& [type, argument] : arguments) {
+            if (type != 'I' && type != 'J' && type != 'F' && type != 'D')
+                error("Unable to interpolate a value of type " << type << " in a string template.");
+            instruction += U" " + UString(1, type) + U" " + argument;
+        }
+        return { instruction, newLine ? U"tdebug -n -k" : U"tdebug -k", U"tdelete -s" };
+    }
+
+    /**
+     * Link the parameters of the method to storage slots.
+     */
+    void MethodBuilder::declareParameters() {
+        // the virtual machine copies the arguments to the storage of their own type in order,
+        // int foo(int a, long b, int c) -> a = ints[0], b = longs[0], c = ints[1]
+        Map<char, uint> offsets;
+        slots = (uint) method->parameters.size();
+
+        for (Parameter& parameter : method->parameters) {
+            char type = getDescriptor(method->Node::package, parameter.type)[0];
+            uint slot = offsets[type]++;
+
+            // a slot can be linked only once, move the parameter to a free slot
+            // if an other parameter of a different type already uses its index
+            if (contains(linked, slot)) {
+                UString source = Strings::toUTF(toString(slot));
+                slot = slots++;
+                if (type == 'L') {
+                    emit(U"aload " + source);
+                    emit(U"astore " + Strings::toUTF(toString(slot)));
+                }
+                else
+                    move(Operand(OperandKind::Local, type, source), type, Strings::toUTF(toString(slot)));
+            }
+
+            Variable variable(type, parameter.name);
+            scopes.back().insert({ parameter.name, variable });
+            declarations[parameter.name]++;
+            linked.push_back(slot);
+            links.push_back(U"#link " + parameter.name + U" " + Strings::toUTF(toString(slot)));
+        }
+        reserved = slots;
+    }
+
+    /**
+     * Build the statements of a block in a new scope.
+     * @param body block statements
+     */
+    void MethodBuilder::buildBlock(List<Node*>& body) {
+        scopes.push_back(Map<UString, Variable>());
+        for (Node* node : body)
+            buildStatement(node);
+        scopes.pop_back();
+    }
+
+    /**
+     * Build a single statement. The temporary slots of the statement are released afterwards.
+     * @param node target statement
+     */
+    void MethodBuilder::buildStatement(Node* node) {
+        uint mark = slots;
+
+        // int a
+        if (node->is(NodeType::LocalDeclare)) {
+            LocalDeclare* local = as(node, LocalDeclare);
+            buildLocal(local->type, local->name, nullptr);
+        }
+        // int a, b = 2
+        else if (node->is(NodeType::MultiLocalDeclare)) {
+            MultiLocalDeclare* locals = as(node, MultiLocalDeclare);
+            for (auto& [name, value] : locals->locals)
+                buildLocal(locals->type, name, value.has_value() ? *value : nullptr);
+        }
+        // int a = 2
+        else if (node->is(NodeType::LocalDeclareAssign)) {
+            LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+            buildLocal(local->type, local->name, local->value);
+        }
+        // a = b + 1
+        else if (node->is(NodeType::LocalAssign)) {
+            LocalAssign* assign = as(node, LocalAssign);
+            evaluateAssign(assign->name, OperatorType::Assign, assign->value);
+        }
+        // a++
+        else if (node->is(NodeType::SideOperation) && (as(node, SideOperation)->operatorType == OperatorType::Increment
+                || as(node, SideOperation)->operatorType == OperatorType::Decrement))
+            step(as(node, SideOperation));
+        // a += 2
+        else if (node->is(NodeType::Operation) || node->is(NodeType::SideOperation) || node->is(NodeType::Group))
+            evaluate(node, 0, U"");
+        // foo(a, b)
+        else if (node->is(NodeType::MethodCall)) {
+            MethodCall* call = as(node, MethodCall);
+            // the console printing is built in, unless the package declares its own print methods
+            if ((call->name == U"print" || call->name == U"println") && resolveMethod(call) == nullptr)
+                buildPrint(call);
+            else {
+                // discard the unused result of the method
+                char type = getReturnDescriptor(buildCall(call))[0];
+                if (type != 'V')
+                    emit(getPrefix(type) + U"pop");
+            }
+        }
+        else if (node->is(NodeType::Return))
+            buildReturn(as(node, Return));
+        else if (node->is(NodeType::If))
+            buildIf(as(node, If));
+        else if (node->is(NodeType::While))
+            buildWhile(as(node, While));
+        else if (node->is(NodeType::DoWhile))
+            buildDoWhile(as(node, DoWhile));
+        else if (node->is(NodeType::Switch))
+            buildSwitch(as(node, Switch));
+        else
+            error("Unable to generate code for statement: " << node->type);
+
+        // release the temporary slots of the statement, but keep the declared local variables
+        slots = getMax(mark, reserved);
+    }
+
+    /**
+     * Build a local variable declaration.
+     * @param type variable type
+     * @param name variable name
+     * @param value initial value of the variable, or null
+     */
+    void MethodBuilder::buildLocal(Token type, UString name, Node* value) {
+        // let a = 2L
+        char descriptor;
+        if (type.is(TokenType::Type, U"let")) {
+            if (value == nullptr)
+                error("Unable to infer the type of local variable '" << name << "' without a value.");
+            descriptor = typeOf(value);
+        }
+        else
+            descriptor = getDescriptor(package, type)[0];
+
+        // evaluate the value directly to the slot of the variable
+        Variable& variable = declare(name, descriptor);
+        if (value != nullptr)
+            evaluate(value, descriptor, variable.linker);
+        // a loop might declare the same variable multiple times, reset it to the default value
+        else if (descriptor != 'L')
+            move(Operand(OperandKind::Constant, descriptor, U"0"), descriptor, variable.linker);
+    }
+
+    /**
+     * Build an if statement with its else if and else cases.
+     * @param statement target if statement
+     */
+    void MethodBuilder::buildIf(If* statement) {
+        UString end = createLabel(U"end");
+
+        // collect the conditional cases of the statement
+        // if (a) { } else if (b) { } else { }
+        List<Node*> conditions = { statement->condition };
+        List<List<Node*>*> bodies = { &statement->body };
+        for (ElseIf* elseIf : statement->elseIfs) {
+            conditions.push_back(elseIf->condition);
+            bodies.push_back(&elseIf->body);
+        }
+
+        for (uint i = 0; i < conditions.size(); i++) {
+            // skip the case body if the condition is false
+            UString next = createLabel(U"else");
+            branch(conditions[i], next, false);
+            buildBlock(*bodies[i]);
+
+            // the last case does not have to jump over the following cases
+            bool last = i == conditions.size() - 1 && statement->elseCase == nullptr;
+            if (!last)
+                emit(U"goto " + end);
+            emit(U":" + next);
+        }
+
+        if (statement->elseCase != nullptr)
+            buildBlock(statement->elseCase->body);
+        emit(U":" + end);
+    }
+
+    /**
+     * Build a while loop.
+     * @param statement target while statement
+     */
+    void MethodBuilder::buildWhile(While* statement) {
+        UString loop = createLabel(U"loop");
+        UString end = createLabel(U"end");
+
+        // :loop
+        // ifi>= -l i -c 10 -jump end
+        // ...
+        // goto loop
+        // :end
+        emit(U":" + loop);
+        branch(statement->condition, end, false);
+        buildBlock(statement->body);
+        emit(U"goto " + loop);
+        emit(U":" + end);
+    }
+
+    /**
+     * Build a do-while loop.
+     * @param statement target do-while statement
+     */
+    void MethodBuilder::buildDoWhile(DoWhile* statement) {
+        UString loop = createLabel(U"loop");
+
+        // :loop
+        // ...
+        // ifi< -l i -c 10 -jump loop
+        emit(U":" + loop);
+        buildBlock(statement->body);
+        branch(statement->condition, loop, true);
+    }
+
+    /**
+     * Build a switch statement.
+     * @param statement target switch statement
+     */
+    void MethodBuilder::buildSwitch(Switch* statement) {
+        if (typeOf(statement->value) != 'I')
+            error("Switch value must be an integer.");
+        UString end = createLabel(U"end");
+        UString fallback = statement->defaultCase != nullptr ? createLabel(U"default") : end;
+
+        // collect the sections of the case keys
+        List<Pair<int, UString>> keys;
+        List<UString> sections;
+        for (SwitchCase* switchCase : statement->cases) {
+            UString section = createLabel(U"case");
+            sections.push_back(section);
+            for (Token& key : switchCase->keys)
+                keys.push_back({ stringToInt(Strings::fromUTF(key.value)), section });
+        }
+
+        // tableswitch -l a -low 1 -default end -jump case1 case2
+        // :case1
+        // ...
+        // goto end
+        // :case2
+        // ...
+        // :end
+        Operand value = evaluate(statement->value, 'I', U"");
+        for (UString& instruction : createSwitch(argument(value, 'I'), keys, fallback, false))
+            emit(instruction);
+        for (uint i = 0; i < sections.size(); i++) {
+            emit(U":" + sections[i]);
+            buildBlock(statement->cases[i]->body);
+            // the last case does not have to jump over the following cases
+            if (i < sections.size() - 1 || statement->defaultCase != nullptr)
+                emit(U"goto " + end);
+        }
+
+        if (statement->defaultCase != nullptr) {
+            emit(U":" + fallback);
+            buildBlock(statement->defaultCase->body);
+        }
+        emit(U":" + end);
+    }
+
+    /**
+     * Build a method return.
+     * @param statement target return statement
+     */
+    void MethodBuilder::buildReturn(Return* statement) {
+        char type = getReturnDescriptor(method)[0];
+
+        // return
+        if (!statement->value.has_value()) {
+            if (type != 'V')
+                error("Method '" << method->name << "' must return a value.");
+            emit(U"return");
+            return;
+        }
+        if (type == 'V')
+            error("Void method '" << method->name << "' cannot return a value.");
+
+        // ireturn -l a
+        Operand value = evaluate(*statement->value, type, U"");
+        emit(getPrefix(type) + U"return " + argument(value, type));
+    }
+
+    /**
+     * Build a console print of the given arguments.
+     * @param call target print call
+     */
+    void MethodBuilder::buildPrint(MethodCall* call) {
+        if (call->arguments.size() > 1)
+            error("Method '" << call->name << "' expects at most one argument.");
+
+        // println ""
+        if (call->arguments.empty()) {
+            emit(call->name + U" \"\"");
+            return;
+        }
+
+        // println "Hello, World"
+        Node* node = call->arguments[0];
+        if (node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::String)) {
+            emit(call->name + U" \"" + as(node, Value)->value.value + U"\"");
+            return;
+        }
+
+        // ttemplate "x = {}" I -l x
+        // tdebug -n -k
+        // tdelete -s
+        if (node->is(NodeType::Template)) {
+            List<UString> names;
+            UString pattern = parseTemplate(as(node, Template)->value.value, names);
+            // a template without placeholders is printed as a literal
+            if (names.empty()) {
+                emit(call->name + U" \"" + as(node, Template)->value.value + U"\"");
+                return;
+            }
+            List<Pair<char, UString>> arguments;
+            for (UString& name : names) {
+                Variable& variable = lookup(name);
+                arguments.push_back({ variable.type, U"-l " + variable.linker });
+            }
+            for (UString& instruction : createTemplatePrint(pattern, arguments, call->name == U"println"))
+                emit(instruction);
+            return;
+        }
+
+        // iload a
+        // idebug -n
+        char type = typeOf(node);
+        if (type == 'V')
+            error("Unable to print a void value.");
+        // the result of a method call is already on the stack
+        if (node->is(NodeType::MethodCall))
+            buildCall(as(node, MethodCall));
+        else
+            push(evaluate(node, type, U""), type);
+        emit(getPrefix(type) + U"debug" + (call->name == U"println" ? U" -n" : U""));
+    }
+
+    /**
+     * Build a method call, that leaves the method result on the stack.
+     * @param call target method call
+     * @return called method
+     */
+    MethodNode* MethodBuilder::buildCall(MethodCall* call) {
+        MethodNode* callee = resolveMethod(call);
+        if (callee == nullptr)
+            error("Unable to resolve method " << call->name << " with " << call->arguments.size()
+                << " arguments in package '" << package->name << "'.");
+
+        // evaluate all the arguments before pushing them, so that the arguments of
+        // a nested method call are not mixed up with the arguments of this call
+        List<Operand> arguments;
+        List<char> types;
+        UString descriptors;
+        for (uint i = 0; i < call->arguments.size(); i++) {
+            UString descriptor = getDescriptor(callee->Node::package, callee->parameters[i].type);
+            types.push_back(descriptor[0]);
+            arguments.push_back(evaluate(call->arguments[i], descriptor[0], U""));
+            descriptors += U" " + descriptor;
+        }
+
+        // the method takes its arguments from the stack in the pushed order
+        for (uint i = 0; i < arguments.size(); i++)
+            push(arguments[i], types[i]);
+        emit(U"invokestatic <package>" + callee->Node::package->name + U" " + callee->name + descriptors);
+        return callee;
+    }
+
+    /**
+     * Evaluate an expression.
+     * @param node target expression
+     * @param type required type descriptor, or 0 if it should be inferred
+     * @param result the slot to write the value to, or empty if any slot can hold the value
+     * @return the operand that holds the value
+     */
+    Operand MethodBuilder::evaluate(Node* node, char type, UString result) {
+        // infer the type of the expression if it is not required by the context
+        if (type == 0)
+            type = typeOf(node);
+
+        if (node->is(NodeType::Value))
+            return evaluateValue(as(node, Value), type, result);
+        else if (node->is(NodeType::Group))
+            return evaluate(as(node, Group)->value, type, result);
+        else if (node->is(NodeType::Operation))
+            return evaluateOperation(as(node, Operation), type, result);
+        else if (node->is(NodeType::SideOperation))
+            return evaluateSideOperation(as(node, SideOperation), type, result);
+
+        // a = b = 2
+        else if (node->is(NodeType::LocalAssign)) {
+            LocalAssign* assign = as(node, LocalAssign);
+            Operand variable = evaluateAssign(assign->name, OperatorType::Assign, assign->value);
+            if (result.empty())
+                return variable;
+            move(variable, type, result);
+            return Operand(OperandKind::Local, type, result);
+        }
+
+        // store the result of the method call from the stack
+        else if (node->is(NodeType::MethodCall)) {
+            MethodCall* call = as(node, MethodCall);
+            char returnType = getReturnDescriptor(buildCall(call))[0];
+            if (returnType == 'V')
+                error("Method " << call->name << " does not return a value.");
+            if (returnType != type)
+                error("Implicit conversion of the result of method " << call->name << " is not supported.");
+            Operand target = result.empty() ? createTemp(type) : Operand(OperandKind::Local, type, result);
+            emit(getPrefix(type) + U"store " + target.value);
+            return target;
+        }
+
+        error("Unable to generate code for expression: " << node->type);
+        return Operand(OperandKind::Constant, type, U"0");
+    }
+
+    /**
+     * Evaluate a single value.
+     * @param node target value
+     * @param type required type descriptor
+     * @param result the slot to write the value to
+     * @return the operand that holds the value
+     */
+    Operand MethodBuilder::evaluateValue(Value* node, char type, UString result) {
+        Token token = node->value;
+
+        // read the value of the variable from its slot
+        Operand operand(OperandKind::Local, type, U"");
+        if (token.is(TokenType::Identifier)) {
+            Variable& variable = lookup(token.value);
+            operand = Operand(OperandKind::Local, variable.type, variable.linker);
+            if (result.empty() || result == variable.linker)
+                return operand;
+        }
+
+        // the constants are passed to the instructions as they are
+        else {
+            UString value = token.value;
+            if (token.is(TokenType::Boolean))
+                value = value == U"true" ? U"1" : U"0";
+            else if (token.is(TokenType::Character))
+                value = Strings::toUTF(toString((int) value[0]));
+            else if (token.is(TokenType::Hexadecimal))
+                value = Strings::toUTF(toString(std::stoll(Strings::fromUTF(value.substr(2)), nullptr, 16)));
+            else if (!token.is(TokenType::Integer) && !token.is(TokenType::Long) && !token.is(TokenType::Float)
+                    && !token.is(TokenType::Double) && !token.is(TokenType::Byte) && !token.is(TokenType::Short))
+                error("Unable to generate code for value: " << token);
+
+            operand = Operand(OperandKind::Constant, typeOf(node), value);
+            if (result.empty())
+                return operand;
+        }
+
+        // copy the value to the required slot
+        move(operand, type, result);
+        return Operand(OperandKind::Local, type, result);
+    }
+
+    /**
+     * Evaluate an operation of two expressions.
+     * @param node target operation
+     * @param type required type descriptor
+     * @param result the slot to write the value to
+     * @return the operand that holds the value
+     */
+    Operand MethodBuilder::evaluateOperation(Operation* node, char type, UString result) {
+        OperatorType operatorType = node->operatorType;
+
+        // a += b
+        if (isAssignment(operatorType)) {
+            Operand variable = evaluateAssign(NodeWalker::requireLocalName(node->left), operatorType, node->right);
+            if (result.empty() || result == variable.value)
+                return variable;
+            move(variable, type, result);
+            return Operand(OperandKind::Local, type, result);
+        }
+
+        // a < b && c
+        if (isComparison(operatorType) || operatorType == OperatorType::And || operatorType == OperatorType::Or)
+            return evaluateCondition(node, result);
+
+        // a + b * c
+        // imul -l b -l c -r 2
+        // iadd -l a -l 2 -r result
+        if (operatorType >= OperatorType::Add && operatorType <= OperatorType::Modulo) {
+            Operand left = evaluate(node->left, type, U"");
+            Operand right = evaluate(node->right, type, U"");
+            Operand target = result.empty() ? createTemp(type) : Operand(OperandKind::Local, type, result);
+            arithmetic(operatorType, type, left, right, target.value);
+            return target;
+        }
+
+        error("Operator '" << node->target << "' is not supported by the virtual machine.");
+        return Operand(OperandKind::Constant, type, U"0");
+    }
+
+    /**
+     * Evaluate a single-operand operation.
+     * @param node target operation
+     * @param type required type descriptor
+     * @param result the slot to write the value to
+     * @return the operand that holds the value
+     */
+    Operand MethodBuilder::evaluateSideOperation(SideOperation* node, char type, UString result) {
+        switch (node->operatorType) {
+            // !a
+            case OperatorType::Not:
+                return evaluateCondition(node, result);
+
+            // -a
+            case OperatorType::Subtract: {
+                Operand value = evaluate(node->operand, type, U"");
+                // negate the constants in place
+                if (value.isConstant()) {
+                    UString negated = value.value[0] == '-' ? value.value.substr(1) : U"-" + value.value;
+                    Operand constant(OperandKind::Constant, value.type, negated);
+                    if (result.empty())
+                        return constant;
+                    move(constant, type, result);
+                    return Operand(OperandKind::Local, type, result);
+                }
+                // ineg -l a -r result
+                Operand target = result.empty() ? createTemp(type) : Operand(OperandKind::Local, type, result);
+                emit(getPrefix(type) + U"neg " + argument(value, type) + U" -r " + target.value);
+                return target;
+            }
+
+            // ++a, a++
+            case OperatorType::Increment:
+            case OperatorType::Decrement: {
+                // increment the variable before it is used
+                if (node->left) {
+                    Operand variable = step(node);
+                    if (result.empty() || result == variable.value)
+                        return variable;
+                    move(variable, type, result);
+                    return Operand(OperandKind::Local, type, result);
+                }
+                // keep the previous value of the variable
+                Operand target = result.empty() ? createTemp(type) : Operand(OperandKind::Local, type, result);
+                move(evaluate(node->operand, type, U""), type, target.value);
+                step(node);
+                return target;
+            }
+
+            default:
+                error("Operator '" << node->target << "' is not supported by the virtual machine.");
+        }
+        return Operand(OperandKind::Constant, type, U"0");
+    }
+
+    /**
+     * Evaluate a condition to an integer slot that holds 1 if the condition is true, 0 otherwise.
+     * @param node target condition
+     * @param result the slot to write the value to
+     * @return the operand that holds the value
+     */
+    Operand MethodBuilder::evaluateCondition(Node* node, UString result) {
+        Operand target = result.empty() ? createTemp('I') : Operand(OperandKind::Local, 'I', result);
+        UString falseCase = createLabel(U"false");
+        UString end = createLabel(U"end");
+
+        // the result is written after the condition is evaluated,
+        // so that the condition can still read the previous value of the result
+        branch(node, falseCase, false);
+        emit(U"iset " + target.value + U" 1");
+        emit(U"goto " + end);
+        emit(U":" + falseCase);
+        emit(U"iset " + target.value + U" 0");
+        emit(U":" + end);
+        return target;
+    }
+
+    /**
+     * Evaluate an assignment to a local variable.
+     * @param name variable name
+     * @param operatorType assignment operator
+     * @param value assigned value
+     * @return the operand of the variable
+     */
+    Operand MethodBuilder::evaluateAssign(UString name, OperatorType operatorType, Node* value) {
+        Variable variable = lookup(name);
+        Operand operand(OperandKind::Local, variable.type, variable.linker);
+
+        // evaluate the value directly to the slot of the variable
+        // a = b * 2 -> imul -l b -c 2 -r a
+        if (operatorType == OperatorType::Assign) {
+            evaluate(value, variable.type, variable.linker);
+            return operand;
+        }
+
+        // a += 2 -> iadd -l a -c 2 -r a
+        OperatorType arithmeticType = getCompoundOperator(operatorType);
+        if (arithmeticType == OperatorType::None)
+            error("Operator '" << UString(getOperatorInfo(operatorType).symbol) << "' is not supported by the virtual machine.");
+        arithmetic(arithmeticType, variable.type, operand, evaluate(value, variable.type, U""), variable.linker);
+        return operand;
+    }
+
+    /**
+     * Build a conditional jump, that jumps to the given section if the condition matches the expected value.
+     * Otherwise the execution continues with the next instruction.
+     * @param node target condition
+     * @param section jump target section
+     * @param expected condition value that makes the jump
+     */
+    void MethodBuilder::branch(Node* node, UString section, bool expected) {
+        // (a)
+        if (node->is(NodeType::Group)) {
+            branch(as(node, Group)->value, section, expected);
+            return;
+        }
+
+        // true
+        if (node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::Boolean)) {
+            if ((as(node, Value)->value.value == U"true") == expected)
+                emit(U"goto " + section);
+            return;
+        }
+
+        // !a
+        if (node->is(NodeType::SideOperation) && as(node, SideOperation)->operatorType == OperatorType::Not) {
+            branch(as(node, SideOperation)->operand, section, !expected);
+            return;
+        }
+
+        if (node->is(NodeType::Operation)) {
+            Operation* operation = as(node, Operation);
+            OperatorType operatorType = operation->operatorType;
+
+            // a && b
+            // the second operand is not evaluated if the first operand is false
+            if (operatorType == OperatorType::And) {
+                if (!expected) {
+                    branch(operation->left, section, false);
+                    branch(operation->right, section, false);
+                    return;
+                }
+                UString skip = createLabel(U"and");
+                branch(operation->left, skip, false);
+                branch(operation->right, section, true);
+                emit(U":" + skip);
+                return;
+            }
+
+            // a || b
+            // the second operand is not evaluated if the first operand is true
+            if (operatorType == OperatorType::Or) {
+                if (expected) {
+                    branch(operation->left, section, true);
+                    branch(operation->right, section, true);
+                    return;
+                }
+                UString skip = createLabel(U"or");
+                branch(operation->left, skip, true);
+                branch(operation->right, section, false);
+                emit(U":" + skip);
+                return;
+            }
+
+            // a < b
+            // ifi< -l a -l b -jump section
+            if (isComparison(operatorType)) {
+                char type = promote(typeOf(operation->left), typeOf(operation->right));
+                Operand left = evaluate(operation->left, type, U"");
+                Operand right = evaluate(operation->right, type, U"");
+                OperatorType comparison = expected ? operatorType : negateComparison(operatorType);
+                emit(U"if" + getPrefix(type) + getOperatorInfo(comparison).symbol + U" "
+                    + argument(left, type) + U" " + argument(right, type) + U" -jump " + section);
+                return;
+            }
+        }
+
+        // any other value is true if it is not zero
+        Operand value = evaluate(node, 'I', U"");
+        emit(UString(expected ? U"ifi!= " : U"ifi== ") + argument(value, 'I') + U" -c 0 -jump " + section);
+    }
+
+    /**
+     * Build an arithmetic instruction.
+     * @param operatorType arithmetic operator
+     * @param type operation type descriptor
+     * @param left first operand
+     * @param right second operand
+     * @param result result slot
+     */
+    void MethodBuilder::arithmetic(OperatorType operatorType, char type, Operand left, Operand right, UString result) {
+        UString name;
+        switch (operatorType) {
+            case OperatorType::Add:
+                name = U"add";
+                break;
+            case OperatorType::Subtract:
+                name = U"sub";
+                break;
+            case OperatorType::Multiply:
+                name = U"mul";
+                break;
+            case OperatorType::Divide:
+                name = U"div";
+                break;
+            case OperatorType::Modulo:
+                name = U"mod";
+                break;
+            default:
+                error("Operator '" << UString(getOperatorInfo(operatorType).symbol) << "' is not an arithmetic operator.");
+        }
+        emit(getPrefix(type) + name + U" " + argument(left, type) + U" " + argument(right, type) + U" -r " + result);
+    }
+
+    /**
+     * Increment or decrement a local variable in place.
+     * @param node target increment operation
+     * @return the operand of the variable
+     */
+    Operand MethodBuilder::step(SideOperation* node) {
+        // iinc -l a -r a
+        Variable variable = lookup(NodeWalker::requireLocalName(node->operand));
+        UString name = node->operatorType == OperatorType::Increment ? U"inc" : U"decr";
+        emit(getPrefix(variable.type) + name + U" -l " + variable.linker + U" -r " + variable.linker);
+        return Operand(OperandKind::Local, variable.type, variable.linker);
+    }
+
+    /**
+     * Copy the operand value to the given slot.
+     * @param value source operand
+     * @param type slot type descriptor
+     * @param result target slot
+     */
+    void MethodBuilder::move(Operand value, char type, UString result) {
+        // iset a 2
+        if (value.isConstant()) {
+            argument(value, type);
+            emit(getPrefix(type) + U"set " + result + U" " + value.value);
+        }
+        // iadd -l b -c 0 -r a
+        // the virtual machine does not have a move instruction, an addition
+        // still copies the value with a single instruction without using the stack
+        else if (value.value != result)
+            emit(getPrefix(type) + U"add " + argument(value, type) + U" -c 0 -r " + result);
+    }
+
+    /**
+     * Push the operand value to the stack.
+     * @param value source operand
+     * @param type stack type descriptor
+     */
+    void MethodBuilder::push(Operand value, char type) {
+        argument(value, type);
+        if (value.isConstant())
+            emit(getPrefix(type) + U"push " + value.value);
+        else
+            emit(getPrefix(type) + U"load " + value.value);
+    }
+
+    /**
+     * Get the instruction argument that reads the operand using the local or constant operand mode.
+     * @param value source operand
+     * @param type instruction type descriptor
+     * @return operand instruction argument
+     */
+    UString MethodBuilder::argument(Operand value, char type) {
+        // the virtual machine does not have conversion instructions yet, a variable can only be
+        // used as its own type, a constant can be used as any type that is at least as wide
+        if (value.type != type && (!value.isConstant() || getRank(value.type) > getRank(type)))
+            error("Implicit conversion from " << (char) value.type << " to " << (char) type << " is not supported.");
+        return (value.isConstant() ? U"-c " : U"-l ") + value.value;
+    }
+
+    /**
+     * Infer the type descriptor of an expression.
+     * @param node target expression
+     * @return inferred type descriptor
+     */
+    char MethodBuilder::typeOf(Node* node) {
+        if (node->is(NodeType::Value)) {
+            Token token = as(node, Value)->value;
+            if (token.is(TokenType::Identifier))
+                return lookup(token.value).type;
+            else if (token.is(TokenType::Long))
+                return 'J';
+            else if (token.is(TokenType::Float))
+                return 'F';
+            else if (token.is(TokenType::Double))
+                return 'D';
+            else if (token.is(TokenType::String))
+                return 'L';
+            return 'I';
+        }
+        else if (node->is(NodeType::Group))
+            return typeOf(as(node, Group)->value);
+        else if (node->is(NodeType::Operation)) {
+            Operation* operation = as(node, Operation);
+            if (isAssignment(operation->operatorType))
+                return lookup(NodeWalker::requireLocalName(operation->left)).type;
+            if (operation->operatorType >= OperatorType::Add && operation->operatorType <= OperatorType::Modulo)
+                return promote(typeOf(operation->left), typeOf(operation->right));
+            // the conditions are integers of 0 or 1
+            return 'I';
+        }
+        else if (node->is(NodeType::SideOperation)) {
+            SideOperation* operation = as(node, SideOperation);
+            return operation->operatorType == OperatorType::Not ? 'I' : typeOf(operation->operand);
+        }
+        else if (node->is(NodeType::LocalAssign))
+            return lookup(as(node, LocalAssign)->name).type;
+        else if (node->is(NodeType::MethodCall)) {
+            MethodNode* callee = resolveMethod(as(node, MethodCall));
+            return callee != nullptr ? getReturnDescriptor(callee)[0] : 'V';
+        }
+        return 'V';
+    }
+
+    /**
+     * Find the method that is called by the method call.
+     * @param call target method call
+     * @return called method, or null if the method is not found
+     */
+    MethodNode* MethodBuilder::resolveMethod(MethodCall* call) {
+        UString arguments;
+        for (Node* argument : call->arguments)
+            arguments += typeOf(argument);
+        return package->resolveCall(call->name, arguments);
+    }
+
+    /**
+     * Declare a local variable in the innermost scope and link it to a new storage slot.
+     * @param name variable name
+     * @param type variable type descriptor
+     * @return declared variable
+     */
+    Variable& MethodBuilder::declare(UString name, char type) {
+        Map<UString, Variable>& scope = scopes.back();
+        if (scope.find(name) != scope.end())
+            error("Local variable '" << name << "' is already declared in this scope.");
+
+        // a linker name can be used only once, the variables of the sibling scopes
+        // with the same name are linked as a.1, a.2 and so on
+        uint count = declarations[name]++;
+        UString linker = count == 0 ? name : name + U"." + Strings::toUTF(toString(count));
+
+        uint slot = slots++;
+        reserved = slots;
+        linked.push_back(slot);
+        links.push_back(U"#link " + linker + U" " + Strings::toUTF(toString(slot)));
+
+        return scope.insert({ name, Variable(type, linker) }).first->second;
+    }
+
+    /**
+     * Find a local variable in the visible scopes.
+     * @param name variable name
+     * @return found variable
+     */
+    Variable& MethodBuilder::lookup(UString name) {
+        for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++) {
+            auto variable = scope->find(name);
+            if (variable != scope->end())
+                return variable->second;
+        }
+        error("Unknown local variable '" << name << "'.");
+        return scopes.back().begin()->second;
+    }
+
+    /**
+     * Allocate a temporary slot, that is released after the current statement.
+     * @param type slot type descriptor
+     * @return temporary slot operand
+     */
+    Operand MethodBuilder::createTemp(char type) {
+        return Operand(OperandKind::Local, type, Strings::toUTF(toString(slots++)));
+    }
+
+    /**
+     * Create a new unique jump section name.
+     * @param prefix section name prefix
+     * @return jump section name
+     */
+    UString MethodBuilder::createLabel(UString prefix) {
+        return prefix + Strings::toUTF(toString(labels++));
+    }
+
+    /**
+     * Append an instruction to the method body.
+     * @param instruction bytecode instruction
+     */
+    void MethodBuilder::emit(UString instruction) {
+        instructions.push_back(instruction);
+    }
+}
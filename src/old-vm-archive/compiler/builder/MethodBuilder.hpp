@@ -0,0 +1,447 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+#include "Package.hpp"
+
+namespace Compiler {
+    /**
+     * The maximum count of the case keys of a switch, that are compared one by one instead of using a switch instruction.
+     */
+    static const uint SWITCH_MAX_COMPARES = 2;
+
+    /**
+     * The maximum ratio of the jump table size to the count of the case keys, that a switch uses a jump table for.
+     */
+    static const uint SWITCH_MAX_TABLE_RATIO = 2;
+
+    /**
+     * Represents a registry of the places where an instruction operand can be read from.
+     */
+    enum class OperandKind {
+        Constant, // -c 10
+        Local     // -l x
+    };
+
+    /**
+     * Represents the result of an evaluated expression, that can be passed to an instruction
+     * using the local or constant operand mode, without pushing it to the stack.
+     */
+    class Operand {
+    public:
+        /**
+         * The place where the operand is read from.
+         */
+        OperandKind kind;
+
+        /**
+         * The type descriptor of the operand, I, J, F, D or L.
+         */
+        char type;
+
+        /**
+         * The constant value or the storage slot of the operand.
+         */
+        UString value;
+
+        /**
+         * Initialize the operand.
+         * @param kind operand kind
+         * @param type operand type descriptor
+         * @param value constant value or storage slot
+         */
+        Operand(OperandKind kind, char type, UString value);
+
+        /**
+         * Determine if the operand is a constant value.
+         * @return true if the operand is a constant
+         */
+        bool isConstant();
+    };
+
+    /**
+     * Represents a local variable that is linked to a storage slot of the method.
+     */
+    class Variable {
+    public:
+        /**
+         * The type descriptor of the variable, I, J, F, D or L.
+         */
+        char type;
+
+        /**
+         * The name of the storage slot linker of the variable.
+         */
+        UString linker;
+
+        /**
+         * Initialize the variable.
+         * @param type variable type descriptor
+         * @param linker storage slot linker name
+         */
+        Variable(char type, UString linker);
+    };
+
+    /**
+     * Represents a per-method code generator, that converts the statements of a method body to bytecode.
+     * Local variables are linked to storage slots, and the expressions read their operands from and
+     * write their results to these slots directly, therefore most of the values never touch the stack.
+     */
+    class MethodBuilder {
+    private:
+        /**
+         * The package that declares the built method.
+         */
+        Package* package;
+
+        /**
+         * The built method, or null if a standalone expression is built.
+         */
+        MethodNode* method;
+
+        /**
+         * The storage slot linkers of the method.
+         */
+        List<UString> links;
+
+        /**
+         * The generated method instructions.
+         */
+        List<UString> instructions;
+
+        /**
+         * The stack of the local variable scopes, the innermost scope is the last one.
+         */
+        List<Map<UString, Variable>> scopes;
+
+        /**
+         * The map of the declaration counts of the local variable names.
+         */
+        Map<UString, uint> declarations;
+
+        /**
+         * The storage slots that are already linked to a variable.
+         */
+        List<uint> linked;
+
+        /**
+         * The index of the next free storage slot. Slots are shared by all the variable types,
+         * so that the linker of a slot always refers to a single variable.
+         */
+        uint slots = 0;
+
+        /**
+         * The index of the first slot that is not used by a local variable.
+         * Temporary slots above this index are released after each statement.
+         */
+        uint reserved = 0;
+
+        /**
+         * The count of the created jump sections.
+         */
+        uint labels = 0;
+
+    public:
+        /**
+         * Initialize the method builder.
+         * @param package method package
+         * @param method target method
+         */
+        MethodBuilder(Package* package, MethodNode* method);
+
+        /**
+         * Initialize the method builder for a standalone expression.
+         * @param package expression package
+         */
+        MethodBuilder(Package* package);
+
+        /**
+         * Build the body of the method.
+         * @param bytecode result bytecode list
+         */
+        void build(List<UString>& bytecode);
+
+        /**
+         * Build a standalone expression, that leaves its value on the stack.
+         * @param node target expression
+         * @param bytecode result bytecode list
+         */
+        void buildValue(Node* node, List<UString>& bytecode);
+
+        /**
+         * Get the type descriptor of the given type token.
+         * @param package package that resolves the declared types
+         * @param type target type token
+         * @return type descriptor
+         */
+        static UString getDescriptor(Package* package, Token type);
+
+        /**
+         * Get the first character of the type descriptor of the given type token, that tells how the values are stored.
+         * @param type target type token
+         * @return descriptor character, or 0 if the type does not have a descriptor
+         */
+        static char getDescriptorKind(Token type);
+
+        /**
+         * Get the return type descriptor of the given method.
+         * @param method target method
+         * @return return type descriptor
+         */
+        static UString getReturnDescriptor(MethodNode* method);
+
+        /**
+         * Create the instructions that jump to the section of the case key matching an integer.
+         * The dense keys use a jump table, the sparse keys use a binary search, and a few keys are compared one by one.
+         * @param value the argument of the switched integer
+         * @param keys the case keys and their sections
+         * @param fallback the section of the unmatched values
+         * @param fallsThrough true if the fallback section directly follows the instructions
+         * @return jump instructions
+         */
+        static List<UString> createSwitch(UString value, List<Pair<int, UString>> keys, UString fallback, bool fallsThrough);
+
+        /**
+         * Replace the "{name}" placeholders of a string template with the "{}" placeholders of the template instruction.
+         * @param value template literal
+         * @param names the list to append the names of the interpolated variables to
+         * @return template pattern
+         */
+        static UString parseTemplate(UString value, List<UString>& names);
+
+        /**
+         * Create the instructions that print a string template. The string is built at once and deleted after it is printed.
+         * @param pattern template pattern
+         * @param arguments the type descriptors and the instruction arguments of the placeholders
+         * @param newLine true if a new line should be printed after the string
+         * @return print instructions
+         */
+        static List<UString> createTemplatePrint(UString pattern, List<Pair<char, UString>> arguments, bool newLine);
+
+    private:
+        /**
+         * Link the parameters of the method to storage slots.
+         */
+        void declareParameters();
+
+        /**
+         * Build the statements of a block in a new scope.
+         * @param body block statements
+         */
+        void buildBlock(List<Node*>& body);
+
+        /**
+         * Build a single statement. The temporary slots of the statement are released afterwards.
+         * @param node target statement
+         */
+        void buildStatement(Node* node);
+
+        /**
+         * Build a local variable declaration.
+         * @param type variable type
+         * @param name variable name
+         * @param value initial value of the variable, or null
+         */
+        void buildLocal(Token type, UString name, Node* value);
+
+        /**
+         * Build an if statement with its else if and else cases.
+         * @param statement target if statement
+         */
+        void buildIf(If* statement);
+
+        /**
+         * Build a while loop.
+         * @param statement target while statement
+         */
+        void buildWhile(While* statement);
+
+        /**
+         * Build a do-while loop.
+         * @param statement target do-while statement
+         */
+        void buildDoWhile(DoWhile* statement);
+
+        /**
+         * Build a switch statement.
+         * @param statement target switch statement
+         */
+        void buildSwitch(Switch* statement);
+
+        /**
+         * Build a method return.
+         * @param statement target return statement
+         */
+        void buildReturn(Return* statement);
+
+        /**
+         * Build a console print of the given arguments.
+         * @param call target print call
+         */
+        void buildPrint(MethodCall* call);
+
+        /**
+         * Build a method call, that leaves the method result on the stack.
+         * @param call target method call
+         * @return called method
+         */
+        MethodNode* buildCall(MethodCall* call);
+
+        /**
+         * Evaluate an expression.
+         * @param node target expression
+         * @param type required type descriptor, or 0 if it should be inferred
+         * @param result the slot to write the value to, or empty if any slot can hold the value
+         * @return the operand that holds the value
+         */
+        Operand evaluate(Node* node, char type, UString result);
+
+        /**
+         * Evaluate a single value.
+         * @param node target value
+         * @param type required type descriptor
+         * @param result the slot to write the value to
+         * @return the operand that holds the value
+         */
+        Operand evaluateValue(Value* node, char type, UString result);
+
+        /**
+         * Evaluate an operation of two expressions.
+         * @param node target operation
+         * @param type required type descriptor
+         * @param result the slot to write the value to
+         * @return the operand that holds the value
+         */
+        Operand evaluateOperation(Operation* node, char type, UString result);
+
+        /**
+         * Evaluate a single-operand operation.
+         * @param node target operation
+         * @param type required type descriptor
+         * @param result the slot to write the value to
+         * @return the operand that holds the value
+         */
+        Operand evaluateSideOperation(SideOperation* node, char type, UString result);
+
+        /**
+         * Evaluate a condition to an integer slot that holds 1 if the condition is true, 0 otherwise.
+         * @param node target condition
+         * @param result the slot to write the value to
+         * @return the operand that holds the value
+         */
+        Operand evaluateCondition(Node* node, UString result);
+
+        /**
+         * Evaluate an assignment to a local variable.
+         * @param name variable name
+         * @param operatorType assignment operator
+         * @param value assigned value
+         * @return the operand of the variable
+         */
+        Operand evaluateAssign(UString name, OperatorType operatorType, Node* value);
+
+        /**
+         * Build a conditional jump, that jumps to the given section if the condition matches the expected value.
+         * Otherwise the execution continues with the next instruction.
+         * @param node target condition
+         * @param section jump target section
+         * @param expected condition value that makes the jump
+         */
+        void branch(Node* node, UString section, bool expected);
+
+        /**
+         * Build an arithmetic instruction.
+         * @param operatorType arithmetic operator
+         * @param type operation type descriptor
+         * @param left first operand
+         * @param right second operand
+         * @param result result slot
+         */
+        void arithmetic(OperatorType operatorType, char type, Operand left, Operand right, UString result);
+
+        /**
+         * Increment or decrement a local variable in place.
+         * @param node target increment operation
+         * @return the operand of the variable
+         */
+        Operand step(SideOperation* node);
+
+        /**
+         * Copy the operand value to the given slot.
+         * @param value source operand
+         * @param type slot type descriptor
+         * @param result target slot
+         */
+        void move(Operand value, char type, UString result);
+
+        /**
+         * Push the operand value to the stack.
+         * @param value source operand
+         * @param type stack type descriptor
+         */
+        void push(Operand value, char type);
+
+        /**
+         * Get the instruction argument that reads the operand using the local or constant operand mode.
+         * @param value source operand
+         * @param type instruction type descriptor
+         * @return operand instruction argument
+         */
+        UString argument(Operand value, char type);
+
+        /**
+         * Infer the type descriptor of an expression.
+         * @param node target expression
+         * @return inferred type descriptor
+         */
+        char typeOf(Node* node);
+
+        /**
+         * Find the method that is called by the method call.
+         * @param call target method call
+         * @return called method, or null if the method is not found
+         */
+        MethodNode* resolveMethod(MethodCall* call);
+
+        /**
+         * Declare a local variable in the innermost scope and link it to a new storage slot.
+         * @param name variable name
+         * @param type variable type descriptor
+         * @return declared variable
+         */
+        Variable& declare(UString name, char type);
+
+        /**
+         * Find a local variable in the visible scopes.
+         * @param name variable name
+         * @return found variable
+         */
+        Variable& lookup(UString name);
+
+        /**
+         * Allocate a temporary slot, that is released after the current statement.
+         * @param type slot type descriptor
+         * @return temporary slot operand
+         */
+        Operand createTemp(char type);
+
+        /**
+         * Create a new unique jump section name.
+         * @param prefix section name prefix
+         * @return jump section name
+         */
+        UString createLabel(UString prefix);
+
+        /**
+         * Append an instruction to the method body.
+         * @param instruction bytecode instruction
+         */
+        void emit(UString instruction);
+    };
+}
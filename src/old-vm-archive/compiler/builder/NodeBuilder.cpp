@@ -74,10 +74,13 @@ namespace Compiler {
     void NodeBuilder::nextImport() {
         Import* import = as(get(), Import);
         // get the target name of the package
-        List<UString> split = Strings::split(import->package->name, '/');
+        List<UString> split = Strings::split(import->target, '/');
         UString target = split.back();
         split = Strings::split(target, '.');
         target = split.back();
+        // wildcard imports are registered by their full path, so they do not override each other
+        if (target == U"*")
+            target = import->target;
         // register the import
         package->imports[target] = import->target;
     }
@@ -91,7 +94,7 @@ namespace Compiler {
         // make the package method static
         method->modifiers.push_back(U"static");
         checkMethodAvailable(method->name, method->parameters);
-        package->methods.push_back(method);
+        package->declareMethod(method);
     }
 
     /**
@@ -103,7 +106,7 @@ namespace Compiler {
         // TODO handle class child types
         UString name = classNode->name;
         checkTypeNameAvailable(name);
-        package->classes[name] = classNode;
+        package->declareType(classNode);
     }
 
     /**
@@ -115,7 +118,7 @@ namespace Compiler {
         // TODO handle struct child types
         UString name = normalStruct->name;
         checkTypeNameAvailable(name);
-        package->structs[name] = normalStruct;
+        package->declareType(normalStruct);
     }
 
     /**
@@ -127,7 +130,7 @@ namespace Compiler {
         // TODO handle tuple struct child types
         UString name = tupleStruct->name;
         checkTypeNameAvailable(name);
-        package->tupleStructs[name] = tupleStruct;
+        package->declareType(tupleStruct);
     }
 
     /**
@@ -144,7 +147,7 @@ namespace Compiler {
      * @param name method name to check
      * @param parameters method parameters to check
      */
-    void NodeBuilder::checkMethodAvailable(UString name, List<Parameter> parameters) {
+    void NodeBuilder::checkMethodAvailable(UString name, List<Parameter>& parameters) {
         if (package->getMethod(name, parameters) != nullptr) {
             print("Method " << name << "(");
             for (uint i = 0; i < parameters.size(); i++) {
@@ -87,7 +87,7 @@ namespace Compiler {
          * @param name method name to check
          * @param parameters method parameters to check
          */
-        void checkMethodAvailable(UString name, List<Parameter> parameters);
+        void checkMethodAvailable(UString name, List<Parameter>& parameters);
 
         /**
          * Get the node at the current index.
@@ -1,6 +1,10 @@
 #include "Package.hpp"
 
 #include "../../util/Strings.hpp"
+#include "../token/Tokenizer.hpp"
+#include "MethodBuilder.hpp"
+
+#include <atomic>
 using namespace Void;
 
 namespace Compiler {
@@ -18,26 +22,17 @@ namespace Compiler {
      * @return found type or nullptr if not found
      */
     TypeNode* Package::getType(UString name) {
-        // check if a package class uses the given name
-        for (auto& [_, classNode] : classes) {
-            if (classNode->name == name)
-                return classNode;
-        }
-
-        // check if a package struct uses the given name
-        for (auto& [_, structNode] : structs) {
-            if (structNode->name == name)
-                return structNode;
-        }
-
-        // check if a package tuple struct uses the given name
-        for (auto& [_, tupleStruct] : tupleStructs) {
-            if (tupleStruct->name == name)
-                return tupleStruct;
-        }
+        return getType(Symbols::intern(name));
+    }
 
-        // package type not found, return null type pointer
-        return nullptr;
+    /**
+     * Get a type from the package by its interned name.
+     * @param name target type name symbol
+     * @return found type or nullptr if not found
+     */
+    TypeNode* Package::getType(Symbol name) {
+        auto it = typeTable.find(name);
+        return it != typeTable.end() ? it->second : nullptr;
     }
 
     /**
@@ -46,42 +41,118 @@ namespace Compiler {
      * @param parameters target method parameters
      * @return found method or nullptr if not found
      */
-    MethodNode* Package::getMethod(UString name, List<Parameter> parameters) {
-        // get the length of the required parameters list
-        ulong checkLength = parameters.size();
-        // loop through the declared package methods
-        for (MethodNode* method : methods) {
-            // get the length of the method's parameter list
-            ulong methodLength = method->parameters.size();
-            // ignore the method if the method name or parameters length does not match
-            if (method->name != name || methodLength != checkLength)
-                continue;
+    MethodNode* Package::getMethod(UString name, List<Parameter>& parameters) {
+        auto it = methodTable.find(getSignature(name, parameters));
+        return it != methodTable.end() ? it->second : nullptr;
+    }
+
+    /**
+     * Get the methods of the package with the given name.
+     * @param name interned method name
+     * @return the overloads of the method in the order of their declarations, empty if not found
+     */
+    const List<MethodNode*>& Package::getOverloads(Symbol name) {
+        static const List<MethodNode*> empty;
+        auto it = overloads.find(name);
+        return it != overloads.end() ? it->second : empty;
+    }
+
+    /**
+     * Find the method that is called with the given arguments, from this package or its dependencies.
+     * The overload whose parameter types match the arguments exactly is preferred, otherwise the first method with
+     * the same name and parameter count is chosen. The methods of this package are preferred over the imported ones.
+     * @param name called method name
+     * @param arguments the kinds of the argument type descriptors
+     * @return called method, or nullptr if the method is not found
+     */
+    MethodNode* Package::resolveCall(UString name, const UString& arguments) {
+        List<Symbol> kinds;
+        for (char32_t kind : arguments)
+            kinds.push_back(Symbols::intern(UString(1, kind)));
+        MethodSignature signature(Symbols::intern(name), kinds);
 
-            // check if the method parameters match
-            for (ulong i = 0; i < checkLength; i++) {
-                // ignore method if the parameter at the 
-                // current index does not match
-                if (method->parameters[i].type.value != parameters[i].type.value)
-                    goto search;
+        // look up the exact overload by its hash first
+        auto it = overloadTable.find(signature);
+        if (it != overloadTable.end())
+            return it->second;
+        for (Package* dependency : dependencies) {
+            it = dependency->overloadTable.find(signature);
+            if (it != dependency->overloadTable.end())
+                return it->second;
+        }
+
+        // fall back to the first overload with the same parameter count
+        for (MethodNode* method : getOverloads(signature.name)) {
+            if (method->parameters.size() == arguments.size())
+                return method;
+        }
+        for (Package* dependency : dependencies) {
+            for (MethodNode* method : dependency->getOverloads(signature.name)) {
+                if (method->parameters.size() == arguments.size())
+                    return method;
             }
-            // method parameters matches, method found
-            return method;
-        search:;
         }
-        // method not found, return a null method pointer
         return nullptr;
     }
 
+    /**
+     * Register a class, struct or tuple struct in the package.
+     * @param type declared type node
+     */
+    void Package::declareType(TypeNode* type) {
+        typeTable[Symbols::intern(type->name)] = type;
+        // register the type in the table of its kind as well
+        if (type->is(NodeType::Class))
+            classes[type->name] = as(type, Class);
+        else if (type->is(NodeType::Struct))
+            structs[type->name] = as(type, NormalStruct);
+        else if (type->is(NodeType::TupleStruct))
+            tupleStructs[type->name] = as(type, TupleStruct);
+    }
+
+    /**
+     * Register a method in the package.
+     * @param method declared method node
+     */
+    void Package::declareMethod(MethodNode* method) {
+        methodTable[getSignature(method->name, method->parameters)] = method;
+        methods.push_back(method);
+
+        // index the method by the kinds of its parameter descriptors, that do not depend on the resolved types
+        Symbol name = Symbols::intern(method->name);
+        overloads[name].push_back(method);
+        List<Symbol> kinds;
+        for (Parameter& parameter : method->parameters) {
+            char kind = MethodBuilder::getDescriptorKind(parameter.type);
+            // a type without a descriptor never matches the arguments exactly
+            if (kind == 0)
+                return;
+            kinds.push_back(Symbols::intern(UString(1, kind)));
+        }
+        // the first declared overload is chosen, if more of them have the same kinds of parameters
+        overloadTable.emplace(MethodSignature(name, kinds), method);
+    }
+
+    /**
+     * Create the interned signature of a method.
+     * @param name method name
+     * @param parameters method parameters
+     * @return method signature of symbols
+     */
+    MethodSignature Package::getSignature(UString name, List<Parameter>& parameters) {
+        List<Symbol> types;
+        for (Parameter& parameter : parameters)
+            types.push_back(Symbols::intern(parameter.type.value));
+        return MethodSignature(Symbols::intern(name), types);
+    }
+
     /**
      * Compile the parsed nodes to executable bytecode.
      * @bytecode executable bytecode result
      */
     void Package::compile(List<UString>& bytecode) {
         // compile the package classes
-        for (auto& [_, classNode] : classes) {
-            // compile the class node to bytecode
-            classNode->build(bytecode);
-        }
+        compileTypes(bytecode);
 
         // return if there are no package methods to be parsed
         if (methods.empty())
@@ -92,12 +163,234 @@ namespace Compiler {
         bytecode.push_back(U"cbegin");
 
         // compile the package methods
+        compileMethods(bytecode);
+
+        bytecode.push_back(U"cend");
+    }
+
+    /**
+     * Compile the package classes to executable bytecode.
+     * @bytecode executable bytecode result
+     */
+    void Package::compileTypes(List<UString>& bytecode) {
+        for (auto& [_, classNode] : classes) {
+            // compile the class node to bytecode
+            classNode->build(bytecode);
+        }
+    }
+
+    /**
+     * Compile the package methods to executable bytecode, without the wrapping package class.
+     * @bytecode executable bytecode result
+     */
+    void Package::compileMethods(List<UString>& bytecode) {
         for (MethodNode* method : methods) {
             // compile the method node to bytevode
             method->build(bytecode);
         }
+    }
 
-        bytecode.push_back(U"cend");
+    /**
+     * Compile the package methods to executable bytecode through the intermediate representation.
+     * @bytecode executable bytecode result
+     * @param passes the pass manager of the intermediate representation
+     */
+    void Package::compileMethods(List<UString>& bytecode, PassManager* passes) {
+        for (MethodNode* method : methods)
+            method->build(bytecode, passes);
+    }
+
+    /**
+     * Get the signatures of the declarations that are exposed by the package.
+     * @return sorted list of the declaration signatures
+     */
+    List<UString> Package::getExports() {
+        List<UString> exports;
+
+        // class Foo
+        for (auto& [typeName, _] : classes)
+            exports.push_back(U"class " + typeName);
+        // struct Foo
+        for (auto& [typeName, _] : structs)
+            exports.push_back(U"struct " + typeName);
+        // tuple Foo
+        for (auto& [typeName, _] : tupleStructs)
+            exports.push_back(U"tuple " + typeName);
+
+        // method foo(int, Bar): int
+        // the return type is exported as well, as the callers of the method depend on it
+        for (MethodNode* method : methods) {
+            UString signature = U"method " + method->name + U"(";
+            for (uint i = 0; i < method->parameters.size(); i++) {
+                signature += method->parameters[i].type.value;
+                if (i < method->parameters.size() - 1)
+                    signature += U", ";
+            }
+            signature += U"): ";
+            for (uint i = 0; i < method->returnTypes.size(); i++) {
+                signature += method->returnTypes[i].types[0].value;
+                if (i < method->returnTypes.size() - 1)
+                    signature += U", ";
+            }
+            exports.push_back(signature);
+        }
+
+        // the types are stored in hash maps, sort the signatures,
+        // so that the same declarations always produce the same exports
+        std::sort(exports.begin(), exports.end());
+        return exports;
+    }
+
+    /**
+     * Declare placeholder types and methods for the given export signatures.
+     * Used for the source files that are not parsed again, because their previous build could be reused.
+     * @param exports declaration signatures of a previous build
+     */
+    void Package::restoreExports(List<UString>& exports) {
+        for (UString& signature : exports) {
+            ulong space = signature.find(' ');
+            UString kind = signature.substr(0, space);
+            UString value = signature.substr(space + 1);
+
+            // declare an empty type with the exported name
+            if (kind == U"class")
+                declareType(new Class(this, value, List<UString>(), List<Node*>()));
+            else if (kind == U"struct")
+                declareType(new NormalStruct(this, value, List<UString>(), List<Node*>()));
+            else if (kind == U"tuple")
+                declareType(new TupleStruct(this, value, List<UString>(), false, List<TupleParameter>()));
+
+            // declare an empty method with the exported signature
+            else if (kind == U"method") {
+                ulong begin = value.find('(');
+                ulong end = value.find(U")");
+                UString methodName = value.substr(0, begin);
+                UString types = value.substr(begin + 1, end - begin - 1);
+                // the exports of the older builds do not have return types
+                UString returns = value.size() > end + 1 ? value.substr(end + 3) : U"void";
+                List<Parameter> parameters;
+                if (!types.empty()) {
+                    for (UString type : Strings::split(types, ',')) {
+                        // remove the separator space
+                        if (!type.empty() && type[0] == ' ')
+                            type = type.substr(1);
+                        TokenType tokenType = Tokenizer::isType(type) ? TokenType::Type : TokenType::Identifier;
+                        parameters.push_back(Parameter(Token::of(tokenType, type), List<Token>(), false, U""));
+                    }
+                }
+                List<NamedType> returnTypes;
+                for (UString type : Strings::split(returns, ',')) {
+                    if (!type.empty() && type[0] == ' ')
+                        type = type.substr(1);
+                    TokenType tokenType = Tokenizer::isType(type) ? TokenType::Type : TokenType::Identifier;
+                    returnTypes.push_back(NamedType({ Token::of(tokenType, type) }, List<Token>(), 0, false, U""));
+                }
+                declareMethod(new MethodNode(this, returnTypes, methodName, parameters, List<Node*>()));
+            }
+        }
+    }
+
+    /**
+     * Move the declarations of an other source file of the same package to this package.
+     * The source file package keeps only the lists of its own declarations, that are compiled to the bytecode of
+     * the source file, every lookup of the declarations goes through this package.
+     * @param other parsed source file package with the same name
+     */
+    void Package::merge(Package* other) {
+        // move the imports of the other source file
+        for (auto& [alias, target] : other->imports)
+            imports[alias] = target;
+
+        // move the methods of the other source file
+        // the signatures of the methods are resolved by this package, so they can see the declarations of every file
+        for (MethodNode* method : other->methods) {
+            if (getMethod(method->name, method->parameters) != nullptr)
+                error("Method " << method->name << " is declared multiple times in package '" << name << "'.");
+            method->Node::package = this;
+            declareMethod(method);
+        }
+
+        // move the types of the other source file
+        for (auto& [typeName, type] : other->typeTable) {
+            if (getType(typeName) != nullptr)
+                error("Type name '" << type->name << "' is already declared in package '" << name << "'.");
+            type->package = this;
+            declareType(type);
+        }
+
+        // clear the lookup tables of the source file package, so that nothing can be resolved from it anymore
+        other->typeTable.clear();
+        other->methodTable.clear();
+        other->overloadTable.clear();
+        other->overloads.clear();
+        other->resolvedTypes.clear();
+        other->dependencies.clear();
+    }
+
+    /**
+     * Resolve the imported packages and the types of the package method signatures.
+     * Should be called after all the project packages have been registered in the application.
+     */
+    void Package::resolve() {
+        // resolve the imported packages
+        // import "std/lang/*"        -> package "lang"
+        // import "std/lang/Console"  -> package "Console" or the package "lang" that declares it
+        for (auto& [_, target] : imports) {
+            Package* dependency = nullptr;
+            for (UString& packageName : getImportedNames(target)) {
+                dependency = application->getPackage(packageName);
+                if (dependency != nullptr)
+                    break;
+            }
+            // the package might be provided by a library that is not part of the project
+            if (dependency == nullptr) {
+                warn("Unable to resolve import \"" << target << "\" in package '" << name << "'.");
+                continue;
+            }
+            if (dependency != this && !(contains(dependencies, dependency)))
+                dependencies.push_back(dependency);
+        }
+
+        // resolve the types used by the method signatures
+        // only this package is modified, the other packages are read only,
+        // therefore the packages can be resolved in parallel
+        for (MethodNode* method : methods) {
+            for (Parameter& parameter : method->parameters)
+                resolveSignatureType(parameter.type);
+            for (NamedType& returnType : method->returnTypes) {
+                for (Token& type : returnType.types)
+                    resolveSignatureType(type);
+            }
+        }
+    }
+
+    /**
+     * Get the names of the packages that might be referred by an import.
+     * @param target the imported path
+     * @return candidate package names, the most specific first
+     */
+    List<UString> Package::getImportedNames(UString target) {
+        List<UString> path = Strings::split(target, '/');
+        List<UString> names;
+        if (path.back() != U"*")
+            names.push_back(path.back());
+        if (path.size() > 1)
+            names.push_back(path[path.size() - 2]);
+        return names;
+    }
+
+    /**
+     * Resolve a type of a method signature and cache its fully qualified name.
+     * @param type target type token
+     */
+    void Package::resolveSignatureType(Token& type) {
+        // ignore types that are already resolved
+        Symbol symbol = Symbols::intern(type.value);
+        if (resolvedTypes.find(symbol) != resolvedTypes.end())
+            return;
+        UString resolved = resolveType(type);
+        if (!resolved.empty())
+            resolvedTypes[symbol] = resolved;
     }
 
     /**
@@ -128,27 +421,18 @@ namespace Compiler {
         }
 
         else if (type.is(TokenType::Identifier)) {
-            // check if a package class uses the given name
-            for (auto& [_, classNode] : classes) {
-                if (classNode->name == name)
-                    return classNode->getFullName();
-            }
-
-            // check if a package struct uses the given name
-            for (auto& [_, structNode] : structs) {
-                if (structNode->name == name)
-                    return structNode->getFullName();
-            }
-
-            // check if a package tuple struct uses the given name
-            for (auto& [_, tupleStruct] : tupleStructs) {
-                if (tupleStruct->name == name)
-                    return tupleStruct->getFullName();
+            // check if a type of this package uses the given name
+            Symbol symbol = Symbols::intern(value);
+            TypeNode* typeNode = getType(symbol);
+            if (typeNode != nullptr)
+                return typeNode->getFullName();
+            // check if a type of an imported package uses the given name
+            for (Package* dependency : dependencies) {
+                typeNode = dependency->getType(symbol);
+                if (typeNode != nullptr)
+                    return typeNode->getFullName();
             }
         }
-
-       
-
         // package type not found, return null type pointer
         return U"";
     }
@@ -158,7 +442,9 @@ namespace Compiler {
      * @param type target type specifier prefix
      */
     UString Package::createAnonymusName(UString type) {
-        int id = (int) (random() * 100000000);
-        return Strings::toUTF(toString(id));
+        // packages are parsed on multiple threads, use a shared counter
+        // so that the anonymus names never collide
+        static std::atomic<uint> counter = 0;
+        return Strings::toUTF(toString(counter++));
     }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "../node/nodes/ValueNode.hpp"
 
 #include "Application.hpp"
+#include "Symbols.hpp"
 
 namespace Compiler {
     class Application;
@@ -22,6 +23,7 @@ namespace Compiler {
     class TypeNode;
     class MethodNode;
     class Parameter;
+    class PassManager;
 
     /**
      * Represens a per-file package. Each source file is a package as well. If the package is 
@@ -72,6 +74,37 @@ namespace Compiler {
          */
         Map<UString, TupleStruct*> tupleStructs;
 
+        /**
+         * The hashed scope table of all the package types, keyed by the interned type names.
+         */
+        Map<Symbol, TypeNode*> typeTable;
+
+        /**
+         * The hashed overload table of the package methods, keyed by the interned method signatures.
+         */
+        Map<MethodSignature, MethodNode*> methodTable;
+
+        /**
+         * The hashed overload table of the package methods, keyed by the interned method names and the kinds of their
+         * parameter descriptors, that are matched against the argument types of the method calls.
+         */
+        Map<MethodSignature, MethodNode*> overloadTable;
+
+        /**
+         * The package methods grouped by their interned names, in the order of their declarations.
+         */
+        Map<Symbol, List<MethodNode*>> overloads;
+
+        /**
+         * The list of the packages that are imported by this package.
+         */
+        List<Package*> dependencies;
+
+        /**
+         * The map of the fully qualified names of the types used by the package method signatures.
+         */
+        Map<Symbol, UString> resolvedTypes;
+
         /**
          * Initialize the package.
          * @param application parent application
@@ -85,13 +118,57 @@ namespace Compiler {
          */
         TypeNode* getType(UString name);
 
+        /**
+         * Get a type from the package by its interned name.
+         * @param name target type name symbol
+         * @return found type or nullptr if not found
+         */
+        TypeNode* getType(Symbol name);
+
         /**
          * Get a method from the package by its signature.
          * @param name target method name
          * @param parameters target method parameters
          * @return found method or nullptr if not found
          */
-        MethodNode* getMethod(UString name, List<Parameter> parameters);
+        MethodNode* getMethod(UString name, List<Parameter>& parameters);
+
+        /**
+         * Get the methods of the package with the given name.
+         * @param name interned method name
+         * @return the overloads of the method in the order of their declarations, empty if not found
+         */
+        const List<MethodNode*>& getOverloads(Symbol name);
+
+        /**
+         * Find the method that is called with the given arguments, from this package or its dependencies.
+         * The overload whose parameter types match the arguments exactly is preferred, otherwise the first method with
+         * the same name and parameter count is chosen. The methods of this package are preferred over the imported ones.
+         * @param name called method name
+         * @param arguments the kinds of the argument type descriptors
+         * @return called method, or nullptr if the method is not found
+         */
+        MethodNode* resolveCall(UString name, const UString& arguments);
+
+        /**
+         * Register a class, struct or tuple struct in the package.
+         * @param type declared type node
+         */
+        void declareType(TypeNode* type);
+
+        /**
+         * Register a method in the package.
+         * @param method declared method node
+         */
+        void declareMethod(MethodNode* method);
+
+        /**
+         * Create the interned signature of a method.
+         * @param name method name
+         * @param parameters method parameters
+         * @return method signature of symbols
+         */
+        static MethodSignature getSignature(UString name, List<Parameter>& parameters);
 
         /**
          * Compile the parsed nodes to executable bytecode.
@@ -99,6 +176,65 @@ namespace Compiler {
          */
         void compile(List<UString>& bytecode);
 
+        /**
+         * Compile the package classes to executable bytecode.
+         * @bytecode executable bytecode result
+         */
+        void compileTypes(List<UString>& bytecode);
+
+        /**
+         * Compile the package methods to executable bytecode, without the wrapping package class.
+         * @bytecode executable bytecode result
+         */
+        void compileMethods(List<UString>& bytecode);
+
+        /**
+         * Compile the package methods to executable bytecode through the intermediate representation.
+         * @bytecode executable bytecode result
+         * @param passes the pass manager of the intermediate representation
+         */
+        void compileMethods(List<UString>& bytecode, PassManager* passes);
+
+        /**
+         * Get the signatures of the declarations that are exposed by the package.
+         * @return sorted list of the declaration signatures
+         */
+        List<UString> getExports();
+
+        /**
+         * Declare placeholder types and methods for the given export signatures.
+         * Used for the source files that are not parsed again, because their previous build could be reused.
+         * @param exports declaration signatures of a previous build
+         */
+        void restoreExports(List<UString>& exports);
+
+        /**
+         * Move the declarations of an other source file of the same package to this package.
+         * The source file package keeps only the lists of its own declarations, that are compiled to the bytecode of
+         * the source file, every lookup of the declarations goes through this package.
+         * @param other parsed source file package with the same name
+         */
+        void merge(Package* other);
+
+        /**
+         * Resolve the imported packages and the types of the package method signatures.
+         * Should be called after all the project packages have been registered in the application.
+         */
+        void resolve();
+
+        /**
+         * Get the names of the packages that might be referred by an import.
+         * @param target the imported path
+         * @return candidate package names, the most specific first
+         */
+        static List<UString> getImportedNames(UString target);
+
+        /**
+         * Resolve a type of a method signature and cache its fully qualified name.
+         * @param type target type token
+         */
+        void resolveSignatureType(Token& type);
+
         /**
          * Try to resolve a declared type from the package.
          * @param type target type name
@@ -0,0 +1,99 @@
+#include "Symbols.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+
+namespace Compiler {
+    namespace Symbols {
+        /**
+         * The lock that guards the interner tables.
+         */
+        static std::shared_mutex lock;
+
+        /**
+         * The map of the interned identifiers to their symbols.
+         */
+        static Map<UString, Symbol> symbols = { { U"", EMPTY_SYMBOL } };
+
+        /**
+         * The interned identifiers indexed by their symbols.
+         * A deque is used, so that the returned identifier references stay valid when the table grows.
+         */
+        static std::deque<UString> names = { U"" };
+    }
+
+    /**
+     * Get the symbol of the given identifier. The identifier is registered if it has not been interned yet.
+     * @param name target identifier
+     * @return unique id of the identifier
+     */
+    Symbol Symbols::intern(const UString& name) {
+        // most of the identifiers are already interned, try to find them with a shared lock first
+        {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            auto it = symbols.find(name);
+            if (it != symbols.end())
+                return it->second;
+        }
+
+        // register the identifier, an other thread might have registered it in the meantime
+        std::unique_lock<std::shared_mutex> guard(lock);
+        auto it = symbols.find(name);
+        if (it != symbols.end())
+            return it->second;
+        Symbol symbol = (Symbol) names.size();
+        names.push_back(name);
+        symbols[name] = symbol;
+        return symbol;
+    }
+
+    /**
+     * Get the identifier of the given symbol.
+     * @param symbol interned symbol
+     * @return identifier of the symbol
+     */
+    const UString& Symbols::nameOf(Symbol symbol) {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return names[symbol];
+    }
+
+    /**
+     * Get the count of the interned identifiers.
+     * @return interned identifier count
+     */
+    uint Symbols::size() {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return (uint) names.size();
+    }
+
+    /**
+     * Initialize the method signature.
+     * @param name method name symbol
+     * @param parameters parameter type symbols
+     */
+    MethodSignature::MethodSignature(Symbol name, List<Symbol> parameters)
+        : name(name), parameters(parameters)
+    { }
+
+    /**
+     * Check if the two signatures are the same.
+     * @param other signature to compare with
+     * @return true if the name and the parameter types match
+     */
+    bool MethodSignature::operator==(const MethodSignature& other) const {
+        return name == other.name && parameters == other.parameters;
+    }
+}
+
+namespace std {
+    /**
+     * Make the method signature usable as a hash map key.
+     */
+    size_t hash<Compiler::MethodSignature>::operator()(const Compiler::MethodSignature& signature) const {
+        // combine the symbols the same way as boost::hash_combine
+        size_t hash = signature.name;
+        for (Compiler::Symbol parameter : signature.parameters)
+            hash ^= parameter + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+}
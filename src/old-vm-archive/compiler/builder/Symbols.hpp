@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Compiler {
+    /**
+     * Represents the unique integer id of an interned identifier.
+     * Two symbols are equal if and only if their identifiers are equal.
+     */
+    typedef uint Symbol;
+
+    /**
+     * The symbol of the empty identifier.
+     */
+    static const Symbol EMPTY_SYMBOL = 0;
+
+    /**
+     * Represents the compiler-wide identifier interner. Identifiers are interned once,
+     * then they are compared and hashed by their integer ids instead of their content.
+     * The interner is shared by the compiler threads.
+     */
+    namespace Symbols {
+        /**
+         * Get the symbol of the given identifier. The identifier is registered if it has not been interned yet.
+         * @param name target identifier
+         * @return unique id of the identifier
+         */
+        Symbol intern(const UString& name);
+
+        /**
+         * Get the identifier of the given symbol.
+         * @param symbol interned symbol
+         * @return identifier of the symbol
+         */
+        const UString& nameOf(Symbol symbol);
+
+        /**
+         * Get the count of the interned identifiers.
+         * @return interned identifier count
+         */
+        uint size();
+    }
+
+    /**
+     * Represents a method signature of the interned method name and parameter type symbols.
+     */
+    class MethodSignature {
+    public:
+        /**
+         * The symbol of the method name.
+         */
+        Symbol name;
+
+        /**
+         * The symbols of the method parameter types.
+         */
+        List<Symbol> parameters;
+
+        /**
+         * Initialize the method signature.
+         * @param name method name symbol
+         * @param parameters parameter type symbols
+         */
+        MethodSignature(Symbol name, List<Symbol> parameters);
+
+        /**
+         * Check if the two signatures are the same.
+         * @param other signature to compare with
+         * @return true if the name and the parameter types match
+         */
+        bool operator==(const MethodSignature& other) const;
+    };
+}
+
+namespace std {
+    /**
+     * Make the method signature usable as a hash map key.
+     */
+    template <>
+    struct hash<Compiler::MethodSignature> {
+        size_t operator()(const Compiler::MethodSignature& signature) const;
+    };
+}
@@ -0,0 +1,92 @@
+#include "BlockMerger.hpp"
+
+#include <algorithm>
+
+namespace Compiler {
+    /**
+     * Initialize the block merger.
+     */
+    BlockMerger::BlockMerger()
+        : IRPass("cfg")
+    { }
+
+    /**
+     * Merge and skip the blocks of a method.
+     * @param method target method
+     * @return the count of the removed blocks
+     */
+    uint BlockMerger::run(IRMethod* method) {
+        // the blocks are removed while iterating, start over after each change
+        uint removed = 0;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (IRBlock* block : method->blocks) {
+                IRInstruction* terminator = block->getTerminator();
+                if (terminator == nullptr || terminator->opcode != IROpcode::Jump)
+                    continue;
+                IRBlock* target = terminator->targets[0];
+                if (target == block || target == method->blocks[0])
+                    continue;
+
+                // a: ... jump b; b: ... -> a: ... ...
+                if (target->predecessors.size() == 1)
+                    merge(method, block, target);
+                // a: branch b, c; b: jump d -> a: branch d, c
+                // the phis of the target are ordered by the predecessors, therefore such targets are not changed
+                else if (block != method->blocks[0] && block->instructions.size() == 1 && target->getPhiCount() == 0)
+                    forward(method, block, target);
+                else
+                    continue;
+
+                removed++;
+                changed = true;
+                break;
+            }
+        }
+        return removed;
+    }
+
+    /**
+     * Append a block to its single predecessor, that jumps to it.
+     * @param method target method
+     * @param block predecessor block
+     * @param target appended block
+     */
+    void BlockMerger::merge(IRMethod* method, IRBlock* block, IRBlock* target) {
+        method->remove(block->getTerminator());
+
+        // the phis of a block with a single predecessor are copies of their only operand
+        for (IRInstruction* instruction : target->instructions) {
+            if (instruction->opcode == IROpcode::Phi) {
+                method->replaceUses(instruction, instruction->operands[0]);
+                continue;
+            }
+            instruction->block = block;
+            block->instructions.push_back(instruction);
+        }
+
+        // the successors of the target are continued from the merged block
+        block->successors = target->successors;
+        for (IRBlock* successor : target->successors)
+            std::replace(successor->predecessors.begin(), successor->predecessors.end(), target, block);
+        method->blocks.erase(std::find(method->blocks.begin(), method->blocks.end(), target));
+    }
+
+    /**
+     * Redirect the predecessors of a block, that only jumps to its target, to the target.
+     * @param method target method
+     * @param block skipped block
+     * @param target jump target of the skipped block
+     */
+    void BlockMerger::forward(IRMethod* method, IRBlock* block, IRBlock* target) {
+        for (IRBlock* predecessor : block->predecessors) {
+            IRInstruction* terminator = predecessor->getTerminator();
+            std::replace(terminator->targets.begin(), terminator->targets.end(), block, target);
+            std::replace(predecessor->successors.begin(), predecessor->successors.end(), block, target);
+            target->predecessors.push_back(predecessor);
+        }
+        target->predecessors.erase(std::find(target->predecessors.begin(), target->predecessors.end(), block));
+        method->blocks.erase(std::find(method->blocks.begin(), method->blocks.end(), block));
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+#include "PassManager.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that simplifies the control flow graph of a method.
+     * A block that is only entered from a single jump is appended to the jumping block, and the blocks that only
+     * jump to an other block are skipped by their predecessors. The structured statements create many such blocks,
+     * for example the end of an if statement, therefore this saves a jump for most of the statements.
+     */
+    class BlockMerger : public IRPass {
+    public:
+        /**
+         * Initialize the block merger.
+         */
+        BlockMerger();
+
+        /**
+         * Merge and skip the blocks of a method.
+         * @param method target method
+         * @return the count of the removed blocks
+         */
+        uint run(IRMethod* method) override;
+
+    private:
+        /**
+         * Append a block to its single predecessor, that jumps to it.
+         * @param method target method
+         * @param block predecessor block
+         * @param target appended block
+         */
+        void merge(IRMethod* method, IRBlock* block, IRBlock* target);
+
+        /**
+         * Redirect the predecessors of a block, that only jumps to its target, to the target.
+         * @param method target method
+         * @param block skipped block
+         * @param target jump target of the skipped block
+         */
+        void forward(IRMethod* method, IRBlock* block, IRBlock* target);
+    };
+}
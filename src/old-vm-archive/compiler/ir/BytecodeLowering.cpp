@@ -0,0 +1,468 @@
+#include "BytecodeLowering.hpp"
+
+#include "../../util/Strings.hpp"
+
+#include <algorithm>
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the instruction prefix of the given type descriptor.
+     * @param type value type descriptor
+     * @return instruction prefix
+     */
+    static UString getPrefix(char type) {
+        switch (type) {
+            case 'I':
+                return U"i";
+            case 'J':
+                return U"l";
+            case 'F':
+                return U"f";
+            case 'D':
+                return U"d";
+        }
+        error("Instance values are not supported by the code generator yet.");
+        return U"";
+    }
+
+    /**
+     * Get the conversion rank of the given type descriptor. Constants can be used as any type with a higher rank.
+     * @param type value type descriptor
+     * @return type rank
+     */
+    static int getRank(char type) {
+        switch (type) {
+            case 'I':
+                return 0;
+            case 'J':
+                return 1;
+            case 'F':
+                return 2;
+            case 'D':
+                return 3;
+        }
+        return 4;
+    }
+
+    /**
+     * Get the comparison that is true if the given comparison is false.
+     * @param operatorType comparison operator
+     * @return negated comparison operator
+     */
+    static OperatorType negateComparison(OperatorType operatorType) {
+        switch (operatorType) {
+            case OperatorType::Equal:
+                return OperatorType::NotEqual;
+            case OperatorType::NotEqual:
+                return OperatorType::Equal;
+            case OperatorType::Less:
+                return OperatorType::GreaterEqual;
+            case OperatorType::LessEqual:
+                return OperatorType::Greater;
+            case OperatorType::Greater:
+                return OperatorType::LessEqual;
+            case OperatorType::GreaterEqual:
+                return OperatorType::Less;
+            default:
+                return OperatorType::None;
+        }
+    }
+
+    /**
+     * Get the bytecode name of an arithmetic instruction.
+     * @param opcode arithmetic operation
+     * @return instruction name without the type prefix
+     */
+    static UString getArithmeticName(IROpcode opcode) {
+        switch (opcode) {
+            case IROpcode::Add:
+                return U"add";
+            case IROpcode::Subtract:
+                return U"sub";
+            case IROpcode::Multiply:
+                return U"mul";
+            case IROpcode::Divide:
+                return U"div";
+            default:
+                return U"mod";
+        }
+    }
+
+    /**
+     * Initialize the bytecode lowering.
+     * @param method lowered method graph
+     */
+    BytecodeLowering::BytecodeLowering(IRMethod* method)
+        : method(method)
+    { }
+
+    /**
+     * Lower the method graph to the bytecode of the method body.
+     * @param bytecode result bytecode list
+     */
+    void BytecodeLowering::lower(List<UString>& bytecode) {
+        splitCriticalEdges();
+
+        for (IRBlock* block : method->blocks) {
+            for (IRInstruction* instruction : block->instructions) {
+                for (IRInstruction* operand : instruction->operands)
+                    uses[operand]++;
+            }
+        }
+        assignSlots();
+
+        List<IRBlock*> order = method->getReversePostorder();
+        for (uint i = 0; i < order.size(); i++) {
+            IRBlock* block = order[i];
+            IRBlock* next = i + 1 < order.size() ? order[i + 1] : nullptr;
+            if (!block->predecessors.empty())
+                emit(U":" + block->getLabel());
+            for (IRInstruction* instruction : block->instructions)
+                lowerInstruction(instruction, next);
+        }
+
+        // iensure 4
+        // the storage of each type is sized once for every slot the method uses, before the first instruction
+        for (char type : { 'I', 'J', 'F', 'D' }) {
+            if (sizes[type] > 0)
+                bytecode.push_back(U"        " + getPrefix(type) + U"ensure " + Strings::toUTF(toString(sizes[type])));
+        }
+        for (UString& instruction : instructions)
+            bytecode.push_back(U"        " + instruction);
+    }
+
+    /**
+     * Split the edges from the blocks with multiple successors to the blocks with phis,
+     * so that the copies of the phis can be placed on a block that is only executed for that edge.
+     */
+    void BytecodeLowering::splitCriticalEdges() {
+        List<IRBlock*> blocks = method->blocks;
+        for (IRBlock* block : blocks) {
+            if (block->successors.size() < 2)
+                continue;
+            IRInstruction* terminator = block->getTerminator();
+            for (uint i = 0; i < block->successors.size(); i++) {
+                IRBlock* successor = block->successors[i];
+                if (successor->getPhiCount() == 0)
+                    continue;
+
+                // the edge block takes the place of this block in the predecessors of the successor,
+                // therefore the operands of the phis stay in the order of the predecessors
+                IRBlock* edge = method->createBlock();
+                IRInstruction* jump = method->create(IROpcode::Jump, 'V');
+                jump->targets = { successor };
+                jump->block = edge;
+                edge->instructions.push_back(jump);
+                edge->predecessors = { block };
+                edge->successors = { successor };
+
+                *std::find(successor->predecessors.begin(), successor->predecessors.end(), block) = edge;
+                block->successors[i] = edge;
+                terminator->targets[i] = edge;
+            }
+        }
+    }
+
+    /**
+     * Assign the storage slots of the values by their live ranges.
+     */
+    void BytecodeLowering::assignSlots() {
+        SlotAllocator allocator(method, uses);
+        allocator.allocate();
+        for (auto& [value, slot] : allocator.slots)
+            slots[value] = Strings::toUTF(toString(slot));
+        sizes = allocator.sizes;
+    }
+
+    /**
+     * Lower a single instruction.
+     * @param instruction target instruction
+     * @param next the block placed after the block of the instruction, or null
+     */
+    void BytecodeLowering::lowerInstruction(IRInstruction* instruction, IRBlock* next) {
+        char type = instruction->type;
+        switch (instruction->opcode) {
+            // the parameters are already in their slots, and the phis are written by their predecessors
+            case IROpcode::Parameter:
+            case IROpcode::Constant:
+            case IROpcode::Phi:
+                break;
+
+            case IROpcode::Add:
+            case IROpcode::Subtract:
+            case IROpcode::Multiply:
+            case IROpcode::Divide:
+            case IROpcode::Modulo:
+                lowerArithmetic(instruction);
+                break;
+
+            // ineg -l a -r 3
+            case IROpcode::Negate:
+                emit(getPrefix(type) + U"neg " + argument(getOperand(instruction->operands[0]), type) + U" -r " + slots[instruction]);
+                break;
+
+            // ipush 2
+            // iload a
+            // invokestatic <package>main foo I I
+            // istore 3
+            case IROpcode::Call:
+                for (IRInstruction* operand : instruction->operands)
+                    push(getOperand(operand), operand->type);
+                emit(U"invokestatic " + instruction->name);
+                if (type == 'V')
+                    break;
+                if (uses[instruction] == 0)
+                    emit(getPrefix(type) + U"pop");
+                else
+                    emit(getPrefix(type) + U"store " + slots[instruction]);
+                break;
+
+            // println "Hello, World"
+            // iload a
+            // idebug -n
+            case IROpcode::Print: {
+                if (instruction->operands.empty()) {
+                    emit(instruction->name + U" \"" + instruction->value + U"\"");
+                    break;
+                }
+                // ttemplate "x = {}" I -l x
+                // tdebug -n -k
+                // tdelete -s
+                if (!instruction->value.empty()) {
+                    List<Pair<char, UString>> arguments;
+                    for (IRInstruction* operand : instruction->operands)
+                        arguments.push_back({ operand->type, argument(getOperand(operand), operand->type) });
+                    for (UString& line : MethodBuilder::createTemplatePrint(instruction->value, arguments, instruction->name == U"println"))
+                        emit(line);
+                    break;
+                }
+                char printed = instruction->operands[0]->type;
+                push(getOperand(instruction->operands[0]), printed);
+                emit(getPrefix(printed) + U"debug" + (instruction->name == U"println" ? U" -n" : U""));
+                break;
+            }
+
+            // goto block3
+            case IROpcode::Jump: {
+                IRBlock* target = instruction->targets[0];
+                copyPhis(instruction->block, target);
+                if (target != next)
+                    emit(U"goto " + target->getLabel());
+                break;
+            }
+
+            case IROpcode::Branch:
+                lowerBranch(instruction, next);
+                break;
+
+            // tableswitch -l a -low 1 -default block2 -jump block3 block4
+            // the phis of the targets are copied on the split edges
+            case IROpcode::Switch: {
+                List<Pair<int, UString>> keys;
+                for (uint i = 0; i < instruction->keys.size(); i++) {
+                    for (int key : instruction->keys[i])
+                        keys.push_back({ key, instruction->targets[i + 1]->getLabel() });
+                }
+                IRBlock* fallback = instruction->targets[0];
+                UString value = argument(getOperand(instruction->operands[0]), 'I');
+                for (UString& jump : MethodBuilder::createSwitch(value, keys, fallback->getLabel(), fallback == next))
+                    emit(jump);
+                break;
+            }
+
+            // ireturn -l a
+            case IROpcode::Return:
+                if (instruction->operands.empty())
+                    emit(U"return");
+                else {
+                    char returned = method->returnType;
+                    emit(getPrefix(returned) + U"return " + argument(getOperand(instruction->operands[0]), returned));
+                }
+                break;
+        }
+    }
+
+    /**
+     * Lower an arithmetic instruction.
+     * @param instruction target instruction
+     */
+    void BytecodeLowering::lowerArithmetic(IRInstruction* instruction) {
+        char type = instruction->type;
+        Operand left = getOperand(instruction->operands[0]);
+        Operand right = getOperand(instruction->operands[1]);
+        UString result = slots[instruction];
+
+        // the constant of an addition is moved to the right, so that the step can be performed in place, 1 + a -> a + 1
+        if (instruction->opcode == IROpcode::Add && left.isConstant() && !right.isConstant())
+            std::swap(left, right);
+
+        // iinc -l a -r a
+        // the integral steps by one are performed in place, if the value is stored in the slot of its operand
+        bool step = instruction->opcode == IROpcode::Add || instruction->opcode == IROpcode::Subtract;
+        if (step && (type == 'I' || type == 'J') && !left.isConstant() && left.value == result
+                && right.isConstant() && right.value == U"1") {
+            UString name = instruction->opcode == IROpcode::Add ? U"inc" : U"decr";
+            emit(getPrefix(type) + name + U" -l " + result + U" -r " + result);
+            return;
+        }
+
+        // iadd -l a -c 2 -r 3
+        emit(getPrefix(type) + getArithmeticName(instruction->opcode) + U" " + argument(left, type) + U" "
+            + argument(right, type) + U" -r " + result);
+    }
+
+    /**
+     * Lower a conditional branch, that falls through to the next block when possible.
+     * @param instruction target branch
+     * @param next the block placed after the block of the branch, or null
+     */
+    void BytecodeLowering::lowerBranch(IRInstruction* instruction, IRBlock* next) {
+        IRBlock* trueBlock = instruction->targets[0];
+        IRBlock* falseBlock = instruction->targets[1];
+        char type = instruction->operands[0]->type;
+        UString left = argument(getOperand(instruction->operands[0]), type);
+        UString right = argument(getOperand(instruction->operands[1]), type);
+
+        // ifi< -l a -c 10 -jump block2
+        // the comparison is negated if the true block follows the branch
+        OperatorType comparison = instruction->comparison;
+        IRBlock* target = trueBlock;
+        IRBlock* otherwise = falseBlock;
+        if (trueBlock == next && falseBlock != next) {
+            comparison = negateComparison(comparison);
+            target = falseBlock;
+            otherwise = trueBlock;
+        }
+        emit(U"if" + getPrefix(type) + getOperatorInfo(comparison).symbol + U" " + left + U" " + right
+            + U" -jump " + target->getLabel());
+        if (otherwise != next)
+            emit(U"goto " + otherwise->getLabel());
+    }
+
+    /**
+     * Copy the operands of the phis of a block, that belong to the given predecessor, to the slots of the phis.
+     * The copies are performed as if they were executed at once, a phi might use the previous value of an other phi.
+     * @param from predecessor block
+     * @param to block of the phis
+     */
+    void BytecodeLowering::copyPhis(IRBlock* from, IRBlock* to) {
+        uint index = (uint) (std::find(to->predecessors.begin(), to->predecessors.end(), from) - to->predecessors.begin());
+
+        // collect the copies that actually change a slot
+        List<Pair<UString, Operand>> copies;
+        for (uint i = 0; i < to->getPhiCount(); i++) {
+            IRInstruction* phi = to->instructions[i];
+            Operand value = getOperand(phi->operands[index]);
+            if (!value.isConstant() && value.value == slots[phi])
+                continue;
+            copies.push_back({ slots[phi], value });
+        }
+
+        while (!copies.empty()) {
+            // find a copy, whose target slot is not read by the other copies anymore
+            uint found = (uint) copies.size();
+            for (uint i = 0; i < copies.size() && found == copies.size(); i++) {
+                bool read = false;
+                for (uint j = 0; j < copies.size() && !read; j++)
+                    read = j != i && !copies[j].second.isConstant() && copies[j].second.value == copies[i].first;
+                if (!read)
+                    found = i;
+            }
+
+            // the remaining copies form a cycle, a = b, b = a
+            // save the value of a target slot, so that its copy can be performed
+            if (found == copies.size()) {
+                UString saved = copies[0].first;
+                char type = copies[0].second.type;
+                UString temp = getTemporary(type);
+                move(Operand(OperandKind::Local, type, saved), type, temp);
+                for (auto& [_, value] : copies) {
+                    if (!value.isConstant() && value.value == saved)
+                        value.value = temp;
+                }
+                found = 0;
+            }
+
+            auto& [target, value] = copies[found];
+            move(value, value.type, target);
+            copies.erase(copies.begin() + found);
+        }
+    }
+
+    /**
+     * Get the operand that reads the value, from its storage slot or as a constant.
+     * @param value target value
+     * @return value operand
+     */
+    Operand BytecodeLowering::getOperand(IRInstruction* value) {
+        if (value->opcode == IROpcode::Constant)
+            return Operand(OperandKind::Constant, value->type, value->value);
+        return Operand(OperandKind::Local, value->type, slots[value]);
+    }
+
+    /**
+     * Copy the operand value to the given slot.
+     * @param value source operand
+     * @param type slot type descriptor
+     * @param result target slot
+     */
+    void BytecodeLowering::move(Operand value, char type, UString result) {
+        // iset a 2
+        if (value.isConstant()) {
+            argument(value, type);
+            emit(getPrefix(type) + U"set " + result + U" " + value.value);
+        }
+        // iadd -l b -c 0 -r a
+        else if (value.value != result)
+            emit(getPrefix(type) + U"add " + argument(value, type) + U" -c 0 -r " + result);
+    }
+
+    /**
+     * Push the operand value to the stack.
+     * @param value source operand
+     * @param type stack type descriptor
+     */
+    void BytecodeLowering::push(Operand value, char type) {
+        argument(value, type);
+        if (value.isConstant())
+            emit(getPrefix(type) + U"push " + value.value);
+        else
+            emit(getPrefix(type) + U"load " + value.value);
+    }
+
+    /**
+     * Get the instruction argument that reads the operand using the local or constant operand mode.
+     * @param value source operand
+     * @param type instruction type descriptor
+     * @return operand instruction argument
+     */
+    UString BytecodeLowering::argument(Operand value, char type) {
+        // the builder has already converted the values, this only guards against the passes mixing up the types
+        if (value.type != type && (!value.isConstant() || getRank(value.type) > getRank(type)))
+            error("Implicit conversion from " << (char) value.type << " to " << (char) type << " is not supported.");
+        return (value.isConstant() ? U"-c " : U"-l ") + value.value;
+    }
+
+    /**
+     * Get the slot, that saves a value while the copies of the phis are performed.
+     * @param type slot type descriptor
+     * @return temporary slot name
+     */
+    UString BytecodeLowering::getTemporary(char type) {
+        // a cycle of copies is only broken when the previous cycles are already resolved,
+        // therefore a single temporary slot of each type is enough
+        if (temporaries.find(type) == temporaries.end())
+            temporaries[type] = Strings::toUTF(toString(sizes[type]++));
+        return temporaries[type];
+    }
+
+    /**
+     * Append an instruction to the method body.
+     * @param instruction bytecode instruction
+     */
+    void BytecodeLowering::emit(UString instruction) {
+        instructions.push_back(instruction);
+    }
+}
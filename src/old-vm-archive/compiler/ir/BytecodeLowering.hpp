@@ -0,0 +1,144 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../builder/MethodBuilder.hpp"
+
+#include "IR.hpp"
+#include "SlotAllocator.hpp"
+
+namespace Compiler {
+    /**
+     * Represents the last stage of the code generation through the intermediate representation, that converts
+     * the control flow graph of a method to bytecode. The values share the storage slots of their type by their
+     * live ranges, and the phis are replaced by copies at the end of the predecessors of their block. The blocks
+     * are placed in reverse postorder, so that most of the jumps fall through to the next block.
+     */
+    class BytecodeLowering {
+    private:
+        /**
+         * The lowered method graph.
+         */
+        IRMethod* method;
+
+        /**
+         * The map of the storage slots of the values.
+         */
+        Map<IRInstruction*, UString> slots;
+
+        /**
+         * The map of the use counts of the values.
+         */
+        Map<IRInstruction*, uint> uses;
+
+        /**
+         * The map of the count of the used storage slots by the value types.
+         */
+        Map<char, uint> sizes;
+
+        /**
+         * The map of the temporary slots of the phi copies by the value types.
+         */
+        Map<char, UString> temporaries;
+
+        /**
+         * The generated method instructions.
+         */
+        List<UString> instructions;
+
+    public:
+        /**
+         * Initialize the bytecode lowering.
+         * @param method lowered method graph
+         */
+        BytecodeLowering(IRMethod* method);
+
+        /**
+         * Lower the method graph to the bytecode of the method body.
+         * @param bytecode result bytecode list
+         */
+        void lower(List<UString>& bytecode);
+
+    private:
+        /**
+         * Split the edges from the blocks with multiple successors to the blocks with phis,
+         * so that the copies of the phis can be placed on a block that is only executed for that edge.
+         */
+        void splitCriticalEdges();
+
+        /**
+         * Assign the storage slots of the values by their live ranges.
+         */
+        void assignSlots();
+
+        /**
+         * Lower a single instruction.
+         * @param instruction target instruction
+         * @param next the block placed after the block of the instruction, or null
+         */
+        void lowerInstruction(IRInstruction* instruction, IRBlock* next);
+
+        /**
+         * Lower an arithmetic instruction.
+         * @param instruction target instruction
+         */
+        void lowerArithmetic(IRInstruction* instruction);
+
+        /**
+         * Lower a conditional branch, that falls through to the next block when possible.
+         * @param instruction target branch
+         * @param next the block placed after the block of the branch, or null
+         */
+        void lowerBranch(IRInstruction* instruction, IRBlock* next);
+
+        /**
+         * Copy the operands of the phis of a block, that belong to the given predecessor, to the slots of the phis.
+         * The copies are performed as if they were executed at once, a phi might use the previous value of an other phi.
+         * @param from predecessor block
+         * @param to block of the phis
+         */
+        void copyPhis(IRBlock* from, IRBlock* to);
+
+        /**
+         * Get the operand that reads the value, from its storage slot or as a constant.
+         * @param value target value
+         * @return value operand
+         */
+        Operand getOperand(IRInstruction* value);
+
+        /**
+         * Copy the operand value to the given slot.
+         * @param value source operand
+         * @param type slot type descriptor
+         * @param result target slot
+         */
+        void move(Operand value, char type, UString result);
+
+        /**
+         * Push the operand value to the stack.
+         * @param value source operand
+         * @param type stack type descriptor
+         */
+        void push(Operand value, char type);
+
+        /**
+         * Get the instruction argument that reads the operand using the local or constant operand mode.
+         * @param value source operand
+         * @param type instruction type descriptor
+         * @return operand instruction argument
+         */
+        UString argument(Operand value, char type);
+
+        /**
+         * Get the slot, that saves a value while the copies of the phis are performed.
+         * @param type slot type descriptor
+         * @return temporary slot name
+         */
+        UString getTemporary(char type);
+
+        /**
+         * Append an instruction to the method body.
+         * @param instruction bytecode instruction
+         */
+        void emit(UString instruction);
+    };
+}
@@ -0,0 +1,55 @@
+#include "CopyPropagator.hpp"
+
+namespace Compiler {
+    /**
+     * Initialize the copy propagator.
+     */
+    CopyPropagator::CopyPropagator()
+        : IRPass("copy")
+    { }
+
+    /**
+     * Replace the phis of a method that merge a single value.
+     * @param method target method
+     * @return the count of the removed phis
+     */
+    uint CopyPropagator::run(IRMethod* method) {
+        // removing a phi might make an other phi that used it a copy, repeat until nothing changes
+        uint removed = 0;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (IRBlock* block : method->blocks) {
+                for (uint i = 0; i < block->getPhiCount(); i++) {
+                    IRInstruction* phi = block->instructions[i];
+                    IRInstruction* value = getCopiedValue(phi);
+                    if (value == nullptr)
+                        continue;
+                    method->replaceUses(phi, value);
+                    method->remove(phi);
+                    removed++;
+                    changed = true;
+                    i--;
+                }
+            }
+        }
+        return removed;
+    }
+
+    /**
+     * Get the single value that is merged by a phi. The phi itself is ignored, as a loop refers back to it.
+     * @param phi target phi
+     * @return copied value, or null if the phi merges different values
+     */
+    IRInstruction* CopyPropagator::getCopiedValue(IRInstruction* phi) {
+        IRInstruction* value = nullptr;
+        for (IRInstruction* operand : phi->operands) {
+            if (operand == phi || operand == value)
+                continue;
+            if (value != nullptr)
+                return nullptr;
+            value = operand;
+        }
+        return value;
+    }
+}
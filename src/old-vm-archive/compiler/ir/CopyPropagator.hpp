@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+#include "PassManager.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that replaces the copies of the values with the copied values.
+     * In static single assignment form an assignment of a variable does not create an instruction, the variable
+     * refers to the assigned value directly, therefore the only copies are the phis that merge a single value.
+     * Such phis are created when a variable is not changed by a loop or by the cases of a condition.
+     */
+    class CopyPropagator : public IRPass {
+    public:
+        /**
+         * Initialize the copy propagator.
+         */
+        CopyPropagator();
+
+        /**
+         * Replace the phis of a method that merge a single value.
+         * @param method target method
+         * @return the count of the removed phis
+         */
+        uint run(IRMethod* method) override;
+
+    private:
+        /**
+         * Get the single value that is merged by a phi. The phi itself is ignored, as a loop refers back to it.
+         * @param phi target phi
+         * @return copied value, or null if the phi merges different values
+         */
+        IRInstruction* getCopiedValue(IRInstruction* phi);
+    };
+}
@@ -0,0 +1,419 @@
+#include "IR.hpp"
+
+#include "../token/Token.hpp"
+#include "../../util/Strings.hpp"
+
+#include <algorithm>
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the name of the given instruction operation.
+     * @param opcode instruction operation
+     * @return operation name
+     */
+    static String getOpcodeName(IROpcode opcode) {
+        switch (opcode) {
+            case IROpcode::Parameter:
+                return "param";
+            case IROpcode::Constant:
+                return "const";
+            case IROpcode::Phi:
+                return "phi";
+            case IROpcode::Add:
+                return "add";
+            case IROpcode::Subtract:
+                return "sub";
+            case IROpcode::Multiply:
+                return "mul";
+            case IROpcode::Divide:
+                return "div";
+            case IROpcode::Modulo:
+                return "mod";
+            case IROpcode::Negate:
+                return "neg";
+            case IROpcode::Call:
+                return "call";
+            case IROpcode::Print:
+                return "print";
+            case IROpcode::Jump:
+                return "jump";
+            case IROpcode::Branch:
+                return "branch";
+            case IROpcode::Switch:
+                return "switch";
+            case IROpcode::Return:
+                return "return";
+        }
+        return "unknown";
+    }
+
+    /**
+     * Print the reference of an instruction operand to the output stream.
+     * @param stream target output stream
+     * @param operand target operand
+     */
+    static void printOperand(OutputStream& stream, IRInstruction* operand) {
+        if (operand->opcode == IROpcode::Constant)
+            stream << operand->value << operand->type;
+        else
+            stream << '%' << operand->id;
+    }
+
+    /**
+     * Initialize the instruction.
+     * @param id instruction identifier
+     * @param opcode instruction operation
+     * @param type produced value type descriptor
+     */
+    IRInstruction::IRInstruction(uint id, IROpcode opcode, char type)
+        : id(id), opcode(opcode), type(type)
+    { }
+
+    /**
+     * Determine if the instruction ends its block.
+     * @return true if the instruction is a jump, branch, switch or return
+     */
+    bool IRInstruction::isTerminator() {
+        return opcode == IROpcode::Jump || opcode == IROpcode::Branch || opcode == IROpcode::Switch || opcode == IROpcode::Return;
+    }
+
+    /**
+     * Determine if the instruction has an effect other than producing its value.
+     * Such instructions must be executed even if their value is not used.
+     * @return true if the instruction cannot be removed
+     */
+    bool IRInstruction::hasSideEffects() {
+        // an integral division by zero stops the program, therefore it is kept unless the divisor is a known non-zero constant
+        if ((opcode == IROpcode::Divide || opcode == IROpcode::Modulo) && (type == 'I' || type == 'J')) {
+            IRInstruction* divisor = operands[1];
+            return divisor->opcode != IROpcode::Constant || divisor->value == U"0";
+        }
+        return opcode == IROpcode::Call || opcode == IROpcode::Print || isTerminator();
+    }
+
+    /**
+     * Determine if the instruction is an arithmetic operation of two operands.
+     * @return true if the instruction is an arithmetic operation
+     */
+    bool IRInstruction::isArithmetic() {
+        return opcode >= IROpcode::Add && opcode <= IROpcode::Modulo;
+    }
+
+    /**
+     * Print the instruction to the output stream.
+     * @param stream target output stream
+     */
+    void IRInstruction::debug(OutputStream& stream) {
+        // %3:I = add %2, 1I
+        if (type != 'V')
+            stream << '%' << id << ':' << type << " = ";
+        if (opcode == IROpcode::Print)
+            stream << name;
+        else
+            stream << getOpcodeName(opcode);
+
+        if (opcode == IROpcode::Parameter || opcode == IROpcode::Call)
+            stream << ' ' << name;
+        // a template print has both the pattern and the interpolated values
+        if (opcode == IROpcode::Print && (operands.empty() || !value.empty()))
+            stream << (operands.empty() ? " \"" : " $\"") << value << '"';
+        if (opcode == IROpcode::Branch)
+            stream << ' ' << UString(getOperatorInfo(comparison).symbol);
+
+        // phi operands are printed with the predecessor they are coming from
+        for (uint i = 0; i < operands.size(); i++) {
+            stream << (i == 0 ? " " : ", ");
+            if (opcode == IROpcode::Phi) {
+                stream << '[';
+                printOperand(stream, operands[i]);
+                stream << ", " << block->predecessors[i]->getLabel() << ']';
+            }
+            else
+                printOperand(stream, operands[i]);
+        }
+
+        // the case targets of a switch are printed with their keys
+        for (uint i = 0; i < targets.size(); i++) {
+            stream << (i == 0 && operands.empty() ? " " : ", ");
+            if (opcode == IROpcode::Switch && i > 0) {
+                for (uint j = 0; j < keys[i - 1].size(); j++)
+                    stream << (j == 0 ? "" : "|") << keys[i - 1][j];
+                stream << " -> ";
+            }
+            stream << targets[i]->getLabel();
+        }
+        stream << '\n';
+    }
+
+    /**
+     * Initialize the block.
+     * @param id block identifier
+     */
+    IRBlock::IRBlock(uint id)
+        : id(id)
+    { }
+
+    /**
+     * Get the last instruction of the block, if it ends the block.
+     * @return block terminator, or null if the block is not terminated yet
+     */
+    IRInstruction* IRBlock::getTerminator() {
+        if (instructions.empty() || !instructions.back()->isTerminator())
+            return nullptr;
+        return instructions.back();
+    }
+
+    /**
+     * Get the count of the phis at the start of the block.
+     * @return phi count
+     */
+    uint IRBlock::getPhiCount() {
+        uint count = 0;
+        while (count < instructions.size() && instructions[count]->opcode == IROpcode::Phi)
+            count++;
+        return count;
+    }
+
+    /**
+     * Get the name of the jump section of the block.
+     * @return block label
+     */
+    UString IRBlock::getLabel() {
+        return U"block" + Strings::toUTF(toString(id));
+    }
+
+    /**
+     * Initialize the method.
+     * @param package method package
+     * @param method source method node
+     * @param returnType return type descriptor
+     */
+    IRMethod::IRMethod(Package* package, MethodNode* method, char returnType)
+        : package(package), method(method), returnType(returnType)
+    { }
+
+    /**
+     * Create a new block at the end of the method.
+     * @return created block
+     */
+    IRBlock* IRMethod::createBlock() {
+        IRBlock* block = new IRBlock(labels++);
+        blocks.push_back(block);
+        return block;
+    }
+
+    /**
+     * Create a new instruction, that is not placed in a block yet.
+     * @param opcode instruction operation
+     * @param type produced value type descriptor
+     * @return created instruction
+     */
+    IRInstruction* IRMethod::create(IROpcode opcode, char type) {
+        return new IRInstruction(values++, opcode, type);
+    }
+
+    /**
+     * Get the constant of the given type and value.
+     * @param type constant type descriptor
+     * @param value constant value
+     * @return constant instruction
+     */
+    IRInstruction* IRMethod::getConstant(char type, UString value) {
+        UString key = UString(1, (cint) type) + value;
+        auto found = constants.find(key);
+        if (found != constants.end())
+            return found->second;
+
+        IRInstruction* constant = create(IROpcode::Constant, type);
+        constant->value = value;
+        constants[key] = constant;
+        return constant;
+    }
+
+    /**
+     * Add a control flow edge between two blocks.
+     * @param from source block
+     * @param to target block
+     */
+    void IRMethod::link(IRBlock* from, IRBlock* to) {
+        from->successors.push_back(to);
+        to->predecessors.push_back(from);
+    }
+
+    /**
+     * Remove a control flow edge between two blocks. The phi operands of the removed edge are removed as well.
+     * @param from source block
+     * @param to target block
+     */
+    void IRMethod::unlink(IRBlock* from, IRBlock* to) {
+        auto successor = std::find(from->successors.begin(), from->successors.end(), to);
+        if (successor != from->successors.end())
+            from->successors.erase(successor);
+
+        auto predecessor = std::find(to->predecessors.begin(), to->predecessors.end(), from);
+        if (predecessor == to->predecessors.end())
+            return;
+        uint index = (uint) (predecessor - to->predecessors.begin());
+        to->predecessors.erase(predecessor);
+        for (uint i = 0; i < to->getPhiCount(); i++)
+            to->instructions[i]->operands.erase(to->instructions[i]->operands.begin() + index);
+    }
+
+    /**
+     * Replace the uses of a value with an other value.
+     * @param value replaced value
+     * @param replacement new value
+     */
+    void IRMethod::replaceUses(IRInstruction* value, IRInstruction* replacement) {
+        for (IRBlock* block : blocks) {
+            for (IRInstruction* instruction : block->instructions) {
+                for (IRInstruction*& operand : instruction->operands) {
+                    if (operand == value)
+                        operand = replacement;
+                }
+            }
+        }
+    }
+
+    /**
+     * Remove an instruction from its block.
+     * @param instruction target instruction
+     */
+    void IRMethod::remove(IRInstruction* instruction) {
+        List<IRInstruction*>& instructions = instruction->block->instructions;
+        instructions.erase(std::find(instructions.begin(), instructions.end(), instruction));
+        instruction->block = nullptr;
+    }
+
+    /**
+     * Remove the blocks that cannot be reached from the entry block.
+     * @return the count of the removed blocks
+     */
+    uint IRMethod::removeUnreachable() {
+        List<IRBlock*> reachable = getReversePostorder();
+        if (reachable.size() == blocks.size())
+            return 0;
+
+        // remove the edges of the unreachable blocks first, so that the phis of the reachable blocks are updated
+        uint removed = 0;
+        for (IRBlock* block : blocks) {
+            if (contains(reachable, block))
+                continue;
+            List<IRBlock*> successors = block->successors;
+            for (IRBlock* successor : successors)
+                unlink(block, successor);
+            removed++;
+        }
+
+        // keep the reachable blocks in their original order
+        List<IRBlock*> result;
+        for (IRBlock* block : blocks) {
+            if (contains(reachable, block))
+                result.push_back(block);
+        }
+        blocks = result;
+        return removed;
+    }
+
+    /**
+     * Get the blocks in reverse postorder. Every block is placed after its dominators, and the successors
+     * are visited in order, so that the first target of a branch follows it when possible.
+     * @return ordered blocks
+     */
+    List<IRBlock*> IRMethod::getReversePostorder() {
+        List<IRBlock*> order;
+        if (blocks.empty())
+            return order;
+
+        // iterative depth-first search, the successors are pushed in reverse order,
+        // therefore the last successor is finished first and placed last in the reversed order
+        List<IRBlock*> visited = { blocks[0] };
+        List<Pair<IRBlock*, uint>> stack = { { blocks[0], (uint) blocks[0]->successors.size() } };
+        while (!stack.empty()) {
+            auto& [block, next] = stack.back();
+            if (next == 0) {
+                order.push_back(block);
+                stack.pop_back();
+                continue;
+            }
+            IRBlock* successor = block->successors[--next];
+            if (contains(visited, successor))
+                continue;
+            visited.push_back(successor);
+            stack.push_back({ successor, (uint) successor->successors.size() });
+        }
+
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    /**
+     * Get the immediate dominator of each reachable block. A block dominates an other block, if every path
+     * from the entry block to the other block goes through it. The entry block is its own dominator.
+     * @return the map of the immediate dominators by the blocks
+     */
+    Map<IRBlock*, IRBlock*> IRMethod::getDominators() {
+        List<IRBlock*> order = getReversePostorder();
+        Map<IRBlock*, uint> indices;
+        for (uint i = 0; i < order.size(); i++)
+            indices[order[i]] = i;
+
+        // the dominators are refined in reverse postorder until they do not change,
+        // the structured loops have a single back edge, therefore this converges in a few iterations
+        Map<IRBlock*, IRBlock*> dominators;
+        if (order.empty())
+            return dominators;
+        dominators[order[0]] = order[0];
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (uint i = 1; i < order.size(); i++) {
+                IRBlock* dominator = nullptr;
+                for (IRBlock* predecessor : order[i]->predecessors) {
+                    if (dominators.find(predecessor) == dominators.end())
+                        continue;
+                    if (dominator == nullptr) {
+                        dominator = predecessor;
+                        continue;
+                    }
+                    // walk up from both blocks to their nearest common dominator
+                    IRBlock* other = predecessor;
+                    while (dominator != other) {
+                        while (indices[dominator] > indices[other])
+                            dominator = dominators[dominator];
+                        while (indices[other] > indices[dominator])
+                            other = dominators[other];
+                    }
+                }
+                auto previous = dominators.find(order[i]);
+                if (previous == dominators.end() || previous->second != dominator) {
+                    dominators[order[i]] = dominator;
+                    changed = true;
+                }
+            }
+        }
+        return dominators;
+    }
+
+    /**
+     * Print the blocks of the method to the output stream.
+     * @param stream target output stream
+     */
+    void IRMethod::debug(OutputStream& stream) {
+        for (IRBlock* block : blocks) {
+            stream << "    " << block->getLabel() << ':';
+            if (!block->predecessors.empty()) {
+                stream << " ; from ";
+                for (uint i = 0; i < block->predecessors.size(); i++)
+                    stream << (i > 0 ? ", " : "") << block->predecessors[i]->getLabel();
+            }
+            stream << '\n';
+            for (IRInstruction* instruction : block->instructions) {
+                stream << "        ";
+                instruction->debug(stream);
+            }
+        }
+    }
+}
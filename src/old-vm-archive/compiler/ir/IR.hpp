@@ -0,0 +1,303 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Operator.hpp"
+
+namespace Compiler {
+    class Package;
+    class MethodNode;
+    class IRBlock;
+
+    /**
+     * Represents a registry of the operations of the intermediate representation.
+     */
+    enum class IROpcode {
+        Parameter, // %0 = param a
+        Constant,  // %1 = const 10
+        Phi,       // %2 = phi [%0, block0], [%4, block2]
+        Add,       // %3 = add %2, %1
+        Subtract,  // %3 = sub %2, %1
+        Multiply,  // %3 = mul %2, %1
+        Divide,    // %3 = div %2, %1
+        Modulo,    // %3 = mod %2, %1
+        Negate,    // %4 = neg %3
+        Call,      // %5 = call <package>main foo I J (%3, %4)
+        Print,     // println %5
+        Jump,      // jump block1
+        Branch,    // branch < %2, %1, block1, block2
+        Switch,    // switch %2, block1, 1|2 -> block2, 5 -> block3
+        Return     // return %5
+    };
+
+    /**
+     * Represents a single typed operation of a method. Every instruction that produces a value is assigned
+     * exactly once, therefore the instruction itself represents its value in the operands of the later instructions.
+     */
+    class IRInstruction {
+    public:
+        /**
+         * The unique identifier of the instruction in its method.
+         */
+        uint id;
+
+        /**
+         * The operation performed by the instruction.
+         */
+        IROpcode opcode;
+
+        /**
+         * The type descriptor of the produced value, I, J, F, D or L, V if the instruction does not produce a value.
+         */
+        char type;
+
+        /**
+         * The values used by the instruction. The operands of a phi are ordered by the predecessors of its block.
+         */
+        List<IRInstruction*> operands;
+
+        /**
+         * The name of the parameter, the called method or the print method.
+         */
+        UString name;
+
+        /**
+         * The value of the constant, or the printed text.
+         */
+        UString value;
+
+        /**
+         * The comparison of the operands of a branch.
+         */
+        OperatorType comparison = OperatorType::None;
+
+        /**
+         * The jump targets of a terminator. A branch jumps to the first target if the comparison is true,
+         * a switch jumps to the first target if none of its case keys match.
+         */
+        List<IRBlock*> targets;
+
+        /**
+         * The case keys of a switch, for each of its targets after the first one.
+         */
+        List<List<int>> keys;
+
+        /**
+         * The block that contains the instruction, or null for the constants.
+         */
+        IRBlock* block = nullptr;
+
+        /**
+         * Initialize the instruction.
+         * @param id instruction identifier
+         * @param opcode instruction operation
+         * @param type produced value type descriptor
+         */
+        IRInstruction(uint id, IROpcode opcode, char type);
+
+        /**
+         * Determine if the instruction ends its block.
+         * @return true if the instruction is a jump, branch, switch or return
+         */
+        bool isTerminator();
+
+        /**
+         * Determine if the instruction has an effect other than producing its value.
+         * Such instructions must be executed even if their value is not used.
+         * @return true if the instruction cannot be removed
+         */
+        bool hasSideEffects();
+
+        /**
+         * Determine if the instruction is an arithmetic operation of two operands.
+         * @return true if the instruction is an arithmetic operation
+         */
+        bool isArithmetic();
+
+        /**
+         * Print the instruction to the output stream.
+         * @param stream target output stream
+         */
+        void debug(OutputStream& stream);
+    };
+
+    /**
+     * Represents a basic block of a method, a sequence of instructions that is always executed from its start
+     * to its end. The phis of the block are placed before the other instructions, and the last instruction
+     * of the block is its terminator.
+     */
+    class IRBlock {
+    public:
+        /**
+         * The unique identifier of the block in its method.
+         */
+        uint id;
+
+        /**
+         * The instructions of the block.
+         */
+        List<IRInstruction*> instructions;
+
+        /**
+         * The blocks that jump to this block.
+         */
+        List<IRBlock*> predecessors;
+
+        /**
+         * The blocks that this block jumps to.
+         */
+        List<IRBlock*> successors;
+
+        /**
+         * Initialize the block.
+         * @param id block identifier
+         */
+        IRBlock(uint id);
+
+        /**
+         * Get the last instruction of the block, if it ends the block.
+         * @return block terminator, or null if the block is not terminated yet
+         */
+        IRInstruction* getTerminator();
+
+        /**
+         * Get the count of the phis at the start of the block.
+         * @return phi count
+         */
+        uint getPhiCount();
+
+        /**
+         * Get the name of the jump section of the block.
+         * @return block label
+         */
+        UString getLabel();
+    };
+
+    /**
+     * Represents the control flow graph of a method in static single assignment form.
+     */
+    class IRMethod {
+    public:
+        /**
+         * The package that declares the method.
+         */
+        Package* package;
+
+        /**
+         * The source method node.
+         */
+        MethodNode* method;
+
+        /**
+         * The return type descriptor of the method.
+         */
+        char returnType;
+
+        /**
+         * The values of the method parameters in declaration order.
+         */
+        List<IRInstruction*> parameters;
+
+        /**
+         * The blocks of the method, the first block is the entry of the method.
+         */
+        List<IRBlock*> blocks;
+
+        /**
+         * The map of the constants of the method by their type and value. Each constant is created once.
+         */
+        Map<UString, IRInstruction*> constants;
+
+        /**
+         * The count of the created instructions.
+         */
+        uint values = 0;
+
+        /**
+         * The count of the created blocks.
+         */
+        uint labels = 0;
+
+        /**
+         * Initialize the method.
+         * @param package method package
+         * @param method source method node
+         * @param returnType return type descriptor
+         */
+        IRMethod(Package* package, MethodNode* method, char returnType);
+
+        /**
+         * Create a new block at the end of the method.
+         * @return created block
+         */
+        IRBlock* createBlock();
+
+        /**
+         * Create a new instruction, that is not placed in a block yet.
+         * @param opcode instruction operation
+         * @param type produced value type descriptor
+         * @return created instruction
+         */
+        IRInstruction* create(IROpcode opcode, char type);
+
+        /**
+         * Get the constant of the given type and value.
+         * @param type constant type descriptor
+         * @param value constant value
+         * @return constant instruction
+         */
+        IRInstruction* getConstant(char type, UString value);
+
+        /**
+         * Add a control flow edge between two blocks.
+         * @param from source block
+         * @param to target block
+         */
+        void link(IRBlock* from, IRBlock* to);
+
+        /**
+         * Remove a control flow edge between two blocks. The phi operands of the removed edge are removed as well.
+         * @param from source block
+         * @param to target block
+         */
+        void unlink(IRBlock* from, IRBlock* to);
+
+        /**
+         * Replace the uses of a value with an other value.
+         * @param value replaced value
+         * @param replacement new value
+         */
+        void replaceUses(IRInstruction* value, IRInstruction* replacement);
+
+        /**
+         * Remove an instruction from its block.
+         * @param instruction target instruction
+         */
+        void remove(IRInstruction* instruction);
+
+        /**
+         * Remove the blocks that cannot be reached from the entry block.
+         * @return the count of the removed blocks
+         */
+        uint removeUnreachable();
+
+        /**
+         * Get the blocks in reverse postorder. Every block is placed after its dominators, and the successors
+         * are visited in order, so that the first target of a branch follows it when possible.
+         * @return ordered blocks
+         */
+        List<IRBlock*> getReversePostorder();
+
+        /**
+         * Get the immediate dominator of each reachable block. A block dominates an other block, if every path
+         * from the entry block to the other block goes through it. The entry block is its own dominator.
+         * @return the map of the immediate dominators by the blocks
+         */
+        Map<IRBlock*, IRBlock*> getDominators();
+
+        /**
+         * Print the blocks of the method to the output stream.
+         * @param stream target output stream
+         */
+        void debug(OutputStream& stream);
+    };
+}
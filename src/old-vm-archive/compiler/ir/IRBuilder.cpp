@@ -0,0 +1,931 @@
+#include "IRBuilder.hpp"
+
+#include "../builder/MethodBuilder.hpp"
+#include "../optimizer/NodeWalker.hpp"
+#include "../../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the conversion rank of the given type descriptor. Constants can be used as any type with a higher rank.
+     * @param type value type descriptor
+     * @return type rank
+     */
+    static int getRank(char type) {
+        switch (type) {
+            case 'I':
+                return 0;
+            case 'J':
+                return 1;
+            case 'F':
+                return 2;
+            case 'D':
+                return 3;
+        }
+        return 4;
+    }
+
+    /**
+     * Get the type of an operation with the given operand types.
+     * @param left first operand type
+     * @param right second operand type
+     * @return wider operand type
+     */
+    static char promote(char left, char right) {
+        return getRank(left) >= getRank(right) ? left : right;
+    }
+
+    /**
+     * Get the instruction operation of an arithmetic operator.
+     * @param operatorType arithmetic or compound assignment operator
+     * @return instruction operation, or Constant if the operator is not arithmetic
+     */
+    static IROpcode getArithmeticOpcode(OperatorType operatorType) {
+        switch (operatorType) {
+            case OperatorType::Add:
+            case OperatorType::AddAssign:
+                return IROpcode::Add;
+            case OperatorType::Subtract:
+            case OperatorType::SubtractAssign:
+                return IROpcode::Subtract;
+            case OperatorType::Multiply:
+            case OperatorType::MultiplyAssign:
+                return IROpcode::Multiply;
+            case OperatorType::Divide:
+            case OperatorType::DivideAssign:
+                return IROpcode::Divide;
+            case OperatorType::Modulo:
+            case OperatorType::ModuloAssign:
+                return IROpcode::Modulo;
+            default:
+                return IROpcode::Constant;
+        }
+    }
+
+    /**
+     * Determine if the given operator compares two values.
+     * @param operatorType target operator
+     * @return true if the operator is a comparison
+     */
+    static bool isComparison(OperatorType operatorType) {
+        return operatorType >= OperatorType::Equal && operatorType <= OperatorType::GreaterEqual;
+    }
+
+    /**
+     * Initialize the IR builder.
+     * @param package method package
+     * @param method target method
+     */
+    IRBuilder::IRBuilder(Package* package, MethodNode* method)
+        : package(package), method(method)
+    { }
+
+    /**
+     * Build the control flow graph of the method body.
+     * @return built method graph
+     */
+    IRMethod* IRBuilder::build() {
+        result = new IRMethod(package, method, MethodBuilder::getReturnDescriptor(method)[0]);
+        current = result->createBlock();
+        seal(current);
+
+        // the parameters are visible in the whole method body
+        scopes.push_back(Map<UString, UString>());
+        declareParameters();
+        buildBlock(method->body);
+
+        // the end of the method body returns without a value
+        if (current->getTerminator() == nullptr)
+            emit(IROpcode::Return, 'V', {});
+
+        // the statements after the returns and the loops that are never left are not part of the graph
+        result->removeUnreachable();
+        return result;
+    }
+
+    /**
+     * Declare the parameters of the method as the first values of the entry block.
+     */
+    void IRBuilder::declareParameters() {
+        for (Parameter& parameter : method->parameters) {
+            char type = MethodBuilder::getDescriptor(method->Node::package, parameter.type)[0];
+            IRInstruction* value = emit(IROpcode::Parameter, type, {});
+            value->name = parameter.name;
+            result->parameters.push_back(value);
+            writeVariable(declare(parameter.name, type), current, value);
+        }
+    }
+
+    /**
+     * Build the statements of a block in a new scope.
+     * @param body block statements
+     */
+    void IRBuilder::buildBlock(List<Node*>& body) {
+        scopes.push_back(Map<UString, UString>());
+        for (Node* node : body)
+            buildStatement(node);
+        scopes.pop_back();
+    }
+
+    /**
+     * Build a single statement.
+     * @param node target statement
+     */
+    void IRBuilder::buildStatement(Node* node) {
+        // int a
+        if (node->is(NodeType::LocalDeclare)) {
+            LocalDeclare* local = as(node, LocalDeclare);
+            buildLocal(local->type, local->name, nullptr);
+        }
+        // int a, b = 2
+        else if (node->is(NodeType::MultiLocalDeclare)) {
+            MultiLocalDeclare* locals = as(node, MultiLocalDeclare);
+            for (auto& [name, value] : locals->locals)
+                buildLocal(locals->type, name, value.has_value() ? *value : nullptr);
+        }
+        // int a = 2
+        else if (node->is(NodeType::LocalDeclareAssign)) {
+            LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+            buildLocal(local->type, local->name, local->value);
+        }
+        // a = b + 1
+        else if (node->is(NodeType::LocalAssign)) {
+            LocalAssign* assign = as(node, LocalAssign);
+            evaluateAssign(assign->name, OperatorType::Assign, assign->value);
+        }
+        // a++, a += 2
+        else if (node->is(NodeType::Operation) || node->is(NodeType::SideOperation) || node->is(NodeType::Group))
+            evaluate(node, 0);
+        // foo(a, b)
+        else if (node->is(NodeType::MethodCall)) {
+            MethodCall* call = as(node, MethodCall);
+            // the console printing is built in, unless the package declares its own print methods
+            if ((call->name == U"print" || call->name == U"println") && resolveMethod(call) == nullptr)
+                buildPrint(call);
+            else
+                buildCall(call);
+        }
+        else if (node->is(NodeType::Return))
+            buildReturn(as(node, Return));
+        else if (node->is(NodeType::If))
+            buildIf(as(node, If));
+        else if (node->is(NodeType::While))
+            buildWhile(as(node, While));
+        else if (node->is(NodeType::DoWhile))
+            buildDoWhile(as(node, DoWhile));
+        else if (node->is(NodeType::Switch))
+            buildSwitch(as(node, Switch));
+        else
+            error("Unable to generate code for statement: " << node->type);
+    }
+
+    /**
+     * Build a local variable declaration.
+     * @param type variable type
+     * @param name variable name
+     * @param value initial value of the variable, or null
+     */
+    void IRBuilder::buildLocal(Token type, UString name, Node* value) {
+        // let a = 2L
+        char descriptor;
+        if (type.is(TokenType::Type, U"let")) {
+            if (value == nullptr)
+                error("Unable to infer the type of local variable '" << name << "' without a value.");
+            descriptor = typeOf(value);
+        }
+        else
+            descriptor = MethodBuilder::getDescriptor(package, type)[0];
+
+        // the value is evaluated before the variable is declared, so that it still refers to the shadowed variables
+        // a variable without a value is zero, even if a loop declares it multiple times
+        IRInstruction* initial = nullptr;
+        if (value != nullptr)
+            initial = evaluate(value, descriptor);
+        else if (descriptor != 'L')
+            initial = result->getConstant(descriptor, U"0");
+
+        UString variable = declare(name, descriptor);
+        if (initial != nullptr)
+            writeVariable(variable, current, initial);
+    }
+
+    /**
+     * Build an if statement with its else if and else cases.
+     * @param statement target if statement
+     */
+    void IRBuilder::buildIf(If* statement) {
+        IRBlock* end = result->createBlock();
+
+        // collect the conditional cases of the statement
+        // if (a) { } else if (b) { } else { }
+        List<Node*> conditions = { statement->condition };
+        List<List<Node*>*> bodies = { &statement->body };
+        for (ElseIf* elseIf : statement->elseIfs) {
+            conditions.push_back(elseIf->condition);
+            bodies.push_back(&elseIf->body);
+        }
+
+        for (uint i = 0; i < conditions.size(); i++) {
+            // the next case is entered if the condition is false
+            IRBlock* body = result->createBlock();
+            IRBlock* next = result->createBlock();
+            branch(conditions[i], body, next);
+            seal(body);
+            seal(next);
+
+            current = body;
+            buildBlock(*bodies[i]);
+            if (current->getTerminator() == nullptr)
+                jump(end);
+            current = next;
+        }
+
+        if (statement->elseCase != nullptr)
+            buildBlock(statement->elseCase->body);
+        if (current->getTerminator() == nullptr)
+            jump(end);
+
+        seal(end);
+        current = end;
+    }
+
+    /**
+     * Build a while loop.
+     * @param statement target while statement
+     */
+    void IRBuilder::buildWhile(While* statement) {
+        // the header is sealed after the body, as the end of the body jumps back to it
+        IRBlock* header = result->createBlock();
+        IRBlock* body = result->createBlock();
+        IRBlock* exit = result->createBlock();
+        jump(header);
+
+        current = header;
+        branch(statement->condition, body, exit);
+        seal(body);
+        seal(exit);
+
+        current = body;
+        buildBlock(statement->body);
+        if (current->getTerminator() == nullptr)
+            jump(header);
+
+        seal(header);
+        current = exit;
+    }
+
+    /**
+     * Build a do-while loop.
+     * @param statement target do-while statement
+     */
+    void IRBuilder::buildDoWhile(DoWhile* statement) {
+        IRBlock* body = result->createBlock();
+        IRBlock* exit = result->createBlock();
+        jump(body);
+
+        current = body;
+        buildBlock(statement->body);
+        // the condition is not reachable if the body always returns
+        if (current->getTerminator() == nullptr)
+            branch(statement->condition, body, exit);
+
+        seal(body);
+        seal(exit);
+        current = exit;
+    }
+
+    /**
+     * Build a switch statement.
+     * @param statement target switch statement
+     */
+    void IRBuilder::buildSwitch(Switch* statement) {
+        if (typeOf(statement->value) != 'I')
+            error("Switch value must be an integer.");
+        IRInstruction* value = evaluate(statement->value, 'I');
+        IRBlock* end = result->createBlock();
+
+        // the unmatched values continue after the statement, if there is no default case
+        IRBlock* fallback = statement->defaultCase != nullptr ? result->createBlock() : end;
+        List<IRBlock*> bodies;
+        if (statement->cases.empty())
+            jump(fallback);
+        else {
+            // the default target is linked first, so that the successors are in the order of the targets
+            IRInstruction* instruction = emit(IROpcode::Switch, 'V', { value });
+            instruction->targets = { fallback };
+            result->link(current, fallback);
+            for (SwitchCase* switchCase : statement->cases) {
+                IRBlock* body = result->createBlock();
+                List<int> keys;
+                for (Token& key : switchCase->keys)
+                    keys.push_back(stringToInt(Strings::fromUTF(key.value)));
+                instruction->targets.push_back(body);
+                instruction->keys.push_back(keys);
+                result->link(current, body);
+                bodies.push_back(body);
+            }
+        }
+
+        for (uint i = 0; i < bodies.size(); i++) {
+            seal(bodies[i]);
+            current = bodies[i];
+            buildBlock(statement->cases[i]->body);
+            if (current->getTerminator() == nullptr)
+                jump(end);
+        }
+
+        if (statement->defaultCase != nullptr) {
+            seal(fallback);
+            current = fallback;
+            buildBlock(statement->defaultCase->body);
+            if (current->getTerminator() == nullptr)
+                jump(end);
+        }
+
+        seal(end);
+        current = end;
+    }
+
+    /**
+     * Build a method return. The statements after the return are built to an unreachable block.
+     * @param statement target return statement
+     */
+    void IRBuilder::buildReturn(Return* statement) {
+        char type = result->returnType;
+
+        // return
+        if (!statement->value.has_value()) {
+            if (type != 'V')
+                error("Method '" << method->name << "' must return a value.");
+            emit(IROpcode::Return, 'V', {});
+        }
+        // return a
+        else {
+            if (type == 'V')
+                error("Void method '" << method->name << "' cannot return a value.");
+            emit(IROpcode::Return, 'V', { evaluate(*statement->value, type) });
+        }
+
+        current = result->createBlock();
+        seal(current);
+    }
+
+    /**
+     * Build a console print of the given arguments.
+     * @param call target print call
+     */
+    void IRBuilder::buildPrint(MethodCall* call) {
+        if (call->arguments.size() > 1)
+            error("Method '" << call->name << "' expects at most one argument.");
+
+        // println ""
+        if (call->arguments.empty()) {
+            emit(IROpcode::Print, 'V', {})->name = call->name;
+            return;
+        }
+
+        // println "Hello, World"
+        Node* node = call->arguments[0];
+        if (node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::String)) {
+            IRInstruction* print = emit(IROpcode::Print, 'V', {});
+            print->name = call->name;
+            print->value = as(node, Value)->value.value;
+            return;
+        }
+
+        // println $"x = {x}"
+        if (node->is(NodeType::Template)) {
+            List<UString> names;
+            List<IRInstruction*> values;
+            UString pattern = MethodBuilder::parseTemplate(as(node, Template)->value.value, names);
+            for (UString& name : names)
+                values.push_back(readVariable(lookup(name), current));
+            IRInstruction* print = emit(IROpcode::Print, 'V', values);
+            print->name = call->name;
+            // a template without placeholders is printed as a literal
+            print->value = names.empty() ? as(node, Template)->value.value : pattern;
+            return;
+        }
+
+        // println a
+        char type = typeOf(node);
+        if (type == 'V')
+            error("Unable to print a void value.");
+        emit(IROpcode::Print, 'V', { evaluate(node, type) })->name = call->name;
+    }
+
+    /**
+     * Build a method call.
+     * @param call target method call
+     * @return the call instruction
+     */
+    IRInstruction* IRBuilder::buildCall(MethodCall* call) {
+        MethodNode* callee = resolveMethod(call);
+        if (callee == nullptr)
+            error("Unable to resolve method " << call->name << " with " << call->arguments.size()
+                << " arguments in package '" << package->name << "'.");
+
+        // the arguments are evaluated in order, each converted to the type of its parameter
+        List<IRInstruction*> arguments;
+        UString descriptors;
+        for (uint i = 0; i < call->arguments.size(); i++) {
+            UString descriptor = MethodBuilder::getDescriptor(callee->Node::package, callee->parameters[i].type);
+            arguments.push_back(evaluate(call->arguments[i], descriptor[0]));
+            descriptors += U" " + descriptor;
+        }
+
+        IRInstruction* instruction = emit(IROpcode::Call, MethodBuilder::getReturnDescriptor(callee)[0], arguments);
+        instruction->name = U"<package>" + callee->Node::package->name + U" " + callee->name + descriptors;
+        return instruction;
+    }
+
+    /**
+     * Evaluate an expression.
+     * @param node target expression
+     * @param type required type descriptor, or 0 if it should be inferred
+     * @return the value of the expression
+     */
+    IRInstruction* IRBuilder::evaluate(Node* node, char type) {
+        // infer the type of the expression if it is not required by the context
+        if (type == 0)
+            type = typeOf(node);
+
+        if (node->is(NodeType::Value))
+            return evaluateValue(as(node, Value), type);
+        else if (node->is(NodeType::Group))
+            return evaluate(as(node, Group)->value, type);
+        else if (node->is(NodeType::Operation))
+            return evaluateOperation(as(node, Operation), type);
+        else if (node->is(NodeType::SideOperation))
+            return evaluateSideOperation(as(node, SideOperation), type);
+
+        // a = b = 2
+        else if (node->is(NodeType::LocalAssign)) {
+            LocalAssign* assign = as(node, LocalAssign);
+            return convert(evaluateAssign(assign->name, OperatorType::Assign, assign->value), type);
+        }
+
+        // foo(a, b) + 1
+        else if (node->is(NodeType::MethodCall)) {
+            MethodCall* call = as(node, MethodCall);
+            IRInstruction* value = buildCall(call);
+            if (value->type == 'V')
+                error("Method " << call->name << " does not return a value.");
+            if (value->type != type)
+                error("Implicit conversion of the result of method " << call->name << " is not supported.");
+            return value;
+        }
+
+        error("Unable to generate code for expression: " << node->type);
+        return nullptr;
+    }
+
+    /**
+     * Evaluate a single value.
+     * @param node target value
+     * @param type required type descriptor
+     * @return the value of the variable or the constant
+     */
+    IRInstruction* IRBuilder::evaluateValue(Value* node, char type) {
+        Token token = node->value;
+
+        // read the current value of the variable
+        if (token.is(TokenType::Identifier))
+            return convert(readVariable(lookup(token.value), current), type);
+
+        UString value = token.value;
+        if (token.is(TokenType::Boolean))
+            value = value == U"true" ? U"1" : U"0";
+        else if (token.is(TokenType::Character))
+            value = Strings::toUTF(toString((int) value[0]));
+        else if (token.is(TokenType::Hexadecimal))
+            value = Strings::toUTF(toString(std::stoll(Strings::fromUTF(value.substr(2)), nullptr, 16)));
+        else if (!token.is(TokenType::Integer) && !token.is(TokenType::Long) && !token.is(TokenType::Float)
+                && !token.is(TokenType::Double) && !token.is(TokenType::Byte) && !token.is(TokenType::Short))
+            error("Unable to generate code for value: " << token);
+
+        return convert(result->getConstant(typeOf(node), value), type);
+    }
+
+    /**
+     * Evaluate an operation of two expressions.
+     * @param node target operation
+     * @param type required type descriptor
+     * @return the result of the operation
+     */
+    IRInstruction* IRBuilder::evaluateOperation(Operation* node, char type) {
+        OperatorType operatorType = node->operatorType;
+
+        // a += b
+        if (isAssignment(operatorType))
+            return convert(evaluateAssign(NodeWalker::requireLocalName(node->left), operatorType, node->right), type);
+
+        // a < b && c
+        if (isComparison(operatorType) || operatorType == OperatorType::And || operatorType == OperatorType::Or)
+            return convert(evaluateCondition(node), type);
+
+        // a + b * c
+        IROpcode opcode = getArithmeticOpcode(operatorType);
+        if (opcode == IROpcode::Constant)
+            error("Operator '" << node->target << "' is not supported by the virtual machine.");
+        IRInstruction* left = evaluate(node->left, type);
+        IRInstruction* right = evaluate(node->right, type);
+        return emit(opcode, type, { left, right });
+    }
+
+    /**
+     * Evaluate a single-operand operation.
+     * @param node target operation
+     * @param type required type descriptor
+     * @return the result of the operation
+     */
+    IRInstruction* IRBuilder::evaluateSideOperation(SideOperation* node, char type) {
+        switch (node->operatorType) {
+            // !a
+            case OperatorType::Not:
+                return convert(evaluateCondition(node), type);
+
+            // -a
+            case OperatorType::Subtract: {
+                IRInstruction* value = evaluate(node->operand, type);
+                // negate the constants in place
+                if (value->opcode == IROpcode::Constant) {
+                    UString negated = value->value[0] == '-' ? value->value.substr(1) : U"-" + value->value;
+                    return result->getConstant(value->type, negated);
+                }
+                return emit(IROpcode::Negate, type, { value });
+            }
+
+            // ++a, a++
+            case OperatorType::Increment:
+            case OperatorType::Decrement: {
+                if (node->left)
+                    return convert(step(node), type);
+                // keep the previous value of the variable
+                IRInstruction* previous = convert(readVariable(lookup(NodeWalker::requireLocalName(node->operand)), current), type);
+                step(node);
+                return previous;
+            }
+
+            default:
+                error("Operator '" << node->target << "' is not supported by the virtual machine.");
+        }
+        return nullptr;
+    }
+
+    /**
+     * Evaluate a condition to an integer value that is 1 if the condition is true, 0 otherwise.
+     * @param node target condition
+     * @return the phi of the condition result
+     */
+    IRInstruction* IRBuilder::evaluateCondition(Node* node) {
+        IRBlock* trueBlock = result->createBlock();
+        IRBlock* falseBlock = result->createBlock();
+        IRBlock* end = result->createBlock();
+        branch(node, trueBlock, falseBlock);
+        seal(trueBlock);
+        seal(falseBlock);
+
+        current = trueBlock;
+        jump(end);
+        current = falseBlock;
+        jump(end);
+        seal(end);
+        current = end;
+
+        // the true block is the first predecessor of the end block
+        IRInstruction* phi = createPhi(end, 'I');
+        phi->operands = { result->getConstant('I', U"1"), result->getConstant('I', U"0") };
+        return phi;
+    }
+
+    /**
+     * Evaluate an assignment to a local variable.
+     * @param name variable name
+     * @param operatorType assignment operator
+     * @param value assigned value
+     * @return the new value of the variable
+     */
+    IRInstruction* IRBuilder::evaluateAssign(UString name, OperatorType operatorType, Node* value) {
+        UString variable = lookup(name);
+        char type = types[variable];
+
+        // a = b * 2
+        if (operatorType == OperatorType::Assign) {
+            IRInstruction* assigned = evaluate(value, type);
+            writeVariable(variable, current, assigned);
+            return assigned;
+        }
+
+        // a += 2
+        // the variable is read after the value, as the value might change the variable as well
+        IROpcode opcode = getArithmeticOpcode(operatorType);
+        if (opcode == IROpcode::Constant)
+            error("Operator '" << UString(getOperatorInfo(operatorType).symbol) << "' is not supported by the virtual machine.");
+        IRInstruction* right = evaluate(value, type);
+        IRInstruction* assigned = emit(opcode, type, { readVariable(variable, current), right });
+        writeVariable(variable, current, assigned);
+        return assigned;
+    }
+
+    /**
+     * Increment or decrement a local variable.
+     * @param node target increment operation
+     * @return the new value of the variable
+     */
+    IRInstruction* IRBuilder::step(SideOperation* node) {
+        UString variable = lookup(NodeWalker::requireLocalName(node->operand));
+        char type = types[variable];
+        IROpcode opcode = node->operatorType == OperatorType::Increment ? IROpcode::Add : IROpcode::Subtract;
+        IRInstruction* value = emit(opcode, type, { readVariable(variable, current), result->getConstant(type, U"1") });
+        writeVariable(variable, current, value);
+        return value;
+    }
+
+    /**
+     * Convert a value to the required type. Constants can be used as any type that is at least as wide.
+     * @param value target value
+     * @param type required type descriptor
+     * @return the value of the required type
+     */
+    IRInstruction* IRBuilder::convert(IRInstruction* value, char type) {
+        if (value->type == type)
+            return value;
+        // the virtual machine does not have conversion instructions yet
+        if (value->opcode != IROpcode::Constant || getRank(value->type) > getRank(type))
+            error("Implicit conversion from " << (char) value->type << " to " << (char) type << " is not supported.");
+        return result->getConstant(type, value->value);
+    }
+
+    /**
+     * Build the branches of a condition, that jump to the first block if the condition is true,
+     * and to the second block otherwise. The current block is terminated by the condition.
+     * @param node target condition
+     * @param trueBlock jump target of the true condition
+     * @param falseBlock jump target of the false condition
+     */
+    void IRBuilder::branch(Node* node, IRBlock* trueBlock, IRBlock* falseBlock) {
+        // (a)
+        if (node->is(NodeType::Group)) {
+            branch(as(node, Group)->value, trueBlock, falseBlock);
+            return;
+        }
+
+        // true
+        if (node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::Boolean)) {
+            jump(as(node, Value)->value.value == U"true" ? trueBlock : falseBlock);
+            return;
+        }
+
+        // !a
+        if (node->is(NodeType::SideOperation) && as(node, SideOperation)->operatorType == OperatorType::Not) {
+            branch(as(node, SideOperation)->operand, falseBlock, trueBlock);
+            return;
+        }
+
+        if (node->is(NodeType::Operation)) {
+            Operation* operation = as(node, Operation);
+            OperatorType operatorType = operation->operatorType;
+
+            // a && b
+            // the second operand is not evaluated if the first operand is false
+            if (operatorType == OperatorType::And || operatorType == OperatorType::Or) {
+                IRBlock* second = result->createBlock();
+                if (operatorType == OperatorType::And)
+                    branch(operation->left, second, falseBlock);
+                // a || b
+                // the second operand is not evaluated if the first operand is true
+                else
+                    branch(operation->left, trueBlock, second);
+                seal(second);
+                current = second;
+                branch(operation->right, trueBlock, falseBlock);
+                return;
+            }
+
+            // a < b
+            if (isComparison(operatorType)) {
+                char type = promote(typeOf(operation->left), typeOf(operation->right));
+                IRInstruction* left = evaluate(operation->left, type);
+                IRInstruction* right = evaluate(operation->right, type);
+                IRInstruction* instruction = emit(IROpcode::Branch, 'V', { left, right });
+                instruction->comparison = operatorType;
+                instruction->targets = { trueBlock, falseBlock };
+                result->link(current, trueBlock);
+                result->link(current, falseBlock);
+                return;
+            }
+        }
+
+        // any other value is true if it is not zero
+        IRInstruction* value = evaluate(node, 'I');
+        IRInstruction* instruction = emit(IROpcode::Branch, 'V', { value, result->getConstant('I', U"0") });
+        instruction->comparison = OperatorType::NotEqual;
+        instruction->targets = { trueBlock, falseBlock };
+        result->link(current, trueBlock);
+        result->link(current, falseBlock);
+    }
+
+    /**
+     * Terminate the current block with a jump to the given block.
+     * @param target jump target
+     */
+    void IRBuilder::jump(IRBlock* target) {
+        emit(IROpcode::Jump, 'V', {})->targets = { target };
+        result->link(current, target);
+    }
+
+    /**
+     * Append a new instruction to the current block.
+     * @param opcode instruction operation
+     * @param type produced value type descriptor
+     * @param operands instruction operands
+     * @return appended instruction
+     */
+    IRInstruction* IRBuilder::emit(IROpcode opcode, char type, List<IRInstruction*> operands) {
+        IRInstruction* instruction = result->create(opcode, type);
+        instruction->operands = operands;
+        instruction->block = current;
+        current->instructions.push_back(instruction);
+        return instruction;
+    }
+
+    /**
+     * Infer the type descriptor of an expression.
+     * @param node target expression
+     * @return inferred type descriptor
+     */
+    char IRBuilder::typeOf(Node* node) {
+        if (node->is(NodeType::Value)) {
+            Token token = as(node, Value)->value;
+            if (token.is(TokenType::Identifier))
+                return types[lookup(token.value)];
+            else if (token.is(TokenType::Long))
+                return 'J';
+            else if (token.is(TokenType::Float))
+                return 'F';
+            else if (token.is(TokenType::Double))
+                return 'D';
+            else if (token.is(TokenType::String))
+                return 'L';
+            return 'I';
+        }
+        else if (node->is(NodeType::Group))
+            return typeOf(as(node, Group)->value);
+        else if (node->is(NodeType::Operation)) {
+            Operation* operation = as(node, Operation);
+            if (isAssignment(operation->operatorType))
+                return types[lookup(NodeWalker::requireLocalName(operation->left))];
+            if (getArithmeticOpcode(operation->operatorType) != IROpcode::Constant)
+                return promote(typeOf(operation->left), typeOf(operation->right));
+            // the conditions are integers of 0 or 1
+            return 'I';
+        }
+        else if (node->is(NodeType::SideOperation)) {
+            SideOperation* operation = as(node, SideOperation);
+            return operation->operatorType == OperatorType::Not ? 'I' : typeOf(operation->operand);
+        }
+        else if (node->is(NodeType::LocalAssign))
+            return types[lookup(as(node, LocalAssign)->name)];
+        else if (node->is(NodeType::MethodCall)) {
+            MethodNode* callee = resolveMethod(as(node, MethodCall));
+            return callee != nullptr ? MethodBuilder::getReturnDescriptor(callee)[0] : 'V';
+        }
+        return 'V';
+    }
+
+    /**
+     * Find the method that is called by the method call.
+     * @param call target method call
+     * @return called method, or null if the method is not found
+     */
+    MethodNode* IRBuilder::resolveMethod(MethodCall* call) {
+        UString arguments;
+        for (Node* argument : call->arguments)
+            arguments += typeOf(argument);
+        return package->resolveCall(call->name, arguments);
+    }
+
+    /**
+     * Declare a local variable in the innermost scope.
+     * @param name variable name
+     * @param type variable type descriptor
+     * @return unique variable key
+     */
+    UString IRBuilder::declare(UString name, char type) {
+        Map<UString, UString>& scope = scopes.back();
+        if (scope.find(name) != scope.end())
+            error("Local variable '" << name << "' is already declared in this scope.");
+
+        uint count = declarations[name]++;
+        UString variable = count == 0 ? name : name + U"." + Strings::toUTF(toString(count));
+        types[variable] = type;
+        scope[name] = variable;
+        return variable;
+    }
+
+    /**
+     * Find the key of a local variable in the visible scopes.
+     * @param name variable name
+     * @return unique variable key
+     */
+    UString IRBuilder::lookup(UString name) {
+        for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++) {
+            auto variable = scope->find(name);
+            if (variable != scope->end())
+                return variable->second;
+        }
+        error("Unknown local variable '" << name << "'.");
+        return U"";
+    }
+
+    /**
+     * Set the value of a variable at the end of a block.
+     * @param variable variable key
+     * @param block target block
+     * @param value new variable value
+     */
+    void IRBuilder::writeVariable(UString variable, IRBlock* block, IRInstruction* value) {
+        definitions[block][variable] = value;
+    }
+
+    /**
+     * Get the value of a variable at the end of a block.
+     * @param variable variable key
+     * @param block target block
+     * @return current variable value
+     */
+    IRInstruction* IRBuilder::readVariable(UString variable, IRBlock* block) {
+        Map<UString, IRInstruction*>& values = definitions[block];
+        auto value = values.find(variable);
+        if (value != values.end())
+            return value->second;
+        return readVariableRecursive(variable, block);
+    }
+
+    /**
+     * Get the value of a variable that is not assigned in the block, from the predecessors of the block.
+     * @param variable variable key
+     * @param block target block
+     * @return variable value at the start of the block
+     */
+    IRInstruction* IRBuilder::readVariableRecursive(UString variable, IRBlock* block) {
+        IRInstruction* value;
+        // the predecessors are not known yet, the operands are added when the block is sealed
+        if (!(contains(sealed, block))) {
+            value = createPhi(block, types[variable]);
+            incompletePhis[block][variable] = value;
+        }
+        // the value of a single predecessor does not need a phi
+        else if (block->predecessors.size() == 1)
+            value = readVariable(variable, block->predecessors[0]);
+        // the entry block and the unreachable blocks do not have a previous value
+        else if (block->predecessors.empty())
+            value = result->getConstant(types[variable], U"0");
+        // the phi is defined before its operands are read, so that a loop can refer back to it
+        else {
+            value = createPhi(block, types[variable]);
+            writeVariable(variable, block, value);
+            addPhiOperands(variable, value);
+        }
+        writeVariable(variable, block, value);
+        return value;
+    }
+
+    /**
+     * Create a phi at the start of a block, without operands.
+     * @param block target block
+     * @param type value type descriptor
+     * @return created phi
+     */
+    IRInstruction* IRBuilder::createPhi(IRBlock* block, char type) {
+        IRInstruction* phi = result->create(IROpcode::Phi, type);
+        phi->block = block;
+        block->instructions.insert(block->instructions.begin() + block->getPhiCount(), phi);
+        return phi;
+    }
+
+    /**
+     * Add the values of a variable at the end of the predecessors of the block of a phi as the phi operands.
+     * @param variable variable key
+     * @param phi target phi
+     */
+    void IRBuilder::addPhiOperands(UString variable, IRInstruction* phi) {
+        for (IRBlock* predecessor : phi->block->predecessors)
+            phi->operands.push_back(readVariable(variable, predecessor));
+    }
+
+    /**
+     * Mark a block as sealed, once all its predecessors are known, and complete its incomplete phis.
+     * @param block target block
+     */
+    void IRBuilder::seal(IRBlock* block) {
+        // reading the operands might create phis in other unsealed blocks
+        TreeMap<UString, IRInstruction*> phis = incompletePhis[block];
+        for (auto& [variable, phi] : phis)
+            addPhiOperands(variable, phi);
+        incompletePhis.erase(block);
+        sealed.push_back(block);
+    }
+}
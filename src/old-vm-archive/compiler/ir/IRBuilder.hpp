@@ -0,0 +1,320 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+#include "../builder/Package.hpp"
+#include "IR.hpp"
+
+namespace Compiler {
+    /**
+     * Represents a converter, that builds the control flow graph of a method body in static single assignment form.
+     * The local variables are not stored in the graph, each assignment creates a new value instead, and the reads
+     * of a variable are resolved to the value of the last assignment. The phis are placed on demand, where the
+     * definitions of multiple predecessors meet. A block is sealed once all its predecessors are known,
+     * the reads of an unsealed block are completed by incomplete phis when the block is sealed.
+     * The builder accepts the same statements and has the same typing rules as the MethodBuilder.
+     */
+    class IRBuilder {
+    private:
+        /**
+         * The package that declares the built method.
+         */
+        Package* package;
+
+        /**
+         * The built method node.
+         */
+        MethodNode* method;
+
+        /**
+         * The control flow graph of the method.
+         */
+        IRMethod* result = nullptr;
+
+        /**
+         * The block that the next instructions are appended to.
+         */
+        IRBlock* current = nullptr;
+
+        /**
+         * The stack of the local variable scopes. Each scope maps the variable names to unique variable keys,
+         * the variables of the sibling scopes with the same name are keyed as a.1, a.2 and so on.
+         */
+        List<Map<UString, UString>> scopes;
+
+        /**
+         * The map of the type descriptors of the variable keys.
+         */
+        Map<UString, char> types;
+
+        /**
+         * The map of the declaration counts of the local variable names.
+         */
+        Map<UString, uint> declarations;
+
+        /**
+         * The current value of each variable at the end of each block.
+         */
+        Map<IRBlock*, Map<UString, IRInstruction*>> definitions;
+
+        /**
+         * The phis of the unsealed blocks, whose operands are added when the block is sealed.
+         */
+        Map<IRBlock*, TreeMap<UString, IRInstruction*>> incompletePhis;
+
+        /**
+         * The blocks whose predecessors are all known.
+         */
+        List<IRBlock*> sealed;
+
+    public:
+        /**
+         * Initialize the IR builder.
+         * @param package method package
+         * @param method target method
+         */
+        IRBuilder(Package* package, MethodNode* method);
+
+        /**
+         * Build the control flow graph of the method body.
+         * @return built method graph
+         */
+        IRMethod* build();
+
+    private:
+        /**
+         * Declare the parameters of the method as the first values of the entry block.
+         */
+        void declareParameters();
+
+        /**
+         * Build the statements of a block in a new scope.
+         * @param body block statements
+         */
+        void buildBlock(List<Node*>& body);
+
+        /**
+         * Build a single statement.
+         * @param node target statement
+         */
+        void buildStatement(Node* node);
+
+        /**
+         * Build a local variable declaration.
+         * @param type variable type
+         * @param name variable name
+         * @param value initial value of the variable, or null
+         */
+        void buildLocal(Token type, UString name, Node* value);
+
+        /**
+         * Build an if statement with its else if and else cases.
+         * @param statement target if statement
+         */
+        void buildIf(If* statement);
+
+        /**
+         * Build a while loop.
+         * @param statement target while statement
+         */
+        void buildWhile(While* statement);
+
+        /**
+         * Build a do-while loop.
+         * @param statement target do-while statement
+         */
+        void buildDoWhile(DoWhile* statement);
+
+        /**
+         * Build a switch statement.
+         * @param statement target switch statement
+         */
+        void buildSwitch(Switch* statement);
+
+        /**
+         * Build a method return. The statements after the return are built to an unreachable block.
+         * @param statement target return statement
+         */
+        void buildReturn(Return* statement);
+
+        /**
+         * Build a console print of the given arguments.
+         * @param call target print call
+         */
+        void buildPrint(MethodCall* call);
+
+        /**
+         * Build a method call.
+         * @param call target method call
+         * @return the call instruction
+         */
+        IRInstruction* buildCall(MethodCall* call);
+
+        /**
+         * Evaluate an expression.
+         * @param node target expression
+         * @param type required type descriptor, or 0 if it should be inferred
+         * @return the value of the expression
+         */
+        IRInstruction* evaluate(Node* node, char type);
+
+        /**
+         * Evaluate a single value.
+         * @param node target value
+         * @param type required type descriptor
+         * @return the value of the variable or the constant
+         */
+        IRInstruction* evaluateValue(Value* node, char type);
+
+        /**
+         * Evaluate an operation of two expressions.
+         * @param node target operation
+         * @param type required type descriptor
+         * @return the result of the operation
+         */
+        IRInstruction* evaluateOperation(Operation* node, char type);
+
+        /**
+         * Evaluate a single-operand operation.
+         * @param node target operation
+         * @param type required type descriptor
+         * @return the result of the operation
+         */
+        IRInstruction* evaluateSideOperation(SideOperation* node, char type);
+
+        /**
+         * Evaluate a condition to an integer value that is 1 if the condition is true, 0 otherwise.
+         * @param node target condition
+         * @return the phi of the condition result
+         */
+        IRInstruction* evaluateCondition(Node* node);
+
+        /**
+         * Evaluate an assignment to a local variable.
+         * @param name variable name
+         * @param operatorType assignment operator
+         * @param value assigned value
+         * @return the new value of the variable
+         */
+        IRInstruction* evaluateAssign(UString name, OperatorType operatorType, Node* value);
+
+        /**
+         * Increment or decrement a local variable.
+         * @param node target increment operation
+         * @return the new value of the variable
+         */
+        IRInstruction* step(SideOperation* node);
+
+        /**
+         * Convert a value to the required type. Constants can be used as any type that is at least as wide.
+         * @param value target value
+         * @param type required type descriptor
+         * @return the value of the required type
+         */
+        IRInstruction* convert(IRInstruction* value, char type);
+
+        /**
+         * Build the branches of a condition, that jump to the first block if the condition is true,
+         * and to the second block otherwise. The current block is terminated by the condition.
+         * @param node target condition
+         * @param trueBlock jump target of the true condition
+         * @param falseBlock jump target of the false condition
+         */
+        void branch(Node* node, IRBlock* trueBlock, IRBlock* falseBlock);
+
+        /**
+         * Terminate the current block with a jump to the given block.
+         * @param target jump target
+         */
+        void jump(IRBlock* target);
+
+        /**
+         * Append a new instruction to the current block.
+         * @param opcode instruction operation
+         * @param type produced value type descriptor
+         * @param operands instruction operands
+         * @return appended instruction
+         */
+        IRInstruction* emit(IROpcode opcode, char type, List<IRInstruction*> operands);
+
+        /**
+         * Infer the type descriptor of an expression.
+         * @param node target expression
+         * @return inferred type descriptor
+         */
+        char typeOf(Node* node);
+
+        /**
+         * Find the method that is called by the method call.
+         * @param call target method call
+         * @return called method, or null if the method is not found
+         */
+        MethodNode* resolveMethod(MethodCall* call);
+
+        /**
+         * Declare a local variable in the innermost scope.
+         * @param name variable name
+         * @param type variable type descriptor
+         * @return unique variable key
+         */
+        UString declare(UString name, char type);
+
+        /**
+         * Find the key of a local variable in the visible scopes.
+         * @param name variable name
+         * @return unique variable key
+         */
+        UString lookup(UString name);
+
+        /**
+         * Set the value of a variable at the end of a block.
+         * @param variable variable key
+         * @param block target block
+         * @param value new variable value
+         */
+        void writeVariable(UString variable, IRBlock* block, IRInstruction* value);
+
+        /**
+         * Get the value of a variable at the end of a block.
+         * @param variable variable key
+         * @param block target block
+         * @return current variable value
+         */
+        IRInstruction* readVariable(UString variable, IRBlock* block);
+
+        /**
+         * Get the value of a variable that is not assigned in the block, from the predecessors of the block.
+         * @param variable variable key
+         * @param block target block
+         * @return variable value at the start of the block
+         */
+        IRInstruction* readVariableRecursive(UString variable, IRBlock* block);
+
+        /**
+         * Create a phi at the start of a block, without operands.
+         * @param block target block
+         * @param type value type descriptor
+         * @return created phi
+         */
+        IRInstruction* createPhi(IRBlock* block, char type);
+
+        /**
+         * Add the values of a variable at the end of the predecessors of the block of a phi as the phi operands.
+         * @param variable variable key
+         * @param phi target phi
+         */
+        void addPhiOperands(UString variable, IRInstruction* phi);
+
+        /**
+         * Mark a block as sealed, once all its predecessors are known, and complete its incomplete phis.
+         * @param block target block
+         */
+        void seal(IRBlock* block);
+    };
+}
@@ -0,0 +1,108 @@
+#include "PassManager.hpp"
+
+#include "IRBuilder.hpp"
+#include "CopyPropagator.hpp"
+#include "ValueNumbering.hpp"
+#include "ValueEliminator.hpp"
+#include "BlockMerger.hpp"
+#include "BytecodeLowering.hpp"
+
+namespace Compiler {
+    /**
+     * Format a duration for the timing report.
+     * @param nanoseconds duration in nanoseconds
+     * @return duration in microseconds
+     */
+    static String formatTime(lint nanoseconds) {
+        return toString(nanoseconds / 1000) + "us";
+    }
+
+    /**
+     * Initialize the pass.
+     * @param name pass name
+     */
+    IRPass::IRPass(String name)
+        : name(name)
+    { }
+
+    /**
+     * Initialize the pass manager with the default optimization passes.
+     * @param dumps the names of the dumped stages
+     */
+    PassManager::PassManager(List<String> dumps)
+        : dumps(dumps)
+    {
+        // the phis that only forward a single value are removed first, so that the numbering sees the copied values,
+        // the elimination sees the real uses of the values, and the merging sees the emptied blocks
+        passes.push_back(new CopyPropagator());
+        passes.push_back(new ValueNumbering());
+        passes.push_back(new ValueEliminator());
+        passes.push_back(new BlockMerger());
+    }
+
+    /**
+     * Compile the body of a method through the intermediate representation.
+     * @param package method package
+     * @param method target method
+     * @param bytecode result bytecode list
+     */
+    void PassManager::compile(Package* package, MethodNode* method, List<UString>& bytecode) {
+        methods++;
+
+        auto begin = nanoTime();
+        IRBuilder builder(package, method);
+        IRMethod* graph = builder.build();
+        buildTime += nanoTime() - begin;
+        dump("ssa", graph);
+
+        for (IRPass* pass : passes) {
+            begin = nanoTime();
+            pass->changes += pass->run(graph);
+            pass->time += nanoTime() - begin;
+            dump(pass->name, graph);
+        }
+
+        begin = nanoTime();
+        BytecodeLowering lowering(graph);
+        lowering.lower(bytecode);
+        lowerTime += nanoTime() - begin;
+    }
+
+    /**
+     * Add the statistics of an other pass manager with the same passes to this manager.
+     * @param other merged pass manager
+     */
+    void PassManager::merge(PassManager* other) {
+        methods += other->methods;
+        buildTime += other->buildTime;
+        lowerTime += other->lowerTime;
+        for (uint i = 0; i < passes.size(); i++) {
+            passes[i]->changes += other->passes[i]->changes;
+            passes[i]->time += other->passes[i]->time;
+        }
+    }
+
+    /**
+     * Get the timing report of the stages.
+     * @return stage times and change counts
+     */
+    String PassManager::report() {
+        // ssa 120us, copy 3 in 10us, gvn 2 in 8us, values 1 in 4us, cfg 2 in 6us, lower 90us
+        String result = "ssa " + formatTime(buildTime);
+        for (IRPass* pass : passes)
+            result += ", " + pass->name + " " + toString(pass->changes) + " in " + formatTime(pass->time);
+        return result + ", lower " + formatTime(lowerTime);
+    }
+
+    /**
+     * Print the graph of the method, if the dump of the given stage is requested.
+     * @param stage stage name
+     * @param method target method
+     */
+    void PassManager::dump(String stage, IRMethod* method) {
+        if (!(contains(dumps, stage)))
+            return;
+        output << "[" << stage << "] " << method->method->name << "\n";
+        method->debug(output);
+    }
+}
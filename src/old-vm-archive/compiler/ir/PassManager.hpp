@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../builder/Package.hpp"
+
+#include "IR.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass that transforms the control flow graph of a method.
+     */
+    class IRPass {
+    public:
+        /**
+         * The name of the pass, used for selecting the dumped passes and in the timing report.
+         */
+        String name;
+
+        /**
+         * The count of the changes made by the pass in all the methods.
+         */
+        uint changes = 0;
+
+        /**
+         * The time spent in the pass in nanoseconds.
+         */
+        lint time = 0;
+
+        /**
+         * Initialize the pass.
+         * @param name pass name
+         */
+        IRPass(String name);
+
+        /**
+         * Transform the graph of a method.
+         * @param method target method
+         * @return the count of the changes made in the method
+         */
+        virtual uint run(IRMethod* method) = 0;
+    };
+
+    /**
+     * Represents the pipeline of the code generation through the intermediate representation. The method nodes are
+     * converted to static single assignment form, the registered passes are run in order on the graph,
+     * then the graph is lowered to bytecode. Each stage is timed separately, so that the cost of the passes
+     * can be compared. A pass manager is used by a single thread, the managers of the worker threads are
+     * merged for the report.
+     */
+    class PassManager {
+    public:
+        /**
+         * The optimization passes in the order they are run.
+         */
+        List<IRPass*> passes;
+
+        /**
+         * The names of the stages whose resulting graphs are printed.
+         */
+        List<String> dumps;
+
+        /**
+         * The printed graphs of the dumped stages, collected until the compilation threads are finished.
+         */
+        StringStream output;
+
+        /**
+         * The count of the compiled methods.
+         */
+        uint methods = 0;
+
+        /**
+         * The time spent on building the graphs in nanoseconds.
+         */
+        lint buildTime = 0;
+
+        /**
+         * The time spent on lowering the graphs to bytecode in nanoseconds.
+         */
+        lint lowerTime = 0;
+
+        /**
+         * Initialize the pass manager with the default optimization passes.
+         * @param dumps the names of the dumped stages
+         */
+        PassManager(List<String> dumps);
+
+        /**
+         * Compile the body of a method through the intermediate representation.
+         * @param package method package
+         * @param method target method
+         * @param bytecode result bytecode list
+         */
+        void compile(Package* package, MethodNode* method, List<UString>& bytecode);
+
+        /**
+         * Add the statistics of an other pass manager with the same passes to this manager.
+         * @param other merged pass manager
+         */
+        void merge(PassManager* other);
+
+        /**
+         * Get the timing report of the stages.
+         * @return stage times and change counts
+         */
+        String report();
+
+    private:
+        /**
+         * Print the graph of the method, if the dump of the given stage is requested.
+         * @param stage stage name
+         * @param method target method
+         */
+        void dump(String stage, IRMethod* method);
+    };
+}
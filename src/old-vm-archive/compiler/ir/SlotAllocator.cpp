@@ -0,0 +1,195 @@
+#include "SlotAllocator.hpp"
+
+#include <algorithm>
+
+namespace Compiler {
+    /**
+     * Initialize the slot allocator.
+     * @param method allocated method graph
+     * @param uses the use counts of the values
+     */
+    SlotAllocator::SlotAllocator(IRMethod* method, Map<IRInstruction*, uint>& uses)
+        : method(method), uses(uses)
+    { }
+
+    /**
+     * Assign a storage slot to each value of the method that needs one.
+     */
+    void SlotAllocator::allocate() {
+        values = List<IRInstruction*>(method->values, nullptr);
+        for (IRBlock* block : method->blocks) {
+            for (IRInstruction* instruction : block->instructions) {
+                if (hasSlot(instruction))
+                    values[instruction->id] = instruction;
+                if (instruction->opcode != IROpcode::Phi)
+                    continue;
+                for (IRInstruction* operand : instruction->operands)
+                    merges[operand].push_back(instruction);
+            }
+        }
+
+        computeLiveness();
+        for (IRBlock* block : method->blocks) {
+            List<bool> live = getLiveOut(block);
+            walkBlock(block, live, true);
+        }
+
+        // the virtual machine copies the arguments to the storage of their own type in order,
+        // int foo(int a, long b, int c) -> a = ints[0], b = longs[0], c = ints[1]
+        for (IRInstruction* parameter : method->parameters) {
+            slots[parameter] = sizes[parameter->type]++;
+        }
+
+        // the values are colored in the order of their definitions, therefore the phis of the loop headers
+        // are colored before the values that are merged by them at the end of the loops
+        for (IRBlock* block : method->getReversePostorder()) {
+            for (IRInstruction* instruction : block->instructions) {
+                if (hasSlot(instruction) && instruction->opcode != IROpcode::Parameter)
+                    assignSlot(instruction);
+            }
+        }
+    }
+
+    /**
+     * Determine if the value of an instruction is written to a storage slot.
+     * @param instruction target instruction
+     * @return true if the value needs a slot
+     */
+    bool SlotAllocator::hasSlot(IRInstruction* instruction) {
+        // the result of a call is discarded if it is not used
+        if (instruction->type == 'V' || instruction->opcode == IROpcode::Constant)
+            return false;
+        return instruction->opcode != IROpcode::Call || uses[instruction] > 0;
+    }
+
+    /**
+     * Calculate the values that are live at the start of each block, until none of the blocks change.
+     */
+    void SlotAllocator::computeLiveness() {
+        for (IRBlock* block : method->blocks)
+            liveIn[block] = List<bool>(method->values, false);
+
+        // the blocks are visited in postorder, so that the successors are mostly updated before their predecessors
+        List<IRBlock*> order = method->getReversePostorder();
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto it = order.rbegin(); it != order.rend(); it++) {
+                List<bool> live = getLiveOut(*it);
+                walkBlock(*it, live, false);
+                if (live != liveIn[*it]) {
+                    liveIn[*it] = live;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    /**
+     * Get the values that are live at the end of a block. The operands of the phis of the successors are
+     * read at the end of the block, while the phis themselves are written there.
+     * @param block target block
+     * @return live values by instruction identifiers
+     */
+    List<bool> SlotAllocator::getLiveOut(IRBlock* block) {
+        List<bool> live(method->values, false);
+        for (IRBlock* successor : block->successors) {
+            List<bool>& successorLive = liveIn[successor];
+            for (uint i = 0; i < live.size(); i++)
+                live[i] = live[i] || successorLive[i];
+
+            uint index = (uint) (std::find(successor->predecessors.begin(), successor->predecessors.end(), block)
+                - successor->predecessors.begin());
+            // a phi might merge an other phi of the same block, a = phi [0, b]; b = phi [1, a]
+            for (uint i = 0; i < successor->getPhiCount(); i++)
+                live[successor->instructions[i]->id] = false;
+            for (uint i = 0; i < successor->getPhiCount(); i++) {
+                IRInstruction* operand = successor->instructions[i]->operands[index];
+                if (hasSlot(operand))
+                    live[operand->id] = true;
+            }
+        }
+        return live;
+    }
+
+    /**
+     * Walk the instructions of a block backwards, and update the live values before each instruction.
+     * @param block target block
+     * @param live the values live at the end of the block, updated to the values live at the start of the block
+     * @param interfere true if the interferences of the defined values should be recorded
+     */
+    void SlotAllocator::walkBlock(IRBlock* block, List<bool>& live, bool interfere) {
+        uint phis = block->getPhiCount();
+        for (uint i = (uint) block->instructions.size(); i > phis; i--) {
+            IRInstruction* instruction = block->instructions[i - 1];
+            if (hasSlot(instruction)) {
+                // the unused values are written as well, therefore they must not overwrite the live values
+                if (interfere)
+                    addInterferences(instruction, live);
+                live[instruction->id] = false;
+            }
+            for (IRInstruction* operand : instruction->operands) {
+                if (hasSlot(operand))
+                    live[operand->id] = true;
+            }
+        }
+
+        // the phis are written at the end of the predecessors, therefore they are all live at the start of the block
+        for (uint i = 0; i < phis; i++)
+            live[block->instructions[i]->id] = true;
+        if (interfere) {
+            for (uint i = 0; i < phis; i++)
+                addInterferences(block->instructions[i], live);
+        }
+    }
+
+    /**
+     * Record that a defined value cannot share a slot with the values of the same type that are live at its definition.
+     * @param value defined value
+     * @param live the values live after the definition
+     */
+    void SlotAllocator::addInterferences(IRInstruction* value, List<bool>& live) {
+        for (uint i = 0; i < live.size(); i++) {
+            IRInstruction* other = values[i];
+            if (!live[i] || other == nullptr || other == value || other->type != value->type)
+                continue;
+            interferences[value].push_back(other);
+            interferences[other].push_back(value);
+        }
+    }
+
+    /**
+     * Assign the slot to a value, that is preferred by the related values and not used by the interfering values.
+     * @param value target value
+     */
+    void SlotAllocator::assignSlot(IRInstruction* value) {
+        List<bool> used(sizes[value->type] + 1, false);
+        for (IRInstruction* other : interferences[value]) {
+            auto slot = slots.find(other);
+            if (slot != slots.end())
+                used[slot->second] = true;
+        }
+
+        // a value merged by a phi takes the slot of the phi, so that it does not have to be copied,
+        // a phi takes the slot of a merged value, and an arithmetic result takes the slot of its left operand,
+        // a = phi [0, b]; b = a + 1 -> iinc -l a -r a
+        List<IRInstruction*> preferred = merges[value];
+        if (value->opcode == IROpcode::Phi || value->isArithmetic() || value->opcode == IROpcode::Negate) {
+            for (IRInstruction* operand : value->operands)
+                preferred.push_back(operand);
+        }
+        for (IRInstruction* other : preferred) {
+            auto slot = slots.find(other);
+            if (slot != slots.end() && other->type == value->type && !used[slot->second]) {
+                slots[value] = slot->second;
+                return;
+            }
+        }
+
+        uint slot = 0;
+        while (used[slot])
+            slot++;
+        slots[value] = slot;
+        sizes[value->type] = std::max(sizes[value->type], slot + 1);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+#include "IR.hpp"
+
+namespace Compiler {
+    /**
+     * Represents the storage slot allocation of the values of a method. The virtual machine keeps a separate storage
+     * for each type, and it grows the storage to the highest slot that is used, therefore the values of each type
+     * are packed into the fewest slots of that type. Two values can share a slot, if one of them is not live at the
+     * definition of the other. The values are colored in the order of their definitions, and a value takes the slot
+     * of a related value when possible, so that the copies of the phis and the in place steps can be omitted.
+     */
+    class SlotAllocator {
+    public:
+        /**
+         * The map of the storage slots of the values.
+         */
+        Map<IRInstruction*, uint> slots;
+
+        /**
+         * The map of the count of the used storage slots by the value types.
+         */
+        Map<char, uint> sizes;
+
+    private:
+        /**
+         * The allocated method graph.
+         */
+        IRMethod* method;
+
+        /**
+         * The map of the use counts of the values.
+         */
+        Map<IRInstruction*, uint>& uses;
+
+        /**
+         * The values that need a slot, indexed by their instruction identifiers.
+         */
+        List<IRInstruction*> values;
+
+        /**
+         * The map of the phis that merge the values.
+         */
+        Map<IRInstruction*, List<IRInstruction*>> merges;
+
+        /**
+         * The map of the values that are live at the start of the blocks, indexed by the instruction identifiers.
+         */
+        Map<IRBlock*, List<bool>> liveIn;
+
+        /**
+         * The map of the values that cannot share a slot with the values.
+         */
+        Map<IRInstruction*, List<IRInstruction*>> interferences;
+
+    public:
+        /**
+         * Initialize the slot allocator.
+         * @param method allocated method graph
+         * @param uses the use counts of the values
+         */
+        SlotAllocator(IRMethod* method, Map<IRInstruction*, uint>& uses);
+
+        /**
+         * Assign a storage slot to each value of the method that needs one.
+         */
+        void allocate();
+
+        /**
+         * Determine if the value of an instruction is written to a storage slot.
+         * @param instruction target instruction
+         * @return true if the value needs a slot
+         */
+        bool hasSlot(IRInstruction* instruction);
+
+    private:
+        /**
+         * Calculate the values that are live at the start of each block, until none of the blocks change.
+         */
+        void computeLiveness();
+
+        /**
+         * Get the values that are live at the end of a block. The operands of the phis of the successors are
+         * read at the end of the block, while the phis themselves are written there.
+         * @param block target block
+         * @return live values by instruction identifiers
+         */
+        List<bool> getLiveOut(IRBlock* block);
+
+        /**
+         * Walk the instructions of a block backwards, and update the live values before each instruction.
+         * @param block target block
+         * @param live the values live at the end of the block, updated to the values live at the start of the block
+         * @param interfere true if the interferences of the defined values should be recorded
+         */
+        void walkBlock(IRBlock* block, List<bool>& live, bool interfere);
+
+        /**
+         * Record that a defined value cannot share a slot with the values of the same type that are live at its definition.
+         * @param value defined value
+         * @param live the values live after the definition
+         */
+        void addInterferences(IRInstruction* value, List<bool>& live);
+
+        /**
+         * Assign the slot to a value, that is preferred by the related values and not used by the interfering values.
+         * @param value target value
+         */
+        void assignSlot(IRInstruction* value);
+    };
+}
@@ -0,0 +1,54 @@
+#include "ValueEliminator.hpp"
+
+namespace Compiler {
+    /**
+     * Initialize the value eliminator.
+     */
+    ValueEliminator::ValueEliminator()
+        : IRPass("values")
+    { }
+
+    /**
+     * Remove the unused instructions of a method.
+     * @param method target method
+     * @return the count of the removed instructions
+     */
+    uint ValueEliminator::run(IRMethod* method) {
+        // the parameters are kept as well, as they describe the arguments passed by the callers
+        List<bool> live(method->values, false);
+        List<IRInstruction*> queue;
+        for (IRBlock* block : method->blocks) {
+            for (IRInstruction* instruction : block->instructions) {
+                if (instruction->hasSideEffects() || instruction->opcode == IROpcode::Parameter) {
+                    live[instruction->id] = true;
+                    queue.push_back(instruction);
+                }
+            }
+        }
+
+        // mark the values used by the live instructions
+        while (!queue.empty()) {
+            IRInstruction* instruction = queue.back();
+            queue.pop_back();
+            for (IRInstruction* operand : instruction->operands) {
+                if (live[operand->id])
+                    continue;
+                live[operand->id] = true;
+                queue.push_back(operand);
+            }
+        }
+
+        uint removed = 0;
+        for (IRBlock* block : method->blocks) {
+            List<IRInstruction*> kept;
+            for (IRInstruction* instruction : block->instructions) {
+                if (live[instruction->id])
+                    kept.push_back(instruction);
+                else
+                    removed++;
+            }
+            block->instructions = kept;
+        }
+        return removed;
+    }
+}
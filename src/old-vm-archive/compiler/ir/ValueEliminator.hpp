@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+#include "PassManager.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that removes the instructions whose values are never used.
+     * The instructions with side effects are kept, and every value that is used by a kept instruction is kept
+     * as well. Unlike counting the uses, the marking removes the phis of a loop that only use each other.
+     */
+    class ValueEliminator : public IRPass {
+    public:
+        /**
+         * Initialize the value eliminator.
+         */
+        ValueEliminator();
+
+        /**
+         * Remove the unused instructions of a method.
+         * @param method target method
+         * @return the count of the removed instructions
+         */
+        uint run(IRMethod* method) override;
+    };
+}
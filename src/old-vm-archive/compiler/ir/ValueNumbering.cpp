@@ -0,0 +1,89 @@
+#include "ValueNumbering.hpp"
+
+namespace Compiler {
+    /**
+     * Initialize the value numbering.
+     */
+    ValueNumbering::ValueNumbering()
+        : IRPass("gvn")
+    { }
+
+    /**
+     * Remove the redundant computations of a method.
+     * @param method target method
+     * @return the count of the removed instructions
+     */
+    uint ValueNumbering::run(IRMethod* method) {
+        children.clear();
+        available.clear();
+        removed = 0;
+
+        Map<IRBlock*, IRBlock*> dominators = method->getDominators();
+        for (IRBlock* block : method->getReversePostorder()) {
+            if (block != method->blocks[0])
+                children[dominators[block]].push_back(block);
+        }
+
+        numberBlock(method, method->blocks[0]);
+        return removed;
+    }
+
+    /**
+     * Number the instructions of a block and the blocks it dominates. The values of the block
+     * are only available in the dominated blocks, therefore they are forgotten afterwards.
+     * @param method target method
+     * @param block target block
+     */
+    void ValueNumbering::numberBlock(IRMethod* method, IRBlock* block) {
+        List<String> defined;
+        List<IRInstruction*> instructions = block->instructions;
+        for (IRInstruction* instruction : instructions) {
+            String key = getKey(instruction);
+            if (key.empty())
+                continue;
+
+            // a = b * c; d = b * c -> a = b * c; d = a
+            auto value = available.find(key);
+            if (value != available.end()) {
+                method->replaceUses(instruction, value->second);
+                method->remove(instruction);
+                removed++;
+                continue;
+            }
+            available[key] = instruction;
+            defined.push_back(key);
+        }
+
+        for (IRBlock* child : children[block])
+            numberBlock(method, child);
+
+        for (String& key : defined)
+            available.erase(key);
+    }
+
+    /**
+     * Get the key that is equal for the instructions that compute the same value.
+     * @param instruction target instruction
+     * @return numbering key, or empty if the instruction cannot be reused
+     */
+    String ValueNumbering::getKey(IRInstruction* instruction) {
+        IROpcode opcode = instruction->opcode;
+        if (!instruction->isArithmetic() && opcode != IROpcode::Negate && opcode != IROpcode::Phi)
+            return "";
+
+        List<uint> operands;
+        for (IRInstruction* operand : instruction->operands)
+            operands.push_back(operand->id);
+        // a + b = b + a
+        if ((opcode == IROpcode::Add || opcode == IROpcode::Multiply) && operands[0] > operands[1])
+            std::swap(operands[0], operands[1]);
+
+        // the phis merge values from the predecessors of their own block only
+        String key = toString((int) opcode) + ":" + instruction->type;
+        if (opcode == IROpcode::Phi)
+            key += ":" + toString(instruction->block->id);
+        for (uint operand : operands)
+            key += ":" + toString(operand);
+        return key;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+#include "PassManager.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that removes the computations whose result is already calculated by an
+     * earlier instruction. The instructions are numbered by their operation and operand values while walking the
+     * dominator tree, and an instruction with the same number as an instruction of a dominating block is replaced
+     * by it. The values are never reassigned in static single assignment form, therefore equal operands always
+     * mean an unchanged computation. The calls and prints are never numbered, as a call might have side effects
+     * or return a different value each time.
+     */
+    class ValueNumbering : public IRPass {
+    private:
+        /**
+         * The map of the dominated blocks by their immediate dominators.
+         */
+        Map<IRBlock*, List<IRBlock*>> children;
+
+        /**
+         * The map of the available values by their numbering keys.
+         */
+        Map<String, IRInstruction*> available;
+
+        /**
+         * The count of the removed instructions of the current method.
+         */
+        uint removed = 0;
+
+    public:
+        /**
+         * Initialize the value numbering.
+         */
+        ValueNumbering();
+
+        /**
+         * Remove the redundant computations of a method.
+         * @param method target method
+         * @return the count of the removed instructions
+         */
+        uint run(IRMethod* method) override;
+
+    private:
+        /**
+         * Number the instructions of a block and the blocks it dominates. The values of the block
+         * are only available in the dominated blocks, therefore they are forgotten afterwards.
+         * @param method target method
+         * @param block target block
+         */
+        void numberBlock(IRMethod* method, IRBlock* block);
+
+        /**
+         * Get the key that is equal for the instructions that compute the same value.
+         * @param instruction target instruction
+         * @return numbering key, or empty if the instruction cannot be reused
+         */
+        String getKey(IRInstruction* instruction);
+    };
+}
@@ -45,6 +45,7 @@ namespace Compiler {
             "Else",
             "While",
             "DoWhile",
+            "Switch",
             "For",
             "ForEach",
             "Error",
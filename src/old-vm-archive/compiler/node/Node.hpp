@@ -3,9 +3,11 @@
 #include "../../Common.hpp"
 #include "../token/Token.hpp"
 #include "../builder/Package.hpp"
+#include "Operator.hpp"
 
 namespace Compiler {
     class Package;
+    class PassManager;
 
     /**
      * Represents a registry of the parsable node types.
@@ -49,6 +51,7 @@ namespace Compiler {
         Else,
         While,
         DoWhile,
+        Switch,
         For,
         ForEach,
         Error,
@@ -303,7 +306,7 @@ namespace Compiler {
 
         List<ElseIf*> elseIfs;
 
-        Else* elseCase;
+        Else* elseCase = nullptr;
 
         If(Package* package, Node* condition, List<Node*> body);
 
@@ -341,6 +344,31 @@ namespace Compiler {
         void debug(uint& index) override;
     };
 
+    class SwitchCase {
+    public:
+        List<Token> keys;
+
+        List<Node*> body;
+
+        SwitchCase(List<Token> keys, List<Node*> body);
+    };
+
+    class Switch : public Node {
+    public:
+        Node* value;
+
+        List<SwitchCase*> cases;
+
+        SwitchCase* defaultCase = nullptr;
+
+        Switch(Package* package, Node* value);
+
+        /**
+         * Debug the content of the parsed node.
+         */
+        void debug(uint& index) override;
+    };
+
     //
     // FieldNode
     //
@@ -533,19 +561,36 @@ namespace Compiler {
 
         TypeNode* parent = nullptr;
 
+        /**
+         * Determine if the method is declared with a body. The native and extern methods do not have one.
+         */
+        bool defined = true;
+
         MethodNode(Package* package, List<NamedType> returnTypes, UString name, List<Parameter> parameters, List<Node*> body);
 
+        /**
+         * Determine if the method is implemented by the virtual machine, instead of its bytecode.
+         * @return true if the method is native or extern
+         */
+        bool isExternal();
+
+        /**
+         * Debug the content of the parsed node.
+         */
+        void debug(uint& index) override;
+
         /**
          * Build bytecode for this node.
          * @param bytecode result bytecode list
          */
         void build(List<UString>& bytecode) override;
 
-    private:
         /**
-         * Parse the return type of the method.
+         * Build bytecode for this node, generating the method body through the intermediate representation.
+         * @param bytecode result bytecode list
+         * @param passes the pass manager of the intermediate representation, or null to build the nodes directly
          */
-        UString parseReturnType();
+        void build(List<UString>& bytecode, PassManager* passes);
     };
 
     class MethodCall : public Node {
@@ -625,6 +670,11 @@ namespace Compiler {
          */
         UString target;
 
+        /**
+         * The type of the target operator.
+         */
+        OperatorType operatorType;
+
         /**
          * The second expression of the operation.
          */
@@ -633,10 +683,10 @@ namespace Compiler {
         /**
          * Initialize the operation.
          * @param left first expression
-         * @param target target operator
+         * @param operatorType target operator
          * @param right second expression
          */
-        Operation(Package* package, Node* left, UString target, Node* right);
+        Operation(Package* package, Node* left, OperatorType operatorType, Node* right);
 
         /**
          * Debug the content of the parsed node.
@@ -679,11 +729,13 @@ namespace Compiler {
     public:
         UString target;
 
+        OperatorType operatorType;
+
         Node* operand;
 
         bool left;
 
-        SideOperation(Package* package, UString target, Node* operand, bool left);
+        SideOperation(Package* package, OperatorType operatorType, Node* operand, bool left);
 
         /**
          * Debug the content of the parsed node.
@@ -3,12 +3,18 @@
 
 using namespace Void;
 
+// print the parsed declarations, unless the parser has been silenced
+#define dump(x) \
+    if (verbose) print(x)
+#define dumpln(x) \
+    if (verbose) println(x)
+
 namespace Compiler {
     /**
      * Initialize the token parser.
      */
-    NodeParser::NodeParser(Package* package, List<Token> tokens)
-        : package(package), tokens(tokens)
+    NodeParser::NodeParser(Package* package, List<Token> tokens, bool verbose)
+        : package(package), tokens(tokens), verbose(verbose)
     { }
 
     /**
@@ -239,6 +245,7 @@ namespace Compiler {
             get();
             // parse the next tuple member type
             NamedType type = nextNamedType(true);
+            returnTypes.push_back(type);
 
             // handle more type members
             // (MyType, OtherType) doSomething() 
@@ -305,6 +312,7 @@ namespace Compiler {
             // handle method generic types end
             // T getValue<T>(String key)
             //              ^ close angle bracket indicates, that the declaration of the method generic types has ended
+            splitGenericEnd();
             get(TokenType::Operator, U">");
         }
 
@@ -334,10 +342,11 @@ namespace Compiler {
         //                     ^ just like before, generic types are placed in between angle brackets
         List<Token> paramGenerics = parseGenerics();
 
-        // handle method array type
-        // int[] getPositionXYZ()
-        //    ^^ square brackets after the type indicates that they are arrays
-        uint dimensions = parseArray();
+        // handle parameter array type
+        // int sum(int[] values)
+        //            ^^ square brackets after the type indicates that they are arrays
+        // TODO the dimensions are not stored by the parameter yet
+        parseArray();
 
         // handle variadic method
         // List<T> fromElements<T>(T... elements)
@@ -376,90 +385,99 @@ namespace Compiler {
         if (peek().is(TokenType::Semicolon, U"auto"))
             get();
 
-        // handle method body begin
-        get(TokenType::Begin);
-
-        // parse the body of the method
+        // handle method declaration without a body
+        // native int hash(int value)
+        //                           ^ the native and extern methods are implemented by the virtual machine
         List<Node*> body;
-        while (!peek().is(TokenType::End)) {
-            body.push_back(nextExpression());
-        }
+        bool defined = peek().is(TokenType::Begin);
+        if (defined) {
+            // handle method body begin
+            get();
 
-        // handle method body end
-        get(TokenType::End);
+            // parse the body of the method
+            while (!peek().is(TokenType::End)) {
+                body.push_back(nextExpression());
+            }
+
+            // handle method body end
+            get(TokenType::End);
+        }
 
         // skip the auto-inserted semicolon
         if (peek().is(TokenType::Semicolon))
             get();
 
         if (returnTypes.size() > 1)
-            print("(");
+            dump("(");
         for (uint i = 0; i < returnTypes.size(); i++) {
             NamedType type = returnTypes[i];
             for (uint j = 0; j < type.types.size(); j++) {
-                print(type.types[j].value);
+                dump(type.types[j].value);
                 if (j < type.types.size() - 1)
-                    print(".");
+                    dump(".");
             }
             if (!type.generics.empty()) {
-                print("<");
+                dump("<");
                 for (uint j = 0; j < type.generics.size(); j++) {
-                    print(type.generics[j].value);
+                    dump(type.generics[j].value);
                 }
-                print(">");
+                dump(">");
             }
             for (uint j = 0; j < type.dimensions; j++) {
-                print("[]");
+                dump("[]");
             }
             if (type.named)
-                print(" " << type.name);
+                dump(" " << type.name);
             if (i < returnTypes.size() - 1)
-                print(", ");
+                dump(", ");
         }
         if (returnTypes.size() > 1)
-            print(")");
-        print(" ");
+            dump(")");
+        dump(" ");
 
-        print(name);
+        dump(name);
 
         if (!genericTypes.empty())
-            print("<" << Strings::join(genericTypes, U", ") << ">");
-        print("(");
+            dump("<" << Strings::join(genericTypes, U", ") << ">");
+        dump("(");
 
         for (uint i = 0; i < parameters.size(); i++) {
-            print(parameters[i].type.value);
+            dump(parameters[i].type.value);
             if (!parameters[i].generics.empty()) {
-                print("<");
+                dump("<");
                 for (uint j = 0; j < parameters[i].generics.size(); j++) {
-                    print(parameters[i].generics[j].value);
+                    dump(parameters[i].generics[j].value);
                 }
-                print(">");
+                dump(">");
             }
             if (parameters[i].varargs)
-                print("...");
+                dump("...");
 
-            print(" " << parameters[i].name);
+            dump(" " << parameters[i].name);
             if (i < parameters.size() - 1)
-                print(", ");
+                dump(", ");
         }
 
-        println(") {");
+        dumpln(") {");
 
         for (Node* element : body) {
             uint index = -1;
             index++;
-            print(Strings::fill(index + 1, "    "));
-            element->debug(index);
+            dump(Strings::fill(index + 1, "    "));
+            if (verbose)
+                element->debug(index);
             index--;
         }
 
-        println("}");
+        dumpln("}");
 
         // skip the auto-inserted semicolon
         if (peek().is(TokenType::Semicolon))
             get();
 
-        return new MethodNode(package, returnTypes, name, parameters, List<Node*>());
+        MethodNode* method = new MethodNode(package, returnTypes, name, parameters, body);
+        method->defined = defined;
+        return method;
     }
 
     /**
@@ -480,19 +498,19 @@ namespace Compiler {
         //       ^^^ the identifier after the type token(s) is the name of the method
         UString name = get(TokenType::Identifier).value;
 
-        print(type.value);
+        dump(type.value);
         if (!typeGenerics.empty()) {
-            print("<");
+            dump("<");
             for (auto token : typeGenerics)
-                print(token.value);
-            print(">");
+                dump(token.value);
+            dump(">");
         }
-        print(" " << name);
+        dump(" " << name);
 
         // handle field without an explicit default value
         if (peek().is(TokenType::Semicolon)) {
             get();
-            println("");
+            dumpln("");
             return new FieldNode(package, type, typeGenerics, name, {});
         }
 
@@ -513,11 +531,12 @@ namespace Compiler {
         // skip the semicolon after the field declaration
         get(TokenType::Semicolon);
 
-        print(" = ");
+        dump(" = ");
         uint index = -1;
-        value->debug(index);
+        if (verbose)
+            value->debug(index);
         if (value->type == NodeType::Value || value->type == NodeType::Template)
-            println("");
+            dumpln("");
 
         return new FieldNode(package, type, typeGenerics, name, makeOptional(value));
     }
@@ -540,24 +559,26 @@ namespace Compiler {
 
         if (value.has_value()) {
             uint index = -1;
-            print(" = ");
-            (*value)->debug(index);
+            dump(" = ");
+            if (verbose)
+                (*value)->debug(index);
         }
 
     parseField:
         // parse the name of the field
         UString fieldName = get(TokenType::Identifier).value;
 
-        print(", " << fieldName);
+        dump(", " << fieldName);
 
         // parse the value of the field
         Option<Node*> fieldValue;
         if (peek().is(TokenType::Operator, U"=")) {
             get();
             fieldValue = nextExpression();
-            print(" = ");
+            dump(" = ");
             uint index = -1;
-            (*fieldValue)->debug(index);
+            if (verbose)
+                (*fieldValue)->debug(index);
         }
 
         // register the field
@@ -574,7 +595,7 @@ namespace Compiler {
         if (peek().is(TokenType::Semicolon))
             get(TokenType::Semicolon);
 
-        println("");
+        dumpln("");
 
         return new MultiField(package, type, generics, fields);
     }
@@ -599,9 +620,9 @@ namespace Compiler {
         //                       ^^^ the generic names are placed in between angle brackets
         List<UString> genericNames = parseGenericNames();
 
-        print(kind << " " << name);
+        dump(kind << " " << name);
         if (!genericNames.empty())
-            print("<" << Strings::join(genericNames, U",") << ">");
+            dump("<" << Strings::join(genericNames, U",") << ">");
 
         // TODO generic type implementation (where T implements MyType)
 
@@ -632,7 +653,7 @@ namespace Compiler {
         // handle type body begin
         get(TokenType::Begin);
 
-        println(" {");
+        dumpln(" {");
 
         // parse the body of the type
         List<Node*> body;
@@ -642,7 +663,7 @@ namespace Compiler {
         // handle type body end
         get(TokenType::End);
 
-        println("}");
+        dumpln("}");
 
         // handle auto-inserted semicolon at the end or the body
         if (peek().is(TokenType::Semicolon, U"auto"))
@@ -675,7 +696,7 @@ namespace Compiler {
         // handle struct body begin
         get(TokenType::Begin);
 
-        println(" {");
+        dumpln(" {");
 
         // parse the body of the struct
         List<Node*> body;
@@ -685,7 +706,7 @@ namespace Compiler {
         // handle struct body end
         get(TokenType::End);
 
-        println("}");
+        dumpln("}");
 
         // handle auto-inserted semicolon at the end or the body
         if (peek().is(TokenType::Semicolon, U"auto"))
@@ -711,22 +732,22 @@ namespace Compiler {
         if (peek().is(TokenType::Semicolon))
             get();
 
-        print("(");
+        dump("(");
         for (uint i = 0; i < parameters.size(); i++) {
             auto param = parameters[i];
-            print(param.type.value);
+            dump(param.type.value);
             if (!param.generics.empty()) {
-                print("<");
+                dump("<");
                 for (auto token : param.generics)
-                    print(token.value);
-                print(">");
+                    dump(token.value);
+                dump(">");
             }
             if (named)
-                print(" " << param.name);
+                dump(" " << param.name);
             if (i < parameters.size() - 1)
-                print(", ");
+                dump(", ");
         }
-        println(")");
+        dumpln(")");
 
         return new TupleStruct(package, name, genericNames, named, parameters);
     }
@@ -791,7 +812,7 @@ namespace Compiler {
      * Parse the next expression instruction.
      * @return new expression
      */
-    Node* NodeParser::nextExpression(bool ignoreJoin) {
+    Node* NodeParser::nextExpression() {
         // handle local variable declaration
         // let myVariable = 100
         // ^^^ the "let" keyword indicates that, the local variable declaration has been started
@@ -801,37 +822,32 @@ namespace Compiler {
         else if (peek().is(TokenType::Identifier) && at(cursor + 1).is(TokenType::Identifier))
             return nextLocalDeclaration();
 
-        else if (peek().is(TokenType::Identifier) && at(cursor + 1).is(TokenType::Operator, U"<"))
+        else if (peek().is(TokenType::Identifier) && at(cursor + 1).is(TokenType::Operator, U"<") && testGenericDeclaration())
             return nextLocalDeclaration();
 
         // handle variable assignation (TODO and non-primitive local variable declaration)
-        else if (peek().is(TokenType::Identifier) && at(cursor + 1).is(TokenType::Operator, U"=") && !at(cursor + 2).is(TokenType::Operator, U"="))
+        else if (peek().is(TokenType::Identifier) && at(cursor + 1).is(TokenType::Operator, U"="))
             return nextLocalAssignation();
 
-        // handle node grouping
-        // let a = (b + c) + d
-        //         ^ the open parenthesis indicate, that the following nodes should be placed in a node group
-        else if (peek().is(TokenType::Open))
-            return nextGroupOrTuple(ignoreJoin);
-
         // handle lambda function
-        else if (peek().is(TokenType::Operator, U"|"))
+        else if (peek().is(TokenType::Operator, U"|") || peek().is(TokenType::Operator, U"||"))
             return nextLambdaFunction();
 
-        // handle string template
-        else if (peek().is(TokenType::Operator, U"$"))
-            return nextStringTemplate(ignoreJoin);
+        // handle value expression, that might be a sequence of operations
+        // let a = (b + c) * -d
+        //         ^^^^^^^^^^^^ the operands are grouped together by the precedence of the operators between them
+        else if (peek().is(5, TokenType::Open, TokenType::Identifier, TokenType::Operator, TokenType::Null, TokenType::Hexadecimal)
+            || peek().isLiteral() || peek().is(TokenType::Expression, U"new")) {
+            Node* value = nextOperation(nextOperand(), PRECEDENCE_LOWEST);
 
-        // handle literal constant or identifier
-        // let name = "John Doe"
-        //            ^^^^^^^^^^ the literal token indicates, that a value is expected
-        else if (peek().isLiteral() || peek().is(TokenType::Identifier))
-            return nextLiteralOrMethodCall(ignoreJoin);
+            // skip the semicolon after the value expression
+            // counter += 1;
+            //             ^ the (auto-inserted) semicolon indicates, that the value expression has been ended
+            if (peek().is(TokenType::Semicolon))
+                get();
 
-        // handle single value operation
-        // TODO make sure the target operator is a single-value operator
-        else if (peek().is(TokenType::Operator))
-            return nextSingleOperator();
+            return value;
+        }
 
         // handle return statement
         else if (peek().is(TokenType::Expression, U"return"))
@@ -853,9 +869,9 @@ namespace Compiler {
         else if (peek().is(TokenType::Expression, U"do"))
             return nextDoWhileStatement();
 
-        // handle new statement
-        else if (peek().is(TokenType::Expression, U"new"))
-            return nextNewStatement(ignoreJoin);
+        // handle switch statement
+        else if (peek().is(TokenType::Expression, U"switch"))
+            return nextSwitchStatement();
 
         // TODO handle local variable assignation
         // handle unexpected token
@@ -864,14 +880,6 @@ namespace Compiler {
         return new ErrorNode();
     }
 
-    /**
-     * Parse the next expression instruction.
-     * @return new expression
-     */
-    Node* NodeParser::nextExpression() {
-        return nextExpression(false);
-    }
-
     /**
      * Parse the new local declaration.
      * @return new local declaration
@@ -1036,10 +1044,16 @@ namespace Compiler {
      */
     Node* NodeParser::nextLambdaFunction() {
         // parse the parameters of the lamba function
+        // || println("no parameters")
+        // ^^ the empty parameter list is a single operator token
         List<Parameter> parameters;
         bool typed = false;
-        Token token = Token::of(TokenType::Operator, U"|");
-        parseParameters(token, token, parameters, typed);
+        if (peek().is(TokenType::Operator, U"||"))
+            get();
+        else {
+            Token token = Token::of(TokenType::Operator, U"|");
+            parseParameters(token, token, parameters, typed);
+        }
 
         // parse the body of the lambda function
         List<Node*> body = parseStatementBody();
@@ -1051,7 +1065,7 @@ namespace Compiler {
      * Parse the next literal value or method call declaration.
      * @return new literal or method call
      */
-    Node* NodeParser::nextLiteralOrMethodCall(bool ignoreJoin) {
+    Node* NodeParser::nextLiteralOrMethodCall() {
         // handle literal constant or identifier
         // 
         // let name = "John Doe"
@@ -1059,41 +1073,17 @@ namespace Compiler {
         // get the value constant
         // let age = 32
         //           ^^ get the actual value of the literal
-        Token value = get(10, TokenType::Identifier,
+        Token value = get(12, TokenType::Identifier,
             TokenType::Boolean, TokenType::Character, TokenType::String,
             TokenType::Byte, TokenType::Short, TokenType::Integer, 
-            TokenType::Long, TokenType::Float, TokenType::Double
+            TokenType::Long, TokenType::Float, TokenType::Double,
+            TokenType::Hexadecimal, TokenType::Null
         );
 
-        // handle single value expression, in which case the local variable is declared, but is not initialized
-        // let myUninitializedVariable;
-        //                            ^ the (auto-inserted) semicolon indicates, that the variable is declared, but is not yet assigned with a value
-        if (peek().is(TokenType::Semicolon))
-            return new Value(package, value);
-
-        // handle operation between two expressions
-        // let var = 100 + 
-        //               ^ the operator after a literal indicates, that there are more expressions to be parsed
-        //                 the two operands are grouped together by an Operation node
-        else if (peek().is(2, TokenType::Operator, TokenType::Colon)) {
-            if (ignoreJoin)
-                return new Value(package, value);
-            if (peek().val(U"."))
-                return nextJoinOperation(new Value(package, value));
-            UString target = parseOperator();
-            // handle right-side single-value operation
-            if (isRightOperator(target))
-                return new SideOperation(package, target, new Value(package, value), false);
-            // TODO make more proper error handling
-            if (!isComplexOperator(target))
-                error("Expected complex operator, but got " << target);
-            return fixOperationTree(new Operation(package, new Value(package, value), target, nextExpression()));
-        }
-
         // handle method call
         // println("Hello, World!")
         //        ^ the open parenthesis token after an identifier indicates, that a method call is expected
-        else if (peek().is(TokenType::Open)) {
+        if (peek().is(TokenType::Open)) {
             // TODO make sure "value" is an identifier
 
             List<Node*> arguments = parseArguments();
@@ -1106,49 +1096,12 @@ namespace Compiler {
             if (peek().is(TokenType::Semicolon))
                 get();
 
-            // handle operation after a method call
-            // outer(inner(123) + 2)
-            //                  ^ the operator indicates, that the method call should be groupped with the expression afterwards
-            if (peek().is(TokenType::Operator)) {
-                if (ignoreJoin)
-                    return new MethodCall(package, value.value, arguments);
-                if (peek().val(U"."))
-                    return nextJoinOperation(new MethodCall(package, value.value, arguments));
-                UString target = parseOperator();
-                // TODO make more proper error handling
-                if (!isComplexOperator(target))
-                    error("Expected complex operator, but got " << target);
-                return fixOperationTree(new Operation(package, new MethodCall(package, value.value, arguments), target, nextExpression()));
-            }
-
             return new MethodCall(package, value.value, arguments);
         }
 
-        // handle group closing
-        // let val = (1 + 2) / 3
-        //                 ^ the close parenthesis indicates, that we are not expecting any value after the current token
-        else if (peek().is(TokenType::Close))
-            return new Value(package, value);
-
-        // handle argument list or array fill
-        // foo(123, 450.7)
-        //        ^ the comma indicates, that the expression has been terminated
-        else if (peek().is(TokenType::Comma))
-            return new Value(package, value);
-
-        // handle index closing or array end
-        // foo[10] = 404
-        //       ^ the closing square bracket indicates, that the expression has been terminated
-        else if (peek().is(TokenType::Stop))
-            return new Value(package, value);
-
-        // handle initializator end
-        // new Pair { key: "value" }
-        //                         ^ the closing bracket indicates, that the initializator has been terminated
-        else if (peek().is(TokenType::End))
-            return new Value(package, value);
-
         // handle indexing
+        // let element = array[index]
+        //                    ^ the open square bracket indicates, that an element of the value is accessed
         else if (peek().is(TokenType::Start)) {
             // skip the '[' sign
             get();
@@ -1171,23 +1124,20 @@ namespace Compiler {
                 return new IndexAssign(package, value.value, index, indexValue);
             }
 
-            // handle operation after an index fetch
-            if (peek().is(TokenType::Operator)) {
-                if (ignoreJoin)
-                    return new IndexFetch(package, value.value, index);
-                if (peek().val(U"."))
-                    return nextJoinOperation(new IndexFetch(package, value.value, index));
-                UString target = parseOperator();
-                // TODO make more proper error handling
-                if (!isComplexOperator(target))
-                    error("Expected complex operator, but got " << target);
-                return fixOperationTree(new Operation(package, new IndexFetch(package, value.value, index), target, nextExpression()));
-            }
-
             // there is no value assignation, handle index fetch
             return new IndexFetch(package, value.value, index);
         }
 
+        // handle single value expression, in which case the value is terminated or followed by an operator
+        // let var = 100 + 
+        //               ^ the operator after a literal indicates, that there are more expressions to be parsed,
+        //                 the operands are grouped together by the caller's operation parser
+        // let val = (1 + 2) / 3
+        //                 ^ the close parenthesis indicates, that we are not expecting any value after the current token
+        else if (peek().is(8, TokenType::Semicolon, TokenType::Operator, TokenType::Colon, TokenType::Close, 
+            TokenType::Comma, TokenType::Stop, TokenType::End, TokenType::Finish))
+            return new Value(package, value);
+
         Token error = peek();
         println("Error (Literal / Method Call) " << error);
         return new ErrorNode();
@@ -1197,25 +1147,12 @@ namespace Compiler {
      * Parse the next string template declaration.
      * @return new string template
      */
-    Node* NodeParser::nextStringTemplate(bool ignoreJoin) {
+    Node* NodeParser::nextStringTemplate() {
         // skip the '$' sign
         get(TokenType::Operator, U"$");
         // get the string value of the template
         Token value = get(TokenType::String);
 
-        // handle operation after template string
-        if (peek().is(TokenType::Operator)) {
-            if (ignoreJoin)
-                return new Template(package, value);
-            if (peek().val(U"."))
-                return nextJoinOperation(new Template(package, value));
-            UString target = parseOperator();
-            // TODO make more proper error handling
-            if (!isComplexOperator(target))
-                error("Expected complex operator, but got " << target);
-            return fixOperationTree(new Operation(package, new Template(package, value), target, nextExpression()));
-        }
-
         return new Template(package, value);
     }
 
@@ -1225,18 +1162,145 @@ namespace Compiler {
      */
     Node* NodeParser::nextSingleOperator() {
         // get the operator of the operation
-        UString target = parseOperator();
-        // parse the operand of the operation
-        Node* operand = nextExpression();
-        
+        // let negated = !condition
+        //               ^ the operator before the operand indicates, that the operation is applied on the value
+        OperatorType target = peekOperator();
+
         // test if an invalid left operator was given
         // TODO handle this properly
-        if (!isLeftOperator(target))
-            error("Expected left-side operator, but got " << target);
+        if (!getOperatorInfo(target).prefix)
+            error("Expected left-side operator, but got " << peek().value);
+        get();
+
+        // parse the operand of the operation
+        // only the operators with a higher precedence than the single operator are included in the operand
+        // -a.b * c    =>    (-(a.b)) * c
+        Node* operand = nextOperation(nextOperand(), PRECEDENCE_PREFIX);
+
+        // the unary plus does not change the value of the operand
+        // a + +b    =>    a + b
+        if (target == OperatorType::Add)
+            return operand;
 
         return new SideOperation(package, target, operand, true);
     }
 
+    /**
+     * Parse the next operand of an operation, which is a value that might be prefixed by single value operators.
+     * @return new operand value
+     */
+    Node* NodeParser::nextOperand() {
+        // handle single value operation
+        // let value = -getNumber()
+        //             ^ the operator before a value indicates, that a single value operation is expected
+        if (peek().is(TokenType::Operator) && !peek().val(U"$"))
+            return nextSingleOperator();
+        return nextPrimary();
+    }
+
+    /**
+     * Parse the next value, that is not followed by an operator.
+     * @return new primary value
+     */
+    Node* NodeParser::nextPrimary() {
+        // handle node grouping
+        // let a = (b + c) + d
+        //         ^ the open parenthesis indicate, that the following nodes should be placed in a node group
+        if (peek().is(TokenType::Open))
+            return nextGroupOrTuple();
+
+        // handle string template
+        else if (peek().is(TokenType::Operator, U"$"))
+            return nextStringTemplate();
+
+        // handle new statement
+        else if (peek().is(TokenType::Expression, U"new"))
+            return nextNewStatement();
+
+        // handle literal constant or identifier
+        // let name = "John Doe"
+        //            ^^^^^^^^^^ the literal token indicates, that a value is expected
+        else if (peek().isLiteral() || peek().is(3, TokenType::Identifier, TokenType::Null, TokenType::Hexadecimal))
+            return nextLiteralOrMethodCall();
+
+        // handle unexpected token
+        Token error = peek();
+        println("Error (Primary) " << error);
+        return new ErrorNode();
+    }
+
+    /**
+     * Parse the sequence of operators after the given operand, and group the operands by the operator precedences.
+     * @param left first operand of the operation
+     * @param precedence the lowest binding power of the operators to be included
+     * @return new operation or the operand itself if no operators follow
+     */
+    Node* NodeParser::nextOperation(Node* left, int precedence) {
+        while (true) {
+            // do not continue the operation if the operand has been terminated
+            // foo(); -bar
+            //      ^ the semicolon indicates, that the operator belongs to the next statement
+            if (cursor > 0 && at(cursor - 1).is(TokenType::Semicolon))
+                return left;
+
+            // resolve the operator after the operand
+            // a + b * c
+            //   ^ the operator table tells how strong the operator binds its operands
+            OperatorType target = peekOperator();
+            const OperatorInfo& info = getOperatorInfo(target);
+
+            // stop if there is no operator after the operand, or the operator binds weaker than the current operation
+            // a * b + c
+            //       ^ when parsing the right side of '*', the '+' belongs to the outer operation
+            if (info.precedence == 0 || info.precedence < precedence)
+                return left;
+            get();
+
+            // handle member access chain
+            // user.getName().length
+            //     ^         ^ the dot indicates, that the next value is accessed on the previous one
+            if (target == OperatorType::Member) {
+                Node* member = nextPrimary();
+                // extend the chain if the left side is already a member access
+                if (left->is(NodeType::JoinOperation))
+                    static_cast<JoinOperation*>(left)->children.push_back(member);
+                else
+                    left = new JoinOperation(package, left, { member });
+            }
+
+            // handle safe member access and scope resolution
+            // user?.name    Color::RED
+            //     ^^             ^^ the right side of these operators are single values
+            else if (target == OperatorType::SafeMember || target == OperatorType::Scope)
+                left = new Operation(package, left, target, nextPrimary());
+
+            // handle right-side single-value operation
+            // index++
+            //      ^^ the operator after the value does not expect another operand
+            else if (info.postfix)
+                left = new SideOperation(package, target, left, false);
+
+            // handle conditional operation
+            // let max = a > b ? a : b
+            //                 ^   ^ the question mark and the colon separate the condition and the two branches
+            else if (target == OperatorType::Ternary) {
+                Node* success = nextOperation(nextOperand(), PRECEDENCE_LOWEST);
+                get(TokenType::Colon);
+                Node* failure = nextOperation(nextOperand(), info.precedence);
+                left = new Operation(package, left, target, new Operation(package, success, OperatorType::TernaryElse, failure));
+            }
+
+            // handle operation between two operands
+            // the right operand of a left-associative operator may only contain operators, that bind stronger
+            // a - b - c    =>    (a - b) - c
+            // a ^ b ^ c    =>    a ^ (b ^ c)
+            else {
+                int next = info.rightAssociative ? info.precedence : info.precedence + 1;
+                left = new Operation(package, left, target, nextOperation(nextOperand(), next));
+            }
+        }
+    }
+
     /**
      * Parse the next value return statement declaration.
      * @return new return statement
@@ -1283,7 +1347,7 @@ namespace Compiler {
      * Parse the next group or tuple declaration.
      * @return new group or tuple
      */
-    Node* NodeParser::nextGroupOrTuple(bool ignoreJoin) {
+    Node* NodeParser::nextGroupOrTuple() {
         // let a = (b + c) + d
         //         ^ the open parenthesis indicate, that the following nodes should be placed in a node group
         // skip the '(' sign
@@ -1324,21 +1388,6 @@ namespace Compiler {
         //                  ^ the closing parenthesis indicate, that the declaration of node group has been ended
         get(TokenType::Close);
 
-        // handle operation after a node group
-        // (2 + 3) + 7
-        //         ^ the operator indicates, that the method call should be grouped with the expression afterward
-        if (peek().is(TokenType::Operator)) {
-            if (ignoreJoin)
-                return new Group(package, value);
-            if (peek().val(U"."))
-                return nextJoinOperation(new Group(package, value));
-            UString target = parseOperator();
-            // TODO make more proper error handling
-            if (!isComplexOperator(target))
-                error("Expected complex operator, but got " << target);
-            return fixOperationTree(new Operation(package, new Group(package, value), target, nextExpression()));
-        }
-
         return new Group(package, value);
     }
 
@@ -1476,11 +1525,83 @@ namespace Compiler {
         return new DoWhile(package, body, condition);
     }
 
+    /**
+     * Parse the next switch statement declaration.
+     * @return new switch statement
+     */
+    Node* NodeParser::nextSwitchStatement() {
+        // skip the "switch" keyword
+        get(TokenType::Expression, U"switch");
+
+        // parse the switched value
+        Switch* statement = new Switch(package, parseCondition());
+
+        // handle the beginning of the cases
+        get(TokenType::Begin);
+
+        List<UString> keys;
+        while (!peek().is(TokenType::End)) {
+            // skip the semicolons between the cases
+            if (peek().is(TokenType::Semicolon)) {
+                get();
+                continue;
+            }
+
+            // handle the default case
+            // else -> println("unknown")
+            bool fallback = peek().is(TokenType::Expression, U"else") || peek().is(TokenType::Identifier, U"default");
+            List<Token> caseKeys;
+            if (fallback) {
+                if (statement->defaultCase != nullptr)
+                    error("Switch statement cannot have multiple default cases.");
+                get();
+            }
+
+            // parse the keys of the case
+            // case 400 | 401 -> println("failed")
+            //      ^^^^^^^^^ the keys of the case are separated by '|' or ','
+            else {
+                if (peek().is(TokenType::Expression, U"case"))
+                    get();
+                while (true) {
+                    Token key = parseSwitchKey();
+                    if (contains(keys, key.value))
+                        error("Duplicate switch case key " << key.value << ".");
+                    keys.push_back(key.value);
+                    caseKeys.push_back(key);
+                    if (!peek().is(TokenType::Operator, U"|") && !peek().is(TokenType::Comma))
+                        break;
+                    get();
+                }
+            }
+
+            // handle the arrow between the keys and the body of the case
+            get(TokenType::Operator, U"-");
+            get(TokenType::Operator, U">");
+
+            // parse the body of the case, the cases do not fall through to each other
+            SwitchCase* switchCase = new SwitchCase(caseKeys, parseStatementBody());
+            if (fallback)
+                statement->defaultCase = switchCase;
+            else
+                statement->cases.push_back(switchCase);
+        }
+
+        // handle the ending of the cases
+        get(TokenType::End);
+
+        // skip the auto-inserted semicolon after the statement
+        if (peek().is(TokenType::Semicolon, U"auto"))
+            get();
+
+        return statement;
+    }
+
     /**
      * Parse the new statement declaration.
      * @return new "new" statement
      */
-    Node* NodeParser::nextNewStatement(bool ignoreJoin) {
+    Node* NodeParser::nextNewStatement() {
         // skip the "new" keyword
         get(TokenType::Expression, U"new");
 
@@ -1516,16 +1637,6 @@ namespace Compiler {
 
         Node* node = new NewNode(package, name, type, arguments, initializator);
 
-        // handle operation after constructor
-        if (peek().is(TokenType::Operator)) {
-            if (ignoreJoin)
-                return node;
-            if (peek().val(U"."))
-                return nextJoinOperation(node);
-            UString target = parseOperator();
-            return new Operation(package, node, target, nextExpression());
-        }
-
         // check if the method call is used as a statement or isn't expecting to be passed in a nested context
         // let result = new Foo("my input"); 
         //                                 ^ the semicolon indicates, that the method call does not have any
@@ -1597,11 +1708,11 @@ namespace Compiler {
         if (peek().is(TokenType::Colon)) {
             // skip the ':' symbol
             get();
-            println(Strings::join(modifiers, U" ") << ": ");
+            dumpln(Strings::join(modifiers, U" ") << ": ");
             return new ModifierBlock(package, modifiers);
         }
         // handle normal modifier list
-        print(Strings::join(modifiers, U" ") << " ");
+        dump(Strings::join(modifiers, U" ") << " ");
         return new ModifierList(package, modifiers);
     }
 
@@ -1676,63 +1787,6 @@ namespace Compiler {
         return ParameterType(type, variadic, name);
     }
 
-    /**
-     * Check if the first operator has a precedence priority over the second operator.
-     * @param first first operator to check
-     * @param second second operator to check
-     * @return true if the first operator has higher precedence than the second one
-     */
-    bool NodeParser::hasPrecedence(UString first, UString second) {
-         return OPERATION_INFO[first].first > OPERATION_INFO[second].first ||
-            (OPERATION_INFO[first].first == OPERATION_INFO[second].first &&
-                OPERATION_INFO[first].second == 0);
-    }
-
-    /**
-     * Fix the order of the operation sequences in the parsed value node.
-     * @param root root value expression node
-     * @return fixed node operations
-     */
-    Node* NodeParser::fixOperationTree(Node* node) {
-        // if the node is not an operation, return it as is
-        if (dynamic_cast<Operation*>(node) == nullptr) {
-            return node;
-        }
-
-        Operation* op = static_cast<Operation*>(node);
-        // recursively correct the order of the left and right nodes
-        op->left = fixOperationTree(op->left);
-        op->right = fixOperationTree(op->right);
-
-        // check if the current operator has lower precedence than the operator
-        // of its right child
-        if (op->right != nullptr &&
-            dynamic_cast<Operation*>(op->right) != nullptr &&
-            hasPrecedence(op->target, static_cast<Operation*>(op->right)->target)) {
-            // perform a right rotation
-            Node* tmp = op->right;
-            op->right = static_cast<Operation*>(tmp)->left;
-            static_cast<Operation*>(tmp)->left = op;
-            return tmp;
-        }
-
-        // check if the current operator has lower or equal precedence than the
-        // operator of its left child, and the left child is also an operation
-        if (op->left != nullptr &&
-            dynamic_cast<Operation*>(op->left) != nullptr &&
-            hasPrecedence(op->target, static_cast<Operation*>(op->left)->target) &&
-            OPERATION_INFO[op->target].second == 0) {
-            // perform a left rotation
-            Node* tmp = op->left;
-            op->left = static_cast<Operation*>(tmp)->right;
-            static_cast<Operation*>(tmp)->right = op;
-            return tmp;
-        }
-
-        // the current order is correct, so return the node as it is
-        return node;
-    }
-
     /**
      * Parse the next content of a type, which might be a type, method or field.
      * @return new declared type, method or field
@@ -1771,7 +1825,7 @@ namespace Compiler {
         UString name = get(TokenType::String).value;
         // ensure that the package is ended by a semicolon
         get(TokenType::Semicolon);
-        println("package \"" << name << '"');
+        dumpln("package \"" << name << '"');
         return new PackageSet(package, name);
     }
 
@@ -1786,46 +1840,10 @@ namespace Compiler {
         UString name = get(TokenType::String).value;
         // ensure that the package is ended by a semicolon
         get(TokenType::Semicolon);
-        println("import \"" << name << '"');
+        dumpln("import \"" << name << '"');
         return new Import(package, name);
     }
 
-    /**
-     * Parse the next join operation.
-     * @param target fisrt node of join operation
-     * @return new join operation
-     */
-    Node* NodeParser::nextJoinOperation(Node* target) {
-        List<Node*> children;
-
-        get(TokenType::Operator, U".");
-
-    parseChild:
-        Node* child = nextExpression(true);
-        children.push_back(child);
-
-        // check if more children are yet to be parsed
-        if (peek().is(TokenType::Operator, U".")) {
-            get();
-            goto parseChild;
-        }
-
-        Node* operation = new JoinOperation(package, target, children);
-
-        if (peek().is(TokenType::Operator)) {
-            UString target = parseOperator();
-            // handle right-side single-value operation
-            if (isRightOperator(target))
-                return new SideOperation(package, target, operation, false);
-            // TODO make more proper error handling
-            if (!isComplexOperator(target))
-                error("Expected complex operator, but got " << target);
-            return fixOperationTree(new Operation(package, operation, target, nextExpression()));
-        }
-
-        return operation;
-    }
-
     /**
      * Parse the generic types of a type.
      * @return geneirc type tokens
@@ -1843,6 +1861,7 @@ namespace Compiler {
         uint offset = 1;
         // loop until the generic type declaration ends
         while (true) {
+            splitGenericEnd();
             Token token = get();
             // handle nested generic type
             if (token.is(TokenType::Operator, U"<"))
@@ -1898,6 +1917,7 @@ namespace Compiler {
             // handle method generic types end
             // T getValue<T>(String key)
             //              ^ close angle bracket indicates, that the declaration of the method generic types has ended
+            splitGenericEnd();
             get(TokenType::Operator, U">");
         }
         return genericNames;
@@ -1944,87 +1964,38 @@ namespace Compiler {
     }
 
     /**
-     * Parse the next operator target.
-     * @return parsed operator
+     * Resolve the operator at the current index without moving the cursor.
+     * @return operator type or None if there is no operator
      */
-    UString NodeParser::parseOperator() {
-        UString result;
-        while (peek().is(TokenType::Operator)) {
-            result += get().value;
-            if (shouldOperatorTerminate(result))
-                return result;
-        }
-        while (peek().is(TokenType::Colon)) {
-            get();
-            result += ':';
-        }
-        return result;
-    }
-
-    /**
-     * Test if the given operator is applicable for a left-right use.
-     * @return true if the operator expects two values
-     */
-    bool NodeParser::isComplexOperator(UString target) {
-        return target == U"+"
-            || target == U"+="
-            || target == U"-"
-            || target == U"-="
-            || target == U"*"
-            || target == U"*="
-            || target == U"/"
-            || target == U"/="
-            || target == U"&"
-            || target == U"&="
-            || target == U"|"
-            || target == U"|="
-            || target == U"&&"
-            || target == U"||"
-            || target == U"::"
-            || target == U"<"
-            || target == U"<="
-            || target == U">"
-            || target == U">="
-            || target == U"=="
-            || target == U">>"
-            || target == U">>>"
-            || target == U"<<" // TODO check triple shift operators
-            || target == U"??"
-            || target == U"?."
-            || target == U"?"
-            || target == U":"
-            || target == U"."
-            || target == U"^";
-    }
-
-    /**
-     * Determine if the given operator should be terminated as it is.
-     * @param target target operator
-     * @return true if the operator parsing should terminate
-     */
-    bool NodeParser::shouldOperatorTerminate(UString target) {
-        return target == U"&&"
-            || target == U"||";
-    }
-
-    /**
-     * Test if the given operator is applicable before a value.
-     * @return true if the operator expects a value on its right
-     */
-    bool NodeParser::isLeftOperator(UString target) {
-        return target == U"!"
-            || target == U"++"
-            || target == U"--"
-            || target == U"-";
+    OperatorType NodeParser::peekOperator() {
+        // the tokenizer has already matched the longest operator of the adjacent characters
+        // a >>= 2
+        //   ^^^ a single operator token
+        Token token = peek();
+        if (token.type == TokenType::Colon)
+            return OperatorType::TernaryElse;
+        if (token.type != TokenType::Operator)
+            return OperatorType::None;
+        uint length;
+        OperatorType type = matchOperator(token.value[0], token.value.size() > 1 ? token.value[1] : 0,
+            token.value.size() > 2 ? token.value[2] : 0, length);
+        return length == token.value.size() ? type : OperatorType::None;
     }
 
     /**
-     * Test if the given operator is applicable after a value.
-     * @return true if the operator expects a value on its left
+     * Split the closing angle brackets of nested generic types, that the tokenizer has matched as a shift operator.
      */
-    bool NodeParser::isRightOperator(UString target) {
-        return target == U"++"
-            || target == U"--";
+    void NodeParser::splitGenericEnd() {
+        // Map<UUID, List<Data>>
+        //                     ^^ the ">>" token is split to two '>' tokens
+        if (!has(cursor))
+            return;
+        Token& token = tokens[cursor];
+        if (!token.is(TokenType::Operator) || token.value.size() < 2 || token.value[0] != '>')
+            return;
+        UString rest = token.value.substr(1);
+        token.value = U">";
+        tokens.insert(tokens.begin() + cursor + 1, Token::of(TokenType::Operator, rest));
     }
 
     /**
@@ -2042,6 +2013,34 @@ namespace Compiler {
         return true;
     }
 
+    /**
+     * Test if the identifier at the cursor is a generic type of a local declaration, rather than the left side of a comparison.
+     * @return true if the tokens after the identifier are generic types followed by a name
+     */
+    bool NodeParser::testGenericDeclaration() {
+        // find the closing angle bracket of the generic types
+        // List<Map<String, int>> entries = ...
+        //     ^               ^^ the angle brackets must be balanced, and must only contain types
+        int depth = 0;
+        for (uint i = cursor + 1; has(i); i++) {
+            Token& token = tokens[i];
+            if (token.is(TokenType::Operator, U"<"))
+                depth++;
+            // the nested generic types may be closed by a single ">>" or ">>>" token
+            else if (token.is(TokenType::Operator) && token.value.find_first_not_of(U'>') == UString::npos) {
+                // the generic types are closed, a name must follow them
+                // index < size > other    <- comparison chain, not followed by a name
+                depth -= (int) token.value.size();
+                if (depth <= 0)
+                    return depth == 0 && at(i + 1).is(TokenType::Identifier);
+            }
+            // ignore type names and separators inside the generic types
+            else if (!token.is(5, TokenType::Identifier, TokenType::Type, TokenType::Comma, TokenType::Start, TokenType::Stop))
+                return false;
+        }
+        return false;
+    }
+
     /**
      * Parse the next condition of a condition block, such as if, else if, while.
      * @return new conditional node
@@ -2099,6 +2098,36 @@ namespace Compiler {
         return body;
     }
 
+    /**
+     * Parse the next constant key of a switch case.
+     * @return integer key token
+     */
+    Token NodeParser::parseSwitchKey() {
+        // handle negative key
+        // -1 -> println("none")
+        bool negative = peek().is(TokenType::Operator, U"-");
+        if (negative)
+            get();
+
+        // the keys are converted to decimal integers, so that each key has a single representation
+        Token token = get();
+        long long key = 0;
+        if (token.is(TokenType::Character) && !negative)
+            key = (long long) token.value[0];
+        else if (token.is(TokenType::Hexadecimal))
+            key = std::stoll(Strings::fromUTF(token.value.substr(2)), nullptr, 16);
+        else if (token.is(3, TokenType::Integer, TokenType::Short, TokenType::Byte))
+            key = std::stoll(Strings::fromUTF(token.value));
+        else
+            error("Switch case key must be an integer constant, but got " << token);
+
+        if (negative)
+            key = -key;
+        if (key != (int) key)
+            error("Switch case key " << key << " is out of the integer range.");
+        return Token::of(TokenType::Integer, Strings::toUTF(toString(key)));
+    }
+
     /**
      * Parse the next argument list declaration.
      * @return new argument list
@@ -15,19 +15,6 @@
 #include "../builder/Package.hpp"
 
 namespace Compiler {
-    /**
-     * The map of the operation's precedences and associativities.
-     */
-    static TreeMap<UString, Pair<int, int>> OPERATION_INFO = {
-        {U"+", {1, 0}},
-        {U"-", {1, 0}},
-        {U"*", {2, 0}},
-        {U"/", {2, 0}},
-        {U"%", {2, 0}},
-        {U"^", {3, 1}},
-        {U".", {4, 0}}
-    };
-
     /**
      * Represents a parser that transforms raw tokens to instructions.
      */
@@ -48,11 +35,19 @@ namespace Compiler {
          */
         uint cursor = 0;
 
+        /**
+         * Determine if the parsed declarations should be printed.
+         */
+        bool verbose;
+
     public:
         /**
          * Initialize the token parser.
+         * @param package target package
+         * @param tokens parsed tokens
+         * @param verbose true if the parsed declarations should be printed
          */
-        NodeParser(Package* package, List<Token> tokens);
+        NodeParser(Package* package, List<Token> tokens, bool verbose = true);
 
         /**
          * Parse the next instruction node.
@@ -232,12 +227,6 @@ namespace Compiler {
          */
         Node* nextContent();
 
-        /**
-         * Parse the next expression instruction.
-         * @return new expression
-         */
-        Node* nextExpression(bool ignoreJoin);
-
         /**
          * Parse the next expression instruction.
          * @return new expression
@@ -276,13 +265,13 @@ namespace Compiler {
          * Parse the next literal value or method call declaration.
          * @return new literal or method call
          */
-        Node* nextLiteralOrMethodCall(bool ignoreJoin);
+        Node* nextLiteralOrMethodCall();
 
         /**
          * Parse the next string template declaration.
          * @return new string template 
          */
-        Node* nextStringTemplate(bool ignoreJoin);
+        Node* nextStringTemplate();
 
         /**
          * Parse the next single value operator declaration.
@@ -290,6 +279,26 @@ namespace Compiler {
          */
         Node* nextSingleOperator();
 
+        /**
+         * Parse the next operand of an operation, which is a value that might be prefixed by single value operators.
+         * @return new operand value
+         */
+        Node* nextOperand();
+
+        /**
+         * Parse the next value, that is not followed by an operator.
+         * @return new primary value
+         */
+        Node* nextPrimary();
+
+        /**
+         * Parse the sequence of operators after the given operand, and group the operands by the operator precedences.
+         * @param left first operand of the operation
+         * @param precedence the lowest binding power of the operators to be included
+         * @return new operation or the operand itself if no operators follow
+         */
+        Node* nextOperation(Node* left, int precedence);
+
         /**
          * Parse the next value return statement declaration.
          * @return new return statement
@@ -306,7 +315,7 @@ namespace Compiler {
          * Parse the next group or tuple declaration.
          * @return new group or tuple
          */
-        Node* nextGroupOrTuple(bool ignoreJoin);
+        Node* nextGroupOrTuple();
 
         /**
          * Parse the next if statement declaration.
@@ -337,11 +346,17 @@ namespace Compiler {
          */
         Node* nextDoWhileStatement();
 
+        /**
+         * Parse the next switch statement declaration.
+         * @return new switch statement
+         */
+        Node* nextSwitchStatement();
+
         /**
          * Parse the new statement declaration.
          * @return new "new" statement
          */
-        Node* nextNewStatement(bool ignoreJoin);
+        Node* nextNewStatement();
 
         /**
          * Parse the next structure initializator declaration.
@@ -374,28 +389,6 @@ namespace Compiler {
          */
         ParameterType nextParameterType();
 
-        /**
-         * Check if the first operator has a predecende priority over the second operator.
-         * @param first first operator to check
-         * @param second second operator to check
-         * @return true if the first operator has higher precedence than the second one
-         */
-        bool hasPrecedence(UString first, UString second);
-
-        /**
-         * Fix the order of the operation sequences in the parsed value node.
-         * @param root root value expression node
-         * @return fixed node operations
-         */
-        Node* fixOperationTree(Node* root);
-
-        /**
-         * Parse the next join operation.
-         * @param target fisrt node of join operation
-         * @return new join operation
-         */
-        Node* nextJoinOperation(Node* target);
-
         /**
          * Parse the generic types of a type.
          * @return generic type tokens
@@ -422,35 +415,15 @@ namespace Compiler {
         List<UString> parseModifiers(NodeType type);
 
         /**
-         * Parse the next operator target.
-         * @return parsed operator
-         */
-        UString parseOperator();
-
-        /**
-         * Test if the given operator is applicable for a left-right use.
-         * @return true if the operator expects two values
+         * Resolve the operator at the current index without moving the cursor.
+         * @return operator type or None if there is no operator
          */
-        bool isComplexOperator(UString target);
+        OperatorType peekOperator();
 
         /**
-         * Determine if the given operator should be terminated as it is.
-         * @param target target operator
-         * @return true if the operator parsing should terminate
+         * Split the closing angle brackets of nested generic types, that the tokenizer has matched as a shift operator.
          */
-        bool shouldOperatorTerminate(UString target);
-
-        /**
-         * Test if the given operator is applicable before a value.
-         * @return true if the operator expects a value on its right
-         */
-        bool isLeftOperator(UString target);
-
-        /**
-         * Test if the given operator is applicable after a value.
-         * @return true if the operator expects a value on its left
-         */
-        bool isRightOperator(UString target);
+        void splitGenericEnd();
 
         /**
          * Test if there are variadic arguments declared.
@@ -458,6 +431,12 @@ namespace Compiler {
          */
         bool testVarargs();
 
+        /**
+         * Test if the identifier at the cursor is a generic type of a local declaration, rather than the left side of a comparison.
+         * @return true if the tokens after the identifier are generic types followed by a name
+         */
+        bool testGenericDeclaration();
+
         /**
          * Parse the next condition of a condition block, such as if, else if, while.
          * @return new conditional node
@@ -470,6 +449,12 @@ namespace Compiler {
          */
         List<Node*> parseStatementBody();
 
+        /**
+         * Parse the next constant key of a switch case.
+         * @return integer key token
+         */
+        Token parseSwitchKey();
+
         /**
          * Parse the next argument list declaration.
          * @return new argument list
@@ -0,0 +1,164 @@
+#include "Operator.hpp"
+#include "../token/Token.hpp"
+
+namespace Compiler {
+    /**
+     * Resolve the longest operator that begins with the given operator characters.
+     * @param first first operator character
+     * @param second second operator character, 0 if missing
+     * @param third third operator character, 0 if missing
+     * @param length the count of the characters used by the operator
+     * @return matched operator type or None
+     */
+    OperatorType matchOperator(cint first, cint second, cint third, uint& length) {
+        // most of the operators are single characters,
+        // the multi-character ones override the length when they are matched
+        length = 1;
+        switch (first) {
+            case '=':
+                // handle "==" and "="
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::Equal;
+                }
+                return OperatorType::Assign;
+            case '+':
+                // handle "++", "+=" and "+"
+                if (second == '+') {
+                    length = 2;
+                    return OperatorType::Increment;
+                }
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::AddAssign;
+                }
+                return OperatorType::Add;
+            case '-':
+                // handle "--", "-=" and "-"
+                if (second == '-') {
+                    length = 2;
+                    return OperatorType::Decrement;
+                }
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::SubtractAssign;
+                }
+                return OperatorType::Subtract;
+            case '*':
+                // handle "*=" and "*"
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::MultiplyAssign;
+                }
+                return OperatorType::Multiply;
+            case '/':
+                // handle "/=" and "/"
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::DivideAssign;
+                }
+                return OperatorType::Divide;
+            case '%':
+                // handle "%=" and "%"
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::ModuloAssign;
+                }
+                return OperatorType::Modulo;
+            case '^':
+                // handle "^=" and "^"
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::PowerAssign;
+                }
+                return OperatorType::Power;
+            case '!':
+                // handle "!=" and "!"
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::NotEqual;
+                }
+                return OperatorType::Not;
+            case '~':
+                return OperatorType::Complement;
+            case '&':
+                // handle "&&", "&=" and "&"
+                if (second == '&') {
+                    length = 2;
+                    return OperatorType::And;
+                }
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::AndAssign;
+                }
+                return OperatorType::BitwiseAnd;
+            case '|':
+                // handle "||", "|=" and "|"
+                if (second == '|') {
+                    length = 2;
+                    return OperatorType::Or;
+                }
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::OrAssign;
+                }
+                return OperatorType::BitwiseOr;
+            case '<':
+                // handle "<<=", "<<", "<=" and "<"
+                if (second == '<') {
+                    length = third == '=' ? 3 : 2;
+                    return third == '=' ? OperatorType::ShiftLeftAssign : OperatorType::ShiftLeft;
+                }
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::LessEqual;
+                }
+                return OperatorType::Less;
+            case '>':
+                // handle ">>>", ">>=", ">>", ">=" and ">"
+                if (second == '>') {
+                    if (third == '>') {
+                        length = 3;
+                        return OperatorType::UnsignedShiftRight;
+                    }
+                    length = third == '=' ? 3 : 2;
+                    return third == '=' ? OperatorType::ShiftRightAssign : OperatorType::ShiftRight;
+                }
+                if (second == '=') {
+                    length = 2;
+                    return OperatorType::GreaterEqual;
+                }
+                return OperatorType::Greater;
+            case '?':
+                // handle "??", "?." and "?"
+                if (second == '?') {
+                    length = 2;
+                    return OperatorType::Coalesce;
+                }
+                if (second == '.') {
+                    length = 2;
+                    return OperatorType::SafeMember;
+                }
+                return OperatorType::Ternary;
+            case ':':
+                // handle "::" and ":"
+                if (second == ':') {
+                    length = 2;
+                    return OperatorType::Scope;
+                }
+                return OperatorType::TernaryElse;
+            case '.':
+                return OperatorType::Member;
+        }
+        // the character is not an operator
+        length = 0;
+        return OperatorType::None;
+    }
+
+    /**
+     * Make the operator type printable to the output stream.
+     */
+    OutputStream& operator<<(OutputStream& stream, OperatorType& type) {
+        return stream << UString(getOperatorInfo(type).symbol);
+    }
+}
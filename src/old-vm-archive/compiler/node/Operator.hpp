@@ -0,0 +1,178 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Compiler {
+    /**
+     * Represents a registry of the expression operators.
+     * The order of the operators must match the order of the OPERATOR_TABLE entries.
+     */
+    enum class OperatorType {
+        None,
+        Assign,             // =
+        AddAssign,          // +=
+        SubtractAssign,     // -=
+        MultiplyAssign,     // *=
+        DivideAssign,       // /=
+        ModuloAssign,       // %=
+        PowerAssign,        // ^=
+        AndAssign,          // &=
+        OrAssign,           // |=
+        ShiftLeftAssign,    // <<=
+        ShiftRightAssign,   // >>=
+        Ternary,            // ?
+        TernaryElse,        // :
+        Coalesce,           // ??
+        Or,                 // ||
+        And,                // &&
+        BitwiseOr,          // |
+        BitwiseAnd,         // &
+        Equal,              // ==
+        NotEqual,           // !=
+        Less,               // <
+        LessEqual,          // <=
+        Greater,            // >
+        GreaterEqual,       // >=
+        ShiftLeft,          // <<
+        ShiftRight,         // >>
+        UnsignedShiftRight, // >>>
+        Add,                // +
+        Subtract,           // -
+        Multiply,           // *
+        Divide,             // /
+        Modulo,             // %
+        Power,              // ^
+        Not,                // !
+        Complement,         // ~
+        Increment,          // ++
+        Decrement,          // --
+        Member,             // .
+        SafeMember,         // ?.
+        Scope               // ::
+    };
+
+    /**
+     * The count of the registered operators.
+     */
+    static const int OPERATOR_COUNT = 41;
+
+    /**
+     * The binding power of the lowest precedence operation. Expressions are parsed from this level.
+     */
+    static const int PRECEDENCE_LOWEST = 1;
+
+    /**
+     * The binding power of the operand of a left-side single value operator.
+     */
+    static const int PRECEDENCE_PREFIX = 14;
+
+    /**
+     * Represents the parsing attributes of an expression operator.
+     */
+    struct OperatorInfo {
+        /**
+         * The source code representation of the operator.
+         */
+        const char32_t* symbol;
+
+        /**
+         * The binding power of the operator after an operand, 0 if the operator cannot follow an operand.
+         */
+        int precedence;
+
+        /**
+         * Determine if the operator groups from right to left.
+         */
+        bool rightAssociative;
+
+        /**
+         * Determine if the operator is applicable before a value.
+         */
+        bool prefix;
+
+        /**
+         * Determine if the operator is applicable after a value, without a second operand.
+         */
+        bool postfix;
+    };
+
+    /**
+     * The flat table of the operator attributes indexed by the operator type.
+     */
+    static const OperatorInfo OPERATOR_TABLE[OPERATOR_COUNT] = {
+        { U"",    0,  false, false, false }, // None
+        { U"=",   1,  true,  false, false }, // Assign
+        { U"+=",  1,  true,  false, false }, // AddAssign
+        { U"-=",  1,  true,  false, false }, // SubtractAssign
+        { U"*=",  1,  true,  false, false }, // MultiplyAssign
+        { U"/=",  1,  true,  false, false }, // DivideAssign
+        { U"%=",  1,  true,  false, false }, // ModuloAssign
+        { U"^=",  1,  true,  false, false }, // PowerAssign
+        { U"&=",  1,  true,  false, false }, // AndAssign
+        { U"|=",  1,  true,  false, false }, // OrAssign
+        { U"<<=", 1,  true,  false, false }, // ShiftLeftAssign
+        { U">>=", 1,  true,  false, false }, // ShiftRightAssign
+        { U"?",   2,  true,  false, false }, // Ternary
+        { U":",   0,  false, false, false }, // TernaryElse
+        { U"??",  3,  true,  false, false }, // Coalesce
+        { U"||",  4,  false, false, false }, // Or
+        { U"&&",  5,  false, false, false }, // And
+        { U"|",   6,  false, false, false }, // BitwiseOr
+        { U"&",   7,  false, false, false }, // BitwiseAnd
+        { U"==",  8,  false, false, false }, // Equal
+        { U"!=",  8,  false, false, false }, // NotEqual
+        { U"<",   9,  false, false, false }, // Less
+        { U"<=",  9,  false, false, false }, // LessEqual
+        { U">",   9,  false, false, false }, // Greater
+        { U">=",  9,  false, false, false }, // GreaterEqual
+        { U"<<",  10, false, false, false }, // ShiftLeft
+        { U">>",  10, false, false, false }, // ShiftRight
+        { U">>>", 10, false, false, false }, // UnsignedShiftRight
+        { U"+",   11, false, true,  false }, // Add
+        { U"-",   11, false, true,  false }, // Subtract
+        { U"*",   12, false, false, false }, // Multiply
+        { U"/",   12, false, false, false }, // Divide
+        { U"%",   12, false, false, false }, // Modulo
+        { U"^",   15, true,  false, false }, // Power
+        { U"!",   0,  false, true,  false }, // Not
+        { U"~",   0,  false, true,  false }, // Complement
+        { U"++",  16, false, true,  true  }, // Increment
+        { U"--",  16, false, true,  true  }, // Decrement
+        { U".",   16, false, false, false }, // Member
+        { U"?.",  16, false, false, false }, // SafeMember
+        { U"::",  16, false, false, false }  // Scope
+    };
+
+    /**
+     * Get the parsing attributes of the given operator.
+     * @param type target operator type
+     * @return operator table entry
+     */
+    inline const OperatorInfo& getOperatorInfo(OperatorType type) {
+        return OPERATOR_TABLE[static_cast<int>(type)];
+    }
+
+    /**
+     * Determine if the given operator assigns a local variable.
+     * @param operatorType target operator
+     * @return true if the operator is an assignment
+     */
+    inline bool isAssignment(OperatorType operatorType) {
+        return operatorType >= OperatorType::Assign && operatorType <= OperatorType::ShiftRightAssign;
+    }
+
+    /**
+     * Resolve the longest operator that begins with the given operator characters.
+     * @param first first operator character
+     * @param second second operator character, 0 if missing
+     * @param third third operator character, 0 if missing
+     * @param length the count of the characters used by the operator
+     * @return matched operator type or None
+     */
+    OperatorType matchOperator(cint first, cint second, cint third, uint& length);
+
+    /**
+     * Make the operator type printable to the output stream.
+     */
+    OutputStream& operator<<(OutputStream& stream, OperatorType& type);
+}
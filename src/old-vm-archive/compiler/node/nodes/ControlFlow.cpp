@@ -217,4 +217,51 @@ namespace Compiler {
         println(Strings::fill(index, "    ") << "}");
         index--;
     }
+
+    SwitchCase::SwitchCase(List<Token> keys, List<Node*> body)
+        : keys(keys), body(body)
+    { }
+
+    Switch::Switch(Package* package, Node* value)
+        : Node(NodeType::Switch, package), value(value)
+    { }
+
+    /**
+     * Debug the content of the parsed node.
+     */
+    void Switch::debug(uint& index) {
+        index++;
+        println("Switch {");
+
+        print(Strings::fill(index + 1, "    ") << "value: ");
+        value->debug(index);
+        if (value->type == NodeType::Value || value->type == NodeType::Template)
+            println("");
+
+        List<SwitchCase*> all = cases;
+        if (defaultCase != nullptr)
+            all.push_back(defaultCase);
+        for (SwitchCase* switchCase : all) {
+            // 400 | 401 -> { }
+            print(Strings::fill(index + 1, "    "));
+            if (switchCase == defaultCase)
+                print("default");
+            for (uint i = 0; i < switchCase->keys.size(); i++)
+                print((i == 0 ? "" : " | ") << switchCase->keys[i].value);
+            println(" -> {");
+            for (uint i = 0; i < switchCase->body.size(); i++) {
+                print(Strings::fill(index + 2, "    "));
+                auto element = switchCase->body[i];
+                index++;
+                element->debug(index);
+                index--;
+                if (element->type == NodeType::Value || element->type == NodeType::Template)
+                    println("");
+            }
+            println(Strings::fill(index + 1, "    ") << "}");
+        }
+
+        println(Strings::fill(index, "    ") << "}");
+        index--;
+    }
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "MethodNode.hpp"
 
 #include "../../../util/Strings.hpp"
+#include "../../builder/MethodBuilder.hpp"
+#include "../../ir/PassManager.hpp"
 using namespace Void;
 
 namespace Compiler {
@@ -8,63 +10,78 @@ namespace Compiler {
         : Modifiable(NodeType::Method, package), returnTypes(returnTypes), name(name), parameters(parameters), body(body)
     { }
 
+    /**
+     * Determine if the method is implemented by the virtual machine, instead of its bytecode.
+     * @return true if the method is native or extern
+     */
+    bool MethodNode::isExternal() {
+        return contains(modifiers, U"native") || contains(modifiers, U"extern");
+    }
+
+    /**
+     * Debug the content of the parsed node.
+     */
+    void MethodNode::debug(uint& index) {
+        print(name << "(");
+        for (uint i = 0; i < parameters.size(); i++) {
+            print(parameters[i].type.value << " " << parameters[i].name);
+            if (i < parameters.size() - 1)
+                print(", ");
+        }
+        println(") {");
+
+        for (Node* element : body) {
+            print(Strings::fill(index + 1, "    "));
+            element->debug(index);
+            if (element->type == NodeType::Value || element->type == NodeType::Template)
+                println("");
+        }
+
+        println(Strings::fill(index, "    ") << "}");
+    }
+
     /**
      * Build bytecode for this node.
      * @param bytecode result bytecode list
      */
     void MethodNode::build(List<UString>& bytecode) {
+        build(bytecode, nullptr);
+    }
+
+    /**
+     * Build bytecode for this node, generating the method body through the intermediate representation.
+     * @param bytecode result bytecode list
+     * @param passes the pass manager of the intermediate representation, or null to build the nodes directly
+     */
+    void MethodNode::build(List<UString>& bytecode, PassManager* passes) {
         bytecode.push_back(U"    mdef " + name);
         if (!modifiers.empty())
             bytecode.push_back(U"    mmod " + Strings::join(modifiers, U" "));
-        // TODO make an universal type parser for parameters & return type
         if (!parameters.empty()) {
             UString params;
             for (uint i = 0; i < parameters.size(); i++) {
-                params += parameters[i].type.value;
+                params += MethodBuilder::getDescriptor(Node::package, parameters[i].type);
                 if (i < parameters.size() - 1)
                     params += U" ";
             }
             bytecode.push_back(U"    mparam " + params);
         }
-        bytecode.push_back(U"    mreturn " + parseReturnType());
+        bytecode.push_back(U"    mreturn " + MethodBuilder::getReturnDescriptor(this));
         bytecode.push_back(U"    mbegin");
+        // the native and extern methods are bound to their implementation when the virtual machine links them
+        if (!defined) {
+            if (!isExternal())
+                error("Method '" << name << "' must have a body, unless it is native or extern.");
+        }
+        else if (passes != nullptr)
+            passes->compile(Node::package, this, bytecode);
+        else {
+            MethodBuilder builder(Node::package, this);
+            builder.build(bytecode);
+        }
         bytecode.push_back(U"    mend");
     }
 
-    /**
-     * Parse the return type of the method.
-     */
-    UString MethodNode::parseReturnType() {
-        // TODO handle tuple return type
-        if (returnTypes.size() > 1)
-            // TODO return void for now
-            return U"V";
-
-        Token type = returnTypes[0].types[0];
-        UString value = type.value;
-        if (value == U"void")
-            return U"V";
-        else if (value == U"byte")
-            return U"B";
-        else if (value == U"short")
-            return U"S";
-        else if (value == U"int")
-            return U"I";
-        else if (value == U"long")
-            return U"J";
-        else if (value == U"float")
-            return U"F";
-        else if (value == U"double")
-            return U"D";
-        else if (value == U"bool")
-            return U"Z";
-        // TODO try to resolve identifier type
-        else
-            error("Unknown return type: '" << type << "'.");
-            
-        return U"V";
-    }
-
     Parameter::Parameter(Token type, List<Token> generics, bool varargs, UString name)
         : type(type), generics(generics), varargs(varargs), name(name)
     { }
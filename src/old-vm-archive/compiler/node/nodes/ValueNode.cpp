@@ -1,6 +1,7 @@
 #include "ValueNode.hpp"
 
 #include "../../../util/Strings.hpp"
+#include "../../builder/MethodBuilder.hpp"
 using namespace Void;
 
 namespace Compiler {
@@ -26,17 +27,19 @@ namespace Compiler {
      * @param bytecode result bytecode list
      */
     void Value::build(List<UString>& bytecode) {
-
+        MethodBuilder builder(package);
+        builder.buildValue(this, bytecode);
     }
 
     /**
      * Initialize the operation.
      * @param left first expression
-     * @param target target operator
+     * @param operatorType target operator
      * @param right second expression
      */
-    Operation::Operation(Package* package, Node* left, UString target, Node* right)
-        : Node(NodeType::Operation, package), left(left), target(target), right(right)
+    Operation::Operation(Package* package, Node* left, OperatorType operatorType, Node* right)
+        : Node(NodeType::Operation, package), left(left), target(getOperatorInfo(operatorType).symbol), 
+          operatorType(operatorType), right(right)
     { }
 
     /**
@@ -44,6 +47,8 @@ namespace Compiler {
      * @param bytecode result bytecode list
      */
     void Operation::build(List<UString>& bytecode) {
+        MethodBuilder builder(package);
+        builder.buildValue(this, bytecode);
     }
 
     /**
@@ -105,8 +110,9 @@ namespace Compiler {
         index--;
     }
 
-    SideOperation::SideOperation(Package* package, UString target, Node* operand, bool left)
-        : Node(NodeType::SideOperation, package), target(target), operand(operand), left(left)
+    SideOperation::SideOperation(Package* package, OperatorType operatorType, Node* operand, bool left)
+        : Node(NodeType::SideOperation, package), target(getOperatorInfo(operatorType).symbol), 
+          operatorType(operatorType), operand(operand), left(left)
     { }
 
     /**
@@ -154,6 +160,8 @@ namespace Compiler {
      * @param bytecode result bytecode list
      */
     void Group::build(List<UString>& bytecode) {
+        MethodBuilder builder(package);
+        builder.buildValue(value, bytecode);
     }
 
     Template::Template(Package* package, Token value)
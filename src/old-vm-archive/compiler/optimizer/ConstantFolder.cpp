@@ -0,0 +1,793 @@
+#include "ConstantFolder.hpp"
+#include "NodeWalker.hpp"
+
+#include "../../util/Strings.hpp"
+
+#include <cmath>
+#include <climits>
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the constant type of the given token. Booleans use the Z descriptor.
+     * @param token target token
+     * @return constant type descriptor, or 0 if the token is not a constant
+     */
+    static char getConstantType(Token& token) {
+        switch (token.type) {
+            case TokenType::Integer:
+            case TokenType::Hexadecimal:
+            case TokenType::Byte:
+            case TokenType::Short:
+            case TokenType::Character:
+                return 'I';
+            case TokenType::Long:
+                return 'J';
+            case TokenType::Float:
+                return 'F';
+            case TokenType::Double:
+                return 'D';
+            case TokenType::Boolean:
+                return 'Z';
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Get the constant type of a declared local variable type.
+     * @param type variable type token
+     * @return constant type descriptor, or 0 if the type cannot hold a constant
+     */
+    static char getDeclaredType(Token& type) {
+        if (!type.is(TokenType::Type))
+            return 0;
+        UString value = type.value;
+        if (value == U"int" || value == U"byte" || value == U"short" || value == U"char")
+            return 'I';
+        else if (value == U"long")
+            return 'J';
+        else if (value == U"float")
+            return 'F';
+        else if (value == U"double")
+            return 'D';
+        else if (value == U"bool")
+            return 'Z';
+        return 0;
+    }
+
+    /**
+     * Get the conversion rank of the given numeric constant type.
+     * @param type constant type descriptor
+     * @return type rank
+     */
+    static int getRank(char type) {
+        switch (type) {
+            case 'I':
+                return 0;
+            case 'J':
+                return 1;
+            case 'F':
+                return 2;
+            default:
+                return 3;
+        }
+    }
+
+    /**
+     * Get the integer value of an integral constant.
+     * @param token constant token
+     * @return integer value
+     */
+    static long long getInteger(Token& token) {
+        if (token.is(TokenType::Character))
+            return (long long) token.value[0];
+        else if (token.is(TokenType::Hexadecimal))
+            return std::stoll(Strings::fromUTF(token.value.substr(2)), nullptr, 16);
+        return std::stoll(Strings::fromUTF(token.value));
+    }
+
+    /**
+     * Get the floating point value of a numeric constant.
+     * @param token constant token
+     * @return floating point value
+     */
+    static double getReal(Token& token) {
+        char type = getConstantType(token);
+        if (type == 'I' || type == 'J')
+            return (double) getInteger(token);
+        return std::stod(Strings::fromUTF(token.value));
+    }
+
+    /**
+     * Create a constant token of an integral value. Integers overflow the same way as in the virtual machine.
+     * @param type constant type descriptor
+     * @param value integer value
+     * @return constant token
+     */
+    static Token createInteger(char type, long long value) {
+        if (type == 'I')
+            return Token::of(TokenType::Integer, Strings::toUTF(toString((int) value)));
+        return Token::of(TokenType::Long, Strings::toUTF(toString(value)));
+    }
+
+    /**
+     * Create a constant token of a floating point value. The value is written with enough digits to be read back exactly.
+     * @param type constant type descriptor
+     * @param value floating point value
+     * @return constant token
+     */
+    static Token createReal(char type, double value) {
+        std::ostringstream stream;
+        if (type == 'F')
+            stream << std::setprecision(9) << (float) value;
+        else
+            stream << std::setprecision(17) << value;
+        return Token::of(type == 'F' ? TokenType::Float : TokenType::Double, Strings::toUTF(stream.str()));
+    }
+
+    /**
+     * Create a boolean constant token.
+     * @param value boolean value
+     * @return constant token
+     */
+    static Token createBoolean(bool value) {
+        return Token::of(TokenType::Boolean, value ? U"true" : U"false");
+    }
+
+    /**
+     * Convert a constant to the given type.
+     * @param token constant token
+     * @param type target type descriptor
+     * @return converted constant token
+     */
+    static Token convert(Token& token, char type) {
+        if (getConstantType(token) == type && !token.is(TokenType::Character) && !token.is(TokenType::Hexadecimal))
+            return token;
+        if (type == 'I' || type == 'J')
+            return createInteger(type, getInteger(token));
+        return createReal(type, getReal(token));
+    }
+
+    /**
+     * Determine if the given node is a constant value.
+     * @param node target node
+     * @return true if the node is a literal constant
+     */
+    static bool isConstant(Node* node) {
+        return node->is(NodeType::Value) && getConstantType(as(node, Value)->value) != 0;
+    }
+
+    /**
+     * Determine if the given node is a boolean constant of the given value.
+     * @param node target node
+     * @param value expected boolean value
+     * @return true if the node is the expected boolean constant
+     */
+    static bool isBoolean(Node* node, bool value) {
+        return node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::Boolean, value ? U"true" : U"false");
+    }
+
+    /**
+     * Determine if the statements declare a local variable directly in the block.
+     * @param body block statements
+     * @return true if a local variable is declared
+     */
+    static bool declaresLocals(List<Node*>& body) {
+        for (Node* node : body) {
+            if (node->is(NodeType::LocalDeclare) || node->is(NodeType::MultiLocalDeclare)
+                    || node->is(NodeType::LocalDeclareAssign) || node->is(NodeType::LocalDeclareDestructure))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Calculate the result of an operation of two integral constants.
+     * @param operatorType operation operator
+     * @param type operation type descriptor
+     * @param left first operand
+     * @param right second operand
+     * @param result calculated constant
+     * @return true if the operation could be calculated at compile time
+     */
+    static bool calculateInteger(OperatorType operatorType, char type, long long left, long long right, Token& result) {
+        // the operations are performed on unsigned values, so that overflows wrap around instead of being undefined
+        unsigned long long a = (unsigned long long) left;
+        unsigned long long b = (unsigned long long) right;
+        int bits = type == 'I' ? 31 : 63;
+        switch (operatorType) {
+            case OperatorType::Add:
+                result = createInteger(type, (long long) (a + b));
+                return true;
+            case OperatorType::Subtract:
+                result = createInteger(type, (long long) (a - b));
+                return true;
+            case OperatorType::Multiply:
+                result = createInteger(type, (long long) (a * b));
+                return true;
+            case OperatorType::Divide:
+            case OperatorType::Modulo:
+                // leave the division by zero to the runtime
+                if (right == 0 || (type == 'J' && left == LLONG_MIN && right == -1))
+                    return false;
+                if (type == 'I') {
+                    left = (int) left;
+                    right = (int) right;
+                }
+                result = createInteger(type, operatorType == OperatorType::Divide ? left / right : left % right);
+                return true;
+            case OperatorType::BitwiseAnd:
+                result = createInteger(type, (long long) (a & b));
+                return true;
+            case OperatorType::BitwiseOr:
+                result = createInteger(type, (long long) (a | b));
+                return true;
+            case OperatorType::ShiftLeft:
+                result = createInteger(type, (long long) (a << (right & bits)));
+                return true;
+            case OperatorType::ShiftRight:
+                result = createInteger(type, (type == 'I' ? (int) left : left) >> (right & bits));
+                return true;
+            case OperatorType::Equal:
+                result = createBoolean(left == right);
+                return true;
+            case OperatorType::NotEqual:
+                result = createBoolean(left != right);
+                return true;
+            case OperatorType::Less:
+                result = createBoolean(left < right);
+                return true;
+            case OperatorType::LessEqual:
+                result = createBoolean(left <= right);
+                return true;
+            case OperatorType::Greater:
+                result = createBoolean(left > right);
+                return true;
+            case OperatorType::GreaterEqual:
+                result = createBoolean(left >= right);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Calculate the result of an operation of two floating point constants.
+     * @param operatorType operation operator
+     * @param type operation type descriptor
+     * @param left first operand
+     * @param right second operand
+     * @param result calculated constant
+     * @return true if the operation could be calculated at compile time
+     */
+    static bool calculateReal(OperatorType operatorType, char type, double left, double right, Token& result) {
+        // calculate the float operations in single precision, as the virtual machine would
+        if (type == 'F') {
+            left = (float) left;
+            right = (float) right;
+        }
+        double value;
+        switch (operatorType) {
+            case OperatorType::Add:
+                value = left + right;
+                break;
+            case OperatorType::Subtract:
+                value = left - right;
+                break;
+            case OperatorType::Multiply:
+                value = left * right;
+                break;
+            case OperatorType::Divide:
+                value = left / right;
+                break;
+            case OperatorType::Modulo:
+                value = std::fmod(left, right);
+                break;
+            case OperatorType::Equal:
+                result = createBoolean(left == right);
+                return true;
+            case OperatorType::NotEqual:
+                result = createBoolean(left != right);
+                return true;
+            case OperatorType::Less:
+                result = createBoolean(left < right);
+                return true;
+            case OperatorType::LessEqual:
+                result = createBoolean(left <= right);
+                return true;
+            case OperatorType::Greater:
+                result = createBoolean(left > right);
+                return true;
+            case OperatorType::GreaterEqual:
+                result = createBoolean(left >= right);
+                return true;
+            default:
+                return false;
+        }
+        if (type == 'F')
+            value = (float) value;
+        // infinity and not-a-number do not have a literal representation
+        if (!std::isfinite(value))
+            return false;
+        result = createReal(type, value);
+        return true;
+    }
+
+    /**
+     * Initialize the constant folder.
+     * @param package optimized package
+     */
+    ConstantFolder::ConstantFolder(Package* package)
+        : package(package)
+    { }
+
+    /**
+     * Fold the constant expressions of all the methods of the package.
+     */
+    void ConstantFolder::fold() {
+        for (MethodNode* method : package->methods)
+            foldMethod(method);
+    }
+
+    /**
+     * Fold the constant expressions of a method body.
+     * @param method target method
+     */
+    void ConstantFolder::foldMethod(MethodNode* method) {
+        declarations.clear();
+        assigned.clear();
+        scopes.clear();
+
+        // the parameters are never constants, but they can be shadowed by the locals
+        for (Parameter& parameter : method->parameters)
+            declarations[parameter.name] += 2;
+
+        // find the local variables that are declared once and never assigned afterwards
+        scan(method->body);
+        foldBlock(method->body);
+    }
+
+    /**
+     * Collect the local variable declarations and assignments of the given statements.
+     * @param body target statements
+     */
+    void ConstantFolder::scan(List<Node*>& body) {
+        NodeWalker::walk(body, [&](Node* node) {
+            switch (node->type) {
+                case NodeType::LocalDeclare:
+                    declarations[as(node, LocalDeclare)->name]++;
+                    break;
+                case NodeType::MultiLocalDeclare:
+                    for (auto& [name, _] : as(node, MultiLocalDeclare)->locals)
+                        declarations[name]++;
+                    break;
+                case NodeType::LocalDeclareAssign:
+                    declarations[as(node, LocalDeclareAssign)->name]++;
+                    break;
+                case NodeType::LocalDeclareDestructure:
+                    for (UString& name : as(node, LocalDeclareDestructure)->members)
+                        declarations[name]++;
+                    break;
+                case NodeType::LocalAssign:
+                    assigned.push_back(as(node, LocalAssign)->name);
+                    break;
+                case NodeType::Operation:
+                    if (isAssignment(as(node, Operation)->operatorType))
+                        assigned.push_back(NodeWalker::getLocalName(as(node, Operation)->left));
+                    break;
+                case NodeType::SideOperation: {
+                    SideOperation* operation = as(node, SideOperation);
+                    if (operation->operatorType == OperatorType::Increment || operation->operatorType == OperatorType::Decrement)
+                        assigned.push_back(NodeWalker::getLocalName(operation->operand));
+                    break;
+                }
+                default:
+                    break;
+            }
+        });
+    }
+
+    /**
+     * Fold the statements of a block in a new scope.
+     * @param body block statements
+     */
+    void ConstantFolder::foldBlock(List<Node*>& body) {
+        scopes.push_back({});
+        List<Node*> result;
+        for (Node* node : body)
+            foldStatement(node, result);
+        body = result;
+        scopes.pop_back();
+    }
+
+    /**
+     * Fold a single statement and append the resulting statements to the block.
+     * @param node target statement
+     * @param result folded block statements
+     */
+    void ConstantFolder::foldStatement(Node* node, List<Node*>& result) {
+        switch (node->type) {
+            // int a = 2
+            case NodeType::LocalDeclareAssign: {
+                LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                local->value = foldLocal(local->type, local->name, local->value);
+                break;
+            }
+            // int a, b = 2
+            case NodeType::MultiLocalDeclare: {
+                MultiLocalDeclare* locals = as(node, MultiLocalDeclare);
+                for (auto& [name, value] : locals->locals) {
+                    if (value.has_value())
+                        value = foldLocal(locals->type, name, *value);
+                }
+                break;
+            }
+            // a = 2 + 3
+            case NodeType::LocalAssign:
+                as(node, LocalAssign)->value = foldValue(as(node, LocalAssign)->value);
+                break;
+            case NodeType::Return: {
+                Return* statement = as(node, Return);
+                if (statement->value.has_value())
+                    statement->value = foldValue(*statement->value);
+                break;
+            }
+            case NodeType::Defer:
+                as(node, Defer)->instruction = foldValue(as(node, Defer)->instruction);
+                break;
+            case NodeType::If:
+                foldIf(as(node, If), result);
+                return;
+            case NodeType::Switch:
+                foldSwitch(as(node, Switch), result);
+                return;
+            case NodeType::While: {
+                While* statement = as(node, While);
+                statement->condition = foldValue(statement->condition);
+                foldBlock(statement->body);
+                break;
+            }
+            case NodeType::DoWhile: {
+                DoWhile* statement = as(node, DoWhile);
+                foldBlock(statement->body);
+                statement->condition = foldValue(statement->condition);
+                break;
+            }
+            case NodeType::Operation:
+            case NodeType::SideOperation:
+            case NodeType::Group:
+            case NodeType::MethodCall:
+                node = foldValue(node);
+                // an expression statement without side effects does not have to be executed
+                if (isConstant(node))
+                    return;
+                break;
+            default:
+                break;
+        }
+        result.push_back(node);
+    }
+
+    /**
+     * Fold a local variable declaration and register its value if the variable is constant.
+     * @param type variable type
+     * @param name variable name
+     * @param value initial value of the variable
+     * @return folded initial value
+     */
+    Node* ConstantFolder::foldLocal(Token type, UString name, Node* value) {
+        value = foldValue(value);
+
+        // only the variables that are never assigned again keep their initial value
+        if (!isConstant(value) || declarations[name] != 1 || contains(assigned, name))
+            return value;
+
+        // let a = 2L
+        Token token = as(value, Value)->value;
+        char valueType = getConstantType(token);
+        char declared = type.is(TokenType::Type, U"let") ? valueType : getDeclaredType(type);
+        if (declared == 0)
+            return value;
+
+        // the constant is stored as the declared type, so that the reads of the variable keep their type
+        if (declared == 'Z' || valueType == 'Z') {
+            if (declared != valueType)
+                return value;
+        }
+        else if (getRank(valueType) > getRank(declared))
+            return value;
+        scopes.back().insert_or_assign(name, convert(token, declared));
+        return value;
+    }
+
+    /**
+     * Fold an if statement and remove the cases that are never executed.
+     * @param statement target if statement
+     * @param result folded block statements
+     */
+    void ConstantFolder::foldIf(If* statement, List<Node*>& result) {
+        // collect the conditional cases of the statement in order
+        List<Node*> conditions = { statement->condition };
+        List<List<Node*>> bodies = { statement->body };
+        for (ElseIf* elseIf : statement->elseIfs) {
+            conditions.push_back(elseIf->condition);
+            bodies.push_back(elseIf->body);
+        }
+
+        // the else case is the one that is executed if no other case matches
+        bool hasElse = statement->elseCase != nullptr;
+        List<Node*> elseBody = hasElse ? statement->elseCase->body : List<Node*>();
+
+        bool promoted = false;
+
+        List<Node*> keptConditions;
+        List<List<Node*>> keptBodies;
+        for (uint i = 0; i < conditions.size(); i++) {
+            Node* condition = foldValue(conditions[i]);
+            // if (false) { }
+            if (isBoolean(condition, false)) {
+                branches++;
+                continue;
+            }
+            foldBlock(bodies[i]);
+            // else if (true) { }
+            // the case is executed unconditionally, therefore the following cases are never reached
+            if (isBoolean(condition, true)) {
+                branches += (uint) (conditions.size() - i - 1) + hasElse;
+                elseBody = bodies[i];
+                hasElse = true;
+                promoted = true;
+                break;
+            }
+            keptConditions.push_back(condition);
+            keptBodies.push_back(bodies[i]);
+        }
+        if (hasElse && !promoted)
+            foldBlock(elseBody);
+
+        // every condition is constant, only the executed case remains
+        if (keptConditions.empty()) {
+            if (!hasElse || elseBody.empty())
+                return;
+            // the statements of the case can be moved to the enclosing block, unless they declare variables
+            // that could collide with the variables of the enclosing block
+            if (!declaresLocals(elseBody)) {
+                result.insert(result.end(), elseBody.begin(), elseBody.end());
+                return;
+            }
+            result.push_back(new If(package, constant(createBoolean(true)), elseBody));
+            return;
+        }
+
+        // rebuild the statement of the remaining cases
+        If* simplified = new If(package, keptConditions[0], keptBodies[0]);
+        for (uint i = 1; i < keptConditions.size(); i++)
+            simplified->elseIfs.push_back(new ElseIf(package, keptConditions[i], keptBodies[i]));
+        if (hasElse)
+            simplified->elseCase = new Else(package, elseBody);
+        result.push_back(simplified);
+    }
+
+    /**
+     * Fold a switch statement and keep only the executed case, if the switched value is constant.
+     * @param statement target switch statement
+     * @param result folded block statements
+     */
+    void ConstantFolder::foldSwitch(Switch* statement, List<Node*>& result) {
+        statement->value = foldValue(statement->value);
+
+        // the cases of a variable value are kept
+        if (!isConstant(statement->value) || getConstantType(as(statement->value, Value)->value) != 'I') {
+            for (SwitchCase* switchCase : statement->cases)
+                foldBlock(switchCase->body);
+            if (statement->defaultCase != nullptr)
+                foldBlock(statement->defaultCase->body);
+            result.push_back(statement);
+            return;
+        }
+
+        // switch (2) { 1 -> foo() 2 -> bar() }
+        // the case of the constant value is executed unconditionally, the other cases are never reached
+        long long key = getInteger(as(statement->value, Value)->value);
+        SwitchCase* matched = statement->defaultCase;
+        for (SwitchCase* switchCase : statement->cases) {
+            for (Token& caseKey : switchCase->keys) {
+                if (getInteger(caseKey) == key)
+                    matched = switchCase;
+            }
+        }
+        branches += (uint) statement->cases.size() + (statement->defaultCase != nullptr) - (matched != nullptr);
+        if (matched == nullptr)
+            return;
+
+        foldBlock(matched->body);
+        if (matched->body.empty())
+            return;
+        // the statements of the case can be moved to the enclosing block, unless they declare variables
+        // that could collide with the variables of the enclosing block
+        if (!declaresLocals(matched->body)) {
+            result.insert(result.end(), matched->body.begin(), matched->body.end());
+            return;
+        }
+        result.push_back(new If(package, constant(createBoolean(true)), matched->body));
+    }
+
+    /**
+     * Fold an expression.
+     * @param node target expression
+     * @return folded expression
+     */
+    Node* ConstantFolder::foldValue(Node* node) {
+        switch (node->type) {
+            // a
+            case NodeType::Value: {
+                Token value = Token::of(TokenType::None);
+                Token token = as(node, Value)->value;
+                if (token.is(TokenType::Identifier) && lookup(token.value, value)) {
+                    propagated++;
+                    return constant(value);
+                }
+                return node;
+            }
+            // (a + b)
+            case NodeType::Group: {
+                Group* group = as(node, Group);
+                group->value = foldValue(group->value);
+                // the grouping is not needed anymore, if the operation has been folded
+                if (group->value->is(NodeType::Value))
+                    return group->value;
+                return group;
+            }
+            case NodeType::Operation:
+                return foldOperation(as(node, Operation));
+            case NodeType::SideOperation:
+                return foldSideOperation(as(node, SideOperation));
+            case NodeType::LocalAssign:
+                as(node, LocalAssign)->value = foldValue(as(node, LocalAssign)->value);
+                return node;
+            case NodeType::MethodCall:
+                for (Node*& argument : as(node, MethodCall)->arguments)
+                    argument = foldValue(argument);
+                return node;
+            default:
+                return node;
+        }
+    }
+
+    /**
+     * Fold an operation of two expressions.
+     * @param node target operation
+     * @return folded expression
+     */
+    Node* ConstantFolder::foldOperation(Operation* node) {
+        OperatorType operatorType = node->operatorType;
+
+        // a += 2 + 3
+        // the assigned variable must not be replaced by its value
+        if (isAssignment(operatorType)) {
+            node->right = foldValue(node->right);
+            return node;
+        }
+
+        node->left = foldValue(node->left);
+        node->right = foldValue(node->right);
+
+        // true && a, false || a
+        // the first operand decides if the second one is evaluated
+        if (operatorType == OperatorType::And || operatorType == OperatorType::Or) {
+            bool shortCircuit = operatorType == OperatorType::Or;
+            if (isBoolean(node->left, shortCircuit) || isBoolean(node->left, !shortCircuit)) {
+                folded++;
+                return isBoolean(node->left, shortCircuit) ? node->left : node->right;
+            }
+            // a && true, a || false
+            if (isBoolean(node->right, !shortCircuit)) {
+                folded++;
+                return node->left;
+            }
+            return node;
+        }
+
+        if (!isConstant(node->left) || !isConstant(node->right))
+            return node;
+
+        Token left = as(node->left, Value)->value;
+        Token right = as(node->right, Value)->value;
+        char leftType = getConstantType(left);
+        char rightType = getConstantType(right);
+
+        // true == false
+        Token result = Token::of(TokenType::None);
+        if (leftType == 'Z' || rightType == 'Z') {
+            if (leftType != rightType || (operatorType != OperatorType::Equal && operatorType != OperatorType::NotEqual))
+                return node;
+            result = createBoolean((left.value == right.value) == (operatorType == OperatorType::Equal));
+        }
+
+        // 2 * 3 + 1L
+        // the operation is calculated using the wider type of the operands
+        else {
+            char type = getRank(leftType) >= getRank(rightType) ? leftType : rightType;
+            if (type == 'I' || type == 'J') {
+                long long a = getInteger(left);
+                long long b = getInteger(right);
+                if (type == 'I') {
+                    a = (int) a;
+                    b = (int) b;
+                }
+                if (!calculateInteger(operatorType, type, a, b, result))
+                    return node;
+            }
+            else if (!calculateReal(operatorType, type, getReal(left), getReal(right), result))
+                return node;
+        }
+
+        folded++;
+        return constant(result);
+    }
+
+    /**
+     * Fold a single-operand operation.
+     * @param node target operation
+     * @return folded expression
+     */
+    Node* ConstantFolder::foldSideOperation(SideOperation* node) {
+        // a++
+        // the incremented variable must not be replaced by its value
+        if (node->operatorType == OperatorType::Increment || node->operatorType == OperatorType::Decrement)
+            return node;
+
+        node->operand = foldValue(node->operand);
+        if (!isConstant(node->operand))
+            return node;
+
+        Token value = as(node->operand, Value)->value;
+        char type = getConstantType(value);
+
+        Token result = Token::of(TokenType::None);
+        // !true
+        if (node->operatorType == OperatorType::Not && type == 'Z')
+            result = createBoolean(value.value != U"true");
+        // -2
+        else if (node->operatorType == OperatorType::Subtract && (type == 'I' || type == 'J'))
+            result = createInteger(type, (long long) (0ULL - (unsigned long long) getInteger(value)));
+        else if (node->operatorType == OperatorType::Subtract && (type == 'F' || type == 'D'))
+            result = createReal(type, -getReal(value));
+        // ~2
+        else if (node->operatorType == OperatorType::Complement && (type == 'I' || type == 'J'))
+            result = createInteger(type, ~getInteger(value));
+        else
+            return node;
+
+        folded++;
+        return constant(result);
+    }
+
+    /**
+     * Find the constant value of a local variable in the visible scopes.
+     * @param name variable name
+     * @param value found constant value
+     * @return true if the variable has a constant value
+     */
+    bool ConstantFolder::lookup(UString name, Token& value) {
+        for (int i = (int) scopes.size() - 1; i >= 0; i--) {
+            auto constant = scopes[i].find(name);
+            if (constant != scopes[i].end()) {
+                value = constant->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Create a new constant value node.
+     * @param value constant token
+     * @return constant value node
+     */
+    Node* ConstantFolder::constant(Token value) {
+        return new Value(package, value);
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that evaluates the expressions of literal operands at compile time.
+     * The local variables that are assigned only once by a constant are replaced by their value,
+     * and the if statements with constant conditions are reduced to the case that is always executed.
+     * The pass works on the parsed nodes, before the bytecode of the method is generated.
+     */
+    class ConstantFolder {
+    private:
+        /**
+         * The package of the optimized methods.
+         */
+        Package* package;
+
+        /**
+         * The stack of the visible constant local variable scopes, the innermost scope is the last one.
+         */
+        List<Map<UString, Token>> scopes;
+
+        /**
+         * The map of the declaration counts of the local variable names of the current method.
+         */
+        Map<UString, uint> declarations;
+
+        /**
+         * The local variable names that are assigned after their declaration in the current method.
+         */
+        List<UString> assigned;
+
+    public:
+        /**
+         * The count of the operations that were replaced by their result.
+         */
+        uint folded = 0;
+
+        /**
+         * The count of the local variable reads that were replaced by a constant value.
+         */
+        uint propagated = 0;
+
+        /**
+         * The count of the if, else if and else cases that were removed or made unconditional.
+         */
+        uint branches = 0;
+
+        /**
+         * Initialize the constant folder.
+         * @param package optimized package
+         */
+        ConstantFolder(Package* package);
+
+        /**
+         * Fold the constant expressions of all the methods of the package.
+         */
+        void fold();
+
+        /**
+         * Fold the constant expressions of a method body.
+         * @param method target method
+         */
+        void foldMethod(MethodNode* method);
+
+    private:
+        /**
+         * Collect the local variable declarations and assignments of the given statements.
+         * @param body target statements
+         */
+        void scan(List<Node*>& body);
+
+        /**
+         * Fold the statements of a block in a new scope.
+         * @param body block statements
+         */
+        void foldBlock(List<Node*>& body);
+
+        /**
+         * Fold a single statement and append the resulting statements to the block.
+         * @param node target statement
+         * @param result folded block statements
+         */
+        void foldStatement(Node* node, List<Node*>& result);
+
+        /**
+         * Fold a local variable declaration and register its value if the variable is constant.
+         * @param type variable type
+         * @param name variable name
+         * @param value initial value of the variable
+         * @return folded initial value
+         */
+        Node* foldLocal(Token type, UString name, Node* value);
+
+        /**
+         * Fold an if statement and remove the cases that are never executed.
+         * @param statement target if statement
+         * @param result folded block statements
+         */
+        void foldIf(If* statement, List<Node*>& result);
+
+        /**
+         * Fold a switch statement and keep only the executed case, if the switched value is constant.
+         * @param statement target switch statement
+         * @param result folded block statements
+         */
+        void foldSwitch(Switch* statement, List<Node*>& result);
+
+        /**
+         * Fold an expression.
+         * @param node target expression
+         * @return folded expression
+         */
+        Node* foldValue(Node* node);
+
+        /**
+         * Fold an operation of two expressions.
+         * @param node target operation
+         * @return folded expression
+         */
+        Node* foldOperation(Operation* node);
+
+        /**
+         * Fold a single-operand operation.
+         * @param node target operation
+         * @return folded expression
+         */
+        Node* foldSideOperation(SideOperation* node);
+
+        /**
+         * Find the constant value of a local variable in the visible scopes.
+         * @param name variable name
+         * @param value found constant value
+         * @return true if the variable has a constant value
+         */
+        bool lookup(UString name, Token& value);
+
+        /**
+         * Create a new constant value node.
+         * @param value constant token
+         * @return constant value node
+         */
+        Node* constant(Token value);
+    };
+}
@@ -0,0 +1,337 @@
+#include "DeadCodeEliminator.hpp"
+#include "NodeWalker.hpp"
+#include "../builder/MethodBuilder.hpp"
+
+#include "../../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Determine if the given node is a boolean constant of the given value.
+     * @param node target node
+     * @param value expected boolean value
+     * @return true if the node is the expected boolean constant
+     */
+    static bool isBoolean(Node* node, bool value) {
+        return node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::Boolean, value ? U"true" : U"false");
+    }
+
+    /**
+     * Determine if the statements declare a local variable directly in the block.
+     * @param body block statements
+     * @return true if a local variable is declared
+     */
+    static bool declaresLocals(List<Node*>& body) {
+        for (Node* node : body) {
+            if (node->is(NodeType::LocalDeclare) || node->is(NodeType::MultiLocalDeclare)
+                    || node->is(NodeType::LocalDeclareAssign) || node->is(NodeType::LocalDeclareDestructure))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Determine if the given node is a numeric literal, that is not zero.
+     * @param node target node
+     * @return true if the node can be used as a divisor safely
+     */
+    static bool isNonZeroNumber(Node* node) {
+        if (!node->is(NodeType::Value))
+            return false;
+        Token token = as(node, Value)->value;
+        if (!token.is(TokenType::Integer) && !token.is(TokenType::Long)
+                && !token.is(TokenType::Float) && !token.is(TokenType::Double))
+            return false;
+        return std::stod(Strings::fromUTF(token.value)) != 0;
+    }
+
+    /**
+     * Initialize the dead code eliminator.
+     * @param package optimized package
+     */
+    DeadCodeEliminator::DeadCodeEliminator(Package* package)
+        : package(package)
+    { }
+
+    /**
+     * Remove the dead code of all the methods of the package.
+     */
+    void DeadCodeEliminator::eliminate() {
+        for (MethodNode* method : package->methods)
+            eliminateMethod(method);
+    }
+
+    /**
+     * Remove the dead code of a method body.
+     * @param method target method
+     */
+    void DeadCodeEliminator::eliminateMethod(MethodNode* method) {
+        eliminateBlock(method->body);
+
+        // removing a variable may leave the variables of its initial value unused,
+        // therefore repeat until there is nothing left to remove
+        uint removed = locals;
+        do {
+            references.clear();
+            NodeWalker::walk(method->body, [&](Node* node) {
+                // a, a = 2
+                if (node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::Identifier))
+                    references[as(node, Value)->value.value]++;
+                else if (node->is(NodeType::LocalAssign))
+                    references[as(node, LocalAssign)->name]++;
+                // $"a = {a}"
+                else if (node->is(NodeType::Template)) {
+                    List<UString> names;
+                    MethodBuilder::parseTemplate(as(node, Template)->value.value, names);
+                    for (UString& name : names)
+                        references[name]++;
+                }
+            });
+        } while (removeUnusedLocals(method->body));
+
+        // the blocks without variables can be merged to their enclosing block
+        if (locals > removed)
+            eliminateBlock(method->body);
+    }
+
+    /**
+     * Remove the unreachable statements of a block.
+     * @param body block statements
+     * @return true if the execution never continues after the block
+     */
+    bool DeadCodeEliminator::eliminateBlock(List<Node*>& body) {
+        List<Node*> result;
+        bool terminated = false;
+        for (Node* node : body) {
+            // return 1
+            // println("never")
+            if (terminated) {
+                statements++;
+                continue;
+            }
+            terminated = eliminateStatement(node, result);
+        }
+        body = result;
+        return terminated;
+    }
+
+    /**
+     * Remove the unreachable parts of a single statement and append the remaining statements to the block.
+     * @param node target statement
+     * @param result remaining block statements
+     * @return true if the execution never continues after the statement
+     */
+    bool DeadCodeEliminator::eliminateStatement(Node* node, List<Node*>& result) {
+        switch (node->type) {
+            case NodeType::Return:
+                result.push_back(node);
+                return true;
+
+            // the statement terminates if every case of it terminates
+            case NodeType::If: {
+                If* statement = as(node, If);
+                bool terminated = eliminateBlock(statement->body);
+                // if (true) { return }
+                // the constant folding leaves the unconditional cases with own variables in place
+                if (isBoolean(statement->condition, true) && statement->elseIfs.empty() && statement->elseCase == nullptr) {
+                    // the case can be moved to the enclosing block, once its variables have been removed
+                    if (declaresLocals(statement->body))
+                        result.push_back(node);
+                    else
+                        result.insert(result.end(), statement->body.begin(), statement->body.end());
+                    return terminated;
+                }
+                for (ElseIf* elseIf : statement->elseIfs)
+                    terminated &= eliminateBlock(elseIf->body);
+                if (statement->elseCase != nullptr)
+                    terminated &= eliminateBlock(statement->elseCase->body);
+                else
+                    terminated = false;
+
+                // if (a > 2) { }
+                bool empty = statement->body.empty() && isPure(statement->condition) && statement->elseCase == nullptr;
+                for (ElseIf* elseIf : statement->elseIfs)
+                    empty &= elseIf->body.empty() && isPure(elseIf->condition);
+                if (empty) {
+                    statements++;
+                    return false;
+                }
+                result.push_back(node);
+                return terminated;
+            }
+
+            case NodeType::While: {
+                While* statement = as(node, While);
+                // while (false) { }
+                if (isBoolean(statement->condition, false)) {
+                    statements++;
+                    return false;
+                }
+                eliminateBlock(statement->body);
+                result.push_back(node);
+                // while (true) { }
+                // the language does not have break statements, therefore an infinite loop is never left
+                return isBoolean(statement->condition, true);
+            }
+
+            case NodeType::DoWhile: {
+                DoWhile* statement = as(node, DoWhile);
+                bool terminated = eliminateBlock(statement->body);
+                // do { } while (false)
+                // the body is executed exactly once, it can be moved to the enclosing block
+                if (isBoolean(statement->condition, false) && !declaresLocals(statement->body)) {
+                    result.insert(result.end(), statement->body.begin(), statement->body.end());
+                    return terminated;
+                }
+                result.push_back(node);
+                return terminated || isBoolean(statement->condition, true);
+            }
+
+            // the statement terminates if every case of it terminates, and a default case is present
+            case NodeType::Switch: {
+                Switch* statement = as(node, Switch);
+                bool terminated = statement->defaultCase != nullptr;
+                for (SwitchCase* switchCase : statement->cases)
+                    terminated &= eliminateBlock(switchCase->body);
+                if (statement->defaultCase != nullptr)
+                    terminated &= eliminateBlock(statement->defaultCase->body);
+
+                // switch (a) { 1 -> { } }
+                bool empty = isPure(statement->value)
+                    && (statement->defaultCase == nullptr || statement->defaultCase->body.empty());
+                for (SwitchCase* switchCase : statement->cases)
+                    empty &= switchCase->body.empty();
+                if (empty) {
+                    statements++;
+                    return false;
+                }
+                result.push_back(node);
+                return terminated;
+            }
+
+            default:
+                result.push_back(node);
+                return false;
+        }
+    }
+
+    /**
+     * Remove the declarations of the local variables of a block, that are never referenced.
+     * @param body block statements
+     * @return true if a declaration has been removed
+     */
+    bool DeadCodeEliminator::removeUnusedLocals(List<Node*>& body) {
+        bool changed = false;
+        List<Node*> result;
+        for (Node* node : body) {
+            switch (node->type) {
+                // int a
+                case NodeType::LocalDeclare:
+                    if (isUnused(as(node, LocalDeclare)->name, nullptr)) {
+                        changed = true;
+                        continue;
+                    }
+                    break;
+                // int a = 2
+                case NodeType::LocalDeclareAssign: {
+                    LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                    if (isUnused(local->name, local->value)) {
+                        changed = true;
+                        continue;
+                    }
+                    break;
+                }
+                // int a, b = 2
+                case NodeType::MultiLocalDeclare: {
+                    auto& declared = as(node, MultiLocalDeclare)->locals;
+                    for (auto local = declared.begin(); local != declared.end();) {
+                        if (isUnused(local->first, local->second.has_value() ? *local->second : nullptr)) {
+                            local = declared.erase(local);
+                            changed = true;
+                        }
+                        else
+                            local++;
+                    }
+                    if (declared.empty())
+                        continue;
+                    break;
+                }
+                case NodeType::If: {
+                    If* statement = as(node, If);
+                    changed |= removeUnusedLocals(statement->body);
+                    for (ElseIf* elseIf : statement->elseIfs)
+                        changed |= removeUnusedLocals(elseIf->body);
+                    if (statement->elseCase != nullptr)
+                        changed |= removeUnusedLocals(statement->elseCase->body);
+                    break;
+                }
+                case NodeType::While:
+                    changed |= removeUnusedLocals(as(node, While)->body);
+                    break;
+                case NodeType::DoWhile:
+                    changed |= removeUnusedLocals(as(node, DoWhile)->body);
+                    break;
+                case NodeType::Switch: {
+                    Switch* statement = as(node, Switch);
+                    for (SwitchCase* switchCase : statement->cases)
+                        changed |= removeUnusedLocals(switchCase->body);
+                    if (statement->defaultCase != nullptr)
+                        changed |= removeUnusedLocals(statement->defaultCase->body);
+                    break;
+                }
+                default:
+                    break;
+            }
+            result.push_back(node);
+        }
+        body = result;
+        return changed;
+    }
+
+    /**
+     * Determine if the unused local variable of the given name can be removed with its initial value.
+     * @param name variable name
+     * @param value initial value of the variable, or null
+     * @return true if the variable can be removed
+     */
+    bool DeadCodeEliminator::isUnused(UString name, Node* value) {
+        if (references[name] > 0 || (value != nullptr && !isPure(value)))
+            return false;
+        locals++;
+        return true;
+    }
+
+    /**
+     * Determine if the evaluation of the given expression has no side effects.
+     * @param node target expression
+     * @return true if the expression can be removed safely
+     */
+    bool DeadCodeEliminator::isPure(Node* node) {
+        switch (node->type) {
+            case NodeType::Value:
+                return true;
+            case NodeType::Group:
+                return isPure(as(node, Group)->value);
+            case NodeType::Operation: {
+                Operation* operation = as(node, Operation);
+                OperatorType operatorType = operation->operatorType;
+                if (operatorType >= OperatorType::Assign && operatorType <= OperatorType::ShiftRightAssign)
+                    return false;
+                // an integer division by zero stops the program, therefore it must be kept
+                if ((operatorType == OperatorType::Divide || operatorType == OperatorType::Modulo)
+                        && !isNonZeroNumber(operation->right))
+                    return false;
+                return isPure(operation->left) && isPure(operation->right);
+            }
+            case NodeType::SideOperation: {
+                SideOperation* operation = as(node, SideOperation);
+                if (operation->operatorType == OperatorType::Increment || operation->operatorType == OperatorType::Decrement)
+                    return false;
+                return isPure(operation->operand);
+            }
+            default:
+                return false;
+        }
+    }
+}
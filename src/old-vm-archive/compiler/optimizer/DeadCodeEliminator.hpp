@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that removes the statements of a method which are never executed,
+     * and the local variables which are never used. The pass is run after the constant folding,
+     * therefore the branches and loops which are decided by constant conditions can be removed as well.
+     */
+    class DeadCodeEliminator {
+    private:
+        /**
+         * The package of the optimized methods.
+         */
+        Package* package;
+
+        /**
+         * The map of the reference counts of the local variable names of the current method.
+         */
+        Map<UString, uint> references;
+
+    public:
+        /**
+         * The count of the statements that were removed, because they could never be executed.
+         */
+        uint statements = 0;
+
+        /**
+         * The count of the local variables that were removed, because they were never used.
+         */
+        uint locals = 0;
+
+        /**
+         * Initialize the dead code eliminator.
+         * @param package optimized package
+         */
+        DeadCodeEliminator(Package* package);
+
+        /**
+         * Remove the dead code of all the methods of the package.
+         */
+        void eliminate();
+
+        /**
+         * Remove the dead code of a method body.
+         * @param method target method
+         */
+        void eliminateMethod(MethodNode* method);
+
+    private:
+        /**
+         * Remove the unreachable statements of a block.
+         * @param body block statements
+         * @return true if the execution never continues after the block
+         */
+        bool eliminateBlock(List<Node*>& body);
+
+        /**
+         * Remove the unreachable parts of a single statement and append the remaining statements to the block.
+         * @param node target statement
+         * @param result remaining block statements
+         * @return true if the execution never continues after the statement
+         */
+        bool eliminateStatement(Node* node, List<Node*>& result);
+
+        /**
+         * Remove the declarations of the local variables of a block, that are never referenced.
+         * @param body block statements
+         * @return true if a declaration has been removed
+         */
+        bool removeUnusedLocals(List<Node*>& body);
+
+        /**
+         * Determine if the unused local variable of the given name can be removed with its initial value.
+         * @param name variable name
+         * @param value initial value of the variable, or null
+         * @return true if the variable can be removed
+         */
+        bool isUnused(UString name, Node* value);
+
+        /**
+         * Determine if the evaluation of the given expression has no side effects.
+         * @param node target expression
+         * @return true if the expression can be removed safely
+         */
+        bool isPure(Node* node);
+    };
+}
@@ -0,0 +1,567 @@
+#include "LoopOptimizer.hpp"
+#include "NodeWalker.hpp"
+
+#include "../../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the type descriptor of a declared numeric local variable type.
+     * @param type variable type token
+     * @return type descriptor, or 0 if the type is not an arithmetic type
+     */
+    static char getDeclaredType(Token& type) {
+        if (type.is(TokenType::Type, U"int"))
+            return 'I';
+        else if (type.is(TokenType::Type, U"long"))
+            return 'J';
+        else if (type.is(TokenType::Type, U"float"))
+            return 'F';
+        else if (type.is(TokenType::Type, U"double"))
+            return 'D';
+        return 0;
+    }
+
+    /**
+     * Get the conversion rank of the given numeric type.
+     * @param type type descriptor
+     * @return type rank
+     */
+    static int getRank(char type) {
+        switch (type) {
+            case 'I':
+                return 0;
+            case 'J':
+                return 1;
+            case 'F':
+                return 2;
+            default:
+                return 3;
+        }
+    }
+
+    /**
+     * Determine if the given token is a numeric literal.
+     * @param token target token
+     * @return true if the token is a number
+     */
+    static bool isNumber(Token& token) {
+        return token.is(TokenType::Integer) || token.is(TokenType::Long)
+            || token.is(TokenType::Float) || token.is(TokenType::Double);
+    }
+
+    /**
+     * Get the value of an integral literal, that can be used as a step of a variable of the given type.
+     * @param node target node
+     * @param type stepped variable type descriptor
+     * @param value literal value
+     * @return true if the node is a suitable integral literal
+     */
+    static bool getInteger(Node* node, char type, long long& value) {
+        if (!node->is(NodeType::Value))
+            return false;
+        Token token = as(node, Value)->value;
+        if (!token.is(TokenType::Integer) && !(type == 'J' && token.is(TokenType::Long)))
+            return false;
+        value = std::stoll(Strings::fromUTF(token.value));
+        return true;
+    }
+
+    /**
+     * Determine if the expression reads any local variable.
+     * @param node target expression
+     * @return true if a variable is referenced
+     */
+    static bool hasVariables(Node* node) {
+        bool found = false;
+        NodeWalker::walk(node, [&](Node* child) {
+            found |= child->is(NodeType::Value) && as(child, Value)->value.is(TokenType::Identifier);
+        });
+        return found;
+    }
+
+    /**
+     * Get the text representation of an arithmetic expression, used for finding the identical invariants of a loop.
+     * @param node target expression
+     * @return expression key
+     */
+    static UString getKey(Node* node) {
+        switch (node->type) {
+            case NodeType::Value: {
+                Token token = as(node, Value)->value;
+                return Strings::toUTF(toString((int) token.type)) + U":" + token.value;
+            }
+            case NodeType::Group:
+                return getKey(as(node, Group)->value);
+            case NodeType::Operation: {
+                Operation* operation = as(node, Operation);
+                return U"(" + getKey(operation->left) + U" " + operation->target + U" " + getKey(operation->right) + U")";
+            }
+            case NodeType::SideOperation: {
+                SideOperation* operation = as(node, SideOperation);
+                return U"(" + operation->target + getKey(operation->operand) + U")";
+            }
+            default:
+                return U"";
+        }
+    }
+
+    /**
+     * Initialize the loop optimizer.
+     * @param package optimized package
+     */
+    LoopOptimizer::LoopOptimizer(Package* package)
+        : package(package)
+    { }
+
+    /**
+     * Optimize the loops of all the methods of the package.
+     */
+    void LoopOptimizer::optimize() {
+        for (MethodNode* method : package->methods)
+            optimizeMethod(method);
+    }
+
+    /**
+     * Optimize the loops of a method body.
+     * @param method target method
+     */
+    void LoopOptimizer::optimizeMethod(MethodNode* method) {
+        types.clear();
+        invariants = 0;
+        collectTypes(method);
+        optimizeBlock(method->body);
+    }
+
+    /**
+     * Collect the type descriptors of the parameters and local variables of a method.
+     * @param method target method
+     */
+    void LoopOptimizer::collectTypes(MethodNode* method) {
+        for (Parameter& parameter : method->parameters)
+            declareType(parameter.name, getDeclaredType(parameter.type));
+
+        // the nodes are visited in source order, therefore the type of a variable
+        // inferred by "let" is known by the time it is referenced
+        NodeWalker::walk(method->body, [&](Node* node) {
+            if (node->is(NodeType::LocalDeclare))
+                declareType(as(node, LocalDeclare)->name, getDeclaredType(as(node, LocalDeclare)->type));
+            else if (node->is(NodeType::MultiLocalDeclare)) {
+                MultiLocalDeclare* locals = as(node, MultiLocalDeclare);
+                for (auto& [name, _] : locals->locals)
+                    declareType(name, getDeclaredType(locals->type));
+            }
+            else if (node->is(NodeType::LocalDeclareAssign)) {
+                LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                bool inferred = local->type.is(TokenType::Type, U"let");
+                declareType(local->name, inferred ? getType(local->value) : getDeclaredType(local->type));
+            }
+            else if (node->is(NodeType::LocalDeclareDestructure)) {
+                for (UString& member : as(node, LocalDeclareDestructure)->members)
+                    declareType(member, 0);
+            }
+        });
+    }
+
+    /**
+     * Declare the type of a local variable of the current method.
+     * @param name variable name
+     * @param type variable type descriptor
+     */
+    void LoopOptimizer::declareType(UString name, char type) {
+        auto declared = types.find(name);
+        if (declared == types.end())
+            types[name] = type;
+        // int a; { long a }
+        // the sibling scopes may use the same name for different types
+        else if (declared->second != type)
+            declared->second = 0;
+    }
+
+    /**
+     * Optimize the loops of the statements of a block. The invariants of a loop are declared in the block,
+     * directly before the loop.
+     * @param body block statements
+     */
+    void LoopOptimizer::optimizeBlock(List<Node*>& body) {
+        List<Node*> result;
+        for (Node* node : body) {
+            switch (node->type) {
+                case NodeType::If: {
+                    If* statement = as(node, If);
+                    optimizeBlock(statement->body);
+                    for (ElseIf* elseIf : statement->elseIfs)
+                        optimizeBlock(elseIf->body);
+                    if (statement->elseCase != nullptr)
+                        optimizeBlock(statement->elseCase->body);
+                    break;
+                }
+                case NodeType::While:
+                    optimizeLoop(as(node, While)->condition, as(node, While)->body, result);
+                    break;
+                case NodeType::DoWhile:
+                    optimizeLoop(as(node, DoWhile)->condition, as(node, DoWhile)->body, result);
+                    break;
+                case NodeType::Switch: {
+                    Switch* statement = as(node, Switch);
+                    for (SwitchCase* switchCase : statement->cases)
+                        optimizeBlock(switchCase->body);
+                    if (statement->defaultCase != nullptr)
+                        optimizeBlock(statement->defaultCase->body);
+                    break;
+                }
+                default:
+                    break;
+            }
+            result.push_back(node);
+        }
+        body = result;
+    }
+
+    /**
+     * Optimize a single loop, and its nested loops afterwards.
+     * @param condition loop condition
+     * @param body loop body statements
+     * @param preheader the list to append the invariant declarations to
+     */
+    void LoopOptimizer::optimizeLoop(Node*& condition, List<Node*>& body, List<Node*>& preheader) {
+        // i = i + 1 -> i++
+        rewriteSteps(condition);
+        for (Node*& statement : body)
+            rewriteSteps(statement);
+
+        // collect the variables whose value may differ between the iterations
+        List<UString> variants;
+        collectVariants(condition, variants);
+        for (Node* statement : body)
+            collectVariants(statement, variants);
+
+        // while (i < n) { sum += a * b } -> let invariant@loop0 = a * b; while (i < n) { sum += invariant@loop0 }
+        Map<UString, UString> invariantNames;
+        hoistExpression(condition, variants, invariantNames, preheader);
+        for (Node* statement : body)
+            hoistStatement(statement, variants, invariantNames, preheader);
+
+        // the nested loops are optimized after the enclosing loop, so that the expressions which do not depend
+        // on any of the loops are moved out of all of them, instead of only the innermost one
+        optimizeBlock(body);
+    }
+
+    /**
+     * Collect the names of the local variables that are declared or assigned inside a loop.
+     * @param node loop condition or statement
+     * @param variants the list to append the variable names to
+     */
+    void LoopOptimizer::collectVariants(Node* node, List<UString>& variants) {
+        NodeWalker::walk(node, [&](Node* child) {
+            // a variable declared inside the loop is declared again in every iteration
+            if (child->is(NodeType::LocalDeclare))
+                variants.push_back(as(child, LocalDeclare)->name);
+            else if (child->is(NodeType::LocalDeclareAssign))
+                variants.push_back(as(child, LocalDeclareAssign)->name);
+            else if (child->is(NodeType::MultiLocalDeclare)) {
+                for (auto& [name, _] : as(child, MultiLocalDeclare)->locals)
+                    variants.push_back(name);
+            }
+            else if (child->is(NodeType::LocalDeclareDestructure)) {
+                for (UString& member : as(child, LocalDeclareDestructure)->members)
+                    variants.push_back(member);
+            }
+            // a = 2, a += 2
+            else if (child->is(NodeType::LocalAssign))
+                variants.push_back(as(child, LocalAssign)->name);
+            else if (child->is(NodeType::Operation) && isAssignment(as(child, Operation)->operatorType))
+                variants.push_back(NodeWalker::getLocalName(as(child, Operation)->left));
+            // a++
+            else if (child->is(NodeType::SideOperation)) {
+                SideOperation* operation = as(child, SideOperation);
+                if (operation->operatorType == OperatorType::Increment || operation->operatorType == OperatorType::Decrement)
+                    variants.push_back(NodeWalker::getLocalName(operation->operand));
+            }
+        });
+    }
+
+    /**
+     * Move the invariant expressions of a loop statement before the loop.
+     * @param node loop statement
+     * @param variants the variables changed by the loop
+     * @param invariantNames the map of the invariant variable names by the hoisted expressions
+     * @param preheader the list to append the invariant declarations to
+     */
+    void LoopOptimizer::hoistStatement(Node* node, List<UString>& variants, Map<UString, UString>& invariantNames,
+            List<Node*>& preheader) {
+        switch (node->type) {
+            // the statements of the nested blocks are visited one by one, so that a statement is never replaced by a value
+            case NodeType::If: {
+                If* statement = as(node, If);
+                hoistExpression(statement->condition, variants, invariantNames, preheader);
+                for (Node* child : statement->body)
+                    hoistStatement(child, variants, invariantNames, preheader);
+                for (ElseIf* elseIf : statement->elseIfs) {
+                    hoistExpression(elseIf->condition, variants, invariantNames, preheader);
+                    for (Node* child : elseIf->body)
+                        hoistStatement(child, variants, invariantNames, preheader);
+                }
+                if (statement->elseCase != nullptr) {
+                    for (Node* child : statement->elseCase->body)
+                        hoistStatement(child, variants, invariantNames, preheader);
+                }
+                break;
+            }
+            case NodeType::While:
+                hoistExpression(as(node, While)->condition, variants, invariantNames, preheader);
+                for (Node* child : as(node, While)->body)
+                    hoistStatement(child, variants, invariantNames, preheader);
+                break;
+            case NodeType::DoWhile:
+                for (Node* child : as(node, DoWhile)->body)
+                    hoistStatement(child, variants, invariantNames, preheader);
+                hoistExpression(as(node, DoWhile)->condition, variants, invariantNames, preheader);
+                break;
+            case NodeType::Switch: {
+                Switch* statement = as(node, Switch);
+                hoistExpression(statement->value, variants, invariantNames, preheader);
+                for (SwitchCase* switchCase : statement->cases) {
+                    for (Node* child : switchCase->body)
+                        hoistStatement(child, variants, invariantNames, preheader);
+                }
+                if (statement->defaultCase != nullptr) {
+                    for (Node* child : statement->defaultCase->body)
+                        hoistStatement(child, variants, invariantNames, preheader);
+                }
+                break;
+            }
+            // the deferred instructions are executed when the method returns, not in the loop
+            case NodeType::Defer:
+                break;
+            default:
+                NodeWalker::forEachChild(node, [&](Node*& child) {
+                    hoistExpression(child, variants, invariantNames, preheader);
+                });
+                break;
+        }
+    }
+
+    /**
+     * Move the invariant parts of an expression before the loop.
+     * @param node loop expression
+     * @param variants the variables changed by the loop
+     * @param invariantNames the map of the invariant variable names by the hoisted expressions
+     * @param preheader the list to append the invariant declarations to
+     */
+    void LoopOptimizer::hoistExpression(Node*& node, List<UString>& variants, Map<UString, UString>& invariantNames,
+            List<Node*>& preheader) {
+        if (node->is(NodeType::Lambda))
+            return;
+
+        // only the calculations are worth moving, the literals and variables are read directly by the instructions
+        Node* value = node;
+        while (value->is(NodeType::Group))
+            value = as(value, Group)->value;
+        bool calculation = value->is(NodeType::Operation) || value->is(NodeType::SideOperation);
+        if (!calculation || !isInvariant(node, variants) || !hasVariables(node)) {
+            NodeWalker::forEachChild(node, [&](Node*& child) {
+                hoistExpression(child, variants, invariantNames, preheader);
+            });
+            return;
+        }
+
+        // the same invariant expression is calculated only once for the loop
+        UString key = getKey(node);
+        auto invariant = invariantNames.find(key);
+        if (invariant == invariantNames.end()) {
+            // let invariant@loop0 = a * b
+            // the type of the variable is inferred the same way as the expression would be evaluated in the loop
+            UString name = U"invariant@loop" + Strings::toUTF(toString(invariants++));
+            preheader.push_back(new LocalDeclareAssign(package, Token::of(TokenType::Type, U"let"), {}, name, node));
+            declareType(name, getType(node));
+            invariant = invariantNames.insert({ key, name }).first;
+        }
+        node = new Value(package, Token::of(TokenType::Identifier, invariant->second));
+        hoisted++;
+    }
+
+    /**
+     * Determine if the expression evaluates to the same value in every iteration of the loop.
+     * @param node target expression
+     * @param variants the variables changed by the loop
+     * @return true if the expression can be calculated before the loop
+     */
+    bool LoopOptimizer::isInvariant(Node* node, List<UString>& variants) {
+        switch (node->type) {
+            case NodeType::Value: {
+                Token token = as(node, Value)->value;
+                if (!token.is(TokenType::Identifier))
+                    return isNumber(token);
+                // only the arithmetic local variables are moved, the other names may refer to fields or types
+                auto type = types.find(token.value);
+                return type != types.end() && type->second != 0 && !(contains(variants, token.value));
+            }
+            case NodeType::Group:
+                return isInvariant(as(node, Group)->value, variants);
+            case NodeType::Operation: {
+                Operation* operation = as(node, Operation);
+                OperatorType operatorType = operation->operatorType;
+                if (operatorType < OperatorType::Add || operatorType > OperatorType::Modulo)
+                    return false;
+                // a division that would not have been executed by an empty loop must not stop the program,
+                // therefore only the divisions by a safe literal are moved
+                if (operatorType == OperatorType::Divide || operatorType == OperatorType::Modulo) {
+                    Node* divisor = operation->right;
+                    if (!divisor->is(NodeType::Value) || !isNumber(as(divisor, Value)->value))
+                        return false;
+                    double value = std::stod(Strings::fromUTF(as(divisor, Value)->value.value));
+                    if (value == 0 || value == -1)
+                        return false;
+                }
+                return isInvariant(operation->left, variants) && isInvariant(operation->right, variants);
+            }
+            // -a
+            case NodeType::SideOperation: {
+                SideOperation* operation = as(node, SideOperation);
+                return operation->operatorType == OperatorType::Subtract && isInvariant(operation->operand, variants);
+            }
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Get the type descriptor of an arithmetic expression.
+     * @param node target expression
+     * @return expression type descriptor
+     */
+    char LoopOptimizer::getType(Node* node) {
+        switch (node->type) {
+            case NodeType::Value: {
+                Token token = as(node, Value)->value;
+                if (token.is(TokenType::Identifier)) {
+                    auto type = types.find(token.value);
+                    return type != types.end() ? type->second : 0;
+                }
+                else if (token.is(TokenType::Integer))
+                    return 'I';
+                else if (token.is(TokenType::Long))
+                    return 'J';
+                else if (token.is(TokenType::Float))
+                    return 'F';
+                else if (token.is(TokenType::Double))
+                    return 'D';
+                return 0;
+            }
+            case NodeType::Group:
+                return getType(as(node, Group)->value);
+            case NodeType::Operation: {
+                if (as(node, Operation)->operatorType < OperatorType::Add || as(node, Operation)->operatorType > OperatorType::Modulo)
+                    return 0;
+                char left = getType(as(node, Operation)->left);
+                char right = getType(as(node, Operation)->right);
+                if (left == 0 || right == 0)
+                    return 0;
+                return getRank(left) >= getRank(right) ? left : right;
+            }
+            case NodeType::SideOperation:
+                if (as(node, SideOperation)->operatorType != OperatorType::Subtract)
+                    return 0;
+                return getType(as(node, SideOperation)->operand);
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Rewrite the induction variable updates of a loop node and its children to increments and decrements.
+     * @param node loop condition or statement
+     */
+    void LoopOptimizer::rewriteSteps(Node*& node) {
+        if (node->is(NodeType::Lambda))
+            return;
+
+        // i = i + 1 -> ++i
+        // the prefix form is used, as it results the new value of the variable, the same way as an assignment
+        bool increment;
+        UString name = getStep(node, increment);
+        if (!name.empty()) {
+            Node* variable = new Value(package, Token::of(TokenType::Identifier, name));
+            node = new SideOperation(package, increment ? OperatorType::Increment : OperatorType::Decrement, variable, true);
+            stepped++;
+            return;
+        }
+
+        NodeWalker::forEachChild(node, [&](Node*& child) {
+            rewriteSteps(child);
+        });
+    }
+
+    /**
+     * Get the variable and the direction of an update that steps an integral variable by one.
+     * @param node target node
+     * @param increment true if the variable is incremented, false if decremented
+     * @return stepped variable name, or empty if the node is not a step by one
+     */
+    UString LoopOptimizer::getStep(Node* node, bool& increment) {
+        UString name;
+        OperatorType operatorType;
+        Node* value;
+        if (node->is(NodeType::LocalAssign)) {
+            name = as(node, LocalAssign)->name;
+            operatorType = OperatorType::Assign;
+            value = as(node, LocalAssign)->value;
+        }
+        else if (node->is(NodeType::Operation)) {
+            Operation* operation = as(node, Operation);
+            name = NodeWalker::getLocalName(operation->left);
+            operatorType = operation->operatorType;
+            value = operation->right;
+        }
+        else
+            return U"";
+
+        // the virtual machine has increment instructions for the integral types only
+        auto type = types.find(name);
+        if (name.empty() || type == types.end() || (type->second != 'I' && type->second != 'J'))
+            return U"";
+        while (value->is(NodeType::Group))
+            value = as(value, Group)->value;
+
+        long long delta;
+        switch (operatorType) {
+            // i += 1, i -= 1
+            case OperatorType::AddAssign:
+            case OperatorType::SubtractAssign:
+                if (!getInteger(value, type->second, delta))
+                    return U"";
+                if (operatorType == OperatorType::SubtractAssign)
+                    delta = -delta;
+                break;
+
+            // i = i + 1, i = 1 + i, i = i - 1
+            case OperatorType::Assign: {
+                if (!value->is(NodeType::Operation))
+                    return U"";
+                Operation* operation = as(value, Operation);
+                if (operation->operatorType == OperatorType::Add && NodeWalker::getLocalName(operation->left) == name
+                        && getInteger(operation->right, type->second, delta))
+                    break;
+                if (operation->operatorType == OperatorType::Add && NodeWalker::getLocalName(operation->right) == name
+                        && getInteger(operation->left, type->second, delta))
+                    break;
+                if (operation->operatorType == OperatorType::Subtract && NodeWalker::getLocalName(operation->left) == name
+                        && getInteger(operation->right, type->second, delta)) {
+                    delta = -delta;
+                    break;
+                }
+                return U"";
+            }
+
+            default:
+                return U"";
+        }
+
+        if (delta != 1 && delta != -1)
+            return U"";
+        increment = delta == 1;
+        return name;
+    }
+}
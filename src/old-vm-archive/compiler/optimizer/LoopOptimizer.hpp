@@ -0,0 +1,149 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+namespace Compiler {
+    /**
+     * Represents an optimization pass, that reduces the work done by each iteration of the while and do-while loops.
+     * The arithmetic expressions whose operands are not changed by the loop are calculated once to a new local
+     * variable before the loop, and the induction variables that are stepped by one are rewritten to increments,
+     * so that they are compiled to the single-operand "inc" and "decr" instructions.
+     * The loops of the language are structured, therefore every loop node is a natural loop with a single entry,
+     * and the statements directly before the loop act as its preheader.
+     */
+    class LoopOptimizer {
+    private:
+        /**
+         * The package of the optimized methods.
+         */
+        Package* package;
+
+        /**
+         * The map of the type descriptors of the local variables of the current method.
+         * The names that are declared with different types are mapped to 0.
+         */
+        Map<UString, char> types;
+
+        /**
+         * The count of the invariant variables of the current method, used for creating unique variable names.
+         */
+        uint invariants = 0;
+
+    public:
+        /**
+         * The count of the invariant expressions that were moved before their loop.
+         */
+        uint hoisted = 0;
+
+        /**
+         * The count of the induction variable updates that were rewritten to increments or decrements.
+         */
+        uint stepped = 0;
+
+        /**
+         * Initialize the loop optimizer.
+         * @param package optimized package
+         */
+        LoopOptimizer(Package* package);
+
+        /**
+         * Optimize the loops of all the methods of the package.
+         */
+        void optimize();
+
+        /**
+         * Optimize the loops of a method body.
+         * @param method target method
+         */
+        void optimizeMethod(MethodNode* method);
+
+    private:
+        /**
+         * Collect the type descriptors of the parameters and local variables of a method.
+         * @param method target method
+         */
+        void collectTypes(MethodNode* method);
+
+        /**
+         * Declare the type of a local variable of the current method.
+         * @param name variable name
+         * @param type variable type descriptor
+         */
+        void declareType(UString name, char type);
+
+        /**
+         * Optimize the loops of the statements of a block. The invariants of a loop are declared in the block,
+         * directly before the loop.
+         * @param body block statements
+         */
+        void optimizeBlock(List<Node*>& body);
+
+        /**
+         * Optimize a single loop, and its nested loops afterwards.
+         * @param condition loop condition
+         * @param body loop body statements
+         * @param preheader the list to append the invariant declarations to
+         */
+        void optimizeLoop(Node*& condition, List<Node*>& body, List<Node*>& preheader);
+
+        /**
+         * Collect the names of the local variables that are declared or assigned inside a loop.
+         * @param node loop condition or statement
+         * @param variants the list to append the variable names to
+         */
+        void collectVariants(Node* node, List<UString>& variants);
+
+        /**
+         * Move the invariant expressions of a loop statement before the loop.
+         * @param node loop statement
+         * @param variants the variables changed by the loop
+         * @param invariantNames the map of the invariant variable names by the hoisted expressions
+         * @param preheader the list to append the invariant declarations to
+         */
+        void hoistStatement(Node* node, List<UString>& variants, Map<UString, UString>& invariantNames, List<Node*>& preheader);
+
+        /**
+         * Move the invariant parts of an expression before the loop.
+         * @param node loop expression
+         * @param variants the variables changed by the loop
+         * @param invariantNames the map of the invariant variable names by the hoisted expressions
+         * @param preheader the list to append the invariant declarations to
+         */
+        void hoistExpression(Node*& node, List<UString>& variants, Map<UString, UString>& invariantNames, List<Node*>& preheader);
+
+        /**
+         * Determine if the expression evaluates to the same value in every iteration of the loop.
+         * @param node target expression
+         * @param variants the variables changed by the loop
+         * @return true if the expression can be calculated before the loop
+         */
+        bool isInvariant(Node* node, List<UString>& variants);
+
+        /**
+         * Get the type descriptor of an arithmetic expression.
+         * @param node target expression
+         * @return expression type descriptor
+         */
+        char getType(Node* node);
+
+        /**
+         * Rewrite the induction variable updates of a loop node and its children to increments and decrements.
+         * @param node loop condition or statement
+         */
+        void rewriteSteps(Node*& node);
+
+        /**
+         * Get the variable and the direction of an update that steps an integral variable by one.
+         * @param node target node
+         * @param increment true if the variable is incremented, false if decremented
+         * @return stepped variable name, or empty if the node is not a step by one
+         */
+        UString getStep(Node* node, bool& increment);
+    };
+}
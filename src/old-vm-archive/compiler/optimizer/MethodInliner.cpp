@@ -0,0 +1,526 @@
+#include "MethodInliner.hpp"
+#include "NodeWalker.hpp"
+
+#include "../../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * Get the name of the return type of the given method.
+     * @param method target method
+     * @return return type name
+     */
+    static UString getReturnType(MethodNode* method) {
+        if (method->returnTypes.size() != 1 || method->returnTypes[0].types.empty())
+            return U"void";
+        return method->returnTypes[0].types[0].value;
+    }
+
+    /**
+     * Determine if the inliner knows how to copy the given node.
+     * @param node target node
+     * @return true if the node can be copied
+     */
+    static bool isCopyable(Node* node) {
+        switch (node->type) {
+            case NodeType::Value:
+            case NodeType::Operation:
+            case NodeType::SideOperation:
+            case NodeType::Group:
+            case NodeType::MethodCall:
+            case NodeType::LocalDeclare:
+            case NodeType::MultiLocalDeclare:
+            case NodeType::LocalDeclareAssign:
+            case NodeType::LocalAssign:
+            case NodeType::Return:
+            case NodeType::If:
+            case NodeType::While:
+            case NodeType::DoWhile:
+            case NodeType::Switch:
+                return true;
+            // the deferred instructions run when the inlined method returns,
+            // which is not the same place where the caller method returns
+            case NodeType::Defer:
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Determine if the evaluation of the expression may change the state of the program.
+     * @param node target expression
+     * @return true if the expression has to be evaluated, even if its value is unused
+     */
+    static bool hasSideEffects(Node* node) {
+        bool effects = false;
+        NodeWalker::walk(node, [&](Node* child) {
+            if (child->is(NodeType::MethodCall) || child->is(NodeType::LocalAssign))
+                effects = true;
+            else if (child->is(NodeType::Operation)) {
+                OperatorType operatorType = as(child, Operation)->operatorType;
+                // an integer division by zero stops the program
+                effects |= (operatorType >= OperatorType::Assign && operatorType <= OperatorType::ShiftRightAssign)
+                    || operatorType == OperatorType::Divide || operatorType == OperatorType::Modulo;
+            }
+            else if (child->is(NodeType::SideOperation)) {
+                OperatorType operatorType = as(child, SideOperation)->operatorType;
+                effects |= operatorType == OperatorType::Increment || operatorType == OperatorType::Decrement;
+            }
+        });
+        return effects;
+    }
+
+    /**
+     * Collect the method calls of an expression, that are evaluated before the other parts of the expression
+     * could change the state of the program.
+     * @param node target expression
+     * @param calls the list to append the references of the calls to
+     * @param movable set to false, if the calls cannot be evaluated before the expression
+     */
+    static void collectCalls(Node*& node, List<Node**>& calls, bool& movable) {
+        if (node->is(NodeType::MethodCall)) {
+            calls.push_back(&node);
+            for (Node* argument : as(node, MethodCall)->arguments)
+                movable &= !hasSideEffects(argument);
+        }
+        else if (node->is(NodeType::Operation)) {
+            Operation* operation = as(node, Operation);
+            // the short-circuit operators may skip the call, and the division may stop the program before the call
+            if (operation->operatorType < OperatorType::BitwiseOr || operation->operatorType > OperatorType::Multiply)
+                movable = false;
+            collectCalls(operation->left, calls, movable);
+            collectCalls(operation->right, calls, movable);
+        }
+        else if (node->is(NodeType::SideOperation)) {
+            SideOperation* operation = as(node, SideOperation);
+            if (operation->operatorType == OperatorType::Increment || operation->operatorType == OperatorType::Decrement)
+                movable = false;
+            collectCalls(operation->operand, calls, movable);
+        }
+        else if (node->is(NodeType::Group))
+            collectCalls(as(node, Group)->value, calls, movable);
+        else if (!node->is(NodeType::Value))
+            movable = false;
+    }
+
+    /**
+     * Initialize the method inliner.
+     * @param package optimized package
+     */
+    MethodInliner::MethodInliner(Package* package)
+        : package(package), caller(nullptr)
+    { }
+
+    /**
+     * Inline the small method calls of all the methods of the package.
+     */
+    void MethodInliner::inlineCalls() {
+        for (MethodNode* method : package->methods)
+            inlineMethod(method);
+    }
+
+    /**
+     * Inline the small method calls of a method body.
+     * @param method target method
+     */
+    void MethodInliner::inlineMethod(MethodNode* method) {
+        caller = method;
+        expansions = 0;
+        expanding = { method };
+        inlineBlock(method->body, 0);
+    }
+
+    /**
+     * Inline the calls of the statements of a block.
+     * @param body block statements
+     * @param depth the count of the inlined methods the block is nested in
+     */
+    void MethodInliner::inlineBlock(List<Node*>& body, uint depth) {
+        List<Node*> result;
+        for (Node* node : body) {
+            // the call nested in the expression of the statement is moved before it, then inlined from there
+            LocalDeclareAssign* hoisted = hoistCall(node, depth);
+            if (hoisted != nullptr)
+                inlineStatement(hoisted, result, depth);
+            inlineStatement(node, result, depth);
+        }
+        body = result;
+    }
+
+    /**
+     * Inline the call of a statement.
+     * @param node target statement
+     * @param result the list to append the statement and the inlined statements to
+     * @param depth the count of the inlined methods the statement is nested in
+     */
+    void MethodInliner::inlineStatement(Node* node, List<Node*>& result, uint depth) {
+        // the calls are inlined, where the call is the first thing the statement evaluates,
+        // so that the body of the called method can be executed before the statement
+        MethodCall* call = nullptr;
+        // foo(a)
+        if (node->is(NodeType::MethodCall))
+            call = as(node, MethodCall);
+        // int b = foo(a)
+        else if (node->is(NodeType::LocalDeclareAssign) && as(node, LocalDeclareAssign)->value->is(NodeType::MethodCall))
+            call = as(as(node, LocalDeclareAssign)->value, MethodCall);
+        // return foo(a)
+        else if (node->is(NodeType::Return) && as(node, Return)->value.has_value()
+                && (*as(node, Return)->value)->is(NodeType::MethodCall))
+            call = as(*as(node, Return)->value, MethodCall);
+
+        MethodNode* callee = call != nullptr ? findCallee(call, depth) : nullptr;
+
+        // the type of the returned value must match the declared type, as there are no conversion instructions
+        if (callee != nullptr && node->is(NodeType::LocalDeclareAssign)) {
+            Token type = as(node, LocalDeclareAssign)->type;
+            if (!type.is(TokenType::Type, U"let") && type.value != getReturnType(callee))
+                callee = nullptr;
+        }
+        else if (callee != nullptr && node->is(NodeType::Return) && getReturnType(caller) != getReturnType(callee))
+            callee = nullptr;
+
+        if (callee == nullptr) {
+            // inline the calls of the nested blocks
+            if (node->is(NodeType::If)) {
+                If* statement = as(node, If);
+                inlineBlock(statement->body, depth);
+                for (ElseIf* elseIf : statement->elseIfs)
+                    inlineBlock(elseIf->body, depth);
+                if (statement->elseCase != nullptr)
+                    inlineBlock(statement->elseCase->body, depth);
+            }
+            else if (node->is(NodeType::While))
+                inlineBlock(as(node, While)->body, depth);
+            else if (node->is(NodeType::DoWhile))
+                inlineBlock(as(node, DoWhile)->body, depth);
+            else if (node->is(NodeType::Switch)) {
+                Switch* statement = as(node, Switch);
+                for (SwitchCase* switchCase : statement->cases)
+                    inlineBlock(switchCase->body, depth);
+                if (statement->defaultCase != nullptr)
+                    inlineBlock(statement->defaultCase->body, depth);
+            }
+            result.push_back(node);
+            return;
+        }
+
+        // copy the body of the called method, then inline the calls of the copied statements as well
+        List<Node*> statements;
+        Node* value = expand(callee, call, statements);
+        expanding.push_back(callee);
+        inlineBlock(statements, depth + 1);
+        expanding.pop_back();
+        result.insert(result.end(), statements.begin(), statements.end());
+        inlined++;
+
+        // use the returned value in place of the call
+        if (node->is(NodeType::LocalDeclareAssign)) {
+            as(node, LocalDeclareAssign)->value = value;
+            result.push_back(node);
+        }
+        else if (node->is(NodeType::Return)) {
+            as(node, Return)->value = value;
+            result.push_back(node);
+        }
+        // the unused returned value is still evaluated, if it changes the state of the program
+        else if (value != nullptr && hasSideEffects(value))
+            result.push_back(value);
+    }
+
+    /**
+     * Move the method call nested in the expression of a statement to a new local variable before the statement,
+     * so that the call can be inlined the same way as the value of a local declaration.
+     * @param node target statement
+     * @param depth the count of the inlined methods the statement is nested in
+     * @return the declaration of the moved call, or nullptr if the statement does not have a call to move
+     */
+    LocalDeclareAssign* MethodInliner::hoistCall(Node* node, uint depth) {
+        // collect the expressions, that are evaluated first by the statement
+        List<Node**> roots;
+        // foo(a + bar(b))
+        if (node->is(NodeType::MethodCall)) {
+            // the call of the statement is inlined on its own
+            if (findCallee(as(node, MethodCall), depth) != nullptr)
+                return nullptr;
+            for (Node*& argument : as(node, MethodCall)->arguments)
+                roots.push_back(&argument);
+        }
+        // int b = a + foo(a)
+        else if (node->is(NodeType::LocalDeclareAssign))
+            roots.push_back(&as(node, LocalDeclareAssign)->value);
+        // b = a + foo(a)
+        else if (node->is(NodeType::LocalAssign))
+            roots.push_back(&as(node, LocalAssign)->value);
+        // b += foo(a)
+        else if (node->is(NodeType::Operation) && isAssignment(as(node, Operation)->operatorType)
+                && as(node, Operation)->left->is(NodeType::Value))
+            roots.push_back(&as(node, Operation)->right);
+        // return a + foo(a)
+        else if (node->is(NodeType::Return) && as(node, Return)->value.has_value())
+            roots.push_back(&*as(node, Return)->value);
+
+        // the call at the head of a declaration or a return is inlined without moving it
+        bool declaration = node->is(NodeType::LocalDeclareAssign) || node->is(NodeType::Return);
+        if (declaration && (*roots[0])->is(NodeType::MethodCall))
+            return nullptr;
+
+        // only a single call is moved, so that the order of the calls does not change
+        List<Node**> calls;
+        bool movable = true;
+        for (Node** root : roots)
+            collectCalls(*root, calls, movable);
+        if (calls.size() != 1 || !movable)
+            return nullptr;
+
+        MethodCall* call = as(*calls[0], MethodCall);
+        MethodNode* callee = findCallee(call, depth);
+        if (callee == nullptr || getReturnType(callee) == U"void")
+            return nullptr;
+
+        // total = total + square(i) -> int @square0 = square(i)
+        //                              total = total + @square0
+        UString name = U"@" + callee->name + Strings::toUTF(toString(expansions++));
+        NamedType& type = callee->returnTypes[0];
+        *calls[0] = new Value(package, Token::of(TokenType::Identifier, name));
+        return new LocalDeclareAssign(package, type.types[0], type.generics, name, call);
+    }
+
+    /**
+     * Find the method called by a method call, that can be inlined.
+     * @param call target method call
+     * @param depth the count of the inlined methods the call is nested in
+     * @return called method, or null if the call cannot be inlined
+     */
+    MethodNode* MethodInliner::findCallee(MethodCall* call, uint depth) {
+        if (depth >= INLINE_MAX_DEPTH)
+            return nullptr;
+
+        // the overloads are resolved by the argument types when the bytecode is generated,
+        // therefore only the methods without overloads are inlined
+        MethodNode* callee = nullptr;
+        List<MethodNode*> candidates;
+        // the called method is looked up by the registered package of the caller, that resolves the other files too
+        Package* scope = caller->Node::package;
+        List<Package*> packages = { scope };
+        packages.insert(packages.end(), scope->dependencies.begin(), scope->dependencies.end());
+        Symbol name = Symbols::intern(call->name);
+        for (Package* candidate : packages) {
+            for (MethodNode* method : candidate->getOverloads(name)) {
+                if (contains(candidates, method))
+                    continue;
+                candidates.push_back(method);
+                callee = method;
+            }
+        }
+        if (candidates.size() != 1 || callee->parameters.size() != call->arguments.size())
+            return nullptr;
+
+        // only the methods of the same file are inlined, and a method cannot be inlined into itself
+        if (!(contains(package->methods, callee)) || contains(expanding, callee) || !isInlinable(callee))
+            return nullptr;
+        return callee;
+    }
+
+    /**
+     * Determine if the method body can be copied to the place of its calls.
+     * @param method target method
+     * @return true if the method can be inlined
+     */
+    bool MethodInliner::isInlinable(MethodNode* method) {
+        // the body of a native or extern method is not known at compile time
+        if (!method->defined || method->isExternal())
+            return false;
+
+        for (Parameter& parameter : method->parameters) {
+            if (parameter.varargs)
+                return false;
+        }
+
+        // collect the local variables of the method
+        List<UString> locals;
+        for (Parameter& parameter : method->parameters)
+            locals.push_back(parameter.name);
+        uint size = 0;
+        bool copyable = true;
+        NodeWalker::walk(method->body, [&](Node* node) {
+            size++;
+            copyable &= isCopyable(node);
+            if (node->is(NodeType::LocalDeclare))
+                locals.push_back(as(node, LocalDeclare)->name);
+            else if (node->is(NodeType::LocalDeclareAssign))
+                locals.push_back(as(node, LocalDeclareAssign)->name);
+            else if (node->is(NodeType::MultiLocalDeclare)) {
+                for (auto& [name, _] : as(node, MultiLocalDeclare)->locals)
+                    locals.push_back(name);
+            }
+        });
+        if (!copyable || size > INLINE_MAX_SIZE)
+            return false;
+
+        // every variable must be a local of the method, otherwise it would refer to a variable of the caller
+        bool local = true;
+        uint returns = 0;
+        NodeWalker::walk(method->body, [&](Node* node) {
+            if (node->is(NodeType::Value) && as(node, Value)->value.is(TokenType::Identifier))
+                local &= contains(locals, as(node, Value)->value.value);
+            else if (node->is(NodeType::LocalAssign))
+                local &= contains(locals, as(node, LocalAssign)->name);
+            else if (node->is(NodeType::Return))
+                returns++;
+        });
+        if (!local)
+            return false;
+
+        // the method may only return at the end of its body, as the inlined statements cannot jump out of the caller
+        bool returnsValue = getReturnType(method) != U"void";
+        Node* last = method->body.empty() ? nullptr : method->body.back();
+        bool endsWithReturn = last != nullptr && last->is(NodeType::Return);
+        if (returns > (endsWithReturn ? 1 : 0))
+            return false;
+        if (returnsValue)
+            return endsWithReturn && as(last, Return)->value.has_value();
+        return !endsWithReturn || !as(last, Return)->value.has_value();
+    }
+
+    /**
+     * Create the statements that execute the called method in the caller method.
+     * @param callee called method
+     * @param call target method call
+     * @param result the list to append the statements to
+     * @return the copy of the returned value, or null if the method does not return a value
+     */
+    Node* MethodInliner::expand(MethodNode* callee, MethodCall* call, List<Node*>& result) {
+        // rename the variables of the inlined method, so that they do not collide with the variables of the caller
+        // int add(int a, int b) -> a@add0, b@add0
+        UString suffix = U"@" + callee->name + Strings::toUTF(toString(expansions++));
+        Map<UString, UString> names;
+        for (Parameter& parameter : callee->parameters)
+            names[parameter.name] = parameter.name + suffix;
+        NodeWalker::walk(callee->body, [&](Node* node) {
+            if (node->is(NodeType::LocalDeclare))
+                names[as(node, LocalDeclare)->name] = as(node, LocalDeclare)->name + suffix;
+            else if (node->is(NodeType::LocalDeclareAssign))
+                names[as(node, LocalDeclareAssign)->name] = as(node, LocalDeclareAssign)->name + suffix;
+            else if (node->is(NodeType::MultiLocalDeclare)) {
+                for (auto& [name, _] : as(node, MultiLocalDeclare)->locals)
+                    names[name] = name + suffix;
+            }
+        });
+
+        // assign the arguments to the parameters in the order of the call
+        for (uint i = 0; i < callee->parameters.size(); i++) {
+            Parameter& parameter = callee->parameters[i];
+            result.push_back(new LocalDeclareAssign(package, parameter.type, parameter.generics,
+                names[parameter.name], call->arguments[i]));
+        }
+
+        // copy the statements of the method, except the final return
+        Node* value = nullptr;
+        for (Node* node : callee->body) {
+            if (node->is(NodeType::Return)) {
+                if (as(node, Return)->value.has_value())
+                    value = copy(*as(node, Return)->value, names);
+                break;
+            }
+            result.push_back(copy(node, names));
+        }
+        return value;
+    }
+
+    /**
+     * Copy a node of the inlined method and rename its local variables.
+     * @param node target node
+     * @param names the map of the renamed variable names
+     * @return copied node
+     */
+    Node* MethodInliner::copy(Node* node, Map<UString, UString>& names) {
+        switch (node->type) {
+            case NodeType::Value: {
+                Token token = as(node, Value)->value;
+                if (token.is(TokenType::Identifier))
+                    token = Token::of(TokenType::Identifier, names[token.value]);
+                return new Value(package, token);
+            }
+            case NodeType::Operation: {
+                Operation* operation = as(node, Operation);
+                return new Operation(package, copy(operation->left, names), operation->operatorType,
+                    copy(operation->right, names));
+            }
+            case NodeType::SideOperation: {
+                SideOperation* operation = as(node, SideOperation);
+                return new SideOperation(package, operation->operatorType, copy(operation->operand, names), operation->left);
+            }
+            case NodeType::Group:
+                return new Group(package, copy(as(node, Group)->value, names));
+            case NodeType::MethodCall: {
+                MethodCall* call = as(node, MethodCall);
+                return new MethodCall(package, call->name, copyBlock(call->arguments, names));
+            }
+            case NodeType::LocalDeclare: {
+                LocalDeclare* local = as(node, LocalDeclare);
+                return new LocalDeclare(package, local->type, local->generics, names[local->name]);
+            }
+            case NodeType::MultiLocalDeclare: {
+                MultiLocalDeclare* locals = as(node, MultiLocalDeclare);
+                TreeMap<UString, Option<Node*>> copied;
+                for (auto& [name, value] : locals->locals)
+                    copied[names[name]] = value.has_value() ? Option<Node*>(copy(*value, names)) : Option<Node*>();
+                return new MultiLocalDeclare(package, locals->type, locals->generics, copied);
+            }
+            case NodeType::LocalDeclareAssign: {
+                LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                return new LocalDeclareAssign(package, local->type, local->generics, names[local->name],
+                    copy(local->value, names));
+            }
+            case NodeType::LocalAssign: {
+                LocalAssign* assign = as(node, LocalAssign);
+                return new LocalAssign(package, names[assign->name], copy(assign->value, names));
+            }
+            case NodeType::If: {
+                If* statement = as(node, If);
+                If* copied = new If(package, copy(statement->condition, names), copyBlock(statement->body, names));
+                for (ElseIf* elseIf : statement->elseIfs) {
+                    copied->elseIfs.push_back(new ElseIf(package, copy(elseIf->condition, names),
+                        copyBlock(elseIf->body, names)));
+                }
+                if (statement->elseCase != nullptr)
+                    copied->elseCase = new Else(package, copyBlock(statement->elseCase->body, names));
+                return copied;
+            }
+            case NodeType::While: {
+                While* statement = as(node, While);
+                return new While(package, copy(statement->condition, names), copyBlock(statement->body, names));
+            }
+            case NodeType::DoWhile: {
+                DoWhile* statement = as(node, DoWhile);
+                return new DoWhile(package, copyBlock(statement->body, names), copy(statement->condition, names));
+            }
+            case NodeType::Switch: {
+                Switch* statement = as(node, Switch);
+                Switch* copied = new Switch(package, copy(statement->value, names));
+                for (SwitchCase* switchCase : statement->cases)
+                    copied->cases.push_back(new SwitchCase(switchCase->keys, copyBlock(switchCase->body, names)));
+                if (statement->defaultCase != nullptr)
+                    copied->defaultCase = new SwitchCase({}, copyBlock(statement->defaultCase->body, names));
+                return copied;
+            }
+            default:
+                error("Unable to inline node: " << node->type);
+                return nullptr;
+        }
+    }
+
+    /**
+     * Copy the statements of a block of the inlined method.
+     * @param body block statements
+     * @param names the map of the renamed variable names
+     * @return copied statements
+     */
+    List<Node*> MethodInliner::copyBlock(List<Node*>& body, Map<UString, UString>& names) {
+        List<Node*> copied;
+        for (Node* node : body)
+            copied.push_back(copy(node, names));
+        return copied;
+    }
+}
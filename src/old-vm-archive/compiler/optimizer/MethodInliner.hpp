@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+namespace Compiler {
+    /**
+     * The maximum count of the nodes of a method body, that can be inlined.
+     */
+    static const uint INLINE_MAX_SIZE = 32;
+
+    /**
+     * The maximum depth of the nested inlined calls, so that the mutually recursive methods stop expanding.
+     */
+    static const uint INLINE_MAX_DEPTH = 3;
+
+    /**
+     * Represents an optimization pass, that replaces the calls of small methods with the body of the called method.
+     * The parameters and local variables of the inlined method are renamed, so that they get their own slots
+     * in the caller method, and the arguments are assigned to the parameters in the order of the call.
+     * Only the methods of the same source file are inlined, so that the incremental build does not need to
+     * rebuild the callers, when an other file changes the body of an inlined method.
+     * A call nested in an expression is first moved to a new local variable before its statement, if it is the only
+     * call of the expression, and nothing evaluated before it by the expression changes the state of the program.
+     */
+    class MethodInliner {
+    private:
+        /**
+         * The package of the optimized source file.
+         */
+        Package* package;
+
+        /**
+         * The method whose calls are inlined.
+         */
+        MethodNode* caller;
+
+        /**
+         * The methods that are currently being inlined, used for detecting the recursion.
+         */
+        List<MethodNode*> expanding;
+
+        /**
+         * The count of the inlined calls of the current method, used for creating unique variable names.
+         */
+        uint expansions = 0;
+
+    public:
+        /**
+         * The count of the calls that were replaced by the body of the called method.
+         */
+        uint inlined = 0;
+
+        /**
+         * Initialize the method inliner.
+         * @param package optimized package
+         */
+        MethodInliner(Package* package);
+
+        /**
+         * Inline the small method calls of all the methods of the package.
+         */
+        void inlineCalls();
+
+        /**
+         * Inline the small method calls of a method body.
+         * @param method target method
+         */
+        void inlineMethod(MethodNode* method);
+
+    private:
+        /**
+         * Inline the calls of the statements of a block.
+         * @param body block statements
+         * @param depth the count of the inlined methods the block is nested in
+         */
+        void inlineBlock(List<Node*>& body, uint depth);
+
+        /**
+         * Inline the call of a statement.
+         * @param node target statement
+         * @param result the list to append the statement and the inlined statements to
+         * @param depth the count of the inlined methods the statement is nested in
+         */
+        void inlineStatement(Node* node, List<Node*>& result, uint depth);
+
+        /**
+         * Move the method call nested in the expression of a statement to a new local variable before the statement,
+         * so that the call can be inlined the same way as the value of a local declaration.
+         * @param node target statement
+         * @param depth the count of the inlined methods the statement is nested in
+         * @return the declaration of the moved call, or nullptr if the statement does not have a call to move
+         */
+        LocalDeclareAssign* hoistCall(Node* node, uint depth);
+
+        /**
+         * Find the method called by a method call, that can be inlined.
+         * @param call target method call
+         * @param depth the count of the inlined methods the call is nested in
+         * @return called method, or null if the call cannot be inlined
+         */
+        MethodNode* findCallee(MethodCall* call, uint depth);
+
+        /**
+         * Determine if the method body can be copied to the place of its calls.
+         * @param method target method
+         * @return true if the method can be inlined
+         */
+        bool isInlinable(MethodNode* method);
+
+        /**
+         * Create the statements that execute the called method in the caller method.
+         * @param callee called method
+         * @param call target method call
+         * @param result the list to append the statements to
+         * @return the copy of the returned value, or null if the method does not return a value
+         */
+        Node* expand(MethodNode* callee, MethodCall* call, List<Node*>& result);
+
+        /**
+         * Copy a node of the inlined method and rename its local variables.
+         * @param node target node
+         * @param names the map of the renamed variable names
+         * @return copied node
+         */
+        Node* copy(Node* node, Map<UString, UString>& names);
+
+        /**
+         * Copy the statements of a block of the inlined method.
+         * @param body block statements
+         * @param names the map of the renamed variable names
+         * @return copied statements
+         */
+        List<Node*> copyBlock(List<Node*>& body, Map<UString, UString>& names);
+    };
+}
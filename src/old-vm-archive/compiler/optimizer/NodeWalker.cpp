@@ -0,0 +1,173 @@
+#include "NodeWalker.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+namespace Compiler {
+    /**
+     * Call the callback for each direct child node of the given node.
+     * The callback receives a reference to the child, therefore it can replace the child node.
+     * @param node parent node
+     * @param callback the function to be called for each child
+     */
+    void NodeWalker::forEachChild(Node* node, Function<void(Node*&)> callback) {
+        switch (node->type) {
+            case NodeType::MultiLocalDeclare:
+                for (auto& [_, value] : as(node, MultiLocalDeclare)->locals) {
+                    if (value.has_value())
+                        callback(*value);
+                }
+                break;
+            case NodeType::LocalDeclareAssign:
+                callback(as(node, LocalDeclareAssign)->value);
+                break;
+            case NodeType::LocalDeclareDestructure:
+                callback(as(node, LocalDeclareDestructure)->value);
+                break;
+            case NodeType::LocalAssign:
+                callback(as(node, LocalAssign)->value);
+                break;
+            case NodeType::Operation:
+                callback(as(node, Operation)->left);
+                callback(as(node, Operation)->right);
+                break;
+            case NodeType::SideOperation:
+                callback(as(node, SideOperation)->operand);
+                break;
+            case NodeType::JoinOperation:
+                callback(as(node, JoinOperation)->target);
+                for (Node*& child : as(node, JoinOperation)->children)
+                    callback(child);
+                break;
+            case NodeType::Group:
+                callback(as(node, Group)->value);
+                break;
+            case NodeType::MethodCall:
+                for (Node*& argument : as(node, MethodCall)->arguments)
+                    callback(argument);
+                break;
+            case NodeType::New:
+                for (Node*& argument : as(node, NewNode)->arguments)
+                    callback(argument);
+                if (as(node, NewNode)->initializator != nullptr)
+                    callback(as(node, NewNode)->initializator);
+                break;
+            case NodeType::Initializator:
+                for (auto& [_, value] : as(node, Initializator)->members)
+                    callback(value);
+                break;
+            case NodeType::Lambda:
+                for (Node*& statement : as(node, Lambda)->body)
+                    callback(statement);
+                break;
+            case NodeType::IndexFetch:
+                callback(as(node, IndexFetch)->index);
+                break;
+            case NodeType::IndexAssign:
+                callback(as(node, IndexAssign)->index);
+                callback(as(node, IndexAssign)->value);
+                break;
+            case NodeType::Tuple:
+                for (Node*& member : as(node, Tuple)->members)
+                    callback(member);
+                break;
+            case NodeType::Return:
+                if (as(node, Return)->value.has_value())
+                    callback(*as(node, Return)->value);
+                break;
+            case NodeType::Defer:
+                callback(as(node, Defer)->instruction);
+                break;
+            case NodeType::If: {
+                If* statement = as(node, If);
+                callback(statement->condition);
+                for (Node*& child : statement->body)
+                    callback(child);
+                for (ElseIf* elseIf : statement->elseIfs) {
+                    callback(elseIf->condition);
+                    for (Node*& child : elseIf->body)
+                        callback(child);
+                }
+                if (statement->elseCase != nullptr) {
+                    for (Node*& child : statement->elseCase->body)
+                        callback(child);
+                }
+                break;
+            }
+            case NodeType::While:
+                callback(as(node, While)->condition);
+                for (Node*& child : as(node, While)->body)
+                    callback(child);
+                break;
+            case NodeType::DoWhile:
+                for (Node*& child : as(node, DoWhile)->body)
+                    callback(child);
+                callback(as(node, DoWhile)->condition);
+                break;
+            case NodeType::Switch: {
+                Switch* statement = as(node, Switch);
+                callback(statement->value);
+                for (SwitchCase* switchCase : statement->cases) {
+                    for (Node*& child : switchCase->body)
+                        callback(child);
+                }
+                if (statement->defaultCase != nullptr) {
+                    for (Node*& child : statement->defaultCase->body)
+                        callback(child);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    /**
+     * Call the callback for the given node and all of its descendants, parents before their children.
+     * @param node root node
+     * @param callback the function to be called for each node
+     */
+    void NodeWalker::walk(Node* node, Function<void(Node*)> callback) {
+        callback(node);
+        forEachChild(node, [&](Node*& child) {
+            walk(child, callback);
+        });
+    }
+
+    /**
+     * Call the callback for the given statements and all of their descendants.
+     * @param body root statements
+     * @param callback the function to be called for each node
+     */
+    void NodeWalker::walk(List<Node*>& body, Function<void(Node*)> callback) {
+        for (Node* node : body)
+            walk(node, callback);
+    }
+
+    /**
+     * Get the name of the local variable that is referred by the given node.
+     * @param node target node
+     * @return local variable name, or empty if the node is not a variable
+     */
+    UString NodeWalker::getLocalName(Node* node) {
+        if (node->is(NodeType::Group))
+            return getLocalName(as(node, Group)->value);
+        if (!node->is(NodeType::Value) || !as(node, Value)->value.is(TokenType::Identifier))
+            return U"";
+        return as(node, Value)->value.value;
+    }
+
+    /**
+     * Get the name of the local variable that is assigned by the given node.
+     * @param node target node
+     * @return local variable name
+     */
+    UString NodeWalker::requireLocalName(Node* node) {
+        UString name = getLocalName(node);
+        if (name.empty())
+            error("Only local variables can be assigned, found: " << node->type);
+        return name;
+    }
+}
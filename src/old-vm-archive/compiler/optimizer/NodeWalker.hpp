@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+namespace Compiler {
+    /**
+     * Represents a tool for iterating over the nodes of a method body.
+     * The optimization passes use it to reach every nested statement and expression,
+     * so that they only have to handle the node types they are interested in.
+     */
+    namespace NodeWalker {
+        /**
+         * Call the callback for each direct child node of the given node.
+         * The callback receives a reference to the child, therefore it can replace the child node.
+         * @param node parent node
+         * @param callback the function to be called for each child
+         */
+        void forEachChild(Node* node, Function<void(Node*&)> callback);
+
+        /**
+         * Call the callback for the given node and all of its descendants, parents before their children.
+         * @param node root node
+         * @param callback the function to be called for each node
+         */
+        void walk(Node* node, Function<void(Node*)> callback);
+
+        /**
+         * Call the callback for the given statements and all of their descendants.
+         * @param body root statements
+         * @param callback the function to be called for each node
+         */
+        void walk(List<Node*>& body, Function<void(Node*)> callback);
+
+        /**
+         * Get the name of the local variable that is referred by the given node.
+         * @param node target node
+         * @return local variable name, or empty if the node is not a variable
+         */
+        UString getLocalName(Node* node);
+
+        /**
+         * Get the name of the local variable that is assigned by the given node.
+         * @param node target node
+         * @return local variable name
+         */
+        UString requireLocalName(Node* node);
+    }
+}
@@ -0,0 +1,207 @@
+#include "ReachabilityAnalyzer.hpp"
+
+#include "../../util/Strings.hpp"
+
+using namespace Void;
+
+namespace Compiler {
+    /**
+     * The name prefix of the anonymous classes that hold the package methods.
+     */
+    static const UString PACKAGE_PREFIX = U"<package>";
+
+    /**
+     * Split an instruction to its space separated arguments.
+     * @param instruction bytecode instruction
+     * @return instruction arguments without the indentation
+     */
+    static List<UString> getArguments(UString& instruction) {
+        List<UString> arguments;
+        for (UString& argument : Strings::split(instruction, ' ')) {
+            if (!argument.empty())
+                arguments.push_back(argument);
+        }
+        return arguments;
+    }
+
+    /**
+     * Remove the methods and classes that are not reachable from the main methods.
+     * If the bytecode does not have a main method, it is a library, and every declaration is kept.
+     * @param bytecode linked bytecode
+     */
+    void ReachabilityAnalyzer::prune(List<UString>& bytecode) {
+        parse(bytecode);
+
+        // the program is started from the main method of a package
+        for (uint i = 0; i < methods.size(); i++) {
+            if (methods[i].name == U"main" && methods[i].owner.starts_with(PACKAGE_PREFIX))
+                markMethod(i);
+        }
+        if (pending.empty())
+            return;
+
+        // follow the calls and type references of the reachable methods
+        while (!pending.empty()) {
+            BytecodeMethod& method = methods[pending.back()];
+            pending.pop_back();
+            for (uint i = method.begin; i <= method.end; i++)
+                analyze(bytecode[i]);
+        }
+
+        // remove the lines of the unreachable declarations
+        List<bool> removed(bytecode.size(), false);
+        for (BytecodeClass& type : classes) {
+            bool package = type.name.starts_with(PACKAGE_PREFIX);
+            uint kept = 0;
+            for (uint index : type.methods) {
+                BytecodeMethod& method = methods[index];
+                if (method.reachable) {
+                    kept++;
+                    continue;
+                }
+                for (uint i = method.begin; i <= method.end; i++)
+                    removed[i] = true;
+                removedMethods++;
+            }
+
+            // the package classes only exist to hold the package methods
+            if ((package && kept == 0) || (!package && !type.reachable)) {
+                for (uint i = type.begin; i <= type.end; i++)
+                    removed[i] = true;
+                removedClasses++;
+            }
+        }
+
+        List<UString> result;
+        for (uint i = 0; i < bytecode.size(); i++) {
+            if (!removed[i])
+                result.push_back(bytecode[i]);
+        }
+        bytecode = result;
+    }
+
+    /**
+     * Find the class and method blocks of the bytecode.
+     * @param bytecode linked bytecode
+     */
+    void ReachabilityAnalyzer::parse(List<UString>& bytecode) {
+        for (uint i = 0; i < bytecode.size(); i++) {
+            List<UString> arguments = getArguments(bytecode[i]);
+            if (arguments.empty())
+                continue;
+            UString& instruction = arguments[0];
+
+            // cdef <package>main
+            if (instruction == U"cdef" && arguments.size() > 1) {
+                BytecodeClass type;
+                type.name = arguments[1];
+                type.begin = i;
+                classIndices[type.name] = (uint) classes.size();
+                classes.push_back(type);
+            }
+            else if (instruction == U"cend" && !classes.empty())
+                classes.back().end = i;
+
+            // mdef foo
+            else if (instruction == U"mdef" && arguments.size() > 1 && !classes.empty()) {
+                BytecodeMethod method;
+                method.owner = classes.back().name;
+                method.name = arguments[1];
+                method.begin = i;
+                classes.back().methods.push_back((uint) methods.size());
+                methods.push_back(method);
+            }
+            // mparam I J
+            else if (instruction == U"mparam" && !methods.empty()) {
+                for (uint j = 1; j < arguments.size(); j++)
+                    methods.back().parameters += (j > 1 ? U" " : U"") + arguments[j];
+            }
+            else if (instruction == U"mend" && !methods.empty()) {
+                BytecodeMethod& method = methods.back();
+                method.end = i;
+                methodIndices[getKey(method.owner, method.name, method.parameters)] = (uint) methods.size() - 1;
+            }
+        }
+    }
+
+    /**
+     * Mark the method as reachable and queue it for analysis.
+     * @param index method index
+     */
+    void ReachabilityAnalyzer::markMethod(uint index) {
+        if (methods[index].reachable)
+            return;
+        methods[index].reachable = true;
+        pending.push_back(index);
+    }
+
+    /**
+     * Mark the class as reachable. The instance methods of the classes are kept,
+     * as the virtual calls cannot be resolved statically.
+     * @param index class index
+     */
+    void ReachabilityAnalyzer::markClass(uint index) {
+        BytecodeClass& type = classes[index];
+        if (type.reachable)
+            return;
+        type.reachable = true;
+        if (type.name.starts_with(PACKAGE_PREFIX))
+            return;
+        for (uint method : type.methods)
+            markMethod(method);
+    }
+
+    /**
+     * Mark the methods and classes that are referenced by an instruction.
+     * @param instruction bytecode instruction
+     */
+    void ReachabilityAnalyzer::analyze(UString instruction) {
+        List<UString> arguments = getArguments(instruction);
+        if (arguments.empty())
+            return;
+
+        // invokestatic <package>main add I I
+        // the static calls are resolved to the exact overload
+        if (arguments[0] == U"invokestatic" && arguments.size() > 2) {
+            UString parameters;
+            for (uint i = 3; i < arguments.size(); i++)
+                parameters += (i > 3 ? U" " : U"") + arguments[i];
+            auto method = methodIndices.find(getKey(arguments[1], arguments[2], parameters));
+            if (method != methodIndices.end())
+                markMethod(method->second);
+        }
+
+        // invokevirtual Foo bar
+        // keep every overload of the other calls
+        else if (arguments[0].starts_with(U"invoke") && arguments.size() > 2) {
+            auto owner = classIndices.find(arguments[1]);
+            if (owner != classIndices.end()) {
+                for (uint method : classes[owner->second].methods) {
+                    if (methods[method].name == arguments[2])
+                        markMethod(method);
+                }
+            }
+        }
+
+        // mparam LFoo
+        // any argument that names a class, or a type descriptor of a class keeps the class
+        for (UString& argument : arguments) {
+            auto type = classIndices.find(argument);
+            if (type == classIndices.end() && argument.size() > 1 && argument[0] == 'L')
+                type = classIndices.find(argument.substr(1));
+            if (type != classIndices.end())
+                markClass(type->second);
+        }
+    }
+
+    /**
+     * Get the lookup key of a method.
+     * @param owner method owner class
+     * @param name method name
+     * @param parameters method parameter descriptors
+     * @return method lookup key
+     */
+    UString ReachabilityAnalyzer::getKey(UString owner, UString name, UString parameters) {
+        return owner + U" " + name + U"(" + parameters + U")";
+    }
+}
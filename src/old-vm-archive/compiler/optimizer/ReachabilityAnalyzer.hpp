@@ -0,0 +1,158 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Compiler {
+    /**
+     * Represents a method block of the linked bytecode.
+     */
+    class BytecodeMethod {
+    public:
+        /**
+         * The name of the class that declares the method.
+         */
+        UString owner;
+
+        /**
+         * The name of the method.
+         */
+        UString name;
+
+        /**
+         * The parameter type descriptors of the method separated by spaces.
+         */
+        UString parameters;
+
+        /**
+         * The index of the "mdef" line of the method.
+         */
+        uint begin = 0;
+
+        /**
+         * The index of the "mend" line of the method.
+         */
+        uint end = 0;
+
+        /**
+         * Determine if the method can be called from the entry point.
+         */
+        bool reachable = false;
+    };
+
+    /**
+     * Represents a class block of the linked bytecode.
+     */
+    class BytecodeClass {
+    public:
+        /**
+         * The name of the class.
+         */
+        UString name;
+
+        /**
+         * The index of the "cdef" line of the class.
+         */
+        uint begin = 0;
+
+        /**
+         * The index of the "cend" line of the class.
+         */
+        uint end = 0;
+
+        /**
+         * The indices of the methods declared by the class.
+         */
+        List<uint> methods;
+
+        /**
+         * Determine if the class is referenced by a reachable method.
+         */
+        bool reachable = false;
+    };
+
+    /**
+     * Represents a whole-program optimization pass, that removes the methods and classes from the linked bytecode,
+     * which cannot be reached from the main methods. The pass works on the bytecode instead of the parsed nodes,
+     * so that the bytecode of the files reused from the previous build is analyzed the same way as the rebuilt ones.
+     */
+    class ReachabilityAnalyzer {
+    private:
+        /**
+         * The class blocks of the bytecode.
+         */
+        List<BytecodeClass> classes;
+
+        /**
+         * The method blocks of the bytecode.
+         */
+        List<BytecodeMethod> methods;
+
+        /**
+         * The map of the class indices by the class names.
+         */
+        Map<UString, uint> classIndices;
+
+        /**
+         * The map of the method indices by the owner class, method name and parameter descriptors.
+         */
+        Map<UString, uint> methodIndices;
+
+        /**
+         * The indices of the reachable methods whose instructions have not been analyzed yet.
+         */
+        List<uint> pending;
+
+    public:
+        /**
+         * The count of the methods that were removed.
+         */
+        uint removedMethods = 0;
+
+        /**
+         * The count of the classes that were removed.
+         */
+        uint removedClasses = 0;
+
+        /**
+         * Remove the methods and classes that are not reachable from the main methods.
+         * If the bytecode does not have a main method, it is a library, and every declaration is kept.
+         * @param bytecode linked bytecode
+         */
+        void prune(List<UString>& bytecode);
+
+    private:
+        /**
+         * Find the class and method blocks of the bytecode.
+         * @param bytecode linked bytecode
+         */
+        void parse(List<UString>& bytecode);
+
+        /**
+         * Mark the method as reachable and queue it for analysis.
+         * @param index method index
+         */
+        void markMethod(uint index);
+
+        /**
+         * Mark the class as reachable. The instance methods of the classes are kept,
+         * as the virtual calls cannot be resolved statically.
+         * @param index class index
+         */
+        void markClass(uint index);
+
+        /**
+         * Mark the methods and classes that are referenced by an instruction.
+         * @param instruction bytecode instruction
+         */
+        void analyze(UString instruction);
+
+        /**
+         * Get the lookup key of a method.
+         * @param owner method owner class
+         * @param name method name
+         * @param parameters method parameter descriptors
+         * @return method lookup key
+         */
+        static UString getKey(UString owner, UString name, UString parameters);
+    };
+}
@@ -0,0 +1,461 @@
+#include "ScalarReplacer.hpp"
+#include "NodeWalker.hpp"
+
+#include "../builder/Package.hpp"
+
+namespace Compiler {
+    /**
+     * Get the name of the local variable that holds a member of a replaced struct.
+     * @param variable struct variable name
+     * @param field struct member
+     * @return member variable name
+     */
+    static UString getMemberName(UString variable, StructField& field) {
+        return variable + U"@" + field.name;
+    }
+
+    /**
+     * Determine if a struct member can be stored in a local variable.
+     * @param type member type
+     * @param generics member type generics
+     * @param value default member value, or null
+     * @return true if the member is a single value without generics
+     */
+    static bool isScalar(Token& type, List<Token>& generics, Node* value) {
+        // the members of struct types would have to be replaced recursively
+        if (!type.is(TokenType::Type) || type.is(TokenType::Type, U"let") || !generics.empty())
+            return false;
+        // the default value is copied to each replaced struct, therefore only literals are allowed
+        return value == nullptr || value->is(NodeType::Value);
+    }
+
+    /**
+     * Initialize the struct field.
+     * @param name member name
+     * @param type member type
+     * @param value default member value
+     */
+    StructField::StructField(UString name, Token type, Node* value)
+        : name(name), type(type), value(value)
+    { }
+
+    /**
+     * Initialize the scalar replacer.
+     * @param package optimized package
+     */
+    ScalarReplacer::ScalarReplacer(Package* package)
+        : package(package)
+    { }
+
+    /**
+     * Replace the non-escaping struct values of all the methods of the package.
+     */
+    void ScalarReplacer::replace() {
+        collectLayouts();
+        if (layouts.empty())
+            return;
+        for (MethodNode* method : package->methods)
+            replaceMethod(method);
+    }
+
+    /**
+     * Replace the non-escaping struct values of a method body.
+     * @param method target method
+     */
+    void ScalarReplacer::replaceMethod(MethodNode* method) {
+        collectCandidates(method);
+        removeEscaping(method);
+        replaceBlock(method->body);
+        for (Node*& node : method->body)
+            replaceExpression(node);
+    }
+
+    /**
+     * Collect the members of the structs of the package, whose members can be stored in local variables.
+     */
+    void ScalarReplacer::collectLayouts() {
+        // struct Point(int x, int y)
+        for (auto& [name, type] : package->tupleStructs) {
+            List<StructField> fields;
+            bool scalar = true;
+            for (TupleParameter& parameter : type->parameters) {
+                scalar &= parameter.dimensions == 0 && isScalar(parameter.type, parameter.generics, nullptr);
+                fields.push_back(StructField(parameter.name, parameter.type, nullptr));
+            }
+            if (scalar)
+                layouts[name] = fields;
+        }
+
+        // struct Person { string name; uint age }
+        for (auto& [name, type] : package->structs) {
+            List<StructField> fields;
+            bool scalar = true;
+            for (Node* node : type->body) {
+                if (node->is(NodeType::Field)) {
+                    FieldNode* field = as(node, FieldNode);
+                    Node* value = field->value.has_value() ? *field->value : nullptr;
+                    scalar &= isScalar(field->type, field->generics, value);
+                    fields.push_back(StructField(field->name, field->type, value));
+                }
+                else if (node->is(NodeType::MultiField)) {
+                    MultiField* field = as(node, MultiField);
+                    for (auto& [fieldName, fieldValue] : field->fields) {
+                        Node* value = fieldValue.has_value() ? *fieldValue : nullptr;
+                        scalar &= isScalar(field->type, field->generics, value);
+                        fields.push_back(StructField(fieldName, field->type, value));
+                    }
+                }
+                else
+                    scalar = false;
+            }
+            if (scalar)
+                layouts[name] = fields;
+        }
+    }
+
+    /**
+     * Collect the struct local variables of a method, that are declared once by a new struct or a copy.
+     * @param method target method
+     */
+    void ScalarReplacer::collectCandidates(MethodNode* method) {
+        candidates.clear();
+        Map<UString, uint> declarations;
+        for (Parameter& parameter : method->parameters)
+            declarations[parameter.name]++;
+
+        NodeWalker::walk(method->body, [&](Node* node) {
+            if (node->is(NodeType::LocalDeclare))
+                declarations[as(node, LocalDeclare)->name]++;
+            else if (node->is(NodeType::MultiLocalDeclare)) {
+                for (auto& [name, _] : as(node, MultiLocalDeclare)->locals)
+                    declarations[name]++;
+            }
+            else if (node->is(NodeType::LocalDeclareDestructure)) {
+                for (UString& member : as(node, LocalDeclareDestructure)->members)
+                    declarations[member]++;
+            }
+            else if (node->is(NodeType::LocalDeclareAssign)) {
+                LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                declarations[local->name]++;
+
+                // let a = new Point(2, 3)
+                UString type;
+                List<Node*> values;
+                if (local->value->is(NodeType::New) && getMemberValues(as(local->value, NewNode), values))
+                    type = as(local->value, NewNode)->name;
+                // Point b = a
+                // the nodes are visited in source order, therefore the copied variable is already known
+                else {
+                    auto copied = candidates.find(NodeWalker::getLocalName(local->value));
+                    if (copied == candidates.end())
+                        return;
+                    type = copied->second;
+                }
+                if (local->type.is(TokenType::Type, U"let") || local->type.is(TokenType::Identifier, type))
+                    candidates[local->name] = type;
+            }
+        });
+
+        // the same name may refer to different variables in different scopes, leave those untouched
+        for (auto& [name, count] : declarations) {
+            if (count > 1)
+                candidates.erase(name);
+        }
+    }
+
+    /**
+     * Remove the struct local variables, that are used in any other way than accessing their members,
+     * destructuring or copying them to an other candidate. Repeated until no more variables escape.
+     * @param method target method
+     */
+    void ScalarReplacer::removeEscaping(MethodNode* method) {
+        while (!candidates.empty()) {
+            Map<UString, uint> references;
+            Map<UString, uint> allowed;
+            for (Node* node : method->body)
+                countReferences(node, references, allowed);
+
+            List<UString> escaping;
+            for (auto& [name, count] : references) {
+                if (allowed[name] != count)
+                    escaping.push_back(name);
+            }
+            // Point b = a
+            // a copy can only be replaced, if the copied struct is replaced as well
+            NodeWalker::walk(method->body, [&](Node* node) {
+                if (!node->is(NodeType::LocalDeclareAssign))
+                    return;
+                LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                UString copied = NodeWalker::getLocalName(local->value);
+                if (isCandidate(local->name) && !copied.empty() && !isCandidate(copied))
+                    escaping.push_back(local->name);
+            });
+
+            if (escaping.empty())
+                return;
+            for (UString& name : escaping)
+                candidates.erase(name);
+        }
+    }
+
+    /**
+     * Count the references of the candidate variables in an expression or statement.
+     * @param node target node
+     * @param references the map of the reference counts of the variables
+     * @param allowed the map of the counts of the references that do not make the variables escape
+     */
+    void ScalarReplacer::countReferences(Node* node, Map<UString, uint>& references, Map<UString, uint>& allowed) {
+        switch (node->type) {
+            // a
+            case NodeType::Value: {
+                UString name = NodeWalker::getLocalName(node);
+                if (isCandidate(name))
+                    references[name]++;
+                return;
+            }
+
+            // a.x
+            case NodeType::JoinOperation: {
+                JoinOperation* operation = as(node, JoinOperation);
+                UString variable;
+                if (getMember(operation, variable) >= 0) {
+                    references[variable]++;
+                    allowed[variable]++;
+                    return;
+                }
+                // the names of the accessed members are not variable references
+                countReferences(operation->target, references, allowed);
+                for (Node* child : operation->children) {
+                    if (!child->is(NodeType::Value))
+                        countReferences(child, references, allowed);
+                }
+                return;
+            }
+
+            // let (x, y) = a
+            case NodeType::LocalDeclareDestructure: {
+                LocalDeclareDestructure* local = as(node, LocalDeclareDestructure);
+                auto candidate = candidates.find(NodeWalker::getLocalName(local->value));
+                if (candidate != candidates.end() && local->members.size() == layouts[candidate->second].size()) {
+                    references[candidate->first]++;
+                    allowed[candidate->first]++;
+                    return;
+                }
+                break;
+            }
+
+            // Point b = a
+            case NodeType::LocalDeclareAssign: {
+                LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                UString copied = NodeWalker::getLocalName(local->value);
+                if (isCandidate(copied) && isCandidate(local->name)) {
+                    references[copied]++;
+                    allowed[copied]++;
+                    return;
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+        NodeWalker::forEachChild(node, [&](Node*& child) {
+            countReferences(child, references, allowed);
+        });
+    }
+
+    /**
+     * Determine if the local variable is a struct that does not escape.
+     * @param name variable name
+     * @return true if the variable can be replaced
+     */
+    bool ScalarReplacer::isCandidate(UString name) {
+        return candidates.find(name) != candidates.end();
+    }
+
+    /**
+     * Get the member values of a new struct in the order of the struct members.
+     * @param node new struct node
+     * @param values the list to append the member values to, a null value resets the member
+     * @return true if the struct can be created without an instance
+     */
+    bool ScalarReplacer::getMemberValues(NewNode* node, List<Node*>& values) {
+        auto layout = layouts.find(node->name);
+        if (layout == layouts.end())
+            return false;
+        List<StructField>& fields = layout->second;
+
+        // new Point(2, 3)
+        if (node->initializator == nullptr) {
+            if (node->arguments.size() != fields.size())
+                return false;
+            values.insert(values.end(), node->arguments.begin(), node->arguments.end());
+            return true;
+        }
+
+        // new Point { x: 2, y: 3 }
+        if (!node->arguments.empty() || !node->initializator->is(NodeType::Initializator))
+            return false;
+        TreeMap<UString, Node*>& members = as(node->initializator, Initializator)->members;
+        for (auto& [name, value] : members) {
+            bool found = false;
+            for (StructField& field : fields)
+                found |= field.name == name;
+            if (!found || value->is(NodeType::Initializator))
+                return false;
+        }
+        for (StructField& field : fields) {
+            auto member = members.find(field.name);
+            if (member != members.end())
+                values.push_back(member->second);
+            // the members missing from the initializator get their default value
+            else if (field.value != nullptr)
+                values.push_back(new Value(package, as(field.value, Value)->value));
+            else
+                values.push_back(nullptr);
+        }
+        return true;
+    }
+
+    /**
+     * Find the member of a struct of a candidate variable.
+     * @param node member access node
+     * @param variable the name of the candidate variable
+     * @return member index, or -1 if the node does not access a member of a candidate
+     */
+    int ScalarReplacer::getMember(JoinOperation* node, UString& variable) {
+        auto candidate = candidates.find(NodeWalker::getLocalName(node->target));
+        if (candidate == candidates.end() || node->children.size() != 1 || !node->children[0]->is(NodeType::Value))
+            return -1;
+        UString member = as(node->children[0], Value)->value.value;
+        List<StructField>& fields = layouts[candidate->second];
+        for (uint i = 0; i < fields.size(); i++) {
+            if (fields[i].name == member) {
+                variable = candidate->first;
+                return (int) i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Replace the candidate declarations, destructurings and member accesses of a block.
+     * @param body block statements
+     */
+    void ScalarReplacer::replaceBlock(List<Node*>& body) {
+        List<Node*> result;
+        for (Node* node : body) {
+            switch (node->type) {
+                // let a = new Point(2, 3) -> int a@x = 2; int a@y = 3
+                // Point b = a -> int b@x = a@x; int b@y = a@y
+                case NodeType::LocalDeclareAssign: {
+                    LocalDeclareAssign* local = as(node, LocalDeclareAssign);
+                    auto candidate = candidates.find(local->name);
+                    if (candidate == candidates.end())
+                        break;
+                    List<StructField>& fields = layouts[candidate->second];
+                    List<UString> names;
+                    List<Node*> values;
+                    for (StructField& field : fields)
+                        names.push_back(getMemberName(local->name, field));
+                    if (local->value->is(NodeType::New))
+                        getMemberValues(as(local->value, NewNode), values);
+                    else {
+                        for (StructField& field : fields)
+                            values.push_back(new Value(package, Token::of(TokenType::Identifier, getMemberName(NodeWalker::getLocalName(local->value), field))));
+                    }
+                    declareMembers(fields, names, values, result);
+                    replaced++;
+                    continue;
+                }
+
+                // let (x, y) = a -> int x = a@x; int y = a@y
+                // let (x, y) = new Point(2, 3) -> int x = 2; int y = 3
+                case NodeType::LocalDeclareDestructure: {
+                    LocalDeclareDestructure* local = as(node, LocalDeclareDestructure);
+                    List<Node*> values;
+                    UString source = NodeWalker::getLocalName(local->value);
+                    auto candidate = candidates.find(source);
+                    if (candidate != candidates.end()) {
+                        List<StructField>& fields = layouts[candidate->second];
+                        for (StructField& field : fields)
+                            values.push_back(new Value(package, Token::of(TokenType::Identifier, getMemberName(source, field))));
+                        declareMembers(fields, local->members, values, result);
+                        continue;
+                    }
+                    if (local->value->is(NodeType::New) && getMemberValues(as(local->value, NewNode), values)
+                            && local->members.size() == values.size()) {
+                        declareMembers(layouts[as(local->value, NewNode)->name], local->members, values, result);
+                        replaced++;
+                        continue;
+                    }
+                    break;
+                }
+
+                case NodeType::If: {
+                    If* statement = as(node, If);
+                    replaceBlock(statement->body);
+                    for (ElseIf* elseIf : statement->elseIfs)
+                        replaceBlock(elseIf->body);
+                    if (statement->elseCase != nullptr)
+                        replaceBlock(statement->elseCase->body);
+                    break;
+                }
+                case NodeType::While:
+                    replaceBlock(as(node, While)->body);
+                    break;
+                case NodeType::DoWhile:
+                    replaceBlock(as(node, DoWhile)->body);
+                    break;
+                case NodeType::Switch: {
+                    Switch* statement = as(node, Switch);
+                    for (SwitchCase* switchCase : statement->cases)
+                        replaceBlock(switchCase->body);
+                    if (statement->defaultCase != nullptr)
+                        replaceBlock(statement->defaultCase->body);
+                    break;
+                }
+                default:
+                    break;
+            }
+            result.push_back(node);
+        }
+        body = result;
+    }
+
+    /**
+     * Replace the member accesses of the candidate variables in an expression.
+     * @param node target expression
+     */
+    void ScalarReplacer::replaceExpression(Node*& node) {
+        // a.x -> a@x
+        if (node->is(NodeType::JoinOperation)) {
+            UString variable;
+            int member = getMember(as(node, JoinOperation), variable);
+            if (member >= 0) {
+                StructField& field = layouts[candidates[variable]][member];
+                node = new Value(package, Token::of(TokenType::Identifier, getMemberName(variable, field)));
+                return;
+            }
+        }
+        NodeWalker::forEachChild(node, [&](Node*& child) {
+            replaceExpression(child);
+        });
+    }
+
+    /**
+     * Declare a local variable for each member of a struct value.
+     * @param fields struct members
+     * @param names the names of the declared variables
+     * @param values the member values, a null value resets the member
+     * @param result the list to append the declarations to
+     */
+    void ScalarReplacer::declareMembers(List<StructField>& fields, List<UString>& names, List<Node*>& values, List<Node*>& result) {
+        for (uint i = 0; i < fields.size(); i++) {
+            if (values[i] != nullptr)
+                result.push_back(new LocalDeclareAssign(package, fields[i].type, {}, names[i], values[i]));
+            else
+                result.push_back(new LocalDeclare(package, fields[i].type, {}, names[i]));
+        }
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../node/Node.hpp"
+
+#include "../node/nodes/ControlFlow.hpp"
+#include "../node/nodes/LocalNode.hpp"
+#include "../node/nodes/MethodNode.hpp"
+#include "../node/nodes/ValueNode.hpp"
+
+namespace Compiler {
+    /**
+     * Represents a member of a struct, that can be stored in a separate local variable.
+     */
+    class StructField {
+    public:
+        /**
+         * The name of the member. The unnamed tuple members are named by their index.
+         */
+        UString name;
+
+        /**
+         * The type of the member.
+         */
+        Token type;
+
+        /**
+         * The default value of the member, or null if the member is initialized to zero.
+         */
+        Node* value;
+
+        /**
+         * Initialize the struct field.
+         * @param name member name
+         * @param type member type
+         * @param value default member value
+         */
+        StructField(UString name, Token type, Node* value);
+    };
+
+    /**
+     * Represents an optimization pass, that replaces the struct values which do not escape their method with
+     * a separate local variable for each of their members. The struct values have value semantics, therefore
+     * a struct local is replaceable, if it is only used for reading and writing its members, destructuring
+     * or copying it to an other replaceable local. Passing the struct to a method, returning it or assigning
+     * it as a whole makes the struct escape, and such struct is kept as an instance.
+     * Only the structs of the same source file are replaced, so that the incremental build does not need to
+     * rebuild the methods, when an other file changes the members of a struct.
+     */
+    class ScalarReplacer {
+    private:
+        /**
+         * The package of the optimized source file.
+         */
+        Package* package;
+
+        /**
+         * The map of the members of the replaceable structs by the struct names.
+         */
+        Map<UString, List<StructField>> layouts;
+
+        /**
+         * The map of the struct names by the local variables of the current method, that do not escape.
+         */
+        Map<UString, UString> candidates;
+
+    public:
+        /**
+         * The count of the struct values that were replaced by their member variables.
+         */
+        uint replaced = 0;
+
+        /**
+         * Initialize the scalar replacer.
+         * @param package optimized package
+         */
+        ScalarReplacer(Package* package);
+
+        /**
+         * Replace the non-escaping struct values of all the methods of the package.
+         */
+        void replace();
+
+        /**
+         * Replace the non-escaping struct values of a method body.
+         * @param method target method
+         */
+        void replaceMethod(MethodNode* method);
+
+    private:
+        /**
+         * Collect the members of the structs of the package, whose members can be stored in local variables.
+         */
+        void collectLayouts();
+
+        /**
+         * Collect the struct local variables of a method, that are declared once by a new struct or a copy.
+         * @param method target method
+         */
+        void collectCandidates(MethodNode* method);
+
+        /**
+         * Remove the struct local variables, that are used in any other way than accessing their members,
+         * destructuring or copying them to an other candidate. Repeated until no more variables escape.
+         * @param method target method
+         */
+        void removeEscaping(MethodNode* method);
+
+        /**
+         * Count the references of the candidate variables in an expression or statement.
+         * @param node target node
+         * @param references the map of the reference counts of the variables
+         * @param allowed the map of the counts of the references that do not make the variables escape
+         */
+        void countReferences(Node* node, Map<UString, uint>& references, Map<UString, uint>& allowed);
+
+        /**
+         * Determine if the local variable is a struct that does not escape.
+         * @param name variable name
+         * @return true if the variable can be replaced
+         */
+        bool isCandidate(UString name);
+
+        /**
+         * Get the member values of a new struct in the order of the struct members.
+         * @param node new struct node
+         * @param values the list to append the member values to, a null value resets the member
+         * @return true if the struct can be created without an instance
+         */
+        bool getMemberValues(NewNode* node, List<Node*>& values);
+
+        /**
+         * Find the member of a struct of a candidate variable.
+         * @param node member access node
+         * @param variable the name of the candidate variable
+         * @return member index, or -1 if the node does not access a member of a candidate
+         */
+        int getMember(JoinOperation* node, UString& variable);
+
+        /**
+         * Replace the candidate declarations, destructurings and member accesses of a block.
+         * @param body block statements
+         */
+        void replaceBlock(List<Node*>& body);
+
+        /**
+         * Replace the member accesses of the candidate variables in an expression.
+         * @param node target expression
+         */
+        void replaceExpression(Node*& node);
+
+        /**
+         * Declare a local variable for each member of a struct value.
+         * @param fields struct members
+         * @param names the names of the declared variables
+         * @param values the member values, a null value resets the member
+         * @param result the list to append the declarations to
+         */
+        void declareMembers(List<StructField>& fields, List<UString>& names, List<Node*>& values, List<Node*>& result);
+    };
+}
@@ -1,4 +1,5 @@
 #include "Tokenizer.hpp"
+#include "../node/Operator.hpp"
 #include "../../util/Strings.hpp"
 
 using namespace Void;
@@ -90,7 +91,29 @@ namespace Compiler {
      * @return new operator token
      */
     Token Tokenizer::nextOperator() {
-        return Token(TokenType::Operator, UString(1, get()));
+        // match the longest operator of the adjacent characters, so the whitespaces separate the operators
+        // x -= y    =>    x  -=  y
+        // x - -y    =>    x  -  -  y
+        uint length;
+        OperatorType type = matchOperator(peek(), at(cursor + 1), at(cursor + 2), length);
+
+        // the safe member operator is not matched before a number, that is the fraction of a ternary value
+        // c ?.5 : 1.5
+        //   ^ the question mark is a ternary operator
+        if (type == OperatorType::SafeMember && isNumber(at(cursor + 2)))
+            length = 1;
+
+        // the second character of a comment marker is not joined with the comment, the transformer looks for the markers
+        // a //= comment
+        //    ^ the '=' belongs to the comment
+        else if (prev() == '/' && (peek() == '/' || peek() == '*'))
+            length = 1;
+
+        // the characters without a matching operator, such as '$', are single operator tokens
+        uint begin = cursor;
+        for (uint i = 0; i < getMax(length, 1u); i++)
+            get();
+        return Token(TokenType::Operator, range(begin, cursor));
     }
 
     /**
@@ -105,6 +128,11 @@ namespace Compiler {
                 type = TokenType::Semicolon;
                 break;
             case ':':
+                // handle the "::" scope operator, that is the only operator that begins with a separator
+                if (peek() == ':') {
+                    get();
+                    return Token(TokenType::Operator, U"::");
+                }
                 type = TokenType::Colon;
                 break;
             case ',':
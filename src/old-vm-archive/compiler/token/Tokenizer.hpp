@@ -255,7 +255,7 @@ namespace Compiler {
         * @param c target character to test
         * @return true if the token is a type
         */
-        bool isType(UString token);
+        static bool isType(UString token);
 
         /**
         * Check if the given token is a modifier token.
@@ -36,9 +36,11 @@ namespace Compiler {
                 }
             }
             // check if the token after is one of the forbidden tokens
+            // the operators are checked by their first character, so that "==" continues the line the same way as "="
+            Token after = nextToken.is(TokenType::Operator) ? Token::of(TokenType::Operator, nextToken.value.substr(0, 1)) : nextToken;
             bool forbiddenAfter = false;
             for (Token element : FORBIDDEN_AFTER) {
-                if (equals(element, nextToken)) {
+                if (equals(element, after)) {
                     forbiddenAfter = true;
                     break;
                 }
@@ -129,13 +131,14 @@ namespace Compiler {
         if (!token.is(TokenType::Operator, U"/") || !nextToken.is(TokenType::Operator, U"*"))
             return;
         // loop until the comment block is ended
-        while (true) {
+        // the tokens are checked one by one, as an operator of multiple characters may be placed inside the comment
+        while (hasNext()) {
             Token first = safeGet(cursor++);
-            Token second = safeGet(cursor++);
-            if (first.is(TokenType::Operator, U"*") && second.is(TokenType::Operator, U"/")) {
-                update();
-                return;
+            if (first.is(TokenType::Operator, U"*") && safeGet(cursor).is(TokenType::Operator, U"/")) {
+                cursor++;
+                break;
             }
         }
+        update();
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Exceptions.hpp"
+#include "../vm/runtime/Console.hpp"
 
 namespace Void {
     /**
@@ -67,6 +68,8 @@ namespace Void {
             // ignore manual program exits
             if (exception == CONTROL_C_EXIT)
                 return EXCEPTION_CONTINUE_SEARCH;
+            // write the output of the program before the exception
+            Console::flush();
             // notify the console of the exception
             println('\n' << "[Void] A windows-level exception occurred: "
                 << getName(exception) << " (" << exception << ")"
@@ -0,0 +1,52 @@
+#include "Threads.hpp"
+
+#include <thread>
+#include <atomic>
+
+namespace Void {
+    /**
+     * Get the count of the threads that can run concurrently on this machine.
+     * @return hardware thread count, at least 1
+     */
+    uint Threads::hardwareThreads() {
+        uint count = std::thread::hardware_concurrency();
+        return count > 0 ? count : 1;
+    }
+
+    /**
+     * Run the task for every index in the range on a pool of worker threads.
+     * The workers take the next unprocessed index, therefore slow tasks do not block the others.
+     * @param size the count of the indices to be processed
+     * @param threads the maximum count of the worker threads
+     * @param task the task to be called for each index
+     */
+    void Threads::forEach(uint size, uint threads, Function<void(uint)> task) {
+        // do not start more workers than the count of the tasks
+        if (threads > size)
+            threads = size;
+
+        // run the tasks on the current thread if there is nothing to distribute
+        if (threads <= 1) {
+            for (uint i = 0; i < size; i++)
+                task(i);
+            return;
+        }
+
+        // the index of the next task to be claimed by a worker
+        std::atomic<uint> next = 0;
+        auto worker = [&]() {
+            for (uint i = next++; i < size; i = next++)
+                task(i);
+        };
+
+        // start the workers, the current thread is used as the last worker
+        List<std::thread> workers;
+        for (uint i = 0; i < threads - 1; i++)
+            workers.emplace_back(worker);
+        worker();
+
+        // wait for all the tasks to be completed
+        for (std::thread& thread : workers)
+            thread.join();
+    }
+}
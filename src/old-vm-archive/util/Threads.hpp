@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../Common.hpp"
+
+namespace Void {
+    /**
+     * Represents a tool for running independent tasks on multiple worker threads.
+     */
+    namespace Threads {
+        /**
+         * Get the count of the threads that can run concurrently on this machine.
+         * @return hardware thread count, at least 1
+         */
+        uint hardwareThreads();
+
+        /**
+         * Run the task for every index in the range on a pool of worker threads.
+         * The workers take the next unprocessed index, therefore slow tasks do not block the others.
+         * @param size the count of the indices to be processed
+         * @param threads the maximum count of the worker threads
+         * @param task the task to be called for each index
+         */
+        void forEach(uint size, uint threads, Function<void(uint)> task);
+    }
+}
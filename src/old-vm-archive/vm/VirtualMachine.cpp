@@ -3,6 +3,9 @@
 #include "../util/Strings.hpp"
 #include "../util/Lists.hpp"
 #include "parser/Instruction.hpp"
+#include "element/Method.hpp"
+#include "runtime/Vectors.hpp"
+#include "../util/Threads.hpp"
 
 namespace Void {
     /**
@@ -10,8 +13,10 @@ namespace Void {
      * @param options command line options
      */
     VirtualMachine::VirtualMachine(Options& options)
-        : options(options)
-    { }
+        : options(options) {
+        // select the vector kernels before any vector instruction could be executed
+        Vectors::initialize(options);
+    }
 
     /**
      * Load bytecode to the virtual machine dynamically.
@@ -52,15 +57,11 @@ namespace Void {
                     // mark the class declaration ended
                     contentBegun = false;
 
-                    // check if the class name is already in use
-                    if (getClass(name) != nullptr)
-                        error("ClassRedefineException: Class '" << name << "' is already defined.");
-
-                    // define the class in the virtual machine
+                    // make the class build its content, before it is visible to the other threads
                     Class* clazz = new Class(name, superclass, modifiers, interfaces, this);
-                    defineClass(clazz);
-                    // make the class build its content
                     clazz->build(content);
+                    // define the class in the virtual machine
+                    defineClass(clazz);
 
                     // reset the class declaration variables
                     name = "<unk>";
@@ -106,8 +107,8 @@ namespace Void {
      * Debug the runtime data of the virtual machine.
      */
     void VirtualMachine::debug() {
-        for (Class* clazz : classes)
-            clazz->debug();
+        for (uint i = 0, count = classes.size(); i < count; i++)
+            classes.at(i)->debug();
     }
 
     /**
@@ -116,22 +117,45 @@ namespace Void {
      * @param class retrieved class or nullptr if missing
      */
     Class* VirtualMachine::getClass(String name) {
-        // loop through the loaded classes
-        for (Class* clazz : classes) {
-            // check if the class name matches the test
-            if (clazz->name == name)
-                return clazz;
-        }
-        // class not found, return null class 
-        return nullptr;
+        return classes.get(name);
     }
 
     /**
-     * Define a new class in the virtual machine.
+     * Define a new class in the virtual machine. The class must be built before it is defined,
+     * as the other threads may use it right after it has been defined.
      * @param class class to add
      */
     void VirtualMachine::defineClass(Class* clazz) {
-        classes.push_back(clazz);
+        // check if the class name is already in use, the table does not let an other thread define it meanwhile
+        if (!classes.insert(clazz))
+            error("ClassRedefineException: Class '" << clazz->name << "' is already defined.");
+        hierarchyVersion.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * Get the only method that a virtual call can invoke, using the loaded class hierarchy.
+     * A call has a single target, if the method or its class is final, or none of the loaded
+     * subclasses of the receiver class override the method.
+     * @param clazz static receiver class
+     * @param method method resolved from the receiver class
+     * @return the single target method, or nullptr if the call must be dispatched by the receiver
+     */
+    Method* VirtualMachine::devirtualize(Class* clazz, Method* method) {
+        // final, private and static methods cannot be overridden
+        if (method->hasModifier(Modifier::FINAL) || method->hasModifier(Modifier::PRIVATE)
+            || method->hasModifier(Modifier::STATIC) || hasModifier(clazz->modifiers, Modifier::FINAL))
+            return method;
+
+        // check if any of the loaded subclasses of the receiver class declares the method again
+        for (uint i = 0, count = classes.size(); i < count; i++) {
+            Class* other = classes.at(i);
+            if (other == clazz || !other->isSubclassOf(clazz))
+                continue;
+            Method* override = other->findMethod(method->name, method->parameters);
+            if (override != nullptr && override != method)
+                return nullptr;
+        }
+        return method;
     }
 
     /**
@@ -139,8 +163,212 @@ namespace Void {
      * @param heap root program stack
      */
     void VirtualMachine::initialize(Stack* heap) {
-        // loop through the defined classes
-        for (Class* clazz : classes)
-            clazz->initialize(heap);
+        // the classes defined by the static constructors are not initialized by this call
+        for (uint i = 0, count = classes.size(); i < count; i++)
+            classes.at(i)->initialize(heap);
+    }
+
+    /**
+     * Start executing a static method on a new thread. The arguments of the method are moved
+     * from the caller stack to the root stack of the thread.
+     * @param method executed static method
+     * @param caller the stack that holds the arguments
+     * @return started thread
+     */
+    Thread* VirtualMachine::startThread(Method* method, Stack* caller) {
+        // the arguments are pulled in the order of the parameters, as the method pulls them from the heap
+        Stack* heap = new Stack(nullptr, nullptr, "Thread");
+        for (String parameter : method->parameters)
+            Thread::transfer(parameter[0], caller, heap);
+
+        std::lock_guard<std::mutex> lock(threadLock);
+        Thread* thread = new Thread((uint) threads.size(), method, heap);
+        threads.push_back(thread);
+        return thread;
+    }
+
+    /**
+     * Retrieve a started thread by its identifier.
+     * @param id thread identifier
+     * @return retrieved thread or nullptr if missing
+     */
+    Thread* VirtualMachine::getThread(uint id) {
+        std::lock_guard<std::mutex> lock(threadLock);
+        return id < threads.size() ? threads[id] : nullptr;
+    }
+
+    /**
+     * Wait until every started thread returns, including the threads that are started meanwhile.
+     */
+    void VirtualMachine::joinThreads() {
+        for (uint i = 0; ; i++) {
+            Thread* thread = getThread(i);
+            if (thread == nullptr)
+                return;
+            thread->join();
+        }
+    }
+
+    /**
+     * Get the task pool of the virtual machine, and start it if it is not running yet.
+     * The "-XTaskWorkers" option sets the count of the worker threads.
+     * @return running task pool
+     */
+    TaskPool* VirtualMachine::getTasks() {
+        std::call_once(tasksStarted, [this]() {
+            uint workers = Threads::hardwareThreads();
+            if (options.has("XTaskWorkers")) {
+                int count = stringToInt(options.get("XTaskWorkers"));
+                if (count <= 0)
+                    error("Invalid task worker count '" << options.get("XTaskWorkers") << "'. The count must be positive");
+                workers = (uint) count;
+            }
+            tasks.store(new TaskPool(workers), std::memory_order_release);
+        });
+        return tasks.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Create a new empty future.
+     * @param type the type descriptor of the result value
+     * @return created future
+     */
+    Future* VirtualMachine::createFuture(char type) {
+        TaskPool* pool = getTasks();
+        std::unique_lock<std::shared_mutex> lock(futureLock);
+        Future* future = new Future((uint) futures.size(), type, pool);
+        futures.push_back(future);
+        return future;
+    }
+
+    /**
+     * Retrieve a created future by its identifier.
+     * @param id future identifier
+     * @return retrieved future or nullptr if missing
+     */
+    Future* VirtualMachine::getFuture(uint id) {
+        std::shared_lock<std::shared_mutex> lock(futureLock);
+        return id < futures.size() ? futures[id] : nullptr;
+    }
+
+    /**
+     * Submit a static method to the task pool. The arguments of the method are moved from the caller stack,
+     * and the returned future is completed with the result of the method.
+     * @param method executed static method
+     * @param caller the stack that holds the arguments
+     * @return the future of the result
+     */
+    Future* VirtualMachine::submitTask(Method* method, Stack* caller) {
+        Stack* heap = new Stack(nullptr, nullptr, "Task");
+        for (String parameter : method->parameters)
+            Thread::transfer(parameter[0], caller, heap);
+
+        Future* future = createFuture(method->returnType[0]);
+        getTasks()->submit([this, method, heap, future]() {
+            Fiber* fiber = new Fiber(true);
+            method->call(fiber, heap, nullptr);
+            runTask(fiber, heap, future);
+        });
+        return future;
+    }
+
+    /**
+     * Submit a static method to the task pool, after a future has been completed. The result of the future is
+     * passed as the last argument, the other arguments are moved from the caller stack right away.
+     * The returned future fails, if the source future has failed.
+     * @param source the future, that the method waits for
+     * @param method executed static method
+     * @param caller the stack that holds the other arguments
+     * @return the future of the result, or nullptr if the last parameter does not accept the result
+     */
+    Future* VirtualMachine::chainTask(Future* source, Method* method, Stack* caller) {
+        // the last parameter of the method receives the result of the source future
+        uint count = (uint) method->parameters.size();
+        if (source->type != 'V') {
+            if (count == 0 || method->parameters[count - 1][0] != source->type)
+                return nullptr;
+            count--;
+        }
+        Stack* heap = new Stack(nullptr, nullptr, "Task");
+        for (uint i = 0; i < count; i++)
+            Thread::transfer(method->parameters[i][0], caller, heap);
+
+        Future* future = createFuture(method->returnType[0]);
+        source->then([this, method, heap, future](Future* completed) {
+            if (completed->getState() == Future::State::FAILED) {
+                future->fail(completed->getError());
+                return;
+            }
+            completed->copyValue(heap);
+            Fiber* fiber = new Fiber(true);
+            method->call(fiber, heap, nullptr);
+            runTask(fiber, heap, future);
+        });
+        return future;
+    }
+
+    /**
+     * Wait until every submitted task is run, if the task pool has been started.
+     */
+    void VirtualMachine::waitTasks() {
+        TaskPool* pool = tasks.load(std::memory_order_acquire);
+        if (pool != nullptr)
+            pool->waitIdle();
+    }
+
+    /**
+     * Create a generator of the values, that a static method yields. The arguments of the method are moved
+     * from the caller stack to the root stack of the generator.
+     * @param method the method, that yields the values
+     * @param caller the stack that holds the arguments
+     * @return created generator, or nullptr if the method is a native function
+     */
+    Generator* VirtualMachine::createGenerator(Method* method, Stack* caller) {
+        // a native function cannot be suspended, as it is executed on the native stack
+        if (method->external)
+            return nullptr;
+        Stack* heap = new Stack(nullptr, nullptr, "Generator");
+        for (String parameter : method->parameters)
+            Thread::transfer(parameter[0], caller, heap);
+
+        std::unique_lock<std::shared_mutex> lock(generatorLock);
+        Generator* generator = new Generator((uint) generators.size(), method, heap);
+        generators.push_back(generator);
+        return generator;
+    }
+
+    /**
+     * Retrieve a created generator by its identifier.
+     * @param id generator identifier
+     * @return retrieved generator or nullptr if missing
+     */
+    Generator* VirtualMachine::getGenerator(uint id) {
+        std::shared_lock<std::shared_mutex> lock(generatorLock);
+        return id < generators.size() ? generators[id] : nullptr;
+    }
+
+    /**
+     * Run a task until it returns, and complete its future with the result. A task, that waits for an other future,
+     * is suspended instead of blocking the worker, and it is continued by the pool after that future is completed.
+     * @param fiber the fiber of the task
+     * @param heap root stack, that receives the result of the task
+     * @param future the future of the result
+     */
+    void VirtualMachine::runTask(Fiber* fiber, Stack* heap, Future* future) {
+        if (!fiber->run()) {
+            // the callback is registered only after the fiber has stopped, so that it is never run by two workers
+            Future* awaited = fiber->takeAwaited();
+            awaited->then([this, fiber, heap, future](Future* completed) {
+                runTask(fiber, heap, future);
+            });
+            return;
+        }
+        // the error of a failed task is reported by its future, the other tasks are not affected
+        if (fiber->hasFailed())
+            future->fail(fiber->getError());
+        else
+            future->complete(heap);
+        delete fiber;
+        delete heap;
     }
 }
@@ -4,22 +4,84 @@
 #include "../util/Options.hpp"
 #include "element/Class.hpp"
 #include "../vm/runtime/Stack.hpp"
+#include "../vm/runtime/Thread.hpp"
+#include "../vm/runtime/TaskPool.hpp"
+#include "../vm/runtime/Future.hpp"
+#include "../vm/runtime/Fiber.hpp"
+#include "../vm/runtime/Generator.hpp"
+#include "../vm/runtime/ClassTable.hpp"
 
 namespace Void {
     class Class;
+    class Method;
     class Stack;
+    class Thread;
+    class TaskPool;
+    class Future;
+    class Fiber;
+    class Generator;
 
     /**
      * Represents a high-level application environment emulator.
-     * Loads executable bytecode dynamically.
+     * Loads executable bytecode dynamically. The loaded classes are shared by the threads of the virtual machine,
+     * a class is defined only after it has been built, and it is not modified afterwards.
      */
     class VirtualMachine {
     private:
         /**
-         * The list of the runtime loaded classes.
+         * The table of the runtime loaded classes. The running threads look up the classes without locking,
+         * so a class may be loaded while other threads are running, without pausing them.
          */
-    private:
-        List<Class*> classes;
+        ClassTable classes;
+
+        /**
+         * The list of the started threads, indexed by their identifier.
+         */
+        List<Thread*> threads;
+
+        /**
+         * The lock of the thread list.
+         */
+        std::mutex threadLock;
+
+        /**
+         * The task pool, that runs the asynchronous tasks. The pool is started when the first future is created.
+         */
+        std::atomic<TaskPool*> tasks = nullptr;
+
+        /**
+         * Determine if the task pool has been started.
+         */
+        std::once_flag tasksStarted;
+
+        /**
+         * The list of the created futures, indexed by their identifier.
+         */
+        List<Future*> futures;
+
+        /**
+         * The lock of the future list.
+         */
+        std::shared_mutex futureLock;
+
+        /**
+         * The list of the created generators, indexed by their identifier.
+         */
+        List<Generator*> generators;
+
+        /**
+         * The lock of the generator list.
+         */
+        std::shared_mutex generatorLock;
+
+        /**
+         * Run a task until it returns, and complete its future with the result. A task, that waits for an other future,
+         * is suspended instead of blocking the worker, and it is continued by the pool after that future is completed.
+         * @param fiber the fiber of the task
+         * @param heap root stack, that receives the result of the task
+         * @param future the future of the result
+         */
+        void runTask(Fiber* fiber, Stack* heap, Future* future);
     
     public:
         /**
@@ -27,6 +89,27 @@ namespace Void {
          */
         Options& options;
 
+        /**
+         * The count of the class definitions. The devirtualized call sites bind their target again,
+         * if a class that might override the target is defined after they were bound.
+         */
+        std::atomic<uint> hierarchyVersion = 0;
+
+        /**
+         * The count of the bound virtual call sites.
+         */
+        std::atomic<uint> virtualSites = 0;
+
+        /**
+         * The count of the virtual call sites, that are bound to a single target method.
+         */
+        std::atomic<uint> devirtualizedSites = 0;
+
+        /**
+         * The count of the calls, whose receiver class did not match the cached class of the call site.
+         */
+        std::atomic<uint> guardMisses = 0;
+
         /**
          * Initialize the virtual machine.
          * @param options command line options
@@ -52,15 +135,109 @@ namespace Void {
         Class* getClass(String name);
 
         /**
-         * Define a new class in the virtual machine.
+         * Define a new class in the virtual machine. The class must be built before it is defined,
+         * as the other threads may use it right after it has been defined.
          * @param class class to add
          */
         void defineClass(Class* clazz);
 
+        /**
+         * Get the only method that a virtual call can invoke, using the loaded class hierarchy.
+         * A call has a single target, if the method or its class is final, or none of the loaded
+         * subclasses of the receiver class override the method.
+         * @param clazz static receiver class
+         * @param method method resolved from the receiver class
+         * @return the single target method, or nullptr if the call must be dispatched by the receiver
+         */
+        Method* devirtualize(Class* clazz, Method* method);
+
         /**
          * Initialize classes and their static members.
          * @param heap root program stack
          */
         void initialize(Stack* heap);
+
+        /**
+         * Start executing a static method on a new thread. The arguments of the method are moved
+         * from the caller stack to the root stack of the thread.
+         * @param method executed static method
+         * @param caller the stack that holds the arguments
+         * @return started thread
+         */
+        Thread* startThread(Method* method, Stack* caller);
+
+        /**
+         * Retrieve a started thread by its identifier.
+         * @param id thread identifier
+         * @return retrieved thread or nullptr if missing
+         */
+        Thread* getThread(uint id);
+
+        /**
+         * Wait until every started thread returns, including the threads that are started meanwhile.
+         */
+        void joinThreads();
+
+        /**
+         * Get the task pool of the virtual machine, and start it if it is not running yet.
+         * The "-XTaskWorkers" option sets the count of the worker threads.
+         * @return running task pool
+         */
+        TaskPool* getTasks();
+
+        /**
+         * Create a new empty future.
+         * @param type the type descriptor of the result value
+         * @return created future
+         */
+        Future* createFuture(char type);
+
+        /**
+         * Retrieve a created future by its identifier.
+         * @param id future identifier
+         * @return retrieved future or nullptr if missing
+         */
+        Future* getFuture(uint id);
+
+        /**
+         * Submit a static method to the task pool. The arguments of the method are moved from the caller stack,
+         * and the returned future is completed with the result of the method.
+         * @param method executed static method
+         * @param caller the stack that holds the arguments
+         * @return the future of the result
+         */
+        Future* submitTask(Method* method, Stack* caller);
+
+        /**
+         * Submit a static method to the task pool, after a future has been completed. The result of the future is
+         * passed as the last argument, the other arguments are moved from the caller stack right away.
+         * The returned future fails, if the source future has failed.
+         * @param source the future, that the method waits for
+         * @param method executed static method
+         * @param caller the stack that holds the other arguments
+         * @return the future of the result, or nullptr if the last parameter does not accept the result
+         */
+        Future* chainTask(Future* source, Method* method, Stack* caller);
+
+        /**
+         * Wait until every submitted task is run, if the task pool has been started.
+         */
+        void waitTasks();
+
+        /**
+         * Create a generator of the values, that a static method yields. The arguments of the method are moved
+         * from the caller stack to the root stack of the generator.
+         * @param method the method, that yields the values
+         * @param caller the stack that holds the arguments
+         * @return created generator, or nullptr if the method is a native function
+         */
+        Generator* createGenerator(Method* method, Stack* caller);
+
+        /**
+         * Retrieve a created generator by its identifier.
+         * @param id generator identifier
+         * @return retrieved generator or nullptr if missing
+         */
+        Generator* getGenerator(uint id);
     };
 }
@@ -2,6 +2,7 @@
 #include "../../util/Strings.hpp"
 #include "../../util/Lists.hpp"
 #include "../parser/Instruction.hpp"
+#include "../parser/Verifier.hpp"
 #include "../runtime/Modifier.hpp"
 
 namespace Void {
@@ -92,15 +93,11 @@ namespace Void {
                     // apply the prefix of the parent class to the inner class name
                     className = name + separator + className;
 
-                    // check if the class name is in use
-                    if (vm->getClass(className) != nullptr)
-                        error("ClassRedefineException: Class '" << className << "' is already defined.");
-
-                    // define the class in the virtual machine
+                    // make the class build its content, before it is visible to the other threads
                     Class* clazz = new Class(className, classSuperclass, modifiers, classInterfaces, vm);
-                    vm->defineClass(clazz);
-                    // make the class build its content
                     clazz->build(content);
+                    // define the class in the virtual machine, that checks if the class name is in use
+                    vm->defineClass(clazz);
 
                     // reset class declaration variables 
                     className = "<unk>";
@@ -320,6 +317,43 @@ namespace Void {
         return nullptr;
     }
 
+    /**
+     * Retrieve a class method with the given signature, that is declared by
+     * the class or inherited from one of its superclasses.
+     * @param name method name
+     * @param parameters method parameters
+     * @return found method or nullptr
+     */
+    Method* Class::findMethod(String name, List<String> parameters) {
+        // walk up the class hierarchy until the method is found
+        for (Class* clazz = this; clazz != nullptr; clazz = vm->getClass(clazz->superclass)) {
+            Method* method = clazz->getMethod(name, parameters);
+            if (method != nullptr)
+                return method;
+            // the root class does not have a loaded superclass
+            if (clazz->superclass.empty() || clazz->superclass == "Object")
+                break;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Determine if the class extends or implements the given class.
+     * @param other target superclass or interface
+     * @return true if the class is the same as the other class or inherits from it
+     */
+    bool Class::isSubclassOf(Class* other) {
+        // walk up the class hierarchy and check the superclasses and the interfaces
+        for (Class* clazz = this; clazz != nullptr; clazz = vm->getClass(clazz->superclass)) {
+            if (clazz == other || contains(clazz->interfaces, other->name))
+                return true;
+            // the root class does not have a loaded superclass
+            if (clazz->superclass.empty() || clazz->superclass == "Object")
+                break;
+        }
+        return false;
+    }
+
     /**
      * Define a new method in the class.
      * @param method target method
@@ -362,9 +396,14 @@ namespace Void {
         if (constructor != nullptr)
             constructor->invoke(vm, heap, nullptr, nullptr);
 
-        // initialize the const pool references for the instructions
-        for (Method* method : methods)
+        // initialize the const pool references for the instructions, remove the checks
+        // that the verifier proves unnecessary, and bind the native methods to their implementations
+        for (Method* method : methods) {
             method->initalize();
+            Verifier::verify(method);
+            if (method->external && method->native == nullptr)
+                method->link();
+        }
 
         // initialize the static class fields 
         // and initialize const pool references for the field instructions
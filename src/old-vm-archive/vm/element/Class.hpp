@@ -4,6 +4,7 @@
 #include "../element/Executable.hpp"
 #include "Method.hpp"
 #include "Field.hpp"
+#include "../runtime/Monitor.hpp"
 
 namespace Void {
     class VirtualMachine;
@@ -54,6 +55,11 @@ namespace Void {
          */
         List<String> interfaces;
 
+        /**
+         * The lock, that the static synchronized methods of the class hold.
+         */
+        Monitor monitor;
+
         /**
          * Initialize the class.
          * @param name class name
@@ -95,6 +101,22 @@ namespace Void {
          */
         Method* getMethod(String name, List<String> parameters);
 
+        /**
+         * Retrieve a class method with the given signature, that is declared by
+         * the class or inherited from one of its superclasses.
+         * @param name method name
+         * @param parameters method parameters
+         * @return found method or nullptr
+         */
+        Method* findMethod(String name, List<String> parameters);
+
+        /**
+         * Determine if the class extends or implements the given class.
+         * @param other target superclass or interface
+         * @return true if the class is the same as the other class or inherits from it
+         */
+        bool isSubclassOf(Class* other);
+
         /**
          * Define a new method in the class.
          * @param method target method
@@ -50,6 +50,12 @@ namespace Void {
          */
         Map<String, uint> linkers;
 
+        /**
+         * The list of the storage ensure instructions, that are executed
+         * before the arguments are copied to the variable storage.
+         */
+        List<Instruction*> ensures;
+
         /**
          * Initialize the virtual machine.
          * @param modifiers executable access modifiers
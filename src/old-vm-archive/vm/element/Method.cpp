@@ -1,8 +1,10 @@
 #include "Method.hpp"
 #include "../runtime/Modifier.hpp"
+#include "../runtime/Natives.hpp"
 #include "../../util/Strings.hpp"
 #include "../../util/Lists.hpp"
 #include "../parser/instructions/Invokes.hpp"
+#include "../runtime/Fiber.hpp"
 
 namespace Void {
     /**
@@ -15,7 +17,9 @@ namespace Void {
      * @param vm running virtual machine
      */
     Method::Method(String name, String returnType, List<String> modifiers, List<String> parameters, Class* clazz, VirtualMachine* vm)
-        : Executable(modifiers, vm, clazz), name(name), returnType(returnType), parameters(parameters)
+        : Executable(modifiers, vm, clazz), name(name), returnType(returnType), parameters(parameters),
+          external(hasModifier(Modifier::NATIVE) || hasModifier(Modifier::EXTERN)),
+          monitored(hasModifier(Modifier::SYNCHRONIZED))
     { }
 
     /**
@@ -28,6 +32,51 @@ namespace Void {
      * @param caller parent caller executable that called this executable
      */
     void Method::invoke(VirtualMachine* vm, Stack* callerStack, Reference<Instance*>* instance, Executable* caller) {
+        // the methods called by this method are executed by the same fiber, without returning to the native code
+        Fiber fiber(false);
+        call(&fiber, callerStack, instance);
+        fiber.run();
+        // the native caller cannot handle the error, so it terminates the program, like an uncaught exception
+        if (fiber.hasFailed())
+            error(fiber.getError());
+    }
+
+    /**
+     * Perform a method call on a fiber. The frame of the method is pushed to the fiber, and it is executed
+     * by the next step of the fiber, the native functions are called right away. A synchronized method
+     * acquires its lock first, and holds it until it returns.
+     * @param fiber the fiber, that executes the method
+     * @param callerStack stack of the method's call context
+     * @param instance target instance to perform the method call with, nullptr it is static call
+     */
+    void Method::call(Fiber* fiber, Stack* callerStack, Reference<Instance*>* instance) {
+        Monitor* monitor = nullptr;
+        if (monitored) {
+            monitor = instance != nullptr ? &instance->data->monitor : &clazz->monitor;
+            monitor->acquire();
+        }
+
+        // call the native function directly on the caller stack, it does not need a context of its own
+        if (external) {
+            // the static constructors are called before the methods of the class are linked
+            if (native == nullptr)
+                link();
+            native(this, callerStack);
+            if (monitor != nullptr)
+                monitor->release();
+            return;
+        }
+        // the lock is released by the fiber, when the frame returns
+        fiber->push(this, createContext(callerStack, instance), callerStack, monitor);
+    }
+
+    /**
+     * Create the execution context of a method call, and copy the method arguments to its variable storage.
+     * @param callerStack stack of the method's call context
+     * @param instance target instance to perform the method call with, nullptr it is static call
+     * @return method execution context
+     */
+    Context* Method::createContext(Stack* callerStack, Reference<Instance*>* instance) {
         // create a new stack for the method execution context that will hold values in memory allowing us to perform operations on
         String stackName = clazz->name + "." + name + "(" + Strings::join(parameters, ", ") + ")" + returnType;
         Stack* stack = new Stack(callerStack, this, stackName);
@@ -35,38 +84,17 @@ namespace Void {
         // create a local variable storage that will hold stack operations' results
         Storage* storage = new Storage();
 
-        // copy the method arguments from the method caller's stack to the current variable storage
-        copyArguments(callerStack, storage, instance);
-
-        // TODO declare method call result
-
-        // TODO handle native method call
-
-        // TODO handle a normal method call
-
         // create the method execution content
         Context* context = new Context(stack, storage, bytecode.size(), this);
 
-        // create a new loop that will execute until a return is called or there is nothing left to be executed
-        for (; context->cursor < context->length; context->cursor++) {
-            // get the instruction at the current cursor
-            Instruction* instruction = bytecode[context->cursor];
-
-            //auto begin = nanoTime();
-
-            // execute the bytecode instruction that will perform stack and storage manipulation
-            // this will might modify the cursor, and return a value
-            instruction->execute(context);
-        
-            //auto end = nanoTime();
-
-            //auto name = ELEMENT_INSTRUCTIONS_MAPPED[static_cast<int>(instruction->kind)];
+        // size the variable storage once for every slot the method uses,
+        // instead of growing it with each argument and local variable
+        for (Instruction* ensure : ensures)
+            ensure->execute(context);
 
-            //println(name << " took " << (end - begin) << "ns" << " " << ((end - begin) / 1000000.0) << "ms");
-        }
-
-        // handle the return value of the method call
-        handleReturn(context, callerStack);
+        // copy the method arguments from the method caller's stack to the current variable storage
+        copyArguments(callerStack, storage, instance);
+        return context;
     }
 
     /**
@@ -86,6 +114,8 @@ namespace Void {
         uint doubleOffset   = 0;
         uint booleanOffset  = 0;
         uint instanceOffset = 0;
+        uint arrayOffset    = 0;
+        uint textOffset     = 0;
 
         // prepare for a non-static method call, place the "this" instance into the first instance storage slot
         if (instance != nullptr)
@@ -96,7 +126,7 @@ namespace Void {
             // get the first character of the parameter type that we are going to test
             // identify what should we do with the parameter
             // array types begins with a "[" prefix, classes with an "L" prefix, and primitives have their own symbols:
-            // B (byte), C (char), S (short), I (int), J (long), F (float), D (double), Z (boolean)
+            // B (byte), C (char), S (short), I (int), J (long), F (float), D (double), Z (boolean), T (string)
             char prefix = parameter[0];
 
             // handle byte parameter
@@ -136,7 +166,13 @@ namespace Void {
             else if (prefix == 'L')
                 storage->instances.set(instanceOffset++, callerStack->instances.pull());
 
-            // TODO handle array parameter
+            // handle primitive array parameter
+            else if (prefix == '[')
+                storage->arrays.set(arrayOffset++, callerStack->arrays.pull());
+
+            // handle string parameter
+            else if (prefix == 'T')
+                storage->texts.set(textOffset++, callerStack->texts.pull());
         }
     }
 
@@ -189,7 +225,21 @@ namespace Void {
         else if (prefix == 'L')
             callerStack->instances.push(object_cast<Reference<Instance*>*>(context->result));
 
-        // TODO handle array return type
+        // handle primitive array return type
+        else if (prefix == '[')
+            callerStack->arrays.push(object_cast<Array*>(context->result));
+
+        // handle string return type
+        else if (prefix == 'T')
+            callerStack->texts.push(object_cast<Text*>(context->result));
+    }
+
+    /**
+     * Bind the native or extern method to its implementation.
+     * The method is linked with the other methods of its class, or by its first call, whichever comes first.
+     */
+    void Method::link() {
+        Natives::bind(this);
     }
 
     /**
@@ -210,8 +260,8 @@ namespace Void {
         // debug the method parameters
         print('(' << Strings::join(parameters, ", ") << ')');
 
-        // do not debug the method body if it is native or abstract
-        if (hasModifier(Modifier::NATIVE) || hasModifier(Modifier::ABSTRACT)) {
+        // do not debug the method body if it is native, extern or abstract
+        if (external || hasModifier(Modifier::ABSTRACT)) {
             // end method body debugging
             println(";");
             return;
@@ -261,14 +311,15 @@ namespace Void {
      */
     void InvokeStatic::initialize(VirtualMachine* vm, Executable* executable) {
         // get the class reference from the virtual machine
-        classRef = vm->getClass(className);
+        Class* clazz = vm->getClass(className);
         // we don't need to check if the class is actually found here, as 
         // it might be loaded afterwards
 
         // get the method reference if the class reference was found
-        if (classRef != nullptr) {
+        if (clazz != nullptr) {
+            classRef.store(clazz, std::memory_order_release);
             // get the method reference from the class
-            methodRef = classRef->getMethod(methodName, methodParameters);
+            methodRef.store(clazz->getMethod(methodName, methodParameters), std::memory_order_release);
             // here again we don't care if the method reference is not found
             // as there are chances this code will not be executed
         }
@@ -279,28 +330,46 @@ namespace Void {
      * @param context bytecode execution context
      */
     void InvokeStatic::execute(Context* context) {
+        // the method is resolved only by the first call, the other calls read the published reference
+        Method* method = methodRef.load(std::memory_order_acquire);
+        if (method == nullptr)
+            method = resolve(context);
+        if (method == nullptr)
+            return;
+        // statically invoke the class method
+        method->call(context->fiber, context->stack, nullptr);
+    }
+
+    /**
+     * Resolve the target class and method. The threads may resolve them at the same time,
+     * as every thread resolves the same references. The fiber of the context fails, if they are missing.
+     * @param context bytecode execution context
+     * @return resolved target method, or nullptr if the fiber has failed
+     */
+    Method* InvokeStatic::resolve(Context* context) {
         // check if the class reference is missing
-        if (classRef == nullptr) {
+        Class* clazz = classRef.load(std::memory_order_acquire);
+        if (clazz == nullptr) {
             // try to load the class reference again, as it was possibly lodaded
             // after this instruction was initialized
-            classRef = context->executable->vm->getClass(className);
+            clazz = context->executable->vm->getClass(className);
             // check if the class is still missing
-            if (classRef == nullptr)
-                // TODO throw an error instead of panicing
-                error("NoSuchClassException: Trying to invoke static method of undefined class " << className);
+            if (clazz == nullptr) {
+                context->fiber->fail("NoSuchClassException: Trying to invoke static method of undefined class " + className);
+                return nullptr;
+            }
+            classRef.store(clazz, std::memory_order_release);
         }
-        // check if the method reference is missing
-        if (methodRef == nullptr) {
-            // get the method reference from the class
-            methodRef = classRef->getMethod(methodName, methodParameters);
-            // check if the method reference is still missing
-            if (methodRef == nullptr)
-                // TODO throw an error instead of panicing
-                error("NoSuchMethodException: Trying to invoke undefined static method " << methodName
-                    << "(" << Strings::join(methodParameters, " ") << ") of class " << className);
+        // get the method reference from the class
+        Method* method = clazz->getMethod(methodName, methodParameters);
+        // check if the method reference is still missing
+        if (method == nullptr) {
+            context->fiber->fail("NoSuchMethodException: Trying to invoke undefined static method " + methodName
+                + "(" + Strings::join(methodParameters, " ") + ") of class " + className);
+            return nullptr;
         }
-        // statically invoke the class method
-        methodRef->invoke(context->executable->vm, context->stack, nullptr, context->executable);
+        methodRef.store(method, std::memory_order_release);
+        return method;
     }
 
     /**
@@ -311,4 +380,163 @@ namespace Void {
         return "invokestatic " + className + " " + methodName + " " + Strings::join(methodParameters, " ");
     }
 #pragma endregion
+
+#pragma region INVOKE_VIRTUAL
+    /**
+     * Initialize virtual method invoke instruction.
+     */
+    InvokeVirtual::InvokeVirtual()
+        : Instruction(Instructions::INVOKE_VIRTUAL)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void InvokeVirtual::parse(String data, List<String> args, uint line, Executable* executable) {
+        // parse the static receiver class name
+        className = args[0];
+        // parse the target method name
+        methodName = args[1];
+        // parse the method parameters
+        methodParameters = Lists::subList(args, 2);
+    }
+
+    /**
+     * Initialize the references in the const pool after the whole program has been parsed.
+     * @param vm running virtual machine
+     * @param executable bytecode executor
+     */
+    void InvokeVirtual::initialize(VirtualMachine* vm, Executable* executable) {
+        // the call site is bound when the whole program is loaded, so that every subclass is known
+        Binding* binding = bind(vm);
+        // count the call site only if it could be resolved, the missing classes are reported when the call is executed
+        if (binding->methodRef == nullptr)
+            return;
+        vm->virtualSites.fetch_add(1, std::memory_order_relaxed);
+        if (binding->target != nullptr)
+            vm->devirtualizedSites.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void InvokeVirtual::execute(Context* context) {
+        VirtualMachine* vm = context->executable->vm;
+
+        // bind the call site again, if the receiver class was missing, or an other class has been loaded since,
+        // that might override the devirtualized method
+        Binding* binding = this->binding.load(std::memory_order_acquire);
+        if (binding == nullptr || binding->methodRef == nullptr
+            || binding->version != vm->hierarchyVersion.load(std::memory_order_acquire)) {
+            binding = bind(vm);
+            if (binding->classRef == nullptr) {
+                context->fiber->fail("NoSuchClassException: Trying to invoke virtual method of undefined class " + className);
+                return;
+            }
+            if (binding->methodRef == nullptr) {
+                context->fiber->fail("NoSuchMethodException: Trying to invoke undefined virtual method " + methodName
+                    + "(" + Strings::join(methodParameters, " ") + ") of class " + className);
+                return;
+            }
+        }
+
+        // get the receiver instance, that is pushed before the arguments
+        Reference<Instance*>* instance = context->stack->instances.pull();
+        if (instance == nullptr || !instance->exists) {
+            context->fiber->fail("NullPointerException: Trying to invoke virtual method " + methodName + " of a deleted instance");
+            return;
+        }
+
+        // the receiver does not have to be checked, if the class hierarchy allows only a single target
+        Method* method = binding->target;
+        if (method == nullptr) {
+            // guard the call with the receiver class of the previous call, most of the call sites see a single class
+            Class* clazz = instance->data->clazz;
+            ReceiverCache* cache = this->cache.load(std::memory_order_acquire);
+            if (cache == nullptr || cache->clazz != clazz)
+                cache = lookup(vm, clazz);
+            if (cache == nullptr) {
+                context->fiber->fail("AbstractMethodError: Class " + clazz->name + " does not implement " + methodName
+                    + "(" + Strings::join(methodParameters, " ") + ")");
+                return;
+            }
+            method = cache->method;
+        }
+
+        // invoke the class method on the receiver instance
+        method->call(context->fiber, context->stack, instance);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String InvokeVirtual::debug() {
+        return "invokevirtual " + className + " " + methodName + " " + Strings::join(methodParameters, " ");
+    }
+
+    /**
+     * Resolve the target method and bind the call site using the current class hierarchy.
+     * @param vm running virtual machine
+     * @return current binding
+     */
+    InvokeVirtual::Binding* InvokeVirtual::bind(VirtualMachine* vm) {
+        std::lock_guard<std::mutex> guard(lock);
+        // the hierarchy version is read before the classes, so a class defined meanwhile makes the call site bind again
+        uint version = vm->hierarchyVersion.load(std::memory_order_acquire);
+        // an other thread might have bound the call site while this thread was waiting for the lock
+        Binding* current = binding.load(std::memory_order_relaxed);
+        if (current != nullptr && current->methodRef != nullptr && current->version == version)
+            return current;
+
+        Binding* result = new Binding { nullptr, nullptr, nullptr, version };
+        if (current != nullptr) {
+            result->classRef = current->classRef;
+            result->methodRef = current->methodRef;
+        }
+        // the class might be loaded after this instruction was initialized
+        if (result->classRef == nullptr)
+            result->classRef = vm->getClass(className);
+        // the method might be declared by a superclass of the receiver class
+        if (result->classRef != nullptr && result->methodRef == nullptr)
+            result->methodRef = result->classRef->findMethod(methodName, methodParameters);
+        if (result->methodRef != nullptr)
+            result->target = vm->devirtualize(result->classRef, result->methodRef);
+
+        bindings.push_back(result);
+        binding.store(result, std::memory_order_release);
+        return result;
+    }
+
+    /**
+     * Look up the method of a receiver class, and cache it for the next call.
+     * @param vm running virtual machine
+     * @param clazz receiver class
+     * @return receiver cache of the class, or nullptr if the class does not implement the method
+     */
+    InvokeVirtual::ReceiverCache* InvokeVirtual::lookup(VirtualMachine* vm, Class* clazz) {
+        std::lock_guard<std::mutex> guard(lock);
+        vm->guardMisses.fetch_add(1, std::memory_order_relaxed);
+        // the receiver classes that have been cached before are reused
+        ReceiverCache* result = nullptr;
+        for (ReceiverCache* cache : caches) {
+            if (cache->clazz == clazz)
+                result = cache;
+        }
+        if (result == nullptr) {
+            Method* method = clazz->findMethod(methodName, methodParameters);
+            if (method == nullptr)
+                return nullptr;
+            result = new ReceiverCache { clazz, method };
+            caches.push_back(result);
+        }
+        cache.store(result, std::memory_order_release);
+        return result;
+    }
+#pragma endregion
 }
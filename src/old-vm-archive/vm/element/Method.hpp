@@ -5,6 +5,7 @@
 #include "../runtime/Instance.hpp"
 #include "../runtime/Stack.hpp"
 #include "../runtime/Storage.hpp"
+#include "../runtime/Fiber.hpp"
 
 #ifdef VOID_EXECUTABLE
 #ifndef VOID_METHOD
@@ -32,7 +33,25 @@ namespace Void {
          */
         List<String> parameters;
 
-        // TODO Native method execution handle.
+        /**
+         * Determine if the method is implemented outside of the bytecode, by a native function or an extern symbol.
+         */
+        bool external;
+
+        /**
+         * Determine if the method holds the lock of its receiver, or the lock of its class if it is static, while it is executed.
+         */
+        bool monitored;
+
+        /**
+         * The NativeFunction that executes the native or extern method, or nullptr if the method is not bound yet.
+         */
+        void (*native)(Method* method, Stack* stack) = nullptr;
+
+        /**
+         * The address of the exported symbol of an extern method.
+         */
+        void* symbol = nullptr;
    
         /**
          * Initialize the class method. 
@@ -57,6 +76,24 @@ namespace Void {
          */
         void invoke(VirtualMachine* vm, Stack* callerStack, Reference<Instance*>* instance, Executable* caller);
 
+        /**
+         * Perform a method call on a fiber. The frame of the method is pushed to the fiber, and it is executed
+         * by the next step of the fiber, the native functions are called right away. A synchronized method
+         * acquires its lock first, and holds it until it returns.
+         * @param fiber the fiber, that executes the method
+         * @param callerStack stack of the method's call context
+         * @param instance target instance to perform the method call with, nullptr it is static call
+         */
+        void call(Fiber* fiber, Stack* callerStack, Reference<Instance*>* instance);
+
+        /**
+         * Create the execution context of a method call, and copy the method arguments to its variable storage.
+         * @param callerStack stack of the method's call context
+         * @param instance target instance to perform the method call with, nullptr it is static call
+         * @return method execution context
+         */
+        Context* createContext(Stack* callerStack, Reference<Instance*>* instance);
+
         /**
          * Copy method call arguments from the caller stack to the variable storage of this execution context.
          * @param callerStack method execution caller stack
@@ -71,6 +108,12 @@ namespace Void {
          */
         void handleReturn(Context* context, Stack* callerStack);
 
+        /**
+         * Bind the native or extern method to its implementation.
+         * The method is linked with the other methods of its class, or by its first call, whichever comes first.
+         */
+        void link();
+
         /**
          * Debug the parsed method and its content.
          */
@@ -6,6 +6,11 @@
 #include "instructions/Doubles.hpp"
 #include "instructions/Sections.hpp"
 #include "instructions/Instances.hpp"
+#include "instructions/Arrays.hpp"
+#include "instructions/Texts.hpp"
+#include "instructions/Threads.hpp"
+#include "instructions/Futures.hpp"
+#include "instructions/Generators.hpp"
 #include "../element/Method.hpp"
 #include "instructions/Invokes.hpp"
 
@@ -90,6 +95,10 @@ namespace Void {
             return new Section();
         else if (identifier == "goto")
             return new Goto();
+        else if (identifier == "tableswitch")
+            return new TableSwitch();
+        else if (identifier == "lookupswitch")
+            return new LookupSwitch();
         else if (identifier == "return")
             return new Return();
         else if (identifier == "#link")
@@ -326,11 +335,144 @@ namespace Void {
             return new InstanceDebug();
         else if (identifier == "delete")
             return new InstanceDelete();
+        else if (identifier == "monitorenter")
+            return new MonitorEnter();
+        else if (identifier == "monitorexit")
+            return new MonitorExit();
+#pragma endregion
+
+#pragma region Arrays
+        else if (identifier == "ianew")
+            return new ArrayNew<int>();
+        else if (identifier == "iaload")
+            return new ArrayLoad<int>();
+        else if (identifier == "iastore")
+            return new ArrayStore<int>();
+        else if (identifier == "iafill")
+            return new ArrayFill<int>();
+        else if (identifier == "lanew")
+            return new ArrayNew<lint>();
+        else if (identifier == "laload")
+            return new ArrayLoad<lint>();
+        else if (identifier == "lastore")
+            return new ArrayStore<lint>();
+        else if (identifier == "lafill")
+            return new ArrayFill<lint>();
+        else if (identifier == "fanew")
+            return new ArrayNew<float>();
+        else if (identifier == "faload")
+            return new ArrayLoad<float>();
+        else if (identifier == "fastore")
+            return new ArrayStore<float>();
+        else if (identifier == "fafill")
+            return new ArrayFill<float>();
+        else if (identifier == "danew")
+            return new ArrayNew<double>();
+        else if (identifier == "daload")
+            return new ArrayLoad<double>();
+        else if (identifier == "dastore")
+            return new ArrayStore<double>();
+        else if (identifier == "dafill")
+            return new ArrayFill<double>();
+        else if (identifier == "arrayload")
+            return new ArrayReferenceLoad();
+        else if (identifier == "arraystore")
+            return new ArrayReferenceStore();
+        else if (identifier == "arraylength")
+            return new ArrayLength();
+        else if (identifier == "arraycopy")
+            return new ArrayCopy();
+        else if (identifier == "arraycompare")
+            return new ArrayCompare();
+        else if (identifier == "arraydelete")
+            return new ArrayDelete();
+        else if (identifier == "arrayreturn")
+            return new ArrayReturn();
+        else if (identifier == "arraydebug")
+            return new ArrayDebug();
+        else if (identifier == "vadd")
+            return new VectorOperation(Instructions::VECTOR_ADD);
+        else if (identifier == "vmul")
+            return new VectorOperation(Instructions::VECTOR_MULTIPLY);
+        else if (identifier == "vmin")
+            return new VectorOperation(Instructions::VECTOR_MINIMUM);
+        else if (identifier == "vmax")
+            return new VectorOperation(Instructions::VECTOR_MAXIMUM);
+        else if (identifier == "vfma")
+            return new VectorMultiplyAdd();
+        else if (identifier == "vsum")
+            return new VectorReduction(Instructions::VECTOR_SUM);
+        else if (identifier == "vdot")
+            return new VectorReduction(Instructions::VECTOR_DOT);
+#pragma endregion
+
+#pragma region Texts
+        else if (identifier == "tconst")
+            return new TextConstant();
+        else if (identifier == "tload")
+            return new TextLoad();
+        else if (identifier == "tstore")
+            return new TextStore();
+        else if (identifier == "tconcat")
+            return new TextConcat();
+        else if (identifier == "ttemplate")
+            return new TextTemplate();
+        else if (identifier == "tlength")
+            return new TextLength();
+        else if (identifier == "thash")
+            return new TextHashCode();
+        else if (identifier == "tequals")
+            return new TextEquality();
+        else if (identifier == "tswitch")
+            return new TextSwitch();
+        else if (identifier == "tdelete")
+            return new TextDelete();
+        else if (identifier == "treturn")
+            return new TextReturn();
+        else if (identifier == "tdebug")
+            return new TextDebug();
+#pragma endregion
+
+#pragma region Threads
+        else if (identifier == "spawn")
+            return new Spawn();
+        else if (identifier == "join")
+            return new Join();
+#pragma endregion
+
+#pragma region Futures
+        else if (identifier == "async")
+            return new Async();
+        else if (identifier == "then")
+            return new Then();
+        else if (identifier == "await")
+            return new Await();
+        else if (identifier == "fnew")
+            return new FutureNew();
+        else if (identifier == "fcomplete")
+            return new FutureComplete();
+        else if (identifier == "ffail")
+            return new FutureFail();
+        else if (identifier == "fstate")
+            return new FutureStatus();
+#pragma endregion
+
+#pragma region Generators
+        else if (identifier == "gnew")
+            return new GeneratorNew();
+        else if (identifier == "ghas")
+            return new GeneratorHasNext();
+        else if (identifier == "gnext")
+            return new GeneratorNext();
+        else if (identifier == "yield")
+            return new Yield();
 #pragma endregion
 
 #pragma region Invokes
         else if (identifier == "invokestatic")
             return new InvokeStatic();
+        else if (identifier == "invokevirtual")
+            return new InvokeVirtual();
 #pragma endregion
 
         else if (identifier == "print")
@@ -347,7 +489,7 @@ namespace Void {
      */
     Context::Context(Stack* stack, Storage* storage, ulong length, Executable* executable)
         : stack(stack), storage(storage), length(length), 
-          executable(executable), cursor(0), result(nullptr)
+          executable(executable), cursor(0), result(nullptr), fiber(nullptr)
     { }
 
     /**
@@ -433,7 +575,7 @@ namespace Void {
      * @param context bytecode execution context
      */
     void Print::execute(Context* context) {
-        print(text);
+        Console::write(text);
     }
 
     /**
@@ -467,7 +609,8 @@ namespace Void {
      * @param context bytecode execution context
      */
     void PrintLine::execute(Context* context) {
-        println(text);
+        Console::write(text);
+        Console::newLine();
     }
 
     /**
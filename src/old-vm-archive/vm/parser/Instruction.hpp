@@ -2,6 +2,7 @@
 
 #include "../../Common.hpp"
 #include "../element/Executable.hpp"
+#include "../runtime/Console.hpp"
 
 #ifndef VOID_INSTRUCTION
 #define VOID_INSTRUCTION
@@ -10,6 +11,7 @@ namespace Void {
     class Storage;
     class Executable;
     class VirtualMachine;
+    class Fiber;
 
     /**
      * Represents a holder of the registered bytecode instructions.
@@ -142,6 +144,16 @@ namespace Void {
          */
         GOTO,
 
+        /**
+         * Jump to the section of an integer from a dense range of case keys.
+         */
+        TABLE_SWITCH,
+
+        /**
+         * Jump to the section of an integer from a sorted list of case keys.
+         */
+        LOOKUP_SWITCH,
+
         /**
          * Link a variable name to a storage unit.
          */
@@ -184,6 +196,16 @@ namespace Void {
          */
         INTEGER_ARRAY_STORE,
 
+        /**
+         * Allocate a new integer array.
+         */
+        INTEGER_ARRAY_NEW,
+
+        /**
+         * Set every element of an integer array to the same value.
+         */
+        INTEGER_ARRAY_FILL,
+
         /**
          * Add two integers from the stack.
          */
@@ -333,6 +355,16 @@ namespace Void {
          */
         FLOAT_ARRAY_STORE,
 
+        /**
+         * Allocate a new float array.
+         */
+        FLOAT_ARRAY_NEW,
+
+        /**
+         * Set every element of a float array to the same value.
+         */
+        FLOAT_ARRAY_FILL,
+
         /**
          * Add two floats from the stack.
          */
@@ -482,6 +514,16 @@ namespace Void {
          */
         DOUBLE_ARRAY_STORE,
 
+        /**
+         * Allocate a new double array.
+         */
+        DOUBLE_ARRAY_NEW,
+
+        /**
+         * Set every element of a double array to the same value.
+         */
+        DOUBLE_ARRAY_FILL,
+
         /**
          * Add two doubles from the stack.
          */
@@ -631,6 +673,16 @@ namespace Void {
          */
         LONG_ARRAY_STORE,
 
+        /**
+         * Allocate a new long array.
+         */
+        LONG_ARRAY_NEW,
+
+        /**
+         * Set every element of a long array to the same value.
+         */
+        LONG_ARRAY_FILL,
+
         /**
          * Add two longs from the stack.
          */
@@ -765,8 +817,6 @@ namespace Void {
          */
         INSTANCE_DELETE,
 
-        ARRAY_DELETE,
-
         /**
          * Load an instance from the storage to the stack.
          */
@@ -794,6 +844,232 @@ namespace Void {
 
         RETURN,
 
+        /**
+         * Acquire the lock of an instance.
+         */
+        MONITOR_ENTER,
+
+        /**
+         * Release the lock of an instance.
+         */
+        MONITOR_EXIT,
+
+#pragma endregion
+
+#pragma region Arrays
+
+        /**
+         * Load an array from the storage to the stack.
+         */
+        ARRAY_LOAD,
+
+        /**
+         * Store an array from the stack to the storage.
+         */
+        ARRAY_STORE,
+
+        /**
+         * Get the element count of an array.
+         */
+        ARRAY_LENGTH,
+
+        /**
+         * Copy a range of elements between two arrays.
+         */
+        ARRAY_COPY,
+
+        /**
+         * Find the first mismatching element of two arrays.
+         */
+        ARRAY_COMPARE,
+
+        /**
+         * Delete an array from the memory.
+         */
+        ARRAY_DELETE,
+
+        /**
+         * Return an array from the method.
+         */
+        ARRAY_RETURN,
+
+        /**
+         * Get the debug message of the array on the stack.
+         */
+        ARRAY_DEBUG,
+
+        /**
+         * Add the elements of two arrays.
+         */
+        VECTOR_ADD,
+
+        /**
+         * Multiply the elements of two arrays.
+         */
+        VECTOR_MULTIPLY,
+
+        /**
+         * Multiply the elements of an array by a scalar, and add the elements of another array.
+         */
+        VECTOR_MULTIPLY_ADD,
+
+        /**
+         * Add the elements of an array together.
+         */
+        VECTOR_SUM,
+
+        /**
+         * Select the smaller of the elements of two arrays.
+         */
+        VECTOR_MINIMUM,
+
+        /**
+         * Select the greater of the elements of two arrays.
+         */
+        VECTOR_MAXIMUM,
+
+        /**
+         * Add the products of the elements of two arrays together.
+         */
+        VECTOR_DOT,
+
+#pragma endregion
+
+#pragma region Texts
+        /**
+         * Load an interned string literal.
+         */
+        TEXT_CONSTANT,
+
+        /**
+         * Load a string from the storage to the stack.
+         */
+        TEXT_LOAD,
+
+        /**
+         * Store a string from the stack to the storage.
+         */
+        TEXT_STORE,
+
+        /**
+         * Concatenate two strings.
+         */
+        TEXT_CONCAT,
+
+        /**
+         * Build a string of a template and its arguments.
+         */
+        TEXT_TEMPLATE,
+
+        /**
+         * Count the code points of a string.
+         */
+        TEXT_LENGTH,
+
+        /**
+         * Get the hash code of a string.
+         */
+        TEXT_HASH,
+
+        /**
+         * Determine if two strings are equal.
+         */
+        TEXT_EQUALS,
+
+        /**
+         * Jump to the section of a string key.
+         */
+        TEXT_SWITCH,
+
+        /**
+         * Release a reference to a string.
+         */
+        TEXT_DELETE,
+
+        /**
+         * Return a string from the method.
+         */
+        TEXT_RETURN,
+
+        /**
+         * Get the debug message of the string on the stack.
+         */
+        TEXT_DEBUG,
+
+#pragma endregion
+
+#pragma region Threads
+        /**
+         * Start executing a static method on a new thread.
+         */
+        SPAWN,
+
+        /**
+         * Wait until a thread returns, and push its result.
+         */
+        JOIN,
+
+#pragma endregion
+
+#pragma region Futures
+        /**
+         * Submit a static method to the task pool.
+         */
+        ASYNC,
+
+        /**
+         * Submit a static method to the task pool, after a future has been completed.
+         */
+        THEN,
+
+        /**
+         * Wait until a future is completed, and push its result.
+         */
+        AWAIT,
+
+        /**
+         * Create an empty future.
+         */
+        FUTURE_NEW,
+
+        /**
+         * Complete a future with a value.
+         */
+        FUTURE_COMPLETE,
+
+        /**
+         * Fail a future with an error message.
+         */
+        FUTURE_FAIL,
+
+        /**
+         * Get the state of a future.
+         */
+        FUTURE_STATE,
+
+#pragma endregion
+
+#pragma region Generators
+        /**
+         * Create a generator of the values, that a static method yields.
+         */
+        GENERATOR_NEW,
+
+        /**
+         * Determine if a generator has a next value.
+         */
+        GENERATOR_HAS_NEXT,
+
+        /**
+         * Push the next value of a generator.
+         */
+        GENERATOR_NEXT,
+
+        /**
+         * Move a value to the generator, and suspend the method.
+         */
+        YIELD,
+
 #pragma endregion
 
         INVOKE_STATIC,
@@ -818,7 +1094,7 @@ namespace Void {
     /**
      * The registry of the mapped instruction names.
      */
-    static const char* ELEMENT_INSTRUCTIONS_MAPPED[148] = {
+    static const char* ELEMENT_INSTRUCTIONS_MAPPED[200] = {
         "cdef",
         "cmod",
         "cext",
@@ -845,6 +1121,8 @@ namespace Void {
 
         "section",
         "goto",
+        "tableswitch",
+        "lookupswitch",
         "linker",
 
         "ipush",
@@ -854,6 +1132,8 @@ namespace Void {
         "iensure",
         "iaload",
         "iastore",
+        "ianew",
+        "iafill",
         "iadd",
         "isub",
         "imul",
@@ -884,6 +1164,8 @@ namespace Void {
         "lensure",
         "laload",
         "lastore",
+        "lanew",
+        "lafill",
         "ladd",
         "lsub",
         "lmul",
@@ -914,6 +1196,8 @@ namespace Void {
         "fensure",
         "faload",
         "fastore",
+        "fanew",
+        "fafill",
         "fadd",
         "fsub",
         "fmul",
@@ -944,6 +1228,8 @@ namespace Void {
         "densure",
         "daload",
         "dastore",
+        "danew",
+        "dafill",
         "dadd",
         "dsub",
         "dmul",
@@ -967,6 +1253,51 @@ namespace Void {
         "ifdl",
         "ifdle",
 
+        "arrayload",
+        "arraystore",
+        "arraylength",
+        "arraycopy",
+        "arraycompare",
+        "arraydelete",
+        "arrayreturn",
+        "arraydebug",
+        "vadd",
+        "vmul",
+        "vfma",
+        "vsum",
+        "vmin",
+        "vmax",
+        "vdot",
+
+        "tconst",
+        "tload",
+        "tstore",
+        "tconcat",
+        "ttemplate",
+        "tlength",
+        "thash",
+        "tequals",
+        "tswitch",
+        "tdelete",
+        "treturn",
+        "tdebug",
+
+        "spawn",
+        "join",
+
+        "async",
+        "then",
+        "await",
+        "fnew",
+        "fcomplete",
+        "ffail",
+        "fstate",
+
+        "gnew",
+        "ghas",
+        "gnext",
+        "yield",
+
         "invokestatic",
         "invokevirtual",
         "invokedynamic",
@@ -981,7 +1312,7 @@ namespace Void {
     /**
      * The registry of the unmapped raw instruction values.
      */
-    static const char* ELEMENT_INSTRUCTIONS_UNMAPPED[148] = {
+    static const char* ELEMENT_INSTRUCTIONS_UNMAPPED[200] = {
         "cdef",
         "cmod",
         "cext",
@@ -1008,6 +1339,8 @@ namespace Void {
 
         "section",
         "goto",
+        "tableswitch",
+        "lookupswitch",
         "linker",
 
         "ipush",
@@ -1199,6 +1532,11 @@ namespace Void {
          */
         Executable* executable;
 
+        /**
+         * The fiber, that holds the frame of the execution context.
+         */
+        Fiber* fiber;
+
         /**
          * Initialize the execution context.
          */
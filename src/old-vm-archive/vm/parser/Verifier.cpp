@@ -0,0 +1,109 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../element/Method.hpp"
+#include "Verifier.hpp"
+#include "instructions/Arrays.hpp"
+
+namespace Void {
+    namespace Verifier {
+        /**
+         * Determine if an instruction type is in the given range of the instruction registry.
+         * @param kind instruction type
+         * @param first the first instruction of the range
+         * @param last the last instruction of the range
+         * @return true if the instruction is in the range
+         */
+        static bool isBetween(Instructions kind, Instructions first, Instructions last) {
+            return static_cast<int>(kind) >= static_cast<int>(first) && static_cast<int>(kind) <= static_cast<int>(last);
+        }
+
+        /**
+         * Determine if an instruction may transfer the execution to an instruction, other than the next one.
+         * @param kind instruction type
+         * @return true if the instruction is a jump
+         */
+        static bool isJump(Instructions kind) {
+            return kind == Instructions::GOTO || kind == Instructions::TABLE_SWITCH || kind == Instructions::LOOKUP_SWITCH
+                || kind == Instructions::TEXT_SWITCH
+                || isBetween(kind, Instructions::INTEGER_IF_EQUAL, Instructions::INTEGER_IF_LESS_THAN_OR_EQUAL)
+                || isBetween(kind, Instructions::LONG_IF_EQUAL, Instructions::LONG_IF_LESS_THAN_OR_EQUAL)
+                || isBetween(kind, Instructions::FLOAT_IF_EQUAL, Instructions::FLOAT_IF_LESS_THAN_OR_EQUAL)
+                || isBetween(kind, Instructions::DOUBLE_IF_EQUAL, Instructions::DOUBLE_IF_LESS_THAN_OR_EQUAL);
+        }
+
+        /**
+         * Get the length of the entry block of a method, the instructions that are executed in order by every call,
+         * before the first jump or jump target.
+         * @param bytecode method bytecode
+         * @return entry block instruction count
+         */
+        static uint getEntryLength(List<Instruction*>& bytecode) {
+            uint length = 0;
+            while (length < bytecode.size()) {
+                Instructions kind = bytecode[length]->kind;
+                if (kind == Instructions::SECTION || isJump(kind))
+                    break;
+                length++;
+            }
+            return length;
+        }
+
+        /**
+         * Remove the bounds checks of the array accesses, whose index is proven to be in range. An array variable
+         * is known to have a fixed length, if it is assigned only once, by an allocation of constant length in the
+         * entry block. Every instruction after the allocation sees the same array, therefore an access of a constant
+         * index within the length needs no check. The array variables are assigned only by the array instructions.
+         * @param method verified method
+         */
+        static void removeBoundsChecks(Method* method) {
+            List<Instruction*>& bytecode = method->bytecode;
+            uint entryLength = getEntryLength(bytecode);
+
+            // the array parameters are assigned by the caller, before the first instruction
+            Map<uint, uint> assignments;
+            uint arrayParameters = 0;
+            for (String& parameter : method->parameters) {
+                if (parameter[0] == '[')
+                    assignments[arrayParameters++]++;
+            }
+
+            // find the array variables, that are assigned by an allocation of constant length in the entry block
+            Map<uint, Pair<uint, int>> allocations;
+            for (uint i = 0; i < bytecode.size(); i++) {
+                ArrayInstruction* instruction = dynamic_cast<ArrayInstruction*>(bytecode[i]);
+                if (instruction == nullptr)
+                    continue;
+                int variable = instruction->getAssignedArray();
+                if (variable < 0)
+                    continue;
+                assignments[(uint) variable]++;
+                ArrayAllocation* allocation = dynamic_cast<ArrayAllocation*>(instruction);
+                int length;
+                if (allocation != nullptr && i < entryLength && allocation->hasConstantLength(length))
+                    allocations[(uint) variable] = { i, length };
+            }
+
+            // remove the checks of the constant indices, that are within the fixed length of the array
+            for (uint i = 0; i < bytecode.size(); i++) {
+                ArrayAccess* access = dynamic_cast<ArrayAccess*>(bytecode[i]);
+                uint variable;
+                int index;
+                if (access == nullptr || !access->hasConstantIndex(variable, index))
+                    continue;
+                auto allocation = allocations.find(variable);
+                if (allocation == allocations.end() || assignments[variable] != 1)
+                    continue;
+                auto [position, length] = allocation->second;
+                if (i > position && index >= 0 && index < length)
+                    access->removeBoundsCheck();
+            }
+        }
+
+        /**
+         * Verify the bytecode of a method, and remove the checks that are proven to be unnecessary.
+         * @param method verified method
+         */
+        void verify(Method* method) {
+            removeBoundsChecks(method);
+        }
+    }
+}
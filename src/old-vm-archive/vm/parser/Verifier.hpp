@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    class Method;
+
+    /**
+     * Represents the bytecode verifier, that proves the properties of the methods, which let the interpreter
+     * skip the runtime checks of their instructions. The verifier is conservative, an instruction keeps its
+     * checks, unless the property holds on every path of the method.
+     */
+    namespace Verifier {
+        /**
+         * Verify the bytecode of a method, and remove the checks that are proven to be unnecessary.
+         * @param method verified method
+         */
+        void verify(Method* method);
+    }
+}
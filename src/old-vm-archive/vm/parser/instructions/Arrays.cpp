@@ -0,0 +1,971 @@
+#include "Arrays.hpp"
+#include "../../runtime/Array.hpp"
+#include "../../runtime/Vectors.hpp"
+
+namespace Void {
+    /**
+     * Represents the mapping of an array element type to its descriptor and its instructions.
+     */
+    template <typename T>
+    struct ArrayElement;
+
+    template <>
+    struct ArrayElement<int> {
+        static constexpr char type = 'I';
+        static constexpr const char* prefix = "i";
+        static constexpr Instructions NEW = Instructions::INTEGER_ARRAY_NEW;
+        static constexpr Instructions LOAD = Instructions::INTEGER_ARRAY_LOAD;
+        static constexpr Instructions STORE = Instructions::INTEGER_ARRAY_STORE;
+        static constexpr Instructions FILL = Instructions::INTEGER_ARRAY_FILL;
+    };
+
+    template <>
+    struct ArrayElement<lint> {
+        static constexpr char type = 'J';
+        static constexpr const char* prefix = "l";
+        static constexpr Instructions NEW = Instructions::LONG_ARRAY_NEW;
+        static constexpr Instructions LOAD = Instructions::LONG_ARRAY_LOAD;
+        static constexpr Instructions STORE = Instructions::LONG_ARRAY_STORE;
+        static constexpr Instructions FILL = Instructions::LONG_ARRAY_FILL;
+    };
+
+    template <>
+    struct ArrayElement<float> {
+        static constexpr char type = 'F';
+        static constexpr const char* prefix = "f";
+        static constexpr Instructions NEW = Instructions::FLOAT_ARRAY_NEW;
+        static constexpr Instructions LOAD = Instructions::FLOAT_ARRAY_LOAD;
+        static constexpr Instructions STORE = Instructions::FLOAT_ARRAY_STORE;
+        static constexpr Instructions FILL = Instructions::FLOAT_ARRAY_FILL;
+    };
+
+    template <>
+    struct ArrayElement<double> {
+        static constexpr char type = 'D';
+        static constexpr const char* prefix = "d";
+        static constexpr Instructions NEW = Instructions::DOUBLE_ARRAY_NEW;
+        static constexpr Instructions LOAD = Instructions::DOUBLE_ARRAY_LOAD;
+        static constexpr Instructions STORE = Instructions::DOUBLE_ARRAY_STORE;
+        static constexpr Instructions FILL = Instructions::DOUBLE_ARRAY_FILL;
+    };
+
+    /**
+     * Check if an element index is in the bounds of an array.
+     * @param array accessed array
+     * @param index accessed element index
+     */
+    static void checkBounds(Array* array, int index) {
+        if (array == nullptr)
+            error("NullPointerException: Trying to access an element of a deleted array");
+        if ((uint) index >= array->length)
+            error("ArrayIndexOutOfBoundsException: Index " << index << " out of bounds for length " << array->length);
+    }
+
+    /**
+     * Check if an array exists, and it holds elements of the given type.
+     * @param array checked array
+     * @param type expected element type descriptor
+     * @param operation the name of the array operation
+     */
+    static void checkType(Array* array, char type, String operation) {
+        if (array == nullptr)
+            error("NullPointerException: Trying to " << operation << " a deleted array");
+        if (array->type != type)
+            error("ArrayStoreException: Trying to " << operation << " an array of type [" << array->type << " as [" << type);
+    }
+
+    /**
+     * Check if an array exists, and it holds float or double elements, that the vector kernels operate on.
+     * @param array checked array
+     * @param operation the name of the vector operation
+     */
+    static void checkVector(Array* array, String operation) {
+        if (array == nullptr)
+            error("NullPointerException: Trying to " << operation << " a deleted array");
+        if (array->type != 'F' && array->type != 'D')
+            error("ArrayStoreException: Trying to " << operation << " an array of type [" << array->type
+                << ", only float and double arrays are supported");
+    }
+
+    /**
+     * Check if two arrays of a vector operation have the same type and length.
+     * @param first the first operand array
+     * @param second the array that must match the first one
+     * @param operation the name of the vector operation
+     */
+    static void checkMatching(Array* first, Array* second, String operation) {
+        checkType(second, first->type, operation);
+        if (second->length != first->length)
+            error("ArrayIndexOutOfBoundsException: Trying to " << operation << " arrays of length " << first->length
+                << " and " << second->length);
+    }
+
+    /**
+     * Get the value of a scalar operand, that is stored as an element of the given type.
+     * @param operand scalar operand
+     * @param context bytecode execution context
+     * @return scalar value
+     */
+    template <typename T>
+    static T getScalar(Operand<double>& operand, Context* context) {
+        switch (operand.target) {
+            case Target::LOCAL:
+                return OperandType<T>::storage(context->storage).get(operand.index);
+            case Target::CONSTANT:
+                return (T) operand.constant;
+            default:
+                return OperandType<T>::stack(context->stack).pull();
+        }
+    }
+
+    /**
+     * Set the value of a scalar result, that is stored as an element of the given type.
+     * @param operand result operand
+     * @param context bytecode execution context
+     * @param value result value
+     */
+    template <typename T>
+    static void setScalar(Operand<double>& operand, Context* context, T value) {
+        if (operand.target == Target::LOCAL)
+            OperandType<T>::storage(context->storage).set(operand.index, value);
+        else
+            OperandType<T>::stack(context->stack).push(value);
+    }
+
+    /**
+     * Get the kernel of an element-wise vector operation.
+     * @param kind instruction type
+     * @return vector kernel
+     */
+    template <typename T>
+    static void (*getKernel(Instructions kind))(const T*, const T*, T*, uint) {
+        const Kernels<T>& kernels = Vectors::get<T>();
+        switch (kind) {
+            case Instructions::VECTOR_ADD:
+                return kernels.add;
+            case Instructions::VECTOR_MULTIPLY:
+                return kernels.multiply;
+            case Instructions::VECTOR_MINIMUM:
+                return kernels.minimum;
+            default:
+                return kernels.maximum;
+        }
+    }
+
+    /**
+     * Initialize the array instruction.
+     * @param kind instruction type
+     */
+    ArrayInstruction::ArrayInstruction(Instructions kind)
+        : Instruction(kind)
+    { }
+
+    /**
+     * Get the array variable that is assigned by the instruction.
+     * @return array storage index, or -1 if the instruction does not assign an array variable
+     */
+    int ArrayInstruction::getAssignedArray() {
+        return -1;
+    }
+
+    /**
+     * Initialize the array access instruction.
+     * @param kind instruction type
+     */
+    ArrayAccess::ArrayAccess(Instructions kind)
+        : ArrayInstruction(kind)
+    { }
+
+    /**
+     * Get the constant index of an element of an array variable.
+     * @param arrayIndex the storage index of the accessed array
+     * @param elementIndex the constant index of the accessed element
+     * @return true if the array is a local variable and the element index is a constant
+     */
+    bool ArrayAccess::hasConstantIndex(uint& arrayIndex, int& elementIndex) {
+        if (array.target != Target::LOCAL || index.target != Target::CONSTANT)
+            return false;
+        arrayIndex = array.index;
+        elementIndex = index.constant;
+        return true;
+    }
+
+    /**
+     * Remove the bounds check of the access, as the index has been proven to be in range.
+     */
+    void ArrayAccess::removeBoundsCheck() {
+        checked = false;
+    }
+
+    /**
+     * Initialize the array allocation instruction.
+     * @param kind instruction type
+     */
+    ArrayAllocation::ArrayAllocation(Instructions kind)
+        : ArrayInstruction(kind)
+    { }
+
+    /**
+     * Get the array variable that is assigned by the instruction.
+     * @return array storage index, or -1 if the array is pushed to the stack
+     */
+    int ArrayAllocation::getAssignedArray() {
+        return result.target == Target::LOCAL ? (int) result.index : -1;
+    }
+
+    /**
+     * Get the constant length of the new array.
+     * @param length array element count
+     * @return true if the length is a constant
+     */
+    bool ArrayAllocation::hasConstantLength(int& length) {
+        length = this->length.constant;
+        return this->length.target == Target::CONSTANT;
+    }
+
+#pragma region ARRAY_NEW
+    /**
+     * Initialize the array creation instruction.
+     */
+    template <typename T>
+    ArrayNew<T>::ArrayNew()
+        : ArrayAllocation(ArrayElement<T>::NEW)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    template <typename T>
+    void ArrayNew<T>::parse(String data, List<String> args, uint line, Executable* executable) {
+        // ianew -c 16 -r values
+        parseOperands(args, executable, &result, length);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    template <typename T>
+    void ArrayNew<T>::execute(Context* context) {
+        int count = length.get(context);
+        if (count < 0)
+            error("NegativeArraySizeException: Trying to allocate an array of " << count << " elements");
+        result.set(context, Array::allocate(ArrayElement<T>::type, (uint) count));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    template <typename T>
+    String ArrayNew<T>::debug() {
+        return String(ArrayElement<T>::prefix) + "anew " + length.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region ARRAY_LOAD
+    /**
+     * Initialize the array element load instruction.
+     */
+    template <typename T>
+    ArrayLoad<T>::ArrayLoad()
+        : ArrayAccess(ArrayElement<T>::LOAD)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    template <typename T>
+    void ArrayLoad<T>::parse(String data, List<String> args, uint line, Executable* executable) {
+        // iaload -l values -l i -r value
+        parseOperands(args, executable, &result, array, index);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    template <typename T>
+    void ArrayLoad<T>::execute(Context* context) {
+        Array* array = this->array.get(context);
+        int index = this->index.get(context);
+        if (checked)
+            checkBounds(array, index);
+        result.set(context, array->elements<T>()[index]);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    template <typename T>
+    String ArrayLoad<T>::debug() {
+        return String(ArrayElement<T>::prefix) + "aload " + array.debug() + " " + index.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region ARRAY_STORE
+    /**
+     * Initialize the array element store instruction.
+     */
+    template <typename T>
+    ArrayStore<T>::ArrayStore()
+        : ArrayAccess(ArrayElement<T>::STORE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    template <typename T>
+    void ArrayStore<T>::parse(String data, List<String> args, uint line, Executable* executable) {
+        // iastore -l values -l i -c 100
+        parseOperands<T>(args, executable, nullptr, array, index, value);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    template <typename T>
+    void ArrayStore<T>::execute(Context* context) {
+        Array* array = this->array.get(context);
+        int index = this->index.get(context);
+        T value = this->value.get(context);
+        if (checked)
+            checkBounds(array, index);
+        array->elements<T>()[index] = value;
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    template <typename T>
+    String ArrayStore<T>::debug() {
+        return String(ArrayElement<T>::prefix) + "astore " + array.debug() + " " + index.debug() + " " + value.debug();
+    }
+#pragma endregion
+
+#pragma region ARRAY_FILL
+    /**
+     * Initialize the array fill instruction.
+     */
+    template <typename T>
+    ArrayFill<T>::ArrayFill()
+        : ArrayInstruction(ArrayElement<T>::FILL)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    template <typename T>
+    void ArrayFill<T>::parse(String data, List<String> args, uint line, Executable* executable) {
+        // iafill -l values -c 0
+        parseOperands<T>(args, executable, nullptr, array, value);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    template <typename T>
+    void ArrayFill<T>::execute(Context* context) {
+        Array* array = this->array.get(context);
+        T value = this->value.get(context);
+        checkType(array, ArrayElement<T>::type, "fill");
+        array->fill(value);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    template <typename T>
+    String ArrayFill<T>::debug() {
+        return String(ArrayElement<T>::prefix) + "afill " + array.debug() + " " + value.debug();
+    }
+#pragma endregion
+
+    template class ArrayNew<int>;
+    template class ArrayNew<lint>;
+    template class ArrayNew<float>;
+    template class ArrayNew<double>;
+    template class ArrayLoad<int>;
+    template class ArrayLoad<lint>;
+    template class ArrayLoad<float>;
+    template class ArrayLoad<double>;
+    template class ArrayStore<int>;
+    template class ArrayStore<lint>;
+    template class ArrayStore<float>;
+    template class ArrayStore<double>;
+    template class ArrayFill<int>;
+    template class ArrayFill<lint>;
+    template class ArrayFill<float>;
+    template class ArrayFill<double>;
+
+#pragma region ARRAY_REFERENCE_LOAD
+    /**
+     * Initialize the array load instruction.
+     */
+    ArrayReferenceLoad::ArrayReferenceLoad()
+        : ArrayInstruction(Instructions::ARRAY_LOAD)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayReferenceLoad::parse(String data, List<String> args, uint line, Executable* executable) {
+        // try to parse the storage index from string
+        index = executable->getLinker(args[0]);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayReferenceLoad::execute(Context* context) {
+        context->stack->arrays.push(context->storage->arrays.get(index));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayReferenceLoad::debug() {
+        return "arrayload " + toString(index);
+    }
+#pragma endregion
+
+#pragma region ARRAY_REFERENCE_STORE
+    /**
+     * Initialize the array store instruction.
+     */
+    ArrayReferenceStore::ArrayReferenceStore()
+        : ArrayInstruction(Instructions::ARRAY_STORE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayReferenceStore::parse(String data, List<String> args, uint line, Executable* executable) {
+        // try to parse the storage index from string
+        index = executable->getLinker(args[0]);
+        // check if the instruction should keep the array on the stack
+        for (uint i = 1; i < args.size(); i++) {
+            if (args[i] == "-k")
+                keepStack = true;
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayReferenceStore::execute(Context* context) {
+        context->storage->arrays.set(index, context->stack->arrays.pull(keepStack));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayReferenceStore::debug() {
+        String result = "arraystore " + toString(index);
+        if (keepStack)
+            result += " -k";
+        return result;
+    }
+
+    /**
+     * Get the array variable that is assigned by the instruction.
+     * @return array storage index
+     */
+    int ArrayReferenceStore::getAssignedArray() {
+        return (int) index;
+    }
+#pragma endregion
+
+#pragma region ARRAY_LENGTH
+    /**
+     * Initialize the array length instruction.
+     */
+    ArrayLength::ArrayLength()
+        : ArrayInstruction(Instructions::ARRAY_LENGTH)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayLength::parse(String data, List<String> args, uint line, Executable* executable) {
+        // arraylength -l values -r length
+        parseOperands(args, executable, &result, array);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayLength::execute(Context* context) {
+        Array* array = this->array.get(context);
+        if (array == nullptr)
+            error("NullPointerException: Trying to get the length of a deleted array");
+        result.set(context, (int) array->length);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayLength::debug() {
+        return "arraylength " + array.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region ARRAY_COPY
+    /**
+     * Initialize the array copy instruction.
+     */
+    ArrayCopy::ArrayCopy()
+        : ArrayInstruction(Instructions::ARRAY_COPY)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayCopy::parse(String data, List<String> args, uint line, Executable* executable) {
+        // arraycopy -l source -c 0 -l target -c 4 -l count
+        parseOperands<int>(args, executable, nullptr, source, sourceOffset, target, targetOffset, count);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayCopy::execute(Context* context) {
+        Array* source = this->source.get(context);
+        int sourceOffset = this->sourceOffset.get(context);
+        Array* target = this->target.get(context);
+        int targetOffset = this->targetOffset.get(context);
+        int count = this->count.get(context);
+
+        // the whole range is checked once, instead of each copied element
+        if (source == nullptr)
+            error("NullPointerException: Trying to copy the elements of a deleted array");
+        checkType(target, source->type, "copy to");
+        if (sourceOffset < 0 || targetOffset < 0 || count < 0
+            || (lint) sourceOffset + count > source->length || (lint) targetOffset + count > target->length)
+            error("ArrayIndexOutOfBoundsException: Trying to copy " << count << " elements from index " << sourceOffset
+                << " of length " << source->length << " to index " << targetOffset << " of length " << target->length);
+
+        source->copy((uint) sourceOffset, target, (uint) targetOffset, (uint) count);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayCopy::debug() {
+        return "arraycopy " + source.debug() + " " + sourceOffset.debug() + " " + target.debug() + " "
+            + targetOffset.debug() + " " + count.debug();
+    }
+#pragma endregion
+
+#pragma region ARRAY_COMPARE
+    /**
+     * Initialize the array compare instruction.
+     */
+    ArrayCompare::ArrayCompare()
+        : ArrayInstruction(Instructions::ARRAY_COMPARE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayCompare::parse(String data, List<String> args, uint line, Executable* executable) {
+        // arraycompare -l first -l second -r mismatch
+        parseOperands(args, executable, &result, first, second);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayCompare::execute(Context* context) {
+        Array* first = this->first.get(context);
+        Array* second = this->second.get(context);
+        if (first == nullptr)
+            error("NullPointerException: Trying to compare a deleted array");
+        checkType(second, first->type, "compare");
+        result.set(context, first->compare(second));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayCompare::debug() {
+        return "arraycompare " + first.debug() + " " + second.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region ARRAY_DELETE
+    /**
+     * Initialize the array deletion instruction.
+     */
+    ArrayDelete::ArrayDelete()
+        : ArrayInstruction(Instructions::ARRAY_DELETE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayDelete::parse(String data, List<String> args, uint line, Executable* executable) {
+        // arraydelete -l values
+        parseOperands<int>(args, executable, nullptr, array);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayDelete::execute(Context* context) {
+        Array* array = this->array.get(context);
+        if (array != nullptr)
+            Array::release(array);
+        // clear the variable, so that a later access fails instead of reading the freed memory
+        if (this->array.target == Target::LOCAL)
+            context->storage->arrays.set(this->array.index, nullptr);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayDelete::debug() {
+        return "arraydelete " + array.debug();
+    }
+
+    /**
+     * Get the array variable that is assigned by the instruction.
+     * @return array storage index, or -1 if the array is deleted from the stack
+     */
+    int ArrayDelete::getAssignedArray() {
+        return array.target == Target::LOCAL ? (int) array.index : -1;
+    }
+#pragma endregion
+
+#pragma region ARRAY_RETURN
+    /**
+     * Initialize the array return instruction.
+     */
+    ArrayReturn::ArrayReturn()
+        : ArrayInstruction(Instructions::ARRAY_RETURN)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayReturn::parse(String data, List<String> args, uint line, Executable* executable) {
+        // arrayreturn -l values
+        parseOperands<int>(args, executable, nullptr, array);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayReturn::execute(Context* context) {
+        // terminate the execution and set the return value
+        context->terminate(array.get(context));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayReturn::debug() {
+        return "arrayreturn " + array.debug();
+    }
+#pragma endregion
+
+#pragma region ARRAY_DEBUG
+    /**
+     * Initialize the array debug instruction.
+     */
+    ArrayDebug::ArrayDebug()
+        : ArrayInstruction(Instructions::ARRAY_DEBUG)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void ArrayDebug::parse(String data, List<String> args, uint line, Executable* executable) {
+        // loop through the debug flags
+        for (uint i = 0; i < args.size(); i++) {
+            String flag = args[i];
+            // check if the debug should insert a new line afterwards
+            if (flag == "-n" || flag == "-new" || flag == "-newline" || flag == "-nl")
+                newLine = true;
+            // check if the array should be kept on the stack
+            else if (flag == "-k" || flag == "-keep" || flag == "-keepstack")
+                keepStack = true;
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void ArrayDebug::execute(Context* context) {
+        Array* array = context->stack->arrays.pull(keepStack);
+        Console::write(array != nullptr ? array->debug() : "null");
+        if (newLine)
+            Console::newLine();
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String ArrayDebug::debug() {
+        String result = "arraydebug";
+        if (newLine)
+            result += " -newline";
+        if (keepStack)
+            result += " -keepstack";
+        return result;
+    }
+#pragma endregion
+
+#pragma region VECTOR_OPERATION
+    /**
+     * Initialize the vector operation instruction.
+     * @param kind instruction type, one of VECTOR_ADD, VECTOR_MULTIPLY, VECTOR_MINIMUM, VECTOR_MAXIMUM
+     */
+    VectorOperation::VectorOperation(Instructions kind)
+        : ArrayInstruction(kind)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void VectorOperation::parse(String data, List<String> args, uint line, Executable* executable) {
+        // vadd -l first -l second -l target
+        parseOperands<int>(args, executable, nullptr, first, second, target);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void VectorOperation::execute(Context* context) {
+        Array* first = this->first.get(context);
+        Array* second = this->second.get(context);
+        Array* target = this->target.get(context);
+
+        // the lengths are checked once, the kernels do not check the bounds of the elements
+        checkVector(first, "combine");
+        checkMatching(first, second, "combine");
+        checkMatching(first, target, "combine");
+
+        if (first->type == 'F')
+            getKernel<float>(kind)(first->elements<float>(), second->elements<float>(), target->elements<float>(), first->length);
+        else
+            getKernel<double>(kind)(first->elements<double>(), second->elements<double>(), target->elements<double>(), first->length);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String VectorOperation::debug() {
+        String name;
+        switch (kind) {
+            case Instructions::VECTOR_ADD:
+                name = "vadd";
+                break;
+            case Instructions::VECTOR_MULTIPLY:
+                name = "vmul";
+                break;
+            case Instructions::VECTOR_MINIMUM:
+                name = "vmin";
+                break;
+            default:
+                name = "vmax";
+        }
+        return name + " " + first.debug() + " " + second.debug() + " " + target.debug();
+    }
+#pragma endregion
+
+#pragma region VECTOR_MULTIPLY_ADD
+    /**
+     * Initialize the vector multiply-add instruction.
+     */
+    VectorMultiplyAdd::VectorMultiplyAdd()
+        : ArrayInstruction(Instructions::VECTOR_MULTIPLY_ADD)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void VectorMultiplyAdd::parse(String data, List<String> args, uint line, Executable* executable) {
+        // vfma -l x -c 2.5 -l y -l y
+        parseOperands<int>(args, executable, nullptr, first, scalar, second, target);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void VectorMultiplyAdd::execute(Context* context) {
+        // the operands are retrieved in the order of the bytecode, the scalar is resolved once the type is known
+        Array* first = this->first.get(context);
+        checkVector(first, "multiply-add");
+        if (first->type == 'F') {
+            float scalar = getScalar<float>(this->scalar, context);
+            Array* second = this->second.get(context);
+            Array* target = this->target.get(context);
+            checkMatching(first, second, "multiply-add");
+            checkMatching(first, target, "multiply-add");
+            Vectors::get<float>().multiplyAdd(first->elements<float>(), scalar, second->elements<float>(),
+                target->elements<float>(), first->length);
+        }
+        else {
+            double scalar = getScalar<double>(this->scalar, context);
+            Array* second = this->second.get(context);
+            Array* target = this->target.get(context);
+            checkMatching(first, second, "multiply-add");
+            checkMatching(first, target, "multiply-add");
+            Vectors::get<double>().multiplyAdd(first->elements<double>(), scalar, second->elements<double>(),
+                target->elements<double>(), first->length);
+        }
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String VectorMultiplyAdd::debug() {
+        return "vfma " + first.debug() + " " + scalar.debug() + " " + second.debug() + " " + target.debug();
+    }
+#pragma endregion
+
+#pragma region VECTOR_REDUCTION
+    /**
+     * Initialize the vector reduction instruction.
+     * @param kind instruction type, one of VECTOR_SUM, VECTOR_DOT
+     */
+    VectorReduction::VectorReduction(Instructions kind)
+        : ArrayInstruction(kind)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void VectorReduction::parse(String data, List<String> args, uint line, Executable* executable) {
+        // vsum -l values -r total
+        // vdot -l first -l second -r product
+        if (kind == Instructions::VECTOR_DOT)
+            parseOperands(args, executable, &result, first, second);
+        else
+            parseOperands(args, executable, &result, first);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void VectorReduction::execute(Context* context) {
+        Array* first = this->first.get(context);
+        checkVector(first, "reduce");
+        Array* second = first;
+        if (kind == Instructions::VECTOR_DOT) {
+            second = this->second.get(context);
+            checkMatching(first, second, "reduce");
+        }
+
+        if (first->type == 'F') {
+            const Kernels<float>& kernels = Vectors::get<float>();
+            setScalar<float>(result, context, kind == Instructions::VECTOR_DOT
+                ? kernels.dot(first->elements<float>(), second->elements<float>(), first->length)
+                : kernels.sum(first->elements<float>(), first->length));
+        }
+        else {
+            const Kernels<double>& kernels = Vectors::get<double>();
+            setScalar<double>(result, context, kind == Instructions::VECTOR_DOT
+                ? kernels.dot(first->elements<double>(), second->elements<double>(), first->length)
+                : kernels.sum(first->elements<double>(), first->length));
+        }
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String VectorReduction::debug() {
+        if (kind == Instructions::VECTOR_DOT)
+            return "vdot " + first.debug() + " " + second.debug() + debugResult(result);
+        return "vsum " + first.debug() + debugResult(result);
+    }
+#pragma endregion
+}
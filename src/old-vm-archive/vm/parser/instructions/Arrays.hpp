@@ -0,0 +1,803 @@
+#pragma once
+
+#include "Operands.hpp"
+
+#ifdef VOID_INSTRUCTION
+namespace Void {
+    /**
+     * Represents an instruction that operates on primitive arrays.
+     */
+    class ArrayInstruction : public Instruction {
+    public:
+        /**
+         * Initialize the array instruction.
+         * @param kind instruction type
+         */
+        ArrayInstruction(Instructions kind);
+
+        /**
+         * Get the array variable that is assigned by the instruction.
+         * @return array storage index, or -1 if the instruction does not assign an array variable
+         */
+        virtual int getAssignedArray();
+    };
+
+    /**
+     * Represents an instruction that accesses an element of an array. The index of the element is checked
+     * against the bounds of the array, unless the verifier has proven that it is always in range.
+     */
+    class ArrayAccess : public ArrayInstruction {
+    protected:
+        /**
+         * The accessed array.
+         */
+        Operand<Array*> array;
+
+        /**
+         * The index of the accessed element.
+         */
+        Operand<int> index;
+
+        /**
+         * Determine if the index is checked against the bounds of the array.
+         */
+        bool checked = true;
+
+    public:
+        /**
+         * Initialize the array access instruction.
+         * @param kind instruction type
+         */
+        ArrayAccess(Instructions kind);
+
+        /**
+         * Get the constant index of an element of an array variable.
+         * @param arrayIndex the storage index of the accessed array
+         * @param elementIndex the constant index of the accessed element
+         * @return true if the array is a local variable and the element index is a constant
+         */
+        bool hasConstantIndex(uint& arrayIndex, int& elementIndex);
+
+        /**
+         * Remove the bounds check of the access, as the index has been proven to be in range.
+         */
+        void removeBoundsCheck();
+    };
+
+    /**
+     * Represents an instruction that allocates an array.
+     */
+    class ArrayAllocation : public ArrayInstruction {
+    protected:
+        /**
+         * The element count of the new array.
+         */
+        Operand<int> length;
+
+        /**
+         * The target of the new array.
+         */
+        Operand<Array*> result;
+
+    public:
+        /**
+         * Initialize the array allocation instruction.
+         * @param kind instruction type
+         */
+        ArrayAllocation(Instructions kind);
+
+        /**
+         * Get the array variable that is assigned by the instruction.
+         * @return array storage index, or -1 if the array is pushed to the stack
+         */
+        int getAssignedArray() override;
+
+        /**
+         * Get the constant length of the new array.
+         * @param length array element count
+         * @return true if the length is a constant
+         */
+        bool hasConstantLength(int& length);
+    };
+
+#pragma region ARRAY_NEW
+    /**
+     * Represents an instruction that allocates a new primitive array.
+     */
+    template <typename T>
+    class ArrayNew : public ArrayAllocation {
+    public:
+        /**
+         * Initialize the array creation instruction.
+         */
+        ArrayNew();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_LOAD
+    /**
+     * Represents an instruction that loads an element of an array.
+     */
+    template <typename T>
+    class ArrayLoad : public ArrayAccess {
+    private:
+        /**
+         * The target of the loaded element.
+         */
+        Operand<T> result;
+
+    public:
+        /**
+         * Initialize the array element load instruction.
+         */
+        ArrayLoad();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_STORE
+    /**
+     * Represents an instruction that stores an element in an array.
+     */
+    template <typename T>
+    class ArrayStore : public ArrayAccess {
+    private:
+        /**
+         * The stored element.
+         */
+        Operand<T> value;
+
+    public:
+        /**
+         * Initialize the array element store instruction.
+         */
+        ArrayStore();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_FILL
+    /**
+     * Represents an instruction that sets every element of an array to the same value.
+     */
+    template <typename T>
+    class ArrayFill : public ArrayInstruction {
+    private:
+        /**
+         * The filled array.
+         */
+        Operand<Array*> array;
+
+        /**
+         * The value of the elements.
+         */
+        Operand<T> value;
+
+    public:
+        /**
+         * Initialize the array fill instruction.
+         */
+        ArrayFill();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_REFERENCE_LOAD
+    /**
+     * Represents an instruction that loads an array from the storage.
+     */
+    class ArrayReferenceLoad : public ArrayInstruction {
+    private:
+        /**
+         * The storage index to load the array from.
+         */
+        uint index = 0;
+
+    public:
+        /**
+         * Initialize the array load instruction.
+         */
+        ArrayReferenceLoad();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_REFERENCE_STORE
+    /**
+     * Represents an instruction that stores an array in the storage.
+     */
+    class ArrayReferenceStore : public ArrayInstruction {
+    private:
+        /**
+         * The storage index to store the array into.
+         */
+        uint index = 0;
+
+        /**
+         * Determine if the array should be kept on the stack.
+         */
+        bool keepStack = false;
+
+    public:
+        /**
+         * Initialize the array store instruction.
+         */
+        ArrayReferenceStore();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+
+        /**
+         * Get the array variable that is assigned by the instruction.
+         * @return array storage index
+         */
+        int getAssignedArray() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_LENGTH
+    /**
+     * Represents an instruction that retrieves the element count of an array.
+     */
+    class ArrayLength : public ArrayInstruction {
+    private:
+        /**
+         * The measured array.
+         */
+        Operand<Array*> array;
+
+        /**
+         * The target of the array length.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the array length instruction.
+         */
+        ArrayLength();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_COPY
+    /**
+     * Represents an instruction that copies a range of elements between two arrays of the same type.
+     */
+    class ArrayCopy : public ArrayInstruction {
+    private:
+        /**
+         * The array to copy the elements from.
+         */
+        Operand<Array*> source;
+
+        /**
+         * The index of the first copied element of the source.
+         */
+        Operand<int> sourceOffset;
+
+        /**
+         * The array to copy the elements into.
+         */
+        Operand<Array*> target;
+
+        /**
+         * The index of the first overwritten element of the target.
+         */
+        Operand<int> targetOffset;
+
+        /**
+         * The count of the copied elements.
+         */
+        Operand<int> count;
+
+    public:
+        /**
+         * Initialize the array copy instruction.
+         */
+        ArrayCopy();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_COMPARE
+    /**
+     * Represents an instruction that finds the first mismatching element of two arrays of the same type.
+     */
+    class ArrayCompare : public ArrayInstruction {
+    private:
+        /**
+         * The first compared array.
+         */
+        Operand<Array*> first;
+
+        /**
+         * The second compared array.
+         */
+        Operand<Array*> second;
+
+        /**
+         * The target of the mismatch index.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the array compare instruction.
+         */
+        ArrayCompare();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_DELETE
+    /**
+     * Represents an instruction that deletes an array from the memory.
+     */
+    class ArrayDelete : public ArrayInstruction {
+    private:
+        /**
+         * The deleted array.
+         */
+        Operand<Array*> array;
+
+    public:
+        /**
+         * Initialize the array deletion instruction.
+         */
+        ArrayDelete();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+
+        /**
+         * Get the array variable that is assigned by the instruction.
+         * @return array storage index, or -1 if the array is deleted from the stack
+         */
+        int getAssignedArray() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_RETURN
+    /**
+     * Represents an instruction that returns an array from the method.
+     */
+    class ArrayReturn : public ArrayInstruction {
+    private:
+        /**
+         * The returned array.
+         */
+        Operand<Array*> array;
+
+    public:
+        /**
+         * Initialize the array return instruction.
+         */
+        ArrayReturn();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region ARRAY_DEBUG
+    /**
+     * Represents an instruction that prints the elements of the array on the stack.
+     */
+    class ArrayDebug : public ArrayInstruction {
+    private:
+        /**
+         * Determine if a new line should be inserted after the array.
+         */
+        bool newLine = false;
+
+        /**
+         * Determine if the array should be kept on the stack.
+         */
+        bool keepStack = false;
+
+    public:
+        /**
+         * Initialize the array debug instruction.
+         */
+        ArrayDebug();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region VECTOR_OPERATION
+    /**
+     * Represents an instruction that combines the elements of two float or double arrays of the same length
+     * into a third one, using the vector kernels that are selected for the processor.
+     */
+    class VectorOperation : public ArrayInstruction {
+    private:
+        /**
+         * The first operand array.
+         */
+        Operand<Array*> first;
+
+        /**
+         * The second operand array.
+         */
+        Operand<Array*> second;
+
+        /**
+         * The array to write the results into, that may be one of the operands.
+         */
+        Operand<Array*> target;
+
+    public:
+        /**
+         * Initialize the vector operation instruction.
+         * @param kind instruction type, one of VECTOR_ADD, VECTOR_MULTIPLY, VECTOR_MINIMUM, VECTOR_MAXIMUM
+         */
+        VectorOperation(Instructions kind);
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region VECTOR_MULTIPLY_ADD
+    /**
+     * Represents an instruction that multiplies the elements of an array by a scalar, and adds the elements
+     * of another array. The scalar is a float or a double, depending on the type of the arrays.
+     */
+    class VectorMultiplyAdd : public ArrayInstruction {
+    private:
+        /**
+         * The array to multiply by the scalar.
+         */
+        Operand<Array*> first;
+
+        /**
+         * The scalar factor. A constant is parsed as a double, and narrowed for float arrays.
+         */
+        Operand<double> scalar;
+
+        /**
+         * The array to add to the products.
+         */
+        Operand<Array*> second;
+
+        /**
+         * The array to write the results into, that may be one of the operands.
+         */
+        Operand<Array*> target;
+
+    public:
+        /**
+         * Initialize the vector multiply-add instruction.
+         */
+        VectorMultiplyAdd();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region VECTOR_REDUCTION
+    /**
+     * Represents an instruction that reduces one or two float or double arrays to a single value. The result
+     * is a float or a double, depending on the type of the arrays.
+     */
+    class VectorReduction : public ArrayInstruction {
+    private:
+        /**
+         * The first operand array.
+         */
+        Operand<Array*> first;
+
+        /**
+         * The second operand array of the dot product.
+         */
+        Operand<Array*> second;
+
+        /**
+         * The target of the reduced value.
+         */
+        Operand<double> result;
+
+    public:
+        /**
+         * Initialize the vector reduction instruction.
+         * @param kind instruction type, one of VECTOR_SUM, VECTOR_DOT
+         */
+        VectorReduction(Instructions kind);
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+}
+#endif
@@ -196,6 +196,8 @@ namespace Void {
     void DoubleEnsure::parse(String data, List<String> args, uint line, Executable* executable) {
         // parse the double storage required size
         size = stringToInt(args[0]);
+        // register the instruction, so that the storage is sized before the method arguments are copied
+        executable->ensures.push_back(this);
     }
 
     /**
@@ -203,7 +205,7 @@ namespace Void {
      * @param context bytecode execution context
      */
     void DoubleEnsure::execute(Context* context) {
-        context->storage->ensure(StorageUnit::INT, size);
+        context->storage->ensure(StorageUnit::DOUBLE, size);
     }
 
     /**
@@ -1239,10 +1241,10 @@ namespace Void {
     void DoubleDebug::execute(Context* context) {
         // get the value from the stack
         double value = context->stack->doubles.pull(keepStack);
-        // double:pr the value and insert a new line if the flag is set
-        print(value);
+        // print the value and insert a new line if the flag is set
+        Console::write(value);
         if (newLine)
-            println("");
+            Console::newLine();
     }
 
     /**
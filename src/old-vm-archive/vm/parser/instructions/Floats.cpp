@@ -184,6 +184,8 @@ namespace Void {
     void FloatEnsure::parse(String data, List<String> args, uint line, Executable* executable) {
         // parse the float storage required size
         size = stringToInt(args[0]);
+        // register the instruction, so that the storage is sized before the method arguments are copied
+        executable->ensures.push_back(this);
     }
 
     /**
@@ -191,7 +193,7 @@ namespace Void {
      * @param context bytecode execution context
      */
     void FloatEnsure::execute(Context* context) {
-        context->storage->ensure(StorageUnit::INT, size);
+        context->storage->ensure(StorageUnit::FLOAT, size);
     }
 
     /**
@@ -1227,10 +1229,10 @@ namespace Void {
     void FloatDebug::execute(Context* context) {
         // get the value from the stack
         float value = context->stack->floats.pull(keepStack);
-        // float:pr the value and insert a new line if the flag is set
-        print(value);
+        // print the value and insert a new line if the flag is set
+        Console::write(value);
         if (newLine)
-            println("");
+            Console::newLine();
     }
 
     /**
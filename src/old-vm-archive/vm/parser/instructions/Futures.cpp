@@ -0,0 +1,353 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../../element/Method.hpp"
+#include "Futures.hpp"
+#include "../../VirtualMachine.hpp"
+#include "../../runtime/Future.hpp"
+#include "../../runtime/Fiber.hpp"
+#include "../../runtime/Text.hpp"
+#include "../../../util/Lists.hpp"
+
+namespace Void {
+    /**
+     * Get the future of an identifier operand.
+     * @param context bytecode execution context
+     * @param operand future identifier operand
+     * @param action the name of the operation, that is reported if the future is missing
+     * @return retrieved future, or nullptr if the fiber has failed
+     */
+    static Future* getFuture(Context* context, Operand<int>& operand, String action) {
+        int id = operand.get(context);
+        Future* future = id < 0 ? nullptr : context->executable->vm->getFuture((uint) id);
+        if (future == nullptr)
+            context->fiber->fail("IllegalStateException: Trying to " + action + " undefined future " + toString(id));
+        return future;
+    }
+
+#pragma region ASYNC
+    /**
+     * Initialize the asynchronous call instruction.
+     */
+    Async::Async()
+        : Instruction(Instructions::ASYNC)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void Async::parse(String data, List<String> args, uint line, Executable* executable) {
+        // async <class> <method> <parameters...> -r future
+        List<String> flags = target.parse(args);
+        parseOperands<int>(flags, executable, &result);
+    }
+
+    /**
+     * Initialize the references in the const pool after the whole program has been parsed.
+     * @param vm running virtual machine
+     * @param executable bytecode executor
+     */
+    void Async::initialize(VirtualMachine* vm, Executable* executable) {
+        target.initialize(vm);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void Async::execute(Context* context) {
+        VirtualMachine* vm = context->executable->vm;
+        Method* method = target.resolve(context, "submit");
+        if (method == nullptr)
+            return;
+        result.set(context, (int) vm->submitTask(method, context->stack)->id);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String Async::debug() {
+        return "async " + target.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region THEN
+    /**
+     * Initialize the future chaining instruction.
+     */
+    Then::Then()
+        : Instruction(Instructions::THEN)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void Then::parse(String data, List<String> args, uint line, Executable* executable) {
+        // then <class> <method> <parameters...> -l future -r chained
+        List<String> flags = target.parse(args);
+        parseOperands(flags, executable, &result, source);
+    }
+
+    /**
+     * Initialize the references in the const pool after the whole program has been parsed.
+     * @param vm running virtual machine
+     * @param executable bytecode executor
+     */
+    void Then::initialize(VirtualMachine* vm, Executable* executable) {
+        target.initialize(vm);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void Then::execute(Context* context) {
+        VirtualMachine* vm = context->executable->vm;
+        Future* future = getFuture(context, source, "chain");
+        if (future == nullptr)
+            return;
+        Method* method = target.resolve(context, "chain");
+        if (method == nullptr)
+            return;
+        Future* chained = vm->chainTask(future, method, context->stack);
+        if (chained == nullptr) {
+            context->fiber->fail("IllegalArgumentException: The last parameter of method " + method->name
+                + " does not accept the result of future " + toString(future->id));
+            return;
+        }
+        result.set(context, (int) chained->id);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String Then::debug() {
+        return "then " + target.debug() + " " + source.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region AWAIT
+    /**
+     * Initialize the future await instruction.
+     */
+    Await::Await()
+        : Instruction(Instructions::AWAIT)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void Await::parse(String data, List<String> args, uint line, Executable* executable) {
+        // await -l future
+        parseOperands<int>(args, executable, nullptr, future);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void Await::execute(Context* context) {
+        Future* awaited = getFuture(context, future, "await");
+        if (awaited == nullptr)
+            return;
+        // a task does not block its worker, it is suspended, and this instruction is executed again when it is resumed
+        Fiber* fiber = context->fiber;
+        if (fiber->asynchronous && fiber->monitors == 0 && awaited->getState() == Future::State::EMPTY) {
+            context->cursor--;
+            fiber->await(awaited);
+            return;
+        }
+        if (!awaited->await(context->stack))
+            fiber->fail("FutureExecutionError: Future " + toString(awaited->id) + " has failed: " + awaited->getError());
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String Await::debug() {
+        return "await " + future.debug();
+    }
+#pragma endregion
+
+#pragma region FUTURE_NEW
+    /**
+     * Initialize the future creation instruction.
+     */
+    FutureNew::FutureNew()
+        : Instruction(Instructions::FUTURE_NEW)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void FutureNew::parse(String data, List<String> args, uint line, Executable* executable) {
+        // fnew <type> -r future
+        if (args.empty() || args[0].starts_with("-"))
+            error("InvalidBytecodeException: The result type of the future is missing");
+        type = args[0][0];
+        List<String> flags = Lists::subList(args, 1);
+        parseOperands<int>(flags, executable, &result);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void FutureNew::execute(Context* context) {
+        result.set(context, (int) context->executable->vm->createFuture(type)->id);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String FutureNew::debug() {
+        return "fnew " + String(1, type) + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region FUTURE_COMPLETE
+    /**
+     * Initialize the future completion instruction.
+     */
+    FutureComplete::FutureComplete()
+        : Instruction(Instructions::FUTURE_COMPLETE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void FutureComplete::parse(String data, List<String> args, uint line, Executable* executable) {
+        // fcomplete -l future -r completed
+        parseOperands(args, executable, &result, future);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void FutureComplete::execute(Context* context) {
+        Future* target = getFuture(context, future, "complete");
+        if (target == nullptr)
+            return;
+        // the value is taken from the stack of its type
+        bool completed = target->complete(context->stack);
+        if (result.target == Target::LOCAL)
+            result.set(context, completed);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String FutureComplete::debug() {
+        return "fcomplete " + future.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region FUTURE_FAIL
+    /**
+     * Initialize the future failure instruction.
+     */
+    FutureFail::FutureFail()
+        : Instruction(Instructions::FUTURE_FAIL)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void FutureFail::parse(String data, List<String> args, uint line, Executable* executable) {
+        // ffail -l future -l message -r failed
+        parseOperands(args, executable, &result, future, message);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void FutureFail::execute(Context* context) {
+        Future* target = getFuture(context, this->future, "fail");
+        if (target == nullptr)
+            return;
+        Text* text = message.get(context);
+        bool failed = target->fail(text == nullptr ? "null" : text->value());
+        // the message is released, if it was taken from the stack
+        if (message.target == Target::STACK)
+            Text::release(text);
+        if (result.target == Target::LOCAL)
+            result.set(context, failed);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String FutureFail::debug() {
+        return "ffail " + future.debug() + " " + message.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region FUTURE_STATE
+    /**
+     * Initialize the future state instruction.
+     */
+    FutureStatus::FutureStatus()
+        : Instruction(Instructions::FUTURE_STATE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void FutureStatus::parse(String data, List<String> args, uint line, Executable* executable) {
+        // fstate -l future -r state
+        parseOperands(args, executable, &result, future);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void FutureStatus::execute(Context* context) {
+        Future* target = getFuture(context, future, "get the state of");
+        if (target != nullptr)
+            result.set(context, static_cast<int>(target->getState()));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String FutureStatus::debug() {
+        return "fstate " + future.debug() + debugResult(result);
+    }
+#pragma endregion
+}
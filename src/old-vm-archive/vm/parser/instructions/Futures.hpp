@@ -0,0 +1,345 @@
+#pragma once
+
+#include "Threads.hpp"
+
+#ifdef VOID_INSTRUCTION
+namespace Void {
+#pragma region ASYNC
+    /**
+     * Represents an instruction that submits a static class method to the task pool of the virtual machine.
+     * The arguments of the method are moved from the stack, and the result of the method completes a new future.
+     */
+    class Async : public Instruction {
+    private:
+        /**
+         * The method executed by the task.
+         */
+        StaticTarget target;
+
+        /**
+         * The target of the future identifier.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the asynchronous call instruction.
+         */
+        Async();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Initialize the references in the const pool after the whole program has been parsed.
+         * @param vm running virtual machine
+         * @param executable bytecode executor
+         */
+        void initialize(VirtualMachine* vm, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region THEN
+    /**
+     * Represents an instruction that submits a static class method to the task pool, after a future has been completed.
+     * The result of the future is passed as the last argument of the method, and the result of the method completes
+     * a new future. The new future fails, if the awaited future has failed.
+     */
+    class Then : public Instruction {
+    private:
+        /**
+         * The method executed by the task.
+         */
+        StaticTarget target;
+
+        /**
+         * The identifier of the awaited future.
+         */
+        Operand<int> source;
+
+        /**
+         * The target of the identifier of the new future.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the future chaining instruction.
+         */
+        Then();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Initialize the references in the const pool after the whole program has been parsed.
+         * @param vm running virtual machine
+         * @param executable bytecode executor
+         */
+        void initialize(VirtualMachine* vm, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region AWAIT
+    /**
+     * Represents an instruction that waits until a future is completed, and pushes its result to the stack.
+     * A task of the pool is suspended until the future is completed, an other thread runs the queued tasks meanwhile.
+     */
+    class Await : public Instruction {
+    private:
+        /**
+         * The identifier of the awaited future.
+         */
+        Operand<int> future;
+
+    public:
+        /**
+         * Initialize the future await instruction.
+         */
+        Await();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region FUTURE_NEW
+    /**
+     * Represents an instruction that creates an empty future, that is completed by the bytecode.
+     */
+    class FutureNew : public Instruction {
+    private:
+        /**
+         * The type descriptor of the result value.
+         */
+        char type = 'V';
+
+        /**
+         * The target of the future identifier.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the future creation instruction.
+         */
+        FutureNew();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region FUTURE_COMPLETE
+    /**
+     * Represents an instruction that completes a future with the value on the stack.
+     */
+    class FutureComplete : public Instruction {
+    private:
+        /**
+         * The identifier of the completed future.
+         */
+        Operand<int> future;
+
+        /**
+         * The local variable of the result, if it is requested, 1 if the future was completed by the instruction.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the future completion instruction.
+         */
+        FutureComplete();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region FUTURE_FAIL
+    /**
+     * Represents an instruction that fails a future with an error message.
+     */
+    class FutureFail : public Instruction {
+    private:
+        /**
+         * The identifier of the failed future.
+         */
+        Operand<int> future;
+
+        /**
+         * The error message of the future.
+         */
+        Operand<Text*> message;
+
+        /**
+         * The local variable of the result, if it is requested, 1 if the future was failed by the instruction.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the future failure instruction.
+         */
+        FutureFail();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region FUTURE_STATE
+    /**
+     * Represents an instruction that gets the state of a future, 0 if it is empty, 1 if it is completed, 2 if it is failed.
+     */
+    class FutureStatus : public Instruction {
+    private:
+        /**
+         * The identifier of the future.
+         */
+        Operand<int> future;
+
+        /**
+         * The target of the state.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the future state instruction.
+         */
+        FutureStatus();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+}
+#endif
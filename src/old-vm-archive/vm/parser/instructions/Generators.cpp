@@ -0,0 +1,205 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../../element/Method.hpp"
+#include "Generators.hpp"
+#include "../../VirtualMachine.hpp"
+#include "../../runtime/Generator.hpp"
+#include "../../runtime/Fiber.hpp"
+
+namespace Void {
+    /**
+     * Get the generator of an identifier operand.
+     * @param context bytecode execution context
+     * @param operand generator identifier operand
+     * @param action the name of the operation, that is reported if the generator is missing
+     * @return retrieved generator, or nullptr if the fiber has failed
+     */
+    static Generator* getGenerator(Context* context, Operand<int>& operand, String action) {
+        int id = operand.get(context);
+        Generator* generator = id < 0 ? nullptr : context->executable->vm->getGenerator((uint) id);
+        if (generator == nullptr)
+            context->fiber->fail("IllegalStateException: Trying to " + action + " undefined generator " + toString(id));
+        return generator;
+    }
+
+#pragma region GENERATOR_NEW
+    /**
+     * Initialize the generator creation instruction.
+     */
+    GeneratorNew::GeneratorNew()
+        : Instruction(Instructions::GENERATOR_NEW)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void GeneratorNew::parse(String data, List<String> args, uint line, Executable* executable) {
+        // gnew <class> <method> <parameters...> -r generator
+        List<String> flags = target.parse(args);
+        parseOperands<int>(flags, executable, &result);
+    }
+
+    /**
+     * Initialize the references in the const pool after the whole program has been parsed.
+     * @param vm running virtual machine
+     * @param executable bytecode executor
+     */
+    void GeneratorNew::initialize(VirtualMachine* vm, Executable* executable) {
+        target.initialize(vm);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void GeneratorNew::execute(Context* context) {
+        VirtualMachine* vm = context->executable->vm;
+        Method* method = target.resolve(context, "generate values of");
+        if (method == nullptr)
+            return;
+        Generator* generator = vm->createGenerator(method, context->stack);
+        if (generator == nullptr) {
+            context->fiber->fail("IllegalArgumentException: Native method " + method->name + " cannot yield values");
+            return;
+        }
+        result.set(context, (int) generator->id);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String GeneratorNew::debug() {
+        return "gnew " + target.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region GENERATOR_HAS_NEXT
+    /**
+     * Initialize the generator value check instruction.
+     */
+    GeneratorHasNext::GeneratorHasNext()
+        : Instruction(Instructions::GENERATOR_HAS_NEXT)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void GeneratorHasNext::parse(String data, List<String> args, uint line, Executable* executable) {
+        // ghas -l generator -r result
+        parseOperands(args, executable, &result, generator);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void GeneratorHasNext::execute(Context* context) {
+        Generator* target = getGenerator(context, generator, "check");
+        if (target == nullptr)
+            return;
+        result.set(context, target->hasNext(context->fiber) ? 1 : 0);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String GeneratorHasNext::debug() {
+        return "ghas " + generator.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region GENERATOR_NEXT
+    /**
+     * Initialize the generator value request instruction.
+     */
+    GeneratorNext::GeneratorNext()
+        : Instruction(Instructions::GENERATOR_NEXT)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void GeneratorNext::parse(String data, List<String> args, uint line, Executable* executable) {
+        // gnext -l generator
+        parseOperands<int>(args, executable, nullptr, generator);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void GeneratorNext::execute(Context* context) {
+        Generator* target = getGenerator(context, generator, "request the next value of");
+        if (target != nullptr)
+            target->next(context->fiber, context->stack);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String GeneratorNext::debug() {
+        return "gnext " + generator.debug();
+    }
+#pragma endregion
+
+#pragma region YIELD
+    /**
+     * Initialize the value yield instruction.
+     */
+    Yield::Yield()
+        : Instruction(Instructions::YIELD)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void Yield::parse(String data, List<String> args, uint line, Executable* executable) {
+        // yield, the value is moved from the stack
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void Yield::execute(Context* context) {
+        // the methods called by the generator method yield to the same generator, as they are executed by its fiber
+        Generator* generator = context->fiber->generator;
+        if (generator == nullptr) {
+            context->fiber->fail("IllegalStateException: Trying to yield a value outside of a generator");
+            return;
+        }
+        // the generator may be resumed by an other thread, that could not release the locks of this one
+        if (context->fiber->monitors != 0) {
+            context->fiber->fail("IllegalMonitorStateException: Trying to yield a value while holding a lock");
+            return;
+        }
+        generator->yield(context->stack);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String Yield::debug() {
+        return "yield";
+    }
+#pragma endregion
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Threads.hpp"
+
+#ifdef VOID_INSTRUCTION
+namespace Void {
+#pragma region GENERATOR_NEW
+    /**
+     * Represents an instruction that creates a generator of the values, that a static class method yields.
+     * The arguments of the method are moved from the stack, the method is executed when the first value is requested.
+     */
+    class GeneratorNew : public Instruction {
+    private:
+        /**
+         * The method, that yields the values.
+         */
+        StaticTarget target;
+
+        /**
+         * The target of the generator identifier.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the generator creation instruction.
+         */
+        GeneratorNew();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Initialize the references in the const pool after the whole program has been parsed.
+         * @param vm running virtual machine
+         * @param executable bytecode executor
+         */
+        void initialize(VirtualMachine* vm, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region GENERATOR_HAS_NEXT
+    /**
+     * Represents an instruction that determines if a generator has a next value. The method of the generator
+     * is resumed until it yields a value or returns.
+     */
+    class GeneratorHasNext : public Instruction {
+    private:
+        /**
+         * The identifier of the generator.
+         */
+        Operand<int> generator;
+
+        /**
+         * The target of the check result, 1 if there is a next value, 0 otherwise.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the generator value check instruction.
+         */
+        GeneratorHasNext();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region GENERATOR_NEXT
+    /**
+     * Represents an instruction that pushes the next value of a generator to the stack.
+     */
+    class GeneratorNext : public Instruction {
+    private:
+        /**
+         * The identifier of the generator.
+         */
+        Operand<int> generator;
+
+    public:
+        /**
+         * Initialize the generator value request instruction.
+         */
+        GeneratorNext();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region YIELD
+    /**
+     * Represents an instruction that moves a value from the stack to the generator, that executes the method,
+     * and suspends the method until the next value is requested. The generator fails, if it yields a value
+     * while it holds a lock.
+     */
+    class Yield : public Instruction {
+    public:
+        /**
+         * Initialize the value yield instruction.
+         */
+        Yield();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+}
+#endif
@@ -1,4 +1,5 @@
 #include "Instances.hpp"
+#include "../../runtime/Fiber.hpp"
 
 namespace Void {
 #pragma region NEW
@@ -37,7 +38,7 @@ namespace Void {
      */
     void New::initialize(VirtualMachine* vm, Executable* executable) {
         // get the class reference from the virtual machine
-        classRef = vm->getClass(className);
+        classRef.store(vm->getClass(className), std::memory_order_release);
         // we don't need to check if the class is actually found here, as 
         // it might be loaded afterwards
     }
@@ -48,18 +49,21 @@ namespace Void {
      */
     void New::execute(Context* context) {
         // check if the class is missing
-        if (classRef == nullptr) {
+        Class* clazz = classRef.load(std::memory_order_acquire);
+        if (clazz == nullptr) {
             // try to load the class reference again, as it was possibly lodaded
-            // after this instruction was initialized
-            classRef = context->executable->vm->getClass(className);
+            // after this instruction was initialized, every thread resolves the same class
+            clazz = context->executable->vm->getClass(className);
             // check if the class is still missing
-            if (classRef == nullptr)
-                // TODO throw an error instead of panicing
-                error("NoSuchClassException: Trying to create instance of undefined class " << className);
+            if (clazz == nullptr) {
+                context->fiber->fail("NoSuchClassException: Trying to create instance of undefined class " + className);
+                return;
+            }
+            classRef.store(clazz, std::memory_order_release);
         }
 
         // create a new instance of the class
-        Instance* instance = new Instance(classRef);
+        Instance* instance = new Instance(clazz);
         // create a wrapper smart pointer for the instance
         Reference<Instance*>* reference = new Reference(instance);
 
@@ -427,13 +431,13 @@ namespace Void {
         Reference<Instance*>* reference = context->stack->instances.pull(keepStack);
         // handle null reference debug
         if (reference == nullptr || !reference->exists)
-            print("null");
+            Console::write("null");
         // print the instance debug message
         else
-            print(reference->data->debug());
+            Console::write(reference->data->debug());
         // insert a new line if the instruction flag is set
         if (newLine)
-            println("");
+            Console::newLine();
     }
 
     /**
@@ -449,4 +453,142 @@ namespace Void {
         return result;
     }
 #pragma endregion
-}
\ No newline at end of file
+
+    /**
+     * Get the lock of the instance, that a monitor instruction operates on.
+     * @param context bytecode execution context
+     * @param source the target of the instance
+     * @param sourceIndex the storage index of the instance
+     * @param action the name of the operation, that is reported if the instance is missing
+     * @return instance lock, or nullptr if the fiber has failed
+     */
+    static Monitor* getMonitor(Context* context, Target source, uint sourceIndex, String action) {
+        Reference<Instance*>* reference = nullptr;
+        switch (source) {
+            case Target::STACK:
+                reference = context->stack->instances.pull();
+                break;
+            case Target::LOCAL:
+                reference = context->storage->instances.get(sourceIndex);
+                break;
+        }
+        if (reference == nullptr || !reference->exists) {
+            context->fiber->fail("NullPointerException: Trying to " + action + " the lock of a deleted instance");
+            return nullptr;
+        }
+        return &reference->data->monitor;
+    }
+
+#pragma region MONITOR_ENTER
+    /**
+     * Initialize the instance lock instruction.
+     */
+    MonitorEnter::MonitorEnter()
+        : Instruction(Instructions::MONITOR_ENTER)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void MonitorEnter::parse(String data, List<String> args, uint line, Executable* executable) {
+        // loop through the instruction data
+        for (uint i = 0; i < args.size(); i++) {
+            // get the current argument
+            String arg = args[i];
+            // handle value from local variable
+            if (arg == "-l" || arg == "-local") {
+                source = Target::LOCAL;
+                sourceIndex = executable->getLinker(args[++i]);
+            }
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void MonitorEnter::execute(Context* context) {
+        Monitor* monitor = getMonitor(context, source, sourceIndex, "acquire");
+        // the fiber is not suspended while it holds a lock, so the lock is released by the same thread
+        if (monitor != nullptr)
+            context->fiber->lock(monitor);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String MonitorEnter::debug() {
+        String result = "monitorenter";
+        switch (source) {
+            case Target::STACK:
+                result += " -stack";
+                break;
+            case Target::LOCAL:
+                result += " -local";
+                break;
+        }
+        return result;
+    }
+#pragma endregion
+
+#pragma region MONITOR_EXIT
+    /**
+     * Initialize the instance unlock instruction.
+     */
+    MonitorExit::MonitorExit()
+        : Instruction(Instructions::MONITOR_EXIT)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void MonitorExit::parse(String data, List<String> args, uint line, Executable* executable) {
+        // loop through the instruction data
+        for (uint i = 0; i < args.size(); i++) {
+            // get the current argument
+            String arg = args[i];
+            // handle value from local variable
+            if (arg == "-l" || arg == "-local") {
+                source = Target::LOCAL;
+                sourceIndex = executable->getLinker(args[++i]);
+            }
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void MonitorExit::execute(Context* context) {
+        Monitor* monitor = getMonitor(context, source, sourceIndex, "release");
+        if (monitor != nullptr && !context->fiber->unlock(monitor))
+            context->fiber->fail("IllegalMonitorStateException: The current thread does not hold the lock");
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String MonitorExit::debug() {
+        String result = "monitorexit";
+        switch (source) {
+            case Target::STACK:
+                result += " -stack";
+                break;
+            case Target::LOCAL:
+                result += " -local";
+                break;
+        }
+        return result;
+    }
+#pragma endregion
+}
@@ -16,9 +16,9 @@ namespace Void {
         String className;
 
         /**
-         * The reference of the target class.
+         * The reference of the target class, that may be resolved by any of the threads.
          */
-        Class* classRef = nullptr;
+        std::atomic<Class*> classRef = nullptr;
 
         /**
          * The target of the instance creation result.
@@ -375,5 +375,97 @@ namespace Void {
         String debug() override;
     };
 #pragma endregion
+
+#pragma region MONITOR_ENTER
+    /**
+     * Represents an instruction that acquires the lock of an instance, the beginning of a synchronized block.
+     * The thread waits until the other threads release the lock.
+     */
+    class MonitorEnter : public Instruction {
+    private:
+        /**
+         * The target of the locked instance.
+         */
+        Target source = Target::STACK;
+
+        /**
+         * The storage index of the locked instance.
+         */
+        uint sourceIndex = 0;
+
+    public:
+        /**
+         * Initialize the instance lock instruction.
+         */
+        MonitorEnter();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region MONITOR_EXIT
+    /**
+     * Represents an instruction that releases the lock of an instance, the end of a synchronized block.
+     * The lock must be held by the current thread.
+     */
+    class MonitorExit : public Instruction {
+    private:
+        /**
+         * The target of the locked instance.
+         */
+        Target source = Target::STACK;
+
+        /**
+         * The storage index of the locked instance.
+         */
+        uint sourceIndex = 0;
+
+    public:
+        /**
+         * Initialize the instance unlock instruction.
+         */
+        MonitorExit();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
 }
 #endif
\ No newline at end of file
@@ -184,6 +184,8 @@ namespace Void {
     void IntegerEnsure::parse(String data, List<String> args, uint line, Executable* executable) {
         // parse the integer storage required size
         size = stringToInt(args[0]);
+        // register the instruction, so that the storage is sized before the method arguments are copied
+        executable->ensures.push_back(this);
     }
 
     /**
@@ -1228,9 +1230,9 @@ namespace Void {
         // get the value from the stack
         int value =context->stack->ints.pull(keepStack);
         // print the value and insert a new line if the flag is set
-        print(value);
+        Console::write(value);
         if (newLine)
-            println("");
+            Console::newLine();
     }
 
     /**
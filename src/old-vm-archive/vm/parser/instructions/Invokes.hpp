@@ -16,9 +16,9 @@ namespace Void {
         String className;
 
         /**
-         * The reference of the target class.
+         * The reference of the target class, that may be resolved by any of the threads.
          */
-        Class* classRef = nullptr;
+        std::atomic<Class*> classRef = nullptr;
 
         /**
          * The name of the target class.
@@ -31,9 +31,9 @@ namespace Void {
         List<String> methodParameters;
 
         /**
-         * The reference of the target method.
+         * The reference of the target method, that may be resolved by any of the threads.
          */
-        Method* methodRef = nullptr;
+        std::atomic<Method*> methodRef = nullptr;
 
     public:
         /**
@@ -68,6 +68,153 @@ namespace Void {
          * @return instruction bytecode data
          */
         String debug() override;
+
+    private:
+        /**
+         * Resolve the target class and method. The threads may resolve them at the same time,
+         * as every thread resolves the same references. The fiber of the context fails, if they are missing.
+         * @param context bytecode execution context
+         * @return resolved target method, or nullptr if the fiber has failed
+         */
+        Method* resolve(Context* context);
+    };
+#pragma endregion
+
+#pragma region INVOKE_VIRTUAL
+    /**
+     * Represents an instruction that invokes a non-static class method on the receiver instance.
+     * The call site is bound to a single method, if the loaded class hierarchy allows only one target,
+     * otherwise the method is looked up by the class of the receiver, and cached for the next call.
+     */
+    class InvokeVirtual : public Instruction {
+    private:
+        /**
+         * The name of the static receiver class.
+         */
+        String className;
+
+        /**
+         * The name of the target method.
+         */
+        String methodName;
+
+        /**
+         * The parameters of the target method.
+         */
+        List<String> methodParameters;
+
+        /**
+         * Represents the resolved references of the call site, that are bound using a version of the class hierarchy.
+         * A binding is not modified after it has been published, a new binding replaces it instead.
+         */
+        struct Binding {
+            /**
+             * The reference of the static receiver class.
+             */
+            Class* classRef;
+
+            /**
+             * The reference of the method resolved from the receiver class.
+             */
+            Method* methodRef;
+
+            /**
+             * The single target method of the call site, or nullptr if the call is dispatched by the receiver.
+             */
+            Method* target;
+
+            /**
+             * The class hierarchy version, that the call site was bound with.
+             */
+            uint version;
+        };
+
+        /**
+         * Represents a receiver class of the dispatched calls, and its method.
+         */
+        struct ReceiverCache {
+            /**
+             * The class of the receiver.
+             */
+            Class* clazz;
+
+            /**
+             * The method of the receiver class.
+             */
+            Method* method;
+        };
+
+        /**
+         * The current binding of the call site.
+         */
+        std::atomic<Binding*> binding = nullptr;
+
+        /**
+         * The receiver class of the previous dispatched call, and its method.
+         */
+        std::atomic<ReceiverCache*> cache = nullptr;
+
+        /**
+         * The published bindings and receiver caches, that are kept alive, as other threads may still read them.
+         * Their count is limited by the count of the loaded classes.
+         */
+        List<Binding*> bindings;
+        List<ReceiverCache*> caches;
+
+        /**
+         * The lock of the published bindings and receiver caches.
+         */
+        std::mutex lock;
+
+    public:
+        /**
+         * Initialize virtual method invoke instruction.
+         */
+        InvokeVirtual();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Initialize the references in the const pool after the whole program has been parsed.
+         * @param vm running virtual machine
+         * @param executable bytecode executor
+         */
+        void initialize(VirtualMachine* vm, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+
+    private:
+        /**
+         * Resolve the target method and bind the call site using the current class hierarchy.
+         * @param vm running virtual machine
+         * @return current binding
+         */
+        Binding* bind(VirtualMachine* vm);
+
+        /**
+         * Look up the method of a receiver class, and cache it for the next call.
+         * @param vm running virtual machine
+         * @param clazz receiver class
+         * @return receiver cache of the class, or nullptr if the class does not implement the method
+         */
+        ReceiverCache* lookup(VirtualMachine* vm, Class* clazz);
     };
 #pragma endregion
 }
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "../Instruction.hpp"
+#include "../../runtime/Stack.hpp"
+#include "../../runtime/Storage.hpp"
+
+#ifdef VOID_INSTRUCTION
+namespace Void {
+    /**
+     * Represents an operand of an instruction, that is retrieved from the stack, a local variable, or the bytecode.
+     */
+    template <typename T>
+    class Operand {
+    public:
+        /**
+         * The target of the operand value.
+         */
+        Target target = Target::STACK;
+
+        /**
+         * The storage index of the operand, if it is a local variable.
+         */
+        uint index = 0;
+
+        /**
+         * The value of the operand, if it is a constant.
+         */
+        T constant{};
+
+        /**
+         * Parse the operand from the flag and the value of a bytecode argument.
+         * @param flag operand target flag
+         * @param value operand storage index or constant value
+         * @param executable bytecode executor
+         */
+        void parse(String flag, String value, Executable* executable);
+
+        /**
+         * Get the value of the operand in the executable context.
+         * @param context bytecode execution context
+         * @return operand value
+         */
+        T get(Context* context);
+
+        /**
+         * Set the value of a result operand in the executable context.
+         * @param context bytecode execution context
+         * @param value result value
+         */
+        void set(Context* context, T value);
+
+        /**
+         * Get the string representation of the operand.
+         * @return operand bytecode data
+         */
+        String debug();
+    };
+
+    /**
+     * Represents the mapping of an operand type to the sub-stack and the sub-storage that hold its values
+     * in the virtual machine, and to the parser of its constants.
+     */
+    template <typename T>
+    struct OperandType;
+
+    template <>
+    struct OperandType<int> {
+        static SubStack<int>& stack(Stack* stack) { return stack->ints; }
+        static SubStorage<int>& storage(Storage* storage) { return storage->ints; }
+        static int parse(String value) { return stringToInt(value); }
+    };
+
+    template <>
+    struct OperandType<lint> {
+        static SubStack<lint>& stack(Stack* stack) { return stack->longs; }
+        static SubStorage<lint>& storage(Storage* storage) { return storage->longs; }
+        static lint parse(String value) { return stringToLong(value); }
+    };
+
+    template <>
+    struct OperandType<float> {
+        static SubStack<float>& stack(Stack* stack) { return stack->floats; }
+        static SubStorage<float>& storage(Storage* storage) { return storage->floats; }
+        static float parse(String value) { return stringToFloat(value); }
+    };
+
+    template <>
+    struct OperandType<double> {
+        static SubStack<double>& stack(Stack* stack) { return stack->doubles; }
+        static SubStorage<double>& storage(Storage* storage) { return storage->doubles; }
+        static double parse(String value) { return stringToDouble(value); }
+    };
+
+    template <>
+    struct OperandType<Array*> {
+        static SubStack<Array*>& stack(Stack* stack) { return stack->arrays; }
+        static SubStorage<Array*>& storage(Storage* storage) { return storage->arrays; }
+        static Array* parse(String value) {
+            error("InvalidBytecodeException: An array operand cannot be a constant");
+            return nullptr;
+        }
+    };
+
+    template <>
+    struct OperandType<Text*> {
+        static SubStack<Text*>& stack(Stack* stack) { return stack->texts; }
+        static SubStorage<Text*>& storage(Storage* storage) { return storage->texts; }
+        static Text* parse(String value) {
+            error("InvalidBytecodeException: A string operand cannot be a constant, load it with tconst");
+            return nullptr;
+        }
+    };
+
+    /**
+     * Parse the operands of an instruction, in the order of their appearance in the bytecode.
+     * @param args split array of the data
+     * @param executable bytecode executor
+     * @param result the operand that is set by the "-r" argument, or nullptr if the instruction has no result
+     * @param operands the operands of the instruction
+     */
+    template <typename R, typename... Ts>
+    void parseOperands(List<String>& args, Executable* executable, Operand<R>* result, Operand<Ts>&... operands) {
+        // collect the flags and the values of the operands, a stack operand has no value
+        List<Pair<String, String>> values;
+        for (uint i = 0; i < args.size(); i++) {
+            String arg = args[i];
+            if (arg == "-l" || arg == "-local")
+                values.push_back({ "-l", args[++i] });
+            else if (arg == "-c" || arg == "-const")
+                values.push_back({ "-c", args[++i] });
+            else if (arg == "-s" || arg == "-stack")
+                values.push_back({ "-s", "" });
+            else if ((arg == "-r" || arg == "-result") && result != nullptr)
+                result->parse("-l", args[++i], executable);
+        }
+        // the missing operands are retrieved from the stack
+        uint index = 0;
+        ((index < values.size() ? operands.parse(values[index].first, values[index].second, executable) : void(), index++), ...);
+    }
+
+    /**
+     * Parse the operand from the flag and the value of a bytecode argument.
+     * @param flag operand target flag
+     * @param value operand storage index or constant value
+     * @param executable bytecode executor
+     */
+    template <typename T>
+    void Operand<T>::parse(String flag, String value, Executable* executable) {
+        if (flag == "-l") {
+            target = Target::LOCAL;
+            index = executable->getLinker(value);
+        }
+        else if (flag == "-c") {
+            target = Target::CONSTANT;
+            constant = OperandType<T>::parse(value);
+        }
+        else
+            target = Target::STACK;
+    }
+
+    /**
+     * Get the value of the operand in the executable context.
+     * @param context bytecode execution context
+     * @return operand value
+     */
+    template <typename T>
+    T Operand<T>::get(Context* context) {
+        switch (target) {
+            case Target::LOCAL:
+                return OperandType<T>::storage(context->storage).get(index);
+            case Target::CONSTANT:
+                return constant;
+            default:
+                return OperandType<T>::stack(context->stack).pull();
+        }
+    }
+
+    /**
+     * Set the value of a result operand in the executable context.
+     * @param context bytecode execution context
+     * @param value result value
+     */
+    template <typename T>
+    void Operand<T>::set(Context* context, T value) {
+        if (target == Target::LOCAL)
+            OperandType<T>::storage(context->storage).set(index, value);
+        else
+            OperandType<T>::stack(context->stack).push(value);
+    }
+
+    /**
+     * Get the string representation of the operand.
+     * @return operand bytecode data
+     */
+    template <typename T>
+    String Operand<T>::debug() {
+        switch (target) {
+            case Target::LOCAL:
+                return "-l " + toString(index);
+            case Target::CONSTANT: {
+                StringStream stream;
+                stream << "-c " << constant;
+                return stream.str();
+            }
+            default:
+                return "-s";
+        }
+    }
+
+    /**
+     * Get the string representation of a result operand.
+     * @param result instruction result
+     * @return result bytecode data
+     */
+    template <typename T>
+    String debugResult(Operand<T>& result) {
+        return result.target == Target::LOCAL ? " -r " + toString(result.index) : "";
+    }
+}
+#endif
@@ -1,5 +1,7 @@
 #include "Sections.hpp"
 
+#include <algorithm>
+
 namespace Void {
 #pragma region SECTION
     /**
@@ -67,6 +69,197 @@ namespace Void {
     }
 #pragma endregion
 
+#pragma region TABLE_SWITCH
+    /**
+     * Initialize the table switch instruction.
+     */
+    TableSwitch::TableSwitch()
+        : Instruction(Instructions::TABLE_SWITCH)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TableSwitch::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tableswitch -l key -low 1 -default end -jump case1 case2 end case4
+        for (uint i = 0; i < args.size(); i++) {
+            // get the current argument
+            String arg = args[i];
+            // handle value from local variable
+            if (arg == "-l" || arg == "-local") {
+                target = Target::LOCAL;
+                value = executable->getLinker(args[++i]);
+            }
+            // handle value from the stack
+            else if (arg == "-s" || arg == "-stack")
+                target = Target::STACK;
+            // handle const value
+            else if (arg == "-c" || arg == "-const") {
+                target = Target::CONSTANT;
+                value = stringToInt(args[++i]);
+            }
+            // handle the key of the first table entry
+            else if (arg == "-low")
+                low = stringToInt(args[++i]);
+            // handle the section of the keys outside the table
+            else if (arg == "-default")
+                fallback = executable->getSection(args[++i]);
+            // handle the sections of the table, that take the rest of the arguments
+            else if (arg == "-j" || arg == "-jump") {
+                while (i + 1 < args.size())
+                    indices.push_back(executable->getSection(args[++i]));
+            }
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TableSwitch::execute(Context* context) {
+        // get the switched value
+        int key = value;
+        switch (target) {
+            case Target::STACK:
+                key = context->stack->ints.pull();
+                break;
+            case Target::LOCAL:
+                key = context->storage->ints.get(value);
+                break;
+        }
+        // the keys below the table wrap around to a large unsigned offset,
+        // therefore a single comparison checks both the bounds of the table
+        uint offset = (uint) key - (uint) low;
+        context->cursor = offset < indices.size() ? indices[offset] : fallback;
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TableSwitch::debug() {
+        String result = "tableswitch";
+        switch (target) {
+            case Target::STACK:
+                result += " -stack";
+                break;
+            case Target::LOCAL:
+                result += " -local " + toString(value);
+                break;
+            case Target::CONSTANT:
+                result += " -const " + toString(value);
+                break;
+        }
+        result += " -low " + toString(low) + " -default " + toString(fallback) + " -jump";
+        for (uint index : indices)
+            result += " " + toString(index);
+        return result;
+    }
+#pragma endregion
+
+#pragma region LOOKUP_SWITCH
+    /**
+     * Initialize the lookup switch instruction.
+     */
+    LookupSwitch::LookupSwitch()
+        : Instruction(Instructions::LOOKUP_SWITCH)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void LookupSwitch::parse(String data, List<String> args, uint line, Executable* executable) {
+        // lookupswitch -l key -default end -case 200 ok -case 404 missing
+        List<Pair<int, uint>> cases;
+        for (uint i = 0; i < args.size(); i++) {
+            // get the current argument
+            String arg = args[i];
+            // handle value from local variable
+            if (arg == "-l" || arg == "-local") {
+                target = Target::LOCAL;
+                value = executable->getLinker(args[++i]);
+            }
+            // handle value from the stack
+            else if (arg == "-s" || arg == "-stack")
+                target = Target::STACK;
+            // handle const value
+            else if (arg == "-c" || arg == "-const") {
+                target = Target::CONSTANT;
+                value = stringToInt(args[++i]);
+            }
+            // handle the section of the unmatched keys
+            else if (arg == "-default")
+                fallback = executable->getSection(args[++i]);
+            // handle a case key and its section
+            else if (arg == "-case") {
+                int key = stringToInt(args[++i]);
+                cases.push_back({ key, executable->getSection(args[++i]) });
+            }
+        }
+
+        // the keys are sorted for the binary search
+        std::sort(cases.begin(), cases.end());
+        for (auto& [key, index] : cases) {
+            keys.push_back(key);
+            indices.push_back(index);
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void LookupSwitch::execute(Context* context) {
+        // get the switched value
+        int key = value;
+        switch (target) {
+            case Target::STACK:
+                key = context->stack->ints.pull();
+                break;
+            case Target::LOCAL:
+                key = context->storage->ints.get(value);
+                break;
+        }
+        // find the case of the key using a binary search
+        auto found = std::lower_bound(keys.begin(), keys.end(), key);
+        if (found != keys.end() && *found == key)
+            context->cursor = indices[found - keys.begin()];
+        else
+            context->cursor = fallback;
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String LookupSwitch::debug() {
+        String result = "lookupswitch";
+        switch (target) {
+            case Target::STACK:
+                result += " -stack";
+                break;
+            case Target::LOCAL:
+                result += " -local " + toString(value);
+                break;
+            case Target::CONSTANT:
+                result += " -const " + toString(value);
+                break;
+        }
+        result += " -default " + toString(fallback);
+        for (uint i = 0; i < keys.size(); i++)
+            result += " -case " + toString(keys[i]) + " " + toString(indices[i]);
+        return result;
+    }
+#pragma endregion
+
 #pragma region RETURN
     /**
      * Initialize the return instruction.
@@ -78,6 +78,129 @@ namespace Void {
     };
 #pragma endregion
 
+#pragma region TABLE_SWITCH
+    /**
+     * Represents an instruction that jumps to the section of an integer key using a jump table.
+     * The table covers every key from the lowest case key to the highest one, the keys without a case
+     * jump to the default section.
+     */
+    class TableSwitch : public Instruction {
+    private:
+        /**
+         * The target of the switched number.
+         */
+        Target target = Target::STACK;
+
+        /**
+         * The storage index or the value of the switched number.
+         */
+        int value = 0;
+
+        /**
+         * The key of the first entry of the table.
+         */
+        int low = 0;
+
+        /**
+         * The bytecode instruction index to jump to, if the key is outside the table.
+         */
+        uint fallback = 0;
+
+        /**
+         * The bytecode instruction indices to jump to, for each key from the lowest key.
+         */
+        List<uint> indices;
+
+    public:
+        /**
+         * Initialize the table switch instruction.
+         */
+        TableSwitch();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region LOOKUP_SWITCH
+    /**
+     * Represents an instruction that jumps to the section of an integer key using a binary search
+     * of the sorted case keys. Used for the sparse keys, that would not fit in a jump table.
+     */
+    class LookupSwitch : public Instruction {
+    private:
+        /**
+         * The target of the switched number.
+         */
+        Target target = Target::STACK;
+
+        /**
+         * The storage index or the value of the switched number.
+         */
+        int value = 0;
+
+        /**
+         * The bytecode instruction index to jump to, if no case key matches.
+         */
+        uint fallback = 0;
+
+        /**
+         * The sorted case keys.
+         */
+        List<int> keys;
+
+        /**
+         * The bytecode instruction indices to jump to, in the order of the case keys.
+         */
+        List<uint> indices;
+
+    public:
+        /**
+         * Initialize the lookup switch instruction.
+         */
+        LookupSwitch();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
 #pragma region RETURN
     /**
      * Represents an instruction that terminates the method execution context.
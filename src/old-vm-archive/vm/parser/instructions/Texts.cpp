@@ -0,0 +1,721 @@
+#include "Texts.hpp"
+
+namespace Void {
+    /**
+     * Split the arguments of a string instruction. A quoted literal is a single argument, even if it contains spaces,
+     * and it is returned with a leading quote, so that it can be told apart from the flags.
+     * @param data raw bytecode data
+     * @return instruction arguments
+     */
+    static List<String> splitArguments(String data) {
+        List<String> args;
+        // skip the name of the instruction
+        size_t i = data.find(' ');
+        while (i < data.length()) {
+            if (data[i] == ' ') {
+                i++;
+                continue;
+            }
+            // read a literal until the closing quote, resolving the escaped characters
+            if (data[i] == '"') {
+                String literal = "\"";
+                for (i++; i < data.length() && data[i] != '"'; i++) {
+                    if (data[i] == '\\' && i + 1 < data.length()) {
+                        char c = data[++i];
+                        literal += c == 'n' ? '\n' : c == 'r' ? '\r' : c == 't' ? '\t' : c;
+                    }
+                    else
+                        literal += data[i];
+                }
+                if (i >= data.length())
+                    error("InvalidBytecodeException: Unterminated string literal: " << data);
+                args.push_back(literal);
+                i++;
+                continue;
+            }
+            size_t end = data.find(' ', i);
+            if (end == String::npos)
+                end = data.length();
+            args.push_back(data.substr(i, end - i));
+            i = end;
+        }
+        return args;
+    }
+
+    /**
+     * Get the bytecode literal of a string, escaping the characters that the parser resolves.
+     * @param text literal string
+     * @return quoted string
+     */
+    static String quote(Text* text) {
+        String result = "\"";
+        for (char c : text->view()) {
+            if (c == '\n')
+                result += "\\n";
+            else if (c == '\r')
+                result += "\\r";
+            else if (c == '\t')
+                result += "\\t";
+            else if (c == '"' || c == '\\')
+                result += String("\\") + c;
+            else
+                result += c;
+        }
+        return result + "\"";
+    }
+
+    /**
+     * Get a string operand, that must not be deleted.
+     * @param context bytecode execution context
+     * @param operand string operand
+     * @param operation the action that is performed on the string
+     * @return string value
+     */
+    static Text* getText(Context* context, Operand<Text*>& operand, const char* operation) {
+        Text* text = operand.get(context);
+        if (text == nullptr)
+            error("NullPointerException: Trying to " << operation << " a deleted string");
+        return text;
+    }
+
+#pragma region TEXT_CONSTANT
+    /**
+     * Initialize the string constant instruction.
+     */
+    TextConstant::TextConstant()
+        : Instruction(Instructions::TEXT_CONSTANT)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextConstant::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tconst "Hello, World!" -r greeting
+        args = splitArguments(data);
+        for (String arg : args) {
+            if (arg[0] == '"')
+                text = Text::intern(arg.substr(1));
+        }
+        if (text == nullptr)
+            error("InvalidBytecodeException: Missing string literal: " << data);
+        parseOperands(args, executable, &result);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextConstant::execute(Context* context) {
+        result.set(context, text);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextConstant::debug() {
+        return "tconst " + quote(text) + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region TEXT_LOAD
+    /**
+     * Initialize the string load instruction.
+     */
+    TextLoad::TextLoad()
+        : Instruction(Instructions::TEXT_LOAD)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextLoad::parse(String data, List<String> args, uint line, Executable* executable) {
+        // try to parse the storage index from string
+        index = executable->getLinker(args[0]);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextLoad::execute(Context* context) {
+        context->stack->texts.push(context->storage->texts.get(index));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextLoad::debug() {
+        return "tload " + toString(index);
+    }
+#pragma endregion
+
+#pragma region TEXT_STORE
+    /**
+     * Initialize the string store instruction.
+     */
+    TextStore::TextStore()
+        : Instruction(Instructions::TEXT_STORE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextStore::parse(String data, List<String> args, uint line, Executable* executable) {
+        // try to parse the storage index from string
+        index = executable->getLinker(args[0]);
+        // check if the instruction should keep the string on the stack
+        for (uint i = 1; i < args.size(); i++) {
+            if (args[i] == "-k")
+                keepStack = true;
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextStore::execute(Context* context) {
+        context->storage->texts.set(index, context->stack->texts.pull(keepStack));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextStore::debug() {
+        String result = "tstore " + toString(index);
+        if (keepStack)
+            result += " -k";
+        return result;
+    }
+#pragma endregion
+
+#pragma region TEXT_CONCAT
+    /**
+     * Initialize the string concatenation instruction.
+     */
+    TextConcat::TextConcat()
+        : Instruction(Instructions::TEXT_CONCAT)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextConcat::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tconcat -l first -l second -r result
+        parseOperands(args, executable, &result, first, second);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextConcat::execute(Context* context) {
+        Text* first = getText(context, this->first, "concatenate");
+        Text* second = getText(context, this->second, "concatenate");
+        result.set(context, Text::concat(first, second));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextConcat::debug() {
+        return "tconcat " + first.debug() + " " + second.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region TEXT_TEMPLATE
+    /**
+     * Initialize the string template instruction.
+     */
+    TextTemplate::TextTemplate()
+        : Instruction(Instructions::TEXT_TEMPLATE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextTemplate::parse(String data, List<String> args, uint line, Executable* executable) {
+        // ttemplate "x = {}, name = {}" I -l x T -l name -r result
+        args = splitArguments(data);
+        String pattern;
+        bool found = false;
+        for (uint i = 0; i < args.size(); i++) {
+            String arg = args[i];
+            // handle the template literal
+            if (arg[0] == '"') {
+                pattern = arg.substr(1);
+                found = true;
+            }
+            // handle the target of the built string
+            else if (arg == "-r" || arg == "-result")
+                result.parse("-l", args[++i], executable);
+            // handle an argument, that is prefixed by its type descriptor
+            else if (arg.length() == 1 && i + 1 < args.size()) {
+                String flag = args[++i];
+                String value;
+                if (flag == "-l" || flag == "-local")
+                    flag = "-l";
+                else if (flag == "-c" || flag == "-const")
+                    flag = "-c";
+                else
+                    flag = "-s";
+                if (flag != "-s")
+                    value = args[++i];
+                switch (arg[0]) {
+                    case 'I':
+                        ints.emplace_back().parse(flag, value, executable);
+                        break;
+                    case 'J':
+                        longs.emplace_back().parse(flag, value, executable);
+                        break;
+                    case 'F':
+                        floats.emplace_back().parse(flag, value, executable);
+                        break;
+                    case 'D':
+                        doubles.emplace_back().parse(flag, value, executable);
+                        break;
+                    case 'T':
+                        texts.emplace_back().parse(flag, value, executable);
+                        break;
+                    default:
+                        error("InvalidBytecodeException: Invalid template argument type '" << arg << "': " << data);
+                }
+                types.push_back(arg[0]);
+            }
+        }
+        if (!found)
+            error("InvalidBytecodeException: Missing template literal: " << data);
+
+        // split the template around the placeholders, the literal parts are interned only once
+        // the "{{" and "}}" sequences are the escaped forms of the literal braces
+        String piece;
+        for (uint i = 0; i < pattern.length(); i++) {
+            if (pattern.compare(i, 2, "{}") == 0) {
+                pieces.push_back(Text::intern(piece));
+                piece.clear();
+                i++;
+                continue;
+            }
+            if (pattern.compare(i, 2, "{{") == 0 || pattern.compare(i, 2, "}}") == 0)
+                i++;
+            piece += pattern[i];
+        }
+        pieces.push_back(Text::intern(piece));
+        if (pieces.size() != types.size() + 1)
+            error("InvalidBytecodeException: Template has " << (pieces.size() - 1) << " placeholders, but "
+                << types.size() << " arguments: " << data);
+
+        // expect a few digits of every argument, so that the buffer is rarely grown
+        for (Text* piece : pieces)
+            capacity += piece->length;
+        capacity += (uint) types.size() * 16;
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextTemplate::execute(Context* context) {
+        TextBuilder builder(capacity);
+        builder.append(pieces[0]);
+        // the arguments of each type are retrieved in the order of the bytecode
+        uint nextInt = 0, nextLong = 0, nextFloat = 0, nextDouble = 0, nextText = 0;
+        for (uint i = 0; i < types.size(); i++) {
+            switch (types[i]) {
+                case 'I':
+                    builder.append(ints[nextInt++].get(context));
+                    break;
+                case 'J':
+                    builder.append(longs[nextLong++].get(context));
+                    break;
+                case 'F':
+                    builder.append(floats[nextFloat++].get(context));
+                    break;
+                case 'D':
+                    builder.append(doubles[nextDouble++].get(context));
+                    break;
+                case 'T':
+                    builder.append(getText(context, texts[nextText++], "format"));
+                    break;
+            }
+            builder.append(pieces[i + 1]);
+        }
+        result.set(context, builder.build());
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextTemplate::debug() {
+        String pattern;
+        for (uint i = 0; i < pieces.size(); i++) {
+            if (i > 0)
+                pattern += "{}";
+            for (char c : pieces[i]->view())
+                pattern += c == '{' || c == '}' ? String(2, c) : String(1, c);
+        }
+        Text* literal = Text::of(pattern);
+        String result = "ttemplate " + quote(literal);
+        Text::release(literal);
+
+        uint nextInt = 0, nextLong = 0, nextFloat = 0, nextDouble = 0, nextText = 0;
+        for (char type : types) {
+            result += String(" ") + type + " ";
+            switch (type) {
+                case 'I':
+                    result += ints[nextInt++].debug();
+                    break;
+                case 'J':
+                    result += longs[nextLong++].debug();
+                    break;
+                case 'F':
+                    result += floats[nextFloat++].debug();
+                    break;
+                case 'D':
+                    result += doubles[nextDouble++].debug();
+                    break;
+                case 'T':
+                    result += texts[nextText++].debug();
+                    break;
+            }
+        }
+        return result + debugResult(this->result);
+    }
+#pragma endregion
+
+#pragma region TEXT_LENGTH
+    /**
+     * Initialize the string length instruction.
+     */
+    TextLength::TextLength()
+        : Instruction(Instructions::TEXT_LENGTH)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextLength::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tlength -l name -r length
+        parseOperands(args, executable, &result, text);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextLength::execute(Context* context) {
+        result.set(context, (int) getText(context, text, "get the length of")->countCodePoints());
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextLength::debug() {
+        return "tlength " + text.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region TEXT_HASH
+    /**
+     * Initialize the string hash instruction.
+     */
+    TextHashCode::TextHashCode()
+        : Instruction(Instructions::TEXT_HASH)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextHashCode::parse(String data, List<String> args, uint line, Executable* executable) {
+        // thash -l name -r hash
+        parseOperands(args, executable, &result, text);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextHashCode::execute(Context* context) {
+        result.set(context, (int) getText(context, text, "hash")->hashCode());
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextHashCode::debug() {
+        return "thash " + text.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region TEXT_EQUALS
+    /**
+     * Initialize the string equality instruction.
+     */
+    TextEquality::TextEquality()
+        : Instruction(Instructions::TEXT_EQUALS)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextEquality::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tequals -l first -l second -r equal
+        parseOperands(args, executable, &result, first, second);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextEquality::execute(Context* context) {
+        Text* first = getText(context, this->first, "compare");
+        Text* second = getText(context, this->second, "compare");
+        result.set(context, first->equals(second) ? 1 : 0);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextEquality::debug() {
+        return "tequals " + first.debug() + " " + second.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region TEXT_SWITCH
+    /**
+     * Initialize the string switch instruction.
+     */
+    TextSwitch::TextSwitch()
+        : Instruction(Instructions::TEXT_SWITCH)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextSwitch::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tswitch -l method -default end -case "GET" get -case "POST" post
+        args = splitArguments(data);
+        for (uint i = 0; i < args.size(); i++) {
+            String arg = args[i];
+            // handle the switched string
+            if (arg == "-l" || arg == "-local")
+                text.parse("-l", args[++i], executable);
+            else if (arg == "-s" || arg == "-stack")
+                text.parse("-s", "", executable);
+            // handle the section of the unmatched keys
+            else if (arg == "-default")
+                fallback = executable->getSection(args[++i]);
+            // handle a case key and its section
+            else if (arg == "-case") {
+                String key = args[++i];
+                if (key[0] != '"')
+                    error("InvalidBytecodeException: The case key must be a string literal: " << data);
+                Text* literal = Text::intern(key.substr(1));
+                if (cases.find(literal) != cases.end())
+                    error("InvalidBytecodeException: Duplicate case key " << quote(literal) << ": " << data);
+                cases[literal] = executable->getSection(args[++i]);
+                keys.push_back(literal);
+            }
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextSwitch::execute(Context* context) {
+        // the cached hash code of the key is used to find the case
+        auto found = cases.find(getText(context, text, "switch on"));
+        context->cursor = found != cases.end() ? found->second : fallback;
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextSwitch::debug() {
+        String result = "tswitch " + text.debug() + " -default " + toString(fallback);
+        for (Text* key : keys)
+            result += " -case " + quote(key) + " " + toString(cases[key]);
+        return result;
+    }
+#pragma endregion
+
+#pragma region TEXT_DELETE
+    /**
+     * Initialize the string deletion instruction.
+     */
+    TextDelete::TextDelete()
+        : Instruction(Instructions::TEXT_DELETE)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextDelete::parse(String data, List<String> args, uint line, Executable* executable) {
+        // tdelete -l name
+        parseOperands<int>(args, executable, nullptr, text);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextDelete::execute(Context* context) {
+        Text::release(text.get(context));
+        // clear the variable, so that a later access fails instead of reading the freed memory
+        if (text.target == Target::LOCAL)
+            context->storage->texts.set(text.index, nullptr);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextDelete::debug() {
+        return "tdelete " + text.debug();
+    }
+#pragma endregion
+
+#pragma region TEXT_RETURN
+    /**
+     * Initialize the string return instruction.
+     */
+    TextReturn::TextReturn()
+        : Instruction(Instructions::TEXT_RETURN)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextReturn::parse(String data, List<String> args, uint line, Executable* executable) {
+        // treturn -l name
+        parseOperands<int>(args, executable, nullptr, text);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextReturn::execute(Context* context) {
+        // terminate the execution and set the return value
+        context->terminate(text.get(context));
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextReturn::debug() {
+        return "treturn " + text.debug();
+    }
+#pragma endregion
+
+#pragma region TEXT_DEBUG
+    /**
+     * Initialize the string debug instruction.
+     */
+    TextDebug::TextDebug()
+        : Instruction(Instructions::TEXT_DEBUG)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void TextDebug::parse(String data, List<String> args, uint line, Executable* executable) {
+        // loop through the debug flags
+        for (uint i = 0; i < args.size(); i++) {
+            String flag = args[i];
+            // check if the debug should insert a new line afterwards
+            if (flag == "-n" || flag == "-new" || flag == "-newline" || flag == "-nl")
+                newLine = true;
+            // check if the string should be kept on the stack
+            else if (flag == "-k" || flag == "-keep" || flag == "-keepstack")
+                keepStack = true;
+        }
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void TextDebug::execute(Context* context) {
+        Text* text = context->stack->texts.pull(keepStack);
+        if (text != nullptr)
+            Console::write(text->data(), text->length);
+        else
+            Console::write("null");
+        if (newLine)
+            Console::newLine();
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String TextDebug::debug() {
+        String result = "tdebug";
+        if (newLine)
+            result += " -newline";
+        if (keepStack)
+            result += " -keepstack";
+        return result;
+    }
+#pragma endregion
+}
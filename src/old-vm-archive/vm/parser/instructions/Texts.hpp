@@ -0,0 +1,590 @@
+#pragma once
+
+#include "Operands.hpp"
+
+#ifdef VOID_INSTRUCTION
+namespace Void {
+#pragma region TEXT_CONSTANT
+    /**
+     * Represents an instruction that loads an interned string literal of the bytecode.
+     */
+    class TextConstant : public Instruction {
+    private:
+        /**
+         * The interned string literal, that is resolved when the instruction is parsed.
+         */
+        Text* text = nullptr;
+
+        /**
+         * The target of the string.
+         */
+        Operand<Text*> result;
+
+    public:
+        /**
+         * Initialize the string constant instruction.
+         */
+        TextConstant();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_LOAD
+    /**
+     * Represents an instruction that loads a string from the storage to the stack.
+     */
+    class TextLoad : public Instruction {
+    private:
+        /**
+         * The storage index of the loaded string.
+         */
+        uint index = 0;
+
+    public:
+        /**
+         * Initialize the string load instruction.
+         */
+        TextLoad();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_STORE
+    /**
+     * Represents an instruction that stores a string from the stack to the storage.
+     */
+    class TextStore : public Instruction {
+    private:
+        /**
+         * The storage index of the stored string.
+         */
+        uint index = 0;
+
+        /**
+         * Determine if the string should be kept on the stack.
+         */
+        bool keepStack = false;
+
+    public:
+        /**
+         * Initialize the string store instruction.
+         */
+        TextStore();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_CONCAT
+    /**
+     * Represents an instruction that concatenates two strings. Long strings are joined by a rope, instead of copying them.
+     */
+    class TextConcat : public Instruction {
+    private:
+        /**
+         * The first part of the string.
+         */
+        Operand<Text*> first;
+
+        /**
+         * The second part of the string.
+         */
+        Operand<Text*> second;
+
+        /**
+         * The target of the new string.
+         */
+        Operand<Text*> result;
+
+    public:
+        /**
+         * Initialize the string concatenation instruction.
+         */
+        TextConcat();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_TEMPLATE
+    /**
+     * Represents an instruction that builds a string of a template, whose "{}" placeholders are replaced by
+     * the arguments. The literal braces are escaped as "{{" and "}}". The string is built in a single buffer,
+     * regardless of the count of the arguments.
+     */
+    class TextTemplate : public Instruction {
+    private:
+        /**
+         * The literal parts of the template, around the placeholders.
+         */
+        List<Text*> pieces;
+
+        /**
+         * The type descriptors of the arguments, in the order of the placeholders.
+         */
+        List<char> types;
+
+        /**
+         * The integer arguments.
+         */
+        List<Operand<int>> ints;
+
+        /**
+         * The long arguments.
+         */
+        List<Operand<lint>> longs;
+
+        /**
+         * The float arguments.
+         */
+        List<Operand<float>> floats;
+
+        /**
+         * The double arguments.
+         */
+        List<Operand<double>> doubles;
+
+        /**
+         * The string arguments.
+         */
+        List<Operand<Text*>> texts;
+
+        /**
+         * The expected length of the built string.
+         */
+        uint capacity = 0;
+
+        /**
+         * The target of the new string.
+         */
+        Operand<Text*> result;
+
+    public:
+        /**
+         * Initialize the string template instruction.
+         */
+        TextTemplate();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_LENGTH
+    /**
+     * Represents an instruction that counts the unicode code points of a string.
+     */
+    class TextLength : public Instruction {
+    private:
+        /**
+         * The measured string.
+         */
+        Operand<Text*> text;
+
+        /**
+         * The target of the code point count.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the string length instruction.
+         */
+        TextLength();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_HASH
+    /**
+     * Represents an instruction that gets the cached hash code of a string.
+     */
+    class TextHashCode : public Instruction {
+    private:
+        /**
+         * The hashed string.
+         */
+        Operand<Text*> text;
+
+        /**
+         * The target of the hash code.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the string hash instruction.
+         */
+        TextHashCode();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_EQUALS
+    /**
+     * Represents an instruction that determines if two strings are equal.
+     */
+    class TextEquality : public Instruction {
+    private:
+        /**
+         * The first compared string.
+         */
+        Operand<Text*> first;
+
+        /**
+         * The second compared string.
+         */
+        Operand<Text*> second;
+
+        /**
+         * The target of the result, 1 if the strings are equal, 0 otherwise.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the string equality instruction.
+         */
+        TextEquality();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_SWITCH
+    /**
+     * Represents an instruction that jumps to the section of a string key. The keys are found by their
+     * cached hash code, and the interned literals are compared by their address.
+     */
+    class TextSwitch : public Instruction {
+    private:
+        /**
+         * The switched string.
+         */
+        Operand<Text*> text;
+
+        /**
+         * The bytecode instruction index to jump to, if no case key matches.
+         */
+        uint fallback = 0;
+
+        /**
+         * The bytecode instruction indices to jump to, mapped by the case keys.
+         */
+        TextMap<uint> cases;
+
+        /**
+         * The case keys in the order of the bytecode.
+         */
+        List<Text*> keys;
+
+    public:
+        /**
+         * Initialize the string switch instruction.
+         */
+        TextSwitch();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_DELETE
+    /**
+     * Represents an instruction that releases a reference to a string.
+     */
+    class TextDelete : public Instruction {
+    private:
+        /**
+         * The released string.
+         */
+        Operand<Text*> text;
+
+    public:
+        /**
+         * Initialize the string deletion instruction.
+         */
+        TextDelete();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_RETURN
+    /**
+     * Represents an instruction that returns a string from the method.
+     */
+    class TextReturn : public Instruction {
+    private:
+        /**
+         * The returned string.
+         */
+        Operand<Text*> text;
+
+    public:
+        /**
+         * Initialize the string return instruction.
+         */
+        TextReturn();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region TEXT_DEBUG
+    /**
+     * Represents an instruction that prints the string on the stack.
+     */
+    class TextDebug : public Instruction {
+    private:
+        /**
+         * Determine if a new line should be inserted after the string.
+         */
+        bool newLine = false;
+
+        /**
+         * Determine if the string should be kept on the stack.
+         */
+        bool keepStack = false;
+
+    public:
+        /**
+         * Initialize the string debug instruction.
+         */
+        TextDebug();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+}
+#endif
@@ -0,0 +1,170 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../../element/Method.hpp"
+#include "Threads.hpp"
+#include "../../VirtualMachine.hpp"
+#include "../../runtime/Thread.hpp"
+#include "../../runtime/Fiber.hpp"
+#include "../../../util/Strings.hpp"
+#include "../../../util/Lists.hpp"
+
+namespace Void {
+#pragma region STATIC_TARGET
+    /**
+     * Parse the class name, the method name and the parameters of the method, that are followed by the flags.
+     * @param args split array of the data
+     * @return the flags after the parameters
+     */
+    List<String> StaticTarget::parse(List<String>& args) {
+        className = args[0];
+        methodName = args[1];
+        // the type descriptors of the parameters never begin with a dash
+        uint end = 2;
+        while (end < args.size() && !args[end].starts_with("-"))
+            end++;
+        methodParameters = List<String>(args.begin() + 2, args.begin() + end);
+        return Lists::subList(args, end);
+    }
+
+    /**
+     * Resolve the method if its class has already been loaded.
+     * @param vm running virtual machine
+     */
+    void StaticTarget::initialize(VirtualMachine* vm) {
+        // the class might be loaded afterwards, it is resolved again when the instruction is executed
+        Class* clazz = vm->getClass(className);
+        if (clazz != nullptr)
+            methodRef.store(clazz->getMethod(methodName, methodParameters), std::memory_order_release);
+    }
+
+    /**
+     * Get the resolved method, and resolve it if it is missing. The fiber of the context fails, if the method
+     * cannot be resolved.
+     * @param context bytecode execution context
+     * @param action the name of the operation, that is reported if the method is missing
+     * @return resolved method, or nullptr if the fiber has failed
+     */
+    Method* StaticTarget::resolve(Context* context, String action) {
+        // every thread resolves the same method, so it may be published by any of them
+        Method* method = methodRef.load(std::memory_order_acquire);
+        if (method != nullptr)
+            return method;
+        Class* clazz = context->executable->vm->getClass(className);
+        if (clazz == nullptr) {
+            context->fiber->fail("NoSuchClassException: Trying to " + action + " static method of undefined class " + className);
+            return nullptr;
+        }
+        method = clazz->getMethod(methodName, methodParameters);
+        if (method == nullptr) {
+            context->fiber->fail("NoSuchMethodException: Trying to " + action + " undefined static method " + methodName
+                + "(" + Strings::join(methodParameters, " ") + ") of class " + className);
+            return nullptr;
+        }
+        methodRef.store(method, std::memory_order_release);
+        return method;
+    }
+
+    /**
+     * Get the string representation of the method.
+     * @return method bytecode data
+     */
+    String StaticTarget::debug() {
+        String parameters = methodParameters.empty() ? "" : " " + Strings::join(methodParameters, " ");
+        return className + " " + methodName + parameters;
+    }
+#pragma endregion
+
+#pragma region SPAWN
+    /**
+     * Initialize the thread start instruction.
+     */
+    Spawn::Spawn()
+        : Instruction(Instructions::SPAWN)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void Spawn::parse(String data, List<String> args, uint line, Executable* executable) {
+        // spawn <class> <method> <parameters...> -r id
+        List<String> flags = target.parse(args);
+        parseOperands<int>(flags, executable, &result);
+    }
+
+    /**
+     * Initialize the references in the const pool after the whole program has been parsed.
+     * @param vm running virtual machine
+     * @param executable bytecode executor
+     */
+    void Spawn::initialize(VirtualMachine* vm, Executable* executable) {
+        target.initialize(vm);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void Spawn::execute(Context* context) {
+        VirtualMachine* vm = context->executable->vm;
+        Method* method = target.resolve(context, "spawn");
+        if (method == nullptr)
+            return;
+        result.set(context, (int) vm->startThread(method, context->stack)->id);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String Spawn::debug() {
+        return "spawn " + target.debug() + debugResult(result);
+    }
+#pragma endregion
+
+#pragma region JOIN
+    /**
+     * Initialize the thread join instruction.
+     */
+    Join::Join()
+        : Instruction(Instructions::JOIN)
+    { }
+
+    /**
+     * Parse raw bytecode instruction.
+     * @param raw bytecode data
+     * @parma args split array of the data
+     * @param line bytecode line index
+     * @param executable bytecode executor
+     */
+    void Join::parse(String data, List<String> args, uint line, Executable* executable) {
+        // join -l id
+        parseOperands<int>(args, executable, nullptr, thread);
+    }
+
+    /**
+     * Execute the instruction in the executable context.
+     * @param context bytecode execution context
+     */
+    void Join::execute(Context* context) {
+        int id = this->thread.get(context);
+        Thread* thread = id < 0 ? nullptr : context->executable->vm->getThread((uint) id);
+        if (thread == nullptr) {
+            context->fiber->fail("IllegalThreadStateException: Trying to join undefined thread " + toString(id));
+            return;
+        }
+        thread->join();
+        thread->collect(context->fiber, context->stack);
+    }
+
+    /**
+     * Get the string representation of the instruction.
+     * @return instruction bytecode data
+     */
+    String Join::debug() {
+        return "join " + thread.debug();
+    }
+#pragma endregion
+}
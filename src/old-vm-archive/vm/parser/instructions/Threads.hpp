@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Operands.hpp"
+
+#ifdef VOID_INSTRUCTION
+namespace Void {
+#pragma region STATIC_TARGET
+    /**
+     * Represents a static method, that an instruction runs on an other thread. The method is resolved when the
+     * instruction is initialized, or by its first execution, that may be done by any of the threads.
+     */
+    class StaticTarget {
+    public:
+        /**
+         * The name of the target class.
+         */
+        String className;
+
+        /**
+         * The name of the target method.
+         */
+        String methodName;
+
+        /**
+         * The parameters of the target method.
+         */
+        List<String> methodParameters;
+
+        /**
+         * The reference of the target method.
+         */
+        std::atomic<Method*> methodRef = nullptr;
+
+        /**
+         * Parse the class name, the method name and the parameters of the method, that are followed by the flags.
+         * @param args split array of the data
+         * @return the flags after the parameters
+         */
+        List<String> parse(List<String>& args);
+
+        /**
+         * Resolve the method if its class has already been loaded.
+         * @param vm running virtual machine
+         */
+        void initialize(VirtualMachine* vm);
+
+        /**
+         * Get the resolved method, and resolve it if it is missing. The fiber of the context fails, if the method
+         * cannot be resolved.
+         * @param context bytecode execution context
+         * @param action the name of the operation, that is reported if the method is missing
+         * @return resolved method, or nullptr if the fiber has failed
+         */
+        Method* resolve(Context* context, String action);
+
+        /**
+         * Get the string representation of the method.
+         * @return method bytecode data
+         */
+        String debug();
+    };
+#pragma endregion
+
+#pragma region SPAWN
+    /**
+     * Represents an instruction that starts executing a static class method on a new thread.
+     * The arguments of the method are moved from the stack to the new thread.
+     */
+    class Spawn : public Instruction {
+    private:
+        /**
+         * The method executed by the thread.
+         */
+        StaticTarget target;
+
+        /**
+         * The target of the thread identifier.
+         */
+        Operand<int> result;
+
+    public:
+        /**
+         * Initialize the thread start instruction.
+         */
+        Spawn();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Initialize the references in the const pool after the whole program has been parsed.
+         * @param vm running virtual machine
+         * @param executable bytecode executor
+         */
+        void initialize(VirtualMachine* vm, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+
+#pragma region JOIN
+    /**
+     * Represents an instruction that waits until a thread returns, and pushes the result of its method to the stack.
+     */
+    class Join : public Instruction {
+    private:
+        /**
+         * The identifier of the joined thread.
+         */
+        Operand<int> thread;
+
+    public:
+        /**
+         * Initialize the thread join instruction.
+         */
+        Join();
+
+        /**
+         * Parse raw bytecode instruction.
+         * @param raw bytecode data
+         * @parma args split array of the data
+         * @param line bytecode line index
+         * @param executable bytecode executor
+         */
+        void parse(String data, List<String> args, uint line, Executable* executable) override;
+
+        /**
+         * Execute the instruction in the executable context.
+         * @param context bytecode execution context
+         */
+        void execute(Context* context) override;
+
+        /**
+         * Get the string representation of the instruction.
+         * @return instruction bytecode data
+         */
+        String debug() override;
+    };
+#pragma endregion
+}
+#endif
@@ -0,0 +1,219 @@
+#include "Array.hpp"
+
+#include <new>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VOID_VECTOR_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VOID_VECTOR_WIDTH 16
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Void {
+#ifdef VOID_VECTOR_WIDTH
+#if VOID_VECTOR_WIDTH == 32
+    /**
+     * Represents a vector register, that holds the processed elements of an array.
+     */
+    typedef __m256i Vector;
+
+    /**
+     * The comparison mask of two vectors, whose every byte is equal.
+     */
+    static const uint EQUAL_MASK = 0xFFFFFFFF;
+
+    static inline Vector broadcast(uint32_t bits) { return _mm256_set1_epi32((int) bits); }
+    static inline Vector broadcast(uint64_t bits) { return _mm256_set1_epi64x((lint) bits); }
+    static inline Vector loadVector(const byte* data) { return _mm256_loadu_si256(reinterpret_cast<const Vector*>(data)); }
+    static inline void storeAligned(byte* data, Vector vector) { _mm256_store_si256(reinterpret_cast<Vector*>(data), vector); }
+    static inline uint compareBytes(Vector a, Vector b) { return (uint) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+#else
+    /**
+     * Represents a vector register, that holds the processed elements of an array.
+     */
+    typedef __m128i Vector;
+
+    /**
+     * The comparison mask of two vectors, whose every byte is equal.
+     */
+    static const uint EQUAL_MASK = 0xFFFF;
+
+    static inline Vector broadcast(uint32_t bits) { return _mm_set1_epi32((int) bits); }
+    static inline Vector broadcast(uint64_t bits) { return _mm_set1_epi64x((lint) bits); }
+    static inline Vector loadVector(const byte* data) { return _mm_loadu_si128(reinterpret_cast<const Vector*>(data)); }
+    static inline void storeAligned(byte* data, Vector vector) { _mm_store_si128(reinterpret_cast<Vector*>(data), vector); }
+    static inline uint compareBytes(Vector a, Vector b) { return (uint) _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+#endif
+
+    /**
+     * Get the index of the lowest set bit of a mask.
+     * @param mask non-zero bit mask
+     * @return lowest set bit index
+     */
+    static inline uint lowestBit(uint mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (uint) index;
+#else
+        return (uint) __builtin_ctz(mask);
+#endif
+    }
+#endif
+
+    /**
+     * Initialize the header of the array.
+     * @param type element type descriptor
+     * @param length element count
+     */
+    Array::Array(char type, uint length)
+        : type(type), elementSize(sizeOf(type)), length(length)
+    { }
+
+    /**
+     * Allocate a new array, with its elements set to zero.
+     * @param type element type descriptor
+     * @param length element count
+     * @return new array
+     */
+    Array* Array::allocate(char type, uint length) {
+        // the header and the elements are allocated together, so that accessing an element needs no indirection
+        size_t size = HEADER_SIZE + (size_t) length * sizeOf(type);
+        void* memory = ::operator new(size, std::align_val_t(ALIGNMENT));
+        Array* array = new (memory) Array(type, length);
+        memset(array->data(), 0, size - HEADER_SIZE);
+        return array;
+    }
+
+    /**
+     * Free the memory of an array.
+     * @param array deleted array
+     */
+    void Array::release(Array* array) {
+        ::operator delete(array, std::align_val_t(ALIGNMENT));
+    }
+
+    /**
+     * Get the size of an element of the given type.
+     * @param type element type descriptor
+     * @return element size in bytes, or 0 if the type is not a primitive array element
+     */
+    uint Array::sizeOf(char type) {
+        switch (type) {
+            case 'I':
+                return sizeof(int);
+            case 'J':
+                return sizeof(lint);
+            case 'F':
+                return sizeof(float);
+            case 'D':
+                return sizeof(double);
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Set every element of the array to the given value.
+     * @param value element value
+     */
+    template <typename T>
+    void Array::fill(T value) {
+        T* elements = this->elements<T>();
+        uint index = 0;
+#ifdef VOID_VECTOR_WIDTH
+        // repeat the bits of the value in a vector register, and store it to the aligned elements
+        // as many times as it fits, the remaining elements are set one by one
+        typedef std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t> Bits;
+        Bits bits;
+        memcpy(&bits, &value, sizeof(T));
+        Vector pattern = broadcast(bits);
+        const uint lanes = VOID_VECTOR_WIDTH / sizeof(T);
+        for (; index + lanes <= length; index += lanes)
+            storeAligned(reinterpret_cast<byte*>(elements + index), pattern);
+#endif
+        for (; index < length; index++)
+            elements[index] = value;
+    }
+
+    template void Array::fill<int>(int value);
+    template void Array::fill<lint>(lint value);
+    template void Array::fill<float>(float value);
+    template void Array::fill<double>(double value);
+
+    /**
+     * Copy a range of elements to another array of the same type. The ranges may overlap.
+     * @param sourceOffset the index of the first copied element
+     * @param target destination array
+     * @param targetOffset the index of the first overwritten element in the destination
+     * @param count copied element count
+     */
+    void Array::copy(uint sourceOffset, Array* target, uint targetOffset, uint count) {
+        // the library copy is already vectorized, and handles the unaligned ends of the ranges
+        memmove(target->data() + (size_t) targetOffset * elementSize, data() + (size_t) sourceOffset * elementSize,
+            (size_t) count * elementSize);
+    }
+
+    /**
+     * Find the first element that differs from the element at the same index of another array of the same type.
+     * The elements are compared by their bits, therefore a NaN equals itself, and positive and negative zeroes differ.
+     * @param other compared array
+     * @return the index of the first mismatch, the length of the shorter array if it is the prefix of the other,
+     * or -1 if the arrays are equal
+     */
+    int Array::compare(Array* other) {
+        uint count = getMin(length, other->length);
+        size_t size = (size_t) count * elementSize;
+        byte* first = data();
+        byte* second = other->data();
+        size_t offset = 0;
+#ifdef VOID_VECTOR_WIDTH
+        // compare a vector of bytes at once, the first clear bit of the mask is the first differing byte
+        for (; offset + VOID_VECTOR_WIDTH <= size; offset += VOID_VECTOR_WIDTH) {
+            uint mask = compareBytes(loadVector(first + offset), loadVector(second + offset));
+            if (mask != EQUAL_MASK)
+                return (int) ((offset + lowestBit(~mask)) / elementSize);
+        }
+#endif
+        for (; offset < size; offset++) {
+            if (first[offset] != second[offset])
+                return (int) (offset / elementSize);
+        }
+        return length == other->length ? -1 : (int) count;
+    }
+
+    /**
+     * Get the string representation of the array.
+     * @return array debug information
+     */
+    String Array::debug() {
+        StringStream stream;
+        stream << "[";
+        for (uint i = 0; i < length; i++) {
+            if (i > 0)
+                stream << ", ";
+            switch (type) {
+                case 'I':
+                    stream << elements<int>()[i];
+                    break;
+                case 'J':
+                    stream << elements<lint>()[i];
+                    break;
+                case 'F':
+                    stream << elements<float>()[i];
+                    break;
+                case 'D':
+                    stream << elements<double>()[i];
+                    break;
+            }
+        }
+        stream << "]";
+        return stream.str();
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    /**
+     * Represents a primitive array of the virtual machine. The array is a single allocation, a header that describes
+     * the elements, followed by the contiguous elements themselves. The elements are aligned to the width of the
+     * vector registers, so that the bulk operations may process them with aligned vector loads and stores.
+     */
+    class Array {
+    public:
+        /**
+         * The alignment of the elements of the array, the width of the widest supported vector register.
+         */
+        static const uint ALIGNMENT = 32;
+
+        /**
+         * The space that is reserved for the header before the elements.
+         */
+        static const uint HEADER_SIZE = ALIGNMENT;
+
+        /**
+         * The descriptor of the element type of the array.
+         */
+        const char type;
+
+        /**
+         * The size of an element in bytes.
+         */
+        const uint elementSize;
+
+        /**
+         * The count of the elements of the array.
+         */
+        const uint length;
+
+        /**
+         * Allocate a new array, with its elements set to zero.
+         * @param type element type descriptor
+         * @param length element count
+         * @return new array
+         */
+        static Array* allocate(char type, uint length);
+
+        /**
+         * Free the memory of an array.
+         * @param array deleted array
+         */
+        static void release(Array* array);
+
+        /**
+         * Get the size of an element of the given type.
+         * @param type element type descriptor
+         * @return element size in bytes, or 0 if the type is not a primitive array element
+         */
+        static uint sizeOf(char type);
+
+        /**
+         * Get the first element of the array.
+         * @return element pointer
+         */
+        template <typename T>
+        T* elements() {
+            return reinterpret_cast<T*>(reinterpret_cast<byte*>(this) + HEADER_SIZE);
+        }
+
+        /**
+         * Get the raw memory of the elements.
+         * @return element data
+         */
+        byte* data() {
+            return reinterpret_cast<byte*>(this) + HEADER_SIZE;
+        }
+
+        /**
+         * Set every element of the array to the given value.
+         * @param value element value
+         */
+        template <typename T>
+        void fill(T value);
+
+        /**
+         * Copy a range of elements to another array of the same type. The ranges may overlap.
+         * @param sourceOffset the index of the first copied element
+         * @param target destination array
+         * @param targetOffset the index of the first overwritten element in the destination
+         * @param count copied element count
+         */
+        void copy(uint sourceOffset, Array* target, uint targetOffset, uint count);
+
+        /**
+         * Find the first element that differs from the element at the same index of another array of the same type.
+         * The elements are compared by their bits, therefore a NaN equals itself, and positive and negative zeroes differ.
+         * @param other compared array
+         * @return the index of the first mismatch, the length of the shorter array if it is the prefix of the other,
+         * or -1 if the arrays are equal
+         */
+        int compare(Array* other);
+
+        /**
+         * Get the string representation of the array.
+         * @return array debug information
+         */
+        String debug();
+
+    private:
+        /**
+         * Initialize the header of the array.
+         * @param type element type descriptor
+         * @param length element count
+         */
+        Array(char type, uint length);
+    };
+}
@@ -0,0 +1,127 @@
+#include "ClassTable.hpp"
+
+#include "../element/Class.hpp"
+
+namespace Void {
+    /**
+     * The count of the hash slots of an empty table.
+     */
+    static const uint INITIAL_CAPACITY = 64;
+
+    /**
+     * Initialize an empty class table.
+     */
+    ClassTable::ClassTable()
+        : table(createTable(INITIAL_CAPACITY))
+    { }
+
+    /**
+     * Delete the current and the replaced tables.
+     */
+    ClassTable::~ClassTable() {
+        retired.push_back(table.load(std::memory_order_relaxed));
+        for (Table* old : retired) {
+            delete[] old->slots;
+            delete[] old->order;
+            delete old;
+        }
+    }
+
+    /**
+     * Retrieve a defined class by its name, without locking the table.
+     * @param name class name
+     * @return retrieved class or nullptr if missing
+     */
+    Class* ClassTable::get(const String& name) {
+        // the acquire loads make the class visible only after every write of its builder
+        Table* current = table.load(std::memory_order_acquire);
+        uint mask = current->capacity - 1;
+        for (uint index = (uint) std::hash<String>()(name) & mask; ; index = (index + 1) & mask) {
+            Class* clazz = current->slots[index].load(std::memory_order_acquire);
+            // the slots are never cleared, so a free slot ends the hash chain
+            if (clazz == nullptr)
+                return nullptr;
+            if (clazz->name == name)
+                return clazz;
+        }
+    }
+
+    /**
+     * Define a class, that must be fully built, as the other threads may read it right after it is inserted.
+     * @param clazz defined class
+     * @return false if an other class has already been defined with the same name
+     */
+    bool ClassTable::insert(Class* clazz) {
+        std::lock_guard<std::mutex> lock(insertLock);
+        // no other thread may insert the same name meanwhile
+        if (get(clazz->name) != nullptr)
+            return false;
+
+        Table* current = table.load(std::memory_order_relaxed);
+        uint count = current->count.load(std::memory_order_relaxed);
+        // the table is kept at most half full, so the hash chains stay short
+        if ((count + 1) * 2 > current->capacity) {
+            Table* grown = createTable(current->capacity * 2);
+            for (uint i = 0; i < count; i++) {
+                grown->order[i] = current->order[i];
+                place(grown, current->order[i]);
+            }
+            grown->count.store(count, std::memory_order_relaxed);
+            table.store(grown, std::memory_order_release);
+            retired.push_back(current);
+            current = grown;
+        }
+
+        current->order[count] = clazz;
+        place(current, clazz);
+        current->count.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Get the count of the defined classes.
+     * @return class count
+     */
+    uint ClassTable::size() {
+        return table.load(std::memory_order_acquire)->count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Retrieve a defined class by the order of the definitions.
+     * @param index definition index, that must be lower than a previously read size
+     * @return retrieved class
+     */
+    Class* ClassTable::at(uint index) {
+        // a larger table copies every class of the replaced one, so the index is valid in the current table too
+        return table.load(std::memory_order_acquire)->order[index];
+    }
+
+    /**
+     * Create an empty table.
+     * @param capacity the count of the hash slots
+     * @return created table
+     */
+    ClassTable::Table* ClassTable::createTable(uint capacity) {
+        Table* created = new Table();
+        created->capacity = capacity;
+        created->slots = new std::atomic<Class*>[capacity];
+        for (uint i = 0; i < capacity; i++)
+            created->slots[i].store(nullptr, std::memory_order_relaxed);
+        created->order = new Class*[capacity / 2];
+        created->count.store(0, std::memory_order_relaxed);
+        return created;
+    }
+
+    /**
+     * Store a class in the first free slot of its hash chain.
+     * @param target the table to store the class in
+     * @param clazz stored class
+     */
+    void ClassTable::place(Table* target, Class* clazz) {
+        uint mask = target->capacity - 1;
+        uint index = (uint) std::hash<String>()(clazz->name) & mask;
+        while (target->slots[index].load(std::memory_order_relaxed) != nullptr)
+            index = (index + 1) & mask;
+        target->slots[index].store(clazz, std::memory_order_release);
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    class Class;
+
+    /**
+     * Represents the table of the defined classes, that is read by the running threads without locking. The classes
+     * are stored in an open addressing hash table, whose slots are published by atomic stores, and the definitions
+     * are serialized by a lock. A full table is copied to a larger one, that replaces it by a single atomic store,
+     * and the replaced tables are kept until the table is deleted, as an other thread may still be reading them.
+     */
+    class ClassTable {
+    public:
+        /**
+         * Initialize an empty class table.
+         */
+        ClassTable();
+
+        /**
+         * The classes are owned by the virtual machine, therefore the table cannot be copied.
+         */
+        ClassTable(const ClassTable&) = delete;
+
+        /**
+         * Delete the current and the replaced tables.
+         */
+        ~ClassTable();
+
+        /**
+         * Retrieve a defined class by its name, without locking the table.
+         * @param name class name
+         * @return retrieved class or nullptr if missing
+         */
+        Class* get(const String& name);
+
+        /**
+         * Define a class, that must be fully built, as the other threads may read it right after it is inserted.
+         * @param clazz defined class
+         * @return false if an other class has already been defined with the same name
+         */
+        bool insert(Class* clazz);
+
+        /**
+         * Get the count of the defined classes.
+         * @return class count
+         */
+        uint size();
+
+        /**
+         * Retrieve a defined class by the order of the definitions.
+         * @param index definition index, that must be lower than a previously read size
+         * @return retrieved class
+         */
+        Class* at(uint index);
+
+    private:
+        /**
+         * Represents a fixed capacity table of the classes.
+         */
+        struct Table {
+            /**
+             * The count of the hash slots, always a power of two.
+             */
+            uint capacity;
+
+            /**
+             * The hash slots of the classes, nullptr if a slot is free.
+             */
+            std::atomic<Class*>* slots;
+
+            /**
+             * The classes in the order of their definitions. An element is written before the count is increased,
+             * therefore the elements below the count are never modified.
+             */
+            Class** order;
+
+            /**
+             * The count of the classes in the table.
+             */
+            std::atomic<uint> count;
+        };
+
+        /**
+         * The current table of the classes.
+         */
+        std::atomic<Table*> table;
+
+        /**
+         * The tables, that have been replaced by a larger one.
+         */
+        List<Table*> retired;
+
+        /**
+         * The lock of the class definitions.
+         */
+        std::mutex insertLock;
+
+        /**
+         * Create an empty table.
+         * @param capacity the count of the hash slots
+         * @return created table
+         */
+        static Table* createTable(uint capacity);
+
+        /**
+         * Store a class in the first free slot of its hash chain.
+         * @param target the table to store the class in
+         * @param clazz stored class
+         */
+        static void place(Table* target, Class* clazz);
+    };
+}
@@ -0,0 +1,221 @@
+#include "Console.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <atomic>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+namespace Void {
+    namespace Console {
+        /**
+         * The file descriptor of the standard output stream.
+         */
+        static const int STANDARD_OUTPUT = 1;
+
+        /**
+         * The space that is reserved in the buffer for formatting a number in place.
+         */
+        static const uint NUMBER_SIZE = 32;
+
+        /**
+         * The significant digits of the formatted floating point numbers, the default precision of the output streams.
+         */
+        static const int FLOATING_PRECISION = 6;
+
+        /**
+         * Determine if the standard output stream is an interactive terminal.
+         * @return true if the output is displayed, instead of being redirected to a file or a pipe
+         */
+        static bool isTerminal() {
+#ifdef _WIN32
+            return _isatty(STANDARD_OUTPUT);
+#else
+            return isatty(STANDARD_OUTPUT);
+#endif
+        }
+
+        /**
+         * Determine if the output is written at the end of each line. The redirected output is fully buffered by default.
+         */
+        static std::atomic<bool> lineBuffered = isTerminal();
+
+        /**
+         * Write data to a file, until all of it has been written.
+         * @param file target file descriptor
+         * @param data written characters
+         * @param length character count
+         */
+        static void writeFully(int file, const char* data, size_t length) {
+            // the system call might write only a part of the data
+            while (length > 0) {
+#ifdef _WIN32
+                lint written = _write(file, data, (uint) length);
+#else
+                lint written = ::write(file, data, length);
+#endif
+                if (written <= 0)
+                    return;
+                data += written;
+                length -= (size_t) written;
+            }
+        }
+
+        /**
+         * Represents the output buffer of a thread.
+         */
+        class OutputBuffer {
+        public:
+            /**
+             * The buffered characters.
+             */
+            char data[BUFFER_SIZE];
+
+            /**
+             * The count of the buffered characters.
+             */
+            size_t size = 0;
+
+            /**
+             * Write the remaining output, when the thread exits. The output stream is flushed after the threads
+             * when the program exits, so that an error message of the virtual machine follows the program output.
+             */
+            ~OutputBuffer() {
+                writeFully(STANDARD_OUTPUT, data, size);
+            }
+
+            /**
+             * Write the buffered characters to the standard output stream.
+             */
+            void flush() {
+                if (size == 0)
+                    return;
+                // the messages of the virtual machine are written through the output stream,
+                // they must not be overtaken by the output of the program
+                std::cout.flush();
+                writeFully(STANDARD_OUTPUT, data, size);
+                size = 0;
+            }
+        };
+
+        /**
+         * The output buffer of the current thread.
+         */
+        static thread_local OutputBuffer buffer;
+
+        /**
+         * Set the buffering mode of the output.
+         * @param mode new buffering mode
+         */
+        void setBuffering(Buffering mode) {
+            lineBuffered = mode == Buffering::LINE;
+        }
+
+        /**
+         * Append raw characters to the output buffer of the current thread.
+         * @param data appended characters
+         * @param length character count
+         */
+        void write(const char* data, size_t length) {
+            if (buffer.size + length <= BUFFER_SIZE) {
+                memcpy(buffer.data + buffer.size, data, length);
+                buffer.size += length;
+                return;
+            }
+
+            // the data does not fit the buffer, write the buffered output and the data with a single system call
+            std::cout.flush();
+#ifdef _WIN32
+            writeFully(STANDARD_OUTPUT, buffer.data, buffer.size);
+            writeFully(STANDARD_OUTPUT, data, length);
+#else
+            iovec parts[2] = { { buffer.data, buffer.size }, { const_cast<char*>(data), length } };
+            lint written = ::writev(STANDARD_OUTPUT, parts, 2);
+            size_t total = written > 0 ? (size_t) written : 0;
+            // write the rest of the parts, if the call was interrupted
+            size_t first = getMin(total, buffer.size);
+            writeFully(STANDARD_OUTPUT, buffer.data + first, buffer.size - first);
+            size_t second = total - first;
+            writeFully(STANDARD_OUTPUT, data + second, length - second);
+#endif
+            buffer.size = 0;
+        }
+
+        /**
+         * Append a text to the output buffer of the current thread.
+         * @param text appended text
+         */
+        void write(const String& text) {
+            write(text.data(), text.size());
+        }
+
+        /**
+         * Format a number in place at the end of the output buffer.
+         * @param value appended value
+         * @param args formatting arguments
+         */
+        template <typename T, typename... Args>
+        static void writeNumber(T value, Args... args) {
+            if (BUFFER_SIZE - buffer.size < NUMBER_SIZE)
+                buffer.flush();
+            char* begin = buffer.data + buffer.size;
+            std::to_chars_result result = std::to_chars(begin, begin + NUMBER_SIZE, value, args...);
+            buffer.size += result.ptr - begin;
+        }
+
+        /**
+         * Append an integer to the output buffer of the current thread.
+         * @param value appended value
+         */
+        void write(int value) {
+            writeNumber(value);
+        }
+
+        /**
+         * Append a long to the output buffer of the current thread.
+         * @param value appended value
+         */
+        void write(lint value) {
+            writeNumber(value);
+        }
+
+        /**
+         * Append a float to the output buffer of the current thread, formatted the same way as an output stream does.
+         * @param value appended value
+         */
+        void write(float value) {
+            writeNumber(value, std::chars_format::general, FLOATING_PRECISION);
+        }
+
+        /**
+         * Append a double to the output buffer of the current thread, formatted the same way as an output stream does.
+         * @param value appended value
+         */
+        void write(double value) {
+            writeNumber(value, std::chars_format::general, FLOATING_PRECISION);
+        }
+
+        /**
+         * Terminate the current line of the output, and write the buffer in line-buffered mode.
+         */
+        void newLine() {
+            if (buffer.size == BUFFER_SIZE)
+                buffer.flush();
+            buffer.data[buffer.size++] = '\n';
+            if (lineBuffered)
+                buffer.flush();
+        }
+
+        /**
+         * Write the output buffer of the current thread to the standard output stream.
+         */
+        void flush() {
+            buffer.flush();
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    /**
+     * Represents the output layer of the programs running in the virtual machine. Each thread collects its output
+     * in a buffer of its own, that is written to the standard output stream when it is full, when a line ends
+     * in line-buffered mode, or when the thread exits. The numbers are formatted without any allocation.
+     */
+    namespace Console {
+        /**
+         * The capacity of the output buffer of a thread.
+         */
+        static const uint BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * Represents a registry of the output buffering modes.
+         */
+        enum class Buffering {
+            LINE, // the buffer is written at the end of each line
+            FULL  // the buffer is written only when it is full, or explicitly flushed
+        };
+
+        /**
+         * Set the buffering mode of the output. The output is line-buffered by default, if it is written to a terminal.
+         * @param mode new buffering mode
+         */
+        void setBuffering(Buffering mode);
+
+        /**
+         * Append raw characters to the output buffer of the current thread.
+         * @param data appended characters
+         * @param length character count
+         */
+        void write(const char* data, size_t length);
+
+        /**
+         * Append a text to the output buffer of the current thread.
+         * @param text appended text
+         */
+        void write(const String& text);
+
+        /**
+         * Append an integer to the output buffer of the current thread.
+         * @param value appended value
+         */
+        void write(int value);
+
+        /**
+         * Append a long to the output buffer of the current thread.
+         * @param value appended value
+         */
+        void write(lint value);
+
+        /**
+         * Append a float to the output buffer of the current thread, formatted the same way as an output stream does.
+         * @param value appended value
+         */
+        void write(float value);
+
+        /**
+         * Append a double to the output buffer of the current thread, formatted the same way as an output stream does.
+         * @param value appended value
+         */
+        void write(double value);
+
+        /**
+         * Terminate the current line of the output, and write the buffer in line-buffered mode.
+         */
+        void newLine();
+
+        /**
+         * Write the output buffer of the current thread to the standard output stream.
+         */
+        void flush();
+    }
+}
@@ -0,0 +1,189 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../element/Method.hpp"
+#include "Fiber.hpp"
+#include "Monitor.hpp"
+
+namespace Void {
+    /**
+     * Initialize an empty fiber.
+     * @param asynchronous true if the fiber runs a task of the task pool
+     */
+    Fiber::Fiber(bool asynchronous)
+        : asynchronous(asynchronous)
+    { }
+
+    /**
+     * Delete the frames, that have not returned yet.
+     */
+    Fiber::~Fiber() {
+        for (Frame& frame : frames) {
+            delete frame.context->stack;
+            delete frame.context->storage;
+            delete frame.context;
+        }
+    }
+
+    /**
+     * Push the frame of a called method. The frame is executed by the next step of the fiber.
+     * @param method called method
+     * @param context method execution context
+     * @param caller the stack, that receives the return value of the method
+     * @param monitor the lock, that is released when the method returns, or nullptr
+     */
+    void Fiber::push(Method* method, Context* context, Stack* caller, Monitor* monitor) {
+        context->fiber = this;
+        frames.push_back({ method, context, caller, monitor });
+        if (monitor != nullptr)
+            monitors++;
+    }
+
+    /**
+     * Execute the frames until every frame returns, or the fiber is suspended.
+     * @return true if every frame has returned or the fiber has failed, false if the fiber has been suspended
+     */
+    bool Fiber::run() {
+        suspended = false;
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            Context* context = frame.context;
+            // the method returns, when a return instruction moves the cursor to the end of the bytecode
+            if (context->cursor >= context->length) {
+                pop();
+                continue;
+            }
+
+            // execute the instruction, an invoke instruction pushes the frame of the called method,
+            // therefore the cursor of the caller is moved before the callee is executed
+            frame.method->bytecode[context->cursor]->execute(context);
+            if (failed) {
+                unwind();
+                return true;
+            }
+            context->cursor++;
+
+            if (suspended)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Suspend the fiber after the current instruction.
+     */
+    void Fiber::suspend() {
+        suspended = true;
+    }
+
+    /**
+     * Suspend the task after the current instruction, until the future is completed.
+     * @param future the future, that the task waits for
+     */
+    void Fiber::await(Future* future) {
+        awaited = future;
+        suspended = true;
+    }
+
+    /**
+     * Fail the fiber after the current instruction. The frames are deleted without returning a value,
+     * and the error is reported by the owner of the fiber, instead of terminating the virtual machine.
+     * @param message the error message
+     */
+    void Fiber::fail(String message) {
+        failure = message;
+        failed = true;
+    }
+
+    /**
+     * Determine if the fiber has failed.
+     * @return true if an instruction has failed the fiber
+     */
+    bool Fiber::hasFailed() {
+        return failed;
+    }
+
+    /**
+     * Get the error message of the failed fiber.
+     * @return failure message
+     */
+    String Fiber::getError() {
+        return failure;
+    }
+
+    /**
+     * Acquire the lock of a synchronized block. The lock is released when the block exits, or when the fiber fails.
+     * @param monitor the acquired lock
+     */
+    void Fiber::lock(Monitor* monitor) {
+        monitor->acquire();
+        locks.push_back(monitor);
+        monitors++;
+    }
+
+    /**
+     * Release the lock of a synchronized block.
+     * @param monitor the released lock
+     * @return false if the current thread does not hold the lock
+     */
+    bool Fiber::unlock(Monitor* monitor) {
+        if (!monitor->release())
+            return false;
+        // the blocks usually exit in the reverse order of their entries, so the search starts at the last lock
+        for (auto it = locks.rbegin(); it != locks.rend(); it++) {
+            if (*it == monitor) {
+                locks.erase(std::next(it).base());
+                monitors--;
+                break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Get the future, that the suspended task waits for, and clear it.
+     * @return awaited future, or nullptr if the fiber does not wait for a future
+     */
+    Future* Fiber::takeAwaited() {
+        Future* future = awaited;
+        awaited = nullptr;
+        return future;
+    }
+
+    /**
+     * Pass the return value of the last frame to its caller, and delete the frame.
+     */
+    void Fiber::pop() {
+        Frame frame = frames.back();
+        frames.pop_back();
+        frame.method->handleReturn(frame.context, frame.caller);
+        if (frame.monitor != nullptr) {
+            frame.monitor->release();
+            monitors--;
+        }
+        delete frame.context->stack;
+        delete frame.context->storage;
+        delete frame.context;
+    }
+
+    /**
+     * Delete every frame of the failed fiber, and release the locks of the synchronized methods and blocks.
+     */
+    void Fiber::unwind() {
+        while (!frames.empty()) {
+            Frame frame = frames.back();
+            frames.pop_back();
+            if (frame.monitor != nullptr) {
+                frame.monitor->release();
+                monitors--;
+            }
+            delete frame.context->stack;
+            delete frame.context->storage;
+            delete frame.context;
+        }
+        // the locks of the blocks, that have not exited, would never be released otherwise
+        while (!locks.empty()) {
+            locks.back()->release();
+            locks.pop_back();
+            monitors--;
+        }
+    }
+}
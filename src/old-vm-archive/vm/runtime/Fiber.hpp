@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    class Method;
+    class Context;
+    class Stack;
+    class Future;
+    class Generator;
+    class Monitor;
+
+    /**
+     * Represents an execution of the bytecode, that keeps its method frames on an explicit frame stack instead of the
+     * native stack. A called method pushes a frame, that is popped when the method returns, so the depth of the
+     * recursion is limited only by the heap. The execution may be suspended between two instructions, and resumed
+     * later by any thread, but a fiber must not be run by multiple threads at the same time.
+     */
+    class Fiber {
+    public:
+        /**
+         * Determine if the fiber runs a task of the task pool. A task is suspended while it waits for a future,
+         * and it is resumed by the pool after the future has been completed. The other fibers block the thread.
+         */
+        const bool asynchronous;
+
+        /**
+         * The generator, that the fiber produces the elements of, or nullptr if the fiber is not a generator.
+         */
+        Generator* generator = nullptr;
+
+        /**
+         * The count of the locks, that the frames of the fiber hold. A task, that holds a lock, is not suspended
+         * while it waits for a future, as the lock must be released by the thread that acquired it.
+         */
+        uint monitors = 0;
+
+        /**
+         * Initialize an empty fiber.
+         * @param asynchronous true if the fiber runs a task of the task pool
+         */
+        Fiber(bool asynchronous);
+
+        /**
+         * Delete the frames, that have not returned yet.
+         */
+        ~Fiber();
+
+        /**
+         * Push the frame of a called method. The frame is executed by the next step of the fiber.
+         * @param method called method
+         * @param context method execution context
+         * @param caller the stack, that receives the return value of the method
+         * @param monitor the lock, that is released when the method returns, or nullptr
+         */
+        void push(Method* method, Context* context, Stack* caller, Monitor* monitor = nullptr);
+
+        /**
+         * Execute the frames until every frame returns, or the fiber is suspended.
+         * @return true if every frame has returned or the fiber has failed, false if the fiber has been suspended
+         */
+        bool run();
+
+        /**
+         * Fail the fiber after the current instruction. The frames are deleted without returning a value,
+         * and the error is reported by the owner of the fiber, instead of terminating the virtual machine.
+         * @param message the error message
+         */
+        void fail(String message);
+
+        /**
+         * Determine if the fiber has failed.
+         * @return true if an instruction has failed the fiber
+         */
+        bool hasFailed();
+
+        /**
+         * Get the error message of the failed fiber.
+         * @return failure message
+         */
+        String getError();
+
+        /**
+         * Suspend the fiber after the current instruction.
+         */
+        void suspend();
+
+        /**
+         * Suspend the task after the current instruction, until the future is completed.
+         * @param future the future, that the task waits for
+         */
+        void await(Future* future);
+
+        /**
+         * Acquire the lock of a synchronized block. The lock is released when the block exits, or when the fiber fails.
+         * @param monitor the acquired lock
+         */
+        void lock(Monitor* monitor);
+
+        /**
+         * Release the lock of a synchronized block.
+         * @param monitor the released lock
+         * @return false if the current thread does not hold the lock
+         */
+        bool unlock(Monitor* monitor);
+
+        /**
+         * Get the future, that the suspended task waits for, and clear it.
+         * @return awaited future, or nullptr if the fiber does not wait for a future
+         */
+        Future* takeAwaited();
+
+    private:
+        /**
+         * Represents a method frame on the frame stack.
+         */
+        struct Frame {
+            /**
+             * The called method.
+             */
+            Method* method;
+
+            /**
+             * The execution context of the method.
+             */
+            Context* context;
+
+            /**
+             * The stack, that receives the return value of the method.
+             */
+            Stack* caller;
+
+            /**
+             * The lock, that is released when the method returns, or nullptr.
+             */
+            Monitor* monitor;
+        };
+
+        /**
+         * The frames of the called methods, the last one is being executed.
+         */
+        List<Frame> frames;
+
+        /**
+         * The locks of the synchronized blocks, that have not exited yet, in the order of the acquisitions.
+         */
+        List<Monitor*> locks;
+
+        /**
+         * Determine if the fiber has been suspended by the current instruction.
+         */
+        bool suspended = false;
+
+        /**
+         * The future, that the suspended task waits for.
+         */
+        Future* awaited = nullptr;
+
+        /**
+         * Determine if the fiber has been failed by an instruction.
+         */
+        bool failed = false;
+
+        /**
+         * The error message of the failed fiber.
+         */
+        String failure;
+
+        /**
+         * Pass the return value of the last frame to its caller, and delete the frame.
+         */
+        void pop();
+
+        /**
+         * Delete every frame of the failed fiber, and release the locks of the synchronized methods and blocks.
+         */
+        void unwind();
+    };
+}
@@ -0,0 +1,141 @@
+#include "Future.hpp"
+#include "Stack.hpp"
+#include "Thread.hpp"
+#include "TaskPool.hpp"
+
+namespace Void {
+    /**
+     * Initialize an empty future.
+     * @param id future identifier
+     * @param type the type descriptor of the result value
+     * @param pool the task pool, that runs the callbacks
+     */
+    Future::Future(uint id, char type, TaskPool* pool)
+        : id(id), type(type), pool(pool), value(new Stack(nullptr, nullptr, "Future"))
+    { }
+
+    /**
+     * Complete the future with the value on the stack. The value is removed from the stack,
+     * even if the future has already been completed.
+     * @param stack the stack that holds the result value
+     * @return true if the future was completed by this call
+     */
+    bool Future::complete(Stack* stack) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (state.load(std::memory_order_relaxed) != State::EMPTY) {
+            // drop the value, that is not needed anymore
+            if (type != 'V') {
+                Stack* dropped = new Stack(nullptr, nullptr, "Dropped");
+                Thread::transfer(type, stack, dropped);
+                delete dropped;
+            }
+            return false;
+        }
+        if (type != 'V')
+            Thread::transfer(type, stack, value);
+        finish(State::COMPLETED, guard);
+        return true;
+    }
+
+    /**
+     * Fail the future with an error.
+     * @param message the completion error
+     * @return true if the future was failed by this call
+     */
+    bool Future::fail(String message) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (state.load(std::memory_order_relaxed) != State::EMPTY)
+            return false;
+        failure = message;
+        finish(State::FAILED, guard);
+        return true;
+    }
+
+    /**
+     * Register a callback, that is run by the task pool after the future has been completed or failed.
+     * @param callback the callback to be run
+     */
+    void Future::then(Function<void(Future*)> callback) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (state.load(std::memory_order_relaxed) == State::EMPTY) {
+                callbacks.push_back(std::move(callback));
+                return;
+            }
+        }
+        // the future has already been completed, the callback is run right away by the pool
+        pool->submit([this, callback]() {
+            callback(this);
+        });
+    }
+
+    /**
+     * Wait until the future is completed, and push a copy of its result value to the stack.
+     * @param stack the stack to push the result to
+     * @return false if the future has failed, and no value has been pushed
+     */
+    bool Future::await(Stack* stack) {
+        // run the queued tasks while waiting, the future might be completed by one of them
+        while (state.load(std::memory_order_acquire) == State::EMPTY) {
+            if (pool->runPending())
+                continue;
+            std::unique_lock<std::mutex> guard(lock);
+            done.wait_for(guard, std::chrono::milliseconds(1), [this]() {
+                return state.load(std::memory_order_relaxed) != State::EMPTY;
+            });
+        }
+        if (state.load(std::memory_order_acquire) == State::FAILED)
+            return false;
+        copyValue(stack);
+        return true;
+    }
+
+    /**
+     * Copy the result value of the completed future to the stack.
+     * @param stack the stack to push the result to
+     */
+    void Future::copyValue(Stack* stack) {
+        if (type == 'V')
+            return;
+        // the awaiting threads copy the value one by one
+        std::lock_guard<std::mutex> guard(lock);
+        Thread::transfer(type, value, stack, true);
+    }
+
+    /**
+     * Get the current state of the future.
+     * @return future state
+     */
+    Future::State Future::getState() {
+        return state.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the completion error of the failed future.
+     * @return completion error
+     */
+    String Future::getError() {
+        std::lock_guard<std::mutex> guard(lock);
+        return failure;
+    }
+
+    /**
+     * Set the final state of the future, and submit its callbacks to the task pool.
+     * @param result final state
+     * @param guard the held lock of the future
+     */
+    void Future::finish(State result, std::unique_lock<std::mutex>& guard) {
+        state.store(result, std::memory_order_release);
+        List<Function<void(Future*)>> completed;
+        completed.swap(callbacks);
+        guard.unlock();
+        done.notify_all();
+
+        // the callbacks are run by the pool, so that a long chain of futures does not run on this thread
+        for (Function<void(Future*)>& callback : completed) {
+            pool->submit([this, callback]() {
+                callback(this);
+            });
+        }
+    }
+}
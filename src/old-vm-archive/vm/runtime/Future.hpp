@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    class Stack;
+    class TaskPool;
+
+    /**
+     * Represents the result of a task of the virtual machine, that is completed by an other thread. The callbacks of
+     * the future are run by the task pool after it has been completed, and the threads that wait for the result help
+     * the workers of the pool meanwhile. The tasks of the pool do not wait, they are suspended until the result is ready.
+     */
+    class Future {
+    public:
+        /**
+         * Represents a registry of the future states.
+         */
+        enum class State : byte {
+            EMPTY,     // the future is yet to be completed
+            COMPLETED, // the future holds its result value
+            FAILED     // the future holds the completion error
+        };
+
+        /**
+         * The identifier of the future, its index in the future table of the virtual machine.
+         */
+        const uint id;
+
+        /**
+         * The type descriptor of the result value, 'V' if the future has no value.
+         */
+        const char type;
+
+        /**
+         * Initialize an empty future.
+         * @param id future identifier
+         * @param type the type descriptor of the result value
+         * @param pool the task pool, that runs the callbacks
+         */
+        Future(uint id, char type, TaskPool* pool);
+
+        /**
+         * Complete the future with the value on the stack. The value is removed from the stack,
+         * even if the future has already been completed.
+         * @param stack the stack that holds the result value
+         * @return true if the future was completed by this call
+         */
+        bool complete(Stack* stack);
+
+        /**
+         * Fail the future with an error.
+         * @param message the completion error
+         * @return true if the future was failed by this call
+         */
+        bool fail(String message);
+
+        /**
+         * Register a callback, that is run by the task pool after the future has been completed or failed.
+         * @param callback the callback to be run
+         */
+        void then(Function<void(Future*)> callback);
+
+        /**
+         * Wait until the future is completed, and push a copy of its result value to the stack.
+         * @param stack the stack to push the result to
+         * @return false if the future has failed, and no value has been pushed
+         */
+        bool await(Stack* stack);
+
+        /**
+         * Copy the result value of the completed future to the stack.
+         * @param stack the stack to push the result to
+         */
+        void copyValue(Stack* stack);
+
+        /**
+         * Get the current state of the future.
+         * @return future state
+         */
+        State getState();
+
+        /**
+         * Get the completion error of the failed future.
+         * @return completion error
+         */
+        String getError();
+
+    private:
+        /**
+         * The task pool, that runs the callbacks.
+         */
+        TaskPool* pool;
+
+        /**
+         * The current state of the future.
+         */
+        std::atomic<State> state = State::EMPTY;
+
+        /**
+         * The stack, that holds the result value.
+         */
+        Stack* value;
+
+        /**
+         * The completion error of the failed future.
+         */
+        String failure;
+
+        /**
+         * The callbacks, that are run after the future has been completed.
+         */
+        List<Function<void(Future*)>> callbacks;
+
+        /**
+         * The lock of the result and the callbacks.
+         */
+        std::mutex lock;
+
+        /**
+         * The condition, that is notified when the future is completed.
+         */
+        std::condition_variable done;
+
+        /**
+         * Set the final state of the future, and submit its callbacks to the task pool.
+         * @param result final state
+         * @param guard the held lock of the future
+         */
+        void finish(State result, std::unique_lock<std::mutex>& guard);
+    };
+}
@@ -0,0 +1,106 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../element/Method.hpp"
+#include "Generator.hpp"
+#include "Fiber.hpp"
+#include "Thread.hpp"
+
+namespace Void {
+    /**
+     * Initialize the generator. The method is not executed until the first value is requested.
+     * @param id generator identifier
+     * @param method the method, that yields the values
+     * @param heap root stack, that holds the arguments of the method
+     */
+    Generator::Generator(uint id, Method* method, Stack* heap)
+        : id(id), type(method->returnType[0]), fiber(new Fiber(false)), heap(heap), buffer(new Stack(nullptr, nullptr, "Generator")) {
+        fiber->generator = this;
+        method->call(fiber, heap, nullptr);
+    }
+
+    /**
+     * Resume the method until it yields the next value, unless that value has been yielded already.
+     * The consumer fails, if the generator is already running, or if the method has failed.
+     * @param consumer the fiber, that requests the value
+     * @return true if a value is ready, false if the method has returned or failed
+     */
+    bool Generator::hasNext(Fiber* consumer) {
+        if (!claim(consumer))
+            return false;
+        bool ready = advance(consumer);
+        running.store(false, std::memory_order_release);
+        return ready;
+    }
+
+    /**
+     * Move the next value to the stack. The method is resumed, if the value has not been yielded yet.
+     * The consumer fails, if the method has no more values.
+     * @param consumer the fiber, that requests the value
+     * @param stack the stack to push the value to
+     */
+    void Generator::next(Fiber* consumer, Stack* stack) {
+        if (!claim(consumer))
+            return;
+        // the value is taken while the generator is claimed, so two consumers never take the same value
+        if (advance(consumer)) {
+            Thread::transfer(type, buffer, stack);
+            buffered.store(false, std::memory_order_relaxed);
+        }
+        // the failure of the method has already been reported
+        else if (!consumer->hasFailed())
+            consumer->fail("NoSuchElementException: Generator " + toString(id) + " has no more values");
+        running.store(false, std::memory_order_release);
+    }
+
+    /**
+     * Move a yielded value from the stack of the method, and suspend the method.
+     * @param stack the stack that holds the yielded value
+     */
+    void Generator::yield(Stack* stack) {
+        Thread::transfer(type, stack, buffer);
+        buffered.store(true, std::memory_order_relaxed);
+        fiber->suspend();
+    }
+
+    /**
+     * Claim the generator for a consumer, so that its fiber is never run by two threads at the same time.
+     * The consumer fails, if the generator is already claimed, by an other thread or by its own method.
+     * @param consumer the fiber, that requests the value
+     * @return true if the generator has been claimed, and it must be released by the consumer
+     */
+    bool Generator::claim(Fiber* consumer) {
+        // the acquire exchange makes the writes of the previous consumer visible
+        if (running.exchange(true, std::memory_order_acquire)) {
+            consumer->fail("IllegalStateException: Generator " + toString(id) + " is already running");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Resume the method of the claimed generator until it yields the next value, unless that value
+     * has been yielded already. The consumer fails, if the method has failed.
+     * @param consumer the fiber, that requests the value
+     * @return true if a value is ready, false if the method has returned or failed
+     */
+    bool Generator::advance(Fiber* consumer) {
+        if (!failure.empty()) {
+            consumer->fail("GeneratorExecutionError: Generator " + toString(id) + " has failed: " + failure);
+            return false;
+        }
+        if (buffered.load(std::memory_order_relaxed) || fiber == nullptr)
+            return buffered.load(std::memory_order_relaxed);
+
+        // the return value of the method is not a yielded value, it is dropped with the fiber
+        if (fiber->run()) {
+            if (fiber->hasFailed()) {
+                failure = fiber->getError();
+                consumer->fail("GeneratorExecutionError: Generator " + toString(id) + " has failed: " + failure);
+            }
+            delete fiber;
+            delete heap;
+            fiber = nullptr;
+            heap = nullptr;
+        }
+        return buffered.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    class Method;
+    class Stack;
+    class Fiber;
+
+    /**
+     * Represents a lazy sequence of values, that are produced by a static method on a fiber of its own. The method
+     * is suspended by each yielded value, and it is resumed when the next value is requested, so the values are
+     * produced one by one on the thread that consumes them. A consumer claims the generator while it requests
+     * a value, and a concurrent request of an other consumer fails instead of running the same fiber.
+     */
+    class Generator {
+    public:
+        /**
+         * The identifier of the generator, its index in the generator table of the virtual machine.
+         */
+        const uint id;
+
+        /**
+         * The type descriptor of the yielded values, the return type of the method. 'V' if the values are not passed.
+         */
+        const char type;
+
+        /**
+         * Initialize the generator. The method is not executed until the first value is requested.
+         * @param id generator identifier
+         * @param method the method, that yields the values
+         * @param heap root stack, that holds the arguments of the method
+         */
+        Generator(uint id, Method* method, Stack* heap);
+
+        /**
+         * Resume the method until it yields the next value, unless that value has been yielded already.
+         * The consumer fails, if the generator is already running, or if the method has failed.
+         * @param consumer the fiber, that requests the value
+         * @return true if a value is ready, false if the method has returned or failed
+         */
+        bool hasNext(Fiber* consumer);
+
+        /**
+         * Move the next value to the stack. The method is resumed, if the value has not been yielded yet.
+         * The consumer fails, if the method has no more values.
+         * @param consumer the fiber, that requests the value
+         * @param stack the stack to push the value to
+         */
+        void next(Fiber* consumer, Stack* stack);
+
+        /**
+         * Move a yielded value from the stack of the method, and suspend the method.
+         * @param stack the stack that holds the yielded value
+         */
+        void yield(Stack* stack);
+
+    private:
+        /**
+         * The fiber, that executes the method, or nullptr if the method has returned.
+         */
+        Fiber* fiber;
+
+        /**
+         * The root stack of the fiber.
+         */
+        Stack* heap;
+
+        /**
+         * The stack, that holds the yielded value, until it is requested.
+         */
+        Stack* buffer;
+
+        /**
+         * The error message of the method, if it has failed, that is reported to every consumer.
+         */
+        String failure;
+
+        /**
+         * Determine if a value has been yielded, that is not requested yet.
+         */
+        std::atomic<bool> buffered = false;
+
+        /**
+         * Determine if the generator has been claimed by a consumer, a generator cannot request its own values.
+         */
+        std::atomic<bool> running = false;
+
+        /**
+         * Claim the generator for a consumer, so that its fiber is never run by two threads at the same time.
+         * The consumer fails, if the generator is already claimed, by an other thread or by its own method.
+         * @param consumer the fiber, that requests the value
+         * @return true if the generator has been claimed, and it must be released by the consumer
+         */
+        bool claim(Fiber* consumer);
+
+        /**
+         * Resume the method of the claimed generator until it yields the next value, unless that value
+         * has been yielded already. The consumer fails, if the method has failed.
+         * @param consumer the fiber, that requests the value
+         * @return true if a value is ready, false if the method has returned or failed
+         */
+        bool advance(Fiber* consumer);
+    };
+}
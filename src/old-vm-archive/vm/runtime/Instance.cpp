@@ -20,7 +20,7 @@ namespace Void {
         Class* temp = clazz;
         while (temp != nullptr) {
             // loop through the registered class fields
-            for (Field* field : clazz->fields) {
+            for (Field* field : temp->fields) {
                 // skip field if it is already copied
                 if (getField(field->name) != nullptr)
                     continue;
@@ -32,11 +32,11 @@ namespace Void {
                 values[field] = field->value;
             }
             // return if the class does not have a custom superclass
-            if (clazz->superclass.empty() || clazz->superclass == "Object")
+            if (temp->superclass.empty() || temp->superclass == "Object")
                 return;
 
             // get the superclass of the class
-            clazz = vm->getClass(clazz->superclass);
+            temp = vm->getClass(temp->superclass);
         }
     }
 
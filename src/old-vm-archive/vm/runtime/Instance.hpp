@@ -3,6 +3,7 @@
 #include "../../Common.hpp"
 #include "../element/Field.hpp"
 #include "Type.hpp"
+#include "Monitor.hpp"
 
 #ifndef VOID_INSTANCE
 #define VOID_INSTANCE
@@ -16,9 +17,10 @@ namespace Void {
     class Reference;
 
     /**
-     * The instance identifier incremention counter.
+     * The instance identifier incremention counter. It is shared by every thread and translation unit,
+     * so that no two instances get the same identifier.
      */
-    static int __instanceCounter = 0;
+    inline std::atomic<int> __instanceCounter = 0;
 
     /**
      * Represents a runtime instance of a loaded class.
@@ -34,7 +36,7 @@ namespace Void {
         /**
          * The increment identifier of the instance.
          */
-        int instanceId = __instanceCounter++;
+        int instanceId = __instanceCounter.fetch_add(1, std::memory_order_relaxed);
 
         /**
          * The type of the instance class.
@@ -46,6 +48,11 @@ namespace Void {
          */
         Class* clazz;
 
+        /**
+         * The lock of the instance header, that the synchronized methods and blocks hold.
+         */
+        Monitor monitor;
+
         /**
          * Initialize the instance.
          * @param clazz intantiated class
@@ -28,13 +28,14 @@ namespace Void {
         WEAK         = 0x00010000,
         STRONG       = 0x00020000,
         DEFAULT      = 0x00040000,
-        ASYNC        = 0x00080000
+        ASYNC        = 0x00080000,
+        EXTERN       = 0x00100000
     };
 
     /**
      * The count of the registered modifiers.
      */
-    static const int MODIFIER_COUNT = 19;
+    static const int MODIFIER_COUNT = 21;
 
     /**
      * The registry of the modifier names.
@@ -42,8 +43,8 @@ namespace Void {
     static const char* MODIFIER_KEYS[MODIFIER_COUNT] = {
         "public", "private", "protected", "static", "final",  "synchronized",
         "volatile", "transient", "native", "unsafe", "abstract", "interface",
-        "annotation",  "enum",   "struct",   "weak",   "strong",   "default",
-        "async"
+        "annotation",  "enum",   "struct",   "tuple_struct", "weak",   "strong",
+        "default", "async", "extern"
     };
 
     /**
@@ -53,7 +54,7 @@ namespace Void {
         0x00000001, 0x00000002, 0x00000004, 0x00000008, 0x00000010, 0x00000020,
         0x00000040, 0x00000080, 0x00000100, 0x00000200, 0x00000400, 0x00000800,
         0x00001000, 0x00002000, 0x00004000, 0x00008000, 0x00010000, 0x00020000,
-        0x00040000
+        0x00040000, 0x00080000, 0x00100000
     };
 
     /**
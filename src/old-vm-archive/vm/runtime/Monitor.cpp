@@ -0,0 +1,185 @@
+#include "Monitor.hpp"
+
+namespace Void {
+    /**
+     * The bit of the lock word, that is set if the word holds an inflated monitor.
+     */
+    static const uint64_t INFLATED = 1;
+
+    /**
+     * The recursion count of a thin lock, stored in the bits after the inflation bit.
+     */
+    static const uint64_t COUNT_UNIT = 2;
+    static const uint64_t COUNT_MASK = 0xFFFE;
+
+    /**
+     * The identifier of the owner thread of a thin lock, stored in the bits after the recursion count. The word is
+     * 64 bits wide on every platform, so the 48 bits of the identifiers are never exhausted by the started threads.
+     */
+    static const uint64_t OWNER_SHIFT = 16;
+    static const uint64_t OWNER_MASK = ~(uint64_t) 0xFFFF;
+
+    /**
+     * The count of the attempts to take a thin lock held by an other thread, before the lock is inflated.
+     */
+    static const uint SPIN_LIMIT = 64;
+
+    /**
+     * The lock contention statistics of every monitor.
+     */
+    static std::atomic<ulong> contended = 0;
+    static std::atomic<ulong> inflated = 0;
+    static std::atomic<ulong> parked = 0;
+
+    /**
+     * The counter of the thread identifiers, 0 marks a free lock.
+     */
+    static std::atomic<uint64_t> threadCounter = 1;
+
+    /**
+     * Get the identifier of the current thread, that is assigned by its first lock.
+     * @return thread identifier
+     */
+    static uint64_t currentThread() {
+        thread_local uint64_t id = threadCounter.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    /**
+     * Delete the inflated monitor of the lock.
+     */
+    Monitor::~Monitor() {
+        uint64_t current = word.load(std::memory_order_acquire);
+        if (current & INFLATED)
+            delete reinterpret_cast<Inflated*>((uintptr_t) (current & ~INFLATED));
+    }
+
+    /**
+     * Acquire the lock, and wait until the other threads release it. A thread may acquire its own lock again.
+     */
+    void Monitor::acquire() {
+        uint64_t self = currentThread() << OWNER_SHIFT;
+        // an uncontended lock is taken by a single exchange
+        uint64_t expected = 0;
+        if (word.compare_exchange_strong(expected, self, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+        acquireSlow(self);
+    }
+
+    /**
+     * Release the lock once, the lock is free after it has been released as many times as it was acquired.
+     * @return false if the current thread does not hold the lock
+     */
+    bool Monitor::release() {
+        uint64_t self = currentThread() << OWNER_SHIFT;
+        uint64_t current = word.load(std::memory_order_acquire);
+        // the owner releases a thin lock by an exchange too, so it notices if the lock was inflated meanwhile
+        while (!(current & INFLATED)) {
+            if ((current & OWNER_MASK) != self)
+                return false;
+            uint64_t next = (current & COUNT_MASK) != 0 ? current - COUNT_UNIT : 0;
+            if (word.compare_exchange_weak(current, next, std::memory_order_release, std::memory_order_acquire))
+                return true;
+        }
+
+        Inflated* monitor = reinterpret_cast<Inflated*>((uintptr_t) (current & ~INFLATED));
+        std::unique_lock<std::mutex> guard(monitor->lock);
+        if (monitor->owner != self)
+            return false;
+        if (--monitor->count > 0)
+            return true;
+        monitor->owner = 0;
+        guard.unlock();
+        monitor->released.notify_one();
+        return true;
+    }
+
+    /**
+     * Get the lock contention statistics of every monitor.
+     * @return contention metrics
+     */
+    Monitor::Metrics Monitor::getMetrics() {
+        return {
+            contended.load(std::memory_order_relaxed),
+            inflated.load(std::memory_order_relaxed),
+            parked.load(std::memory_order_relaxed)
+        };
+    }
+
+    /**
+     * Acquire the lock, that the thread could not acquire by a single exchange.
+     * @param self the identifier of the current thread
+     */
+    void Monitor::acquireSlow(uint64_t self) {
+        bool counted = false;
+        for (uint spins = 0; ; spins++) {
+            uint64_t current = word.load(std::memory_order_acquire);
+
+            // the lock has been inflated, the monitor parks the thread until the lock is released
+            if (current & INFLATED) {
+                Inflated* monitor = reinterpret_cast<Inflated*>((uintptr_t) (current & ~INFLATED));
+                std::unique_lock<std::mutex> guard(monitor->lock);
+                if (monitor->owner == self) {
+                    monitor->count++;
+                    return;
+                }
+                if (monitor->owner != 0) {
+                    if (!counted)
+                        contended.fetch_add(1, std::memory_order_relaxed);
+                    parked.fetch_add(1, std::memory_order_relaxed);
+                    monitor->released.wait(guard, [monitor]() {
+                        return monitor->owner == 0;
+                    });
+                }
+                monitor->owner = self;
+                monitor->count = 1;
+                return;
+            }
+
+            // the lock has been released since the first attempt
+            if (current == 0) {
+                if (word.compare_exchange_weak(current, self, std::memory_order_acquire, std::memory_order_relaxed))
+                    return;
+                continue;
+            }
+
+            // the owner acquires the lock again, the recursion count is moved to a monitor if it overflows the word
+            if ((current & OWNER_MASK) == self) {
+                if ((current & COUNT_MASK) == COUNT_MASK)
+                    inflate(current);
+                else if (word.compare_exchange_weak(current, current + COUNT_UNIT, std::memory_order_acquire, std::memory_order_relaxed))
+                    return;
+                continue;
+            }
+
+            // an other thread holds the lock, it is likely to be released soon, otherwise the lock is inflated
+            if (!counted) {
+                contended.fetch_add(1, std::memory_order_relaxed);
+                counted = true;
+            }
+            if (spins < SPIN_LIMIT)
+                std::this_thread::yield();
+            else
+                inflate(current);
+        }
+    }
+
+    /**
+     * Move the owner of a thin lock to a new inflated monitor, unless the lock word has changed meanwhile.
+     * The inflation is permanent, as a parked thread may still hold the address of the monitor after the lock
+     * is released, so the monitor is deleted only with its object.
+     * @param current the observed lock word
+     */
+    void Monitor::inflate(uint64_t current) {
+        Inflated* monitor = new Inflated();
+        monitor->owner = current & OWNER_MASK;
+        monitor->count = (uint) ((current & COUNT_MASK) / COUNT_UNIT) + 1;
+        // the exchange fails, if the owner has released the lock or changed its recursion count meanwhile
+        if (!word.compare_exchange_strong(current, (uint64_t) reinterpret_cast<uintptr_t>(monitor) | INFLATED,
+                std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            delete monitor;
+            return;
+        }
+        inflated.fetch_add(1, std::memory_order_relaxed);
+    }
+}
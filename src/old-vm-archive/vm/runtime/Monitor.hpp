@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    /**
+     * Represents the lock of an object header, that the synchronized methods and blocks hold. The lock is a single word,
+     * that holds the identifier of the owner thread and its recursion count, and it is taken by a single atomic
+     * exchange, if no other thread holds it. A thread that finds the lock held spins for a while, then inflates
+     * the lock, moves the owner to a monitor that parks the waiting threads. An inflated lock is never deflated,
+     * it keeps its monitor until the object is deleted, and every later acquisition takes the mutex of the monitor.
+     */
+    class Monitor {
+    public:
+        /**
+         * Represents the lock contention statistics of every monitor of the virtual machine.
+         */
+        struct Metrics {
+            /**
+             * The count of the lock acquisitions, that found the lock held by an other thread.
+             */
+            ulong contended;
+
+            /**
+             * The count of the locks, that were inflated to a parking monitor.
+             */
+            ulong inflated;
+
+            /**
+             * The count of the times a thread was parked by an inflated monitor.
+             */
+            ulong parked;
+        };
+
+        /**
+         * Initialize an unlocked monitor.
+         */
+        Monitor() = default;
+
+        /**
+         * The lock word belongs to a single object, therefore it cannot be copied.
+         */
+        Monitor(const Monitor&) = delete;
+
+        /**
+         * Delete the inflated monitor of the lock.
+         */
+        ~Monitor();
+
+        /**
+         * Acquire the lock, and wait until the other threads release it. A thread may acquire its own lock again.
+         */
+        void acquire();
+
+        /**
+         * Release the lock once, the lock is free after it has been released as many times as it was acquired.
+         * @return false if the current thread does not hold the lock
+         */
+        bool release();
+
+        /**
+         * Get the lock contention statistics of every monitor.
+         * @return contention metrics
+         */
+        static Metrics getMetrics();
+
+    private:
+        /**
+         * Represents an inflated lock, that parks the threads that wait for it.
+         */
+        struct Inflated {
+            /**
+             * The identifier of the owner thread, 0 if the lock is free.
+             */
+            uint64_t owner;
+
+            /**
+             * The count of the times the owner has acquired the lock.
+             */
+            uint count;
+
+            /**
+             * The lock of the owner and the count.
+             */
+            std::mutex lock;
+
+            /**
+             * The condition, that is notified when the lock is released.
+             */
+            std::condition_variable released;
+        };
+
+        /**
+         * The lock word. It is 0 if the lock is free, the address of the inflated monitor with the lowest bit set
+         * if it has been inflated, otherwise the identifier of the owner thread and the count of the recursions.
+         */
+        std::atomic<uint64_t> word = 0;
+
+        /**
+         * Acquire the lock, that the thread could not acquire by a single exchange.
+         * @param self the identifier of the current thread
+         */
+        void acquireSlow(uint64_t self);
+
+        /**
+         * Move the owner of a thin lock to a new inflated monitor, unless the lock word has changed meanwhile.
+         * The inflation is permanent, as a parked thread may still hold the address of the monitor after the lock
+         * is released, so the monitor is deleted only with its object.
+         * @param current the observed lock word
+         */
+        void inflate(uint64_t current);
+    };
+}
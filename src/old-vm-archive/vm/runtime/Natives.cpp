@@ -0,0 +1,272 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../element/Method.hpp"
+#include "Natives.hpp"
+#include "Console.hpp"
+#include "../../util/Strings.hpp"
+
+namespace Void {
+    namespace Natives {
+        /**
+         * The maximum count of the arguments of an extern call.
+         */
+        static const uint MAX_EXTERN_ARGUMENTS = 6;
+
+        /**
+         * The libraries that are searched for the extern symbols after the requested libraries.
+         */
+        static const char* DEFAULT_LIBRARIES[] = { "kernel32.dll", "msvcrt.dll" };
+
+        /**
+         * The map of the registered native functions by their method signatures.
+         */
+        static Map<String, NativeFunction> functions;
+
+        /**
+         * The flag of the registration of the builtin native functions.
+         */
+        static std::once_flag builtinsDefined;
+
+        /**
+         * The loaded native libraries, that are searched for the extern symbols.
+         */
+        static List<HMODULE> libraries;
+
+        /**
+         * Determine if the native libraries have been loaded.
+         */
+        static bool librariesLoaded = false;
+
+        /**
+         * Get the registry key of a method signature.
+         * @param className the name of the declaring class
+         * @param name method name
+         * @param parameters method parameter descriptors
+         * @param returnType method return type descriptor
+         * @return method signature key
+         */
+        static String getKey(String className, String name, List<String>& parameters, String returnType) {
+            // lang/Console.println(I)V
+            return className + "." + name + "(" + Strings::join(parameters, ", ") + ")" + returnType;
+        }
+
+        /**
+         * Print a value to the standard output stream and terminate the line.
+         * @param value printed value
+         */
+        template <typename T>
+        static void writeLine(T value) {
+            Console::write(value);
+            Console::newLine();
+        }
+
+        /**
+         * Print a value to the standard output stream.
+         * @param value printed value
+         */
+        template <typename T>
+        static void write(T value) {
+            Console::write(value);
+        }
+
+        /**
+         * Print a value to the standard error stream and terminate the line.
+         * @param value printed value
+         */
+        template <typename T>
+        static void writeErrorLine(T value) {
+            // write the buffered output first, so that the two streams are not reordered
+            Console::flush();
+            std::cerr << value << '\n';
+        }
+
+        /**
+         * Print a value to the standard error stream.
+         * @param value printed value
+         */
+        template <typename T>
+        static void writeError(T value) {
+            Console::flush();
+            std::cerr << value;
+        }
+
+        /**
+         * Register the console methods of the standard library for the given value type.
+         */
+        template <typename T>
+        static void defineConsole() {
+            define<&writeLine<T>>("lang/Console", "println");
+            define<&write<T>>("lang/Console", "print");
+            define<&writeErrorLine<T>>("lang/Console", "errorln");
+            define<&writeError<T>>("lang/Console", "error");
+        }
+
+        /**
+         * Register the native methods of the standard library.
+         */
+        static void defineBuiltins() {
+            defineConsole<int>();
+            defineConsole<lint>();
+            defineConsole<float>();
+            defineConsole<double>();
+        }
+
+        /**
+         * Register the function of a native method.
+         * @param className the name of the declaring class
+         * @param name method name
+         * @param parameters method parameter descriptors
+         * @param returnType method return type descriptor
+         * @param function native function
+         */
+        void define(String className, String name, List<String> parameters, String returnType, NativeFunction function) {
+            functions[getKey(className, name, parameters, returnType)] = function;
+        }
+
+        /**
+         * Get the function of a native method.
+         * @param method target native method
+         * @return native function, or nullptr if the method has not been registered
+         */
+        NativeFunction find(Method* method) {
+            // the builtins are registered on the first lookup, so that an embedder may override them before
+            std::call_once(builtinsDefined, defineBuiltins);
+            auto it = functions.find(getKey(method->clazz->name, method->name, method->parameters, method->returnType));
+            return it != functions.end() ? it->second : nullptr;
+        }
+
+        /**
+         * Bind a native or extern method to its implementation.
+         * @param method target method
+         */
+        void bind(Method* method) {
+            String key = getKey(method->clazz->name, method->name, method->parameters, method->returnType);
+
+            // bind the native method to the function registered for its signature
+            if (!method->hasModifier(Modifier::EXTERN)) {
+                method->native = find(method);
+                if (method->native == nullptr)
+                    error("UnsatisfiedLinkError: No native function is registered for " << key);
+                return;
+            }
+
+            // bind the extern method to the exported symbol of the same name
+            method->symbol = resolve(method->name, method->vm);
+            if (method->symbol == nullptr)
+                error("UnsatisfiedLinkError: Unable to find the symbol of extern method " << key << " in the native libraries");
+
+            // the arguments are passed in the integer registers or in the floating point registers,
+            // the calling convention of the other signatures cannot be known without describing the function
+            bool integral = method->parameters.size() <= MAX_EXTERN_ARGUMENTS;
+            bool floating = integral;
+            for (String& parameter : method->parameters) {
+                integral &= parameter == "I" || parameter == "J";
+                floating &= parameter == "D";
+            }
+            char result = method->returnType[0];
+            if (integral && (result == 'V' || result == 'I' || result == 'J'))
+                method->native = callIntegral;
+            else if (floating && result == 'D')
+                method->native = callFloating;
+            else
+                error("UnsatisfiedLinkError: Extern method " << key << " must take at most " << MAX_EXTERN_ARGUMENTS
+                    << " integers and longs, or " << MAX_EXTERN_ARGUMENTS << " doubles and return a double");
+        }
+
+        /**
+         * Find an exported symbol of the native libraries. The libraries of the "-XNativeLibraries" option
+         * are searched first, separated by semicolons, then the default system libraries and the virtual machine itself.
+         * @param name symbol name
+         * @param vm running virtual machine
+         * @return symbol address, or nullptr if none of the libraries export it
+         */
+        void* resolve(String name, VirtualMachine* vm) {
+            // load the libraries once, when the first extern method is linked
+            if (!librariesLoaded) {
+                librariesLoaded = true;
+                if (vm->options.has("XNativeLibraries")) {
+                    String requested = vm->options.get("XNativeLibraries");
+                    for (String library : Strings::split(requested, ';')) {
+                        HMODULE module = LoadLibraryA(library.c_str());
+                        if (module == nullptr)
+                            warn("Unable to load native library " << library);
+                        else
+                            libraries.push_back(module);
+                    }
+                }
+                // the system libraries are not available on every platform
+                for (const char* library : DEFAULT_LIBRARIES) {
+                    HMODULE module = LoadLibraryA(library);
+                    if (module != nullptr)
+                        libraries.push_back(module);
+                }
+                HMODULE self = GetModuleHandleA(nullptr);
+                if (self != nullptr)
+                    libraries.push_back(self);
+            }
+
+            for (HMODULE library : libraries) {
+                FARPROC symbol = GetProcAddress(library, name.c_str());
+                if (symbol != nullptr)
+                    return reinterpret_cast<void*>(symbol);
+            }
+            return nullptr;
+        }
+
+        /**
+         * Call an extern function, whose parameters are integers or longs.
+         * @param method extern method
+         * @param stack caller stack
+         */
+        void callIntegral(Method* method, Stack* stack) {
+            // the integers are widened to the size of a register, the callee reads their lower half only
+            lint a[MAX_EXTERN_ARGUMENTS] = {};
+            uint count = (uint) method->parameters.size();
+            for (uint i = 0; i < count; i++)
+                a[i] = method->parameters[i][0] == 'J' ? stack->longs.pull() : stack->ints.pull();
+
+            void* symbol = method->symbol;
+            lint result = 0;
+            switch (count) {
+                case 0: result = reinterpret_cast<lint (*)()>(symbol)(); break;
+                case 1: result = reinterpret_cast<lint (*)(lint)>(symbol)(a[0]); break;
+                case 2: result = reinterpret_cast<lint (*)(lint, lint)>(symbol)(a[0], a[1]); break;
+                case 3: result = reinterpret_cast<lint (*)(lint, lint, lint)>(symbol)(a[0], a[1], a[2]); break;
+                case 4: result = reinterpret_cast<lint (*)(lint, lint, lint, lint)>(symbol)(a[0], a[1], a[2], a[3]); break;
+                case 5: result = reinterpret_cast<lint (*)(lint, lint, lint, lint, lint)>(symbol)(a[0], a[1], a[2], a[3], a[4]); break;
+                case 6: result = reinterpret_cast<lint (*)(lint, lint, lint, lint, lint, lint)>(symbol)(a[0], a[1], a[2], a[3], a[4], a[5]); break;
+            }
+
+            // the upper half of the register is undefined, if the function returns an integer
+            char prefix = method->returnType[0];
+            if (prefix == 'I')
+                stack->ints.push((int) result);
+            else if (prefix == 'J')
+                stack->longs.push(result);
+        }
+
+        /**
+         * Call an extern function, whose parameters and return value are doubles.
+         * @param method extern method
+         * @param stack caller stack
+         */
+        void callFloating(Method* method, Stack* stack) {
+            double a[MAX_EXTERN_ARGUMENTS] = {};
+            uint count = (uint) method->parameters.size();
+            for (uint i = 0; i < count; i++)
+                a[i] = stack->doubles.pull();
+
+            void* symbol = method->symbol;
+            double result = 0;
+            switch (count) {
+                case 0: result = reinterpret_cast<double (*)()>(symbol)(); break;
+                case 1: result = reinterpret_cast<double (*)(double)>(symbol)(a[0]); break;
+                case 2: result = reinterpret_cast<double (*)(double, double)>(symbol)(a[0], a[1]); break;
+                case 3: result = reinterpret_cast<double (*)(double, double, double)>(symbol)(a[0], a[1], a[2]); break;
+                case 4: result = reinterpret_cast<double (*)(double, double, double, double)>(symbol)(a[0], a[1], a[2], a[3]); break;
+                case 5: result = reinterpret_cast<double (*)(double, double, double, double, double)>(symbol)(a[0], a[1], a[2], a[3], a[4]); break;
+                case 6: result = reinterpret_cast<double (*)(double, double, double, double, double, double)>(symbol)(a[0], a[1], a[2], a[3], a[4], a[5]); break;
+            }
+            stack->doubles.push(result);
+        }
+    }
+}
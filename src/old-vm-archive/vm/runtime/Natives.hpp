@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "Stack.hpp"
+
+#include <tuple>
+
+namespace Void {
+    class Method;
+    class VirtualMachine;
+
+    /**
+     * Represents the handle of a method, that is implemented outside of the bytecode.
+     * The function pulls the arguments of the call from the caller stack, and pushes the result back to it.
+     */
+    typedef void (*NativeFunction)(Method* method, Stack* stack);
+
+    /**
+     * Represents the mapping of a C++ type to the sub-stack that holds its values in the virtual machine.
+     */
+    template <typename T>
+    struct NativeType;
+
+    template <>
+    struct NativeType<int> {
+        static constexpr char descriptor = 'I';
+        static int pull(Stack* stack) { return stack->ints.pull(); }
+        static void push(Stack* stack, int value) { stack->ints.push(value); }
+    };
+
+    template <>
+    struct NativeType<lint> {
+        static constexpr char descriptor = 'J';
+        static lint pull(Stack* stack) { return stack->longs.pull(); }
+        static void push(Stack* stack, lint value) { stack->longs.push(value); }
+    };
+
+    template <>
+    struct NativeType<float> {
+        static constexpr char descriptor = 'F';
+        static float pull(Stack* stack) { return stack->floats.pull(); }
+        static void push(Stack* stack, float value) { stack->floats.push(value); }
+    };
+
+    template <>
+    struct NativeType<double> {
+        static constexpr char descriptor = 'D';
+        static double pull(Stack* stack) { return stack->doubles.pull(); }
+        static void push(Stack* stack, double value) { stack->doubles.push(value); }
+    };
+
+    template <>
+    struct NativeType<bool> {
+        static constexpr char descriptor = 'Z';
+        static bool pull(Stack* stack) { return stack->booleans.pull(); }
+        static void push(Stack* stack, bool value) { stack->booleans.push(value); }
+    };
+
+    /**
+     * Represents the registry of the functions, that implement the native methods of the loaded classes.
+     * The native methods are bound to their functions when the classes are linked, the extern methods
+     * are bound to the symbols of the same name, that are exported by the native libraries.
+     */
+    namespace Natives {
+        /**
+         * Register the function of a native method.
+         * @param className the name of the declaring class
+         * @param name method name
+         * @param parameters method parameter descriptors
+         * @param returnType method return type descriptor
+         * @param function native function
+         */
+        void define(String className, String name, List<String> parameters, String returnType, NativeFunction function);
+
+        /**
+         * Get the function of a native method.
+         * @param method target native method
+         * @return native function, or nullptr if the method has not been registered
+         */
+        NativeFunction find(Method* method);
+
+        /**
+         * Bind a native or extern method to its implementation.
+         * @param method target method
+         */
+        void bind(Method* method);
+
+        /**
+         * Find an exported symbol of the native libraries. The libraries of the "-XNativeLibraries" option
+         * are searched first, separated by semicolons, then the default system libraries and the virtual machine itself.
+         * @param name symbol name
+         * @param vm running virtual machine
+         * @return symbol address, or nullptr if none of the libraries export it
+         */
+        void* resolve(String name, VirtualMachine* vm);
+
+        /**
+         * Call an extern function, whose parameters are integers or longs.
+         * @param method extern method
+         * @param stack caller stack
+         */
+        void callIntegral(Method* method, Stack* stack);
+
+        /**
+         * Call an extern function, whose parameters and return value are doubles.
+         * @param method extern method
+         * @param stack caller stack
+         */
+        void callFloating(Method* method, Stack* stack);
+
+        /**
+         * Call a C++ function with the arguments pulled from the caller stack. The arguments are pulled
+         * in the order of the parameters, straight to the argument registers of the call.
+         * @param function target function
+         * @param stack caller stack
+         */
+        template <typename R, typename... Args>
+        inline void call(R (*function)(Args...), Stack* stack) {
+            // the elements of a braced list are evaluated from left to right, unlike the arguments of a call
+            std::tuple<Args...> arguments { NativeType<Args>::pull(stack)... };
+            if constexpr (std::is_void_v<R>)
+                std::apply(function, arguments);
+            else
+                NativeType<R>::push(stack, std::apply(function, arguments));
+        }
+
+        /**
+         * Represents the bridge between the virtual machine and a C++ function, that is known at compile time.
+         * @param method called native method
+         * @param stack caller stack
+         */
+        template <auto Function>
+        void bridge(Method* method, Stack* stack) {
+            call(Function, stack);
+        }
+
+        /**
+         * Get the descriptor of a C++ type.
+         * @return type descriptor
+         */
+        template <typename T>
+        String descriptorOf() {
+            if constexpr (std::is_void_v<T>)
+                return "V";
+            else
+                return String(1, NativeType<T>::descriptor);
+        }
+
+        /**
+         * Register the function of a native method. The descriptors of the method are created from the
+         * signature of the function, so that the function cannot be bound to a method with different types.
+         * @param className the name of the declaring class
+         * @param name method name
+         * @param handle the bridge of the function
+         * @param function the implementing C++ function
+         */
+        template <typename R, typename... Args>
+        void define(String className, String name, NativeFunction handle, R (*function)(Args...)) {
+            define(className, name, { descriptorOf<Args>()... }, descriptorOf<R>(), handle);
+        }
+
+        /**
+         * Register a C++ function as the implementation of a native method.
+         * @param className the name of the declaring class
+         * @param name method name
+         */
+        template <auto Function>
+        void define(String className, String name) {
+            define(className, name, &bridge<Function>, Function);
+        }
+    }
+}
@@ -3,6 +3,8 @@
 #include "../../Common.hpp"
 #include "Instance.hpp"
 #include "Reference.hpp"
+#include "Array.hpp"
+#include "Text.hpp"
 
 namespace Void {
     class Executable;
@@ -20,7 +22,9 @@ namespace Void {
         DOUBLE,
         LONG,
         BOOLEAN,
-        INSTANCE
+        INSTANCE,
+        ARRAY,
+        TEXT
     };
     
     /**
@@ -37,7 +41,7 @@ namespace Void {
         /**
          * The next node of the node.
          */
-        StackNode<T>* next;
+        StackNode<T>* next = NULL;
 
         /**
          * Initialize a new node with an initial value.
@@ -45,7 +49,6 @@ namespace Void {
          */
         StackNode(T data) {
             this->data = data;
-            this->next = next;
         }
     };
 
@@ -68,9 +71,30 @@ namespace Void {
         /**
          * The count of elements in the sun-stack.
          */
-        uint count;
+        uint count = 0;
 
     public:
+        /**
+         * Initialize an empty sub-stack.
+         */
+        SubStack() = default;
+
+        /**
+         * The nodes are owned by the sub-stack, therefore it cannot be copied.
+         */
+        SubStack(const SubStack&) = delete;
+
+        /**
+         * Delete the remaining nodes of the sub-stack.
+         */
+        ~SubStack() {
+            while (first != NULL) {
+                StackNode<T>* next = first->next;
+                delete first;
+                first = next;
+            }
+        }
+
         /**
          * Push a value to the end of the sub-stack.
          * @param new sub-stack element
@@ -286,6 +310,16 @@ namespace Void {
          */
         SubStack<Reference<Instance*>*> instances;
 
+        /**
+         * The primitive array value holder sub-stack.
+         */
+        SubStack<Array*> arrays;
+
+        /**
+         * The string value holder sub-stack.
+         */
+        SubStack<Text*> texts;
+
         /**
          * The offset of the current stack that determines
          * how far this stack is from the heap.
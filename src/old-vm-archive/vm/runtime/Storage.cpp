@@ -27,11 +27,17 @@ namespace Void {
                 longs.ensure(capacity);
                 break;
             case StorageUnit::BOOLEAN:
-                doubles.ensure(capacity);
+                booleans.ensure(capacity);
                 break;
             case StorageUnit::INSTANCE:
                 instances.ensure(capacity);
                 break;
+            case StorageUnit::ARRAY:
+                arrays.ensure(capacity);
+                break;
+            case StorageUnit::TEXT:
+                texts.ensure(capacity);
+                break;
         }
     }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "../../Common.hpp"
 #include "Instance.hpp"
+#include "Array.hpp"
+#include "Text.hpp"
 
 namespace Void {
     class Instance;
@@ -17,7 +19,9 @@ namespace Void {
         DOUBLE,
         LONG,
         BOOLEAN,
-        INSTANCE
+        INSTANCE,
+        ARRAY,
+        TEXT
     };
 
     /**
@@ -51,6 +55,18 @@ namespace Void {
         SubStorage() : SubStorage(0)
         { }
 
+        /**
+         * The array is owned by the sub-storage, therefore it cannot be copied.
+         */
+        SubStorage(const SubStorage&) = delete;
+
+        /**
+         * Delete the array of the sub-storage.
+         */
+        ~SubStorage() {
+            delete[] data;
+        }
+
         /**
          * Set a value of the sub-storage at the given index
          * @param index sub-storage index
@@ -189,6 +205,16 @@ namespace Void {
          */
         SubStorage<Reference<Instance*>*> instances;
 
+        /**
+         * The primitive array value holder sub-storage.
+         */
+        SubStorage<Array*> arrays;
+
+        /**
+         * The string value holder sub-storage.
+         */
+        SubStorage<Text*> texts;
+
         /**
          * Ensure the capacity of the storage.
          * @param unit sub-storage type
@@ -0,0 +1,200 @@
+#include "TaskPool.hpp"
+
+namespace Void {
+    /**
+     * The pool of the current thread, if the thread is a worker.
+     */
+    static thread_local TaskPool* currentPool = nullptr;
+
+    /**
+     * The worker index of the current thread in its pool.
+     */
+    static thread_local uint currentWorker = 0;
+
+    /**
+     * Start the worker threads of the pool.
+     * @param workers the count of the worker threads
+     */
+    TaskPool::TaskPool(uint workers) {
+        // the queues are created before the workers start, so that every worker can steal from every queue
+        for (uint i = 0; i < workers; i++)
+            queues.push_back(new WorkQueue());
+        for (uint i = 0; i < workers; i++)
+            threads.emplace_back(&TaskPool::work, this, i);
+    }
+
+    /**
+     * Wait until the queued tasks are run, and stop the worker threads.
+     */
+    TaskPool::~TaskPool() {
+        waitIdle();
+        {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+        for (WorkQueue* queue : queues)
+            delete queue;
+    }
+
+    /**
+     * Queue a task to be run by a worker. A worker queues the task for itself, an other thread
+     * distributes the tasks between the workers.
+     * @param task the task to be run
+     */
+    void TaskPool::submit(Function<void()> task) {
+        uint index = currentPool == this ? currentWorker : next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        // the task is counted before it is queued, so the pool is never idle while a task is being submitted,
+        // and the queue depth never drops below zero, when the task is taken right after it was queued
+        unfinished.fetch_add(1, std::memory_order_relaxed);
+        submitted.fetch_add(1, std::memory_order_relaxed);
+        // the depth is incremented while holding the sleep lock, so an idle worker cannot miss the wakeup
+        {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            uint depth = pending.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (depth > peakPending.load(std::memory_order_relaxed))
+                peakPending.store(depth, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->lock);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        wakeup.notify_one();
+    }
+
+    /**
+     * Run a queued task on the current thread, so that a thread waiting for a task helps the workers.
+     * @return true if a task was run
+     */
+    bool TaskPool::runPending() {
+        Function<void()> task;
+        if (!take(currentPool == this ? currentWorker : (uint) queues.size(), task))
+            return false;
+        run(task);
+        return true;
+    }
+
+    /**
+     * Wait until every submitted task is run, including the tasks that are submitted meanwhile.
+     */
+    void TaskPool::waitIdle() {
+        // the waiting thread runs the queued tasks as well, until only the running tasks are left
+        while (unfinished.load(std::memory_order_acquire) > 0) {
+            if (runPending())
+                continue;
+            std::unique_lock<std::mutex> lock(sleepLock);
+            idle.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+                return unfinished.load(std::memory_order_acquire) == 0 || pending.load(std::memory_order_relaxed) > 0;
+            });
+        }
+    }
+
+    /**
+     * Get the count of the worker threads.
+     * @return worker count
+     */
+    uint TaskPool::size() {
+        return (uint) queues.size();
+    }
+
+    /**
+     * Get the count of the queued tasks, that are waiting to be run.
+     * @return queued task count
+     */
+    uint TaskPool::queueDepth() {
+        return pending.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the metrics of the task pool.
+     * @return pool metrics
+     */
+    TaskPool::Metrics TaskPool::getMetrics() {
+        return Metrics {
+            size(),
+            submitted.load(std::memory_order_relaxed),
+            stolen.load(std::memory_order_relaxed),
+            helped.load(std::memory_order_relaxed),
+            queueDepth(),
+            peakPending.load(std::memory_order_relaxed)
+        };
+    }
+
+    /**
+     * Run the tasks of a worker, until the pool is stopped.
+     * @param index worker index
+     */
+    void TaskPool::work(uint index) {
+        currentPool = this;
+        currentWorker = index;
+        Function<void()> task;
+        while (true) {
+            if (take(index, task)) {
+                run(task);
+                continue;
+            }
+            // sleep until a task is queued, the queues are checked again after waking up,
+            // as an other worker might have taken the task meanwhile
+            std::unique_lock<std::mutex> lock(sleepLock);
+            wakeup.wait(lock, [this]() {
+                return pending.load(std::memory_order_relaxed) > 0 || stopping;
+            });
+            if (stopping && pending.load(std::memory_order_relaxed) == 0)
+                return;
+        }
+    }
+
+    /**
+     * Take a task from the queue of the worker, or steal one from the other workers.
+     * @param index the index of the worker, or the size of the pool for a thread outside the pool
+     * @param task the taken task
+     * @return true if a task was taken
+     */
+    bool TaskPool::take(uint index, Function<void()>& task) {
+        uint count = (uint) queues.size();
+        // the newest task of the worker is taken first, as its data is most likely still in the cache
+        if (index < count) {
+            WorkQueue* queue = queues[index];
+            std::lock_guard<std::mutex> lock(queue->lock);
+            if (!queue->tasks.empty()) {
+                task = std::move(queue->tasks.back());
+                queue->tasks.pop_back();
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // steal the oldest task of the next worker that has one, the workers start looking at different queues
+        for (uint i = 1; i <= count; i++) {
+            uint victim = (index + i) % count;
+            if (victim == index)
+                continue;
+            WorkQueue* queue = queues[victim];
+            std::lock_guard<std::mutex> lock(queue->lock);
+            if (queue->tasks.empty())
+                continue;
+            task = std::move(queue->tasks.front());
+            queue->tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            // the tasks run by a waiting thread are not balanced between the workers, so they are counted apart
+            (index < count ? stolen : helped).fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Run a taken task, and notify the waiting threads if the pool became idle.
+     * @param task the task to be run
+     */
+    void TaskPool::run(Function<void()>& task) {
+        task();
+        task = nullptr;
+        if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    /**
+     * Represents a fixed pool of worker threads, that run short tasks. Every worker has a queue of its own, a task
+     * submitted by a worker is pushed to the queue of that worker, and the worker takes its newest task first.
+     * A worker that has no task steals the oldest task of an other worker, so the tasks do not need a dedicated
+     * thread, and the busy workers are not blocked by a shared queue.
+     */
+    class TaskPool {
+    public:
+        /**
+         * Represents the metrics of the task pool.
+         */
+        struct Metrics {
+            /**
+             * The count of the worker threads.
+             */
+            uint workers;
+
+            /**
+             * The count of the submitted tasks.
+             */
+            uint submitted;
+
+            /**
+             * The count of the tasks, that a worker took from the queue of an other worker.
+             */
+            uint stolen;
+
+            /**
+             * The count of the tasks, that a waiting thread outside the pool took from the queue of a worker.
+             */
+            uint helped;
+
+            /**
+             * The count of the queued tasks, that are waiting to be run.
+             */
+            uint queueDepth;
+
+            /**
+             * The largest count of the queued tasks.
+             */
+            uint peakQueueDepth;
+        };
+
+        /**
+         * Start the worker threads of the pool.
+         * @param workers the count of the worker threads
+         */
+        TaskPool(uint workers);
+
+        /**
+         * Wait until the queued tasks are run, and stop the worker threads.
+         */
+        ~TaskPool();
+
+        /**
+         * Queue a task to be run by a worker. A worker queues the task for itself, an other thread
+         * distributes the tasks between the workers.
+         * @param task the task to be run
+         */
+        void submit(Function<void()> task);
+
+        /**
+         * Run a queued task on the current thread, so that a thread waiting for a task helps the workers.
+         * @return true if a task was run
+         */
+        bool runPending();
+
+        /**
+         * Wait until every submitted task is run, including the tasks that are submitted meanwhile.
+         */
+        void waitIdle();
+
+        /**
+         * Get the count of the worker threads.
+         * @return worker count
+         */
+        uint size();
+
+        /**
+         * Get the count of the queued tasks, that are waiting to be run.
+         * @return queued task count
+         */
+        uint queueDepth();
+
+        /**
+         * Get the metrics of the task pool.
+         * @return pool metrics
+         */
+        Metrics getMetrics();
+
+    private:
+        /**
+         * Represents the task queue of a worker. The worker pushes and takes tasks at the back of the queue,
+         * the other threads steal them from the front of the queue.
+         */
+        struct WorkQueue {
+            /**
+             * The queued tasks.
+             */
+            std::deque<Function<void()>> tasks;
+
+            /**
+             * The lock of the queued tasks.
+             */
+            std::mutex lock;
+        };
+
+        /**
+         * The task queues of the workers.
+         */
+        List<WorkQueue*> queues;
+
+        /**
+         * The worker threads.
+         */
+        List<std::thread> threads;
+
+        /**
+         * The lock, that the idle workers and the threads waiting for the pool to be idle wait with.
+         */
+        std::mutex sleepLock;
+
+        /**
+         * The condition, that wakes up an idle worker when a task is queued.
+         */
+        std::condition_variable wakeup;
+
+        /**
+         * The condition, that is notified when every submitted task has been run.
+         */
+        std::condition_variable idle;
+
+        /**
+         * The count of the queued tasks.
+         */
+        std::atomic<uint> pending = 0;
+
+        /**
+         * The count of the submitted tasks, that have not finished yet.
+         */
+        std::atomic<uint> unfinished = 0;
+
+        /**
+         * The index of the queue, that the next task of a thread outside the pool is pushed to.
+         */
+        std::atomic<uint> next = 0;
+
+        /**
+         * The metric counters of the pool.
+         */
+        std::atomic<uint> submitted = 0;
+        std::atomic<uint> stolen = 0;
+        std::atomic<uint> helped = 0;
+        std::atomic<uint> peakPending = 0;
+
+        /**
+         * Determine if the workers should exit, once the queues are empty.
+         */
+        bool stopping = false;
+
+        /**
+         * Run the tasks of a worker, until the pool is stopped.
+         * @param index worker index
+         */
+        void work(uint index);
+
+        /**
+         * Take a task from the queue of the worker, or steal one from the other workers.
+         * @param index the index of the worker, or the size of the pool for a thread outside the pool
+         * @param task the taken task
+         * @return true if a task was taken
+         */
+        bool take(uint index, Function<void()>& task);
+
+        /**
+         * Run a taken task, and notify the waiting threads if the pool became idle.
+         * @param task the task to be run
+         */
+        void run(Function<void()>& task);
+    };
+}
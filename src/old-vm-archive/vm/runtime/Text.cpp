@@ -0,0 +1,381 @@
+#include "Text.hpp"
+
+#include <new>
+#include <cstring>
+#include <charconv>
+
+namespace Void {
+    /**
+     * The precision of the formatted floating point numbers, the default precision of the output streams.
+     */
+    static const int FLOATING_PRECISION = 6;
+
+    /**
+     * The longest formatted number.
+     */
+    static const uint NUMBER_SIZE = 32;
+
+    /**
+     * The parameters of the FNV-1a hash function.
+     */
+    static const uint HASH_BASIS = 2166136261u;
+    static const uint HASH_PRIME = 16777619u;
+
+    /**
+     * The constant pool of the interned strings.
+     */
+    static std::unordered_set<Text*, TextHash, TextEquals> pool;
+
+    /**
+     * The lock of the constant pool, as the bytecode may be loaded while other threads are running.
+     */
+    static std::mutex poolLock;
+
+    /**
+     * Initialize the header of the string.
+     * @param length byte count
+     * @param kind string representation
+     */
+    Text::Text(uint length, Kind kind)
+        : length(length), kind(kind)
+    { }
+
+    /**
+     * Create a new string from UTF-8 bytes.
+     * @param data string bytes
+     * @param length byte count
+     * @return new string
+     */
+    Text* Text::of(const char* data, uint length) {
+        Text* text;
+        if (length <= INLINE_CAPACITY) {
+            text = new Text(length, Kind::INLINE);
+            memcpy(text->chars, data, length);
+            text->chars[length] = '\0';
+        }
+        else {
+            text = new Text(length, Kind::FLAT);
+            text->buffer = new char[length + 1];
+            memcpy(text->buffer, data, length);
+            text->buffer[length] = '\0';
+        }
+        return text;
+    }
+
+    /**
+     * Create a new string from UTF-8 bytes.
+     * @param value string bytes
+     * @return new string
+     */
+    Text* Text::of(const String& value) {
+        return of(value.data(), (uint) value.size());
+    }
+
+    /**
+     * Get the interned string of the given value. The literals of the bytecode are interned when they are
+     * parsed, therefore the equal literals are the same string, and they can be compared by their address.
+     * @param value string bytes
+     * @return interned string
+     */
+    Text* Text::intern(const String& value) {
+        Text* text = of(value);
+        // the hash code is computed before the string is published, so that it is never written again
+        text->hashCode();
+        std::lock_guard<std::mutex> lock(poolLock);
+        auto found = pool.find(text);
+        if (found != pool.end()) {
+            release(text);
+            return *found;
+        }
+        text->interned = true;
+        pool.insert(text);
+        return text;
+    }
+
+    /**
+     * Concatenate two strings. The parts are not modified, the result holds its own references to them.
+     * @param left first part
+     * @param right second part
+     * @return new string
+     */
+    Text* Text::concat(Text* left, Text* right) {
+        if (left->length == 0)
+            return right->retain();
+        if (right->length == 0)
+            return left->retain();
+
+        // short results are copied, so that the ropes do not consist of many tiny parts
+        uint length = left->length + right->length;
+        if (length <= FLAT_LIMIT) {
+            TextBuilder builder(length);
+            return builder.append(left).append(right).build();
+        }
+
+        // appending to a rope, that ends with a short part, replaces that part with a longer one
+        if (left->kind == Kind::ROPE && left->parts.right->kind != Kind::ROPE
+            && left->parts.right->length + right->length <= FLAT_LIMIT)
+            return join(left->parts.left->retain(), concat(left->parts.right, right));
+
+        Text* rope = join(left->retain(), right->retain());
+        if (rope->depth <= MAX_DEPTH)
+            return rope;
+
+        // the repeated appends created a deep rope, rebuild it with the same parts
+        List<Text*> leaves;
+        rope->collect(leaves);
+        Text* balanced = balance(leaves, 0, (uint) leaves.size());
+        release(rope);
+        return balanced;
+    }
+
+    /**
+     * Release a reference to a string, and delete it if it was the last one.
+     * @param text released string, ignored if it is nullptr or interned
+     */
+    void Text::release(Text* text) {
+        if (text == nullptr || text->interned || text->references.fetch_sub(1, std::memory_order_acq_rel) > 1)
+            return;
+        if (text->kind == Kind::FLAT)
+            delete[] text->buffer;
+        else if (text->kind == Kind::ROPE) {
+            release(text->parts.left);
+            release(text->parts.right);
+        }
+        delete text;
+    }
+
+    /**
+     * Add a reference to the string.
+     * @return this string
+     */
+    Text* Text::retain() {
+        // the interned strings are shared by every thread, and they are never deleted
+        if (!interned)
+            references.fetch_add(1, std::memory_order_relaxed);
+        return this;
+    }
+
+    /**
+     * Get the bytes of the string. A rope is copied to a single buffer by the first call.
+     * @return null-terminated UTF-8 bytes
+     */
+    const char* Text::data() {
+        if (kind == Kind::INLINE)
+            return chars;
+        if (kind == Kind::ROPE)
+            flatten();
+        return buffer;
+    }
+
+    /**
+     * Get a view of the bytes of the string.
+     * @return string bytes
+     */
+    std::string_view Text::view() {
+        return std::string_view(data(), length);
+    }
+
+    /**
+     * Get a copy of the bytes of the string.
+     * @return string bytes
+     */
+    String Text::value() {
+        return String(data(), length);
+    }
+
+    /**
+     * Count the unicode code points of the string.
+     * @return code point count
+     */
+    uint Text::countCodePoints() {
+        // every code point has exactly one byte, that is not a continuation byte of the form 10xxxxxx
+        const char* bytes = data();
+        uint count = 0;
+        for (uint i = 0; i < length; i++)
+            count += (bytes[i] & 0xC0) != 0x80;
+        return count;
+    }
+
+    /**
+     * Get the hash code of the string, that is computed by the first call. A rope is hashed without copying it.
+     * @return string hash
+     */
+    uint Text::hashCode() {
+        if (hashed)
+            return hash;
+
+        List<Text*> leaves;
+        collect(leaves);
+        uint result = HASH_BASIS;
+        for (Text* leaf : leaves) {
+            const char* bytes = leaf->data();
+            for (uint i = 0; i < leaf->length; i++)
+                result = (result ^ (byte) bytes[i]) * HASH_PRIME;
+        }
+
+        hash = result;
+        hashed = true;
+        return hash;
+    }
+
+    /**
+     * Determine if the string has the same bytes as another string.
+     * @param other compared string
+     * @return true if the strings are equal
+     */
+    bool Text::equals(Text* other) {
+        if (this == other)
+            return true;
+        // two different interned strings are never equal
+        if (length != other->length || (interned && other->interned))
+            return false;
+        if (hashed && other->hashed && hash != other->hash)
+            return false;
+        return memcmp(data(), other->data(), length) == 0;
+    }
+
+    /**
+     * Determine if the string is interned.
+     * @return true if the string is never deleted
+     */
+    bool Text::isInterned() {
+        return interned;
+    }
+
+    /**
+     * Create a rope node, that takes over the given references to its parts.
+     * @param left first part
+     * @param right second part
+     * @return new rope
+     */
+    Text* Text::join(Text* left, Text* right) {
+        Text* rope = new Text(left->length + right->length, Kind::ROPE);
+        rope->parts.left = left;
+        rope->parts.right = right;
+        rope->depth = (byte) (getMax(left->depth, right->depth) + 1);
+        return rope;
+    }
+
+    /**
+     * Create a balanced rope of a range of parts, that holds its own references to them.
+     * @param leaves flat parts of the rope
+     * @param begin the index of the first part
+     * @param end the index after the last part
+     * @return balanced rope
+     */
+    Text* Text::balance(List<Text*>& leaves, uint begin, uint end) {
+        if (end - begin == 1)
+            return leaves[begin]->retain();
+        uint middle = begin + (end - begin) / 2;
+        return join(balance(leaves, begin, middle), balance(leaves, middle, end));
+    }
+
+    /**
+     * Collect the flat parts of the string, in the order of their bytes.
+     * @param leaves the list to append the parts to
+     */
+    void Text::collect(List<Text*>& leaves) {
+        if (kind != Kind::ROPE) {
+            leaves.push_back(this);
+            return;
+        }
+        parts.left->collect(leaves);
+        parts.right->collect(leaves);
+    }
+
+    /**
+     * Copy the bytes of a rope to a single buffer, and release its parts.
+     */
+    void Text::flatten() {
+        List<Text*> leaves;
+        collect(leaves);
+        char* bytes = new char[length + 1];
+        uint offset = 0;
+        for (Text* leaf : leaves) {
+            memcpy(bytes + offset, leaf->data(), leaf->length);
+            offset += leaf->length;
+        }
+        bytes[length] = '\0';
+
+        release(parts.left);
+        release(parts.right);
+        kind = Kind::FLAT;
+        depth = 0;
+        buffer = bytes;
+    }
+
+    /**
+     * Initialize the string builder.
+     * @param capacity expected byte count
+     */
+    TextBuilder::TextBuilder(uint capacity) {
+        buffer.reserve(capacity);
+    }
+
+    /**
+     * Append UTF-8 bytes to the string.
+     * @param data appended bytes
+     * @param length byte count
+     */
+    TextBuilder& TextBuilder::append(const char* data, uint length) {
+        buffer.append(data, length);
+        return *this;
+    }
+
+    /**
+     * Append the bytes of a string.
+     * @param text appended string
+     */
+    TextBuilder& TextBuilder::append(Text* text) {
+        buffer.append(text->data(), text->length);
+        return *this;
+    }
+
+    /**
+     * Append the decimal representation of an integer.
+     * @param value appended integer
+     */
+    TextBuilder& TextBuilder::append(int value) {
+        char number[NUMBER_SIZE];
+        std::to_chars_result result = std::to_chars(number, number + NUMBER_SIZE, value);
+        return append(number, (uint) (result.ptr - number));
+    }
+
+    /**
+     * Append the decimal representation of a long.
+     * @param value appended long
+     */
+    TextBuilder& TextBuilder::append(lint value) {
+        char number[NUMBER_SIZE];
+        std::to_chars_result result = std::to_chars(number, number + NUMBER_SIZE, value);
+        return append(number, (uint) (result.ptr - number));
+    }
+
+    /**
+     * Append the representation of a float, formatted the same way as an output stream does.
+     * @param value appended float
+     */
+    TextBuilder& TextBuilder::append(float value) {
+        char number[NUMBER_SIZE];
+        std::to_chars_result result = std::to_chars(number, number + NUMBER_SIZE, value, std::chars_format::general, FLOATING_PRECISION);
+        return append(number, (uint) (result.ptr - number));
+    }
+
+    /**
+     * Append the representation of a double, formatted the same way as an output stream does.
+     * @param value appended double
+     */
+    TextBuilder& TextBuilder::append(double value) {
+        char number[NUMBER_SIZE];
+        std::to_chars_result result = std::to_chars(number, number + NUMBER_SIZE, value, std::chars_format::general, FLOATING_PRECISION);
+        return append(number, (uint) (result.ptr - number));
+    }
+
+    /**
+     * Create a new string of the appended bytes.
+     * @return new string
+     */
+    Text* TextBuilder::build() {
+        return Text::of(buffer);
+    }
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+#include <string_view>
+
+namespace Void {
+    /**
+     * Represents an immutable UTF-8 string of the virtual machine. Short strings are stored inside the header,
+     * longer ones in a separate buffer. A concatenation of long strings is a rope, a node that refers to its two
+     * parts, and it is copied to a single buffer only when its bytes are needed. The hash code is computed once
+     * and cached, so the strings may be used as map keys and switch keys cheaply.
+     *
+     * A string is owned by reference counting. A new string has one reference, a rope retains its parts,
+     * and the interned strings are never deleted. The references may be counted by multiple threads, however
+     * a rope is flattened in place, so a string that is not interned must not be read by multiple threads.
+     */
+    class Text {
+    public:
+        /**
+         * The count of the bytes that are stored inside the header, without a separate allocation.
+         */
+        static const uint INLINE_CAPACITY = 23;
+
+        /**
+         * The length of the longest concatenation, that is copied to a single buffer instead of creating a rope.
+         */
+        static const uint FLAT_LIMIT = 256;
+
+        /**
+         * The depth of the deepest rope, before its parts are rebalanced.
+         */
+        static const uint MAX_DEPTH = 32;
+
+        /**
+         * The count of the UTF-8 bytes of the string.
+         */
+        const uint length;
+
+        /**
+         * Create a new string from UTF-8 bytes.
+         * @param data string bytes
+         * @param length byte count
+         * @return new string
+         */
+        static Text* of(const char* data, uint length);
+
+        /**
+         * Create a new string from UTF-8 bytes.
+         * @param value string bytes
+         * @return new string
+         */
+        static Text* of(const String& value);
+
+        /**
+         * Get the interned string of the given value. The literals of the bytecode are interned when they are
+         * parsed, therefore the equal literals are the same string, and they can be compared by their address.
+         * @param value string bytes
+         * @return interned string
+         */
+        static Text* intern(const String& value);
+
+        /**
+         * Concatenate two strings. The parts are not modified, the result holds its own references to them.
+         * @param left first part
+         * @param right second part
+         * @return new string
+         */
+        static Text* concat(Text* left, Text* right);
+
+        /**
+         * Release a reference to a string, and delete it if it was the last one.
+         * @param text released string, ignored if it is nullptr or interned
+         */
+        static void release(Text* text);
+
+        /**
+         * Add a reference to the string.
+         * @return this string
+         */
+        Text* retain();
+
+        /**
+         * Get the bytes of the string. A rope is copied to a single buffer by the first call.
+         * @return null-terminated UTF-8 bytes
+         */
+        const char* data();
+
+        /**
+         * Get a view of the bytes of the string.
+         * @return string bytes
+         */
+        std::string_view view();
+
+        /**
+         * Get a copy of the bytes of the string.
+         * @return string bytes
+         */
+        String value();
+
+        /**
+         * Count the unicode code points of the string.
+         * @return code point count
+         */
+        uint countCodePoints();
+
+        /**
+         * Get the hash code of the string, that is computed by the first call. A rope is hashed without copying it.
+         * @return string hash
+         */
+        uint hashCode();
+
+        /**
+         * Determine if the string has the same bytes as another string.
+         * @param other compared string
+         * @return true if the strings are equal
+         */
+        bool equals(Text* other);
+
+        /**
+         * Determine if the string is interned.
+         * @return true if the string is never deleted
+         */
+        bool isInterned();
+
+    private:
+        /**
+         * Represents a registry of the string representations.
+         */
+        enum class Kind : byte {
+            INLINE, // the bytes are stored in the header
+            FLAT,   // the bytes are stored in a separate buffer
+            ROPE    // the bytes are stored by the two parts
+        };
+
+        /**
+         * The representation of the string.
+         */
+        Kind kind;
+
+        /**
+         * The count of the rope nodes on the longest path to a part of the string.
+         */
+        byte depth = 0;
+
+        /**
+         * Determine if the string is interned.
+         */
+        bool interned = false;
+
+        /**
+         * Determine if the hash code has been computed.
+         */
+        bool hashed = false;
+
+        /**
+         * The count of the references to the string.
+         */
+        std::atomic<uint> references = 1;
+
+        /**
+         * The cached hash code of the string.
+         */
+        uint hash = 0;
+
+        union {
+            /**
+             * The bytes of a short string.
+             */
+            char chars[INLINE_CAPACITY + 1];
+
+            /**
+             * The bytes of a long string.
+             */
+            char* buffer;
+
+            /**
+             * The parts of a rope.
+             */
+            struct {
+                Text* left;
+                Text* right;
+            } parts;
+        };
+
+        /**
+         * Initialize the header of the string.
+         * @param length byte count
+         * @param kind string representation
+         */
+        Text(uint length, Kind kind);
+
+        /**
+         * Create a rope node, that takes over the given references to its parts.
+         * @param left first part
+         * @param right second part
+         * @return new rope
+         */
+        static Text* join(Text* left, Text* right);
+
+        /**
+         * Create a balanced rope of a range of parts, that holds its own references to them.
+         * @param leaves flat parts of the rope
+         * @param begin the index of the first part
+         * @param end the index after the last part
+         * @return balanced rope
+         */
+        static Text* balance(List<Text*>& leaves, uint begin, uint end);
+
+        /**
+         * Collect the flat parts of the string, in the order of their bytes.
+         * @param leaves the list to append the parts to
+         */
+        void collect(List<Text*>& leaves);
+
+        /**
+         * Copy the bytes of a rope to a single buffer, and release its parts.
+         */
+        void flatten();
+    };
+
+    /**
+     * Represents the hash function of the string map keys, that uses the cached hash code.
+     */
+    struct TextHash {
+        size_t operator()(Text* text) const {
+            return text->hashCode();
+        }
+    };
+
+    /**
+     * Represents the equality function of the string map keys, that compares the bytes of the strings.
+     */
+    struct TextEquals {
+        bool operator()(Text* first, Text* second) const {
+            return first->equals(second);
+        }
+    };
+
+    /**
+     * Represents a map, whose keys are strings.
+     */
+    template <typename V>
+    using TextMap = std::unordered_map<Text*, V, TextHash, TextEquals>;
+
+    /**
+     * Represents a builder of a string from many parts, that are appended to a single growing buffer.
+     */
+    class TextBuilder {
+    private:
+        /**
+         * The bytes of the string.
+         */
+        String buffer;
+
+    public:
+        /**
+         * Initialize the string builder.
+         * @param capacity expected byte count
+         */
+        TextBuilder(uint capacity = 0);
+
+        /**
+         * Append UTF-8 bytes to the string.
+         * @param data appended bytes
+         * @param length byte count
+         */
+        TextBuilder& append(const char* data, uint length);
+
+        /**
+         * Append the bytes of a string.
+         * @param text appended string
+         */
+        TextBuilder& append(Text* text);
+
+        /**
+         * Append the decimal representation of an integer.
+         * @param value appended integer
+         */
+        TextBuilder& append(int value);
+
+        /**
+         * Append the decimal representation of a long.
+         * @param value appended long
+         */
+        TextBuilder& append(lint value);
+
+        /**
+         * Append the representation of a float, formatted the same way as an output stream does.
+         * @param value appended float
+         */
+        TextBuilder& append(float value);
+
+        /**
+         * Append the representation of a double, formatted the same way as an output stream does.
+         * @param value appended double
+         */
+        TextBuilder& append(double value);
+
+        /**
+         * Create a new string of the appended bytes.
+         * @return new string
+         */
+        Text* build();
+    };
+}
@@ -0,0 +1,107 @@
+// the method header has to be included first, as it is only defined after the executable
+#include "../element/Method.hpp"
+#include "Thread.hpp"
+#include "Fiber.hpp"
+#include "Text.hpp"
+
+namespace Void {
+    /**
+     * Start executing the method on a new thread.
+     * @param id thread identifier
+     * @param method executed static method
+     * @param heap root stack, that holds the arguments of the method
+     */
+    Thread::Thread(uint id, Method* method, Stack* heap)
+        : id(id), method(method), heap(heap) {
+        // the output of the thread is flushed by its console buffer, when the thread exits
+        thread = std::thread([this]() {
+            // the error of a failed thread is reported to its joiners, the other threads are not affected
+            Fiber fiber(false);
+            this->method->call(&fiber, this->heap, nullptr);
+            fiber.run();
+            if (fiber.hasFailed()) {
+                failure = fiber.getError();
+                warn("Uncaught error in thread " << this->id << ": " << failure);
+            }
+        });
+    }
+
+    /**
+     * Wait until the method returns. The thread may be joined by more threads, or multiple times.
+     */
+    void Thread::join() {
+        // the other joiners wait until the first one returns
+        std::call_once(joined, [this]() {
+            thread.join();
+        });
+    }
+
+    /**
+     * Move the result of the method to a stack. The result can be taken only once, after the thread was joined.
+     * The joiner fails, if the method has failed, or if the result has already been taken.
+     * @param joiner the fiber, that joined the thread
+     * @param stack the stack to push the result to
+     */
+    void Thread::collect(Fiber* joiner, Stack* stack) {
+        if (!failure.empty()) {
+            joiner->fail("ThreadExecutionError: Thread " + toString(id) + " has failed: " + failure);
+            return;
+        }
+        char prefix = method->returnType[0];
+        if (prefix == 'V')
+            return;
+        if (collected.exchange(true)) {
+            joiner->fail("IllegalThreadStateException: The result of thread " + toString(id) + " has already been taken");
+            return;
+        }
+        transfer(prefix, heap, stack);
+    }
+
+    /**
+     * Move a value from a stack to an other stack.
+     * @param prefix the type descriptor of the value
+     * @param from source stack
+     * @param to target stack
+     * @param keep true if the value should be copied, and kept on the source stack
+     */
+    void Thread::transfer(char prefix, Stack* from, Stack* to, bool keep) {
+        switch (prefix) {
+            case 'B':
+                to->bytes.push(from->bytes.pull(keep));
+                break;
+            case 'C':
+                to->chars.push(from->chars.pull(keep));
+                break;
+            case 'S':
+                to->shorts.push(from->shorts.pull(keep));
+                break;
+            case 'I':
+                to->ints.push(from->ints.pull(keep));
+                break;
+            case 'J':
+                to->longs.push(from->longs.pull(keep));
+                break;
+            case 'F':
+                to->floats.push(from->floats.pull(keep));
+                break;
+            case 'D':
+                to->doubles.push(from->doubles.pull(keep));
+                break;
+            case 'Z':
+                to->booleans.push(from->booleans.pull(keep));
+                break;
+            case 'L':
+                to->instances.push(from->instances.pull(keep));
+                break;
+            case '[':
+                to->arrays.push(from->arrays.pull(keep));
+                break;
+            case 'T': {
+                // the copied string holds a reference of its own
+                Text* text = from->texts.pull(keep);
+                to->texts.push(keep && text != nullptr ? text->retain() : text);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../../Common.hpp"
+
+namespace Void {
+    class Method;
+    class Stack;
+    class Fiber;
+
+    /**
+     * Represents a thread of the virtual machine, that runs a static method. Every thread has its own stacks and
+     * frames, and the threads share the loaded classes, whose metadata is not modified after they are built.
+     */
+    class Thread {
+    public:
+        /**
+         * The identifier of the thread, its index in the thread table of the virtual machine.
+         */
+        const uint id;
+
+        /**
+         * The method executed by the thread.
+         */
+        Method* const method;
+
+        /**
+         * The root stack of the thread, that holds the arguments of the method, and its result after it returned.
+         */
+        Stack* const heap;
+
+        /**
+         * Start executing the method on a new thread.
+         * @param id thread identifier
+         * @param method executed static method
+         * @param heap root stack, that holds the arguments of the method
+         */
+        Thread(uint id, Method* method, Stack* heap);
+
+        /**
+         * Wait until the method returns. The thread may be joined by more threads, or multiple times.
+         */
+        void join();
+
+        /**
+         * Move the result of the method to a stack. The result can be taken only once, after the thread was joined.
+         * The joiner fails, if the method has failed, or if the result has already been taken.
+         * @param joiner the fiber, that joined the thread
+         * @param stack the stack to push the result to
+         */
+        void collect(Fiber* joiner, Stack* stack);
+
+        /**
+         * Move a value from a stack to an other stack.
+         * @param prefix the type descriptor of the value
+         * @param from source stack
+         * @param to target stack
+         * @param keep true if the value should be copied, and kept on the source stack
+         */
+        static void transfer(char prefix, Stack* from, Stack* to, bool keep = false);
+
+    private:
+        /**
+         * The system thread, that executes the method.
+         */
+        std::thread thread;
+
+        /**
+         * Determine if the system thread has been joined.
+         */
+        std::once_flag joined;
+
+        /**
+         * The error message of the method, if it has failed. It is written before the system thread exits,
+         * therefore it is visible to the joiners.
+         */
+        String failure;
+
+        /**
+         * Determine if the result of the method has been taken.
+         */
+        std::atomic<bool> collected = false;
+    };
+}
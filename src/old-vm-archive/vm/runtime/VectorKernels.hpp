@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Vectors.hpp"
+
+namespace Void {
+    namespace Vectors {
+        /**
+         * Represents the numeric kernels, that are written once for every instruction set. The instruction set is
+         * described by a type, that defines its vector register and the operations on it. The elements that do not
+         * fill a whole vector at the end of the arrays are processed one by one. This header is included by the
+         * translation unit of each instruction set, so that the kernels are compiled for that instruction set.
+         */
+        template <typename Set>
+        struct KernelsOf {
+            typedef typename Set::Element T;
+            typedef typename Set::Vector V;
+
+            static void add(const T* first, const T* second, T* result, uint length) {
+                uint i = 0;
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    Set::store(result + i, Set::add(Set::load(first + i), Set::load(second + i)));
+                for (; i < length; i++)
+                    result[i] = first[i] + second[i];
+            }
+
+            static void multiply(const T* first, const T* second, T* result, uint length) {
+                uint i = 0;
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    Set::store(result + i, Set::multiply(Set::load(first + i), Set::load(second + i)));
+                for (; i < length; i++)
+                    result[i] = first[i] * second[i];
+            }
+
+            static void minimum(const T* first, const T* second, T* result, uint length) {
+                uint i = 0;
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    Set::store(result + i, Set::minimum(Set::load(first + i), Set::load(second + i)));
+                // the same operand is selected as by the vector instruction, if any of them is not a number
+                for (; i < length; i++)
+                    result[i] = first[i] < second[i] ? first[i] : second[i];
+            }
+
+            static void maximum(const T* first, const T* second, T* result, uint length) {
+                uint i = 0;
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    Set::store(result + i, Set::maximum(Set::load(first + i), Set::load(second + i)));
+                for (; i < length; i++)
+                    result[i] = first[i] > second[i] ? first[i] : second[i];
+            }
+
+            static void multiplyAdd(const T* first, T scalar, const T* second, T* result, uint length) {
+                V factor = Set::broadcast(scalar);
+                uint i = 0;
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    Set::store(result + i, Set::multiplyAdd(Set::load(first + i), factor, Set::load(second + i)));
+                for (; i < length; i++)
+                    result[i] = first[i] * scalar + second[i];
+            }
+
+            static T sum(const T* values, uint length) {
+                // four independent sums hide the latency of the additions
+                V a = Set::zero(), b = Set::zero(), c = Set::zero(), d = Set::zero();
+                uint i = 0;
+                for (; i + 4 * Set::WIDTH <= length; i += 4 * Set::WIDTH) {
+                    a = Set::add(a, Set::load(values + i));
+                    b = Set::add(b, Set::load(values + i + Set::WIDTH));
+                    c = Set::add(c, Set::load(values + i + 2 * Set::WIDTH));
+                    d = Set::add(d, Set::load(values + i + 3 * Set::WIDTH));
+                }
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    a = Set::add(a, Set::load(values + i));
+                T result = Set::reduce(Set::add(Set::add(a, b), Set::add(c, d)));
+                for (; i < length; i++)
+                    result += values[i];
+                return result;
+            }
+
+            static T dot(const T* first, const T* second, uint length) {
+                V a = Set::zero(), b = Set::zero(), c = Set::zero(), d = Set::zero();
+                uint i = 0;
+                for (; i + 4 * Set::WIDTH <= length; i += 4 * Set::WIDTH) {
+                    a = Set::multiplyAdd(Set::load(first + i), Set::load(second + i), a);
+                    b = Set::multiplyAdd(Set::load(first + i + Set::WIDTH), Set::load(second + i + Set::WIDTH), b);
+                    c = Set::multiplyAdd(Set::load(first + i + 2 * Set::WIDTH), Set::load(second + i + 2 * Set::WIDTH), c);
+                    d = Set::multiplyAdd(Set::load(first + i + 3 * Set::WIDTH), Set::load(second + i + 3 * Set::WIDTH), d);
+                }
+                for (; i + Set::WIDTH <= length; i += Set::WIDTH)
+                    a = Set::multiplyAdd(Set::load(first + i), Set::load(second + i), a);
+                T result = Set::reduce(Set::add(Set::add(a, b), Set::add(c, d)));
+                for (; i < length; i++)
+                    result += first[i] * second[i];
+                return result;
+            }
+
+            /**
+             * Fill a kernel table with the kernels of the instruction set.
+             * @param kernels target kernel table
+             */
+            static void load(Kernels<T>& kernels) {
+                kernels.add = add;
+                kernels.multiply = multiply;
+                kernels.minimum = minimum;
+                kernels.maximum = maximum;
+                kernels.multiplyAdd = multiplyAdd;
+                kernels.sum = sum;
+                kernels.dot = dot;
+            }
+        };
+    }
+}
@@ -0,0 +1,247 @@
+#include "VectorKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VOID_X86
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOID_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Void {
+    namespace Vectors {
+        /**
+         * Represents the instruction set, that processes one element at a time.
+         */
+        template <typename T>
+        struct Scalar {
+            typedef T Element;
+            typedef T Vector;
+            static const uint WIDTH = 1;
+            static Vector load(const T* data) { return *data; }
+            static void store(T* data, Vector value) { *data = value; }
+            static Vector add(Vector a, Vector b) { return a + b; }
+            static Vector multiply(Vector a, Vector b) { return a * b; }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return a * b + c; }
+            static Vector minimum(Vector a, Vector b) { return a < b ? a : b; }
+            static Vector maximum(Vector a, Vector b) { return a > b ? a : b; }
+            static Vector broadcast(T value) { return value; }
+            static Vector zero() { return 0; }
+            static T reduce(Vector value) { return value; }
+        };
+
+#ifdef VOID_SSE2
+        /**
+         * Represents the SSE2 instruction set, that processes four floats at a time.
+         */
+        struct Sse2Float {
+            typedef float Element;
+            typedef __m128 Vector;
+            static const uint WIDTH = 4;
+            static Vector load(const float* data) { return _mm_loadu_ps(data); }
+            static void store(float* data, Vector value) { _mm_storeu_ps(data, value); }
+            static Vector add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+            static Vector multiply(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            static Vector minimum(Vector a, Vector b) { return _mm_min_ps(a, b); }
+            static Vector maximum(Vector a, Vector b) { return _mm_max_ps(a, b); }
+            static Vector broadcast(float value) { return _mm_set1_ps(value); }
+            static Vector zero() { return _mm_setzero_ps(); }
+            static float reduce(Vector value) {
+                // add the upper half to the lower half, then the second element to the first one
+                value = _mm_add_ps(value, _mm_movehl_ps(value, value));
+                value = _mm_add_ss(value, _mm_shuffle_ps(value, value, 1));
+                return _mm_cvtss_f32(value);
+            }
+        };
+
+        /**
+         * Represents the SSE2 instruction set, that processes two doubles at a time.
+         */
+        struct Sse2Double {
+            typedef double Element;
+            typedef __m128d Vector;
+            static const uint WIDTH = 2;
+            static Vector load(const double* data) { return _mm_loadu_pd(data); }
+            static void store(double* data, Vector value) { _mm_storeu_pd(data, value); }
+            static Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+            static Vector multiply(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+            static Vector minimum(Vector a, Vector b) { return _mm_min_pd(a, b); }
+            static Vector maximum(Vector a, Vector b) { return _mm_max_pd(a, b); }
+            static Vector broadcast(double value) { return _mm_set1_pd(value); }
+            static Vector zero() { return _mm_setzero_pd(); }
+            static double reduce(Vector value) {
+                return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+            }
+        };
+#endif
+
+        /**
+         * The float kernels of the selected instruction set.
+         */
+        static Kernels<float> floats;
+
+        /**
+         * The double kernels of the selected instruction set.
+         */
+        static Kernels<double> doubles;
+
+        /**
+         * The selected instruction set.
+         */
+        static InstructionSet selected = InstructionSet::SCALAR;
+
+        /**
+         * Determine if the processor and the operating system support the AVX2 and FMA extensions.
+         * @return true if the 256-bit registers may be used
+         */
+        static bool supportsAvx2() {
+#if defined(VOID_X86) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+            // the operating system must save the upper half of the registers as well
+            __cpuid(info, 1);
+            bool fma = info[2] & (1 << 12);
+            bool osxsave = info[2] & (1 << 27);
+            bool avx = info[2] & (1 << 28);
+            if (!fma || !osxsave || !avx || (_xgetbv(0) & 6) != 6)
+                return false;
+            __cpuidex(info, 7, 0);
+            return info[1] & (1 << 5);
+#elif defined(VOID_X86) && defined(__GNUC__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * Select the kernels of the widest instruction set that the processor supports.
+         * The "-XVectorISA" option limits the selection to the given instruction set.
+         * @param options command line options
+         */
+        void initialize(Options& options) {
+            InstructionSet set = detect();
+            if (options.has("XVectorISA")) {
+                String name = options.get("XVectorISA");
+                InstructionSet limit;
+                if (name == "scalar")
+                    limit = InstructionSet::SCALAR;
+                else if (name == "sse2")
+                    limit = InstructionSet::SSE2;
+                else if (name == "avx2")
+                    limit = InstructionSet::AVX2;
+                else
+                    error("Invalid vector instruction set '" << name << "'. Available instruction sets: scalar, sse2, avx2");
+                set = static_cast<InstructionSet>(getMin(static_cast<int>(set), static_cast<int>(limit)));
+            }
+            select(set);
+        }
+
+        /**
+         * Detect the widest instruction set, that the processor and the build of the virtual machine support.
+         * @return supported instruction set
+         */
+        InstructionSet detect() {
+#ifdef VOID_SSE2
+            return supportsAvx2() ? InstructionSet::AVX2 : InstructionSet::SSE2;
+#else
+            return InstructionSet::SCALAR;
+#endif
+        }
+
+        /**
+         * Select the kernels of the given instruction set.
+         * @param set selected instruction set, that must be supported by the processor
+         */
+        void select(InstructionSet set) {
+            switch (set) {
+                case InstructionSet::SCALAR:
+                    loadScalar(floats, doubles);
+                    break;
+                case InstructionSet::SSE2:
+                    loadSse2(floats, doubles);
+                    break;
+                case InstructionSet::AVX2:
+                    loadAvx2(floats, doubles);
+                    break;
+            }
+            selected = set;
+        }
+
+        /**
+         * Get the instruction set of the selected kernels.
+         * @return selected instruction set
+         */
+        InstructionSet getSelected() {
+            return selected;
+        }
+
+        /**
+         * Get the name of an instruction set.
+         * @param set target instruction set
+         * @return instruction set name
+         */
+        String getName(InstructionSet set) {
+            switch (set) {
+                case InstructionSet::SSE2:
+                    return "sse2";
+                case InstructionSet::AVX2:
+                    return "avx2";
+                default:
+                    return "scalar";
+            }
+        }
+
+        /**
+         * Get the selected float kernels.
+         * @return kernel table
+         */
+        template <>
+        const Kernels<float>& get<float>() {
+            return floats;
+        }
+
+        /**
+         * Get the selected double kernels.
+         * @return kernel table
+         */
+        template <>
+        const Kernels<double>& get<double>() {
+            return doubles;
+        }
+
+        /**
+         * Fill the kernel tables with the kernels, that process one element at a time.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadScalar(Kernels<float>& floats, Kernels<double>& doubles) {
+            KernelsOf<Scalar<float>>::load(floats);
+            KernelsOf<Scalar<double>>::load(doubles);
+        }
+
+        /**
+         * Fill the kernel tables with the SSE2 kernels.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadSse2(Kernels<float>& floats, Kernels<double>& doubles) {
+#ifdef VOID_SSE2
+            KernelsOf<Sse2Float>::load(floats);
+            KernelsOf<Sse2Double>::load(doubles);
+#else
+            loadScalar(floats, doubles);
+#endif
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../../Common.hpp"
+#include "../../util/Options.hpp"
+
+namespace Void {
+    /**
+     * Represents the table of the numeric kernels of an element type, that are compiled for an instruction set.
+     */
+    template <typename T>
+    struct Kernels {
+        /**
+         * Add the elements of two arrays.
+         */
+        void (*add)(const T* first, const T* second, T* result, uint length);
+
+        /**
+         * Multiply the elements of two arrays.
+         */
+        void (*multiply)(const T* first, const T* second, T* result, uint length);
+
+        /**
+         * Select the smaller of the elements of two arrays.
+         */
+        void (*minimum)(const T* first, const T* second, T* result, uint length);
+
+        /**
+         * Select the greater of the elements of two arrays.
+         */
+        void (*maximum)(const T* first, const T* second, T* result, uint length);
+
+        /**
+         * Multiply the elements of an array by a scalar, and add the elements of another array.
+         */
+        void (*multiplyAdd)(const T* first, T scalar, const T* second, T* result, uint length);
+
+        /**
+         * Add the elements of an array together.
+         */
+        T (*sum)(const T* values, uint length);
+
+        /**
+         * Add the products of the elements of two arrays together.
+         */
+        T (*dot)(const T* first, const T* second, uint length);
+    };
+
+    /**
+     * Represents the vectorized numeric kernels of the virtual machine. The kernels of the widest instruction set,
+     * that the processor supports, are selected when the virtual machine starts. The reductions may add the
+     * elements in any order, therefore their rounding may differ from a sequential loop.
+     */
+    namespace Vectors {
+        /**
+         * Represents a registry of the instruction sets, that the kernels are compiled for.
+         */
+        enum class InstructionSet {
+            SCALAR, // one element at a time, available on every processor
+            SSE2,   // 128-bit vectors, the baseline of the x86-64 processors
+            AVX2    // 256-bit vectors with fused multiply-add
+        };
+
+        /**
+         * Select the kernels of the widest instruction set that the processor supports.
+         * The "-XVectorISA" option limits the selection to the given instruction set.
+         * @param options command line options
+         */
+        void initialize(Options& options);
+
+        /**
+         * Detect the widest instruction set, that the processor and the build of the virtual machine support.
+         * @return supported instruction set
+         */
+        InstructionSet detect();
+
+        /**
+         * Select the kernels of the given instruction set.
+         * @param set selected instruction set, that must be supported by the processor
+         */
+        void select(InstructionSet set);
+
+        /**
+         * Get the instruction set of the selected kernels.
+         * @return selected instruction set
+         */
+        InstructionSet getSelected();
+
+        /**
+         * Get the name of an instruction set.
+         * @param set target instruction set
+         * @return instruction set name
+         */
+        String getName(InstructionSet set);
+
+        /**
+         * Get the selected kernels of an element type.
+         * @return kernel table
+         */
+        template <typename T>
+        const Kernels<T>& get();
+
+        template <>
+        const Kernels<float>& get<float>();
+
+        template <>
+        const Kernels<double>& get<double>();
+
+        /**
+         * Fill the kernel tables with the kernels, that process one element at a time.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadScalar(Kernels<float>& floats, Kernels<double>& doubles);
+
+        /**
+         * Fill the kernel tables with the SSE2 kernels.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadSse2(Kernels<float>& floats, Kernels<double>& doubles);
+
+        /**
+         * Fill the kernel tables with the AVX2 kernels. These are compiled for AVX2 and FMA in a translation unit
+         * of their own, so they must not be called, unless the processor supports these extensions.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadAvx2(Kernels<float>& floats, Kernels<double>& doubles);
+    }
+}
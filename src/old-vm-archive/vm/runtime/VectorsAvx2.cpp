@@ -0,0 +1,95 @@
+#include "Vectors.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+// the kernels of this translation unit are compiled for the extensions, they are selected
+// only if the processor supports them, the rest of the virtual machine is compiled for the baseline
+#if defined(__GNUC__) && !defined(__AVX2__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#define VOID_AVX2_TARGET
+#endif
+
+// the kernel templates must be defined after the target is changed, so that the intrinsics may be inlined into them
+#include "VectorKernels.hpp"
+
+namespace Void {
+    namespace Vectors {
+        /**
+         * Represents the AVX2 instruction set, that processes eight floats at a time.
+         */
+        struct Avx2Float {
+            typedef float Element;
+            typedef __m256 Vector;
+            static const uint WIDTH = 8;
+            static Vector load(const float* data) { return _mm256_loadu_ps(data); }
+            static void store(float* data, Vector value) { _mm256_storeu_ps(data, value); }
+            static Vector add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+            static Vector multiply(Vector a, Vector b) { return _mm256_mul_ps(a, b); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm256_fmadd_ps(a, b, c); }
+            static Vector minimum(Vector a, Vector b) { return _mm256_min_ps(a, b); }
+            static Vector maximum(Vector a, Vector b) { return _mm256_max_ps(a, b); }
+            static Vector broadcast(float value) { return _mm256_set1_ps(value); }
+            static Vector zero() { return _mm256_setzero_ps(); }
+            static float reduce(Vector value) {
+                // add the upper lane to the lower lane, then reduce the lower lane
+                __m128 half = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+                half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+                half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+                return _mm_cvtss_f32(half);
+            }
+        };
+
+        /**
+         * Represents the AVX2 instruction set, that processes four doubles at a time.
+         */
+        struct Avx2Double {
+            typedef double Element;
+            typedef __m256d Vector;
+            static const uint WIDTH = 4;
+            static Vector load(const double* data) { return _mm256_loadu_pd(data); }
+            static void store(double* data, Vector value) { _mm256_storeu_pd(data, value); }
+            static Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+            static Vector multiply(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+            static Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm256_fmadd_pd(a, b, c); }
+            static Vector minimum(Vector a, Vector b) { return _mm256_min_pd(a, b); }
+            static Vector maximum(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+            static Vector broadcast(double value) { return _mm256_set1_pd(value); }
+            static Vector zero() { return _mm256_setzero_pd(); }
+            static double reduce(Vector value) {
+                __m128d half = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+                return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+            }
+        };
+
+        /**
+         * Fill the kernel tables with the AVX2 kernels. These are compiled for AVX2 and FMA in a translation unit
+         * of their own, so they must not be called, unless the processor supports these extensions.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadAvx2(Kernels<float>& floats, Kernels<double>& doubles) {
+            KernelsOf<Avx2Float>::load(floats);
+            KernelsOf<Avx2Double>::load(doubles);
+        }
+    }
+}
+
+#ifdef VOID_AVX2_TARGET
+#pragma GCC pop_options
+#endif
+#else
+namespace Void {
+    namespace Vectors {
+        /**
+         * Fill the kernel tables with the SSE2 kernels, as the AVX2 kernels are not available on this architecture.
+         * @param floats float kernel table
+         * @param doubles double kernel table
+         */
+        void loadAvx2(Kernels<float>& floats, Kernels<double>& doubles) {
+            loadSse2(floats, doubles);
+        }
+    }
+}
+#endif